@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Source/alpine3d/alpine3d/AlpineControl.cc" "alpine3d/CMakeFiles/alpine3d.app.dir/AlpineControl.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.app.dir/AlpineControl.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/AlpineMain.cc" "alpine3d/CMakeFiles/alpine3d.app.dir/AlpineMain.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.app.dir/AlpineMain.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/Source/alpine3d/_gate_build_mpi/alpine3d/CMakeFiles/alpine3d.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,60 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Source/alpine3d/alpine3d/DataAssimilation.cc" "alpine3d/CMakeFiles/alpine3d.dir/DataAssimilation.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/DataAssimilation.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/Glaciers.cc" "alpine3d/CMakeFiles/alpine3d.dir/Glaciers.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/Glaciers.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/LateralFlow.cc" "alpine3d/CMakeFiles/alpine3d.dir/LateralFlow.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/LateralFlow.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/MPIControl.cc" "alpine3d/CMakeFiles/alpine3d.dir/MPIControl.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/MPIControl.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/MeteoObj.cc" "alpine3d/CMakeFiles/alpine3d.dir/MeteoObj.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/MeteoObj.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/OMPControl.cc" "alpine3d/CMakeFiles/alpine3d.dir/OMPControl.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/OMPControl.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/OutputQueue.cc" "alpine3d/CMakeFiles/alpine3d.dir/OutputQueue.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/OutputQueue.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/SnowpackInterface.cc" "alpine3d/CMakeFiles/alpine3d.dir/SnowpackInterface.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/SnowpackInterface.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/SnowpackInterfaceWorker.cc" "alpine3d/CMakeFiles/alpine3d.dir/SnowpackInterfaceWorker.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/SnowpackInterfaceWorker.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/SyntheticDomain.cc" "alpine3d/CMakeFiles/alpine3d.dir/SyntheticDomain.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/SyntheticDomain.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/TechSnowA3D.cc" "alpine3d/CMakeFiles/alpine3d.dir/TechSnowA3D.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/TechSnowA3D.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/EnergyBalance.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/EnergyBalance.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/EnergyBalance.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/RadiationField.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/RadiationField.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/RadiationField.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/SnowBRDF.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/SnowBRDF.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/SnowBRDF.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/SolarPanel.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/SolarPanel.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/SolarPanel.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationAlgorithm.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationAlgorithm.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationAlgorithm.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationComplex.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationComplex.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationComplex.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationHelbig.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationHelbig.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationHelbig.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationSimple.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationSimple.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationSimple.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/VFSparseMatrix.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/VFSparseMatrix.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/VFSparseMatrix.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactors.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactors.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactors.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsCluster.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsCluster.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsCluster.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsHelbig.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsHelbig.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsHelbig.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsSectors.cc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsSectors.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/ebalance/ViewFactorsSectors.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/runoff/Runoff.cc" "alpine3d/CMakeFiles/alpine3d.dir/runoff/Runoff.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/runoff/Runoff.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/Cell.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Cell.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Cell.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/Saltation.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Saltation.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Saltation.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/SnowDrift.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDrift.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDrift.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/SnowDriftFEControl.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEControl.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEControl.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/SnowDriftFEInit.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEInit.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEInit.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/SnowDriftFENumerics.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFENumerics.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFENumerics.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/Sublimation.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Sublimation.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Sublimation.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/Suspension.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Suspension.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/Suspension.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/WindFieldLibrary.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/WindFieldLibrary.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/WindFieldLibrary.cc.o.d"
+  "/root/repo/Source/alpine3d/alpine3d/snowdrift/checksum.cc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/checksum.cc.o" "gcc" "alpine3d/CMakeFiles/alpine3d.dir/snowdrift/checksum.cc.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/Source/alpine3d/lib/libalpine3d.so" "/root/repo/Source/alpine3d/lib/libalpine3d.so.3.3.0"
+  "/root/repo/Source/alpine3d/lib/libalpine3d.so.3" "/root/repo/Source/alpine3d/lib/libalpine3d.so.3.3.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,81 @@
+file(REMOVE_RECURSE
+  "/root/repo/Source/alpine3d/lib/libalpine3d.pdb"
+  "/root/repo/Source/alpine3d/lib/libalpine3d.so"
+  "/root/repo/Source/alpine3d/lib/libalpine3d.so.3"
+  "/root/repo/Source/alpine3d/lib/libalpine3d.so.3.3.0"
+  "CMakeFiles/alpine3d.dir/DataAssimilation.cc.o"
+  "CMakeFiles/alpine3d.dir/DataAssimilation.cc.o.d"
+  "CMakeFiles/alpine3d.dir/Glaciers.cc.o"
+  "CMakeFiles/alpine3d.dir/Glaciers.cc.o.d"
+  "CMakeFiles/alpine3d.dir/LateralFlow.cc.o"
+  "CMakeFiles/alpine3d.dir/LateralFlow.cc.o.d"
+  "CMakeFiles/alpine3d.dir/MPIControl.cc.o"
+  "CMakeFiles/alpine3d.dir/MPIControl.cc.o.d"
+  "CMakeFiles/alpine3d.dir/MeteoObj.cc.o"
+  "CMakeFiles/alpine3d.dir/MeteoObj.cc.o.d"
+  "CMakeFiles/alpine3d.dir/OMPControl.cc.o"
+  "CMakeFiles/alpine3d.dir/OMPControl.cc.o.d"
+  "CMakeFiles/alpine3d.dir/OutputQueue.cc.o"
+  "CMakeFiles/alpine3d.dir/OutputQueue.cc.o.d"
+  "CMakeFiles/alpine3d.dir/SnowpackInterface.cc.o"
+  "CMakeFiles/alpine3d.dir/SnowpackInterface.cc.o.d"
+  "CMakeFiles/alpine3d.dir/SnowpackInterfaceWorker.cc.o"
+  "CMakeFiles/alpine3d.dir/SnowpackInterfaceWorker.cc.o.d"
+  "CMakeFiles/alpine3d.dir/SyntheticDomain.cc.o"
+  "CMakeFiles/alpine3d.dir/SyntheticDomain.cc.o.d"
+  "CMakeFiles/alpine3d.dir/TechSnowA3D.cc.o"
+  "CMakeFiles/alpine3d.dir/TechSnowA3D.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/EnergyBalance.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/EnergyBalance.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/RadiationField.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/RadiationField.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/SnowBRDF.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/SnowBRDF.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/SolarPanel.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/SolarPanel.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationAlgorithm.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationAlgorithm.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationComplex.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationComplex.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationHelbig.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationHelbig.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationSimple.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/TerrainRadiationSimple.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/VFSparseMatrix.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/VFSparseMatrix.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactors.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactors.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsCluster.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsCluster.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsHelbig.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsHelbig.cc.o.d"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsSectors.cc.o"
+  "CMakeFiles/alpine3d.dir/ebalance/ViewFactorsSectors.cc.o.d"
+  "CMakeFiles/alpine3d.dir/runoff/Runoff.cc.o"
+  "CMakeFiles/alpine3d.dir/runoff/Runoff.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/Cell.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/Cell.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/Saltation.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/Saltation.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDrift.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDrift.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEControl.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEControl.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEInit.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFEInit.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFENumerics.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/SnowDriftFENumerics.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/Sublimation.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/Sublimation.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/Suspension.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/Suspension.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/WindFieldLibrary.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/WindFieldLibrary.cc.o.d"
+  "CMakeFiles/alpine3d.dir/snowdrift/checksum.cc.o"
+  "CMakeFiles/alpine3d.dir/snowdrift/checksum.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/alpine3d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,117 @@
+# Install script for directory: /root/repo/Source/alpine3d/alpine3d
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "exe" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so.3.3.0"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/Source/alpine3d/lib/libalpine3d.so.3.3.0"
+    "/root/repo/Source/alpine3d/lib/libalpine3d.so.3"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so.3.3.0"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHANGE
+           FILE "${file}"
+           OLD_RPATH "/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib:::::::::::::::"
+           NEW_RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "exe" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so"
+         RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/Source/alpine3d/lib/libalpine3d.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so"
+         OLD_RPATH "/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib:::::::::::::::"
+         NEW_RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libalpine3d.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "exe" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d"
+         RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/bin" TYPE EXECUTABLE FILES "/root/repo/Source/alpine3d/bin/alpine3d")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d"
+         OLD_RPATH "/root/repo/Source/alpine3d/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib:"
+         NEW_RPATH "/usr/local/lib:/root/repo/Source/snowpack/lib:/root/repo/Source/meteoio/lib:/usr/lib/x86_64-linux-gnu/openmpi/lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/bin/alpine3d")
+    endif()
+  endif()
+endif()
+
@@ -0,0 +1,91 @@
+# This file will be configured to contain variables for CPack. These variables
+# should be set in the CMake list file of the project before CPack module is
+# included. The list of available CPACK_xxx variables and their associated
+# documentation may be obtained using
+#  cpack --help-variable-list
+#
+# Some variables are common to all generators (e.g. CPACK_PACKAGE_NAME)
+# and some are specific to a generator
+# (e.g. CPACK_NSIS_EXTRA_INSTALL_COMMANDS). The generator specific variables
+# usually begin with CPACK_<GENNAME>_xxxx.
+
+
+set(CPACK_ARCH "x86_64")
+set(CPACK_ARCHIVE_COMPONENT_INSTALL "OFF")
+set(CPACK_BUILD_SOURCE_DIRS "/root/repo/Source/alpine3d;/root/repo/Source/alpine3d/_gate_build_omp")
+set(CPACK_BUNDLE_ALL "OFF")
+set(CPACK_CMAKE_GENERATOR "Unix Makefiles")
+set(CPACK_COMPONENTS_ALL "documentation;examples;exe")
+set(CPACK_COMPONENTS_ALL_SET_BY_USER "TRUE")
+set(CPACK_COMPONENT_EXE_DESCRIPTION "The Alpine3D standalone model")
+set(CPACK_COMPONENT_EXE_DISPLAY_NAME "Alpine3D application")
+set(CPACK_COMPONENT_EXE_GROUP "Runtime")
+set(CPACK_COMPONENT_GROUP_RUNTIME_DESCRIPTION "What you need to run an application based on Alpine3D")
+set(CPACK_COMPONENT_LIBRARIES_DESCRIPTION "The Alpine3D static library")
+set(CPACK_COMPONENT_LIBRARIES_DISPLAY_NAME "Alpine3D static library")
+set(CPACK_COMPONENT_RUNTIME_GROUP "Runtime")
+set(CPACK_COMPONENT_UNSPECIFIED_HIDDEN "TRUE")
+set(CPACK_COMPONENT_UNSPECIFIED_REQUIRED "TRUE")
+set(CPACK_DEBIAN_PACKAGE_ARCHITECTURE "amd64")
+set(CPACK_DEBIAN_PACKAGE_DEPENDS "libstdc++, meteoio,snowpack")
+set(CPACK_DEBIAN_PACKAGE_NAME "alpine3d")
+set(CPACK_DEBIAN_PACKAGE_SECTION "science")
+set(CPACK_DEFAULT_PACKAGE_DESCRIPTION_FILE "/usr/share/cmake-3.25/Templates/CPack.GenericDescription.txt")
+set(CPACK_DEFAULT_PACKAGE_DESCRIPTION_SUMMARY "alpine3d built using CMake")
+set(CPACK_DMG_SLA_USE_RESOURCE_FILE_LICENSE "ON")
+set(CPACK_GENERATOR "DEB;RPM;TGZ")
+set(CPACK_INSTALL_CMAKE_PROJECTS "/root/repo/Source/alpine3d/_gate_build_omp;alpine3d;ALL;/")
+set(CPACK_INSTALL_PREFIX "/usr/local")
+set(CPACK_MODULE_PATH "/root/repo/Source/alpine3d/tools/cmake/")
+set(CPACK_NSIS_DISPLAY_NAME "Alpine3d")
+set(CPACK_NSIS_INSTALLER_ICON_CODE "")
+set(CPACK_NSIS_INSTALLER_MUI_ICON_CODE "")
+set(CPACK_NSIS_INSTALL_ROOT "$PROGRAMFILES")
+set(CPACK_NSIS_PACKAGE_NAME "Alpine3d")
+set(CPACK_NSIS_UNINSTALL_NAME "Uninstall")
+set(CPACK_OBJCOPY_EXECUTABLE "/usr/bin/objcopy")
+set(CPACK_OBJDUMP_EXECUTABLE "/usr/bin/objdump")
+set(CPACK_OUTPUT_CONFIG_FILE "/root/repo/Source/alpine3d/_gate_build_omp/CPackConfig.cmake")
+set(CPACK_PACKAGE_CONTACT "Mathias Bavay <Mathias.Bavay@wsl.ch>")
+set(CPACK_PACKAGE_DEFAULT_LOCATION "/")
+set(CPACK_PACKAGE_DESCRIPTION "Alpine3d Model")
+set(CPACK_PACKAGE_DESCRIPTION_FILE "/root/repo/Source/alpine3d/Welcome.txt")
+set(CPACK_PACKAGE_DESCRIPTION_SUMMARY "This is the Alpine3D distributed alpine surface processes model.")
+set(CPACK_PACKAGE_FILE_NAME "Alpine3d-3.3.0-x86_64")
+set(CPACK_PACKAGE_ICON "/root/repo/Source/alpine3d/alpine3d/icons\\icon.ico")
+set(CPACK_PACKAGE_INSTALL_DIRECTORY "Alpine3d")
+set(CPACK_PACKAGE_INSTALL_REGISTRY_KEY "Alpine3d")
+set(CPACK_PACKAGE_NAME "Alpine3d")
+set(CPACK_PACKAGE_RELOCATABLE "true")
+set(CPACK_PACKAGE_VENDOR "WSL Institute for Snow and Avalanche Research")
+set(CPACK_PACKAGE_VERSION "3.3.0")
+set(CPACK_PACKAGE_VERSION_MAJOR "3")
+set(CPACK_PACKAGE_VERSION_MINOR "3")
+set(CPACK_PACKAGE_VERSION_PATCH "0")
+set(CPACK_PACKAGING_INSTALL_PREFIX "/usr")
+set(CPACK_READELF_EXECUTABLE "/usr/bin/readelf")
+set(CPACK_RESOURCE_FILE_LICENSE "/root/repo/Source/alpine3d/License.txt")
+set(CPACK_RESOURCE_FILE_README "/root/repo/Source/alpine3d/Readme.txt")
+set(CPACK_RESOURCE_FILE_WELCOME "/root/repo/Source/alpine3d/Welcome.txt")
+set(CPACK_RPM_PACKAGE_ARCHITECTURE "x86_64")
+set(CPACK_RPM_PACKAGE_GROUP "Applications/Science")
+set(CPACK_RPM_PACKAGE_LICENSE "LPGLv3")
+set(CPACK_RPM_PACKAGE_NAME "alpine3d")
+set(CPACK_RPM_PACKAGE_REQUIRES "libstdc++6, meteoio,snowpack")
+set(CPACK_SET_DESTDIR "OFF")
+set(CPACK_SOURCE_GENERATOR "TGZ")
+set(CPACK_SOURCE_IGNORE_FILES "~$;\\.svn/;/CMakeFiles/;/CMakeCache*;/cmake_install\\.cmake$;/cmake_uninstall\\.cmake$;^_CPack_.*/;/CPack*;\\.o$;/m4/")
+set(CPACK_SOURCE_OUTPUT_CONFIG_FILE "/root/repo/Source/alpine3d/_gate_build_omp/CPackSourceConfig.cmake")
+set(CPACK_SOURCE_PACKAGE_FILE_NAME "Alpine3d-3.3.0")
+set(CPACK_SYSTEM_NAME "Linux")
+set(CPACK_THREADS "1")
+set(CPACK_TOPLEVEL_TAG "Linux")
+set(CPACK_WIX_SIZEOF_VOID_P "8")
+
+if(NOT CPACK_PROPERTIES_FILE)
+  set(CPACK_PROPERTIES_FILE "/root/repo/Source/alpine3d/_gate_build_omp/CPackProperties.cmake")
+endif()
+
+if(EXISTS ${CPACK_PROPERTIES_FILE})
+  include(${CPACK_PROPERTIES_FILE})
+endif()
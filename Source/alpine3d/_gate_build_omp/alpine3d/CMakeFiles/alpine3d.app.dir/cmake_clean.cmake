@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "/root/repo/Source/alpine3d/bin/alpine3d"
+  "/root/repo/Source/alpine3d/bin/alpine3d.pdb"
+  "CMakeFiles/alpine3d.app.dir/AlpineControl.cc.o"
+  "CMakeFiles/alpine3d.app.dir/AlpineControl.cc.o.d"
+  "CMakeFiles/alpine3d.app.dir/AlpineMain.cc.o"
+  "CMakeFiles/alpine3d.app.dir/AlpineMain.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/alpine3d.app.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,114 @@
+# Install script for directory: /root/repo/Source/alpine3d
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/alpine3d" TYPE FILE FILES
+    "/root/repo/Source/alpine3d/alpine3d/Alpine3D.h"
+    "/root/repo/Source/alpine3d/alpine3d/AlpineControl.h"
+    "/root/repo/Source/alpine3d/alpine3d/AlpineMain.h"
+    "/root/repo/Source/alpine3d/alpine3d/DataAssimilation.h"
+    "/root/repo/Source/alpine3d/alpine3d/Glaciers.h"
+    "/root/repo/Source/alpine3d/alpine3d/LateralFlow.h"
+    "/root/repo/Source/alpine3d/alpine3d/MPIControl.h"
+    "/root/repo/Source/alpine3d/alpine3d/MainPage.h"
+    "/root/repo/Source/alpine3d/alpine3d/MeteoObj.h"
+    "/root/repo/Source/alpine3d/alpine3d/OMPControl.h"
+    "/root/repo/Source/alpine3d/alpine3d/OutputQueue.h"
+    "/root/repo/Source/alpine3d/alpine3d/SnowpackInterface.h"
+    "/root/repo/Source/alpine3d/alpine3d/SnowpackInterfaceWorker.h"
+    "/root/repo/Source/alpine3d/alpine3d/SyntheticDomain.h"
+    "/root/repo/Source/alpine3d/alpine3d/TechSnowA3D.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/alpine3d/ebalance" TYPE FILE FILES
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/EBStruct.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/EnergyBalance.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/RadiationField.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/SnowBRDF.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/SolarPanel.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationAlgorithm.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationComplex.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationHelbig.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/TerrainRadiationSimple.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/VFSparseMatrix.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/VFSymetricMatrix.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactors.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsAlgorithm.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsCluster.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsHelbig.h"
+    "/root/repo/Source/alpine3d/alpine3d/ebalance/ViewFactorsSectors.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/alpine3d/runoff" TYPE FILE FILES "/root/repo/Source/alpine3d/alpine3d/runoff/Runoff.h")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/alpine3d/snowdrift" TYPE FILE FILES
+    "/root/repo/Source/alpine3d/alpine3d/snowdrift/Cell.h"
+    "/root/repo/Source/alpine3d/alpine3d/snowdrift/SnowDrift.h"
+    "/root/repo/Source/alpine3d/alpine3d/snowdrift/WindFieldLibrary.h"
+    "/root/repo/Source/alpine3d/alpine3d/snowdrift/checksum.h"
+    )
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/Source/alpine3d/_gate_build_omp/alpine3d/cmake_install.cmake")
+
+endif()
+
+if(CMAKE_INSTALL_COMPONENT)
+  set(CMAKE_INSTALL_MANIFEST "install_manifest_${CMAKE_INSTALL_COMPONENT}.txt")
+else()
+  set(CMAKE_INSTALL_MANIFEST "install_manifest.txt")
+endif()
+
+string(REPLACE ";" "\n" CMAKE_INSTALL_MANIFEST_CONTENT
+       "${CMAKE_INSTALL_MANIFEST_FILES}")
+file(WRITE "/root/repo/Source/alpine3d/_gate_build_omp/${CMAKE_INSTALL_MANIFEST}"
+     "${CMAKE_INSTALL_MANIFEST_CONTENT}")
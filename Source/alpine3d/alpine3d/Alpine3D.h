@@ -25,6 +25,7 @@
 #include <alpine3d/OMPControl.h>
 //#include <alpine3d/MainPage.h>
 #include <alpine3d/MeteoObj.h>
+#include <alpine3d/SyntheticDomain.h>
 //#include <alpine3d/runoff/prevah_runoff/fortran_and_c.h>
 //#include <alpine3d/runoff/prevah_runoff/Runoff.h>
 //#include <alpine3d/runoff/prevah_runoff/f77-uscore.h>
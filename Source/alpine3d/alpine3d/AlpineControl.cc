@@ -19,6 +19,8 @@
 #include <alpine3d/AlpineMain.h>
 #include <meteoio/MeteoIO.h>
 
+#include <fstream>
+
 using namespace mio;
 using namespace std;
 
@@ -35,7 +37,7 @@ using namespace std;
  */
 AlpineControl::AlpineControl(SnowpackInterface *mysnowpack, SnowDriftA3D *mysnowdrift, EnergyBalance *myeb, DataAssimilation *myda, Runoff *myrunoff, const Config& cfg, const DEMObject& in_dem)
               : dem(in_dem), meteo(cfg, in_dem), snowpack(mysnowpack), snowdrift(mysnowdrift), eb(myeb), da(myda),
-                runoff(myrunoff), snow_days_between(0.), max_run_time(-1.), enable_simple_snow_drift(false), nocompute(false), out_snow(true), correct_meteo_grids_HS(false)
+                runoff(myrunoff), snow_days_between(0.), max_run_time(-1.), results_file(), sn_workers(1), eb_workers(1), enable_simple_snow_drift(false), nocompute(false), out_snow(true), correct_meteo_grids_HS(false)
 {
 	cfg.getValue("SNOW_WRITE", "Output", out_snow);
 	if (out_snow) {
@@ -49,6 +51,9 @@ AlpineControl::AlpineControl(SnowpackInterface *mysnowpack, SnowDriftA3D *mysnow
 
 	//check if maximum run time is specified
 	cfg.getValue("MAX_RUN_TIME", "Alpine3D", max_run_time, IOUtils::nothrow);
+
+	//when benchmarking, the timings are appended to a results file
+	cfg.getValue("RESULTS_FILE", "Benchmark", results_file, IOUtils::nothrow);
 }
 
 void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
@@ -60,6 +65,8 @@ void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
 	std::vector<MeteoData> vecMeteo; // to transfer meteo information
 	mio::Grid2DObject p, psum, psum_ph, vw, vw_drift, dw, rh, ta, tsg, ilwr;
 	const bool isMaster = MPIControl::instance().master();
+	ModulesTiming timing;
+	unsigned int nr_steps = 0;
 
 	if (isMaster) {
 		cout << "\n**** Done initializing\n";
@@ -81,6 +88,7 @@ void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
 	elapsed.start();
 	for (unsigned int t_ind=0; t_ind<max_steps; t_ind++) { //main computational loop
 		const double elapsed_start = elapsed.getElapsed();
+		MPIControl::instance().resetExchangedBytes();
 		const double est_completion = elapsed_start * ((double)max_steps/(double)(t_ind+1) - 1.);
 
 		if (isMaster) {
@@ -184,6 +192,20 @@ void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
 			throw;
 		}
 
+		timing.meteo += meteo.getTiming();
+		if (eb) {
+			timing.ebalance += eb->getTiming();
+			timing.terrain += eb->getTerrainRadiationTiming();
+		}
+		if (snowdrift) timing.snowdrift += snowdrift->getTiming();
+		if (snowpack) timing.snowpack += snowpack->getTiming();
+		if (runoff) timing.runoff += runoff->getTiming();
+		timing.total += elapsed.getElapsed()-elapsed_start;
+		double exchanged_bytes = static_cast<double>( MPIControl::instance().getExchangedBytes() );
+		MPIControl::instance().reduce_sum(exchanged_bytes, false); //total of all processes, on the master
+		timing.exchanged_bytes += exchanged_bytes;
+		nr_steps++;
+
 		if (isMaster) {
 			cout << "[i] timing (seconds spent): " << std::setprecision(3) << std::fixed<< "\n";
 			cout << "\tmeteo=" << meteo.getTiming() << "  ";
@@ -193,7 +215,9 @@ void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
 			if (snowpack) cout << "snowpack=" << snowpack->getTiming() << "  ";
 			if (runoff) cout << "runoff=" << runoff->getTiming() << " ";
 
-			cout << "\n\ttotal=" << elapsed.getElapsed()-elapsed_start << endl;
+			cout << "\n\ttotal=" << elapsed.getElapsed()-elapsed_start;
+			if (MPIControl::instance().size()>1) cout << "  MPI exchanges=" << exchanged_bytes/1024. << " kB";
+			cout << endl;
 		}
 
 		if (ForceStop) break;
@@ -207,4 +231,57 @@ void AlpineControl::Run(Date i_startdate, const unsigned int max_steps)
 		if (isMaster) cout << "[i] Simulation finished, writing output files...\n";
 		snowpack->writeOutputSNO(calcDate);
 	 }
+
+	if (isMaster && !nocompute && nr_steps>0) {
+		printTimingSummary(timing, nr_steps);
+		if (!results_file.empty()) writeTimingResults(timing, nr_steps);
+	}
+}
+
+void AlpineControl::printTimingSummary(const ModulesTiming& timing, const unsigned int& nr_steps) const
+{
+	const std::string names[] = {"meteo", "ebalance", "  terrain", "snowdrift", "snowpack", "runoff"};
+	const double values[] = {timing.meteo, timing.ebalance, timing.terrain, timing.snowdrift, timing.snowpack, timing.runoff};
+	const bool enabled[] = {true, eb!=NULL, eb!=NULL, snowdrift!=NULL, snowpack!=NULL, runoff!=NULL};
+
+	cout << "\n[i] Timing summary over " << nr_steps << " steps (seconds spent):\n";
+	cout << "\t" << std::left << std::setw(12) << "module" << std::right << std::setw(12) << "total" << std::setw(12) << "per step" << std::setw(10) << "share" << "\n";
+	for (size_t ii=0; ii<6; ii++) {
+		if (!enabled[ii]) continue;
+		const double share = (timing.total>0.)? values[ii] / timing.total * 100. : 0.;
+		cout << "\t" << std::left << std::setw(12) << names[ii] << std::right << std::fixed << std::setprecision(3) << std::setw(12) << values[ii];
+		cout << std::setw(12) << values[ii]/nr_steps << std::setprecision(1) << std::setw(9) << share << "%\n";
+	}
+	cout << "\t" << std::left << std::setw(12) << "total" << std::right << std::setprecision(3) << std::setw(12) << timing.total << std::setw(12) << timing.total/nr_steps << "\n";
+	if (MPIControl::instance().size()>1)
+		cout << "[i] MPI exchanges: " << timing.exchanged_bytes/(1024.*1024.) << " MB in total, " << timing.exchanged_bytes/1024./nr_steps << " kB per step\n";
+}
+
+/**
+ * @brief Append one line of timing results to the benchmark results file.
+ * @details The columns are: number of processes, number of Snowpack workers, number of Ebalance workers, number of
+ * simulated cells, number of steps and the time spent (in seconds) in meteo, ebalance, terrain radiation, snowdrift,
+ * snowpack, runoff and in total. The disabled modules are marked with IOUtils::nodata.
+ * @param timing accumulated timings
+ * @param nr_steps number of simulated time steps
+ */
+void AlpineControl::writeTimingResults(const ModulesTiming& timing, const unsigned int& nr_steps) const
+{
+	const bool write_header = !FileUtils::fileExists(results_file);
+	std::ofstream fout(results_file.c_str(), std::ios::out | std::ios::app);
+	if (fout.fail()) throw AccessException(results_file, AT);
+
+	if (write_header)
+		fout << "# processes sn_workers eb_workers cells steps meteo ebalance terrain snowdrift snowpack runoff total\n";
+
+	const double nodata = IOUtils::nodata;
+	fout << MPIControl::instance().size() << " " << sn_workers << " " << eb_workers << " " << dem.grid2D.getCount() << " " << nr_steps;
+	fout << std::fixed << std::setprecision(3);
+	fout << " " << timing.meteo;
+	fout << " " << ((eb)? timing.ebalance : nodata) << " " << ((eb)? timing.terrain : nodata);
+	fout << " " << ((snowdrift)? timing.snowdrift : nodata);
+	fout << " " << ((snowpack)? timing.snowpack : nodata);
+	fout << " " << ((runoff)? timing.runoff : nodata);
+	fout << " " << timing.total << "\n";
+	fout.close();
 }
@@ -58,8 +58,19 @@ class AlpineControl
 		              const mio::DEMObject& in_dem);
 		void Run(mio::Date i_startdate, const unsigned int max_steps);
 		void setNoCompute(bool i_nocompute) {nocompute = i_nocompute;}
+		void setWorkers(const unsigned int& i_sn_workers, const unsigned int& i_eb_workers) {sn_workers = i_sn_workers; eb_workers = i_eb_workers;}
 
 	private:
+		/** @brief Time spent in each module, accumulated over all the time steps */
+		struct ModulesTiming {
+			ModulesTiming() : meteo(0.), ebalance(0.), terrain(0.), snowdrift(0.), snowpack(0.), runoff(0.), total(0.), exchanged_bytes(0.) {}
+			double meteo, ebalance, terrain, snowdrift, snowpack, runoff, total;
+			double exchanged_bytes; ///< bytes sent between the MPI processes, summed over all processes
+		};
+
+		void printTimingSummary(const ModulesTiming& timing, const unsigned int& nr_steps) const;
+		void writeTimingResults(const ModulesTiming& timing, const unsigned int& nr_steps) const;
+
 		MeteoObj meteo;
 		const mio::DEMObject& dem;
 
@@ -70,6 +81,8 @@ class AlpineControl
 		Runoff* runoff;
 		double snow_days_between;
 		double max_run_time;
+		std::string results_file; ///< where to append the timing results (see \ref benchmark "benchmark")
+		unsigned int sn_workers, eb_workers;
 		bool enable_simple_snow_drift;
 		bool nocompute, out_snow, correct_meteo_grids_HS; // no computation, only parse inputs (check mode)
 };
@@ -40,6 +40,7 @@
 #include <alpine3d/snowdrift/SnowDrift.h>
 #include <alpine3d/SnowpackInterface.h>
 #include <alpine3d/DataAssimilation.h>
+#include <alpine3d/SyntheticDomain.h>
 
 using namespace std;
 using namespace mio;
@@ -48,7 +49,7 @@ using namespace mio;
 static int steps = 0; //how many hours to simulate
 static Date startdate;
 
-static bool enable_eb=false, enable_drift=false, enable_runoff=false, enable_da=false, nocompute=false, restart=false;
+static bool enable_eb=false, enable_drift=false, enable_runoff=false, enable_da=false, nocompute=false, restart=false, benchmark=false;
 static int npsnowpack=1, npebalance=1;
 
 inline void Usage(char *prog)
@@ -63,6 +64,7 @@ inline void Usage(char *prog)
 	cout << "\t[--enable-da] (default:off)\n";
 	cout << "\t[--no-compute] Don't compute the simulation, only parse and validate the inputs (default:off)\n";
 	cout << "\t[--restart] Restart simulation from previous .sno files (default:off)\n";
+	cout << "\t[--benchmark] Generate and simulate a synthetic domain as configured in the [Benchmark] section (default:off)\n";
 	cout << "\t[-p, --np-snowpack=<number of processors for SnowPack>]\n";
 	cout << "\t[-b, --np-ebalance=<number of processors for Ebalance>]\n";
 	cout << "\t[-i, --iofile=<MeteoIO ini file> (default:./io.ini)]\n";
@@ -74,7 +76,7 @@ inline void Usage(char *prog)
 inline void parseCmdLine(int argc, char **argv, Config &cfg)
 {
 	std::string iofile( "io.ini" );
-	int eeb=0, edr=0, ero=0, eda=0, nco=0, rst=0;
+	int eeb=0, edr=0, ero=0, eda=0, nco=0, rst=0, bch=0;
 	int longindex=0, opt = -1;
 	bool setStart=false, setEnd=false, setSteps=false;
 	std::string start_date_input, end_date_input;
@@ -88,6 +90,7 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg)
 		{"enable-da",		no_argument,&eda, 1},
 		{"no-compute",		no_argument,&nco, 1},
 		{"restart",		no_argument,&rst, 1},
+		{"benchmark",		no_argument,&bch, 1},
 
 		/* These options don't set a flag.
 			We distinguish them by their indices. */
@@ -160,6 +163,7 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg)
 	enable_da	= (eda!=0);
 	nocompute	= (nco!=0);
 	restart		= (rst!=0);
+	benchmark	= (bch!=0);
 
 	//now, we read the config file and set the start and end dates
 	//only the master requires the io.ini, the rest receives a the cfg object:
@@ -383,6 +387,12 @@ inline void real_main(int argc, char **argv)
 
 	Config cfg;
 	parseCmdLine(argc, argv, cfg); //pass command line arguments, set config file for cfg
+	if (benchmark) { //the master writes the synthetic inputs, then all processes point their config to them
+		const SyntheticDomain domain(cfg);
+		if (mpicontrol.master()) domain.generate(startdate, steps, enable_drift);
+		mpicontrol.barrier();
+		domain.setConfig(cfg, enable_drift);
+	}
 	IOManager io(cfg);
 	const time_t start = time(NULL);
 
@@ -412,6 +422,7 @@ inline void real_main(int argc, char **argv)
 		setModules(cfg, io, dem, landuse, vec_pts, drift, eb, snowpack, da, runoff);
 		AlpineControl control(snowpack, drift, eb, da, runoff, cfg, dem);
 		control.setNoCompute(nocompute);
+		control.setWorkers(npsnowpack, npebalance);
 		control.Run(startdate, steps);
 	} catch (std::exception& e) {
 		cerr << "[E] exception thrown: " << e.what() << endl;
@@ -424,6 +435,14 @@ inline void real_main(int argc, char **argv)
 	}
 
 	cleanDestroyAll(drift, eb, snowpack, da, runoff);
+#ifdef MIO_TRACING
+	//each process writes its own trace, the summary is only printed for the master
+	Tracer::setProcessID( mpicontrol.rank() );
+	std::ostringstream trace_file;
+	trace_file << meteo_outpath << "/trace_" << mpicontrol.rank() << ".json";
+	Tracer::writeChromeTrace( trace_file.str() );
+	if (mpicontrol.master()) std::cout << "\n" << Tracer::getSummary();
+#endif
 	const time_t  end = time(NULL);
 	if (mpicontrol.master()) {
 		printf("\n");
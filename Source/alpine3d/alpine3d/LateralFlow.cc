@@ -0,0 +1,300 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <alpine3d/LateralFlow.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mio;
+using namespace std;
+
+const size_t LateralFlow::npos = static_cast<size_t>(-1);
+
+/**
+ * @brief Build the routing graph
+ * @param dem DEM of the whole domain
+ * @param i_startx first column computed by this process
+ * @param i_nx number of columns computed by this process
+ */
+LateralFlow::LateralFlow(const mio::DEMObject& dem, const size_t& i_startx, const size_t& i_nx)
+            : dimy(dem.getNy()), startx(i_startx), nx(i_nx), ext_startx(i_startx), ext_nx(i_nx), nr_halo_left(0), nr_halo_right(0),
+              borders_domain(), destination(), weight(), contrib_start(), contrib(), layer_start(), layer_date(), layer_L(), layer_flux()
+{
+	const size_t dimx = dem.getNx();
+	if (startx+nx > dimx)
+		throw InvalidArgumentException("The band computed by this process is outside of the domain", AT);
+
+	//the columns next to the band belong to the neighbouring processes
+	nr_halo_left = (startx>0)? 1 : 0;
+	nr_halo_right = (startx+nx<dimx)? 1 : 0;
+	ext_startx = startx - nr_halo_left;
+	ext_nx = nx + nr_halo_left + nr_halo_right;
+
+	const size_t nr_procs = MPIControl::instance().size();
+	std::vector<size_t> borders_offsets(nr_procs), borders_widths(nr_procs, 2);
+	for (size_t ii = 0; ii < nr_procs; ii++) borders_offsets[ii] = 2*ii;
+	borders_domain = MPIDomain(borders_offsets, borders_widths, 2*nr_procs, 1);
+
+	//D8 destinations, by sectors of 45° centered on North and going clockwise (the y axis points to the North)
+	static const int dx[8] = { 0,  1,  1,  1,  0, -1, -1, -1};
+	static const int dy[8] = { 1,  1,  0, -1, -1, -1,  0,  1};
+
+	const size_t ext_cells = ext_nx * dimy;
+	destination.assign(ext_cells, npos);
+	weight.assign(ext_cells, 0.);
+	for (size_t ext_ix = 0; ext_ix < ext_nx; ext_ix++) {
+		const size_t ix = ext_startx + ext_ix;
+		for (size_t iy = 0; iy < dimy; iy++) {
+			//pixels without valid azimuth have been given azimuth = 0
+			const double azi = (dem.azi(ix,iy) == IOUtils::nodata)? 0. : dem.azi(ix,iy);
+			const int sector = static_cast<int>( ceil((azi - 22.5) / 45.) ) % 8; //]337.5, 22.5] is North, ]22.5, 67.5] is North-East, etc
+			const int ixd = static_cast<int>(ext_ix) + dx[sector];
+			const int iyd = static_cast<int>(iy) + dy[sector];
+			if (ixd < 0 || iyd < 0 || ixd >= static_cast<int>(ext_nx) || iyd >= static_cast<int>(dimy)) continue; //outside of the domain (or of the halo)
+
+			const size_t cell = ext_ix*dimy + iy;
+			destination[cell] = static_cast<size_t>(ixd)*dimy + static_cast<size_t>(iyd);
+			const double dist = (dx[sector]!=0 && dy[sector]!=0)? Cst::Sqrt2 * dem.cellsize : dem.cellsize;
+			weight[cell] = 1. / dist;
+		}
+	}
+
+	//for each cell of the band, list the cells that contribute to its source/sink term (including itself) in ascending order
+	std::vector< std::vector<size_t> > contributors(nx * dimy);
+	for (size_t cell = 0; cell < ext_cells; cell++) {
+		const size_t ext_ix = cell / dimy;
+		if (ext_ix >= nr_halo_left && ext_ix < nr_halo_left+nx)
+			contributors[ cell - nr_halo_left*dimy ].push_back( cell );
+
+		const size_t dst = destination[cell];
+		if (dst == npos) continue;
+		const size_t dst_ix = dst / dimy;
+		if (dst_ix >= nr_halo_left && dst_ix < nr_halo_left+nx)
+			contributors[ dst - nr_halo_left*dimy ].push_back( cell );
+	}
+
+	contrib_start.resize(contributors.size()+1, 0);
+	for (size_t ii = 0; ii < contributors.size(); ii++)
+		contrib_start[ii+1] = contrib_start[ii] + contributors[ii].size();
+	contrib.reserve(contrib_start.back());
+	for (size_t ii = 0; ii < contributors.size(); ii++)
+		contrib.insert(contrib.end(), contributors[ii].begin(), contributors[ii].end());
+
+	layer_start.resize(ext_cells+1, 0);
+}
+
+/**
+ * @brief Translate the slope parallel flux of all pixels computed by this process into source/sink terms
+ * @param snow_pixel all the pixels of the band computed by this process, the pixel (ix,iy) (with ix relative to the start of the band)
+ * being at index ix*dimy+iy. Skipped pixels are NULL.
+ * @param worker_startx first column (in the whole domain) of the columns range of each worker
+ * @param worker_deltax number of columns of each worker
+ */
+void LateralFlow::compute(const std::vector<SnowStation*>& snow_pixel, const std::vector<size_t>& worker_startx, const std::vector<size_t>& worker_deltax)
+{
+	if (snow_pixel.size() != nx*dimy)
+		throw InvalidArgumentException("The number of pixels does not match the band computed by this process", AT);
+
+	//exchange the border columns with the neighbouring processes
+	MPIControl& mpicontrol = MPIControl::instance();
+	std::vector<double> from_left, from_right;
+	if (mpicontrol.size() > 1) {
+		std::vector<double> to_left, to_right;
+		if (nr_halo_left>0) packColumn(snow_pixel, 0, to_left);
+		if (nr_halo_right>0) packColumn(snow_pixel, nx-1, to_right);
+		double max_len = static_cast<double>( std::max(to_left.size(), to_right.size()) );
+		mpicontrol.reduce_max(max_len);
+
+		const size_t rank = mpicontrol.rank();
+		mio::Array2D<double> borders(borders_domain.getDimX(), static_cast<size_t>(max_len), 0.); //the padding is never read
+		for (size_t jj = 0; jj < to_left.size(); jj++) borders(2*rank, jj) = to_left[jj];
+		for (size_t jj = 0; jj < to_right.size(); jj++) borders(2*rank+1, jj) = to_right[jj];
+		mpicontrol.exchangeHalos(borders, borders_domain);
+
+		if (nr_halo_left>0) {
+			from_left.resize(borders.getNy());
+			for (size_t jj = 0; jj < from_left.size(); jj++) from_left[jj] = borders(2*rank-1, jj);
+		}
+		if (nr_halo_right>0) {
+			from_right.resize(borders.getNy());
+			for (size_t jj = 0; jj < from_right.size(); jj++) from_right[jj] = borders(2*rank+2, jj);
+		}
+	}
+
+	//first phase: gather the layers of the band and of the halo into flat buffers
+	const size_t nbworkers = worker_startx.size();
+	for (size_t pass = 0; pass < 2; pass++) { //first count the layers, then fill the buffers
+		const bool fill = (pass==1);
+		if (nr_halo_left>0) readHaloColumn(from_left, 0, fill);
+		if (nr_halo_right>0) readHaloColumn(from_right, ext_nx-1, fill);
+
+		#pragma omp parallel for schedule(dynamic, 1)
+		for (size_t ii = 0; ii < nbworkers; ii++) {
+			gatherLayers(snow_pixel, worker_startx[ii]-startx, worker_startx[ii]-startx+worker_deltax[ii], fill);
+		}
+
+		if (!fill) {
+			for (size_t cell = 0; cell+1 < layer_start.size(); cell++)
+				layer_start[cell+1] += layer_start[cell];
+			const size_t nr_layers = layer_start.back();
+			layer_date.resize(nr_layers);
+			layer_L.resize(nr_layers);
+			layer_flux.resize(nr_layers);
+		}
+	}
+
+	//second phase: each pixel collects its own source/sink terms
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (size_t ii = 0; ii < nbworkers; ii++) {
+		applyFlux(snow_pixel, worker_startx[ii]-startx, worker_startx[ii]-startx+worker_deltax[ii]);
+	}
+}
+
+/**
+ * @brief Serialize the layers of one column of the band: for each pixel, its number of layers followed by
+ * the deposition date, thickness and slope parallel flux of each layer (anything after the last pixel is ignored
+ * when reading the column back)
+ */
+void LateralFlow::packColumn(const std::vector<SnowStation*>& snow_pixel, const size_t& ix, std::vector<double>& buffer) const
+{
+	buffer.clear();
+	for (size_t iy = 0; iy < dimy; iy++) {
+		const SnowStation* pixel = snow_pixel[ix*dimy + iy];
+		const size_t nE = (pixel!=NULL)? pixel->getNumberOfElements() : 0;
+		buffer.push_back( static_cast<double>(nE) );
+		for (size_t n = 0; n < nE; n++) {
+			buffer.push_back( pixel->Edata[n].depositionDate.getJulian(true) );
+			buffer.push_back( pixel->Edata[n].L );
+			buffer.push_back( pixel->Edata[n].SlopeParFlux );
+		}
+	}
+}
+
+/**
+ * @brief Read a column received from a neighbouring process (see packColumn())
+ * @param buffer serialized column
+ * @param ext_ix column index in the extended band
+ * @param fill if false, only count the layers, otherwise copy them into the buffers
+ */
+void LateralFlow::readHaloColumn(const std::vector<double>& buffer, const size_t& ext_ix, const bool& fill)
+{
+	size_t pos = 0;
+	for (size_t iy = 0; iy < dimy; iy++) {
+		const size_t cell = ext_ix*dimy + iy;
+		if (pos >= buffer.size())
+			throw IOException("Invalid lateral flow halo received from a neighbouring process", AT);
+		const size_t nE = static_cast<size_t>( buffer[pos++] );
+		if (pos + 3*nE > buffer.size())
+			throw IOException("Invalid lateral flow halo received from a neighbouring process", AT);
+
+		if (!fill) {
+			layer_start[cell+1] = nE;
+			pos += 3*nE;
+			continue;
+		}
+		for (size_t n = layer_start[cell]; n < layer_start[cell]+nE; n++) {
+			layer_date[n] = buffer[pos++];
+			layer_L[n] = buffer[pos++];
+			layer_flux[n] = buffer[pos++];
+		}
+	}
+}
+
+/**
+ * @brief Copy the layers of the pixels of a range of columns into the flat buffers
+ * @param snow_pixel all the pixels of the band
+ * @param ix_start first column (relative to the band)
+ * @param ix_end last column (excluded)
+ * @param fill if false, only count the layers, otherwise copy them into the buffers
+ */
+void LateralFlow::gatherLayers(const std::vector<SnowStation*>& snow_pixel, const size_t& ix_start, const size_t& ix_end, const bool& fill)
+{
+	for (size_t ix = ix_start; ix < ix_end; ix++) {
+		for (size_t iy = 0; iy < dimy; iy++) {
+			const SnowStation* pixel = snow_pixel[ix*dimy + iy];
+			const size_t cell = (ix+nr_halo_left)*dimy + iy;
+			const size_t nE = (pixel!=NULL)? pixel->getNumberOfElements() : 0;
+			if (!fill) {
+				layer_start[cell+1] = nE;
+				continue;
+			}
+			for (size_t n = 0; n < nE; n++) {
+				const size_t idx = layer_start[cell] + n;
+				layer_date[idx] = pixel->Edata[n].depositionDate.getJulian(true);
+				layer_L[idx] = pixel->Edata[n].L;
+				layer_flux[idx] = pixel->Edata[n].SlopeParFlux;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Find the layer of a pixel that receives the water coming from a layer deposited at a given date: this is
+ * the first layer that is not older, or the top layer if they are all older (never put water into an older layer).
+ * @param cell pixel in the extended band (it must have at least one layer)
+ * @param date deposition date of the source layer (gmt julian)
+ * @return index of the layer in the flat buffers
+ */
+size_t LateralFlow::findLayer(const size_t& cell, const double& date) const
+{
+	const size_t last = layer_start[cell+1] - 1;
+	for (size_t nn = layer_start[cell]; nn < last; nn++) {
+		if (layer_date[nn] >= date - Date::epsilon) return nn;
+	}
+	return last;
+}
+
+/**
+ * @brief Accumulate the source/sink terms of the pixels of a range of columns. The water that leaves a pixel
+ * is a sink term for this pixel while the water that enters a pixel is a source term for it. Each pixel
+ * only writes into its own layers.
+ * @param snow_pixel all the pixels of the band
+ * @param ix_start first column (relative to the band)
+ * @param ix_end last column (excluded)
+ */
+void LateralFlow::applyFlux(const std::vector<SnowStation*>& snow_pixel, const size_t& ix_start, const size_t& ix_end) const
+{
+	for (size_t ix = ix_start; ix < ix_end; ix++) {
+		for (size_t iy = 0; iy < dimy; iy++) {
+			const size_t idx = ix*dimy + iy;
+			SnowStation* pixel = snow_pixel[idx];
+			if (pixel == NULL) continue; //skipped cell
+			const size_t cell = (ix+nr_halo_left)*dimy + iy;
+			const size_t first = layer_start[cell];
+			if (layer_start[cell+1] == first) continue; //no layers
+
+			for (size_t kk = contrib_start[idx]; kk < contrib_start[idx+1]; kk++) {
+				const size_t src = contrib[kk];
+				if (src == cell) { //water leaving this pixel
+					const size_t dst = destination[cell];
+					if (dst == npos || layer_start[dst+1] == layer_start[dst]) continue;
+					for (size_t n = first; n < layer_start[cell+1]; n++) {
+						ElementData& elem = pixel->Edata[n - first];
+						elem.lwc_source -= layer_flux[n] * weight[cell];
+						elem.SlopeParFlux = 0.; //it has now been redistributed
+					}
+				} else { //water coming from an upstream pixel
+					for (size_t n = layer_start[src]; n < layer_start[src+1]; n++) {
+						const size_t nn = findLayer(cell, layer_date[n]);
+						pixel->Edata[nn - first].lwc_source += layer_flux[n] * weight[src] * (layer_L[n] / layer_L[nn]);
+					}
+				}
+			}
+		}
+	}
+}
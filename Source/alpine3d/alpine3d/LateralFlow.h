@@ -0,0 +1,76 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef LATERALFLOW_H
+#define LATERALFLOW_H
+
+#include <alpine3d/MPIControl.h>
+#include <meteoio/MeteoIO.h>
+#include <snowpack/libsnowpack.h>
+
+#include <vector>
+
+/**
+ * @class LateralFlow
+ * @brief Route the slope parallel water flux of each pixel to its downslope neighbour.
+ * The routing graph is built once from the DEM: each pixel drains into one of its 8 neighbours (D8), chosen from
+ * its slope azimuth (with the same convention as the pixels' metadata, ie cells without azimuth drain to the North).
+ * For each pixel, the graph contains its destination, the inverse of the distance to it (the edge weight) and the
+ * ordered list of the pixels that contribute to its source/sink term (its upstream pixels and itself).
+ *
+ * Each call to compute() then works in two phases. The layers of all the pixels of the band computed by the current
+ * process are first gathered into a flat buffer, together with the border columns of the neighbouring processes
+ * (the halo). These are exchanged with MPIControl::exchangeHalos() on a compact domain where each process owns only
+ * the first and last columns of its band, serialized and padded to the longest column of all processes. Then each pixel accumulates the water it receives and the water it loses into its own lwc_source,
+ * in a fixed order. Since a pixel only writes to its own layers, the OpenMP workers never write to the same pixel
+ * and the results do not depend on the number of workers or processes.
+ *
+ * As before, the water is put into the first layer of the destination pixel that is not older than the source
+ * layer (or into its top layer). The water volume is conserved: the sink term is the flux divided by the distance to
+ * the destination pixel and the source term is the same volume spread over the thickness of the receiving layer.
+ */
+class LateralFlow
+{
+	public:
+		LateralFlow(const mio::DEMObject& dem, const size_t& i_startx, const size_t& i_nx);
+
+		void compute(const std::vector<SnowStation*>& snow_pixel, const std::vector<size_t>& worker_startx, const std::vector<size_t>& worker_deltax);
+
+	private:
+		void packColumn(const std::vector<SnowStation*>& snow_pixel, const size_t& ix, std::vector<double>& buffer) const;
+		void readHaloColumn(const std::vector<double>& buffer, const size_t& ext_ix, const bool& fill);
+		void gatherLayers(const std::vector<SnowStation*>& snow_pixel, const size_t& ix_start, const size_t& ix_end, const bool& fill);
+		void applyFlux(const std::vector<SnowStation*>& snow_pixel, const size_t& ix_start, const size_t& ix_end) const;
+		size_t findLayer(const size_t& cell, const double& date) const;
+
+		static const size_t npos;
+
+		size_t dimy;
+		size_t startx, nx; ///< band computed by this process (global columns)
+		size_t ext_startx, ext_nx; ///< same band, extended by the halo columns
+		size_t nr_halo_left, nr_halo_right; ///< number of halo columns on each side (0 or 1)
+		MPIDomain borders_domain; ///< each process owns the first and last columns of its band, to exchange the halos
+
+		std::vector<size_t> destination; ///< for each cell of the extended band, index of its destination cell (or npos)
+		std::vector<double> weight; ///< for each cell of the extended band, inverse of the distance to its destination
+		std::vector<size_t> contrib_start, contrib; ///< for each cell of the band, the cells that contribute to its source/sink term
+
+		std::vector<size_t> layer_start; ///< for each cell of the extended band, index of its first layer in the buffers below
+		std::vector<double> layer_date, layer_L, layer_flux; ///< deposition date (gmt julian), thickness and slope parallel flux
+};
+
+#endif
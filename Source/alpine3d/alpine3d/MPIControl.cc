@@ -98,7 +98,7 @@ bool MPIControl::master() const
 }
 
 #ifdef ENABLE_MPI
-MPIControl::MPIControl()
+MPIControl::MPIControl() : rank_(0), size_(1), name_(), exchanged_bytes(0)
 {
 	MPI_Init(NULL, NULL);
 
@@ -154,6 +154,7 @@ void MPIControl::broadcast(std::string& message, const size_t& root)
 	if (rank_ != root) message.resize(msg_len);
 	ierr = MPI_Bcast(const_cast<char*>(message.c_str()), msg_len, MPI_CHAR, root, MPI_COMM_WORLD);
 	checkSuccess(ierr);
+	if (rank_ == root) exchanged_bytes += msg_len * (size_-1);
 }
 
 void MPIControl::send(std::string& message, const size_t& recipient, const int& tag)
@@ -166,6 +167,7 @@ void MPIControl::send(std::string& message, const size_t& recipient, const int&
 
 	ierr = MPI_Send(const_cast<char*>(message.c_str()), msg_len, MPI_CHAR, static_cast<int>(recipient), tag, MPI_COMM_WORLD);
 	checkSuccess(ierr);
+	exchanged_bytes += msg_len;
 }
 
 void MPIControl::receive(std::string& message, const size_t& source, const int& tag)
@@ -249,6 +251,130 @@ void MPIControl::barrier() const
 	MPI_Barrier(MPI_COMM_WORLD);
 }
 
+void MPIControl::allgather(mio::Array2D<double>& grid, const MPIDomain& domain)
+{
+	const std::vector<mio::Array2D<double>*> grids(1, &grid);
+	allgather(grids, domain);
+}
+
+void MPIControl::gather(mio::Array2D<double>& grid, const MPIDomain& domain, const size_t& root)
+{
+	const std::vector<mio::Array2D<double>*> grids(1, &grid);
+	gather(grids, domain, root);
+}
+
+void MPIControl::allgather(const std::vector<mio::Array2D<double>*>& grids, const MPIDomain& domain)
+{
+	if (size_ <= 1 || grids.empty()) return;
+	MIO_TRACE_ZONE("Alpine3D", "MPI allgather");
+
+	const size_t nr_grids = grids.size();
+	const size_t dimy = grids.front()->getNy();
+	std::vector<int> counts(size_), displs(size_);
+	size_t total = 0;
+	for (size_t ii=0; ii<size_; ii++) {
+		counts[ii] = static_cast<int>( domain.getWidth(ii) * dimy * nr_grids );
+		displs[ii] = static_cast<int>( total );
+		total += domain.getWidth(ii) * dimy * nr_grids;
+	}
+
+	//the bands of all grids are packed one after the other
+	const size_t band_size = domain.getWidth(rank_) * dimy;
+	std::vector<double> send_buffer( band_size * nr_grids );
+	for (size_t kk=0; kk<nr_grids && band_size>0; kk++)
+		packBand(*grids[kk], domain.getOffset(rank_), domain.getWidth(rank_), &send_buffer[kk*band_size]);
+	std::vector<double> recv_buffer(total);
+
+	const int ierr = MPI_Allgatherv(send_buffer.empty()? NULL : &send_buffer[0], counts[rank_], MPI_DOUBLE,
+	                                recv_buffer.empty()? NULL : &recv_buffer[0], &counts[0], &displs[0], MPI_DOUBLE, MPI_COMM_WORLD);
+	checkSuccess(ierr);
+	exchanged_bytes += send_buffer.size() * sizeof(double) * (size_-1);
+
+	for (size_t ii=0; ii<size_; ii++) {
+		if (ii == rank_ || counts[ii] == 0) continue;
+		const size_t recv_band = domain.getWidth(ii) * dimy;
+		for (size_t kk=0; kk<nr_grids; kk++)
+			unpackBand(&recv_buffer[displs[ii] + kk*recv_band], domain.getOffset(ii), domain.getWidth(ii), *grids[kk]);
+	}
+}
+
+void MPIControl::gather(const std::vector<mio::Array2D<double>*>& grids, const MPIDomain& domain, const size_t& root)
+{
+	if (size_ <= 1 || grids.empty()) return;
+	MIO_TRACE_ZONE("Alpine3D", "MPI gather");
+
+	const size_t nr_grids = grids.size();
+	const size_t dimy = grids.front()->getNy();
+	std::vector<int> counts(size_), displs(size_);
+	size_t total = 0;
+	for (size_t ii=0; ii<size_; ii++) {
+		counts[ii] = static_cast<int>( domain.getWidth(ii) * dimy * nr_grids );
+		displs[ii] = static_cast<int>( total );
+		total += domain.getWidth(ii) * dimy * nr_grids;
+	}
+
+	//the bands of all grids are packed one after the other
+	const size_t band_size = domain.getWidth(rank_) * dimy;
+	std::vector<double> send_buffer( band_size * nr_grids );
+	for (size_t kk=0; kk<nr_grids && band_size>0; kk++)
+		packBand(*grids[kk], domain.getOffset(rank_), domain.getWidth(rank_), &send_buffer[kk*band_size]);
+	std::vector<double> recv_buffer( (rank_ == root)? total : 0 );
+
+	const int ierr = MPI_Gatherv(send_buffer.empty()? NULL : &send_buffer[0], counts[rank_], MPI_DOUBLE,
+	                             recv_buffer.empty()? NULL : &recv_buffer[0], &counts[0], &displs[0], MPI_DOUBLE,
+	                             static_cast<int>(root), MPI_COMM_WORLD);
+	checkSuccess(ierr);
+
+	if (rank_ != root) {
+		exchanged_bytes += send_buffer.size() * sizeof(double);
+		return;
+	}
+	for (size_t ii=0; ii<size_; ii++) {
+		if (ii == rank_ || counts[ii] == 0) continue;
+		const size_t recv_band = domain.getWidth(ii) * dimy;
+		for (size_t kk=0; kk<nr_grids; kk++)
+			unpackBand(&recv_buffer[displs[ii] + kk*recv_band], domain.getOffset(ii), domain.getWidth(ii), *grids[kk]);
+	}
+}
+
+void MPIControl::exchangeHalos(mio::Array2D<double>& grid, const MPIDomain& domain)
+{
+	if (size_ <= 1 || domain.getHalo() == 0) return;
+	MIO_TRACE_ZONE("Alpine3D", "MPI exchangeHalos");
+
+	const size_t startx = domain.getOffset(rank_);
+	const size_t nx = domain.getWidth(rank_);
+	const size_t halo = domain.getHalo();
+	const int left = (rank_ > 0)? static_cast<int>(rank_-1) : MPI_PROC_NULL;
+	const int right = (rank_+1 < size_)? static_cast<int>(rank_+1) : MPI_PROC_NULL;
+	const size_t halo_left = (rank_ > 0)? std::min(halo, domain.getWidth(rank_-1)) : 0; //columns to receive from the left
+	const size_t halo_right = (rank_+1 < size_)? std::min(halo, domain.getWidth(rank_+1)) : 0; //columns to receive from the right
+	const size_t send_nx = std::min(halo, nx); //columns required by each neighbour from this band
+
+	std::vector<double> send_buffer, recv_buffer;
+	int ierr;
+
+	//send the last columns to the right neighbour, receive the last columns of the left neighbour
+	packBand(grid, startx+nx-send_nx, (right!=MPI_PROC_NULL)? send_nx : 0, send_buffer);
+	recv_buffer.resize(halo_left * grid.getNy());
+	ierr = MPI_Sendrecv(send_buffer.empty()? NULL : &send_buffer[0], static_cast<int>(send_buffer.size()), MPI_DOUBLE, right, 0,
+	                    recv_buffer.empty()? NULL : &recv_buffer[0], static_cast<int>(recv_buffer.size()), MPI_DOUBLE, left, 0,
+	                    MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	checkSuccess(ierr);
+	exchanged_bytes += send_buffer.size() * sizeof(double);
+	if (halo_left>0) unpackBand(&recv_buffer[0], startx-halo_left, halo_left, grid);
+
+	//send the first columns to the left neighbour, receive the first columns of the right neighbour
+	packBand(grid, startx, (left!=MPI_PROC_NULL)? send_nx : 0, send_buffer);
+	recv_buffer.resize(halo_right * grid.getNy());
+	ierr = MPI_Sendrecv(send_buffer.empty()? NULL : &send_buffer[0], static_cast<int>(send_buffer.size()), MPI_DOUBLE, left, 1,
+	                    recv_buffer.empty()? NULL : &recv_buffer[0], static_cast<int>(recv_buffer.size()), MPI_DOUBLE, right, 1,
+	                    MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	checkSuccess(ierr);
+	exchanged_bytes += send_buffer.size() * sizeof(double);
+	if (halo_right>0) unpackBand(&recv_buffer[0], startx+nx, halo_right, grid);
+}
+
 #else
 std::string getHostName() {
 	static const size_t len = 4096;
@@ -271,7 +397,7 @@ std::string getHostName() {
 	#endif
 }
 
-MPIControl::MPIControl() : rank_(0), size_(1), name_( getHostName() )
+MPIControl::MPIControl() : rank_(0), size_(1), name_( getHostName() ), exchanged_bytes(0)
 {
 	#ifdef _OPENMP
 		std::cout << "[i] Init of OpenMP on '" << name_ << "' with a pool of " << omp_get_max_threads() << " threads\n";
@@ -285,6 +411,11 @@ void MPIControl::reduce_min(double&, bool) {}
 void MPIControl::reduce_sum(double&, bool) {}
 void MPIControl::reduce_sum(int&, bool) {}
 void MPIControl::gather(const int& val, std::vector<int>& vec, const size_t&) { vec.resize(1, val); }
+void MPIControl::allgather(mio::Array2D<double>&, const MPIDomain&) {}
+void MPIControl::gather(mio::Array2D<double>&, const MPIDomain&, const size_t&) {}
+void MPIControl::allgather(const std::vector<mio::Array2D<double>*>&, const MPIDomain&) {}
+void MPIControl::gather(const std::vector<mio::Array2D<double>*>&, const MPIDomain&, const size_t&) {}
+void MPIControl::exchangeHalos(mio::Array2D<double>&, const MPIDomain&) {}
 #endif
 
 
@@ -420,6 +551,66 @@ MPIControl& MPIControl::instance()
 	return instance_;
 }
 
+MPIDomain MPIControl::getDomain(const size_t& dimx, const size_t& halo) const
+{
+	std::vector<size_t> offsets(size_), widths(size_);
+	for (size_t ii=0; ii<size_; ii++)
+		getArraySliceParams(dimx, size_, ii, offsets[ii], widths[ii]);
+	return MPIDomain(offsets, widths, dimx, halo);
+}
+
+MPIDomain MPIControl::getDomainOptim(const mio::DEMObject& dem, const mio::Grid2DObject& landuse, const size_t& halo)
+{
+	const size_t dimx = dem.getNx();
+	std::vector<size_t> offsets(size_), widths(size_);
+	for (size_t ii=0; ii<size_; ii++)
+		getArraySliceParamsOptim(dimx, ii, offsets[ii], widths[ii], dem, landuse);
+	return MPIDomain(offsets, widths, dimx, halo);
+}
+
+/**
+ * @brief Copy the columns [startx, startx+nx[ of a grid into a contiguous buffer
+ * @param[in] grid grid to copy from
+ * @param[in] startx first column to copy
+ * @param[in] nx number of columns to copy
+ * @param[out] buffer contiguous buffer, resized to hold nx*dimy values
+ */
+void MPIControl::packBand(const mio::Array2D<double>& grid, const size_t& startx, const size_t& nx, std::vector<double>& buffer)
+{
+	buffer.resize(nx * grid.getNy());
+	if (!buffer.empty()) packBand(grid, startx, nx, &buffer[0]);
+}
+
+/**
+ * @brief Copy the columns [startx, startx+nx[ of a grid into a contiguous buffer
+ * @param[in] grid grid to copy from
+ * @param[in] startx first column to copy
+ * @param[in] nx number of columns to copy
+ * @param[out] buffer contiguous buffer that can hold at least nx*dimy values
+ */
+void MPIControl::packBand(const mio::Array2D<double>& grid, const size_t& startx, const size_t& nx, double* buffer)
+{
+	const size_t dimy = grid.getNy();
+	for (size_t jj=0; jj<dimy; jj++)
+		for (size_t ii=0; ii<nx; ii++)
+			buffer[jj*nx + ii] = grid(startx+ii, jj);
+}
+
+/**
+ * @brief Copy a contiguous buffer back into the columns [startx, startx+nx[ of a grid
+ * @param[in] buffer contiguous buffer as filled by packBand()
+ * @param[in] startx first column to fill
+ * @param[in] nx number of columns to fill
+ * @param[in,out] grid grid to fill
+ */
+void MPIControl::unpackBand(const double* buffer, const size_t& startx, const size_t& nx, mio::Array2D<double>& grid)
+{
+	const size_t dimy = grid.getNy();
+	for (size_t jj=0; jj<dimy; jj++)
+		for (size_t ii=0; ii<nx; ii++)
+			grid(startx+ii, jj) = buffer[jj*nx + ii];
+}
+
 void MPIControl::getArraySliceParams(const size_t& dimx, const size_t& nbworkers, const size_t& idx_wk, size_t& startx_sub, size_t& nx_sub)
 {
 	if (nbworkers < dimx) {
@@ -29,6 +29,48 @@
 #include <meteoio/MeteoIO.h>
 #include <cstdio>
 
+/**
+ * @class MPIDomain
+ * @brief Description of the decomposition of a grid along x between the MPI processes.
+ * Each process owns a contiguous band of columns and might additionally require a few columns
+ * from its neighbours (its halo). The decomposition is described once and then given to the slice
+ * exchanges of MPIControl (allgather(), gather() and exchangeHalos()), so only the owned bands
+ * (and not full grids) are transfered between the processes.
+ */
+class MPIDomain
+{
+	public:
+		MPIDomain() : offsets(1, 0), widths(1, 0), dimx(0), halo(0) {}
+
+		/**
+		 * @brief Constructor
+		 * @param[in] i_offsets first owned column for each process
+		 * @param[in] i_widths number of owned columns for each process
+		 * @param[in] i_dimx total number of columns of the grid
+		 * @param[in] i_halo number of columns that each process requires on each side of its band
+		 */
+		MPIDomain(const std::vector<size_t>& i_offsets, const std::vector<size_t>& i_widths, const size_t& i_dimx, const size_t& i_halo=0)
+		         : offsets(i_offsets), widths(i_widths), dimx(i_dimx), halo(i_halo)
+		{
+			if (offsets.size()!=widths.size())
+				throw mio::InvalidArgumentException("Each process must have an offset and a width", AT);
+		}
+
+		size_t getNProcesses() const {return offsets.size();}
+		size_t getDimX() const {return dimx;}
+		size_t getHalo() const {return halo;}
+		size_t getOffset(const size_t& rank) const {return offsets[rank];}
+		size_t getWidth(const size_t& rank) const {return widths[rank];}
+		/** @brief First column (owned or halo) required by the given process */
+		size_t getHaloStart(const size_t& rank) const {return (offsets[rank]>halo)? offsets[rank]-halo : 0;}
+		/** @brief One past the last column (owned or halo) required by the given process */
+		size_t getHaloEnd(const size_t& rank) const {return std::min(offsets[rank]+widths[rank]+halo, dimx);}
+
+	private:
+		std::vector<size_t> offsets, widths;
+		size_t dimx, halo;
+};
+
 /**
  * @class MPIControl
  * @brief A singleton class that deals with all aspects of parallelization within Alpine3D (MPI, OpenMP, PETSc)
@@ -131,6 +173,72 @@ class MPIControl
 		void reduce_sum(int& value, const bool all=true);
 		//@}
 
+		/**
+		 * @brief Describe the balanced decomposition of a grid of dimx columns (see getArraySliceParams())
+		 * @param[in] dimx number of columns of the grid
+		 * @param[in] halo number of columns that each process requires on each side of its band
+		 * @return decomposition for all processes
+		 */
+		MPIDomain getDomain(const size_t& dimx, const size_t& halo=0) const;
+
+		/**
+		 * @brief Describe the decomposition of a grid, balancing the number of cells to compute (see getArraySliceParamsOptim())
+		 * @param[in] dem DEM used in the model
+		 * @param[in] landuse Landuse grid used in the model, nodata in landuse should indicate where no computation is required
+		 * @param[in] halo number of columns that each process requires on each side of its band
+		 * @return decomposition for all processes
+		 */
+		MPIDomain getDomainOptim(const mio::DEMObject& dem, const mio::Grid2DObject& landuse, const size_t& halo=0);
+
+		/**
+		 * @brief Each process contributes its own band of the grid and receives all other bands, so all processes
+		 * hold the full grid. Contrary to reduce_sum() only the owned bands are transfered.
+		 * @param[in,out] grid grid of the full domain, only the band owned by the calling process has to be valid
+		 * @param[in] domain decomposition of the grid
+		 */
+		void allgather(mio::Array2D<double>& grid, const MPIDomain& domain);
+
+		/**
+		 * @brief Collect the bands of all processes on the root process (for example to write the grid out).
+		 * The other processes are left untouched.
+		 * @param[in,out] grid grid of the full domain, only the band owned by the calling process has to be valid
+		 * @param[in] domain decomposition of the grid
+		 * @param[in] root The process rank that will gather the bands
+		 */
+		void gather(mio::Array2D<double>& grid, const MPIDomain& domain, const size_t& root = 0);
+
+		/**
+		 * @brief Same as allgather() for a batch of grids: the bands of all the grids are exchanged in one collective call
+		 * @param[in,out] grids grids of the full domain (all with the same dimensions)
+		 * @param[in] domain decomposition of the grids
+		 */
+		void allgather(const std::vector<mio::Array2D<double>*>& grids, const MPIDomain& domain);
+
+		/**
+		 * @brief Same as gather() for a batch of grids: the bands of all the grids are collected in one collective call
+		 * @param[in,out] grids grids of the full domain (all with the same dimensions)
+		 * @param[in] domain decomposition of the grids
+		 * @param[in] root The process rank that will gather the bands
+		 */
+		void gather(const std::vector<mio::Array2D<double>*>& grids, const MPIDomain& domain, const size_t& root = 0);
+
+		/**
+		 * @brief Exchange the halos with the neighbouring processes: each process sends the border columns of
+		 * its band and receives the columns of its neighbours that are within its halo.
+		 * @param[in,out] grid grid of the full domain, only the band owned by the calling process has to be valid
+		 * @param[in] domain decomposition of the grid
+		 * @note the halo is limited to the width of the neighbouring bands
+		 */
+		void exchangeHalos(mio::Array2D<double>& grid, const MPIDomain& domain);
+
+		/**
+		 * @brief Number of bytes sent by the calling process since the last call to resetExchangedBytes().
+		 * This covers all the exchanges performed through this class.
+		 * @return number of bytes
+		 */
+		size_t getExchangedBytes() const {return exchanged_bytes;}
+		void resetExchangedBytes() {exchanged_bytes = 0;}
+
 		/**
 		 * This method is used when deserializing a class T from a void* representing a char*,
 		 * instantiating an object from a string
@@ -203,6 +311,7 @@ class MPIControl
 		template <class T> void reduce_sum(T& obj, const bool all=true)
 		{
 			if (size_ <= 1) return;
+			MIO_TRACE_ZONE("Alpine3D", "MPI reduce_sum");
 
 			MPI_Op op;
 			MPI_Op_create(op_sum_func<T>, true, &op);
@@ -212,6 +321,7 @@ class MPIControl
 
 			const size_t len = serialize(&in_obj_char, obj, true);
 			out_obj_char = new char[len];
+			exchanged_bytes += len;
 
 			MPI_Datatype chars_datatype;
 			MPI_Type_contiguous(static_cast<int>(len), MPI_CHAR, &chars_datatype);
@@ -242,6 +352,7 @@ class MPIControl
 		template <class T> void broadcast(T& obj, const size_t& root = 0)
 		{
 			if (size_ <= 1) return;
+			MIO_TRACE_ZONE("Alpine3D", "MPI broadcast");
 
 			std::string obj_string;
 
@@ -274,6 +385,7 @@ class MPIControl
 		template <class T> void broadcast(std::vector<T>& vec_obj, const size_t& root = 0)
 		{
 			if (size_ <= 1) return;
+			MIO_TRACE_ZONE("Alpine3D", "MPI broadcast");
 
 			std::string obj_string;
 			size_t vec_size;
@@ -407,6 +519,7 @@ class MPIControl
 		template <class T> void gather(std::vector<T*>& vec_local, const size_t& root = 0)
 		{
 			if (size_ <= 1) return;
+			MIO_TRACE_ZONE("Alpine3D", "MPI gather");
 
 			std::vector<int> vec_sizes;
 			const size_t sum = vec_local.size();
@@ -500,10 +613,14 @@ class MPIControl
 		void receive(int& value, const size_t& source, const int& tag=0);
 
 		static void checkSuccess(const int& ierr);
+		static void packBand(const mio::Array2D<double>& grid, const size_t& startx, const size_t& nx, std::vector<double>& buffer);
+		static void packBand(const mio::Array2D<double>& grid, const size_t& startx, const size_t& nx, double* buffer);
+		static void unpackBand(const double* buffer, const size_t& startx, const size_t& nx, mio::Array2D<double>& grid);
 
 		size_t rank_;          // the rank of this process
 		size_t size_;          // the number of all processes
 		std::string name_;  // the name of the node this process is running on
+		size_t exchanged_bytes; // the number of bytes sent by this process since the last reset
 };
 
 #endif
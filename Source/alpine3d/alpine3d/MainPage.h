@@ -38,6 +38,7 @@
  *        -# \subpage glaciers "Glaciers katabatic flows"
  *        -# \subpage techsnowA3D "Technical snow production"
  *     -# \subpage running_simulations "Running a simulation"
+ *     -# \subpage benchmark "Synthetic domain benchmark"
  * -# Expanding Alpine3D
  *        -# \subpage coding_style "Coding style"
  * 
@@ -281,6 +281,7 @@ void MeteoObj::fillMeteoGrids(const Date& calcDate)
 
 void MeteoObj::getMeteo(const Date& calcDate)
 {
+	MIO_TRACE_ZONE("Alpine3D", "getMeteo");
 	//Note: in case of MPI simulation only master node is responsible for file I/O
 	if (!MPIControl::instance().master()) return;
 
@@ -0,0 +1,124 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <alpine3d/OutputQueue.h>
+#include <meteoio/MeteoIO.h>
+
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Constructor
+ * @param enable if false, no writer thread is started and the jobs are run synchronously
+ * @param max_jobs maximum number of jobs that can be pending (including the one being processed), at least 1
+ */
+OutputQueue::OutputQueue(const bool& enable, const size_t& max_jobs)
+            : jobs(), mtx(), cv_jobs(), cv_slots(), writer(), error_msg(), max_pending( (max_jobs>0)? max_jobs : 1 ),
+              async(enable), stop(false), busy(false)
+{
+	if (async) writer = std::thread(&OutputQueue::run, this);
+}
+
+OutputQueue::~OutputQueue()
+{
+	if (!async) return;
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		stop = true;
+	}
+	cv_jobs.notify_all();
+	writer.join(); //the writer only leaves once all the pending jobs have been processed
+
+	if (!error_msg.empty())
+		std::cerr << "[E] Output failed: " << error_msg << "\n";
+}
+
+/**
+ * @brief Submit a new output job
+ * @details This blocks while the queue is full. Since the job will run later, it must not reference data
+ * that the caller is going to modify or destroy.
+ * @param job job to run
+ */
+void OutputQueue::push(const std::function<void()>& job)
+{
+	if (!async) {
+		job();
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv_slots.wait(lock, [this]{ return (jobs.size() + (busy? 1 : 0)) < max_pending || !error_msg.empty(); });
+		checkError();
+		jobs.push_back( job );
+	}
+	cv_jobs.notify_one();
+}
+
+/**
+ * @brief Wait until all the pending jobs have been processed
+ * @details This rethrows the error of a failed job, if any.
+ */
+void OutputQueue::flush()
+{
+	if (!async) return;
+
+	std::unique_lock<std::mutex> lock(mtx);
+	cv_slots.wait(lock, [this]{ return jobs.empty() && !busy; });
+	checkError();
+}
+
+//must be called with the lock held
+void OutputQueue::checkError()
+{
+	if (error_msg.empty()) return;
+
+	const std::string msg( error_msg );
+	error_msg.clear(); //so the error is only reported once
+	throw mio::IOException("Output failed: " + msg, AT);
+}
+
+void OutputQueue::run()
+{
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv_jobs.wait(lock, [this]{ return stop || !jobs.empty(); });
+			if (jobs.empty()) return; //stop has been requested and all jobs have been processed
+			job = jobs.front();
+			jobs.pop_front();
+			busy = true;
+		}
+
+		std::string msg;
+		try {
+			job();
+		} catch (const std::exception& e) {
+			msg = e.what();
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			busy = false;
+			if (!msg.empty() && error_msg.empty()) error_msg = msg;
+		}
+		cv_slots.notify_all();
+	}
+}
@@ -0,0 +1,68 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OUTPUTQUEUE_H
+#define OUTPUTQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class OutputQueue
+ * @brief Bounded, single consumer queue of output jobs.
+ * The jobs are executed in submission order by one background thread so the caller can proceed with the next
+ * simulation step while the previous outputs are being formatted and written. Each job must own the data it works on
+ * (ie a snapshot of the model state), since the model keeps evolving while the job runs.
+ *
+ * At most max_jobs jobs are pending at any time: when the queue is full, push() blocks until the writer
+ * thread has freed a slot, thus bounding the memory used by the snapshots (max_jobs=2 is the usual double buffering).
+ * When the queue is disabled, the jobs are run immediately in the calling thread.
+ *
+ * If a job throws, the error is kept and rethrown (as an mio::IOException) by the next call to push() or flush().
+ * The destructor flushes all pending jobs before returning.
+ */
+class OutputQueue
+{
+	public:
+		OutputQueue(const bool& enable, const size_t& max_jobs=2);
+		~OutputQueue();
+
+		void push(const std::function<void()>& job);
+		void flush();
+		bool isAsync() const {return async;}
+
+	private:
+		OutputQueue(const OutputQueue&);
+		OutputQueue& operator=(const OutputQueue&);
+
+		void run();
+		void checkError();
+
+		std::deque< std::function<void()> > jobs;
+		std::mutex mtx;
+		std::condition_variable cv_jobs, cv_slots;
+		std::thread writer;
+		std::string error_msg; ///< message of the first failed job, empty if none
+		const size_t max_pending;
+		bool async, stop, busy;
+};
+
+#endif
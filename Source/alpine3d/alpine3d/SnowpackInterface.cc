@@ -22,10 +22,41 @@
 
 #include <errno.h>
 #include <algorithm>
+#include <memory>
 
 using namespace std;
 using namespace mio;
 
+namespace {
+//data handed over to the output queue, it is deleted once written out if owned
+struct PointsSnapshot {
+	PointsSnapshot(const bool& i_owned) : snow_pixel(), meteo_pixel(), surface_flux(), owned(i_owned) {}
+	~PointsSnapshot() {
+		if (!owned) return;
+		for (size_t ii=0; ii<snow_pixel.size(); ii++) delete snow_pixel[ii];
+		for (size_t ii=0; ii<meteo_pixel.size(); ii++) delete meteo_pixel[ii];
+		for (size_t ii=0; ii<surface_flux.size(); ii++) delete surface_flux[ii];
+	}
+
+	std::vector<SnowStation*> snow_pixel;
+	std::vector<CurrentMeteo*> meteo_pixel;
+	std::vector<SurfaceFluxes*> surface_flux;
+	const bool owned;
+
+	private:
+		PointsSnapshot(const PointsSnapshot&);
+		PointsSnapshot& operator=(const PointsSnapshot&);
+};
+
+//deep copy of objects still owned by somebody else
+template <class T> void copyPointers(const std::vector<T*>& vec_in, std::vector<T*>& vec_out)
+{
+	vec_out.reserve( vec_in.size() );
+	for (size_t ii=0; ii<vec_in.size(); ii++)
+		vec_out.push_back( (vec_in[ii]!=NULL)? new T( *vec_in[ii] ) : NULL );
+}
+}
+
 const std::vector<std::string> SnowpackInterface::grids_not_computed_in_worker{
 "TA",
 "RH",
@@ -100,19 +131,19 @@ SnowpackInterface::SnowpackInterface(const mio::Config& io_cfg, const size_t& nb
                                      const bool is_restart_in)
                 : run_info(), io(io_cfg), pts(prepare_pts(vec_pts)),dem(dem_in),
                   is_restart(is_restart_in), useCanopy(false), enable_simple_snow_drift(false), enable_lateral_flow(false), a3d_view(false),
-                  do_io_locally(true), station_name(),glacier_katabatic_flow(false), snow_production(false), snow_grooming(false),
+                  do_io_locally(true), async_output(true), station_name(),glacier_katabatic_flow(false), snow_production(false), snow_grooming(false),
                   Tsoil_idx(), grids_start(0), grids_days_between(0), ts_start(0.), ts_days_between(0.), prof_start(0.), prof_days_between(0.),
                   grids_write(true), ts_write(false), prof_write(false), snow_write(false), write_poi_meteo(true), snow_poi_written(false), glacier_from_grid(false),
                   meteo_outpath(), outpath(), mask_glaciers(false), mask_dynamic(false), maskGlacier(), tz_out(0.),
-                  sn_cfg(readAndTweakConfig(io_cfg, !pts.empty())), snowpackIO(sn_cfg), dimx(dem_in.getNx()), dimy(dem_in.getNy()), mpi_offset(0), mpi_nx(dimx),
+                  sn_cfg(readAndTweakConfig(io_cfg, !pts.empty())), snowpackIO(sn_cfg), dimx(dem_in.getNx()), dimy(dem_in.getNy()), mpi_offset(0), mpi_nx(dimx), mpi_domain(),
                   landuse(landuse_in), mns(dem_in, IOUtils::nodata), shortwave(dem_in, IOUtils::nodata), longwave(dem_in, IOUtils::nodata), diffuse(dem_in, IOUtils::nodata),
                   terrain_shortwave(dem_in, IOUtils::nodata), terrain_longwave(dem_in, IOUtils::nodata),
                   psum(dem_in, IOUtils::nodata), psum_ph(dem_in, IOUtils::nodata), psum_tech(dem_in, IOUtils::nodata), grooming(dem_in, IOUtils::nodata),
                   vw(dem_in, IOUtils::nodata), vw_drift(dem_in, IOUtils::nodata), dw(dem_in, IOUtils::nodata), rh(dem_in, IOUtils::nodata),
                   ta(dem_in, IOUtils::nodata), tsg(dem_in, IOUtils::nodata), init_glaciers_height(dem_in, IOUtils::nodata), winderosiondeposition(dem_in, 0),
                   solarElevation(0.), output_grids(), workers(nbworkers), worker_startx(nbworkers), worker_deltax(nbworkers), worker_stations_coord(nbworkers),
-                  timer(), nextStepTimestamp(startTime), timeStep(dt_main/86400.), dataMeteo2D(false), dataDa(false), dataSnowDrift(false), dataRadiation(false),
-                  drift(NULL), eb(NULL), da(NULL), runoff(NULL), glaciers(NULL), techSnow(NULL)
+                  grids_cache(), iswr_dir(), timer(), nextStepTimestamp(startTime), timeStep(dt_main/86400.), dataMeteo2D(false), dataDa(false), dataSnowDrift(false), dataRadiation(false),
+                  drift(NULL), eb(NULL), da(NULL), runoff(NULL), glaciers(NULL), techSnow(NULL), output_queue(NULL), lateral_flow(NULL)
 {
 	MPIControl& mpicontrol = MPIControl::instance();
 
@@ -199,6 +230,7 @@ SnowpackInterface::SnowpackInterface(const mio::Config& io_cfg, const size_t& nb
 
 	//If MPI is active, every node gets a slice of the DEM to work on
 	mpicontrol.getArraySliceParamsOptim(dimx, mpi_offset, mpi_nx,dem,landuse);
+	mpi_domain = mpicontrol.getDomainOptim(dem, landuse);
 	std::cout << "[i] MPI instance "<< mpicontrol.rank() <<" for solving snowpack : grid range = ["
 	<< mpi_offset << " to " << mpi_offset+mpi_nx-1 << "] " << mpi_nx << " columns\n";
 	//Cut DEM and landuse in MPI domain, MPI domain are computed
@@ -265,6 +297,9 @@ SnowpackInterface::SnowpackInterface(const mio::Config& io_cfg, const size_t& nb
 		}
 	}
 
+	//the routing graph only depends on the DEM, so it is built once
+	if (enable_lateral_flow) lateral_flow = new LateralFlow(dem, mpi_offset, mpi_nx);
+
 	// init glacier map (after creating and init workers) for output
 	if (mask_glaciers || glacier_katabatic_flow) {
 		maskGlacier = getGrid(SnGrids::GLACIER);
@@ -280,6 +315,9 @@ SnowpackInterface::SnowpackInterface(const mio::Config& io_cfg, const size_t& nb
 	if (snow_production || snow_grooming) {
 		techSnow = new TechSnowA3D(io_cfg, dem);
 	}
+
+	//from now on, snowpackIO is only used through the output queue
+	output_queue = new OutputQueue(async_output);
 }
 
 SnowpackInterface& SnowpackInterface::operator=(const SnowpackInterface& source) {
@@ -310,6 +348,8 @@ SnowpackInterface& SnowpackInterface::operator=(const SnowpackInterface& source)
 		workers = source.workers;
 		worker_startx = source.worker_startx;
 		worker_deltax = source.worker_deltax;
+		grids_cache = source.grids_cache;
+		iswr_dir = source.iswr_dir;
 		timer = source.timer;
 		nextStepTimestamp = source.nextStepTimestamp;
 		timeStep = source.timeStep;
@@ -334,6 +374,7 @@ SnowpackInterface& SnowpackInterface::operator=(const SnowpackInterface& source)
 		snow_production = source.snow_production;
 		glaciers = source.glaciers;
 		techSnow = source.techSnow;
+		lateral_flow = source.lateral_flow;
 		enable_lateral_flow = source.enable_lateral_flow;
 		a3d_view = source.a3d_view;
 
@@ -342,6 +383,7 @@ SnowpackInterface& SnowpackInterface::operator=(const SnowpackInterface& source)
 		is_restart = source.is_restart;
 		useCanopy = source.useCanopy;
 		do_io_locally = source.do_io_locally;
+		async_output = source.async_output;
 		station_name = source.station_name;
 
 		Tsoil_idx = source.Tsoil_idx;
@@ -406,6 +448,7 @@ mio::Config SnowpackInterface::readAndTweakConfig(const mio::Config& io_cfg, con
 	tmp_cfg.getValue("PROF_START", "Output", prof_start);
 	tmp_cfg.getValue("PROF_DAYS_BETWEEN", "Output", prof_days_between);
 	tmp_cfg.getValue("WRITE_POI_METEO", "Output", write_poi_meteo, IOUtils::nothrow);
+	tmp_cfg.getValue("ASYNC_OUTPUT", "Output", async_output, IOUtils::nothrow);
 
 	tmp_cfg.getValue("METEOPATH", "Output", meteo_outpath);
 	tmp_cfg.getValue("TIME_ZONE", "Output", tz_out, IOUtils::nothrow);
@@ -423,7 +466,9 @@ mio::Config SnowpackInterface::readAndTweakConfig(const mio::Config& io_cfg, con
  */
 SnowpackInterface::~SnowpackInterface()
 {
+	delete output_queue; //this writes out all pending outputs
 	if (glacier_katabatic_flow) delete glaciers;
+	delete lateral_flow;
 	//if (runoff) delete runoff;
 	while (!workers.empty()) delete workers.back(), workers.pop_back();
 }
@@ -449,19 +494,30 @@ double SnowpackInterface::getTiming() const
  */
 void SnowpackInterface::writeOutput(const mio::Date& date)
 {
+	MIO_TRACE_ZONE("Alpine3D", "writeOutput");
 	MPIControl& mpicontrol = MPIControl::instance();
 	const bool isMaster = mpicontrol.master();
 
 	if (do_grid_output(date)) {
-		//no OpenMP pragma here, otherwise multiple threads might call an MPI reduce_sum()
-		for (size_t ii=0; ii<output_grids.size(); ii++) {
-			const size_t SnGrids_idx = SnGrids::getParameterIndex( output_grids[ii] );
-			mio::Grid2DObject grid( getGrid( static_cast<SnGrids::Parameters>(SnGrids_idx)) );
+		//all the output grids are gathered at once, only the master writes them
+		std::vector<SnGrids::Parameters> params( output_grids.size() );
+		for (size_t ii=0; ii<output_grids.size(); ii++)
+			params[ii] = static_cast<SnGrids::Parameters>( SnGrids::getParameterIndex( output_grids[ii] ) );
+		gatherGrids(params, false);
 
+		//no OpenMP pragma here: MeteoIO serializes the calls to the output grids plugin anyway
+		for (size_t ii=0; ii<output_grids.size(); ii++) {
 			if (isMaster) {
-				if (mask_glaciers) grid *= maskGlacier;
+				mio::Grid2DObject masked_grid;
+				const mio::Grid2DObject* grid_ptr = &getGridView(params[ii], false);
+				if (mask_glaciers) {
+					masked_grid = *grid_ptr;
+					masked_grid *= maskGlacier;
+					grid_ptr = &masked_grid;
+				}
+				const mio::Grid2DObject& grid = *grid_ptr;
 				const size_t meteoGrids_idx = MeteoGrids::getParameterIndex( output_grids[ii] );
-				if (meteoGrids_idx!=IOUtils::npos) { //for this, the grid plugins must be thread-safe!
+				if (meteoGrids_idx!=IOUtils::npos) {
 					io.write2DGrid(grid, static_cast<MeteoGrids::Parameters>(meteoGrids_idx), date);
 				} else {
 					std::string grid_type;
@@ -507,6 +563,24 @@ bool SnowpackInterface::do_grid_output(const mio::Date &date) const
 	return (grids_write && booleanTime(date.getJulian(), grids_days_between, grids_start, dt_main/60.));
 }
 
+/**
+ * @brief Method tells if on given date, the special points' time series should be written
+ * @param date is the date object which is controlled, if output needs to be done
+ */
+bool SnowpackInterface::do_ts_output(const mio::Date &date) const
+{
+	return (ts_write && booleanTime(date.getJulian(), ts_days_between, ts_start, dt_main/60.));
+}
+
+/**
+ * @brief Method tells if on given date, the special points' profiles should be written
+ * @param date is the date object which is controlled, if output needs to be done
+ */
+bool SnowpackInterface::do_prof_output(const mio::Date &date) const
+{
+	return (prof_write && booleanTime(date.getJulian(), prof_days_between, prof_days_between, dt_main/60));
+}
+
 /**
  * @brief commands worker to write .sno files. Is triggered by Alpine Control
  *
@@ -525,7 +599,7 @@ void SnowpackInterface::writeOutputSNO(const mio::Date& date)
 
 	if (mpicontrol.master()) {
 		std::cout << "[i] Writing SNO output for process " << mpicontrol.master_rank() << "\n";
-		writeSnowCover(date, snow_station); //local data
+		pushSnowCover(date, snow_station, false); //local data
 
 		//Now gather all elements on the master node
 		for (size_t ii=0; ii<mpicontrol.size(); ii++) {
@@ -534,13 +608,12 @@ void SnowpackInterface::writeOutputSNO(const mio::Date& date)
 			vector<SnowStation*> snow_station_tmp;
 
 			mpicontrol.receive(snow_station_tmp, ii);
-			writeSnowCover(date, snow_station_tmp);
-			for (size_t jj=0; jj<snow_station_tmp.size(); jj++) delete snow_station_tmp[jj];
+			pushSnowCover(date, snow_station_tmp, true);
 		}
 	} else {
 		if (do_io_locally) {
 			std::cout << "[i] Writing SNO output for process " << mpicontrol.rank() << "\n";
-			writeSnowCover(date, snow_station); //local data
+			pushSnowCover(date, snow_station, false); //local data
 		} else {
 			mpicontrol.send(snow_station, mpicontrol.master_rank());
 		}
@@ -553,6 +626,25 @@ void SnowpackInterface::writeSnowCover(const mio::Date& date, const std::vector<
 		snowpackIO.writeSnowCover(date, *(snow_station[jj]), ZwischenData());
 }
 
+/**
+ * @brief Hand the snow cover of the given stations over to the output queue
+ * @param date Output date
+ * @param snow_station stations to write out. This vector is emptied.
+ * @param owned if true, the stations belong to the caller and will be deleted once written out. Otherwise they belong to
+ * the workers and are copied if the output is asynchronous.
+ */
+void SnowpackInterface::pushSnowCover(const mio::Date& date, std::vector<SnowStation*>& snow_station, const bool& owned)
+{
+	std::shared_ptr<PointsSnapshot> data( new PointsSnapshot(owned || output_queue->isAsync()) );
+	if (owned || !output_queue->isAsync())
+		data->snow_pixel.swap( snow_station );
+	else
+		copyPointers(snow_station, data->snow_pixel);
+	snow_station.clear();
+
+	output_queue->push( [this, date, data]() { writeSnowCover(date, data->snow_pixel); } );
+}
+
 /* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
    Methods to set references to other methodes
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% */
@@ -577,12 +669,9 @@ void SnowpackInterface::setSnowDrift()
 {
 	if (drift) {
 		// Provide snow parameters to SnowDrift
-		const Grid2DObject cH( getGrid(SnGrids::HS) );
-		const Grid2DObject sp( getGrid(SnGrids::SP) );
-		const Grid2DObject rg( getGrid(SnGrids::RG) );
-		const Grid2DObject N3( getGrid(SnGrids::N3) );
-		const Grid2DObject rb( getGrid(SnGrids::RB) );
-		drift->setSnowSurfaceData(cH, sp, rg, N3, rb);
+		const SnGrids::Parameters params[5] = {SnGrids::HS, SnGrids::SP, SnGrids::RG, SnGrids::N3, SnGrids::RB};
+		gatherGrids( std::vector<SnGrids::Parameters>(params, params+5) );
+		drift->setSnowSurfaceData(getGridView(SnGrids::HS), getGridView(SnGrids::SP), getGridView(SnGrids::RG), getGridView(SnGrids::N3), getGridView(SnGrids::RB));
 	}
 }
 
@@ -607,8 +696,7 @@ void SnowpackInterface::setEnergyBalance()
 {
 	if (eb) {
 		// Provide albedo to EnergyBalance
-		const Grid2DObject alb( getGrid(SnGrids::TOP_ALB) );
-		eb->setAlbedo(alb);
+		eb->setAlbedo( getGridView(SnGrids::TOP_ALB) );
 	}
 }
 
@@ -709,6 +797,7 @@ void SnowpackInterface::setSnowMassChange(const mio::Grid2DObject& new_mns, cons
  */
 void SnowpackInterface::setMeteo(const Grid2DObject& new_psum, const Grid2DObject& new_psum_ph, const Grid2DObject& new_vw, const Grid2DObject& new_dw, const Grid2DObject& new_rh, const Grid2DObject& new_ta, const Grid2DObject& new_tsg, const mio::Date& timestamp)
 {
+	MIO_TRACE_ZONE("Alpine3D", "SnowpackSetMeteo");
 	if (nextStepTimestamp != timestamp) {
 		if (MPIControl::instance().master()) {
 			std::cerr << "Providing meteo fields at " << timestamp.toString(Date::ISO);
@@ -728,15 +817,14 @@ void SnowpackInterface::setMeteo(const Grid2DObject& new_psum, const Grid2DObjec
 		ta = new_ta;
 	} else {
 		if (mask_dynamic) glaciers->setGlacierMap(maskGlacier);
-		const Grid2DObject TSS( getGrid(SnGrids::TSS) );
-		const Grid2DObject cH( getGrid(SnGrids::HS) );
-		ta = glaciers->correctTemperatures(cH, TSS, new_ta);
+		const SnGrids::Parameters params[2] = {SnGrids::TSS, SnGrids::HS};
+		gatherGrids( std::vector<SnGrids::Parameters>(params, params+2) );
+		ta = glaciers->correctTemperatures(getGridView(SnGrids::HS), getGridView(SnGrids::TSS), new_ta);
 	}
 	tsg = new_tsg;
 
 	if (snow_production || snow_grooming) {
-		const Grid2DObject cH( getGrid(SnGrids::HS) );
-		techSnow->setMeteo(new_ta, new_rh, cH, timestamp);
+		techSnow->setMeteo(new_ta, new_rh, getGridView(SnGrids::HS), timestamp);
 		psum_tech = techSnow->getGrid(SnGrids::PSUM_TECH);
 		grooming = techSnow->getGrid(SnGrids::GROOMING);
 	}
@@ -795,9 +883,26 @@ void SnowpackInterface::setRadiationComponents(const mio::Array2D<double>& short
 /**
  * @brief Request specific grid by parameter type
  * @param param parameter
+ * @param all_processes if true, the full grid is available on all processes, otherwise only on the master process
+ * (the other processes then only hold their own band)
  * @return 2D output grid (empty if the requested parameter was not available)
  */
-mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param) const
+mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param, const bool& all_processes) const
+{
+	return getGridView(param, all_processes);
+}
+
+/**
+ * @brief Request specific grid by parameter type, without copying it
+ * @details The grids computed by the workers are gathered once per time step (see gatherGrids()) and then kept,
+ * so repeated requests for the same parameter within a time step do not merge and exchange the grid again.
+ * @param param parameter
+ * @param all_processes if true, the full grid is available on all processes, otherwise only on the master process
+ * (the other processes then only hold their own band)
+ * @return 2D output grid (empty if the requested parameter was not available). This reference remains valid
+ * until the next time step is computed.
+ */
+const mio::Grid2DObject& SnowpackInterface::getGridView(const SnGrids::Parameters& param, const bool& all_processes) const
 {
 	//special case for the meteo forcing grids
 	switch (param) {
@@ -830,39 +935,79 @@ mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param) c
 		case SnGrids::ISWR_DIFF:
 			return diffuse;
 		case SnGrids::ISWR_DIR:
-			return shortwave-diffuse-terrain_shortwave;
+			iswr_dir = shortwave-diffuse-terrain_shortwave;
+			return iswr_dir;
 		case SnGrids::WINDEROSIONDEPOSITION:
 			return winderosiondeposition;
 		default: ; //so compilers do not complain about missing conditions
 	}
 
-	mio::Grid2DObject o_grid2D(dem, 0.); //so the reduce_sum works
-	size_t errCount = 0;
-	mio::Grid2DObject tmp_grid2D_(dem,mpi_offset, 0, mpi_nx, dimy);
-	mio::Grid2DObject tmp_grid2D(tmp_grid2D_,mio::IOUtils::nodata);
-	#pragma omp parallel for schedule(dynamic) reduction(+: errCount)
-	for (size_t ii = 0; ii < workers.size(); ii++) {
-		const mio::Grid2DObject tmp( workers[ii]->getGrid(param) );
-		if (!tmp.empty()) {
-			for (size_t i=0; i<tmp_grid2D.getNx(); ++i){
-				for (size_t j=0; j<tmp_grid2D.getNy(); ++j){
-					if (tmp(i,j)!=mio::IOUtils::nodata) tmp_grid2D(i,j)=tmp(i,j);
-				}
+	gatherGrids(std::vector<SnGrids::Parameters>(1, param), all_processes);
+	return grids_cache[param].grid;
+}
+
+/**
+ * @brief Gather a batch of grids computed by the workers.
+ * @details Each worker only copies its own cells into the grids of the process and the bands of all the requested
+ * parameters are then exchanged between the processes in one collective call. The gathered grids are kept until the
+ * next time step is computed, so the parameters that are already available are not gathered again. This must be called
+ * by all processes with the same parameters.
+ * @param params parameters to gather (the meteo forcing grids are ignored, they are always available)
+ * @param all_processes if true, the full grids are available on all processes, otherwise only on the master process
+ */
+void SnowpackInterface::gatherGrids(const std::vector<SnGrids::Parameters>& params, const bool& all_processes) const
+{
+	std::vector<SnGrids::Parameters> new_params;
+	std::vector<mio::Grid2DObject*> new_grids;
+	std::vector<mio::Array2D<double>*> to_exchange;
+	for (size_t kk=0; kk<params.size(); kk++) {
+		const SnGrids::Parameters& param = params[kk];
+		//the meteo forcing grids are not computed by the workers, getGridView() returns them directly
+		if (std::find(grids_not_computed_in_worker.begin(), grids_not_computed_in_worker.end(), SnGrids::getParameterName(param)) != grids_not_computed_in_worker.end())
+			continue;
+		const std::map<SnGrids::Parameters, CachedGrid>::iterator it( grids_cache.find(param) );
+		if (it!=grids_cache.end()) { //already gathered for this time step, maybe only on the master
+			if (all_processes && !it->second.all_processes) {
+				to_exchange.push_back( &it->second.grid.grid2D );
+				it->second.all_processes = true;
 			}
-		} else {
-			errCount++;
+			continue;
 		}
-	}
-	o_grid2D.grid2D.fill(tmp_grid2D.grid2D, mpi_offset, 0, mpi_nx, dimy);
 
-	MPIControl::instance().reduce_sum(o_grid2D);
-	//with some MPI implementations, when transfering large amounts of data, the buffers might get full and lead to a crash
+		bool available = true;
+		for (size_t ii = 0; ii < workers.size(); ii++) available = available && workers[ii]->hasGrid(param);
+		CachedGrid& cached = grids_cache[param];
+		cached.all_processes = all_processes;
+		if (!available) {
+			std::cerr << "[W] Requested " << SnGrids::getParameterName( param ) << " but this was not available in the workers\n";
+			cached.all_processes = true; //the empty grid is the same on all processes
+			continue;
+		}
 
-	if (errCount>0) {
-		std::cerr << "[W] Requested " << SnGrids::getParameterName( param ) << " but this was not available in the workers\n";
-		o_grid2D.clear(); //the requested parameter was not available
+		//the band of the process is nodata except for the cells computed by the workers
+		cached.grid.set(dem, 0.);
+		for (size_t jj=0; jj<dimy; jj++)
+			for (size_t ii=mpi_offset; ii<mpi_offset+mpi_nx; ii++)
+				cached.grid(ii, jj) = mio::IOUtils::nodata;
+		new_params.push_back( param );
+		new_grids.push_back( &cached.grid );
+		to_exchange.push_back( &cached.grid.grid2D );
 	}
-	return o_grid2D;
+
+	if (!new_params.empty()) {
+		//the workers own disjoint cells, so they can fill the same grids concurrently
+		#pragma omp parallel for schedule(dynamic)
+		for (size_t ii = 0; ii < workers.size(); ii++) {
+			for (size_t kk=0; kk<new_params.size(); kk++)
+				workers[ii]->copyOwnedCells(new_params[kk], *new_grids[kk], mpi_offset);
+		}
+	}
+
+	//only the bands computed by each process are transfered
+	if (all_processes)
+		MPIControl::instance().allgather(to_exchange, mpi_domain);
+	else
+		MPIControl::instance().gather(to_exchange, mpi_domain, MPIControl::instance().master_rank());
 }
 
 /**
@@ -871,6 +1016,7 @@ mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param) c
  */
 void SnowpackInterface::calcNextStep()
 {
+	MIO_TRACE_ZONE("Alpine3D", "SnowpackStep");
 	//Control if all data are present
 	if (!dataMeteo2D) {
 		return;
@@ -909,10 +1055,13 @@ void SnowpackInterface::calcNextStep()
 	const mio::Grid2DObject tmp_shortwave(shortwave, mpi_offset, 0, mpi_nx, dimy);
 	const mio::Grid2DObject tmp_diffuse(diffuse, mpi_offset, 0, mpi_nx, dimy);
 	const mio::Grid2DObject tmp_longwave(longwave, mpi_offset, 0, mpi_nx, dimy);
+	//the stability indices are only written out in the special points' time series and profiles
+	const bool stability_needed = !pts.empty() && (do_ts_output(nextStepTimestamp) || do_prof_output(nextStepTimestamp));
 	#pragma omp parallel for schedule(dynamic, 1) reduction(+: errCount)
 	for (size_t ii = 0; ii < workers.size(); ii++) { // make slices
 		// run model, process exceptions in a way that is compatible with openmp
 		try {
+			workers[ii]->setComputeStability( stability_needed );
 			workers[ii]->runModel(nextStepTimestamp, tmp_psum, tmp_psum_ph, tmp_psum_tech, tmp_rh, tmp_ta, tmp_tsg, tmp_vw, tmp_vw_drift, tmp_dw, tmp_mns, tmp_shortwave, tmp_diffuse, tmp_longwave, solarElevation);
 			if (snow_grooming) {
 				const mio::Grid2DObject tmp_grooming(grooming, mpi_offset, 0, mpi_nx, dimy);
@@ -923,21 +1072,21 @@ void SnowpackInterface::calcNextStep()
 			cout << e.what() << std::endl;
 		}
 	}
+	grids_cache.clear(); //the workers' grids have been updated
 
 	//Lateral flow
-	if (enable_lateral_flow) {
-#ifdef ENABLE_MPI
-		throw IOException("LATERAL_FLOW is not supported when using MPI.", AT);
-#else
-		calcLateralFlow();
-#endif
-	}
+	if (enable_lateral_flow) calcLateralFlow();
 
 	//Retrieve special points data and write files
 	if (!pts.empty()) write_special_points();
 
 	if (errCount>0) {
 		//something wrong took place, quitting. At least we tried writing the special points out
+		try {
+			output_queue->flush();
+		} catch (const std::exception& e) {
+			cout << e.what() << std::endl;
+		}
 		std::abort(); //force core dump
 	}
 
@@ -970,32 +1119,24 @@ void SnowpackInterface::write_special_points()
 	for (size_t ii=0; ii<workers.size(); ii++)
 		workers[ii]->getOutputSpecialPoints(snow_pixel, meteo_pixel, surface_flux);
 
+	const bool write_sno = (!snow_write && !snow_poi_written); //also write the .sno of the special points
 	if (do_io_locally) {
-		writeOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux);
-		if (!snow_write && !snow_poi_written) {
-			writeSnowCover(nextStepTimestamp, snow_pixel); //also write the .sno of the special points
-			snow_poi_written = true;
-		}
+		pushOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux, false, write_sno);
+		snow_poi_written = true;
 	} else { // data has to be sent to the master process
 		if (mpicontrol.master()) {
 			// Write out local data first and then gather data from all processes
-			writeOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux);
-			if (!snow_write && !snow_poi_written) {
-				writeSnowCover(nextStepTimestamp, snow_pixel); //also write the .sno of the special points
-			}
+			pushOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux, false, write_sno);
 
 			for (size_t ii=0; ii<mpicontrol.size(); ii++) {
 				if (ii == mpicontrol.master_rank()) continue;
-				snow_pixel.clear(); meteo_pixel.clear(); surface_flux.clear();
 
 				mpicontrol.receive(snow_pixel, ii);
 				mpicontrol.receive(meteo_pixel, ii);
 				mpicontrol.receive(surface_flux, ii);
 
-				writeOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux);
-				if (!snow_write && !snow_poi_written) {
-					writeSnowCover(nextStepTimestamp, snow_pixel); //also write the .sno of the special points
-				}
+				//the received data is written out while receiving from the next process
+				pushOutputSpecialPoints(nextStepTimestamp, snow_pixel, meteo_pixel, surface_flux, true, write_sno);
 			}
 			snow_poi_written = true;
 		} else {
@@ -1009,6 +1150,37 @@ void SnowpackInterface::write_special_points()
 	for (size_t ii=0; ii<workers.size(); ii++) workers[ii]->clearSpecialPointsData();
 }
 
+/**
+ * @brief Hand the special points data over to the output queue
+ * @param date Output date
+ * @param snow_pixel The SnowStation data for all the special points
+ * @param meteo_pixel The CurrentMeteo data for all the special points
+ * @param surface_flux The SurfaceFlux data for all the special points
+ * @param owned if true, the data belongs to the caller and will be deleted once written out. Otherwise it belongs to
+ * the workers and is copied if the output is asynchronous. In any case, the three vectors are emptied.
+ * @param write_sno also write the .sno files of the special points?
+ */
+void SnowpackInterface::pushOutputSpecialPoints(const mio::Date& date, std::vector<SnowStation*>& snow_pixel, std::vector<CurrentMeteo*>& meteo_pixel,
+                                                std::vector<SurfaceFluxes*>& surface_flux, const bool& owned, const bool& write_sno)
+{
+	std::shared_ptr<PointsSnapshot> data( new PointsSnapshot(owned || output_queue->isAsync()) );
+	if (owned || !output_queue->isAsync()) {
+		data->snow_pixel.swap( snow_pixel );
+		data->meteo_pixel.swap( meteo_pixel );
+		data->surface_flux.swap( surface_flux );
+	} else {
+		copyPointers(snow_pixel, data->snow_pixel);
+		copyPointers(meteo_pixel, data->meteo_pixel);
+		copyPointers(surface_flux, data->surface_flux);
+	}
+	snow_pixel.clear(); meteo_pixel.clear(); surface_flux.clear();
+
+	output_queue->push( [this, date, data, write_sno]() {
+		writeOutputSpecialPoints(date, data->snow_pixel, data->meteo_pixel, data->surface_flux);
+		if (write_sno) writeSnowCover(date, data->snow_pixel);
+	} );
+}
+
 /**
  * @brief Write the output which is asked to have more for the special points
  * @param date Output date
@@ -1019,8 +1191,8 @@ void SnowpackInterface::write_special_points()
 void SnowpackInterface::writeOutputSpecialPoints(const mio::Date& date, const std::vector<SnowStation*>& snow_pixel, const std::vector<CurrentMeteo*>& meteo_pixel,
                                                  const std::vector<SurfaceFluxes*>& surface_flux)
 {
-	const bool TS = (ts_write && booleanTime(date.getJulian(), ts_days_between, ts_start, dt_main/60.));
-	const bool PR = (prof_write && booleanTime(date.getJulian(), prof_days_between, prof_days_between, dt_main/60));
+	const bool TS = do_ts_output(date);
+	const bool PR = do_prof_output(date);
 
 	const ProcessDat Hdata; // empty ProcessDat, get it from where ??
 	for (size_t ii=0; ii<snow_pixel.size(); ii++) {
@@ -1366,116 +1538,17 @@ void SnowpackInterface::readSnowCover(const std::string& GRID_sno, const std::st
 }
 
 /**
- * @brief Calculates lateral flow
+ * @brief Calculates lateral flow: the slope parallel flux of each pixel is routed to its downslope neighbour
+ * (see LateralFlow) and turned into source/sink terms.
  * @author Nander Wever
  */
 void SnowpackInterface::calcLateralFlow()
 {
-	std::vector<SnowStation*> snow_pixel;
-	// Retrieve snow stations
+	std::vector<SnowStation*> snow_pixel(mpi_nx*dimy, NULL);
 	for (size_t ii = 0; ii < workers.size(); ii++) {
-		workers[ii]->getLateralFlow(snow_pixel);
+		workers[ii]->getSnowStations(snow_pixel);
 	}
-	// Translate lateral flow in source/sink term
-	size_t ix=0;											// The source cell x coordinate
-	int ixd=-1, iyd=-1;										// The destination cell x and y coordinates
-	size_t errCount = 0;
-	#pragma omp parallel for schedule(dynamic, 1) reduction(+: errCount)
-	for (size_t ii = 0; ii < workers.size(); ii++) {						// Cycle over all workers
-		try {
-			for (size_t jj = 0; jj < worker_deltax[ii]; jj++) {				// Cycle over x range per worker
-				for (size_t iy = 0; iy < dimy; iy++) {					// Cycle over y
-					ix = worker_startx[ii] + jj;
-					const size_t index_SnowStation_src = ix * dimy + iy;		// Index of source cell of water
-					double tmp_dist = -1;						// Cell distance
-					if (snow_pixel[index_SnowStation_src] != NULL) {		// Make sure it is not a NULL pointer (in case of skipped cells)
-						// Now determine destination cell for the water, based on azimuth
-						if ((snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 337.5 && snow_pixel[index_SnowStation_src]->meta.getAzimuth() <= 360.) || (snow_pixel[index_SnowStation_src]->meta.getAzimuth() >=0. && snow_pixel[index_SnowStation_src]->meta.getAzimuth() <= 22.5)) {
-							ixd = ix;
-							iyd = iy-1;
-							tmp_dist = dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 22.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 67.5) {
-							ixd = ix+1;
-							iyd = iy-1;
-							tmp_dist = mio::Cst::Sqrt2 * dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 67.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 112.5) {
-							ixd = ix+1;
-							iyd = iy;
-							tmp_dist = dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 112.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 157.5) {
-							ixd = ix+1;
-							iyd = iy+1;
-							tmp_dist = mio::Cst::Sqrt2 * dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 157.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 202.5) {
-							ixd = ix;
-							iyd = iy+1;
-							tmp_dist = dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 202.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 247.5) {
-							ixd = ix-1;
-							iyd = iy+1;
-							tmp_dist = mio::Cst::Sqrt2 * dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 247.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 292.5) {
-							ixd = ix-1;
-							iyd = iy;
-							tmp_dist = dem.cellsize;
-						} else if (snow_pixel[index_SnowStation_src]->meta.getAzimuth() > 292.5 || snow_pixel[index_SnowStation_src]->meta.getAzimuth() < 337.5) {
-							ixd = ix-1;
-							iyd = iy-1;
-							tmp_dist = mio::Cst::Sqrt2 * dem.cellsize;
-						} else {
-							// Undefined aspect, don't route the lateral flow by setting destination cell outside domain
-							ixd=-1;
-							iyd=-1;
-						}
-						if (ixd >= 0 && iyd >= 0 && ixd < int(dimx) && iyd < int(dimy)) {								// Check if destination cell is inside domain
-							const size_t index_SnowStation_dst = dimy * ixd + iyd;							// Destination cell of water
-							if (snow_pixel[index_SnowStation_dst] != NULL) {							// Make sure destination cell is not a NULL pointer (in case of skipped cells)
-								for (size_t n=0; n < snow_pixel[index_SnowStation_src]->getNumberOfElements(); n++) {			// Loop over all layers in source cell
-									for (size_t nn=0; nn < snow_pixel[index_SnowStation_dst]->getNumberOfElements(); nn++) {	// Loop over all layers in destination cell
-										// Now check if deposition date is equal or newer (i.e., never put lateral water in an older layer, except when we cycled over all layers and we are at the top layer)
-										if (snow_pixel[index_SnowStation_dst]->Edata[nn].depositionDate >= snow_pixel[index_SnowStation_src]->Edata[n].depositionDate
-											|| nn == snow_pixel[index_SnowStation_dst]->getNumberOfElements()-1) {
-											// The flux into the pixel is a source term for the destination cell
-											snow_pixel[index_SnowStation_dst]->Edata[nn].lwc_source += snow_pixel[index_SnowStation_src]->Edata[n].SlopeParFlux / tmp_dist * (snow_pixel[index_SnowStation_dst]->Edata[nn].L / snow_pixel[index_SnowStation_src]->Edata[n].L);
-											// The flux out of the pixel is a sink term for the source cell
-											snow_pixel[index_SnowStation_src]->Edata[n].lwc_source -= snow_pixel[index_SnowStation_src]->Edata[n].SlopeParFlux / tmp_dist * (snow_pixel[index_SnowStation_dst]->Edata[nn].L / snow_pixel[index_SnowStation_src]->Edata[n].L);
-											// Set the SlopeParFlux to zero, now that we have redistributed it.
-											snow_pixel[index_SnowStation_src]->Edata[n].SlopeParFlux = 0.;
-											break;
-										}
-									}
-								}
-							}
-						}
-					}
-				}
-				ix++;
-			}
-		} catch(const std::exception& e) {
-			++errCount;
-			cout << e.what() << std::endl;
-		}
-	}
-
-	if (errCount>0) {
-		//something wrong took place, quitting. At least we tried writing the special points out
-		std::abort(); //force core dump
-	}
-
-	// Send back SnowStations to the workers
-	#pragma omp parallel for schedule(dynamic, 1) reduction(+: errCount)
-	for (size_t ii = 0; ii < workers.size(); ii++) {
-		std::vector<SnowStation*> snow_pixel_out;					// Construct vector to send snow stations to the associated worker
-		for (size_t jj = 0; jj < worker_deltax[ii]; jj++) {				// Cycle over x range per worker
-			for (size_t iy = 0; iy < dimy; iy++) {					// Cycle over y
-				ix = worker_startx[ii] + jj;
-				const size_t idx = ix * dimy + iy;				// Index of snow pixel
-				snow_pixel_out.push_back( snow_pixel[idx] );
-			}
-		}
-		workers[ii]->setLateralFlow(snow_pixel_out);
-	}
-	return;
+	lateral_flow->compute(snow_pixel, worker_startx, worker_deltax);
 }
 
 
@@ -33,6 +33,8 @@ class Runoff; // forward declaration, cyclic header include
 #include <alpine3d/SnowpackInterfaceWorker.h>
 #include <alpine3d/Glaciers.h>
 #include <alpine3d/TechSnowA3D.h>
+#include <alpine3d/OutputQueue.h>
+#include <alpine3d/LateralFlow.h>
 
 /**
  * @page snowpack Snowpack
@@ -101,7 +103,8 @@ class Runoff; // forward declaration, cyclic header include
  * Full snowpack stratigraphy outputs are provided at specific Points Of Interest, as defined with the POI key in the [Input] section. These outputs
  * contain time series of snow profiles and fluxes as well as meteorological forcing at these points, allowing to re-run these points manually in the
  * Snowpack model. These outputs are written in the path pointed to by METEOPATH in the [Ouput] section. The time resolution is controlled similarly to
- * standard Snowpack runs with the TS_WRITE and PROF_WRITE groups of keys (see Snowpack documentation).
+ * standard Snowpack runs with the TS_WRITE and PROF_WRITE groups of keys (see Snowpack documentation). Since the snowpack stability is only part of
+ * these outputs, it is only computed for the Points Of Interest and only at the time steps when their time series or profiles are written.
  *
  * @code
  * [Input]
@@ -122,6 +125,12 @@ class Runoff; // forward declaration, cyclic header include
  * METEOPATH         = ../output
  * @endcode
  *
+ * @section async_outputs Asynchronous outputs
+ * The special points outputs (time series, profiles and meteo forcing) as well as the snow cover (".sno") files are handed over to a
+ * background writer thread, so the simulation can proceed with the next time step while the previous outputs are being formatted and written.
+ * The data to write out is copied before being handed over and at most two output steps can be pending at any time (if the writer lags behind,
+ * the simulation waits for it). All pending outputs are written before Alpine3D exits. This is controlled by the ASYNC_OUTPUT key
+ * in the [Output] section (default: true), setting it to false writes all outputs synchronously.
  *
  */
  class SnowpackInterface
@@ -170,13 +179,17 @@ class Runoff; // forward declaration, cyclic header include
 		                            const double& solarElevation,
 		                            const mio::Date& timestamp);
 
-		mio::Grid2DObject getGrid(const SnGrids::Parameters& param) const;
+		mio::Grid2DObject getGrid(const SnGrids::Parameters& param, const bool& all_processes=true) const;
+		const mio::Grid2DObject& getGridView(const SnGrids::Parameters& param, const bool& all_processes=true) const;
+		void gatherGrids(const std::vector<SnGrids::Parameters>& params, const bool& all_processes=true) const;
 
 	private:
 		static const std::vector<std::string> grids_not_computed_in_worker;
 		std::string getGridsRequirements() const;
 		mio::Config readAndTweakConfig(const mio::Config& io_cfg,const bool have_pts);
 		bool do_grid_output(const mio::Date &date) const;
+		bool do_ts_output(const mio::Date &date) const;
+		bool do_prof_output(const mio::Date &date) const;
 		void calcNextStep();
 		void setInitGlacierHeight();
 		SN_SNOWSOIL_DATA getIcePixel(const double glacier_height, const std::stringstream& GRID_sno, const bool seaIce);
@@ -190,6 +203,9 @@ class Runoff; // forward declaration, cyclic header include
 		void write_SMET(const CurrentMeteo& met, const mio::StationData& meta, const SurfaceFluxes& surf) const;
 		void writeOutputSpecialPoints(const mio::Date& date, const std::vector<SnowStation*>& snow_pixel, const std::vector<CurrentMeteo*>& meteo_pixel,
 		                              const std::vector<SurfaceFluxes*>& surface_flux);
+		void pushOutputSpecialPoints(const mio::Date& date, std::vector<SnowStation*>& snow_pixel, std::vector<CurrentMeteo*>& meteo_pixel,
+		                             std::vector<SurfaceFluxes*>& surface_flux, const bool& owned, const bool& write_sno);
+		void pushSnowCover(const mio::Date& date, std::vector<SnowStation*>& snow_station, const bool& owned);
 		void write_special_points();
 		void calcLateralFlow();
 		void calcSimpleSnowDrift(const mio::Grid2DObject& ErodedMass, mio::Grid2DObject& psum);
@@ -206,6 +222,7 @@ class Runoff; // forward declaration, cyclic header include
 		// Config dependent information
 		bool is_restart, useCanopy, enable_simple_snow_drift, enable_lateral_flow, a3d_view;
 		bool do_io_locally; // if false all I/O will only be done on the master process
+		bool async_output; // if true, the special points and sno outputs are written by a background thread
 		std::string station_name; // value for the key OUTPUT::EXPERIMENT
 		bool glacier_katabatic_flow, snow_production, snow_grooming;
 		// Output
@@ -227,6 +244,7 @@ class Runoff; // forward declaration, cyclic header include
 
 		size_t dimx, dimy;
 		size_t mpi_offset, mpi_nx;
+		MPIDomain mpi_domain; ///< bands computed by each process, used to exchange the output grids
 		mio::Grid2DObject landuse;
 		// meteo forcing variables
 		mio::Grid2DObject mns, shortwave, longwave, diffuse, terrain_shortwave, terrain_longwave;
@@ -239,6 +257,13 @@ class Runoff; // forward declaration, cyclic header include
 		std::vector<size_t> worker_startx; // stores offset for each workers slice
 		std::vector<size_t> worker_deltax; // stores size for each workers slize
 		std::vector<std::vector<std::pair<size_t,size_t> > > worker_stations_coord; // stores the grid coordinates of each worker
+		struct CachedGrid {
+			CachedGrid() : grid(), all_processes(false) {}
+			mio::Grid2DObject grid;
+			bool all_processes; // is the full grid available on all processes or only on the master?
+		};
+		mutable std::map<SnGrids::Parameters, CachedGrid> grids_cache; // grids already gathered from the workers for the current time step
+		mutable mio::Grid2DObject iswr_dir; // ISWR_DIR is computed on request from the radiation components
 		// time relevant
 		mio::Timer timer; // used to measure calc time of one step
 		mio::Date nextStepTimestamp;
@@ -254,6 +279,8 @@ class Runoff; // forward declaration, cyclic header include
 
 		Glaciers *glaciers;
 		TechSnowA3D *techSnow;
+		OutputQueue *output_queue; // all writes through snowpackIO go through this queue
+		LateralFlow *lateral_flow; // routing graph for the lateral flow
 };
 
 #endif
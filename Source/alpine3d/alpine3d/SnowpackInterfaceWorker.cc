@@ -160,7 +160,7 @@ SnowpackInterfaceWorker::SnowpackInterfaceWorker(const mio::Config& io_cfg,
    isSpecialPoint(snow_stations.size(), false), landuse(landuse_in), store(dem_in, 0.), erodedmass(dem_in, 0.), grids(), snow_pixel(), meteo_pixel(),
    surface_flux(), soil_temp_depths(), snow_density_depths(), calculation_step_length(0.), height_of_wind_value(0.),
    snow_temp_depth(IOUtils::nodata), snow_avg_temp_depth(IOUtils::nodata), snow_avg_rho_depth(IOUtils::nodata),
-   enable_simple_snow_drift(false), useDrift(false), useEBalance(false), useCanopy(false)
+   enable_simple_snow_drift(false), useDrift(false), useEBalance(false), useCanopy(false), computeStability(true)
 {
 
 	sn_cfg.getValue("CALCULATION_STEP_LENGTH", "Snowpack", calculation_step_length);
@@ -313,10 +313,13 @@ void SnowpackInterfaceWorker::getOutputSNO(std::vector<SnowStation*>& snow_stati
 
 /**
  * @brief Method that the Master can search the neded data (in grids) from Worker (Pull from client)
+ * @details This returns a view on the grid owned by the worker (no copy is made). It covers the whole domain of the
+ * process but only the cells computed by this worker are set, the others being nodata. The view remains valid until
+ * the next call to runModel().
  * @param param says which grid param the Master wants to have
  * @return the 2D output grid, which gives back the data to the master
  */
-mio::Grid2DObject SnowpackInterfaceWorker::getGrid(const SnGrids::Parameters& param) const
+const mio::Grid2DObject& SnowpackInterfaceWorker::getGrid(const SnGrids::Parameters& param) const
 {
 	const std::map< SnGrids::Parameters, mio::Grid2DObject >::const_iterator it = grids.find(param);
 	if (it==grids.end()) {
@@ -326,6 +329,24 @@ mio::Grid2DObject SnowpackInterfaceWorker::getGrid(const SnGrids::Parameters& pa
 	return it->second;
 }
 
+/**
+ * @brief Copy the cells computed by this worker into a larger grid. Only the cells of this worker are
+ * visited (instead of the whole domain), so the workers can fill the same grid concurrently.
+ * @param param parameter to copy
+ * @param grid grid to fill, the other cells are left untouched
+ * @param startx column of the grid that matches the first column of the worker's grids
+ */
+void SnowpackInterfaceWorker::copyOwnedCells(const SnGrids::Parameters& param, mio::Grid2DObject& grid, const size_t& startx) const
+{
+	const mio::Grid2DObject& src = getGrid(param);
+	for (size_t ii = 0; ii < SnowStationsCoord.size(); ++ii) {
+		const size_t ix = SnowStationsCoord[ii].first;
+		const size_t iy = SnowStationsCoord[ii].second;
+		const double value = src(ix, iy);
+		if (value!=IOUtils::nodata) grid(startx+ix, iy) = value;
+	}
+}
+
 /**
  * @brief Retrieve one point (ii,jj) from the specified grid.
  * @param param says which grid param the Master wants to have
@@ -659,14 +680,17 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
 			getGridPoint(SnGrids::TOP_ALB, ix, iy) = previous_albedo;
 		}
 
-		try{
-			stability.checkStability(meteoPixel, snowPixel);
-		} catch(...) {
-			snowPixel.S_4 = Stability::max_stability; //nothing else to do...
+		//the stability is only written out for the special points, and only when their time series or profiles are written
+		if (computeStability && isSpecialPoint[index_SnowStation]) {
+			try{
+				stability.checkStability(meteoPixel, snowPixel);
+			} catch(...) {
+				snowPixel.S_4 = Stability::max_stability; //nothing else to do...
+			}
 		}
 
 		surfaceFlux.mass[SurfaceFluxes::MS_TOTALMASS] = 0.0;
-		const std::vector<ElementData> EMS( snowPixel.Edata );
+		const std::vector<ElementData>& EMS = snowPixel.Edata;
 		for (size_t e=0; e<EMS.size(); e++) {
 			if (EMS[e].theta[SOIL] <= 0.) {
 				surfaceFlux.mass[SurfaceFluxes::MS_TOTALMASS] += EMS[e].M;
@@ -751,28 +775,17 @@ bool SnowpackInterfaceWorker::is_special(const std::vector< std::pair<size_t,siz
 }
 
 /**
- * @brief method called by SnowpackInterface to retrieve all snow_pixels, to read the lateral flow variable
- * @param ptr_snow_pixel to vector of SnowStations, where the variable SlopeParFlux contains the lateral flow
- */
-void SnowpackInterfaceWorker::getLateralFlow(std::vector<SnowStation*>& ptr_snow_pixel)
-{
-	for(size_t ii = 0; ii < SnowStationsCoord.size(); ++ii) {
-		#pragma omp critical (snow_station_lock)
-		ptr_snow_pixel.push_back( SnowStations[ii] );
-	}
-}
-
-/**
- * @brief method called by SnowpackInterface to send back the source/sink term for treating lateral flow
- * @param ptr_snow_pixel to vector of SnowStations, in which the lwc_source variable is set to contain the lateral flow.
+ * @brief method called by SnowpackInterface to retrieve the snow_pixels of this worker (for example to compute the lateral flow)
+ * @param snow_station vector of SnowStations covering the whole grid of the worker, the pixel (ix,iy) being at index ix*dimy+iy.
+ * Only the pixels of this worker are set.
  */
-void SnowpackInterfaceWorker::setLateralFlow(const std::vector<SnowStation*>& ptr_snow_pixel)
+void SnowpackInterfaceWorker::getSnowStations(std::vector<SnowStation*>& snow_station) const
 {
-	for(size_t ii = 0; ii < SnowStationsCoord.size(); ++ii) {
-		if (SnowStations[ii]!=NULL) {
-			for(size_t n=0; n<SnowStations[ii]->getNumberOfElements(); n++) {
-				SnowStations[ii]->Edata[n].lwc_source = ptr_snow_pixel[ii]->Edata[n].lwc_source;
-			}
-		}
+	if (snow_station.size() != dimx*dimy)
+		throw InvalidArgumentException("The vector of SnowStations must cover the whole grid", AT);
+	for (size_t ii = 0; ii < SnowStationsCoord.size(); ++ii) {
+		const size_t ix = SnowStationsCoord[ii].first;
+		const size_t iy = SnowStationsCoord[ii].second;
+		snow_station[ix*dimy + iy] = SnowStations[ii];
 	}
 }
@@ -39,12 +39,15 @@ class SnowpackInterfaceWorker
 
 		void setUseDrift(const bool useDrift_in) {useDrift = useDrift_in;}
 		void setUseEBalance(const bool useEBalance_in) {useEBalance = useEBalance_in;}
+		void setComputeStability(const bool computeStability_in) {computeStability = computeStability_in;} ///< compute the stability of the special points at the next step?
 		void getOutputSNO(std::vector<SnowStation*>& snow_station) const;
 		void getOutputSpecialPoints(std::vector<SnowStation*>& ptr_snow_pixel, std::vector<CurrentMeteo*>& ptr_meteo_pixel,
 		                            std::vector<SurfaceFluxes*>& ptr_surface_flux);
 		void clearSpecialPointsData();
 
-		mio::Grid2DObject getGrid(const SnGrids::Parameters& param) const;
+		const mio::Grid2DObject& getGrid(const SnGrids::Parameters& param) const;
+		bool hasGrid(const SnGrids::Parameters& param) const {return grids.find(param)!=grids.end();}
+		void copyOwnedCells(const SnGrids::Parameters& param, mio::Grid2DObject& grid, const size_t& startx) const;
 
 		void runModel(const mio::Date& julian,
 		              const mio::Grid2DObject &psum,
@@ -68,8 +71,7 @@ class SnowpackInterfaceWorker
 		static bool skipThisCell(const double& landuse_val, const double& dem_val);
 		static bool is_special(const std::vector< std::pair<size_t,size_t> >& pts_in, const size_t& ix, const size_t& iy);
 		static void uniqueOutputGrids(std::vector<std::string>& output_grids);
-		void getLateralFlow(std::vector<SnowStation*>& snow_station);
-		void setLateralFlow(const std::vector<SnowStation*>& snow_station);
+		void getSnowStations(std::vector<SnowStation*>& snow_station) const;
 
 	private:
 		void initGrids(std::vector<std::string>& params, const std::vector<std::string>& grids_not_computed_in_worker);
@@ -106,7 +108,7 @@ class SnowpackInterfaceWorker
 		double height_of_wind_value;
 		double snow_temp_depth, snow_avg_temp_depth, snow_avg_rho_depth;
 		bool enable_simple_snow_drift;
-		bool useDrift, useEBalance, useCanopy;
+		bool useDrift, useEBalance, useCanopy, computeStability;
 };
 
 #endif
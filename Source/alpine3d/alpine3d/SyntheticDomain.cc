@@ -0,0 +1,426 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <alpine3d/SyntheticDomain.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace mio;
+using namespace std;
+
+//land use codes (PREVAH) used for the synthetic domain, the snow covered variants are code+1
+static const int LUS_FOREST = 10300, LUS_MEADOW = 10700, LUS_GLACIER = 11400;
+
+const std::string SyntheticDomain::wind_fields_names[] = {"synthetic_W", "synthetic_S"};
+
+/**
+ * @brief Read the configuration of the synthetic domain
+ * @param cfg configuration, the [Benchmark] section is read
+ */
+SyntheticDomain::SyntheticDomain(const mio::Config& cfg)
+                : workdir("./synthetic"), experiment(), coordsys(), coordparam(),
+                  cellsize(100.), latitude(46.8), longitude(9.8), base_altitude(1500.), relief(1500.), wind_speed(5.),
+                  glacier_fraction(0.1), forest_fraction(0.2), snow_fraction(0.5), tz(0.),
+                  nx(50), ny(50), nz(10), nr_stations(4), seed(1)
+{
+	cfg.getValue("WORKDIR", "Benchmark", workdir, IOUtils::nothrow);
+	cfg.getValue("NX", "Benchmark", nx, IOUtils::nothrow);
+	cfg.getValue("NY", "Benchmark", ny, IOUtils::nothrow);
+	cfg.getValue("NZ", "Benchmark", nz, IOUtils::nothrow);
+	cfg.getValue("WIND_SPEED", "Benchmark", wind_speed, IOUtils::nothrow);
+	cfg.getValue("CELLSIZE", "Benchmark", cellsize, IOUtils::nothrow);
+	cfg.getValue("LATITUDE", "Benchmark", latitude, IOUtils::nothrow);
+	cfg.getValue("LONGITUDE", "Benchmark", longitude, IOUtils::nothrow);
+	cfg.getValue("BASE_ALTITUDE", "Benchmark", base_altitude, IOUtils::nothrow);
+	cfg.getValue("RELIEF", "Benchmark", relief, IOUtils::nothrow);
+	cfg.getValue("NR_STATIONS", "Benchmark", nr_stations, IOUtils::nothrow);
+	cfg.getValue("GLACIER_FRACTION", "Benchmark", glacier_fraction, IOUtils::nothrow);
+	cfg.getValue("FOREST_FRACTION", "Benchmark", forest_fraction, IOUtils::nothrow);
+	cfg.getValue("SNOW_FRACTION", "Benchmark", snow_fraction, IOUtils::nothrow);
+	cfg.getValue("SEED", "Benchmark", seed, IOUtils::nothrow);
+
+	cfg.getValue("EXPERIMENT", "Output", experiment);
+	cfg.getValue("TIME_ZONE", "Input", tz);
+	cfg.getValue("COORDSYS", "Input", coordsys);
+	cfg.getValue("COORDPARAM", "Input", coordparam, IOUtils::nothrow);
+
+	if (nx<3 || ny<3) throw InvalidArgumentException("The synthetic domain must be at least 3x3 cells", AT);
+	if (nz<4) throw InvalidArgumentException("The synthetic wind fields must have at least 4 levels", AT);
+	if (wind_speed<0.) throw InvalidArgumentException("The wind speed of the synthetic wind fields must be positive", AT);
+	if (nr_stations==0) throw InvalidArgumentException("The synthetic domain needs at least one station", AT);
+	if (cellsize<=0.) throw InvalidArgumentException("Invalid cell size for the synthetic domain", AT);
+	if (glacier_fraction<0. || forest_fraction<0. || (glacier_fraction+forest_fraction)>1.)
+		throw InvalidArgumentException("The glacier and forest fractions must be positive and their sum can not exceed 1", AT);
+	if (snow_fraction<0. || snow_fraction>1.) throw InvalidArgumentException("The snow fraction must be between 0 and 1", AT);
+}
+
+/**
+ * @brief Write all the input files of the synthetic domain into the working directory.
+ * This should only be called by the master process.
+ * @param startdate first simulation time step
+ * @param nr_steps number of (hourly) simulation steps, the forcing covers them with a margin of two days on each side
+ * @param wind_fields also generate the wind fields required by snowdrift?
+ */
+void SyntheticDomain::generate(const mio::Date& startdate, const unsigned int& nr_steps, const bool& wind_fields) const
+{
+	Config grid_cfg;
+	grid_cfg.addKey("COORDSYS", "Input", coordsys);
+	grid_cfg.addKey("COORDPARAM", "Input", coordparam);
+	grid_cfg.addKey("COORDSYS", "Output", coordsys);
+	grid_cfg.addKey("COORDPARAM", "Output", coordparam);
+	grid_cfg.addKey("GRID2D", "Output", "ARC");
+	grid_cfg.addKey("GRID2DPATH", "Output", workdir);
+	IOManager io(grid_cfg);
+
+	const DEMObject dem( buildDEM() );
+	io.write2DGrid(dem, "dem");
+	const Grid2DObject landuse( buildLanduse(dem) );
+	io.write2DGrid(landuse, "landuse");
+
+	writeMeteo(dem, startdate, nr_steps);
+	writeSnowFiles(startdate);
+	if (wind_fields) {
+		writeWindField(dem, wind_fields_names[0], 270.);
+		writeWindField(dem, wind_fields_names[1], 180.);
+	}
+
+	size_t counts[3] = {0, 0, 0}, nr_snow = 0;
+	for (size_t ii=0; ii<landuse.getNx()*landuse.getNy(); ii++) {
+		const int code = static_cast<int>( landuse(ii) + .0001 );
+		if (code%100 == 1) nr_snow++;
+		if (code/100 == LUS_FOREST/100) counts[0]++;
+		else if (code/100 == LUS_MEADOW/100) counts[1]++;
+		else counts[2]++;
+	}
+	std::cout << "[i] Synthetic domain of " << nx << "x" << ny << " cells written in " << workdir << ": "
+	          << counts[0] << " forest, " << counts[1] << " meadow, " << counts[2] << " glacier and " << nr_snow << " snow covered cells, "
+	          << nr_stations << " stations\n";
+}
+
+/**
+ * @brief Set the [Input] keys so the simulation reads the synthetic domain
+ * @param o_cfg configuration to update (this must be done on all processes)
+ * @param wind_fields should the snowdrift wind fields be configured?
+ */
+void SyntheticDomain::setConfig(mio::Config& o_cfg, const bool& wind_fields) const
+{
+	o_cfg.addKey("DEM", "Input", "ARC");
+	o_cfg.addKey("DEMFILE", "Input", workdir + "/dem.asc");
+	o_cfg.addKey("LANDUSE", "Input", "ARC");
+	o_cfg.addKey("LANDUSEFILE", "Input", workdir + "/landuse.asc");
+	o_cfg.addKey("METEO", "Input", "SMET");
+	o_cfg.addKey("METEOPATH", "Input", workdir);
+	o_cfg.addKey("SNOW", "Input", "SMET");
+	o_cfg.addKey("SNOWPATH", "Input", workdir);
+
+	o_cfg.deleteKeys("STATION", "Input"); //remove any station that would have been declared by the user
+	for (size_t ii=0; ii<nr_stations; ii++)
+		o_cfg.addKey("STATION"+IOUtils::toString(ii+1), "Input", "SYN"+IOUtils::toString(ii+1));
+
+	if (wind_fields) {
+		o_cfg.addKey("GRID3D", "Input", "ARPS");
+		o_cfg.addKey("GRID3DPATH", "Input", workdir);
+		o_cfg.addKey("ARPS_EXT", "Input", "none");
+		o_cfg.addKey("WINDFIELDS", "Input", wind_fields_names[0]+" 12 "+wind_fields_names[1]+" 12");
+	}
+}
+
+//the domain is a valley along the y axis, with a few harmonics in both directions to provide varied slopes and aspects
+mio::DEMObject SyntheticDomain::buildDEM() const
+{
+	Lcg rnd(seed);
+	static const size_t nr_harmonics = 4;
+	double kx[nr_harmonics], ky[nr_harmonics], phase[nr_harmonics], amplitude[nr_harmonics];
+	for (size_t ii=0; ii<nr_harmonics; ii++) {
+		kx[ii] = 1. + std::floor(rnd.next()*4.);
+		ky[ii] = 1. + std::floor(rnd.next()*4.);
+		phase[ii] = rnd.next() * 2.*Cst::PI;
+		amplitude[ii] = 0.05 + 0.1*rnd.next();
+	}
+
+	Coords llcorner(coordsys, coordparam);
+	llcorner.setLatLon(latitude, longitude, IOUtils::nodata);
+	DEMObject dem;
+	dem.set(nx, ny, cellsize, llcorner);
+
+	for (size_t iy=0; iy<ny; iy++) {
+		const double y = static_cast<double>(iy) / static_cast<double>(ny-1);
+		for (size_t ix=0; ix<nx; ix++) {
+			const double x = static_cast<double>(ix) / static_cast<double>(nx-1);
+			double z = 0.7 * std::abs(2.*x - 1.) + 0.15 * y; //valley floor rising toward the north
+			for (size_t ii=0; ii<nr_harmonics; ii++)
+				z += amplitude[ii] * std::sin(Cst::PI*kx[ii]*x + phase[ii]) * std::sin(Cst::PI*ky[ii]*y + phase[ii]);
+			dem(ix, iy) = base_altitude + relief * std::max(0., std::min(1., z));
+		}
+	}
+
+	dem.setUpdatePpt((DEMObject::update_type)(DEMObject::SLOPE | DEMObject::NORMAL | DEMObject::CURVATURE));
+	dem.update();
+	return dem;
+}
+
+//glaciers on the highest cells, forest on the lowest cells, meadows in between; snow above the snow line
+mio::Grid2DObject SyntheticDomain::buildLanduse(const mio::DEMObject& dem) const
+{
+	const size_t nr_cells = dem.getNx()*dem.getNy();
+	std::vector<double> altitudes( nr_cells );
+	for (size_t ii=0; ii<nr_cells; ii++) altitudes[ii] = dem(ii);
+	std::sort(altitudes.begin(), altitudes.end());
+	const size_t forest_idx = static_cast<size_t>( forest_fraction * static_cast<double>(nr_cells) );
+	const size_t glacier_idx = nr_cells - static_cast<size_t>( glacier_fraction * static_cast<double>(nr_cells) );
+	const size_t snow_idx = nr_cells - static_cast<size_t>( snow_fraction * static_cast<double>(nr_cells) );
+	const double forest_line = (forest_idx>0)? altitudes[forest_idx-1] : -Cst::dbl_max;
+	const double glacier_line = (glacier_idx<nr_cells)? altitudes[glacier_idx] : Cst::dbl_max;
+	const double snow_line = (snow_idx<nr_cells)? altitudes[snow_idx] : Cst::dbl_max;
+
+	Grid2DObject landuse(dem, IOUtils::nodata);
+	for (size_t ii=0; ii<nr_cells; ii++) {
+		const double altitude = dem(ii);
+		int code = LUS_MEADOW;
+		if (altitude>=glacier_line) code = LUS_GLACIER;
+		else if (altitude<=forest_line) code = LUS_FOREST;
+		if (altitude>=snow_line) code++;
+		landuse(ii) = static_cast<double>( code );
+	}
+
+	return landuse;
+}
+
+//stations spread on a regular pattern over the domain, avoiding the borders
+std::vector< std::pair<size_t,size_t> > SyntheticDomain::getStationsPositions() const
+{
+	const size_t cols = static_cast<size_t>( std::ceil(std::sqrt(static_cast<double>(nr_stations))) );
+	const size_t rows = (nr_stations + cols - 1) / cols;
+
+	std::vector< std::pair<size_t,size_t> > positions;
+	for (size_t ii=0; ii<nr_stations; ii++) {
+		const size_t ix = ((2*(ii%cols) + 1) * nx) / (2*cols);
+		const size_t iy = ((2*(ii/cols) + 1) * ny) / (2*rows);
+		positions.push_back( std::make_pair(std::min(ix, static_cast<size_t>(nx-1)), std::min(iy, static_cast<size_t>(ny-1))) );
+	}
+	return positions;
+}
+
+void SyntheticDomain::writeMeteo(const mio::DEMObject& dem, const mio::Date& startdate, const unsigned int& nr_steps) const
+{
+	Config meteo_cfg;
+	meteo_cfg.addKey("COORDSYS", "Input", coordsys);
+	meteo_cfg.addKey("COORDPARAM", "Input", coordparam);
+	meteo_cfg.addKey("TIME_ZONE", "Input", IOUtils::toString(tz));
+	meteo_cfg.addKey("COORDSYS", "Output", coordsys);
+	meteo_cfg.addKey("COORDPARAM", "Output", coordparam);
+	meteo_cfg.addKey("TIME_ZONE", "Output", IOUtils::toString(tz));
+	meteo_cfg.addKey("METEO", "Output", "SMET");
+	meteo_cfg.addKey("METEOPATH", "Output", workdir);
+	IOManager io(meteo_cfg);
+
+	const std::vector< std::pair<size_t,size_t> > positions( getStationsPositions() );
+	const Date start( startdate - 2. );
+	const size_t nr_hours = nr_steps + 4*24;
+
+	std::vector< std::vector<MeteoData> > vecMeteo( positions.size() );
+	for (size_t st=0; st<positions.size(); st++) {
+		const size_t ix = positions[st].first, iy = positions[st].second;
+		Coords location(coordsys, coordparam);
+		location.setXY(dem.llcorner.getEasting() + (static_cast<double>(ix)+.5)*cellsize,
+		               dem.llcorner.getNorthing() + (static_cast<double>(iy)+.5)*cellsize, dem(ix, iy));
+		const std::string id( "SYN"+IOUtils::toString(st+1) );
+		const StationData sd(location, id, "Synthetic station "+IOUtils::toString(st+1));
+		const double altitude = dem(ix, iy);
+		const double dz = altitude - base_altitude;
+
+		SunObject sun(location.getLat(), location.getLon(), altitude);
+		vecMeteo[st].reserve( nr_hours );
+		for (size_t hh=0; hh<nr_hours; hh++) {
+			const Date date( start + static_cast<double>(hh)/24. );
+			const double t = static_cast<double>(hh) / 24.; //in days
+			int year, month, day, hour, minute;
+			date.getDate(year, month, day, hour, minute);
+
+			const bool precip = (std::sin(2.*Cst::PI*t/4.) > 0.6); //one precipitation event every four days
+			const double ta = 268.15 + 4.*std::cos(2.*Cst::PI*(hour-14)/24.) + 3.*std::sin(2.*Cst::PI*t/5.) - 0.0065*dz;
+			const double rh = (precip)? 0.95 : 0.7 + 0.15*std::sin(2.*Cst::PI*t/3.);
+			const double vw = 3. + 2.5*(1. + std::sin(2.*Cst::PI*t/2.)) + 0.002*dz;
+			const double dw = std::fmod(270. + 60.*std::sin(2.*Cst::PI*t/6.), 360.);
+			const double psum = (precip)? 0.8 * (1. + 0.0005*dz) : 0.;
+
+			sun.setDate(date.getJulian(true), 0.);
+			sun.calculateRadiation(ta, rh, 0.5);
+			double toa, direct, diffuse;
+			sun.getHorizontalRadiation(toa, direct, diffuse);
+			const double iswr = (direct + diffuse) * ((precip)? 0.4 : 1.);
+			const double ilwr = Atmosphere::Brutsaert_ilwr(rh, ta) * ((precip)? 1.15 : 1.);
+
+			MeteoData md(date, sd);
+			md(MeteoData::TA) = ta;
+			md(MeteoData::RH) = rh;
+			md(MeteoData::VW) = vw;
+			md(MeteoData::DW) = dw;
+			md(MeteoData::ISWR) = iswr;
+			md(MeteoData::ILWR) = ilwr;
+			md(MeteoData::PSUM) = psum;
+			md(MeteoData::TSG) = 273.15;
+			vecMeteo[st].push_back( md );
+		}
+	}
+
+	io.writeMeteoData(vecMeteo);
+}
+
+void SyntheticDomain::writeSnowFiles(const mio::Date& startdate) const
+{
+	const Date profile_date( startdate - 1./24. );
+	const int codes[] = {LUS_FOREST, LUS_MEADOW, LUS_GLACIER};
+	for (size_t ii=0; ii<3; ii++) {
+		writeSnowFile(codes[ii], profile_date);
+		writeSnowFile(codes[ii]+1, profile_date);
+	}
+}
+
+//write the initial snow cover file for a given land use class: soil layers, ice for glaciers and snow for the xxx01 classes
+void SyntheticDomain::writeSnowFile(const int& landuse_code, const mio::Date& profile_date) const
+{
+	const bool is_forest = (landuse_code/100 == LUS_FOREST/100);
+	const bool is_glacier = (landuse_code/100 == LUS_GLACIER/100);
+	const bool has_snow = (landuse_code%100 == 1);
+	static const double soil_layers[] = {2., 1., .5, .25, .15};
+	static const size_t nr_soil = 5, nr_ice = 10, nr_snow = 5;
+	const size_t nr_snow_layers = ((is_glacier)? nr_ice : 0) + ((has_snow)? nr_snow : 0);
+	const double hs = ((has_snow)? static_cast<double>(nr_snow)*0.15 : 0.);
+
+	const std::string name( experiment + "_" + IOUtils::toString(landuse_code) );
+	const std::string filename( workdir + "/" + name + ".sno" );
+	std::ofstream fout(filename.c_str());
+	if (fout.fail()) throw AccessException(filename, AT);
+
+	const std::string date_str( profile_date.toString(Date::ISO) );
+	fout << "SMET 1.1 ASCII\n";
+	fout << "[HEADER]\n";
+	fout << "station_id = " << name << "\n";
+	fout << "station_name = " << name << "\n";
+	fout << std::fixed << std::setprecision(6) << "latitude = " << latitude << "\n";
+	fout << "longitude = " << longitude << "\n";
+	fout << std::setprecision(1) << "altitude = " << base_altitude << "\n";
+	fout << "nodata = -999\n";
+	fout << std::setprecision(2) << "tz = " << tz << "\n";
+	fout << "ProfileDate = " << date_str << "\n";
+	fout << "HS_Last = " << hs << "\n";
+	fout << "SlopeAngle = 0\n";
+	fout << "SlopeAzi = 0\n";
+	fout << "nSoilLayerData = " << nr_soil << "\n";
+	fout << "nSnowLayerData = " << nr_snow_layers << "\n";
+	fout << "SoilAlbedo = 0.2\n";
+	fout << "BareSoil_z0 = 0.02\n";
+	fout << "CanopyHeight = " << ((is_forest)? 15. : 0.) << "\n";
+	fout << "CanopyLeafAreaIndex = " << ((is_forest)? 4. : 0.) << "\n";
+	fout << "CanopyDirectThroughfall = " << ((is_forest)? 0.1 : 1.) << "\n";
+	fout << "WindScalingFactor = 1\n";
+	fout << "ErosionLevel = " << ((nr_snow_layers>0)? nr_soil+nr_snow_layers-1 : nr_soil-1) << "\n";
+	fout << "TimeCountDeltaHS = 0\n";
+	fout << "fields = timestamp Layer_Thick T Vol_Frac_I Vol_Frac_W Vol_Frac_V Vol_Frac_S Rho_S Conduc_S HeatCapac_S rg rb dd sp mk mass_hoar ne CDot metamo\n";
+	fout << "[DATA]\n";
+
+	//layers are written from the bottom to the top
+	for (size_t ii=0; ii<nr_soil; ii++)
+		fout << date_str << " " << soil_layers[ii] << " 274.15 0.0 0.045 0.22297 0.73203 2400.0 0.3 900.0 163.84 0.0 0.0 0.0 0 0.0 1 0 0\n";
+	if (is_glacier) {
+		for (size_t ii=0; ii<nr_ice; ii++)
+			fout << date_str << " 2.00 271.15 0.95 0.0 0.05 0.0 0.0 0.0 0.0 5.0 2.5 0.0 1.0 7 0.0 1 0 0\n";
+	}
+	if (has_snow) {
+		for (size_t ii=0; ii<nr_snow; ii++)
+			fout << date_str << " 0.15 268.15 0.30 0.0 0.70 0.0 0.0 0.0 0.0 0.5 0.2 0.0 0.5 0 0.0 1 0 0\n";
+	}
+
+	fout.close();
+}
+
+/**
+ * @brief Write a wind field in the ARPS ascii format
+ * @details The wind has a logarithmic profile, follows the terrain and blows from the given direction. As in ARPS,
+ * the first level is below the ground and the second level is the ground.
+ * @param dem the domain's DEM
+ * @param name wind field name (also used as file name)
+ * @param direction direction the wind is blowing from (deg)
+ */
+void SyntheticDomain::writeWindField(const mio::DEMObject& dem, const std::string& name, const double& direction) const
+{
+	static const double z_ref = 10., z0 = 0.03;
+	const std::string filename( workdir + "/" + name );
+	std::ofstream fout(filename.c_str());
+	if (fout.fail()) throw AccessException(filename, AT);
+
+	std::vector<double> heights(nz);
+	for (size_t iz=1; iz<nz; iz++) heights[iz] = 3. * std::pow(static_cast<double>(iz-1), 1.5);
+	heights[0] = -heights[2];
+
+	const double u_dir = -std::sin(direction*Cst::to_rad), v_dir = -std::cos(direction*Cst::to_rad);
+	Array3D<double> z(nx, ny, nz), u(nx, ny, nz), v(nx, ny, nz), w(nx, ny, nz);
+	for (size_t iy=0; iy<ny; iy++) {
+		for (size_t ix=0; ix<nx; ix++) {
+			const size_t ix0 = (ix>0)? ix-1 : ix, ix1 = (ix<nx-1)? ix+1 : ix;
+			const size_t iy0 = (iy>0)? iy-1 : iy, iy1 = (iy<ny-1)? iy+1 : iy;
+			const double sx = (dem(ix1, iy) - dem(ix0, iy)) / (static_cast<double>(ix1-ix0)*cellsize);
+			const double sy = (dem(ix, iy1) - dem(ix, iy0)) / (static_cast<double>(iy1-iy0)*cellsize);
+			for (size_t iz=0; iz<nz; iz++) {
+				z(ix, iy, iz) = dem(ix, iy) + heights[iz];
+				const double height = std::max(heights[iz], 0.5); //as in ARPS, the ground and below ground levels are not at rest
+				const double vw = wind_speed * std::log((height+z0)/z0) / std::log((z_ref+z0)/z0);
+				u(ix, iy, iz) = vw * u_dir;
+				v(ix, iy, iz) = vw * v_dir;
+				w(ix, iy, iz) = (u(ix, iy, iz)*sx + v(ix, iy, iz)*sy) * std::exp(-height/200.);
+			}
+		}
+	}
+
+	fout << "# Synthetic wind field generated by Alpine3D\n";
+	fout << "# blowing from " << direction << " deg\n";
+	fout << "# written in the ARPS ascii format\n";
+	fout << "#\n";
+	fout << " nx = " << nx << ", ny = " << ny << ", nz = " << nz << "\n";
+	fout << std::fixed << std::setprecision(3);
+	fout << "x coordinate\n";
+	for (size_t ix=0; ix<nx; ix++) fout << " " << static_cast<double>(ix)*cellsize << ((ix%10==9)? "\n" : "");
+	fout << "\ny coordinate\n";
+	for (size_t iy=0; iy<ny; iy++) fout << " " << static_cast<double>(iy)*cellsize << ((iy%10==9)? "\n" : "");
+	fout << "\nz coordinate\n";
+	for (size_t iz=0; iz<nz; iz++) fout << " " << heights[iz] << ((iz%10==9)? "\n" : "");
+	fout << "\n";
+
+	const std::string labels[] = {"zp coordinat", "u", "v", "w"};
+	const Array3D<double>* fields[] = {&z, &u, &v, &w};
+	for (size_t ff=0; ff<4; ff++) {
+		fout << labels[ff] << "\n";
+		const Array3D<double>& field = *fields[ff];
+		size_t count = 0;
+		for (size_t iz=0; iz<nz; iz++) {
+			for (size_t iy=0; iy<ny; iy++) {
+				for (size_t ix=0; ix<nx; ix++) {
+					fout << " " << field(ix, iy, iz);
+					if ((++count)%10 == 0) fout << "\n";
+				}
+			}
+		}
+		fout << "\n";
+	}
+
+	fout.close();
+}
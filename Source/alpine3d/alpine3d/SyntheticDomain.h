@@ -0,0 +1,107 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SYNTHETICDOMAIN_H
+#define SYNTHETICDOMAIN_H
+
+#include <meteoio/MeteoIO.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @page benchmark Synthetic domain benchmark
+ * In order to evaluate the performances of Alpine3D (and its strong and weak scaling with the number of OpenMP workers and
+ * MPI processes) independently of any production data, Alpine3D can generate its own simulation domain. When running with
+ * the "--benchmark" command line switch, the master process generates a DEM, a land use grid, the meteorological forcing
+ * of a few stations, the initial snow cover files for each land use class and (when snowdrift is enabled) some wind fields
+ * in a working directory. It then sets all the [Input] keys that point to these files, so the rest of the configuration file
+ * (output, snowpack, interpolations, etc) is used as usual. Since the generation is fully deterministic, two runs with the same
+ * keys always simulate exactly the same domain.
+ *
+ * The domain is a valley oriented along the y axis with some harmonics superimposed. The highest cells are covered by glaciers,
+ * the lowest cells by forest and the remaining cells are meadows. All cells above a snow line start the simulation with a snow
+ * cover (their land use code is then xxx01 instead of xxx00, for example 10701 for a snow covered meadow). The forcing starts
+ * cold and dry, with a few precipitation events and a daily cycle for air temperature and radiation.
+ *
+ * The following keys in the [Benchmark] section control the generation:
+ * 	- NX, NY: number of cells of the domain (default: 50 x 50);
+ * 	- CELLSIZE: cell size in meters (default: 100);
+ * 	- LATITUDE, LONGITUDE: geographic coordinates of the lower left corner (default: 46.8, 9.8);
+ * 	- BASE_ALTITUDE: altitude of the valley floor (default: 1500 m);
+ * 	- RELIEF: altitude difference between the valley floor and the highest cells (default: 1500 m);
+ * 	- NR_STATIONS: number of meteorological stations, spread over the domain (default: 4);
+ * 	- GLACIER_FRACTION: fraction of the cells covered by glaciers (default: 0.1);
+ * 	- FOREST_FRACTION: fraction of the cells covered by forest (default: 0.2);
+ * 	- SNOW_FRACTION: fraction of the cells that are snow covered at the start of the simulation (default: 0.5);
+ * 	- NZ: number of vertical levels of the wind fields, only used by snowdrift (default: 10);
+ * 	- WIND_SPEED: wind speed 10 m above the ground in the wind fields, only used by snowdrift (default: 5 m/s, which is
+ * 	too weak for saltation to start);
+ * 	- SEED: seed of the random generator used to build the terrain (default: 1);
+ * 	- WORKDIR: where to write the generated files, this directory must exist (default: ./synthetic);
+ * 	- RESULTS_FILE: if set, one line of timing results is appended to this file at the end of the run (see below).
+ *
+ * The modules are selected as usual: the energy balance with "--enable-eb", the terrain radiation with the
+ * TERRAIN_RADIATION key in the [EBalance] section, the snowdrift with "--enable-drift" and the runoff with "--enable-runoff".
+ * The number of steps to simulate is given with "--steps" (the forcing is generated accordingly).
+ *
+ * At the end of the run, the master process prints the time spent in each module (please note that the terrain radiation
+ * is part of the energy balance and that when snowdrift is enabled, it triggers the Snowpack computation so its
+ * timing includes Snowpack's). When RESULTS_FILE is set, it also appends
+ * a line containing the number of processes, the number of Snowpack and Ebalance workers, the number of simulated cells,
+ * the number of steps and the time spent in each module to this file. The script "tests/scaling/run_scaling.sh" uses it to
+ * run strong and weak scaling series and to print the speedup and parallel efficiency of each module.
+ * @code
+ * alpine3d --iofile=io.ini --benchmark --enable-eb --np-snowpack=4 --np-ebalance=4 --startdate=2014-12-01T01:00 --steps=24
+ * @endcode
+ */
+
+class SyntheticDomain
+{
+	public:
+		SyntheticDomain(const mio::Config& cfg);
+
+		void generate(const mio::Date& startdate, const unsigned int& nr_steps, const bool& wind_fields) const;
+		void setConfig(mio::Config& cfg, const bool& wind_fields) const;
+
+	private:
+		/** @brief Minimal deterministic random generator, so all platforms generate the same domain */
+		class Lcg {
+			public:
+				Lcg(const unsigned int& seed) : state(seed*2654435761u + 1u) {}
+				double next() { state = state*1664525u + 1013904223u; return static_cast<double>(state >> 8) / 16777216.; }
+			private:
+				unsigned int state;
+		};
+
+		mio::DEMObject buildDEM() const;
+		mio::Grid2DObject buildLanduse(const mio::DEMObject& dem) const;
+		void writeMeteo(const mio::DEMObject& dem, const mio::Date& startdate, const unsigned int& nr_steps) const;
+		void writeSnowFiles(const mio::Date& startdate) const;
+		void writeSnowFile(const int& landuse_code, const mio::Date& profile_date) const;
+		void writeWindField(const mio::DEMObject& dem, const std::string& name, const double& direction) const;
+		std::vector< std::pair<size_t,size_t> > getStationsPositions() const;
+
+		static const std::string wind_fields_names[];
+
+		std::string workdir, experiment, coordsys, coordparam;
+		double cellsize, latitude, longitude, base_altitude, relief, wind_speed;
+		double glacier_fraction, forest_fraction, snow_fraction, tz;
+		unsigned int nx, ny, nz, nr_stations, seed;
+};
+
+#endif
@@ -26,7 +26,7 @@ EnergyBalance::EnergyBalance(const unsigned int& i_nbworkers, const mio::Config&
               : snowpack(NULL), terrain_radiation(NULL), radfields(), dem(dem_in), vecMeteo(), 
                 albedo(dem, 0.), direct_unshaded_horizontal(dem_in.getNx(), dem_in.getNy(), 0.),
                 direct(dem_in.getNx(), dem_in.getNy(), 0.), diffuse(dem_in.getNx(), dem_in.getNy(), 0.), 
-                reflected(dem_in.getNx(), dem_in.getNy(), 0.), timer(), cfg(cfg_in), 
+                reflected(dem_in.getNx(), dem_in.getNy(), 0.), domain(), timer(), terrain_timer(), cfg(cfg_in), 
                 dimx(dem_in.getNx()), dimy(dem_in.getNy()), nbworkers(i_nbworkers)
 {
 
@@ -34,6 +34,7 @@ EnergyBalance::EnergyBalance(const unsigned int& i_nbworkers, const mio::Config&
 
 	size_t startx = 0, nx = dimx;
 	instance.getArraySliceParams(dimx, startx, nx);
+	domain = instance.getDomain(dimx);
 
 	for (size_t ii=0; ii<nbworkers; ii++) {
 		size_t thread_startx, thread_nx;
@@ -84,6 +85,7 @@ EnergyBalance& EnergyBalance::operator=(const EnergyBalance& source) {
 		reflected = source.reflected;
 		direct_unshaded_horizontal = source.reflected;
 		timer = source.timer;
+		terrain_timer = source.terrain_timer;
 		dimx = source.dimx;
 		dimy = source.dimy;
 		nbworkers = source.nbworkers;
@@ -133,7 +135,9 @@ void EnergyBalance::setMeteo(const mio::Grid2DObject& in_ilwr,
                              const mio::Grid2DObject& in_ta, const mio::Grid2DObject& in_rh,
                              const mio::Grid2DObject& in_p, const mio::Date timestamp)
 {
+	MIO_TRACE_ZONE("Alpine3D", "EnergyBalance");
 	timer.restart();
+	terrain_timer.reset();
 
 	#pragma omp parallel for schedule(dynamic)
 	for (size_t ii=0; ii<nbworkers; ii++) {
@@ -151,9 +155,10 @@ void EnergyBalance::setMeteo(const mio::Grid2DObject& in_ilwr,
 		diffuse.fill(band_diffuse, startx, 0, nx, dimy);
 		direct_unshaded_horizontal.fill(band_direct_unshaded_horizontal, startx, 0, nx, dimy);
 	}
-	MPIControl::instance().reduce_sum(direct);
-	MPIControl::instance().reduce_sum(diffuse);
-	MPIControl::instance().reduce_sum(direct_unshaded_horizontal);
+	//each process only sends its own band, the terrain radiation and Snowpack need the full grids
+	MPIControl::instance().allgather(direct, domain);
+	MPIControl::instance().allgather(diffuse, domain);
+	MPIControl::instance().allgather(direct_unshaded_horizontal, domain);
 	double solarAzimuth, solarElevation;
 	radfields[0].getPositionSun(solarAzimuth, solarElevation);
 
@@ -162,6 +167,7 @@ void EnergyBalance::setMeteo(const mio::Grid2DObject& in_ilwr,
 	sky_ilwr=0;
 	terrain_ilwr=0;
 	if (terrain_radiation) {
+		terrain_timer.start();
 		// note: parallelization has to take place inside the TerrainRadiationAlgorithm implementations
 		terrain_radiation->setMeteo(albedo.grid2D, in_ta.grid2D);
 		terrain_radiation->getRadiation(direct, diffuse, reflected, direct_unshaded_horizontal,
@@ -169,6 +175,7 @@ void EnergyBalance::setMeteo(const mio::Grid2DObject& in_ilwr,
 		if (hasSP()){
 			terrain_radiation->setSP(radfields[0].getDate(), solarAzimuth, solarElevation);
 		}
+		terrain_timer.stop();
 	}
 
 	if (MPIControl::instance().master())
@@ -202,3 +209,12 @@ double EnergyBalance::getTiming() const
 {
 	return timer.getElapsed();
 }
+
+/**
+ * @brief Time spent computing the terrain radiation during the last time step (this is included in getTiming())
+ * @return time in seconds
+ */
+double EnergyBalance::getTerrainRadiationTiming() const
+{
+	return terrain_timer.getElapsed();
+}
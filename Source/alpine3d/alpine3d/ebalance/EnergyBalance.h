@@ -86,6 +86,7 @@ class EnergyBalance
 		bool hasSP(){return terrain_radiation->hasSP();}
 		void setStations(const std::vector<mio::MeteoData>& in_vecMeteo);
 		double getTiming() const;
+		double getTerrainRadiationTiming() const;
 		void Destroy();
 		std::string getGridsRequirements() const;
 
@@ -97,7 +98,8 @@ class EnergyBalance
 		std::vector<mio::MeteoData> vecMeteo;
 		mio::Grid2DObject albedo;
 		mio::Array2D<double> direct_unshaded_horizontal, direct, diffuse, reflected; //FELIX: direct_unshaded_horizontal
-		mio::Timer timer;
+		MPIDomain domain; ///< bands of the grids computed by each process
+		mio::Timer timer, terrain_timer; ///< terrain_timer only measures the terrain radiation (also included in timer)
 		const mio::Config& cfg;
 		size_t dimx, dimy;
 		unsigned int nbworkers;
@@ -617,6 +617,7 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double> &direct, mio::Ar
 										   mio::Array2D<double> &/*sky_ilwr*/, mio::Array2D<double> &/*terrain_ilwr*/,
 										   double solarAzimuth, double solarElevation)
 {
+	MIO_TRACE_ZONE("Alpine3D", "TerrainRadiation");
 	MPIControl &mpicontrol = MPIControl::instance();
 
 	if (_hasSP) {
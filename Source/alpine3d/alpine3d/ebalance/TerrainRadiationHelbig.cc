@@ -94,6 +94,7 @@ void TerrainRadiationHelbig::setMeteo(const mio::Array2D<double> &albedo, const
 
 void TerrainRadiationHelbig::Compute()
 {
+	MIO_TRACE_ZONE("Alpine3D", "TerrainRadiation");
 	ComputeRadiationBalance();
 }
 
@@ -73,6 +73,10 @@ inline int CellsRadComparator_Helbig(const void *cell1, const void *cell2)
  *       - vf_file: file containing the sky view factors
  *       - tvfarea: file containing the terrain view factors x surface
  *
+ * The sector and cluster view factors are computed in parallel and stored as sparse matrices. If the VF_CACHE key
+ * in the [EBalance] section points to an existing directory, these matrices are written there and read back by the
+ * following runs, as long as the DEM and the parameters they depend on have not changed.
+ *
  */
 class TerrainRadiationHelbig : public TerrainRadiationAlgorithm
 {
@@ -23,11 +23,12 @@ using namespace mio;
 TerrainRadiationSimple::TerrainRadiationSimple(const mio::Config& /*i_cfg*/, const mio::DEMObject& dem_in, const std::string& method)
                        : TerrainRadiationAlgorithm(method),
                          albedo_grid(dem_in.getNx(), dem_in.getNy(), IOUtils::nodata), sky_vf(dem_in.getNx(), dem_in.getNy(), 0),
-                         dimx(dem_in.getNx()), dimy(dem_in.getNy()), startx(0), endx(dimx)
+                         dimx(dem_in.getNx()), dimy(dem_in.getNy()), startx(0), endx(dimx), domain()
 {
 	// In case we're running with MPI enabled, calculate the slice this process is responsible for
 	size_t nx = dimx;
 	MPIControl::instance().getArraySliceParams(dimx, startx, nx);
+	domain = MPIControl::instance().getDomain(dimx);
 	endx = startx + nx;
 
 	initSkyViewFactor(dem_in);
@@ -43,9 +44,10 @@ void TerrainRadiationSimple::getRadiation(mio::Array2D<double>& /*direct*/,
                                           mio::Array2D<double>& /*terrain_ilwr*/,
                                           double /*solarAzimuth*/, double /*solarElevation*/)
 {
+	MIO_TRACE_ZONE("Alpine3D", "TerrainRadiation");
 	MPIControl& mpicontrol = MPIControl::instance();
-	terrain.resize(dimx, dimy, 0.);  //so reduce_sum works properly when it sums full grids
-	Array2D<double> diff_corr(dimx, dimy, 0.); //so reduce_sum works properly when it sums full grids
+	terrain.resize(dimx, dimy, 0.);
+	Array2D<double> diff_corr(dimx, dimy, 0.);
 
 	if (mpicontrol.master()) {
 		std::cout << "[i] Calculating terrain radiation with simple method, using " << mpicontrol.size();
@@ -68,8 +70,8 @@ void TerrainRadiationSimple::getRadiation(mio::Array2D<double>& /*direct*/,
 		}
 	}
 
-	mpicontrol.reduce_sum(terrain);
-	mpicontrol.reduce_sum(diff_corr);
+	mpicontrol.allgather(terrain, domain);
+	mpicontrol.allgather(diff_corr, domain);
 	diffuse = diff_corr; //return the corrected diffuse radiation
 }
 
@@ -108,7 +110,7 @@ void TerrainRadiationSimple::setMeteo(const mio::Array2D<double>& albedo, const
 
 void TerrainRadiationSimple::getSkyViewFactor(mio::Array2D<double> &o_sky_vf) {
 	o_sky_vf = sky_vf;
-	MPIControl::instance().reduce_sum(o_sky_vf);
+	MPIControl::instance().allgather(o_sky_vf, domain);
 }
 
 void TerrainRadiationSimple::initSkyViewFactor(const mio::DEMObject &dem)
@@ -55,6 +55,7 @@ class TerrainRadiationSimple : public TerrainRadiationAlgorithm {
 
 		const size_t dimx, dimy;
 		size_t startx, endx;
+		MPIDomain domain;
 };
 
 #endif
@@ -0,0 +1,227 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <alpine3d/ebalance/VFSparseMatrix.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+using namespace mio;
+using namespace std;
+
+const char VFSparseMatrix::magic[8] = {'A', '3', 'D', 'V', 'F', 'C', 'S', 'R'};
+
+static bool compareCols(const std::pair<size_t, double>& a, const std::pair<size_t, double>& b)
+{
+	return a.first < b.first;
+}
+
+/**
+ * @brief Build the matrix from lists of (row, column, value) triplets
+ * @details The entries given several times for the same row and column are summed in the order they appear in the lists.
+ * @param nrows number of rows of the matrix
+ * @param triplets lists of triplets, in any order
+ */
+void VFSparseMatrix::build(const size_t& nrows, const std::vector< std::vector<Triplet> >& triplets)
+{
+	//counting sort of the triplets by row
+	std::vector<size_t> ptr(nrows+1, 0);
+	for (size_t ll=0; ll<triplets.size(); ll++) {
+		for (size_t ii=0; ii<triplets[ll].size(); ii++) {
+			if (triplets[ll][ii].row >= nrows) throw IndexOutOfBoundsException("View factor row out of range", AT);
+			ptr[ triplets[ll][ii].row+1 ]++;
+		}
+	}
+	for (size_t ii=0; ii<nrows; ii++) ptr[ii+1] += ptr[ii];
+
+	std::vector< std::pair<size_t, double> > entries( ptr[nrows] );
+	std::vector<size_t> cursor(ptr.begin(), ptr.end()-1);
+	for (size_t ll=0; ll<triplets.size(); ll++) {
+		for (size_t ii=0; ii<triplets[ll].size(); ii++) {
+			const Triplet& triplet = triplets[ll][ii];
+			entries[ cursor[triplet.row]++ ] = std::make_pair(triplet.col, triplet.value);
+		}
+	}
+
+	//sort each row by column and merge the duplicates
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (size_t row=0; row<nrows; row++) {
+		std::stable_sort(entries.begin()+ptr[row], entries.begin()+ptr[row+1], compareCols);
+	}
+
+	row_ptr.assign(nrows+1, 0);
+	cols.clear();
+	values.clear();
+	cols.reserve(entries.size());
+	values.reserve(entries.size());
+	for (size_t row=0; row<nrows; row++) {
+		for (size_t ii=ptr[row]; ii<ptr[row+1]; ii++) {
+			if (ii>ptr[row] && entries[ii].first==cols.back())
+				values.back() += entries[ii].second;
+			else {
+				cols.push_back(entries[ii].first);
+				values.push_back(entries[ii].second);
+			}
+		}
+		row_ptr[row+1] = values.size();
+	}
+}
+
+/**
+ * @brief Get a view factor
+ * @param row index of the shooting cell
+ * @param col index of the receiving cell
+ * @return view factor, 0 if it is not in the matrix
+ */
+double VFSparseMatrix::operator()(const size_t& row, const size_t& col) const
+{
+	if (row+1 >= row_ptr.size()) return 0.;
+	const std::vector<size_t>::const_iterator begin( cols.begin()+row_ptr[row] ), end( cols.begin()+row_ptr[row+1] );
+	const std::vector<size_t>::const_iterator it( std::lower_bound(begin, end, col) );
+	if (it == end || *it != col) return 0.;
+	return values[ static_cast<size_t>(it - cols.begin()) ];
+}
+
+/**
+ * @brief Sum of all the view factors of a row, ie the fraction of the hemisphere of the shooting cell that is covered by terrain
+ */
+double VFSparseMatrix::getRowSum(const size_t& row) const
+{
+	if (row+1 >= row_ptr.size()) return 0.;
+	double sum = 0.;
+	for (size_t ii=row_ptr[row]; ii<row_ptr[row+1]; ii++) sum += values[ii];
+	return sum;
+}
+
+/**
+ * @brief Compute a signature identifying the DEM (geometry and altitudes) and the parameters used to compute the view factors
+ * @param dem DEM
+ * @param params all the parameters that influence the view factors
+ * @return signature as an hexadecimal string
+ */
+std::string VFSparseMatrix::getSignature(const mio::DEMObject& dem, const std::vector<double>& params)
+{
+	std::vector<double> data;
+	data.push_back( static_cast<double>(dem.getNx()) );
+	data.push_back( static_cast<double>(dem.getNy()) );
+	data.push_back( dem.cellsize );
+	data.push_back( dem.llcorner.getEasting() );
+	data.push_back( dem.llcorner.getNorthing() );
+	data.insert(data.end(), params.begin(), params.end());
+	const size_t count = dem.getNx()*dem.getNy();
+	for (size_t ii=0; ii<count; ii++) data.push_back( dem.grid2D(ii) );
+
+	//64 bits FNV-1a hash
+	unsigned long long hash = 14695981039346656037ULL;
+	const unsigned char *bytes = reinterpret_cast<const unsigned char*>( &data[0] );
+	for (size_t ii=0; ii<data.size()*sizeof(double); ii++) {
+		hash ^= bytes[ii];
+		hash *= 1099511628211ULL;
+	}
+
+	std::ostringstream ss;
+	ss << std::hex;
+	ss.width(16);
+	ss.fill('0');
+	ss << hash;
+	return ss.str();
+}
+
+std::string VFSparseMatrix::getCacheFilename(const std::string& cache_dir, const std::string& name, const std::string& signature)
+{
+	return cache_dir + "/vf_" + name + "_" + signature + ".a3dvf";
+}
+
+/**
+ * @brief Read the matrix from the cache directory
+ * @param cache_dir cache directory
+ * @param name name of the view factors algorithm
+ * @param signature signature of the DEM and parameters (see getSignature())
+ * @return false if there is no valid cache file (the matrix is then left unchanged)
+ */
+bool VFSparseMatrix::readCache(const std::string& cache_dir, const std::string& name, const std::string& signature)
+{
+	std::ifstream fin(getCacheFilename(cache_dir, name, signature).c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	char file_magic[8], file_signature[16];
+	long long header[2]; //nrows, nnz
+	fin.read(file_magic, sizeof(file_magic));
+	fin.read(file_signature, sizeof(file_signature));
+	fin.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (fin.fail() || memcmp(file_magic, magic, sizeof(magic)) != 0) return false;
+	if (signature.size() != sizeof(file_signature) || memcmp(file_signature, signature.c_str(), sizeof(file_signature)) != 0) return false;
+	if (header[0] < 0 || header[1] < 0) return false;
+
+	const size_t nrows = static_cast<size_t>(header[0]), nnz = static_cast<size_t>(header[1]);
+	std::vector<long long> buffer(std::max(nrows+1, nnz));
+	std::vector<size_t> file_row_ptr(nrows+1), file_cols(nnz);
+	std::vector<double> file_values(nnz);
+
+	fin.read(reinterpret_cast<char*>(&buffer[0]), static_cast<std::streamsize>((nrows+1)*sizeof(long long)));
+	for (size_t ii=0; ii<=nrows; ii++) file_row_ptr[ii] = static_cast<size_t>(buffer[ii]);
+	if (nnz > 0) {
+		fin.read(reinterpret_cast<char*>(&buffer[0]), static_cast<std::streamsize>(nnz*sizeof(long long)));
+		for (size_t ii=0; ii<nnz; ii++) file_cols[ii] = static_cast<size_t>(buffer[ii]);
+		fin.read(reinterpret_cast<char*>(&file_values[0]), static_cast<std::streamsize>(nnz*sizeof(double)));
+	}
+	if (fin.fail() || file_row_ptr[0] != 0 || file_row_ptr[nrows] != nnz) return false;
+
+	row_ptr.swap(file_row_ptr);
+	cols.swap(file_cols);
+	values.swap(file_values);
+	return true;
+}
+
+/**
+ * @brief Write the matrix into the cache directory. The file is first written under a temporary name and
+ * then renamed, so an interrupted run never leaves a truncated cache file behind.
+ * @param cache_dir cache directory
+ * @param name name of the view factors algorithm
+ * @param signature signature of the DEM and parameters (see getSignature())
+ */
+void VFSparseMatrix::writeCache(const std::string& cache_dir, const std::string& name, const std::string& signature) const
+{
+	if (signature.size() != 16) throw InvalidArgumentException("Invalid view factors signature '"+signature+"'", AT);
+	const std::string filename( getCacheFilename(cache_dir, name, signature) );
+	const std::string tmp_filename( filename + ".tmp" );
+	{
+		std::ofstream fout(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+		if (fout.fail()) throw AccessException(tmp_filename, AT);
+
+		const size_t nrows = getNrows(), nnz = getNnz();
+		const long long header[2] = {static_cast<long long>(nrows), static_cast<long long>(nnz)};
+		fout.write(magic, sizeof(magic));
+		fout.write(signature.c_str(), 16);
+		fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		const std::vector<long long> file_row_ptr(row_ptr.begin(), row_ptr.end());
+		fout.write(reinterpret_cast<const char*>(&file_row_ptr[0]), static_cast<std::streamsize>((nrows+1)*sizeof(long long)));
+		if (nnz > 0) {
+			const std::vector<long long> file_cols(cols.begin(), cols.end());
+			fout.write(reinterpret_cast<const char*>(&file_cols[0]), static_cast<std::streamsize>(nnz*sizeof(long long)));
+			fout.write(reinterpret_cast<const char*>(&values[0]), static_cast<std::streamsize>(nnz*sizeof(double)));
+		}
+		if (fout.fail()) throw AccessException("Could not write "+tmp_filename, AT);
+	}
+	if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+		throw AccessException("Could not rename "+tmp_filename+" to "+filename, AT);
+}
@@ -0,0 +1,65 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef VFSPARSEMATRIX_H
+#define VFSPARSEMATRIX_H
+
+#include <meteoio/MeteoIO.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @class VFSparseMatrix
+ * @brief Read-only sparse matrix of view factors in compressed row format (one row per shooting cell, one column per
+ * receiving cell, both being 64 bits indices).
+ * @details The matrix is built once from lists of triplets (for example one list per OpenMP thread), the values given
+ * several times for the same row and column being summed up. Looking up a view factor is then a binary search
+ * within its row. The matrix can be written to and read back from a cache directory; the cache files carry a signature
+ * (see getSignature()) so a matrix computed for another DEM or other parameters is never used.
+ */
+class VFSparseMatrix {
+	public:
+		typedef struct TRIPLET {
+			TRIPLET(const size_t& i_row, const size_t& i_col, const double& i_value) : row(i_row), col(i_col), value(i_value) {}
+			size_t row, col;
+			double value;
+		} Triplet;
+
+		VFSparseMatrix() : row_ptr(1, 0), cols(), values() {}
+
+		void build(const size_t& nrows, const std::vector< std::vector<Triplet> >& triplets);
+		double operator()(const size_t& row, const size_t& col) const;
+		double getRowSum(const size_t& row) const;
+		size_t getNrows() const {return row_ptr.size()-1;}
+		size_t getNnz() const {return values.size();}
+
+		static std::string getSignature(const mio::DEMObject& dem, const std::vector<double>& params);
+		bool readCache(const std::string& cache_dir, const std::string& name, const std::string& signature);
+		void writeCache(const std::string& cache_dir, const std::string& name, const std::string& signature) const;
+
+	private:
+		static std::string getCacheFilename(const std::string& cache_dir, const std::string& name, const std::string& signature);
+
+		static const char magic[8];
+
+		std::vector<size_t> row_ptr; ///< index of the first entry of each row, plus the total number of entries
+		std::vector<size_t> cols; ///< column of each entry, sorted within each row
+		std::vector<double> values;
+};
+
+#endif
@@ -17,7 +17,9 @@
 */
 #include <alpine3d/ebalance/ViewFactorsCluster.h>
 
-ViewFactorsCluster::ViewFactorsCluster(const mio::Config& cfg, const mio::DEMObject &dem_in) : dem(dem_in)
+#include <sys/stat.h>
+
+ViewFactorsCluster::ViewFactorsCluster(const mio::Config& cfg, const mio::DEMObject &dem_in) : sky_vf(), vf(), dem(dem_in), cache_dir()
 {
 	cellsize = dem.cellsize;
 	dimx = dem.getNx();
@@ -27,6 +29,12 @@ ViewFactorsCluster::ViewFactorsCluster(const mio::Config& cfg, const mio::DEMObj
 
 	cfg.getValue("sw_radius", "EBalance", sw_radius);
 	cfg.getValue("sub_crit", "EBalance", sub_crit);
+	cfg.getValue("VF_CACHE", "EBalance", cache_dir, mio::IOUtils::nothrow);
+	if (!cache_dir.empty()) {
+		struct stat buffer;
+		if (stat(cache_dir.c_str(), &buffer) != 0 || !S_ISDIR(buffer.st_mode))
+			throw mio::AccessException("The VF_CACHE directory '"+cache_dir+"' does not exist", AT);
+	}
 
 	hSections = 60;
 	vSections = 30;
@@ -36,8 +44,37 @@ ViewFactorsCluster::ViewFactorsCluster(const mio::Config& cfg, const mio::DEMObj
 
 	max_shade_distance = std::numeric_limits<double>::max();
 
-	calcVF_cluster();
-	fill_vf_map();
+	const std::string signature( getSignature() );
+	if (!cache_dir.empty() && vf.readCache(cache_dir, "cluster", signature)) {
+		std::cout << "[i] cluster view factors read from " << cache_dir << "\n";
+	} else {
+		calcVF_cluster();
+		if (!cache_dir.empty()) {
+			try {
+				vf.writeCache(cache_dir, "cluster", signature);
+			} catch (const std::exception& e) { //the cache is only an optimization, the simulation can go on
+				std::cout << "[W] could not write the cluster view factors: " << e.what() << "\n";
+			}
+		}
+	}
+
+	for (int i=0; i<dimx; i++) {
+		for (int j=0; j<dimy; j++)
+			sky_vf(i,j) = 1. - vf.getRowSum( static_cast<size_t>(j) + static_cast<size_t>(i)*static_cast<size_t>(dimy) );
+	}
+}
+
+/**
+ * @brief Signature of the DEM and of all the parameters the cluster view factors depend on, for the view factors cache
+ */
+std::string ViewFactorsCluster::getSignature() const
+{
+	std::vector<double> params;
+	params.push_back( static_cast<double>(hSections) );
+	params.push_back( static_cast<double>(vSections) );
+	params.push_back( sw_radius );
+	params.push_back( sub_crit );
+	return VFSparseMatrix::getSignature(dem, params);
 }
 
 double ViewFactorsCluster::getSkyViewFactor(const int &i, const int &j)
@@ -67,22 +104,34 @@ void ViewFactorsCluster::calcSchrittweite( const double &altitude, const double
 }
 
 
+/**
+ * @brief Compute the cluster view factors
+ * @details The shooting cells are processed in parallel, each thread collecting its own list of view factors
+ * that are then all merged into the sparse view factors matrix.
+ */
 void ViewFactorsCluster::calcVF_cluster()
 {
 	std::cout << "[i] computing cluster view factors" << std::endl;
 
-	vf_cluster.resize(dem.getNx(),dem.getNy(),hSections,vSections);
-	vc_cluster.resize(dem.getNx(),dem.getNy(),hSections,vSections);
+	const size_t ncells = static_cast<size_t>(dimx) * static_cast<size_t>(dimy);
+	std::vector< std::vector<VFSparseMatrix::Triplet> > triplets;
 
-	for (int x=0;x<dimx; x++) {
-		std::cout << x*100/dimx << "%" << std::endl;
-		for (int y=0; y<dimy; y++) {
-			//std::cout << "  " << y*100/dimy << "%" << std::endl;
+	#pragma omp parallel
+	{
+		std::vector<VFSparseMatrix::Triplet> thread_triplets;
+		mio::Array1D<double> tan_h(hSections);
+		mio::Array2D<double> vf_cell(hSections, vSections);
+		mio::Array2D<long long> vc_cell(hSections, vSections);
 
-			mio::Array1D<double> tan_h(hSections);
+		#pragma omp for schedule(dynamic, 16)
+		for (size_t shootID=0; shootID<ncells; shootID++) {
+			const int x = static_cast<int>(shootID / dimy);
+			const int y = static_cast<int>(shootID % dimy);
 
 			for (unsigned int h=0; h<hSections; h++)
 				tan_h(h) = -1 * (dem.Nx(x,y)*sin(h*2.*M_PI/hSections)+dem.Ny(x,y)*cos(h*2.*M_PI/hSections))/dem.Nz(x,y);
+			vf_cell = 0.;
+			vc_cell = -1;
 
 			bool cont = true;
 			int r=1;
@@ -91,29 +140,46 @@ void ViewFactorsCluster::calcVF_cluster()
 				int i = x-r;
 				int j = y-r;
 				while (i<=x+r) {
-					cont = VF_calc(x,y,i,j,tan_h) || cont;
+					cont = VF_calc(x,y,i,j,tan_h,vf_cell,vc_cell) || cont;
 					i++;
 				}
 				i--;
 				while (j<y+r) {
 					j++;
-					cont = VF_calc(x,y,i,j,tan_h) || cont;
+					cont = VF_calc(x,y,i,j,tan_h,vf_cell,vc_cell) || cont;
 				}
 				while (i>x-r) {
 					i--;
-					cont = VF_calc(x,y,i,j,tan_h) || cont;
+					cont = VF_calc(x,y,i,j,tan_h,vf_cell,vc_cell) || cont;
 				}
 				while (j>y-r+1) {
 					j--;
-					cont = VF_calc(x,y,i,j,tan_h) || cont;
+					cont = VF_calc(x,y,i,j,tan_h,vf_cell,vc_cell) || cont;
 				}
 				r++;
 			}
+
+			//each sector is represented by the last cell that has been seen in it
+			for (unsigned int h=0; h<hSections; h++) {
+				for (unsigned int v=0; v<vSections; v++) {
+					if (vc_cell(h,v) < 0 || vf_cell(h,v) == 0.) continue;
+					thread_triplets.push_back( VFSparseMatrix::Triplet(shootID, static_cast<size_t>(vc_cell(h,v)), vf_cell(h,v)) );
+				}
+			}
+		}
+
+		#pragma omp critical(vf_cluster_merge)
+		{
+			triplets.push_back( std::vector<VFSparseMatrix::Triplet>() );
+			triplets.back().swap( thread_triplets );
 		}
 	}
+
+	vf.build(ncells, triplets);
 }
 
-bool ViewFactorsCluster::VF_calc(const unsigned int ix1, const unsigned int iy1, const int ix2, const int iy2, mio::Array1D<double> &tan_h)
+bool ViewFactorsCluster::VF_calc(const unsigned int ix1, const unsigned int iy1, const int ix2, const int iy2, mio::Array1D<double> &tan_h,
+                                 mio::Array2D<double> &vf_cell, mio::Array2D<long long> &vc_cell)
 {
 	//std::cout << ix1 << " " << iy1 << " " <<  ix2 << " " << iy2 << std::endl;
 	if (ix2<0 || ix2>dimx-1 || iy2<0 || iy2>dimy-1) return false;
@@ -149,8 +215,8 @@ bool ViewFactorsCluster::VF_calc(const unsigned int ix1, const unsigned int iy1,
 		if (j >= vSections)
 			j = vSections-1;
 
-		vf_cluster(ix1, iy1, bottom, j) += GetSymetricPartOfViewFactor(ix1,iy1,ix2,iy2) / (EuclidianDistance(dem.Nx(ix1,iy1), dem.Ny(ix1,iy1), 1.) * cellsize * cellsize);
-		vc_cluster(ix1, iy1, bottom, j) = ix2*dimx+iy2;
+		vf_cell(bottom, j) += GetSymetricPartOfViewFactor(ix1,iy1,ix2,iy2) / (EuclidianDistance(dem.Nx(ix1,iy1), dem.Ny(ix1,iy1), 1.) * cellsize * cellsize);
+		vc_cell(bottom, j) = static_cast<long long>(iy2) + static_cast<long long>(ix2)*dimy;
 	}
 	for (unsigned int i=bottom; i<top; i++) {
 		if (tan_angle>tan_h(i)) tan_h(i) = tan_angle;
@@ -159,36 +225,11 @@ bool ViewFactorsCluster::VF_calc(const unsigned int ix1, const unsigned int iy1,
 	return true;
 }
 
-void ViewFactorsCluster::fill_vf_map()
-{
-	std::cout << "[i] computing cluster view factors.. fill map" << std::endl;
-	for (int i=0;i<dimx;i++) {
-		for (int j=0;j<dimy;j++) {
-			for (unsigned int h=0; h<hSections; h++) {
-				for (unsigned int v=0; v<vSections; v++) {
-					const unsigned int shootID = j+i*dimy;
-					const unsigned int ID = vc_cluster(i,j,h,v) + shootID*dimx*dimy;
-
-					const double viewFactor = vf_cluster(i,j,h,v);
-
-					sky_vf(i, j) -= viewFactor;
-
-					vf.insert(std::pair<int,double>(ID, viewFactor));
-				}
-			}
-		}
-	}
-}
-
-
 double ViewFactorsCluster::GetViewfactor(const int i, const int j, const int a, const int b)
 {
-	const unsigned int shootID = j+i*dimy;
-	const unsigned int ID = b+a*dimy + shootID*dimx*dimy;
-
-	if (vf.find(ID) == vf.end())
-		return 0.;
-	return vf.at(ID);
+	const size_t shootID = static_cast<size_t>(j) + static_cast<size_t>(i)*static_cast<size_t>(dimy);
+	const size_t ID = static_cast<size_t>(b) + static_cast<size_t>(a)*static_cast<size_t>(dimy);
+	return vf(shootID, ID);
 }
 
 double ViewFactorsCluster::GetSymetricPartOfViewFactor(const int i, const int j, const int a, const int b)
@@ -20,7 +20,7 @@
 
 #include <meteoio/MeteoIO.h>
 #include <alpine3d/ebalance/ViewFactorsAlgorithm.h>
-#include <map>
+#include <alpine3d/ebalance/VFSparseMatrix.h>
 
 class ViewFactorsCluster : public ViewFactorsAlgorithm {
 
@@ -31,12 +31,11 @@ class ViewFactorsCluster : public ViewFactorsAlgorithm {
 		double GetViewfactor(const int i, const int j, const int a, const int b);
 
 	private:
-		mio::Array4D<double> vf_cluster;
-		mio::Array4D<unsigned int> vc_cluster;
 		mio::Array2D<double> sky_vf;
-		std::map<int, double> vf;
+		VFSparseMatrix vf;
 
 		mio::DEMObject dem;
+		std::string cache_dir;
 		double cellsize;
 		double sw_radius;
 		double max_shade_distance;
@@ -46,8 +45,7 @@ class ViewFactorsCluster : public ViewFactorsAlgorithm {
 		unsigned int hSections, vSections;
 		unsigned int schrittweitenLimit;
 
-		void fill_vf_map();
-		void calcHorizonField();
+		std::string getSignature() const;
 		void calcSchrittweite(const double& altitude, const double& dH, const double& distance,
 		                      const double& horizon_tan_angle, unsigned int& schrittweite) const;
 		double getHorizonForRay(const unsigned int& ix1, const unsigned int& iy1, const double& alpha,
@@ -62,7 +60,8 @@ class ViewFactorsCluster : public ViewFactorsAlgorithm {
 		                               const double by, const double bz);
 
 		void calcVF_cluster();
-		bool VF_calc(const unsigned int ix1, const unsigned int iy1, const int ix2, const int iy2, mio::Array1D<double> &tan_h);
+		bool VF_calc(const unsigned int ix1, const unsigned int iy1, const int ix2, const int iy2, mio::Array1D<double> &tan_h,
+		             mio::Array2D<double> &vf_cell, mio::Array2D<long long> &vc_cell);
 };
 
 #endif
@@ -17,26 +17,66 @@
 */
 #include <alpine3d/ebalance/ViewFactorsSectors.h>
 
-ViewFactorsSectors::ViewFactorsSectors(const mio::Config& cfg, const mio::DEMObject &dem_in) : dem(dem_in)
+#include <algorithm>
+#include <sys/stat.h>
+
+ViewFactorsSectors::ViewFactorsSectors(const mio::Config& cfg, const mio::DEMObject &dem_in) : vf(), viewCells(), sky_vf(), dem(dem_in), cache_dir()
 {
-        cellsize = dem.cellsize;
-        dimx = dem.getNx();
-        dimy = dem.getNy();
+	cellsize = dem.cellsize;
+	dimx = dem.getNx();
+	dimy = dem.getNy();
+
+	sky_vf.resize(dimx, dimy, 1);
+
+	cfg.getValue("sw_radius", "EBalance", sw_radius);
+	cfg.getValue("VF_CACHE", "EBalance", cache_dir, mio::IOUtils::nothrow);
+	if (!cache_dir.empty()) {
+		struct stat buffer;
+		if (stat(cache_dir.c_str(), &buffer) != 0 || !S_ISDIR(buffer.st_mode))
+			throw mio::AccessException("The VF_CACHE directory '"+cache_dir+"' does not exist", AT);
+	}
 
-        sky_vf.resize(dimx, dimy, 1);
+	hSections = 60;
+	vSections = 30;
 
-        cfg.getValue("sw_radius", "EBalance", sw_radius);
+	schrittweitenLimit = 1;
+	//max_shade_distance = (dem.grid2D.getMax() - dem.grid2D.getMin()) / tan(5.*M_PI/180.);
 
-        hSections = 60;
-        vSections = 30;
+	max_shade_distance = std::numeric_limits<double>::max();
 
-        schrittweitenLimit = 1;
-        //max_shade_distance = (dem.grid2D.getMax() - dem.grid2D.getMin()) / tan(5.*M_PI/180.);
+	const std::string signature( getSignature() );
+	if (!cache_dir.empty() && vf.readCache(cache_dir, "sectors", signature)) {
+		std::cout << "[i] sector view factors read from " << cache_dir << "\n";
+	} else {
+		calcHorizonField();
+		fill_vf_map();
+		if (!cache_dir.empty()) {
+			try {
+				vf.writeCache(cache_dir, "sectors", signature);
+			} catch (const std::exception& e) { //the cache is only an optimization, the simulation can go on
+				std::cout << "[W] could not write the sector view factors: " << e.what() << "\n";
+			}
+		}
+	}
 
-        max_shade_distance = std::numeric_limits<double>::max();
+	for (int i=0; i<dimx; i++) {
+		for (int j=0; j<dimy; j++)
+			sky_vf(i,j) = 1. - vf.getRowSum( static_cast<size_t>(j) + static_cast<size_t>(i)*static_cast<size_t>(dimy) );
+	}
+}
 
-        calcHorizonField();
-        fill_vf_map();
+/**
+ * @brief Signature of the DEM and of all the parameters the sector view factors depend on, for the view factors cache
+ */
+std::string ViewFactorsSectors::getSignature() const
+{
+	std::vector<double> params;
+	params.push_back( static_cast<double>(hSections) );
+	params.push_back( static_cast<double>(vSections) );
+	params.push_back( static_cast<double>(schrittweitenLimit) );
+	params.push_back( sw_radius );
+	params.push_back( max_shade_distance );
+	return VFSparseMatrix::getSignature(dem, params);
 }
 
 double ViewFactorsSectors::getSkyViewFactor(const int &i, const int &j)
@@ -58,18 +98,22 @@ void ViewFactorsSectors::calcHorizonField()
 
 	viewCells.resize(dem.getNx(),dem.getNy(),hSections,vSections);
 
-	for (unsigned int iy1=0; iy1<dem.getNy(); iy1++) {
-		for (unsigned int ix1=0; ix1<dem.getNx(); ix1++) {
-
-			double cell_alt = dem.grid2D(ix1, iy1);
-			if (cell_alt==mio::IOUtils::nodata) continue;
-
-			for (int z=0; z<hSections;z++) {
-				std::vector<unsigned int> viewCellsTemp(vSections);
-				getHorizonForRay(ix1,iy1, (z+0.5)*alpha_factor, viewCellsTemp);
-				for (int i=0;i<vSections; i++) {
-					viewCells(ix1,iy1,z,i) = viewCellsTemp[i];
-				}
+	//each cell only writes its own view cells, so the cells can be processed in parallel
+	const size_t ncells = dem.getNx()*dem.getNy();
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (size_t ii=0; ii<ncells; ii++) {
+		const unsigned int ix1 = static_cast<unsigned int>(ii % dem.getNx());
+		const unsigned int iy1 = static_cast<unsigned int>(ii / dem.getNx());
+
+		const double cell_alt = dem.grid2D(ix1, iy1);
+		if (cell_alt==mio::IOUtils::nodata) continue;
+
+		std::vector<unsigned int> viewCellsTemp(vSections);
+		for (int z=0; z<hSections;z++) {
+			std::fill(viewCellsTemp.begin(), viewCellsTemp.end(), 0);
+			getHorizonForRay(ix1,iy1, (z+0.5)*alpha_factor, viewCellsTemp);
+			for (int i=0;i<vSections; i++) {
+				viewCells(ix1,iy1,z,i) = viewCellsTemp[i];
 			}
 		}
 	}
@@ -92,7 +136,7 @@ void ViewFactorsSectors::calcSchrittweite(const double& altitude, const double&
 
 
 double ViewFactorsSectors::getHorizonForRay(const unsigned int& ix1, const unsigned int& iy1, const double& alpha,
-                                            std::vector<unsigned int>& i_viewCells)
+                                            std::vector<unsigned int>& i_viewCells) const
 {
 	bool horizon_found = false;
 	int nb_cells = 1;
@@ -165,12 +209,25 @@ double ViewFactorsSectors::getHorizonForRay(const unsigned int& ix1, const unsig
 	return horizon_tan_angle;
 }
 
+/**
+ * @brief Compute the view factors from the view cells
+ * @details The shooting cells are processed in parallel, each thread collecting its own list of view factors
+ * that are then all merged into the sparse view factors matrix.
+ */
 void ViewFactorsSectors::fill_vf_map()
 {
 	const double sw_radius2 = sw_radius * sw_radius;
-	for ( int i_shoot = 0; i_shoot < dimx; i_shoot++ ) {
-		std::cout << i_shoot * 100 / dimx << "%" << std::endl;
-		for ( int j_shoot = 0; j_shoot < dimy; j_shoot++ ) {
+	const size_t ncells = static_cast<size_t>(dimx) * static_cast<size_t>(dimy);
+	std::vector< std::vector<VFSparseMatrix::Triplet> > triplets;
+
+	#pragma omp parallel
+	{
+		std::vector<VFSparseMatrix::Triplet> thread_triplets;
+
+		#pragma omp for schedule(dynamic, 16)
+		for (size_t shootID=0; shootID<ncells; shootID++) {
+			const int i_shoot = static_cast<int>(shootID / dimy);
+			const int j_shoot = static_cast<int>(shootID % dimy);
 
 			const double z_shoot=dem.grid2D(i_shoot,j_shoot);
 			for ( int v = 0; v < vSections; v++ ) {
@@ -182,50 +239,47 @@ void ViewFactorsSectors::fill_vf_map()
 					const unsigned int cell = viewCells(i_shoot, j_shoot, h, v);
 					if (cell == 0) continue;
 
-					const unsigned int i = cell % dimx;
-					const unsigned int j = (int) (cell/dimx);
+					const int i = static_cast<int>(cell % dimx);
+					const int j = static_cast<int>(cell / dimx);
 
 					const double bx = (i_shoot - i) * cellsize;	// bx = dx (m) going from (i_shoot,j_shoot) to (i,j)
 					const double by = (j_shoot - j) * cellsize;	// by = dy (m) going from (i_shoot,j_shoot) to (i,j)
 					const double bz = z_shoot - dem.grid2D(i,j);	// bz = dz (m) going from (i_shoot,j_shoot) to (i,j)
 
 					// distance between the surfaces
-					const double dist = sqrt( (bx * bx) + (by * by) + (bz * bz) );
 					const double dist2 = (bx * bx) + (by * by) + (bz * bz);
-
 					if (!( dist2 <= sw_radius2 && dist2>0.)) continue;
+					const double dist = sqrt( dist2 );
 
 					const double viewFactor = getPrecViewFactor(cos(theta_min), cos(theta_max), dist);
-
-					const unsigned int shootID = j_shoot+i_shoot*dimy;
-					const unsigned int ID = j+i*dimy + shootID*dimx*dimy;
-
-					sky_vf(i_shoot, j_shoot) -= viewFactor;
-
-					if (vf.find(ID) == vf.end())
-						vf.insert(std::pair<int,double>(ID, viewFactor));
-					else
-						vf.at(ID) += viewFactor;
-
-
+					if (viewFactor == 0.) continue;
+					const size_t ID = static_cast<size_t>(j) + static_cast<size_t>(i)*static_cast<size_t>(dimy);
+					thread_triplets.push_back( VFSparseMatrix::Triplet(shootID, ID, viewFactor) );
 				}
 			}
 		}
+
+		#pragma omp critical(vf_sectors_merge)
+		{
+			triplets.push_back( std::vector<VFSparseMatrix::Triplet>() );
+			triplets.back().swap( thread_triplets );
+		}
 	}
+
+	vf.build(ncells, triplets);
 }
 
 double ViewFactorsSectors::GetViewfactor(const int i, const int j, const int a, const int b)
 {
-	const unsigned int shootID = j+i*dimy;
-	const unsigned int ID = b+a*dimy + shootID*dimx*dimy;
-
-	if (vf.find(ID) == vf.end())
-		return 0.;
-	return vf.at(ID);
+	const size_t shootID = static_cast<size_t>(j) + static_cast<size_t>(i)*static_cast<size_t>(dimy);
+	const size_t ID = static_cast<size_t>(b) + static_cast<size_t>(a)*static_cast<size_t>(dimy);
+	return vf(shootID, ID);
 }
 
 int ViewFactorsSectors::getViewCells(const int i, const int j, const int h, const int v)
 {
+	if (viewCells.getNx() == 0)
+		throw mio::InvalidArgumentException("The view cells are not available when the sector view factors have been read from the cache", AT);
 	return viewCells(i,j,h,v);
 }
 
@@ -233,7 +287,7 @@ int ViewFactorsSectors::getViewCells(const int i, const int j, const int h, cons
 /**
         Opimizted viewfactor calculation
 */
-double ViewFactorsSectors::getPrecViewFactor(const double &cos_theta_min, const double &/*cos_theta_max*/, const double &radius)
+double ViewFactorsSectors::getPrecViewFactor(const double &cos_theta_min, const double &/*cos_theta_max*/, const double &radius) const
 {
 
 	double viewFactor=0;
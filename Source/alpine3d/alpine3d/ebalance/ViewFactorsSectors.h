@@ -20,7 +20,7 @@
 
 #include <meteoio/MeteoIO.h>
 #include <alpine3d/ebalance/ViewFactorsAlgorithm.h>
-#include <map>
+#include <alpine3d/ebalance/VFSparseMatrix.h>
 
 class ViewFactorsSectors : public ViewFactorsAlgorithm {
 	public:
@@ -31,10 +31,11 @@ class ViewFactorsSectors : public ViewFactorsAlgorithm {
 		int getViewCells(const int i, const int j, const int h, const int v);
 
 	private:
-		std::map<int, double> vf;
-		mio::Array4D<unsigned int> viewCells;
+		VFSparseMatrix vf;
+		mio::Array4D<unsigned int> viewCells; ///< only available when the view factors have not been read from the cache
 		mio::Array2D<double> sky_vf;
 		mio::DEMObject dem;
+		std::string cache_dir;
 
 		double cellsize;
 		double max_shade_distance;
@@ -44,13 +45,14 @@ class ViewFactorsSectors : public ViewFactorsAlgorithm {
 		int hSections, vSections;
 		unsigned int schrittweitenLimit;
 
+		std::string getSignature() const;
 		void fill_vf_map();
 		void calcHorizonField();
 		void calcSchrittweite(const double& altitude, const double& dH, const double& distance,
 		                      const double& horizon_tan_angle, unsigned int& schrittweite) const;
 		double getHorizonForRay(const unsigned int& ix1, const unsigned int& iy1, const double& alpha,
-		                        std::vector<unsigned int>& viewCells);
-		double getPrecViewFactor(const double& cos_theta_min, const double& cos_theta_max, const double& radius);
+		                        std::vector<unsigned int>& viewCells) const;
+		double getPrecViewFactor(const double& cos_theta_min, const double& cos_theta_max, const double& radius) const;
 };
 
 #endif
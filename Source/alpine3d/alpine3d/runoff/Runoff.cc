@@ -312,7 +312,7 @@ void Runoff::updateGlacierMask() {
  */
 mio::Grid2DObject Runoff::computePrecipRunoff(const mio::Grid2DObject& psum, const mio::Grid2DObject& ta) const
 {
-	const mio::Grid2DObject surfRunoff( snowpack->getGrid(SnGrids::MS_SNOWPACK_RUNOFF) );
+	const mio::Grid2DObject& surfRunoff( snowpack->getGridView(SnGrids::MS_SNOWPACK_RUNOFF) );
 	if ( (psum.getNx()            != slope_correction.getNx()) ||
 	     (ta.getNx()              != slope_correction.getNx()) ||
 	     (surfRunoff.getNx()      != slope_correction.getNx()) ||
@@ -347,10 +347,11 @@ mio::Grid2DObject Runoff::computePrecipRunoff(const mio::Grid2DObject& psum, con
 void Runoff::getExtraMeteoGrids(std::vector<mio::Grid2DObject>& grids) const {
 	grids.clear();
 	grids.reserve(n_extra_meteo_variables);
+	snowpack->gatherGrids(extra_meteo_variables); //all the variables in one exchange
 
 	for(size_t iVar(0); iVar < n_extra_meteo_variables; ++iVar) {
 		const SnGrids::Parameters& currParam(extra_meteo_variables.at(iVar));
-		const mio::Grid2DObject tmp( snowpack->getGrid(currParam) );
+		const mio::Grid2DObject& tmp( snowpack->getGridView(currParam) );
 
 		if(tmp.grid2D.getCount() == 0)
 			throw mio::InvalidArgumentException("Cannot average parameter " +
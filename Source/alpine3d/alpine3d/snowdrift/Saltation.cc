@@ -50,26 +50,25 @@ using namespace std;
  */
 void SnowDriftA3D::compSaltation(bool setbound)
 {
+	const double sigma=300.;
+	bool saltation_ok = true;
 
-	unsigned int ix,iy;
-	double tauS, tau_th, Ubar2;
-	double weight, binding, sigma=300.;
-	double dg;
-	double flux_mean, cs_mean;  /* What we finally want */
-
-	const mio::Grid2DObject store( snowpack->getGrid(SnGrids::STORE) );
-	const mio::Grid2DObject swe( snowpack->getGrid(SnGrids::SWE) );
+	const SnGrids::Parameters params[2] = {SnGrids::STORE, SnGrids::SWE};
+	snowpack->gatherGrids( std::vector<SnGrids::Parameters>(params, params+2) ); //both grids in one exchange
+	const mio::Grid2DObject& store( snowpack->getGridView(SnGrids::STORE) );
+	const mio::Grid2DObject& swe( snowpack->getGridView(SnGrids::SWE) );
 
 	/* Calculate the Fluxes for all Bottom Elements */
-	for (iy=1; iy<ny-1; iy++) {
-		for (ix=1; ix<nx-1; ix++){
+	//each pixel is independent, the DOORSCHOT model being expensive the rows are dynamically distributed
+	#pragma omp parallel for schedule(dynamic)
+	for (unsigned int iy=1; iy<ny-1; iy++) {
+		for (unsigned int ix=1; ix<nx-1; ix++){
 			if (cH.grid2D(ix,iy)==mio::IOUtils::nodata) {
 				saltation(ix,iy) = 0.0; c_salt(ix,iy) = 0.0;
 				continue;
 			}
 			//Michi: Please CHECK these two lines!
-			flux_mean=0;
-			cs_mean=0;
+			double flux_mean=0, cs_mean=0;  /* What we finally want */
 			
 			if ( cH.grid2D(ix, iy) <= 0.05 || (store(ix,iy)+swe(ix,iy))<5.) { 
 				saltation(ix,iy) = 0.0; c_salt(ix,iy) = 0.0;
@@ -78,7 +77,7 @@ void SnowDriftA3D::compSaltation(bool setbound)
 
 			/* Determine shear stress from the wind */
 			/*      tauS = DENSITY_AIR*DSQR(nodes[n].Km / nodes[n].lm); */ /* First try - Nice try */
-			
+			double tauS;
 			if (TKE) {
 				/* From TKE using similarity */
 				/* Attention FUDGE */
@@ -86,16 +85,17 @@ void SnowDriftA3D::compSaltation(bool setbound)
 
 			} else {
 				/* From wind speed using log-profile */
-			    Ubar2 = mio::Optim::pow2(nodes_u.grid3D(ix,iy,2)) + mio::Optim::pow2(nodes_v.grid3D(ix,iy,2)) + mio::Optim::pow2(nodes_w.grid3D(ix,iy,2));
+			    const double Ubar2 = mio::Optim::pow2(nodes_u.grid3D(ix,iy,2)) + mio::Optim::pow2(nodes_v.grid3D(ix,iy,2)) + mio::Optim::pow2(nodes_w.grid3D(ix,iy,2));
 			    tauS =  Constants::density_air*Ubar2*mio::Optim::pow2(Saltation::karman/log((nodes_z.grid3D(ix,iy,2) - nodes_z.grid3D(ix,iy,1))/Saltation::z0_salt));
 			    if (tauS == 0.) {
 				printf("\n tauS zero: ix:%d, iy:%d, u:%f, v:%f"
 					,ix,iy,nodes_u.grid3D(ix,iy,2),nodes_v.grid3D(ix,iy,2));
 			    }
 			}
+			double tau_th, dg;
 			if (thresh_snow) {
-				weight = 0.02*Constants::density_ice*(sp.grid2D(ix, iy) + 1.)*mio::Cst::gravity*MM_TO_M(rg.grid2D(ix, iy));
-				binding = 0.0015*sigma*N3.grid2D(ix, iy)*rb.grid2D(ix, iy)*rb.grid2D(ix, iy)/rg.grid2D(ix, iy)/rg.grid2D(ix, iy);
+				const double weight = 0.02*Constants::density_ice*(sp.grid2D(ix, iy) + 1.)*mio::Cst::gravity*MM_TO_M(rg.grid2D(ix, iy));
+				const double binding = 0.0015*sigma*N3.grid2D(ix, iy)*rb.grid2D(ix, iy)*rb.grid2D(ix, iy)/rg.grid2D(ix, iy)/rg.grid2D(ix, iy);
 				tau_th = std::max(tau_thresh, SnowDrift::schmidt_drift_fudge*(weight + binding));
 				dg = std::min(grain_size,std::max(0.3*grain_size,2.*rg.grid2D(ix, iy)));
 			} else {
@@ -105,22 +105,26 @@ void SnowDriftA3D::compSaltation(bool setbound)
 
 			/* Calculate Flux and Lower Concentration Boundary Condition*/
 			if (!saltation_obj.compSaltation(tauS, tau_th, nodes_slope.grid3D(ix,iy,1)*(180./Constants::pi), dg, flux_mean, cs_mean)) {
-				cout<<" Could not calculate Saltation"<<endl;
-			    return;
+				saltation_ok = false; //we can not leave an OpenMP loop, the error is reported below
+				continue;
 			}
 			saltation(ix,iy) = flux_mean; c_salt(ix,iy) = c_red*cs_mean;
 		} /* for ix */
 	}
+	if (!saltation_ok) {
+		cout<<" Could not calculate Saltation"<<endl;
+		return;
+	}
 
 	/* First set Zero Gradient Boundary Condition */
 	if (setbound) {
-		for (iy=0; iy<ny; iy++) {
+		for (unsigned int iy=0; iy<ny; iy++) {
 			saltation(0,iy) =  saltation(1,iy); saltation(nx-1,iy) = saltation(nx-2,iy);
 			c_salt(0,iy) = c_salt(1,iy); c_salt(nx-1,iy) = c_salt(nx-2,iy);
 		}
 
 		//Michi: the old stuffs do not set the boundary correctly!
-		for (ix=0; ix<nx; ix++) {
+		for (unsigned int ix=0; ix<nx; ix++) {
 			saltation(ix,0) =  saltation(ix,1); saltation(ix,ny-1) = saltation(ix,ny-2);
 			c_salt(ix,0) = c_salt(ix,1); c_salt(ix,ny-1) = c_salt(ix,ny-2);
 		}
@@ -24,6 +24,8 @@
 
 #include <assert.h>
 #include <vector>
+#include <sstream>
+#include <iomanip>
 
 #include <alpine3d/snowdrift/SnowDrift.h>
 #include <alpine3d/AlpineMain.h>
@@ -48,12 +50,13 @@ const bool SnowDriftA3D::thresh_snow = true;//Flag to determine whether ustar_th
 
 
 SnowDriftA3D::SnowDriftA3D(const DEMObject& dem, const mio::Config& cfg) 
-                        : saltation_obj(cfg), auxLayerHeight(0.02), io(cfg), snowpack(NULL), eb(NULL), 
+                        : saltation_obj(cfg), auxLayerHeight(0.02), io(cfg), wind_library(cfg, dem), snowpack(NULL), eb(NULL), 
                         cH(dem, IOUtils::nodata), sp(dem, IOUtils::nodata), rg(dem, IOUtils::nodata), N3(dem, IOUtils::nodata), rb(dem, IOUtils::nodata),
                         nx(0), ny(0), nz(0), vw(dem, IOUtils::nodata), rh(dem, IOUtils::nodata), ta(dem, IOUtils::nodata), p(dem, IOUtils::nodata), 
-                        psum(dem, IOUtils::nodata), psum_ph(dem, IOUtils::nodata), STATIONARY(true)
+                        psum(dem, IOUtils::nodata), psum_ph(dem, IOUtils::nodata), STATIONARY(true), print_checksums(false)
 {
 	const string wind_field_string = cfg.get("WINDFIELDS", "Input");
+	cfg.getValue("DRIFT_CHECKSUMS", "Alpine3D", print_checksums, IOUtils::nothrow);
 
 	vector<string> TA_interpol;
 	cfg.getValues("TA::algorithms", "Interpolations2D", TA_interpol);
@@ -179,9 +182,12 @@ void SnowDriftA3D::CompleteNodes()
 		cout << "[i] Snowdrift: updating the mesh..."<<endl;
 
 		// the second arps layer (topography) becomes the bottom (ie boundary)
-		// layer of the suspension grid, calculate the slope first
-		for (size_t ii=0; ii<nx; ii++){
-			for (size_t jj=0; jj<ny; jj++){
+		// layer of the suspension grid, calculate the slope first. Then an additional
+		// suspension grid layer of nodes is added between the first and second arps layer.
+		// Each column only depends on itself, so both are done in one pass in memory order
+		#pragma omp parallel for
+		for (size_t jj=0; jj<ny; jj++){
+			for (size_t ii=0; ii<nx; ii++){
 				nodes_slope(ii,jj,0) = (nodes_v(ii,jj,1)*atan(-nodes_sy(ii,jj,1)) + nodes_u(ii,jj,1)*atan(-nodes_sx(ii,jj,1)))
 				/sqrt(Optim::pow2(nodes_v(ii,jj,1)) + Optim::pow2(nodes_u(ii,jj,1)));
 				nodes_slope(ii,jj,1) = nodes_slope(ii,jj,0);
@@ -190,19 +196,11 @@ void SnowDriftA3D::CompleteNodes()
 				nodes_w(ii,jj,0) = 0.;
 				nodes_wstar(ii,jj,0) = nodes_wstar(ii,jj,1);
 				nodes_e(ii,jj,0) = nodes_e(ii,jj,1);
-			}
-		}
-
-		//an additional suspension grid layer of nodes is added between the
-		//first and second arps layer
 
-		//the new layer is located between the first and second
-		//arps layer, adjusted by the factor auxLayerHeight. The x,y
-		//coordinates remain the same as long as the mesh remains
-		//regular in these directions
-
-		for (size_t ii=0; ii<nx; ii++){
-			for (size_t jj=0; jj<ny; jj++){
+				//the new layer is located between the first and second
+				//arps layer, adjusted by the factor auxLayerHeight. The x,y
+				//coordinates remain the same as long as the mesh remains
+				//regular in these directions
 				const double salt_height = nodes_z(ii,jj,1) - nodes_z(ii,jj,0);
 
 				//the direction of the wind field of a node in the new layer is
@@ -253,6 +251,7 @@ void SnowDriftA3D::InitializeNodes(const mio::Grid3DObject& z_readMatr)
 		nodes_Subl_ini.set(z_readMatr, 0.);
 	}
 	
+	#pragma omp parallel for
 	for (unsigned int kk=0; kk<nz; kk++){
 		for (unsigned int jj=0;jj<ny;jj++){
 			for (unsigned int ii=0;ii<nx;ii++){
@@ -279,34 +278,32 @@ void SnowDriftA3D::InitializeNodes(const mio::Grid3DObject& z_readMatr)
 	cout <<"[i] Snowdrift adding artificial layer..."<<endl;
 
 	// the second arps layer (topography) becomes the bottom (ie boundary)
-	// layer of the suspension grid
-	for (unsigned int ii=0;ii<nx;ii++){
-		for (unsigned int jj=0;jj<ny;jj++){
+	// layer of the suspension grid and an additional suspension grid layer of nodes
+	// is added between the first and second arps layer (one pass per column, in memory order)
+	size_t nr_invalid = 0; //the threads do not print, the invalid heights are only reported after the loop
+	#pragma omp parallel for reduction(+: nr_invalid)
+	for (unsigned int jj=0;jj<ny;jj++){
+		for (unsigned int ii=0;ii<nx;ii++){
 			nodes_z(ii,jj,0) = z_readMatr(ii,jj,1);
 			nodes_x(ii,jj,0) = nodes_x(ii,jj,1);
 			nodes_y(ii,jj,0) = nodes_y(ii,jj,1);
 			nodes_sx(ii,jj,0) = nodes_sx(ii,jj,1);
 			nodes_sy(ii,jj,0) = nodes_sy(ii,jj,1);
+
+			//the new layer is located between the first and second
+			//arps layer, adjusted by the factor auxLayerHeight. The x,y
+			//coordinates remain the same as long as the mesh remains
+			//regular in these directions
+			const double salt_height = auxLayerHeight*(nodes_z(ii,jj,2) - nodes_z(ii,jj,0));
+			if (salt_height<0.) nr_invalid++;
+			nodes_z(ii,jj,1) = nodes_z(ii,jj,0)+salt_height;
+			nodes_x(ii,jj,1) = nodes_x(ii,jj,2);
+			nodes_y(ii,jj,1) = nodes_y(ii,jj,2);
+			nodes_sx(ii,jj,1) = nodes_sx(ii,jj,2);
+			nodes_sy(ii,jj,1) = nodes_sy(ii,jj,2);
 		}
 	}
-	//an additional suspension grid layer of nodes is added between the
-	//first and second arps layer
-	//the new layer is located between the first and second
-	//arps layer, adjusted by the factor auxLayerHeight. The x,y
-	//coordinates remain the same as long as the mesh remains
-	//regular in these directions
-
-	for (unsigned int ii=0;ii<nx;ii++){
-	    for (unsigned int jj=0;jj<ny;jj++){
-		const double salt_height = auxLayerHeight*(nodes_z(ii,jj,2) - nodes_z(ii,jj,0));
-		if (salt_height<0.) std::cout << "[E] Invalid height ARPS data at (" << ii << "," << jj << ") = " << salt_height << "\n";
-		nodes_z(ii,jj,1) = nodes_z(ii,jj,0)+salt_height;
-		nodes_x(ii,jj,1) = nodes_x(ii,jj,2);
-		nodes_y(ii,jj,1) = nodes_y(ii,jj,2);
-		nodes_sx(ii,jj,1) = nodes_sx(ii,jj,2);
-		nodes_sy(ii,jj,1) = nodes_sy(ii,jj,2);
-	    }
-	}
+	if (nr_invalid>0) std::cout << "[E] Invalid height ARPS data (the second layer is below the first one) at " << nr_invalid << " point(s)\n";
 }
 
 void SnowDriftA3D::ConstructElements()
@@ -654,6 +651,7 @@ void SnowDriftA3D::SnowMassChange(bool setbound, const mio::Date& calcDate)
  */
 void SnowDriftA3D::Compute(const Date& calcDate)
 {
+	MIO_TRACE_ZONE("Alpine3D", "SnowDrift");
 	timer.restart();
 	
 	const double max_hs = cH.grid2D.getMax();
@@ -687,12 +685,17 @@ void SnowDriftA3D::Compute(const Date& calcDate)
 	SnowMassChange(true, calcDate);
 
 	std::cout << "[i] SnowDrift simulation done for " << calcDate.toString(Date::ISO) << "\n";
+	if (print_checksums) { //these checksums are compared against a reference by the drift regression test
+		std::ostringstream ss;
+		ss << std::scientific << std::setprecision(10);
+		ss << "[i] SnowDrift checksums: c=" << checksum_c(nodes_c) << " saltation=" << checksum(saltation) << " c_salt=" << checksum(c_salt) << " mns=" << checksum(mns.grid2D) << "\n";
+		std::cout << ss.str();
+	}
 
 	if (snowpack!=NULL) {
 		snowpack->setSnowMassChange(mns, calcDate);
 	}
 
-	//DEBUG("Checksum SnowDrift: nodes=%lf, saltation=%lf, c_salt=%lf", checksum_c(nodes_c), checksum(saltation), checksum(c_salt));
 	timer.stop();
 
 }  /* End SnowDrift */
@@ -812,11 +815,8 @@ void SnowDriftA3D::setMeteo (const unsigned int& steps, const Grid2DObject& new_
 	if (new_wind_status) {
 		wind_field_index++;
 		const std::string filename( wind_fields[wind_field_index].wind );
-		io.read3DGrid(nodes_u, filename+":u");
-		io.read3DGrid(nodes_v, filename+":v");
-		io.read3DGrid(nodes_w, filename+":w");
-		if (READK) io.read3DGrid(nodes_K, filename+":kmh");
-		cout <<"[i] Snowdrift: ARPS wind field successfully read"<<endl;
+		wind_library.read(io, filename, (READK!=0), nodes_u, nodes_v, nodes_w, nodes_K);
+		cout <<"[i] Snowdrift: wind field " << filename << " set"<<endl;
 	}
 
 	mio::Grid2DObject dw(vw, IOUtils::nodata);	// dw field with vw as template for dimensions
@@ -843,8 +843,9 @@ void SnowDriftA3D::setMeteo (const unsigned int& steps, const Grid2DObject& new_
 void SnowDriftA3D::initializeTRH()
 {
 	//start with first level
-	for (unsigned int ix=0; ix<nx; ix++){
-		for (unsigned int iy=0; iy<ny; iy++){
+	#pragma omp parallel for
+	for (unsigned int iy=0; iy<ny; iy++){
+		for (unsigned int ix=0; ix<nx; ix++){
 			nodes_RH.grid3D(ix,iy,0) = rh.grid2D(ix,iy); //constant field, single measurement at Wan3
 			nodes_Tair.grid3D(ix,iy,0) = ta_1D;
 			nodes_q.grid3D(ix,iy,0) = Atmosphere::relToSpecHumidity(nodes_z.grid3D(ix,iy,0), nodes_Tair.grid3D(ix,iy,0),nodes_RH.grid3D(ix,iy,0));
@@ -853,8 +854,9 @@ void SnowDriftA3D::initializeTRH()
 		}
 	}
 
-	//adjust rest of domain
+	//adjust rest of domain, each level depends on the one below
 	for (unsigned int iz=1; iz<nz; iz++){
+		#pragma omp parallel for
 		for (unsigned int iy=0; iy<ny; iy++){
 			for (unsigned int ix=0;ix<nx; ix++){
 			nodes_q.grid3D(ix,iy,iz)=nodes_q.grid3D(ix,iy,iz-1);
@@ -45,6 +45,7 @@ typedef mio::Array1D<int> CIntArray;
 #include <alpine3d/SnowpackInterface.h>
 #include <alpine3d/ebalance/EnergyBalance.h>
 #include <alpine3d/snowdrift/checksum.h>
+#include <alpine3d/snowdrift/WindFieldLibrary.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -74,6 +75,16 @@ struct WIND_FIELD {unsigned int start_step;std::string wind;};
  * WINDFIELDS = sw3.asc 1 nw3.asc 3 ww0.asc 2 nw9.asc 5 nw6.asc 10 ww0.asc 5 sw3.asc 6 nw3.asc 1
  * @endcode
  *
+ * Each distinct wind field is only parsed once: the most recently used wind situations are kept in memory (see
+ * WindFieldLibrary). It is also possible to keep a binary copy of the wind fields in a cache directory, so later runs
+ * do not have to parse the ARPS files again:
+ * @code
+ * WINDFIELDS_CACHE    = ../input/wind_fields/cache
+ * WINDFIELDS_RESIDENT = 3
+ * @endcode
+ *
+ * For testing purposes, the checksums of the drift fields can be printed at each time step by setting DRIFT_CHECKSUMS to true in the
+ * [Alpine3D] section (default: false).
  */
 class SnowDriftA3D {
 	public:
@@ -208,6 +219,7 @@ class SnowDriftA3D {
 		double station_altitude;
 
 		mio::IOManager io;
+		WindFieldLibrary wind_library;
 		SnowpackInterface *snowpack;
 		EnergyBalance *eb;
 		mio::Timer timer;
@@ -322,6 +334,7 @@ class SnowDriftA3D {
 		mio::Grid3DObject nodes_e, nodes_c;
 		mio::Grid3DObject nodes_Tair,nodes_Tair_ini, nodes_q, nodes_q_ini, nodes_RH, nodes_Subl, nodes_Subl_ini, nodes_WindVel, nodes_tmp_c;
 		bool STATIONARY;
+		bool print_checksums; ///< print the checksums of the drift fields at each step (for the regression tests)
 
 	protected:
 		void buildWindFieldsTable(const std::string& wind_field_string);
@@ -478,6 +478,7 @@ void SnowDriftA3D::values_nodes_to_elements(const Grid3DObject& nodesGrid, CDoub
 	const int nz_grid=nodesGrid.getNz();
 	const unsigned int Nelems=elementsArray.getNx();
 
+	#pragma omp parallel for
 	for (int i=0; i<(signed)Nelems; i++){
 		//find the nodes for this element
 		int iz = (int)floor(i/nxy);
@@ -510,68 +511,35 @@ void SnowDriftA3D::values_nodes_to_elements(const Grid3DObject& nodesGrid, CDoub
  */
 void SnowDriftA3D::values_elements_to_nodes(Grid3DObject& nodesGrid, const CDoubleArray& elementsArray )
 {
-    const int ncols=nodesGrid.getNx();
-    const int nrows=nodesGrid.getNy();
-    const int ndepths=nodesGrid.getNz();
-    int ixmin=0;
-    int ixmax=0;
-    int iymin=0;
-    int iymax=0;
-    int izmin=0;
-    int izmax=0;
-
-    for (int ii=0; ii<=ncols-1; ii++){
-	for (int jj=0; jj<=nrows-1; jj++){
-	    for (int kk=0; kk<=ndepths-1; kk++){
-
-		if (ii==0){
-		    ixmin=ii;
-		    ixmax=ii;
-		}else if (ii==ncols-1){
-		    ixmin=ii-1;
-		    ixmax=ii-1;
-		}else{
-		    ixmin=ii-1;
-		    ixmax=ii;
-		}
-
-		if (jj==0){
-		    iymin=jj;
-		    iymax=jj;
-		}else if (jj==nrows-1){
-			iymin=jj-1;
-			iymax=jj-1;//iymax=jj;
-		}else{
-		    iymin=jj-1;
-		    iymax=jj;
-		}
-
-		if (kk==0){
-		    izmin=kk;
-		    izmax=kk;
-		}else if (kk==ndepths-1){
-		    izmin=kk-1;
-		    izmax=kk-1;
-		}else{
-		    izmin=kk-1;
-		    izmax=kk;
-		}
-
-		double value = 0.;
-		int count = 0;
-		for ( int ix=ixmin; ix<=ixmax; ix++){
-		    for (int iy = iymin; iy<=iymax; iy++) {
-			for (int iz = izmin; iz<=izmax; iz++) {
-			    int element = iz*(ncols)*(nrows)+iy*(ncols)+ix;
-			    value += elementsArray(element);
-			    count+=1;
+	const int ncols=nodesGrid.getNx();
+	const int nrows=nodesGrid.getNy();
+	const int ndepths=nodesGrid.getNz();
+
+	//each node is the average of the (up to 8) elements around it, the nodes are filled in memory order
+	#pragma omp parallel for
+	for (int kk=0; kk<=ndepths-1; kk++){
+		const int izmin = (kk==0)? kk : kk-1;
+		const int izmax = (kk==0 || kk==ndepths-1)? izmin : kk;
+		for (int jj=0; jj<=nrows-1; jj++){
+			const int iymin = (jj==0)? jj : jj-1;
+			const int iymax = (jj==0 || jj==nrows-1)? iymin : jj;
+			for (int ii=0; ii<=ncols-1; ii++){
+				const int ixmin = (ii==0)? ii : ii-1;
+				const int ixmax = (ii==0 || ii==ncols-1)? ixmin : ii;
+
+				double value = 0.;
+				int count = 0;
+				for ( int ix=ixmin; ix<=ixmax; ix++){
+					for (int iy = iymin; iy<=iymax; iy++) {
+						for (int iz = izmin; iz<=izmax; iz++) {
+							const int element = iz*(ncols)*(nrows)+iy*(ncols)+ix;
+							value += elementsArray(element);
+							count+=1;
+						}
+					}
+				}
+				nodesGrid.grid3D(ii,jj,kk)=value/count;
 			}
-		    }
 		}
-		value=value/count;
-		nodesGrid.grid3D(ii,jj,kk)=value;
-	    }
 	}
-    }
-
 }
@@ -517,11 +517,14 @@ void SnowDriftA3D::matmult(CDoubleArray& y_loc,
 {
 	const size_t dim = rowPtr.getNx() - 1;
 
+	//the rows are independent and each of them is summed in the same order whatever the number of threads
+	#pragma omp parallel for
 	for (size_t i = 0; i < dim; i++) {
-		y_loc[i] = 0;
+		double sum = 0;
 		for (int j = rowPtr[i]; j < rowPtr[i+1] ; j++) {
-			y_loc[i] += sA_loc[ j ] * x_loc[ colInd[j] ];
+			sum += sA_loc[ j ] * x_loc[ colInd[j] ];
 		}
+		y_loc[i] = sum;
 	}
 }
 
@@ -668,6 +671,7 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 
       beta = rho_new / rho_old * alpha / omega;
 
+      #pragma omp parallel for
       for (size_t i=0;i<n;i++) {
 	 			p_loc[i] *= beta;
 	  		p_loc[i] += (r[i] - beta * omega *v[i] );
@@ -692,6 +696,7 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 			}
       alpha = rho_new / res4;
 
+      #pragma omp parallel for
       for ( size_t i = 0; i < n; i++ ) {
 	  		aux1[i] = r[i] - alpha * v[i];
 	  		//precond
@@ -709,6 +714,7 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 
       omega = res4 / res5;
 
+      #pragma omp parallel for
       for ( size_t i = 0; i < n; i++ ) {
 	  		result[i] += ( alpha * phat[i] + omega * auxhat[i] );
 	 			r[i] = aux1[i] - omega * aux2[i];
@@ -34,18 +34,21 @@ void SnowDriftA3D::Sublimation()
 {
 	nodes_Subl.grid3D = 0.;
 
-	for (unsigned int ix=0; ix<nx;ix++) {
-		for (unsigned int iy=0; iy<ny; iy++) {
-			for (unsigned int iz=1; iz<nz; iz++)	{ //start at second level since below > BC saturation
-				//calculate magnitude windspeed instead of u,v,w
-				const double WindVelocity = sqrt(mio::Optim::pow2(nodes_u.grid3D(ix,iy,iz))+mio::Optim::pow2(nodes_v.grid3D(ix,iy,iz))+mio::Optim::pow2(nodes_w.grid3D(ix,iy,iz)));
-				if ( nodes_c.grid3D(ix,iy,iz)>1e-9 && nodes_RH.grid3D(ix,iy,iz)<1.0){
-					const double repRadius = 6.25e-5; //representative radius for sublimation of a particle size distribution
-					const double dmdt_ini = calcSubldM(repRadius, nodes_Tair.grid3D(ix,iy,iz), nodes_RH.grid3D(ix,iy,iz), WindVelocity, nodes_z.grid3D(ix,iy,iz));
-					nodes_Subl.grid3D(ix,iy,iz) = calcS(nodes_c.grid3D(ix,iy,iz),repRadius,dmdt_ini);
-				}
-			}
-		}
+	const double repRadius = 6.25e-5; //representative radius for sublimation of a particle size distribution
+	const size_t nxny = static_cast<size_t>(nx)*static_cast<size_t>(ny);
+	const size_t count = nxny*static_cast<size_t>(nz);
+
+	//the nodes are independent, so they are processed in memory order (start at second level since below > BC saturation)
+	#pragma omp parallel for
+	for (size_t ii=nxny; ii<count; ii++) {
+		const double conc = nodes_c.grid3D(ii);
+		const double RH = nodes_RH.grid3D(ii);
+		if (!(conc>1e-9 && RH<1.0)) continue;
+
+		//calculate magnitude windspeed instead of u,v,w (only where there is something to sublimate)
+		const double WindVelocity = sqrt(mio::Optim::pow2(nodes_u.grid3D(ii))+mio::Optim::pow2(nodes_v.grid3D(ii))+mio::Optim::pow2(nodes_w.grid3D(ii)));
+		const double dmdt_ini = calcSubldM(repRadius, nodes_Tair.grid3D(ii), RH, WindVelocity, nodes_z.grid3D(ii));
+		nodes_Subl.grid3D(ii) = calcS(conc, repRadius, dmdt_ini);
 	}
 }
 
@@ -99,7 +102,7 @@ double SnowDriftA3D::calcSubldM(const double Radius,const double AirTemperature,
  */
 double SnowDriftA3D::calcS(const double concentration,const double sublradius, const double dmdt)
 {
-	const double subllossrate = (concentration / (4./3.*Constants::pi*pow(sublradius,3)*Constants::density_ice)) * dmdt;
+	const double subllossrate = (concentration / (4./3.*Constants::pi*Optim::pow3(sublradius)*Constants::density_ice)) * dmdt;
 	return subllossrate;
 }
 
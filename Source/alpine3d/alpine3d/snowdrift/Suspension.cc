@@ -241,7 +241,8 @@ void SnowDriftA3D::iterativeSublimationCalculation(int timeStep, int maxTimeStep
 			initializeSystem( colA, rowA,sA,sB,rhs,f,Psi,q,q00, HUM);
 			Grid3DObject tmpSource_q;
 			tmpSource_q.set(nx,ny,nz,ta.cellsize,ta.llcorner);
-			 for (size_t ii=0; ii<(nx*ny*nz); ii++) {
+			#pragma omp parallel for
+			for (size_t ii=0; ii<(nx*ny*nz); ii++) {
 				tmpSource_q(ii) = -1.*nodes_Subl_ini(ii) / (Atmosphere::waterVaporDensity(nodes_Tair(ii), Atmosphere::vaporSaturationPressure(nodes_Tair(ii)))+Atmosphere::stdDryAirDensity(nodes_z(ii), nodes_Tair(ii))*factorf);
 			}
 			values_nodes_to_elements(tmpSource_q,f);
@@ -250,6 +251,7 @@ void SnowDriftA3D::iterativeSublimationCalculation(int timeStep, int maxTimeStep
 
 			//recalculate relative humidity field
 			values_elements_to_nodes(nodes_q, q);
+			#pragma omp parallel for
 			for (size_t ii=0; ii<(nx*ny*nz); ii++) {
 				nodes_RH(ii) = RH_from_q(nodes_Tair(ii),nodes_q(ii), nodes_z(ii));
 				if (nodes_RH(ii)>=1.5){
@@ -284,6 +286,7 @@ void SnowDriftA3D::iterativeSublimationCalculation(int timeStep, int maxTimeStep
 			initializeSystem( colA, rowA,sA,sB,rhs,f,Psi,T,T00, TEM);
 			Grid3DObject tmpSink_T;
 			tmpSink_T.set(nx,ny,nz,ta.cellsize,ta.llcorner);
+			#pragma omp parallel for
 			for (size_t ii=0; ii<(nx*ny*nz); ii++) {
 				tmpSink_T(ii) = (nodes_Subl_ini(ii)*factorf) * Constants::lh_sublimation * 1/(Constants::specific_heat_air*(1+0.84*nodes_q(ii))*Atmosphere::stdDryAirDensity(nodes_z(ii), nodes_Tair(ii)));
 			}
@@ -296,6 +299,7 @@ void SnowDriftA3D::iterativeSublimationCalculation(int timeStep, int maxTimeStep
 			Grid3DObject tmp_potT;
 			tmp_potT.set(nx,ny,nz,ta.cellsize,ta.llcorner);
 			values_elements_to_nodes(tmp_potT,T);
+			#pragma omp parallel for
 			for (size_t ii=0; ii<(nx*ny*nz); ii++) {
 				nodes_Tair(ii) = tmp_potT(ii)-(Cst::gravity/Constants::specific_heat_air)*nodes_z(ii);
 				nodes_RH(ii) = RH_from_q(nodes_Tair(ii),nodes_q(ii), nodes_z(ii));
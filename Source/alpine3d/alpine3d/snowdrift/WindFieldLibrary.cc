@@ -0,0 +1,230 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <alpine3d/snowdrift/WindFieldLibrary.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace mio;
+using namespace std;
+
+const char WindFieldLibrary::magic[8] = {'A', '3', 'D', 'W', 'I', 'N', 'D', '2'};
+
+WindFieldLibrary::WindFieldLibrary(const mio::Config& cfg, const mio::DEMObject& dem)
+                 : resident(), cache_dir(), grid3d_path(), coordsys(), coordparam(), cellsize(dem.cellsize),
+                   dem_x(dem.llcorner.getEasting()), dem_y(dem.llcorner.getNorthing()),
+                   dem_nx(dem.getNx()), dem_ny(dem.getNy()), max_resident(3), nr_parsed(0)
+{
+	cfg.getValue("WINDFIELDS_CACHE", "Input", cache_dir, IOUtils::nothrow);
+	cfg.getValue("WINDFIELDS_RESIDENT", "Input", max_resident, IOUtils::nothrow);
+	cfg.getValue("GRID3DPATH", "Input", grid3d_path, IOUtils::nothrow);
+	cfg.getValue("COORDSYS", "Input", coordsys, IOUtils::nothrow);
+	cfg.getValue("COORDPARAM", "Input", coordparam, IOUtils::nothrow);
+
+	if (!cache_dir.empty() && !FileUtils::directoryExists(cache_dir))
+		throw AccessException("The WINDFIELDS_CACHE directory '"+cache_dir+"' does not exist", AT);
+}
+
+/**
+ * @brief Get the wind components of a wind situation
+ * @param io IOManager used to parse the wind field if it is neither in memory nor in the cache directory
+ * @param name name of the wind field (as given in the WINDFIELDS key)
+ * @param read_K should the eddy diffusivity also be read?
+ * @param u wind component along x
+ * @param v wind component along y
+ * @param w vertical wind component
+ * @param K eddy diffusivity (only set if read_K is true)
+ */
+void WindFieldLibrary::read(mio::IOManager& io, const std::string& name, const bool& read_K,
+                            mio::Grid3DObject& u, mio::Grid3DObject& v, mio::Grid3DObject& w, mio::Grid3DObject& K)
+{
+	std::list<WindSituation>::iterator it = resident.begin();
+	for (; it != resident.end(); ++it) {
+		if (it->name == name && (it->has_K || !read_K)) break;
+	}
+
+	if (it == resident.end()) {
+		WindSituation field;
+		load(io, name, read_K, field);
+		if (max_resident == 0) { //nothing is kept in memory, so we can hand the arrays over
+			std::swap(u, field.u);
+			std::swap(v, field.v);
+			std::swap(w, field.w);
+			if (read_K) std::swap(K, field.K);
+			return;
+		}
+		resident.push_front(field);
+		while (resident.size() > max_resident) resident.pop_back();
+		it = resident.begin();
+	} else {
+		resident.splice(resident.begin(), resident, it); //now the most recently used
+		it = resident.begin();
+	}
+
+	//the snowdrift module modifies the lowest layers of the wind field, so it gets its own copy
+	u = it->u;
+	v = it->v;
+	w = it->w;
+	if (read_K) K = it->K;
+}
+
+void WindFieldLibrary::load(mio::IOManager& io, const std::string& name, const bool& read_K, WindSituation& field)
+{
+	field.name = name;
+	field.has_K = read_K;
+	if (!cache_dir.empty() && readCache(name, read_K, field)) {
+		cout << "[i] Snowdrift: wind field " << name << " read from " << getCacheFilename(name) << "\n";
+		return;
+	}
+
+	io.read3DGrid(field.u, name+":u");
+	io.read3DGrid(field.v, name+":v");
+	io.read3DGrid(field.w, name+":w");
+	if (read_K) io.read3DGrid(field.K, name+":kmh");
+	nr_parsed++;
+
+	if (!cache_dir.empty()) {
+		toFloat(field.u);
+		toFloat(field.v);
+		toFloat(field.w);
+		if (read_K) toFloat(field.K);
+		try {
+			writeCache(name, field);
+		} catch (const std::exception& e) { //the cache is only an optimization, the simulation can go on
+			cout << "[W] Snowdrift: could not write the binary wind field for " << name << ": " << e.what() << "\n";
+		}
+	}
+}
+
+/**
+ * @brief Round all values of a grid to float32, so parsed and cached wind fields are exactly the same
+ */
+void WindFieldLibrary::toFloat(mio::Grid3DObject& grid)
+{
+	const size_t count = grid.getNx()*grid.getNy()*grid.getNz(); //getCount() would skip the nodata cells
+	for (size_t ii = 0; ii < count; ii++) {
+		grid.grid3D(ii) = static_cast<double>( static_cast<float>(grid.grid3D(ii)) );
+	}
+}
+
+std::string WindFieldLibrary::getCacheFilename(const std::string& name) const
+{
+	std::string cache_name( name );
+	std::replace(cache_name.begin(), cache_name.end(), '/', '_'); //wind fields might be in sub-directories of GRID3DPATH
+	return cache_dir + "/" + cache_name + ".a3dwind";
+}
+
+/**
+ * @brief Get the size and modification time of the original ARPS file
+ * @return false if the file could not be found
+ */
+bool WindFieldLibrary::getSourceStamp(const std::string& name, long long& size, long long& mtime) const
+{
+	return FileUtils::getFileStamp(grid3d_path + "/" + name, size, mtime);
+}
+
+/**
+ * @brief Read a wind situation from the cache directory
+ * @return false if there is no valid cache file for this wind situation
+ */
+bool WindFieldLibrary::readCache(const std::string& name, const bool& read_K, WindSituation& field) const
+{
+	long long src_size, src_mtime;
+	if (!getSourceStamp(name, src_size, src_mtime)) return false;
+
+	std::ifstream fin(getCacheFilename(name).c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	char file_magic[8];
+	long long header[6]; //nx, ny, nz, nr_params, source size, source modification time
+	double geometry[5]; //cellsize, xllcorner, yllcorner (as read from the ARPS file), DEM xllcorner, DEM yllcorner
+	fin.read(file_magic, sizeof(file_magic));
+	fin.read(reinterpret_cast<char*>(header), sizeof(header));
+	fin.read(reinterpret_cast<char*>(geometry), sizeof(geometry));
+	if (fin.fail() || memcmp(file_magic, magic, sizeof(magic)) != 0) return false;
+
+	const size_t nx = static_cast<size_t>(header[0]), ny = static_cast<size_t>(header[1]), nz = static_cast<size_t>(header[2]);
+	const size_t nr_params = static_cast<size_t>(header[3]);
+	if (nx != dem_nx || ny != dem_ny || fabs(geometry[0] - cellsize) > 1e-6*cellsize) return false; //not on the DEM's grid
+	if (fabs(geometry[3] - dem_x) > 1e-3*cellsize || fabs(geometry[4] - dem_y) > 1e-3*cellsize) return false; //the DEM has moved
+	if (header[4] != src_size || header[5] != src_mtime) return false; //the ARPS file has changed
+	if (nr_params < 3 || (read_K && nr_params < 4)) return false;
+
+	std::vector<double> z(nz);
+	if (nz > 0) fin.read(reinterpret_cast<char*>(&z[0]), static_cast<std::streamsize>(nz*sizeof(double)));
+
+	Coords llcorner(coordsys, coordparam);
+	llcorner.setXY(geometry[1], geometry[2], IOUtils::nodata);
+	mio::Grid3DObject* grids[4] = {&field.u, &field.v, &field.w, &field.K};
+	const size_t count = nx*ny*nz;
+	std::vector<float> buffer(count);
+	for (size_t pp = 0; pp < nr_params && pp < 4; pp++) {
+		if (count > 0) fin.read(reinterpret_cast<char*>(&buffer[0]), static_cast<std::streamsize>(count*sizeof(float)));
+		if (fin.fail()) return false;
+		if (pp == 3 && !read_K) break;
+		grids[pp]->set(nx, ny, nz, geometry[0], llcorner);
+		grids[pp]->z = z;
+		for (size_t ii = 0; ii < count; ii++) grids[pp]->grid3D(ii) = static_cast<double>( buffer[ii] );
+	}
+	return true;
+}
+
+/**
+ * @brief Write a wind situation into the cache directory. The file is first written under a temporary name and
+ * then renamed, so an interrupted run never leaves a truncated cache file behind.
+ */
+void WindFieldLibrary::writeCache(const std::string& name, const WindSituation& field) const
+{
+	long long src_size, src_mtime;
+	if (!getSourceStamp(name, src_size, src_mtime)) return; //we would not be able to validate it
+
+	const std::string filename( getCacheFilename(name) );
+	const std::string tmp_filename( filename + ".tmp" );
+	{
+		std::ofstream fout(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+		if (fout.fail()) throw AccessException(tmp_filename, AT);
+
+		const size_t nx = field.u.getNx(), ny = field.u.getNy(), nz = field.u.getNz();
+		const long long header[6] = {static_cast<long long>(nx), static_cast<long long>(ny), static_cast<long long>(nz),
+		                             field.has_K? 4 : 3, src_size, src_mtime};
+		const double geometry[5] = {field.u.cellsize, field.u.llcorner.getEasting(), field.u.llcorner.getNorthing(), dem_x, dem_y};
+		fout.write(magic, sizeof(magic));
+		fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+		fout.write(reinterpret_cast<const char*>(geometry), sizeof(geometry));
+		std::vector<double> z(field.u.z);
+		z.resize(nz, IOUtils::nodata);
+		if (nz > 0) fout.write(reinterpret_cast<const char*>(&z[0]), static_cast<std::streamsize>(nz*sizeof(double)));
+
+		const mio::Grid3DObject* grids[4] = {&field.u, &field.v, &field.w, &field.K};
+		const size_t count = nx*ny*nz;
+		std::vector<float> buffer(count);
+		for (size_t pp = 0; pp < (field.has_K? 4u : 3u); pp++) {
+			if (grids[pp]->getNx()*grids[pp]->getNy()*grids[pp]->getNz() != count) throw InvalidArgumentException("Inconsistent wind field dimensions for "+name, AT);
+			for (size_t ii = 0; ii < count; ii++) buffer[ii] = static_cast<float>( grids[pp]->grid3D(ii) );
+			if (count > 0) fout.write(reinterpret_cast<const char*>(&buffer[0]), static_cast<std::streamsize>(count*sizeof(float)));
+		}
+		if (fout.fail()) throw AccessException("Could not write "+tmp_filename, AT);
+	}
+	if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+		throw AccessException("Could not rename "+tmp_filename+" to "+filename, AT);
+}
@@ -0,0 +1,76 @@
+/***********************************************************************************/
+/*  Copyright 2009-2015 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WINDFIELDLIBRARY_H
+#define WINDFIELDLIBRARY_H
+
+#include <meteoio/MeteoIO.h>
+
+#include <list>
+#include <string>
+
+/**
+ * @class WindFieldLibrary
+ * @brief Provide the 3D wind fields of the snowdrift module, parsing each distinct wind situation only once.
+ * The most recently used wind situations are kept in memory, so switching back to a wind situation that has already
+ * been used (for example NW, then SE, then NW again) only copies the arrays instead of parsing the ARPS files again.
+ *
+ * When a cache directory is given, each wind situation is also written there in a compact binary format (float32)
+ * the first time it is parsed and later runs read this binary file instead of the ASCII ARPS file. The header of the
+ * binary file contains the geometry of the DEM (size, cellsize and lower left corner, all validated against the current
+ * DEM) as well as the size and modification time of the original file, so the cache is rebuilt whenever the ARPS file
+ * changes or the simulation is moved to another domain. In order to get exactly the same results whether the cache
+ * already exists or not, the wind fields are then always rounded to float32 (even when they have just been parsed).
+ *
+ * The following keys in the [Input] section control the library:
+ * 	- WINDFIELDS_CACHE: directory where to write the binary wind fields (it must exist; default: no binary cache);
+ * 	- WINDFIELDS_RESIDENT: number of wind situations to keep in memory (default: 3).
+ */
+class WindFieldLibrary
+{
+	public:
+		WindFieldLibrary(const mio::Config& cfg, const mio::DEMObject& dem);
+
+		void read(mio::IOManager& io, const std::string& name, const bool& read_K,
+		          mio::Grid3DObject& u, mio::Grid3DObject& v, mio::Grid3DObject& w, mio::Grid3DObject& K);
+
+		size_t getNrParsed() const {return nr_parsed;}
+
+	private:
+		typedef struct WIND_SITUATION {
+			WIND_SITUATION() : name(), has_K(false), u(), v(), w(), K() {}
+			std::string name;
+			bool has_K;
+			mio::Grid3DObject u, v, w, K;
+		} WindSituation;
+
+		void load(mio::IOManager& io, const std::string& name, const bool& read_K, WindSituation& field);
+		bool readCache(const std::string& name, const bool& read_K, WindSituation& field) const;
+		void writeCache(const std::string& name, const WindSituation& field) const;
+		bool getSourceStamp(const std::string& name, long long& size, long long& mtime) const;
+		std::string getCacheFilename(const std::string& name) const;
+		static void toFloat(mio::Grid3DObject& grid);
+
+		static const char magic[8];
+
+		std::list<WindSituation> resident; ///< most recently used wind situations, the most recent first
+		std::string cache_dir, grid3d_path, coordsys, coordparam;
+		double cellsize, dem_x, dem_y; ///< DEM cellsize and lower left corner
+		size_t dem_nx, dem_ny, max_resident, nr_parsed;
+};
+
+#endif
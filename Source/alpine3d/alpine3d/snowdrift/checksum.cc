@@ -130,10 +130,6 @@ double checksum(const mio::Array1D<SnowStation>&x)
 
 		t+=checksum(x[ii].Ndata, x[ii].getNumberOfNodes());
 		t+=checksum(x[ii].Edata, x[ii].getNumberOfElements());
-		if (x[ii].Kt!=NULL) {
-			t+=0.1;
-		}
-
 		t+=checksum(x[ii].Cdata);
 
 		if (t>1.0E20 && first) {
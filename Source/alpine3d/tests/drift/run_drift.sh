@@ -0,0 +1,66 @@
+#!/bin/bash
+#This runs a few snowdrift steps on a synthetic domain (see the "benchmark" documentation page) and
+#compares the checksums of the drift fields printed at each step with a reference
+#usage: run_drift.sh [nr_steps]
+
+# Print a special line to prevent CTest from truncating the test output
+printf "CTEST_FULL_OUTPUT (line required by CTest to avoid output truncation)\n\n"
+
+STEPS=${1:-6}
+BEGIN="2014-12-01T01:00"
+PREC="1e-6"
+PROG_ROOTDIR=../../bin
+export DYLD_FALLBACK_LIBRARY_PATH=${PROG_ROOTDIR}:${DYLD_FALLBACK_LIBRARY_PATH}	#for osX
+export LD_LIBRARY_PATH=${PROG_ROOTDIR}:${PROG_ROOTDIR}/../lib:${LD_LIBRARY_PATH}	#for Linux
+
+mkdir -p output synthetic
+rm -f output/checksums.txt
+
+#now run the simulation
+date
+${PROG_ROOTDIR}/alpine3d --iofile=./io.ini --benchmark --enable-eb --enable-drift --np-snowpack=2 --np-ebalance=2 --startdate=${BEGIN} --steps=${STEPS} > stdouterr.log 2>&1
+ret=$?
+date
+if [ "$ret" -ne "0" ]; then
+	echo "fail : Alpine3D did not complete properly! Return code=$ret"
+	exit 1
+fi
+grep "SnowDrift checksums" stdouterr.log > output/checksums.txt
+
+#stop here when re-generating the reference file
+#cp output/checksums.txt checksums_ref.txt; exit
+
+#there must be one line of checksums per step, and the reference must cover all of them
+nr_lines=$(wc -l < output/checksums.txt)
+if [ "$nr_lines" -ne "$STEPS" ]; then
+	echo "fail : expected snowdrift checksums for ${STEPS} step(s), got ${nr_lines}"
+	exit 1
+fi
+if [ "$(wc -l < checksums_ref.txt)" -lt "$STEPS" ]; then
+	echo "fail : the reference only contains $(wc -l < checksums_ref.txt) step(s), ${STEPS} were requested"
+	exit 1
+fi
+
+#Compare the checksums with the reference (relative tolerance)
+head -n ${STEPS} checksums_ref.txt | paste -d'\n' - output/checksums.txt | awk -v prec=${PREC} '
+	{
+		getline line
+		step = NR/2
+		nr_ref = split($0, ref, "[ =]+")
+		nr = split(line, val, "[ =]+")
+		if (nr != nr_ref) { print "Checksums differ at step " step ": " line; nr_fail++; next }
+		for (ii=1; ii<=nr; ii++) {
+			if (val[ii] !~ /^[-+0-9.eE]+$/) continue
+			diff = val[ii] - ref[ii]
+			if (diff<0) diff = -diff
+			scale = (ref[ii]<0)? -ref[ii] : ref[ii]
+			tol = (scale>0)? prec*scale : prec
+			if (diff > tol) { print "Checksums differ at step " step " for " val[ii-1] ": " ref[ii] " vs " val[ii]; nr_fail++ }
+		}
+		nr_steps++
+	}
+	END {
+		if (nr_steps==0) print "fail : no snowdrift checksums found"
+		else if (nr_fail==0) print "Checksums match the reference for " nr_steps " step(s)"
+	}
+'
@@ -0,0 +1,96 @@
+#!/bin/bash
+#This runs Alpine3D on a synthetic domain (see the "benchmark" documentation page) with an increasing
+#number of workers and prints the speedup and parallel efficiency of each module, both for strong scaling
+#(same domain for all runs) and weak scaling (the domain grows with the number of workers).
+#usage: run_scaling.sh [nr_steps] [list of workers]
+#	for example: run_scaling.sh 12 1 2 4 8
+#the following environment variables are also used:
+#	NX, NY: size of the domain for one worker (default: as in io.ini)
+#	MODULES: Alpine3D modules to enable (default: "--enable-eb")
+#	RANKS: list of MPI processes to run with (default: 1), requires MPIRUN such as "mpirun -np"
+
+# Print a special line to prevent CTest from truncating the test output
+printf "CTEST_FULL_OUTPUT (line required by CTest to avoid output truncation)\n\n"
+
+STEPS=${1:-6}
+shift
+WORKERS=${@:-"1 2 4"}
+RANKS=${RANKS:-1}
+MODULES=${MODULES:-"--enable-eb"}
+BEGIN="2014-12-01T01:00"
+
+NX=${NX:-`awk -F'=' '/^NX/{gsub(/[ \t]/, "", $2); print $2}' io.ini`}
+NY=${NY:-`awk -F'=' '/^NY/{gsub(/[ \t]/, "", $2); print $2}' io.ini`}
+
+PROG_ROOTDIR=../../bin
+export DYLD_FALLBACK_LIBRARY_PATH=${PROG_ROOTDIR}:${DYLD_FALLBACK_LIBRARY_PATH}	#for osX
+export LD_LIBRARY_PATH=${PROG_ROOTDIR}:${PROG_ROOTDIR}/../lib:${LD_LIBRARY_PATH}	#for Linux
+
+mkdir -p output synthetic
+rm -f output/strong.txt output/weak.txt
+
+#run one simulation: run_a3d {results file} {nx} {ny} {processes} {workers}
+function run_a3d {
+	results=$1
+	nx=$2
+	ny=$3
+	ranks=$4
+	workers=$5
+
+	printf "[BENCHMARK]\nNX = ${nx}\nNY = ${ny}\nRESULTS_FILE = ${results}\n" | cat io.ini - > io_run.ini
+	launcher=""
+	if [ "${ranks}" -gt "1" ]; then
+		launcher="${MPIRUN} ${ranks}"
+	fi
+	${launcher} ${PROG_ROOTDIR}/alpine3d --iofile=./io_run.ini --benchmark ${MODULES} --np-snowpack=${workers} --np-ebalance=${workers} --startdate=${BEGIN} --steps=${STEPS} > stdouterr.log 2>&1
+	ret=$?
+	if [ "$ret" -ne "0" ]; then
+		echo "fail : Alpine3D did not complete properly for ${ranks} process(es) and ${workers} worker(s) on ${nx}x${ny} cells! Return code=$ret"
+		exit 1
+	fi
+}
+
+#print the speedup and efficiency of each module compared to the first run
+#print_table {results file} {title} {strong|weak}
+function print_table {
+	awk -v title="$2" -v mode="$3" '
+		/^#/ {next}
+		{
+			nr++
+			units = $1*$2
+			if (nr==1) {
+				printf("\n%s scaling (speedup / efficiency relative to the first run)\n", title)
+				printf("%5s %5s %9s %6s", "procs", "work.", "cells", "steps")
+				for (ii=6; ii<=NF; ii++) printf(" %20s", name[ii])
+				printf("\n")
+				units_ref = units
+				for (ii=6; ii<=NF; ii++) ref[ii] = $ii
+			}
+			printf("%5d %5d %9d %6d", $1, $2, $4, $5)
+			for (ii=6; ii<=NF; ii++) {
+				if ($ii<0 || $ii==0 || ref[ii]<=0) { printf(" %20s", "-"); continue }
+				speedup = ref[ii] / $ii
+				if (mode=="strong") efficiency = speedup * units_ref / units
+				else efficiency = speedup
+				printf(" %8.3fs %4.2fx %4.0f%%", $ii, speedup, efficiency*100.)
+			}
+			printf("\n")
+		}
+		BEGIN {
+			split("x x x x x meteo ebalance terrain snowdrift snowpack runoff total", name, " ")
+		}
+	' $1
+}
+
+date
+for ranks in ${RANKS}; do
+	for workers in ${WORKERS}; do
+		echo "Running ${STEPS} steps with ${ranks} process(es) and ${workers} worker(s)"
+		run_a3d ./output/strong.txt ${NX} ${NY} ${ranks} ${workers}
+		run_a3d ./output/weak.txt $(( NX * ranks * workers )) ${NY} ${ranks} ${workers}
+	done
+done
+date
+
+print_table output/strong.txt "Strong" strong
+print_table output/weak.txt "Weak" weak
@@ -25,6 +25,13 @@ else
 	echo "fail : Alpine3D did not complete properly! Return code=$ret"
 fi
 
+#all the requested output grids must be available (either as meteo forcing or from the workers)
+nr_missing=$(grep -c "not available in the workers" stdouterr.log)
+if [ "$nr_missing" -ne "0" ]; then
+	echo "fail : ${nr_missing} requested grid(s) were not available in the workers"
+	grep "not available in the workers" stdouterr.log | sort | uniq -c
+fi
+
 #stop here when re-generating the reference files
 #exit
 
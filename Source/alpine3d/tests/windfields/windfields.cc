@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <meteoio/MeteoIO.h>
+#include <alpine3d/SyntheticDomain.h>
+#include <alpine3d/snowdrift/WindFieldLibrary.h>
+
+using namespace mio;
+using namespace std;
+
+//The wind fields of a synthetic domain are read through the binary cache of the WindFieldLibrary: the cached wind
+//fields must be exactly the same as the parsed ones and the cache must not be used for a DEM at another location.
+const std::string work_dir( "windfields_work" );
+const std::string cache_dir( work_dir + "/cache" );
+const std::string wind_field( "synthetic_W" );
+
+size_t nr_errors = 0;
+
+void error(const std::string& msg)
+{
+	cerr << msg << endl;
+	nr_errors++;
+}
+
+void cleanup()
+{
+	if (!FileUtils::directoryExists(work_dir)) return;
+	const std::list<std::string> files( FileUtils::readDirectory(work_dir, "", true) );
+	for (std::list<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) std::remove( (work_dir+"/"+*it).c_str() );
+	std::remove( cache_dir.c_str() );
+	std::remove( work_dir.c_str() );
+}
+
+bool isIdentical(const Grid3DObject& grid1, const Grid3DObject& grid2)
+{
+	if (grid1.getNx()!=grid2.getNx() || grid1.getNy()!=grid2.getNy() || grid1.getNz()!=grid2.getNz()) return false;
+	if (grid1.cellsize!=grid2.cellsize || grid1.z!=grid2.z) return false;
+	if (grid1.llcorner.getEasting()!=grid2.llcorner.getEasting() || grid1.llcorner.getNorthing()!=grid2.llcorner.getNorthing()) return false;
+	for (size_t ii=0; ii<grid1.getNx()*grid1.getNy()*grid1.getNz(); ii++)
+		if (grid1.grid3D(ii)!=grid2.grid3D(ii)) return false;
+	return true;
+}
+
+//read the wind field with a new library (so nothing is resident in memory) and check if it had to be parsed
+void readWindField(const std::string& step, const Config& cfg, const DEMObject& dem, const bool& expect_parsed, Grid3DObject (&field)[3])
+{
+	IOManager io(cfg);
+	WindFieldLibrary library(cfg, dem);
+	Grid3DObject K; //the synthetic wind fields do not provide the eddy diffusivity
+	library.read(io, wind_field, false, field[0], field[1], field[2], K);
+	if (library.getNrParsed()!=(expect_parsed? 1 : 0))
+		error(step + ": the wind field should " + (expect_parsed? "have been parsed" : "have been read from the cache"));
+}
+
+void compare(const std::string& step, const Grid3DObject (&ref)[3], const Grid3DObject (&field)[3])
+{
+	const char* names[3] = {"u", "v", "w"};
+	for (size_t pp=0; pp<3; pp++)
+		if (!isIdentical(ref[pp], field[pp])) error(step + ": the " + names[pp] + " component is different");
+}
+
+int main() {
+	cleanup();
+	mkdir(work_dir.c_str(), 0755);
+	mkdir(cache_dir.c_str(), 0755);
+
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("EXPERIMENT", "Output", "windfields");
+	cfg.addKey("WORKDIR", "Benchmark", work_dir);
+	cfg.addKey("NX", "Benchmark", "12");
+	cfg.addKey("NY", "Benchmark", "10");
+	cfg.addKey("NR_STATIONS", "Benchmark", "1");
+	const SyntheticDomain domain(cfg);
+	domain.generate(Date(2014, 12, 1, 1, 0, 1.), 2, true);
+	domain.setConfig(cfg, true);
+	cfg.addKey("WINDFIELDS_CACHE", "Input", cache_dir);
+
+	DEMObject dem;
+	IOManager io(cfg);
+	io.readDEM(dem);
+	DEMObject shifted_dem( dem );
+	shifted_dem.llcorner.setXY(dem.llcorner.getEasting()+dem.cellsize, dem.llcorner.getNorthing(), dem.llcorner.getAltitude());
+
+	//round trip: parsed and written to the cache, then read back
+	Grid3DObject parsed[3], cached[3];
+	readWindField("Building the cache", cfg, dem, true, parsed);
+	readWindField("Reading the cache", cfg, dem, false, cached);
+	compare("Reading the cache", parsed, cached);
+
+	//same size but another location: the cache can not be used and is rebuilt for the new location
+	readWindField("Shifted DEM", cfg, shifted_dem, true, cached);
+	compare("Shifted DEM", parsed, cached);
+	readWindField("Reading the cache of the shifted DEM", cfg, shifted_dem, false, cached);
+	readWindField("Back to the original DEM", cfg, dem, true, cached);
+
+	cleanup();
+	if (nr_errors>0) {
+		cerr << nr_errors << " error(s) with the wind fields cache\n";
+		return EXIT_FAILURE;
+	}
+	cout << "Wind fields cache successfully validated\n";
+	return EXIT_SUCCESS;
+}
@@ -112,6 +112,7 @@ void Config::addKey(std::string key, std::string section, const std::string& val
 	IOUtils::toUpper(section);
 	IOUtils::toUpper(key);
 	properties[ section + "::" + key ] = value;
+	sections.insert( section );
 }
 
 void Config::deleteKey(std::string key, std::string section)
@@ -19,8 +19,11 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <cstdio>
+#include <ctime>
 #include <fstream>
+#include <sys/stat.h>
 
 #if defined _WIN32 || defined __MINGW32__
 	#ifndef NOMINMAX
@@ -325,6 +328,22 @@ void readDirectoryPrivate(const std::string& path, const std::string& sub_path,
 }
 #endif
 
+bool directoryExists(const std::string& path)
+{
+	struct stat buffer;
+	if (stat(path.c_str(), &buffer)!=0) return false;
+	return ((buffer.st_mode & S_IFMT)==S_IFDIR);
+}
+
+bool getFileStamp(const std::string& filename, long long& size, long long& mtime)
+{
+	struct stat buffer;
+	if (stat(filename.c_str(), &buffer)!=0) return false;
+	size = static_cast<long long>(buffer.st_size);
+	mtime = static_cast<long long>(buffer.st_mtime);
+	return true;
+}
+
 char getEoln(std::istream& fin)
 {
 	std::streambuf* pbuf;
@@ -401,9 +420,30 @@ std::map<std::string,std::string> readKeyValueHeader(std::istream& fin, const si
 
 
 //below, the file indexer implementation
+FileIndexer::FileIndexer(const FileIndexer& source) : vecIndex(), index_mutex()
+{
+	const SharedLock lock( source.index_mutex );
+	vecIndex = source.vecIndex;
+}
+
+FileIndexer& FileIndexer::operator=(const FileIndexer& source)
+{
+	if (this != &source) {
+		std::vector< struct file_index > tmp;
+		{
+			const SharedLock lock( source.index_mutex );
+			tmp = source.vecIndex;
+		}
+		const ExclusiveLock lock( index_mutex );
+		vecIndex.swap( tmp );
+	}
+	return *this;
+}
+
 void FileIndexer::setIndex(const Date& i_date, const std::streampos& i_pos)
 {
 	const file_index elem(i_date, i_pos);
+	const ExclusiveLock lock( index_mutex );
 
 	//check if we can simply append the new index
 	if (vecIndex.empty() || elem>vecIndex.back()) {
@@ -434,6 +474,7 @@ void FileIndexer::setIndex(const double& i_date, const std::streampos& i_pos)
 
 std::streampos FileIndexer::getIndex(const Date& i_date) const
 {
+	const SharedLock lock( index_mutex );
 	const size_t foundIdx = binarySearch(i_date);
 	if (foundIdx==static_cast<size_t>(-1)) return static_cast<std::streampos>(-1);
 	else return vecIndex[foundIdx].pos;
@@ -467,6 +508,7 @@ size_t FileIndexer::binarySearch(const Date& soughtdate) const
 
 const std::string FileIndexer::toString() const
 {
+	const SharedLock lock( index_mutex );
 	std::ostringstream os;
 	os << "<FileIndexer>\n";
 	for (size_t ii=0; ii<vecIndex.size(); ii++)
@@ -475,5 +517,219 @@ const std::string FileIndexer::toString() const
 	return os.str();
 }
 
+
+//below, the grids catalog implementation
+/**
+* @brief Constructor
+* @param i_path archive directory
+* @param i_pattern only consider the files whose name contains this pattern (see readDirectory())
+* @param i_index_dir existing directory where to keep the catalogue between runs (default: empty, so it is only kept in memory)
+* @param i_recursive also look for files in the sub-directories of the archive (the file names are then relative paths)
+*/
+GridsCatalog::GridsCatalog(const std::string& i_path, const std::string& i_pattern, const std::string& i_index_dir, const bool& i_recursive)
+             : files(), entries(), path(i_path), pattern(i_pattern), index_dir(i_index_dir), signature(), dir_mtime(-1), nr_parsed(0), recursive(i_recursive) {}
+
+/**
+* @brief Bring the catalogue up to date with the archive directory
+* @param parser plugin specific parser for the archive files
+*/
+void GridsCatalog::update(const FileParser& parser)
+{
+	long long dir_size, current_mtime;
+	if (!getFileStamp(path, dir_size, current_mtime))
+		throw AccessException("Can not access grids archive directory '"+path+"'", AT);
+
+	const std::string parser_signature( parser.getSignature() );
+	if (parser_signature!=signature) { //different parsing options, the catalogue must be rebuilt
+		files.clear();
+		signature = parser_signature;
+		dir_mtime = -1;
+		if (!index_dir.empty()) readIndex();
+	}
+	if (!recursive && dir_mtime!=-1 && current_mtime==dir_mtime) { //nothing has changed since the last update
+		if (entries.empty() && !files.empty()) buildEntries();
+		return;
+	}
+	const long long previous_mtime = dir_mtime;
+
+	const std::list<std::string> dirlist( readDirectory(path, pattern, recursive) );
+	std::map<std::string, file_record> new_files;
+	bool changed = (dirlist.size()!=files.size());
+	for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
+		file_record record;
+		if (!getFileStamp(path + "/" + *it, record.size, record.mtime)) continue; //the file is gone in the meantime
+
+		const std::map<std::string, file_record>::iterator known( files.find(*it) );
+		if (known!=files.end() && known->second.size==record.size && known->second.mtime==record.mtime) {
+			record.grids.swap( known->second.grids );
+		} else {
+			parser.parse(path, *it, record.grids);
+			nr_parsed++;
+			changed = true;
+		}
+		new_files[*it].grids.swap( record.grids );
+		new_files[*it].size = record.size;
+		new_files[*it].mtime = record.mtime;
+	}
+	files.swap( new_files );
+
+	//a directory modified within the current second could still receive files with the same mtime
+	dir_mtime = (current_mtime < static_cast<long long>(time(nullptr))-1)? current_mtime : -1;
+	buildEntries();
+	if (!index_dir.empty() && (changed || dir_mtime!=previous_mtime)) {
+		try {
+			writeIndex();
+		} catch (const std::exception& e) { //the index is only an optimization, we can go on without it
+			std::cerr << "[W] Could not write the grids catalogue for '" << path << "': " << e.what() << "\n";
+		}
+	}
+}
+
+/**
+* @brief Get the parameters available for each date within a time range
+* @param[in] start start of the time range (inclusive)
+* @param[in] end end of the time range (inclusive)
+* @param[out] results for each date, the set of MeteoGrids::Parameters available
+*/
+void GridsCatalog::getGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> >& results) const
+{
+	const catalog_entry elem(start, 0, "");
+	for (std::vector<catalog_entry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), elem); it!=entries.end(); ++it) {
+		if (it->date>end) break;
+		results[ it->date ].insert( it->param );
+	}
+}
+
+/**
+* @brief Get all the grids available within a time range
+* @param[in] start start of the time range (inclusive)
+* @param[in] end end of the time range (inclusive)
+* @param[out] results grids found in the time range, sorted by date
+*/
+void GridsCatalog::getEntries(const Date& start, const Date& end, std::vector<catalog_entry>& results) const
+{
+	results.clear();
+	const catalog_entry elem(start, 0, "");
+	for (std::vector<catalog_entry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), elem); it!=entries.end(); ++it) {
+		if (it->date>end) break;
+		results.push_back( *it );
+	}
+}
+
+void GridsCatalog::buildEntries()
+{
+	entries.clear();
+	for (std::map<std::string, file_record>::const_iterator it = files.begin(); it!=files.end(); ++it)
+		entries.insert(entries.end(), it->second.grids.begin(), it->second.grids.end());
+	std::stable_sort(entries.begin(), entries.end()); //files are sorted by name, so equal dates keep this order
+}
+
+/**
+* @brief Build the name of the index file from a hash of the archive path (FNV-1a)
+*/
+std::string GridsCatalog::getIndexFilename() const
+{
+	const std::string key( cleanPath(path, true) );
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t ii=0; ii<key.size(); ii++) {
+		hash ^= static_cast<unsigned char>(key[ii]);
+		hash *= 1099511628211ULL;
+	}
+
+	std::ostringstream os;
+	os << index_dir << "/.meteoio_catalog_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".idx";
+	return os.str();
+}
+
+/**
+* @brief Read the catalogue from the index directory
+* @details The index file contains a header (with the archive path, the parser's signature and the directory modification
+* time) and then, for each file, a line with its size, modification time, number of grids and name followed by one
+* line per grid (julian date in GMT, time zone, parameter and offset).
+* @return false if there is no valid index file for this archive and parser
+*/
+bool GridsCatalog::readIndex()
+{
+	std::ifstream fin(getIndexFilename().c_str());
+	if (fin.fail()) return false;
+
+	std::string line, file_path, file_signature;
+	long long file_dir_mtime = -1;
+	std::getline(fin, line);
+	if (line!="MeteoIO grids catalog 1") return false;
+	std::getline(fin, file_path);
+	std::getline(fin, file_signature);
+	fin >> file_dir_mtime;
+	if (fin.fail() || file_path!=path || file_signature!=signature) return false;
+
+	std::map<std::string, file_record> index_files;
+	size_t nr_files = 0;
+	fin >> nr_files;
+	for (size_t ii=0; ii<nr_files; ii++) {
+		file_record record;
+		size_t nr_grids = 0;
+		std::string name;
+		fin >> record.size >> record.mtime >> nr_grids;
+		fin.get(); //the separator before the name, that might contain spaces
+		std::getline(fin, name);
+		if (fin.fail()) return false;
+		for (size_t jj=0; jj<nr_grids; jj++) {
+			double julian, tz;
+			catalog_entry grid;
+			fin >> julian >> tz >> grid.param >> grid.offset;
+			if (fin.fail()) return false;
+			grid.date.setDate(julian, 0.);
+			grid.date.setTimeZone(tz);
+			grid.file = name;
+			record.grids.push_back( grid );
+		}
+		index_files[name].grids.swap( record.grids );
+		index_files[name].size = record.size;
+		index_files[name].mtime = record.mtime;
+	}
+	if (fin.fail()) return false;
+
+	files.swap( index_files );
+	dir_mtime = file_dir_mtime;
+	return true;
+}
+
+/**
+* @brief Write the catalogue into the index directory. The file is first written under a temporary name and
+* then renamed, so an interrupted run never leaves a truncated file behind.
+*/
+void GridsCatalog::writeIndex() const
+{
+	const std::string filename( getIndexFilename() );
+	const std::string tmp_filename( filename + ".tmp" );
+	{
+		std::ofstream fout(tmp_filename.c_str(), std::ios::out | std::ios::trunc);
+		if (fout.fail()) throw AccessException(tmp_filename, AT);
+
+		fout << "MeteoIO grids catalog 1\n" << path << "\n" << signature << "\n" << dir_mtime << "\n" << files.size() << "\n";
+		fout << std::setprecision(17);
+		for (std::map<std::string, file_record>::const_iterator it = files.begin(); it!=files.end(); ++it) {
+			fout << it->second.size << " " << it->second.mtime << " " << it->second.grids.size() << " " << it->first << "\n";
+			for (size_t jj=0; jj<it->second.grids.size(); jj++) {
+				const catalog_entry& grid = it->second.grids[jj];
+				fout << grid.date.getJulian(true) << " " << grid.date.getTimeZone() << " " << grid.param << " " << grid.offset << "\n";
+			}
+		}
+		if (fout.fail()) throw AccessException("Could not write "+tmp_filename, AT);
+	}
+	if (std::rename(tmp_filename.c_str(), filename.c_str())!=0)
+		throw AccessException("Could not rename "+tmp_filename+" to "+filename, AT);
+}
+
+const std::string GridsCatalog::toString() const
+{
+	std::ostringstream os;
+	os << "<GridsCatalog>\n";
+	os << "\t" << path << ": " << files.size() << " files, " << entries.size() << " grids";
+	if (!entries.empty()) os << " from " << entries.front().date.toString(Date::ISO) << " to " << entries.back().date.toString(Date::ISO);
+	os << "\n</GridsCatalog>\n";
+	return os.str();
+}
+
 } //end namespace FileUtils
 } //end namespace mio
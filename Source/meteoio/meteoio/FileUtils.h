@@ -21,10 +21,12 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include <list>
 
 #include <meteoio/dataClasses/Date.h>
+#include <meteoio/SharedMutex.h>
 
 namespace mio {
 namespace FileUtils {
@@ -57,6 +59,19 @@ namespace FileUtils {
 
 	bool fileExists(const std::string& filename);
 
+	///@brief Does this directory exist? (links are followed)
+	bool directoryExists(const std::string& path);
+
+	/**
+	* @brief Get the size and modification time of a file or directory, for example to know if it has changed since
+	* some data was derived from it
+	* @param[in] filename file (or directory) name
+	* @param[out] size size in bytes
+	* @param[out] mtime modification time, in seconds since the epoch
+	* @return false if the file could not be accessed (size and mtime are then not modified)
+	*/
+	bool getFileStamp(const std::string& filename, long long& size, long long& mtime);
+
 	/**
 	* @brief Replace "\" by "/" in a string so that a path string is cross plateform, optionally resolve
 	* links, convert relative paths to absolute paths, etc
@@ -125,6 +140,7 @@ namespace FileUtils {
 	* @class file_indexer
 	* @brief helps building an index of stream positions
 	* to quickly jump closer to the proper position in a file
+	* @details The index can be read and updated by several threads at the same time.
 	*
 	* @ingroup plugins
 	* @author Mathias Bavay
@@ -132,7 +148,9 @@ namespace FileUtils {
 	*/
 	class FileIndexer {
 		public:
-			FileIndexer() : vecIndex() {}
+			FileIndexer() : vecIndex(), index_mutex() {}
+			FileIndexer(const FileIndexer& source);
+			FileIndexer& operator=(const FileIndexer& source);
 
 			/**
 			* @brief Add a new position to the index
@@ -170,6 +188,84 @@ namespace FileUtils {
 			size_t binarySearch(const Date& soughtdate) const;
 
 			std::vector< struct file_index > vecIndex;
+			mutable SharedMutex index_mutex;
+	};
+
+	/**
+	* @class GridsCatalog
+	* @brief Persistent catalogue of the grids available in an archive directory
+	* @details The files of the archive directory are parsed by a plugin specific FileParser to know which grids
+	* (date, parameter, file and position within the file) they contain. The results are kept sorted by date, so
+	* the grids available within a time range are found by a binary search. When the directory has not been modified
+	* since the last update, it is not even listed again. Otherwise, only the files that are new or whose size or
+	* modification time have changed are parsed again (so files rewritten in place are only noticed once the directory
+	* itself has been modified).
+	*
+	* If an index directory has been provided, the catalogue is also written there (as a hidden file) so the
+	* following runs only need to check the files for changes. The index file also contains the parser's signature,
+	* so changing the parsing options (for example the time zone) triggers a full update.
+	*
+	* @ingroup plugins
+	*/
+	class GridsCatalog {
+		public:
+			///a grid found in the archive
+			struct catalog_entry {
+				catalog_entry() : date(), param(static_cast<size_t>(-1)), file(), offset(0) {}
+				catalog_entry(const Date& i_date, const size_t& i_param, const std::string& i_file, const size_t& i_offset=0)
+				               : date(i_date), param(i_param), file(i_file), offset(i_offset) {}
+				bool operator<(const catalog_entry& a) const {
+					return date < a.date;
+				}
+				Date date;
+				size_t param; ///< as MeteoGrids::Parameters
+				std::string file; ///< file name, relative to the archive directory
+				size_t offset; ///< position of the grid in the file (for example, its time index), 0 for single grid files
+			};
+
+			///plugin specific parsing of the archive files
+			class FileParser {
+				public:
+					virtual ~FileParser() {}
+					/**
+					* @brief Get the grids contained in a file of the archive
+					* @param[in] path archive directory
+					* @param[in] filename file name, relative to the archive directory
+					* @param[out] entries grids found in this file (to append to)
+					*/
+					virtual void parse(const std::string& path, const std::string& filename, std::vector<catalog_entry>& entries) const = 0;
+					///everything that changes the results of the parsing (so a different signature invalidates the index)
+					virtual std::string getSignature() const = 0;
+			};
+
+			GridsCatalog() : files(), entries(), path(), pattern(), index_dir(), signature(), dir_mtime(-1), nr_parsed(0), recursive(false) {}
+			GridsCatalog(const std::string& i_path, const std::string& i_pattern="", const std::string& i_index_dir="", const bool& i_recursive=false);
+
+			void update(const FileParser& parser);
+			void getGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> >& results) const;
+			void getEntries(const Date& start, const Date& end, std::vector<catalog_entry>& results) const;
+
+			size_t getNrParsed() const {return nr_parsed;} ///< number of files that had to be parsed so far
+			const std::string toString() const;
+
+		private:
+			struct file_record {
+				file_record() : size(-1), mtime(-1), grids() {}
+				long long size, mtime;
+				std::vector<catalog_entry> grids;
+			};
+
+			std::string getIndexFilename() const;
+			bool readIndex();
+			void writeIndex() const;
+			void buildEntries();
+
+			std::map<std::string, file_record> files; ///< all the files of the archive
+			std::vector<catalog_entry> entries; ///< all grids, sorted by date
+			std::string path, pattern, index_dir, signature;
+			long long dir_mtime; ///< modification time of the archive directory at the last update, -1 if it should not be trusted
+			size_t nr_parsed;
+			bool recursive; ///< also look for files in the sub-directories of the archive
 	};
 
 } //end namespace FileUtils
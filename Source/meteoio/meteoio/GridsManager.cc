@@ -21,22 +21,39 @@
 #include <meteoio/dataClasses/Coords.h>
 #include <meteoio/meteoLaws/Atmosphere.h>
 #include <meteoio/MathOptim.h>
+#include <meteoio/Tracing.h>
 
 using namespace std;
 
 namespace mio {
 
 GridsManager::GridsManager(IOHandler& in_iohandler, const Config& in_cfg)
-             : iohandler(in_iohandler), cfg(in_cfg), buffer(0), grids2d_list(), grids2d_start(), grids2d_end(),
-               grid2d_list_buffer_size(370.), processing_level(IOUtils::filtered | IOUtils::resampled | IOUtils::generated), dem_altimeter(false)
+             : iohandler(in_iohandler), cfg(in_cfg), buffer(0), remapper(), grids2d_list(), grids2d_start(), grids2d_end(),
+               grid2d_list_buffer_size(370.), processing_level(IOUtils::filtered | IOUtils::resampled | IOUtils::generated), dem_altimeter(false),
+               buffers_mutex()
 {
 	size_t max_grids = 10;
 	cfg.getValue("BUFF_GRIDS", "General", max_grids, IOUtils::nothrow);
 	buffer.setMaxGrids(max_grids);
+	bool compact_grids = false;
+	cfg.getValue("BUFF_GRIDS_COMPACT", "General", compact_grids, IOUtils::nothrow);
+	buffer.setCompact(compact_grids);
 	cfg.getValue("BUFFER_SIZE", "General", grid2d_list_buffer_size, IOUtils::nothrow);
 	cfg.getValue("DEM_FROM_PRESSURE", "Input", dem_altimeter, IOUtils::nothrow); //HACK document it! if no dem is found but local and sea level pressure grids are found, use them to rebuild a DEM; [Input] section
+
+	std::string remap_method("BILINEAR"), remap_cache;
+	cfg.getValue("REMAP_METHOD", "InputEditing", remap_method, IOUtils::nothrow);
+	cfg.getValue("REMAP_CACHE", "InputEditing", remap_cache, IOUtils::nothrow);
+	remapper = GridRemapper(GridRemapper::getMethod(remap_method), remap_cache);
 }
 
+GridsManager::GridsManager(const GridsManager& source)
+             : iohandler(source.iohandler), cfg(source.cfg), buffer(source.buffer), remapper(source.remapper), grids2d_list(source.grids2d_list),
+               grids2d_start(source.grids2d_start), grids2d_end(source.grids2d_end), grid2d_list_buffer_size(source.grid2d_list_buffer_size),
+               processing_level(source.processing_level), dem_altimeter(source.dem_altimeter),
+               buffers_mutex()
+{}
+
 /**
 * @brief Set the desired ProcessingLevel
 * @details The processing level affects the way meteo data is read and processed. Three values are possible:
@@ -57,9 +74,16 @@ void GridsManager::setProcessingLevel(const unsigned int& i_level)
 	    && ((i_level & IOUtils::filtered) == IOUtils::filtered))
 		throw InvalidArgumentException("The processing level is invalid (raw and filtered at the same time)", AT);
 
+	const ExclusiveLock lock( buffers_mutex );
 	processing_level = i_level;
 }
 
+void GridsManager::clear_cache()
+{
+	const ExclusiveLock lock( buffers_mutex );
+	buffer.clear();
+}
+
 /**
 * @brief Read the requested grid, according to the configured processing level
 * @details If the grid has been buffered, it will be returned from the buffer. If it is not available but can be generated, it will
@@ -69,13 +93,20 @@ void GridsManager::setProcessingLevel(const unsigned int& i_level)
 */
 void GridsManager::read2DGrid(Grid2DObject& grid2D, const std::string& option)
 {
+	MIO_TRACE_ZONE("MeteoIO", "read2DGrid");
+	{ //buffered grids are returned concurrently with the other readers
+		const SharedLock lock( buffers_mutex );
+		if (processing_level != IOUtils::raw && buffer.get(grid2D, option)) return;
+	}
+
+	const ExclusiveLock lock( buffers_mutex );
 	if (processing_level == IOUtils::raw){
 		iohandler.read2DGrid(grid2D, option);
 	} else {
-		if (buffer.get(grid2D, option)) return;
+		if (buffer.get(grid2D, option)) return; //another thread might have read it in the mean time
 
 		iohandler.read2DGrid(grid2D, option);
-		buffer.push(grid2D, option);
+		buffer.pushAndGet(grid2D, option);
 	}
 }
 
@@ -89,18 +120,59 @@ void GridsManager::read2DGrid(Grid2DObject& grid2D, const std::string& option)
 */
 void GridsManager::read2DGrid(Grid2DObject& grid2D, const MeteoGrids::Parameters& parameter, const Date& date)
 {
+	{ //buffered grids are returned concurrently with the other readers
+		const SharedLock lock( buffers_mutex );
+		if (processing_level != IOUtils::raw && buffer.get(grid2D, parameter, date)) {
+			if (grid2D.isLatlon()) grid2D.reproject(); //as in getGrid()
+			return;
+		}
+	}
+
+	const ExclusiveLock lock( buffers_mutex );
 	grid2D = getGrid(parameter, date);
 }
 
+/**
+* @brief Get the requested grid remapped onto the provided DEM
+* @details The grid is read (or generated) as by read2DGrid() but without the simplified lat/lon handling. It is then remapped onto
+* the DEM by a GridRemapper, that computes the remapping operator only once for all grids sharing the same geolocalization.
+* @param[out] grid2D a grid filled with the requested parameter, with the DEM's geolocalization
+* @param parameter the parameter to get
+* @param[in] date the timestamp that we would like to have
+* @param[in] dem the Digital Elevation Model providing the target geolocalization
+*/
+void GridsManager::remap2DGrid(Grid2DObject& grid2D, const MeteoGrids::Parameters& parameter, const Date& date, const DEMObject& dem)
+{
+	const ExclusiveLock lock( buffers_mutex );
+	const Grid2DObject source( getGrid(parameter, date, false) );
+	remapper.remap(source, dem, grid2D);
+}
+
+std::string GridsManager::getRemapInfo() const
+{
+	const SharedLock lock( buffers_mutex );
+	return "remapped grid, " + GridRemapper::getMethodName( remapper.getMethod() );
+}
+
 void GridsManager::readDEM(DEMObject& grid2D)
 {
+	MIO_TRACE_ZONE("MeteoIO", "readDEM");
 	//TODO: dem_altimeter; reading DEM data with no associated date (ie Date()) OR with associated date (for example, TLS data)
-	if (processing_level == IOUtils::raw){
-		iohandler.readDEM(grid2D);
-	} else {
-		if (!buffer.get(grid2D, "/:DEM")) {
+	bool buffered;
+	{
+		const SharedLock lock( buffers_mutex );
+		buffered = (processing_level != IOUtils::raw && buffer.get(grid2D, "/:DEM"));
+	}
+
+	if (!buffered) {
+		const ExclusiveLock lock( buffers_mutex );
+		if (processing_level == IOUtils::raw){
 			iohandler.readDEM(grid2D);
-			buffer.push(grid2D, "/:DEM");
+		} else {
+			if (!buffer.get(grid2D, "/:DEM")) {
+				iohandler.readDEM(grid2D);
+				buffer.push(grid2D, "/:DEM");
+			}
 		}
 	}
 
@@ -111,6 +183,12 @@ void GridsManager::readDEM(DEMObject& grid2D)
 
 void GridsManager::readLanduse(Grid2DObject& grid2D)
 {
+	{
+		const SharedLock lock( buffers_mutex );
+		if (processing_level != IOUtils::raw && buffer.get(grid2D, "/:LANDUSE")) return;
+	}
+
+	const ExclusiveLock lock( buffers_mutex );
 	if (processing_level == IOUtils::raw){
 		iohandler.readLanduse(grid2D);
 	} else {
@@ -118,12 +196,18 @@ void GridsManager::readLanduse(Grid2DObject& grid2D)
 			return;
 
 		iohandler.readLanduse(grid2D);
-		buffer.push(grid2D, "/:LANDUSE");
+		buffer.pushAndGet(grid2D, "/:LANDUSE");
 	}
 }
 
 void GridsManager::readGlacier(Grid2DObject& grid2D)
 {
+	{
+		const SharedLock lock( buffers_mutex );
+		if (processing_level != IOUtils::raw && buffer.get(grid2D, "/:GLACIER")) return;
+	}
+
+	const ExclusiveLock lock( buffers_mutex );
 	if (processing_level == IOUtils::raw){
 		iohandler.readGlacier(grid2D);
 	} else {
@@ -131,21 +215,27 @@ void GridsManager::readGlacier(Grid2DObject& grid2D)
 			return;
 
 		iohandler.readGlacier(grid2D);
-		buffer.push(grid2D, "/:GLACIER");
+		buffer.pushAndGet(grid2D, "/:GLACIER");
 	}
 }
 
 void GridsManager::readAssimilationData(const Date& date, Grid2DObject& grid2D)
 {
+	const string grid_hash = "/:ASSIMILATIONDATA"+date.toString(Date::ISO);
+	{
+		const SharedLock lock( buffers_mutex );
+		if (processing_level != IOUtils::raw && buffer.get(grid2D, grid_hash)) return;
+	}
+
+	const ExclusiveLock lock( buffers_mutex );
 	if (processing_level == IOUtils::raw){
 		iohandler.readAssimilationData(date, grid2D);
 	} else {
-		const string grid_hash = "/:ASSIMILATIONDATA"+date.toString(Date::ISO);
 		if (buffer.get(grid2D, grid_hash))
 			return;
 
 		iohandler.readAssimilationData(date, grid2D);
-		buffer.push(grid2D, grid_hash);
+		buffer.pushAndGet(grid2D, grid_hash);
 	}
 }
 
@@ -282,6 +372,15 @@ std::vector<StationData> GridsManager::initVirtualStations(const DEMObject& dem,
 * @return a vector of meteodata for the configured virtual stations at the provided date, for the provided parameters
 */
 METEO_SET GridsManager::getVirtualStationsFromGrid(const DEMObject& dem, const std::vector<size_t>& v_params, const std::vector<StationData>& v_stations, const Date& date, const bool& PtsExtract)
+{
+	const ExclusiveLock lock( buffers_mutex );
+	return extractVirtualStations(dem, v_params, v_stations, date, PtsExtract);
+}
+
+/**
+* @brief Extract the virtual stations from the grids at a given date, without locking the buffers
+*/
+METEO_SET GridsManager::extractVirtualStations(const DEMObject& dem, const std::vector<size_t>& v_params, const std::vector<StationData>& v_stations, const Date& date, const bool& PtsExtract)
 {
 	//HACK handle extra parameters when possible
 	const size_t nrStations = v_stations.size();
@@ -341,6 +440,7 @@ std::vector<METEO_SET> GridsManager::getVirtualStationsFromGrid(const DEMObject&
 	const size_t nrStations = v_stations.size();
 	std::vector<METEO_SET> vecvecMeteo( nrStations );
 
+	const ExclusiveLock lock( buffers_mutex );
 	const bool status = setGrids2d_list(dateStart, dateEnd);
 	if (!status)
 		throw InvalidArgumentException("The chosen plugin seems not to support the list2DGrids call that is required for gridded data extraction", AT);
@@ -355,7 +455,7 @@ std::vector<METEO_SET> GridsManager::getVirtualStationsFromGrid(const DEMObject&
 
 	//now, we read the data for each available timestep
 	for (; it!=grids2d_list.end(); ++it) {
-		const METEO_SET vecMeteo( getVirtualStationsFromGrid(dem, v_params, v_stations, it->first, PtsExtract) ); //the number of stations can not change
+		const METEO_SET vecMeteo( extractVirtualStations(dem, v_params, v_stations, it->first, PtsExtract) ); //the number of stations can not change
 		for (size_t ii=0; ii<nrStations; ii++)
 			vecvecMeteo[ii].push_back( vecMeteo[ii] );
 
@@ -443,7 +543,7 @@ Grid2DObject GridsManager::getRawGrid(const MeteoGrids::Parameters& parameter, c
 	Grid2DObject grid2D;
 	if (!buffer.get(grid2D, parameter, date)) {
 		iohandler.read2DGrid(grid2D, parameter, date);
-		buffer.push(grid2D, parameter, date);
+		buffer.pushAndGet(grid2D, parameter, date);
 	}
 
 	return grid2D;
@@ -460,6 +560,7 @@ Grid2DObject GridsManager::getRawGrid(const MeteoGrids::Parameters& parameter, c
 */
 Grid2DObject GridsManager::getGrid(const MeteoGrids::Parameters& parameter, const Date& date, const bool& enforce_cartesian)
 {
+	MIO_TRACE_ZONE("MeteoIO", "getGrid");
 	Grid2DObject grid2D;
 
 	if (processing_level == IOUtils::raw){
@@ -469,13 +570,13 @@ Grid2DObject GridsManager::getGrid(const MeteoGrids::Parameters& parameter, cons
 			const bool status = setGrids2d_list( date ); //rebuffer the grid list if necessary
 			if (!status) { //this means that the list2DGrids call is not implemeted in the plugin, we try to save the day...
 				iohandler.read2DGrid(grid2D, parameter, date);
-				buffer.push(grid2D, parameter, date);
+				buffer.pushAndGet(grid2D, parameter, date);
 			} else { //the list2DGrids call is implemented in the plugin
 				const std::map<Date, std::set<size_t> >::const_iterator it = grids2d_list.find(date);
 				if (it!=grids2d_list.end()) {
 					if ( it->second.find(parameter) != it->second.end() ) {
 						iohandler.read2DGrid(grid2D, parameter, date);
-						buffer.push(grid2D, parameter, date);
+						buffer.pushAndGet(grid2D, parameter, date);
 					} else { //the right parameter could not be found, can we generate it?
 						if (!generateGrid(grid2D, it->second, parameter, date))
 							throw NoDataException("Could not find or generate a grid of "+MeteoGrids::getParameterName( parameter )+" at time "+date.toString(Date::ISO), AT);
@@ -534,7 +635,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const double K = pow(grid2D(ii)/p_sea(ii), k_inv); //because grid2D has been initialized with P
 			grid2D(ii) = ta(ii)*Cst::earth_R0*(1.-K) / (Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 - ta(ii)*(1.-K));
 		}
-		buffer.push(grid2D, parameter, date);
+		buffer.pushAndGet(grid2D, parameter, date);
 		return true;
 	}
 
@@ -555,7 +656,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 				grid2D(ii) = IOUtils::UV_TO_DW(U(ii), V(ii)); // turn into degrees [0;360)
 		}
 
-		buffer.push(grid2D, parameter, date);
+		buffer.pushAndGet(grid2D, parameter, date);
 		return true;
 	}
 
@@ -593,7 +694,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject iswr_diff( getRawGrid(MeteoGrids::ISWR_DIFF, date) );
 			grid2D = getRawGrid(MeteoGrids::ISWR_DIR, date);
 			grid2D += iswr_diff;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::ISWR, date);
 			return true;
 		}
 
@@ -603,7 +704,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject alb( getRawGrid(MeteoGrids::ALB, date) );
 			grid2D = getRawGrid(MeteoGrids::RSWR, date);
 			grid2D /= alb;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::ISWR, date);
 			return true;
 		}
 
@@ -623,7 +724,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject iswr_diff( getRawGrid(MeteoGrids::ISWR_DIFF, date) );
 			grid2D = getRawGrid(MeteoGrids::ISWR_DIR, date);
 			grid2D += iswr_diff;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::ISWR, date);
 		} else {
 			grid2D = getRawGrid(MeteoGrids::ISWR, date);
 		}
@@ -631,7 +732,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 		const Grid2DObject alb( getRawGrid(MeteoGrids::ALB, date) );
 
 		grid2D *= alb;
-		buffer.push(grid2D, MeteoGrids::RSWR, date);
+		buffer.pushAndGet(grid2D, MeteoGrids::RSWR, date);
 		return true;
 	}
 
@@ -643,7 +744,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject lwr_net( getRawGrid(MeteoGrids::LWR_NET, date) );
 			grid2D = getRawGrid(MeteoGrids::OLWR, date);
 			grid2D += lwr_net;
-			buffer.push(grid2D, MeteoGrids::ILWR, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::ILWR, date);
 			return true;
 		}
 	}
@@ -657,7 +758,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			grid2D = getRawGrid(MeteoGrids::SWE, date);
 			grid2D *= 1000.0; //convert mm=kg/m^3 into kg
 			grid2D /= rsno;
-			buffer.push(grid2D, MeteoGrids::HS, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::HS, date);
 			return true;
 		}
 		return false;
@@ -674,7 +775,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			grid2D = getRawGrid(MeteoGrids::PSUM_S, date);
 			grid2D += psum_l;
 			grid2D += psum_lc;
-			buffer.push(grid2D, MeteoGrids::PSUM, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::PSUM, date);
 			return true;
 		}
 
@@ -682,7 +783,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject psum_l( getRawGrid(MeteoGrids::PSUM_L, date) );
 			grid2D = getRawGrid(MeteoGrids::PSUM_S, date);
 			grid2D += psum_l;
-			buffer.push(grid2D, MeteoGrids::PSUM, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::PSUM, date);
 			return true;
 		}
 	}
@@ -695,7 +796,7 @@ bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& av
 			const Grid2DObject psum_l( getRawGrid(MeteoGrids::PSUM_L, date) );
 			grid2D = getRawGrid(MeteoGrids::PSUM_S, date);
 			grid2D += psum_l;
-			buffer.push(grid2D, MeteoGrids::PSUM, date);
+			buffer.pushAndGet(grid2D, MeteoGrids::PSUM, date);
 
 			for (size_t ii=0; ii<grid2D.size(); ii++) {
 				const double psum = grid2D(ii);
@@ -996,6 +1097,7 @@ bool GridsManager::getPtsfromgenerateGrid(std::vector<double>& Vec, const std::s
 
 
 const std::string GridsManager::toString() const {
+	const SharedLock lock( buffers_mutex );
 	ostringstream os;
 	os << "<GridsManager>\n";
 	os << "Config& cfg = " << hex << &cfg << dec << "\n";
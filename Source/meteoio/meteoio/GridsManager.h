@@ -21,21 +21,38 @@
 
 #include <meteoio/dataClasses/Buffer.h>
 #include <meteoio/dataClasses/MeteoData.h>
+#include <meteoio/meteoStats/GridRemapper.h>
 #include <meteoio/IOHandler.h>
 #include <meteoio/Config.h>
+#include <meteoio/SharedMutex.h>
 
 #include <set>
 #include <map>
 
 namespace mio {
 
+/**
+ * @class GridsManager
+ * @brief Buffered access to the gridded data
+ * @details The grids buffer is protected by a readers / writer lock, so grids that have already been buffered are returned
+ * concurrently while reading, generating or remapping grids is done by one thread at a time (see @ref concurrency).
+ */
 class GridsManager {
 	public:
 		GridsManager(IOHandler& in_iohandler, const Config& in_cfg);
 
+		/**
+		 * @brief Copy constructor
+		 * @details The copy gets its own lock, the source must not be used by other threads while it is being copied.
+		 * @param[in] source GridsManager to copy
+		 */
+		GridsManager(const GridsManager& source);
+
 		//Legacy support to support functionality of the IOInterface superclass:
 		void read2DGrid(Grid2DObject& grid_out, const std::string& option="");
 		void read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date);
+		void remap2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date, const DEMObject& dem);
+		std::string getRemapInfo() const;
 
 		//HACK buffer 3D grids!
 		void read3DGrid(Grid3DObject& grid_out, const std::string& i_filename="") {iohandler.read3DGrid(grid_out, i_filename);}
@@ -53,7 +70,7 @@ class GridsManager {
 		//end legacy support
 
 		void setProcessingLevel(const unsigned int& i_level);
-		void clear_cache() {buffer.clear();}
+		void clear_cache();
 
 		/**
 		 * @brief Returns a copy of the internal Config object.
@@ -77,6 +94,7 @@ class GridsManager {
 		const std::string toString() const;
 
 	private:
+		METEO_SET extractVirtualStations(const DEMObject& dem, const std::vector<size_t>& v_params, const std::vector<StationData>& v_stations, const Date& date, const bool& PtsExtract);
 		bool isAvailable(const std::set<size_t>& available_params, const MeteoGrids::Parameters& parameter, const Date& date) const;
 		bool setGrids2d_list(const Date& date);
 		bool setGrids2d_list(const Date& dateStart, const Date& dateEnd);
@@ -89,12 +107,15 @@ class GridsManager {
 		IOHandler& iohandler;
 		const Config& cfg;
 		GridBuffer buffer;
+		GridRemapper remapper; ///< to remap the grids onto the DEM (see IOUtils::GRID_REMAP)
 		std::map<Date, std::set<size_t> > grids2d_list; ///< list of available 2d grids
 		Date grids2d_start, grids2d_end; ///< validity range of the grids2d_list
 
 		double grid2d_list_buffer_size; ///< how many days to read the list of grids2d for?
 		unsigned int processing_level;
 		bool dem_altimeter; ///< use the pressure to compute the elevation?
+
+		mutable SharedMutex buffers_mutex; ///< protects the grids buffer, the grids list and the remapper
 };
 } //end namespace
 #endif
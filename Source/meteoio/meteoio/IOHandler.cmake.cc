@@ -265,43 +265,55 @@ IOInterface* IOHandler::getPlugin(std::string plugin_name, const Config& i_cfg)
  * for the inputs and outputs will lead to different instances being cached.
  * @param[in] cfgkey Configuration key giving the plugin name (example: METEO);
  * @param[in] cfgsection Section where to find this configuration key (example: INPUT);
+ * @param[out] plugin_lock lock on the plugin, the plugin must only be used while it is held
  * @param[in] sec_rename New section name if the section should be renamed before being passed to the plugin's constructor
  * (default: empty string, so no renaming)
  * @return Pointer to the constructed plugin
  *
  */
-IOInterface* IOHandler::getPlugin(const std::string& cfgkey, const std::string& cfgsection, const std::string& sec_rename)
+IOInterface* IOHandler::getPlugin(const std::string& cfgkey, const std::string& cfgsection, std::unique_lock<std::mutex>& plugin_lock, const std::string& sec_rename)
 {
 	const std::string op_src = cfg.get(cfgkey, cfgsection);
 	const std::string plugin_key( cfgsection+"::"+cfgkey+"::"+op_src ); //otherwise, reading meteo+grids with the same plugin would rely on the same object
 
-	if (mapPlugins.find(plugin_key) == mapPlugins.end()) { //the plugin has not already been constructed
-		IOInterface *ioPtr = nullptr;
+	IOInterface *ioPtr = nullptr;
+	std::shared_ptr<std::mutex> ioLock;
+	{
+		const std::lock_guard<std::mutex> lock( *plugins_mutex );
+		if (mapPlugins.find(plugin_key) == mapPlugins.end()) { //the plugin has not already been constructed
+			if (sec_rename.empty() || sec_rename==cfgsection) {
+				ioPtr = getPlugin(op_src, cfg);
+			} else {
+				Config cfg2( cfg );
+				cfg2.moveSection(cfgsection, sec_rename, true);
+				ioPtr = getPlugin(op_src, cfg2);
+			}
+
+			if (ioPtr==nullptr)
+				throw IOException("Cannot find plugin " + op_src + " as requested in file " + cfg.getSourceName() + ". Has it been activated through ccmake? Is it declared in IOHandler::getPlugin?", AT);
 
-		if (sec_rename.empty() || sec_rename==cfgsection) {
-			ioPtr = getPlugin(op_src, cfg);
-		} else {
-			Config cfg2( cfg );
-			cfg2.moveSection(cfgsection, sec_rename, true);
-			ioPtr = getPlugin(op_src, cfg2);
+			mapPlugins[plugin_key] = ioPtr;
+			mapPluginsLocks[plugin_key] = std::make_shared<std::mutex>();
 		}
 
-		if (ioPtr==nullptr)
-			throw IOException("Cannot find plugin " + op_src + " as requested in file " + cfg.getSourceName() + ". Has it been activated through ccmake? Is it declared in IOHandler::getPlugin?", AT);
-		else
-			mapPlugins[plugin_key] = ioPtr;
+		ioPtr = mapPlugins[plugin_key];
+		ioLock = mapPluginsLocks[plugin_key];
 	}
 
-	return mapPlugins[plugin_key];
+	//the plugins are not expected to be thread-safe, so the caller keeps the plugin locked until it is done with it
+	plugin_lock = std::unique_lock<std::mutex>( *ioLock );
+	return ioPtr;
 }
 
 //Copy constructor
 IOHandler::IOHandler(const IOHandler& aio)
-           : IOInterface(), cfg(aio.cfg), preProcessor(aio.cfg), mapPlugins(aio.mapPlugins)
+           : IOInterface(), cfg(aio.cfg), preProcessor(aio.cfg), mapPlugins(aio.mapPlugins), mapPluginsLocks(aio.mapPluginsLocks),
+             plugins_mutex(aio.plugins_mutex), editing_mutex()
 {}
 
 IOHandler::IOHandler(const Config& cfgreader)
-           : IOInterface(), cfg(cfgreader), preProcessor(cfgreader), mapPlugins()
+           : IOInterface(), cfg(cfgreader), preProcessor(cfgreader), mapPlugins(), mapPluginsLocks(),
+             plugins_mutex(std::make_shared<std::mutex>()), editing_mutex()
 {}
 
 IOHandler::~IOHandler() noexcept
@@ -317,6 +329,8 @@ IOHandler& IOHandler::operator=(const IOHandler& source) {
 	if (this != &source) {
 		preProcessor = source.preProcessor;
 		mapPlugins = source.mapPlugins;
+		mapPluginsLocks = source.mapPluginsLocks;
+		plugins_mutex = source.plugins_mutex;
 	}
 	return *this;
 }
@@ -338,56 +352,66 @@ std::vector<std::string> IOHandler::getListOfSources(const std::string& plugin_k
 
 bool IOHandler::list2DGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> > &list)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Input", plugin_lock);
 	return plugin->list2DGrids(start, end, list);
 }
 
 void IOHandler::read2DGrid(Grid2DObject& grid_out, const std::string& i_filename)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Input", plugin_lock);
 	plugin->read2DGrid(grid_out, i_filename);
 }
 
 void IOHandler::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Input", plugin_lock);
 	plugin->read2DGrid(grid_out, parameter, date);
 }
 
 void IOHandler::readPointsIn2DGrid(std::vector<double>& data, const MeteoGrids::Parameters& parameter, const Date& date, const std::vector< std::pair<size_t, size_t> >& Pts)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Input", plugin_lock);
 	plugin->readPointsIn2DGrid(data, parameter, date, Pts);
 }
 
 void IOHandler::read3DGrid(Grid3DObject& grid_out, const std::string& i_filename)
 {
-	IOInterface *plugin = getPlugin("GRID3D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID3D", "Input", plugin_lock);
 	plugin->read3DGrid(grid_out, i_filename);
 }
 
 void IOHandler::read3DGrid(Grid3DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	IOInterface *plugin = getPlugin("GRID3D", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID3D", "Input", plugin_lock);
 	plugin->read3DGrid(grid_out, parameter, date);
 }
 
 void IOHandler::readDEM(DEMObject& dem_out)
 {
-	IOInterface *plugin = getPlugin("DEM", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("DEM", "Input", plugin_lock);
 	plugin->readDEM(dem_out);
+	plugin_lock.unlock();
 	dem_out.update();
 }
 
 void IOHandler::readLanduse(Grid2DObject& landuse_out)
 {
-	IOInterface *plugin = getPlugin("LANDUSE", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("LANDUSE", "Input", plugin_lock);
 	plugin->readLanduse(landuse_out);
 }
 
 void IOHandler::readGlacier(Grid2DObject& glacier_out)
 {
-	IOInterface *plugin = getPlugin("GLACIER", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GLACIER", "Input", plugin_lock);
 	plugin->readGlacier(glacier_out);
 }
 
@@ -397,7 +421,8 @@ void IOHandler::readStationData(const Date& date, STATIONS_SET& vecStation)
 	if (sources.empty()) throw UnknownValueException("No plugin defined for METEO", AT);;
 
 	for (size_t ii=0; ii<sources.size(); ii++) {
-		IOInterface *plugin = getPlugin("METEO", sources[ii], "INPUT");
+		std::unique_lock<std::mutex> plugin_lock;
+		IOInterface *plugin = getPlugin("METEO", sources[ii], plugin_lock, "INPUT");
 
 		if (ii==0) {
 			plugin->readStationData(date, vecStation);
@@ -408,6 +433,7 @@ void IOHandler::readStationData(const Date& date, STATIONS_SET& vecStation)
 		}
 	}
 	
+	const std::lock_guard<std::mutex> lock( editing_mutex );
 	preProcessor.editTimeSeries( vecStation );
 }
 
@@ -419,10 +445,14 @@ void IOHandler::readMeteoData(const Date& dateStart, const Date& dateEnd,
 
 	//some time filters change the requested dates (for example, time loop)
 	Date fakeStart( dateStart ),fakeEnd( dateEnd );
-	preProcessor.timeproc.process(fakeStart, fakeEnd);
+	{
+		const std::lock_guard<std::mutex> lock( editing_mutex );
+		preProcessor.timeproc.process(fakeStart, fakeEnd);
+	}
 
 	for (size_t ii=0; ii<sources.size(); ii++) {
-		IOInterface *plugin = getPlugin("METEO", sources[ii], "INPUT");
+		std::unique_lock<std::mutex> plugin_lock;
+		IOInterface *plugin = getPlugin("METEO", sources[ii], plugin_lock, "INPUT");
 
 		if (ii==0) {
 			plugin->readMeteoData(fakeStart, fakeEnd, vecMeteo);
@@ -433,48 +463,56 @@ void IOHandler::readMeteoData(const Date& dateStart, const Date& dateEnd,
 		}
 	}
 
+	const std::lock_guard<std::mutex> lock( editing_mutex );
 	preProcessor.editTimeSeries( vecMeteo );
 }
 
 void IOHandler::writeMeteoData(const std::vector<METEO_SET>& vecMeteo,
                                const std::string& name)
 {
-	IOInterface *plugin = getPlugin("METEO", "Output");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("METEO", "Output", plugin_lock);
 	plugin->writeMeteoData(vecMeteo, name);
 }
 
 void IOHandler::readAssimilationData(const Date& date_in, Grid2DObject& da_out)
 {
-	IOInterface *plugin = getPlugin("DA", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("DA", "Input", plugin_lock);
 	plugin->readAssimilationData(date_in, da_out);
 }
 
 void IOHandler::readPOI(std::vector<Coords>& pts) {
-	IOInterface *plugin = getPlugin("POI", "Input");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("POI", "Input", plugin_lock);
 	plugin->readPOI(pts);
 }
 
 void IOHandler::write2DGrid(const Grid2DObject& grid_in, const std::string& name)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Output");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Output", plugin_lock);
 	plugin->write2DGrid(grid_in, name);
 }
 
 void IOHandler::write2DGrid(const Grid2DObject& grid_in, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	IOInterface *plugin = getPlugin("GRID2D", "Output");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID2D", "Output", plugin_lock);
 	plugin->write2DGrid(grid_in, parameter, date);
 }
 
 void IOHandler::write3DGrid(const Grid3DObject& grid_out, const std::string& options)
 {
-	IOInterface *plugin = getPlugin("GRID3D", "Output");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID3D", "Output", plugin_lock);
 	plugin->write3DGrid(grid_out, options);
 }
 
 void IOHandler::write3DGrid(const Grid3DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	IOInterface *plugin = getPlugin("GRID3D", "Output");
+	std::unique_lock<std::mutex> plugin_lock;
+	IOInterface *plugin = getPlugin("GRID3D", "Output", plugin_lock);
 	plugin->write3DGrid(grid_out, parameter, date);
 }
 
@@ -485,6 +523,7 @@ const std::string IOHandler::toString() const
 	os << "Config& cfg = " << hex << &cfg << dec << "\n";
 
 	os << "<mapPlugins>\n";
+	const std::lock_guard<std::mutex> lock( *plugins_mutex );
 	std::map<std::string, IOInterface*>::const_iterator it1;
 	for (it1=mapPlugins.begin(); it1 != mapPlugins.end(); ++it1) {
 		os << setw(10) << it1->first << " = " << hex <<  it1->second << dec << "\n";
@@ -23,6 +23,8 @@
 #include <meteoio/DataEditing.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -33,6 +35,7 @@ namespace mio {
 * @class IOHandler
 * @brief This class is the class to use for raw I/O operations. It is responsible for transparently loading the plugins
 * and it follows the interface defined by the IOInterface class with the addition of a few convenience methods.
+* The calls made to each plugin instance are serialized, so the plugins don't have to be thread-safe (see @ref concurrency).
 */
 class IOHandler : public IOInterface {
 	public:
@@ -74,12 +77,15 @@ class IOHandler : public IOInterface {
 
 	private:
 		IOInterface* getPlugin(std::string plugin_name, const Config& i_cfg) const;
-		IOInterface* getPlugin(const std::string& cfgkey, const std::string& cfgsection, const std::string& sec_rename="");
+		IOInterface* getPlugin(const std::string& cfgkey, const std::string& cfgsection, std::unique_lock<std::mutex>& plugin_lock, const std::string& sec_rename="");
 		std::vector<std::string> getListOfSources(const std::string& plugin_key, const std::string& sec_pattern) const;
 
 		const Config& cfg;
 		DataEditing preProcessor;
 		std::map<std::string, IOInterface*> mapPlugins;
+		std::map<std::string, std::shared_ptr<std::mutex> > mapPluginsLocks; ///< one lock per plugin instance, shared with the copies
+		std::shared_ptr<std::mutex> plugins_mutex; ///< protects the plugins maps
+		std::mutex editing_mutex; ///< protects the preProcessor
 };
 
 } //namespace
@@ -181,6 +181,39 @@ namespace mio {
  * @endcode
  * @note The resampled grids won't be provided by the read2DGrid() call but by the getMeteoData() call since they are considered as spatial interpolations.
  * 
+ * @section grids_remap Remapping of gridded data
+ * When the forcing grids are already at a suitable resolution but do not share the DEM's geolocalization (for example lat/lon NWP outputs
+ * or grids in another projection), they can be directly remapped onto the DEM by setting REGRIDDING_STRATEGY to *GRID_REMAP*. The remapping
+ * operator is computed only once for each pair of source grid and DEM and then applied to all parameters and timesteps (see GridRemapper).
+ * The following keys control the remapping (in the [InputEditing] section):
+ *    + REGRIDDING_STRATEGY set to *GRID_REMAP*;
+ *    + REMAP_METHOD: either NEAREST, BILINEAR or CONSERVATIVE (optional, default: BILINEAR);
+ *    + REMAP_CACHE: an existing directory where to keep the remapping operators between runs (optional).
+ *
+ * @code
+ * [Input]
+ * DEM     = ARC
+ * DEMFILE = ./input/grids/davos.asc
+ * 
+ * GRID2D    = NETCDF
+ * GRID2DFILE = ./input/grids/era-interim.nc
+ * NETCDF_SCHEMA = ECMWF
+ * 
+ * [InputEditing]
+ * REGRIDDING_STRATEGY = GRID_REMAP
+ * REMAP_METHOD = CONSERVATIVE
+ * REMAP_CACHE = ./cache
+ * @endcode
+ * @note As for GRID_RESAMPLE, the remapped grids are provided by the getMeteoData() call. The time series are read as usual.
+ * 
+ * @section grids_buffering Buffering of gridded data
+ * The last grids that have been read are kept in memory (key BUFF_GRIDS in the [General] section, default: 10) as well as the last
+ * spatially interpolated grids (key BUFF_GRIDS in the [Interpolations2D] section, default: 10). For large domains, these buffers can
+ * be stored in a compact form by setting BUFF_GRIDS_COMPACT to true in the relevant section: the values are then kept as float32 with
+ * a validity mask (see CompactGrid2D), halving the memory footprint at the cost of rounding the buffered grids to about 7 significant digits.
+ * All the grids that go through such a buffer are returned rounded, including the first time they are read or interpolated, so the
+ * results do not depend on whether a grid was found in the buffer or not.
+ * 
  */
 
 IOUtils::OperationMode IOManager::getIOManagerTSMode(const Config& i_cfg)
@@ -217,6 +250,8 @@ IOUtils::OperationMode IOManager::getIOManagerGridMode(const Config& i_cfg)
 		return IOUtils::GRID_RESAMPLE;
 	if (regridding_strategy_str=="GRID_1DINTERPOLATE")
 		return IOUtils::GRID_1DINTERPOLATE;
+	if (regridding_strategy_str=="GRID_REMAP")
+		return IOUtils::GRID_REMAP;
 	
 	throw InvalidArgumentException("The selected regridding_strategy is not supported", AT);
 }
@@ -224,22 +259,31 @@ IOUtils::OperationMode IOManager::getIOManagerGridMode(const Config& i_cfg)
 //TODO write an IOHandler that can directly tap into the buffers of a tsm or gdm
 IOManager::IOManager(const std::string& filename_in) : cfg(filename_in), ts_mode(getIOManagerTSMode(cfg)), iohandler(cfg),
                                                        tsm1(iohandler, cfg, 1, ts_mode), tsm2(iohandler, cfg, 2), gdm1(iohandler, cfg), interpolator(cfg, tsm1, gdm1), source_dem(),
-                                                       v_params(), grids_params(), v_stations(), v_gridstations(), vstations_refresh_rate(3600), vstations_refresh_offset(0)
+                                                       v_params(), grids_params(), v_stations(), v_gridstations(), vstations_refresh_rate(3600), vstations_refresh_offset(0),
+                                                       manager_mutex()
 {
 	initIOManager();
 }
 
 IOManager::IOManager(const Config& i_cfg) : cfg(i_cfg), ts_mode(getIOManagerTSMode(cfg)), iohandler(cfg),
                                             tsm1(iohandler, cfg, 1, ts_mode), tsm2(iohandler, cfg, 2), gdm1(iohandler, cfg), interpolator(cfg, tsm1, gdm1), source_dem(),
-                                            v_params(), grids_params(), v_stations(), v_gridstations(), vstations_refresh_rate(3600), vstations_refresh_offset(0)
+                                            v_params(), grids_params(), v_stations(), v_gridstations(), vstations_refresh_rate(3600), vstations_refresh_offset(0),
+                                            manager_mutex()
 {
 	initIOManager();
 }
 
+IOManager::IOManager(const IOManager& source) : cfg(source.cfg), ts_mode(source.ts_mode), iohandler(source.iohandler),
+                                            tsm1(source.tsm1), tsm2(source.tsm2), gdm1(source.gdm1), interpolator(source.interpolator), source_dem(source.source_dem),
+                                            v_params(source.v_params), grids_params(source.grids_params), v_stations(source.v_stations), v_gridstations(source.v_gridstations),
+                                            vstations_refresh_rate(source.vstations_refresh_rate), vstations_refresh_offset(source.vstations_refresh_offset),
+                                            manager_mutex()
+{}
+
 void IOManager::initIOManager()
 {
 	//TODO support extra parameters by getting the param index from vecTrueMeteo[0]
-	if (ts_mode>=IOUtils::GRID_EXTRACT) {
+	if (ts_mode>=IOUtils::GRID_EXTRACT && ts_mode!=IOUtils::GRID_REMAP) {
 		std::vector<std::string> vecStr;
 		cfg.getValue("Virtual_parameters", "InputEditing", vecStr);
 		for (size_t ii=0; ii<vecStr.size(); ii++) {
@@ -262,7 +306,7 @@ void IOManager::initIOManager()
 		tsm2.setProcessingLevel(IOUtils::resampled | IOUtils::generated); //in this case, we do not want to re-apply the filters (or force filter pass=2 on tsm2?)
 	}
 	
-	if (ts_mode!=IOUtils::STD) initVirtualStations();
+	if (ts_mode!=IOUtils::STD && ts_mode!=IOUtils::GRID_REMAP) initVirtualStations(); //GRID_REMAP only works on grids
 }
 
 void IOManager::initVirtualStations()
@@ -309,8 +353,9 @@ size_t IOManager::getStationData(const Date& date, STATIONS_SET& vecStation)
 {
 	vecStation.clear();
 
-	if (ts_mode==IOUtils::STD) return tsm1.getStationData(date, vecStation);
+	if (ts_mode==IOUtils::STD || ts_mode==IOUtils::GRID_REMAP) return tsm1.getStationData(date, vecStation);
 	
+	const std::lock_guard<std::mutex> lock( manager_mutex );
 	if (ts_mode==IOUtils::VSTATIONS || ts_mode==IOUtils::GRID_SMART) {
 		if (v_stations.empty()) initVirtualStations();
 		vecStation = v_stations;
@@ -325,8 +370,10 @@ size_t IOManager::getStationData(const Date& date, STATIONS_SET& vecStation)
 //TODO: smarter rebuffer! (ie partial)
 size_t IOManager::getMeteoData(const Date& dateStart, const Date& dateEnd, std::vector< METEO_SET >& vecVecMeteo) 
 {
-	if (ts_mode==IOUtils::STD) return tsm1.getMeteoData(dateStart, dateEnd, vecVecMeteo);
+	if (ts_mode==IOUtils::STD || ts_mode==IOUtils::GRID_REMAP) return tsm1.getMeteoData(dateStart, dateEnd, vecVecMeteo);
 	
+	//the other modes fill the buffers from each other, so they must not be interleaved
+	const std::lock_guard<std::mutex> lock( manager_mutex );
 	if (ts_mode>=IOUtils::GRID_EXTRACT && ts_mode!=IOUtils::GRID_SMART) {
 		const Date bufferStart( tsm1.getBufferStart( TimeSeriesManager::RAW ) );
 		const Date bufferEnd( tsm1.getBufferEnd(  TimeSeriesManager::RAW  ) );
@@ -369,10 +416,12 @@ size_t IOManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 {
 	vecMeteo.clear();
 
-	if (ts_mode==IOUtils::STD) {
+	if (ts_mode==IOUtils::STD || ts_mode==IOUtils::GRID_REMAP) {
 		return tsm1.getMeteoData(i_date, vecMeteo);
 	}
 	
+	//the other modes fill the buffers from each other, so they must not be interleaved
+	const std::lock_guard<std::mutex> lock( manager_mutex );
 	if (ts_mode>=IOUtils::GRID_EXTRACT && ts_mode!=IOUtils::GRID_SMART) {
 		const Date bufferStart( tsm1.getBufferStart( TimeSeriesManager::RAW ) );
 		const Date bufferEnd( tsm1.getBufferEnd( TimeSeriesManager::RAW ) );
@@ -456,6 +505,7 @@ bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const std::
 bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const MeteoData::Parameters& meteoparam,
                   Grid2DObject& result, std::string& info_string)
 {
+	const std::lock_guard<std::mutex> lock( manager_mutex ); //the interpolation algorithms are not thread-safe
 	if (ts_mode==IOUtils::GRID_RESAMPLE) { //fill tsm1's buffer
 		const Date bufferStart( tsm1.getBufferStart( TimeSeriesManager::RAW ) );
 		const Date bufferEnd( tsm1.getBufferEnd( TimeSeriesManager::RAW ) );
@@ -470,6 +520,13 @@ bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const Meteo
 		}
 	} else if (ts_mode==IOUtils::GRID_1DINTERPOLATE) { //temporally interpolate grid
 		throw IOException("Not implemented yet", AT);
+	} else if (ts_mode==IOUtils::GRID_REMAP) { //remap the matching grid onto the DEM
+		const size_t grid_param = MeteoGrids::getParameterIndex( MeteoData::getParameterName(meteoparam) );
+		if (grid_param==IOUtils::npos)
+			throw InvalidArgumentException("Parameter '" + MeteoData::getParameterName(meteoparam) + "' can not be remapped from grids", AT);
+		gdm1.remap2DGrid(result, static_cast<MeteoGrids::Parameters>(grid_param), date, dem);
+		info_string = gdm1.getRemapInfo();
+		return (!result.empty());
 	}
 
 	info_string = interpolator.interpolate(date, dem, meteoparam, result);
@@ -479,6 +536,7 @@ bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const Meteo
 bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const std::string& param_name,
                   Grid2DObject& result, std::string& info_string)
 {
+	const std::lock_guard<std::mutex> lock( manager_mutex ); //the interpolation algorithms are not thread-safe
 	if (ts_mode==IOUtils::GRID_RESAMPLE) { //fill tsm1's buffer
 		const Date bufferStart( tsm1.getBufferStart( TimeSeriesManager::RAW ) );
 		const Date bufferEnd( tsm1.getBufferEnd( TimeSeriesManager::RAW ) );
@@ -493,6 +551,13 @@ bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const std::
 		}
 	} else if (ts_mode==IOUtils::GRID_1DINTERPOLATE) { //temporally interpolate grid
 		throw IOException("Not implemented yet", AT);
+	} else if (ts_mode==IOUtils::GRID_REMAP) { //remap the matching grid onto the DEM
+		const size_t grid_param = MeteoGrids::getParameterIndex( param_name );
+		if (grid_param==IOUtils::npos)
+			throw InvalidArgumentException("Parameter '" + param_name + "' can not be remapped from grids", AT);
+		gdm1.remap2DGrid(result, static_cast<MeteoGrids::Parameters>(grid_param), date, dem);
+		info_string = gdm1.getRemapInfo();
+		return (!result.empty());
 	}
 
 	info_string = interpolator.interpolate(date, dem, param_name, result);
@@ -504,7 +569,8 @@ bool IOManager::getMeteoData(const Date& date, const DEMObject& dem, const std::
 void IOManager::interpolate(const Date& date, const DEMObject& dem, const MeteoData::Parameters& meteoparam,
                             const std::vector<Coords>& in_coords, std::vector<double>& result)
 {
-	const std::string info_string( interpolator.interpolate(date, dem, meteoparam, in_coords, result) );
+	std::string info_string;
+	interpolate(date, dem, meteoparam, in_coords, result, info_string);
 	cerr << "[i] Interpolating " << MeteoData::getParameterName(meteoparam);
 	cerr << " (" << info_string << ") " << endl;
 }
@@ -512,12 +578,14 @@ void IOManager::interpolate(const Date& date, const DEMObject& dem, const MeteoD
 void IOManager::interpolate(const Date& date, const DEMObject& dem, const MeteoData::Parameters& meteoparam,
                             const std::vector<Coords>& in_coords, std::vector<double>& result, std::string& info_string)
 {
+	const std::lock_guard<std::mutex> lock( manager_mutex ); //the interpolation algorithms are not thread-safe
 	info_string = interpolator.interpolate(date, dem, meteoparam, in_coords, result);
 }
 
 void IOManager::interpolate(const Date& date, const DEMObject& dem, const MeteoData::Parameters& meteoparam,
                             const std::vector<StationData>& in_stations, std::vector<double>& result, std::string& info_string)
 {
+	const std::lock_guard<std::mutex> lock( manager_mutex ); //the interpolation algorithms are not thread-safe
 	info_string = interpolator.interpolate(date, dem, meteoparam, in_stations, result);
 }
 
@@ -25,17 +25,33 @@
 #include <meteoio/TimeSeriesManager.h>
 #include <meteoio/GridsManager.h>
 
+#include <mutex>
+
 namespace mio {
 
 class TimeSeriesManager;
 class GridsManager;
 class Meteo2DInterpolator;
 
+/**
+ * @class IOManager
+ * @brief Main entry point to read, process and write data
+ * @details An IOManager can be used by several threads at the same time: the time series and grids that are already buffered are
+ * returned concurrently, while the spatial interpolations and the virtual stations are computed by one thread at a time
+ * (see @ref concurrency).
+ */
 class IOManager {
 	public:
 		IOManager(const std::string& filename_in);
 		IOManager(const Config& i_cfg);
 
+		/**
+		 * @brief Copy constructor
+		 * @details The copy gets its own locks, the source must not be used by other threads while it is being copied.
+		 * @param source IOManager to copy
+		 */
+		IOManager(const IOManager& source);
+
 		//Legacy support to support functionality of the IOInterface superclass:
 		void read2DGrid(Grid2DObject& grid_out, const std::string& options="") {gdm1.read2DGrid(grid_out, options);}
 		void read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date) {gdm1.read2DGrid(grid_out, parameter, date);}
@@ -252,6 +268,7 @@ class IOManager {
 		std::vector<size_t> v_params, grids_params; ///< Parameters for virtual stations
 		std::vector<StationData> v_stations, v_gridstations; ///< metadata for virtual stations
 		unsigned int vstations_refresh_rate, vstations_refresh_offset; ///< when using virtual stations, how often should the data be spatially re-interpolated? (in seconds)
+		std::mutex manager_mutex; ///< serializes the spatial interpolations and the virtual stations handling
 };
 } //end namespace
 #endif
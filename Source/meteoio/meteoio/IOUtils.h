@@ -68,7 +68,8 @@ namespace IOUtils {
 		GRID_SMART, ///< extract all relevant grid points from a provided grid
 		GRID_ALL, ///< extract all grid points from a provided grid
 		GRID_RESAMPLE, ///< generate a grid at a different resolution
-		GRID_1DINTERPOLATE  ///< temporally interpolate existing grids
+		GRID_1DINTERPOLATE, ///< temporally interpolate existing grids
+		GRID_REMAP ///< remap existing grids onto the DEM (see GridRemapper)
 	};
 
 	enum ThrowOptions { dothrow, nothrow };
@@ -77,6 +77,8 @@ namespace mio {
  *    -# \subpage quick_overview "Quick overview" of the functionnality provided by MeteoIO
  *    -# <A HREF="modules.html">Modules list</a>
  *    -# \subpage examples "Usage examples"
+ *    -# \subpage tracing "Timing instrumentation" of the processing chain
+ *    -# \subpage concurrency "Concurrent accesses" from several threads
  * -# Advanced: Expanding MeteoIO
  *    -# How to \subpage dev_coords "write a coordinate system support"
  *    -# How to \subpage dev_plugins "write a Plugin"
@@ -239,7 +241,8 @@ namespace mio {
  *
  * You first need to create the various sections:
  * - [General] : The documentation about this section is found in \ref Config. It currently contains 
- *               some buffering keys (see BufferedIOHandler).
+ *               some buffering keys (see BufferedIOHandler) and the persistent cache of the filtered
+ *               meteorological data (see TimeSeriesCache).
  *
  * - [Input] : This section contains the list of all the plugins that you want to use as well as their parameters. You can
  *             use one plugin for the meteorological data (key=METEO), one for grids (key=GRID2D), one for the Points Of Interest
@@ -18,6 +18,7 @@
 */
 #include <meteoio/Meteo1DInterpolator.h>
 #include <meteoio/dataClasses/StationData.h>
+#include <meteoio/Tracing.h>
 
 #include <iostream>
 #include <utility>
@@ -73,6 +74,7 @@ void Meteo1DInterpolator::getWindowSize(ProcessingProperties& o_properties) cons
 
 bool Meteo1DInterpolator::resampleData(const Date& date, const std::string& stationHash, const std::vector<MeteoData>& vecM, MeteoData& md)
 {
+	MIO_TRACE_ZONE("MeteoIO", "resampleData");
 	if (vecM.empty()) //Deal with case of the empty vector
 		return false; //nothing left to do
 
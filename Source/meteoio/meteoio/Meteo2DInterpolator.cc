@@ -19,6 +19,7 @@
 
 #include <meteoio/Meteo2DInterpolator.h>
 #include <meteoio/Timer.h>
+#include <meteoio/Tracing.h>
 
 using namespace std;
 
@@ -32,6 +33,9 @@ Meteo2DInterpolator::Meteo2DInterpolator(const Config& i_cfg, TimeSeriesManager&
 	size_t max_grids = 10; //default number of grids to keep in buffer
 	cfg.getValue("BUFF_GRIDS", "Interpolations2D", max_grids, IOUtils::nothrow);
 	grid_buffer.setMaxGrids(max_grids);
+	bool compact_grids = false; //keep the interpolated grids as float32
+	cfg.getValue("BUFF_GRIDS_COMPACT", "Interpolations2D", compact_grids, IOUtils::nothrow);
+	grid_buffer.setCompact(compact_grids);
 	
 	setAlgorithms();
 }
@@ -161,6 +165,7 @@ std::string Meteo2DInterpolator::interpolate(const Date& date, const DEMObject&
 std::string Meteo2DInterpolator::interpolate(const Date& date, const DEMObject& dem, const std::string& param_name,
                                       Grid2DObject& result, const bool& quiet)
 {
+	MIO_TRACE_ZONE("MeteoIO", "interpolate2D");
 	std::string InfoString;
 	if (!algorithms_ready) setAlgorithms();
 
@@ -192,7 +197,7 @@ std::string Meteo2DInterpolator::interpolate(const Date& date, const DEMObject&
 		if (quiet) {
 			std::cerr << "[E] " << msg << "\n";
 			result.set(dem, IOUtils::nodata);
-			grid_buffer.push(result, grid_hash.str(), msg); //HACK is it the proper way of doing this? Could we have a valid grid later on?
+			grid_buffer.pushAndGet(result, grid_hash.str(), msg); //HACK is it the proper way of doing this? Could we have a valid grid later on?
 			return msg;
 		} else throw IOException(msg, AT);
 	}
@@ -211,7 +216,7 @@ std::string Meteo2DInterpolator::interpolate(const Date& date, const DEMObject&
 	}
 
 	//save grid in buffer
-	grid_buffer.push(result, grid_hash.str(), InfoString);
+	grid_buffer.pushAndGet(result, grid_hash.str(), InfoString);
 	return InfoString;
 }
 
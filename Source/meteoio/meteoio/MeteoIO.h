@@ -36,6 +36,7 @@
 #include <meteoio/dataClasses/Array4D.h>
 #include <meteoio/dataClasses/CoordsAlgorithms.h>
 #include <meteoio/dataClasses/Coords.h>
+#include <meteoio/dataClasses/CompactGrid2D.h>
 #include <meteoio/dataClasses/Date.h>
 #include <meteoio/dataClasses/DEMObject.h>
 #include <meteoio/dataClasses/DEMAlgorithms.h>
@@ -54,10 +55,12 @@
 #include <meteoio/IOExceptions.h>
 #include <meteoio/IOHandler.h>
 #include <meteoio/IOInterface.h>
+#include <meteoio/TimeSeriesCache.h>
 #include <meteoio/TimeSeriesManager.h>
 #include <meteoio/GridsManager.h>
 #include <meteoio/IOManager.h>
 #include <meteoio/IOUtils.h>
+#include <meteoio/SharedMutex.h>
 //#include <meteoio/MainPage.h> //only for doxygen
 #include <meteoio/MathOptim.h>
 //#include <meteoio/MessageBoxX11.h>
@@ -79,10 +82,12 @@
 
 #include <meteoio/MeteoProcessor.h>
 //#include <meteoio/meteoStats/libfit1DCore.h>
+#include <meteoio/meteoStats/libexpression.h>
 #include <meteoio/meteoStats/libfit1D.h>
 #include <meteoio/meteoStats/libinterpol1D.h>
 #include <meteoio/meteoStats/libinterpol2D.h>
 #include <meteoio/meteoStats/libresampling2D.h>
+#include <meteoio/meteoStats/GridRemapper.h>
 #include <meteoio/meteoStats/RandomNumberGenerator.h>
 
 //skip all plugins' implementations header files
@@ -91,5 +96,6 @@
 
 #include <meteoio/meteoResampling/ResamplingAlgorithms.h>
 #include <meteoio/Timer.h>
+#include <meteoio/Tracing.h>
 
 #endif
@@ -18,6 +18,7 @@
 */
 #include <meteoio/MeteoProcessor.h>
 #include <meteoio/meteoFilters/TimeFilters.h>
+#include <meteoio/Tracing.h>
 #include <algorithm>
 
 using namespace std;
@@ -96,6 +97,7 @@ void MeteoProcessor::compareProperties(const ProcessingProperties& newprop, Proc
 void MeteoProcessor::process(std::vector< std::vector<MeteoData> >& ivec,
                              std::vector< std::vector<MeteoData> >& ovec, const bool& second_pass)
 {
+	MIO_TRACE_ZONE("MeteoIO", "filterMeteoData");
 	std::swap(ivec, ovec);
 	if (processing_stack.empty() || !enable_meteo_filtering) return;
 	
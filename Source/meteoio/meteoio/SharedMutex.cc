@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/SharedMutex.h>
+
+namespace mio {
+
+void SharedMutex::lock()
+{
+	std::unique_lock<std::mutex> lk(mtx);
+	nr_writers_waiting++;
+	while (writer || nr_readers>0) cond.wait(lk);
+	nr_writers_waiting--;
+	writer = true;
+}
+
+void SharedMutex::unlock()
+{
+	{
+		const std::lock_guard<std::mutex> lk(mtx);
+		writer = false;
+	}
+	cond.notify_all(); //wake up both the waiting readers and writers
+}
+
+void SharedMutex::lock_shared()
+{
+	std::unique_lock<std::mutex> lk(mtx);
+	while (writer || nr_writers_waiting>0) cond.wait(lk);
+	nr_readers++;
+}
+
+void SharedMutex::unlock_shared()
+{
+	bool last_reader = false;
+	{
+		const std::lock_guard<std::mutex> lk(mtx);
+		nr_readers--;
+		last_reader = (nr_readers==0);
+	}
+	if (last_reader) cond.notify_all();
+}
+
+} //end namespace mio
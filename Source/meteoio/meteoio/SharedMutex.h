@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHAREDMUTEX_H
+#define SHAREDMUTEX_H
+
+#include <condition_variable>
+#include <mutex>
+
+namespace mio {
+
+/**
+ * @page concurrency Concurrent accesses
+ * An IOManager (as well as a TimeSeriesManager, a GridsManager or an IOHandler) can be shared between several threads that
+ * read and write data at the same time. The following contract applies:
+ *    - reading data that is already buffered (meteo time series, resampled points, 2D grids, DEM, etc) only takes a
+ *      shared lock on the buffers, so concurrent readers don't wait on each other;
+ *    - when the buffers have to be filled (reading, filtering, resampling, generating, remapping) the buffers are locked
+ *      exclusively. Concurrent requests that need the same data therefore wait until the first one has filled the buffers
+ *      and then read the buffered data;
+ *    - the plugins don't need to be thread-safe: the IOHandler serializes the calls made to each plugin instance, but
+ *      different plugin instances are called concurrently (for example reading meteo data while writing grids);
+ *    - the spatial interpolations, the virtual stations and the other modes that combine several buffers are
+ *      serialized by the IOManager;
+ *    - the configuration methods (setProcessingLevel(), setMinBufferRequirements(), push_meteo_data(), clear_cache(),
+ *      etc) are safe to call at any time, but the data that is returned by the other threads then depends on when each
+ *      call happened. They should be called before starting the concurrent accesses.
+ *
+ * The locks are always taken in the same order (IOManager, then TimeSeriesManager or GridsManager, then IOHandler and
+ * finally the plugins), so nested calls can not deadlock. The objects can not be copied while they are used concurrently.
+ * Please note that the Config object itself is only read, so it must not be modified while it is used by an IOManager.
+ *
+ * The "concurrency" test exercises these code paths with several threads and compares the results with a sequential run.
+ */
+
+/**
+ * @class SharedMutex
+ * @brief A readers / writer lock.
+ * @details Many threads can hold the lock in shared mode (lock_shared()) at the same time while only one thread can hold it
+ * in exclusive mode (lock()). Writers have priority: once a thread waits for the exclusive lock, new readers wait too, so
+ * writers can not be starved by a continuous flow of readers. The lock is not recursive and a shared lock can not be
+ * upgraded: it must be released before requesting the exclusive lock.
+ * It should be used through the SharedLock and ExclusiveLock guards.
+ */
+class SharedMutex {
+	public:
+		SharedMutex() : mtx(), cond(), nr_readers(0), nr_writers_waiting(0), writer(false) {}
+
+		void lock();
+		void unlock();
+		void lock_shared();
+		void unlock_shared();
+
+	private:
+		SharedMutex(const SharedMutex&);
+		SharedMutex& operator=(const SharedMutex&);
+
+		std::mutex mtx;
+		std::condition_variable cond;
+		size_t nr_readers, nr_writers_waiting;
+		bool writer;
+};
+
+/**
+ * @class SharedLock
+ * @brief Hold a SharedMutex in shared mode between its construction and its destruction.
+ */
+class SharedLock {
+	public:
+		explicit SharedLock(SharedMutex& i_mutex) : mutex(i_mutex) {mutex.lock_shared();}
+		~SharedLock() {mutex.unlock_shared();}
+
+	private:
+		SharedLock(const SharedLock&);
+		SharedLock& operator=(const SharedLock&);
+
+		SharedMutex& mutex;
+};
+
+/**
+ * @class ExclusiveLock
+ * @brief Hold a SharedMutex in exclusive mode between its construction and its destruction.
+ */
+class ExclusiveLock {
+	public:
+		explicit ExclusiveLock(SharedMutex& i_mutex) : mutex(i_mutex) {mutex.lock();}
+		~ExclusiveLock() {mutex.unlock();}
+
+	private:
+		ExclusiveLock(const ExclusiveLock&);
+		ExclusiveLock& operator=(const ExclusiveLock&);
+
+		SharedMutex& mutex;
+};
+
+} //end namespace mio
+
+#endif
@@ -0,0 +1,419 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <meteoio/TimeSeriesCache.h>
+#include <meteoio/FileUtils.h>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace mio {
+
+static const char cache_magic[] = "MeteoIO series cache 1";
+
+//binary helpers, the cache is only meant to be read back on the same platform
+template <typename T> static void writeValue(std::ostream& os, const T& value)
+{
+	os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> static bool readValue(std::istream& is, T& value)
+{
+	is.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return !is.fail();
+}
+
+static void writeString(std::ostream& os, const std::string& str)
+{
+	writeValue(os, static_cast<unsigned long long>(str.size()));
+	os.write(str.c_str(), static_cast<std::streamsize>(str.size()));
+}
+
+static bool readString(std::istream& is, std::string& str)
+{
+	unsigned long long len = 0;
+	if (!readValue(is, len) || len>(1ULL<<24)) return false;
+	str.resize(static_cast<size_t>(len));
+	if (len>0) is.read(&str[0], static_cast<std::streamsize>(len));
+	return !is.fail();
+}
+
+static void writeDate(std::ostream& os, const Date& date)
+{
+	writeValue(os, date.getJulian(true));
+	writeValue(os, date.getTimeZone());
+}
+
+static bool readDate(std::istream& is, Date& date)
+{
+	double julian, tz;
+	if (!readValue(is, julian) || !readValue(is, tz)) return false;
+	date.setDate(julian, 0.);
+	date.setTimeZone(tz);
+	return true;
+}
+
+static unsigned char getFlags(const MeteoData& md, const size_t& param)
+{
+	return static_cast<unsigned char>( (md.isFiltered(param)? 1 : 0) | (md.isResampledParam(param)? 2 : 0) | (md.isGenerated(param)? 4 : 0) );
+}
+
+static void setFlags(MeteoData& md, const size_t& param, const unsigned char& flags)
+{
+	if (flags & 1) md.setFiltered(param);
+	if (flags & 2) md.setResampledParam(param);
+	if (flags & 4) md.setGenerated(param);
+}
+
+TimeSeriesCache::TimeSeriesCache(const Config& cfg, const char& rank, const IOUtils::OperationMode& mode)
+                : input_paths(), current_stamps(), cache_dir(), signature(), nr_hits(0), nr_tails(0), nr_misses(0)
+{
+	std::string dir;
+	cfg.getValue("METEO_CACHE", "General", dir, IOUtils::nothrow);
+	if (dir.empty()) return;
+
+	struct stat buffer;
+	if (stat(dir.c_str(), &buffer)!=0 || !S_ISDIR(buffer.st_mode))
+		throw AccessException("METEO_CACHE directory '"+dir+"' does not exist", AT);
+
+	const std::vector< std::pair<std::string, std::string> > paths( cfg.getValues("METEOPATH", "Input") );
+	for (size_t ii=0; ii<paths.size(); ii++) input_paths.push_back( paths[ii].second );
+	if (input_paths.empty()) {
+		std::cerr << "[W] METEO_CACHE is ignored since there is no METEOPATH to check for changes in the input data\n";
+		return;
+	}
+
+	cache_dir = dir;
+	signature = buildSignature(cfg, rank, mode);
+}
+
+/**
+ * @brief Everything that has an influence on the filtered data, except the input data itself
+ */
+std::string TimeSeriesCache::buildSignature(const Config& cfg, const char& rank, const IOUtils::OperationMode& mode) const
+{
+	std::ostringstream os;
+	os << getLibVersion() << "\n" << static_cast<int>(rank) << " " << static_cast<int>(mode) << "\n";
+	static const char* sections[] = {"Input", "InputEditing", "Filters", "Interpolations1D"};
+	for (size_t ii=0; ii<sizeof(sections)/sizeof(sections[0]); ii++) {
+		os << "[" << sections[ii] << "]\n";
+		const std::vector< std::pair<std::string, std::string> > values( cfg.getValues("", sections[ii]) );
+		for (size_t jj=0; jj<values.size(); jj++) os << values[jj].first << "=" << values[jj].second << "\n";
+	}
+	return os.str();
+}
+
+/**
+ * @brief Build the name of the cache file from a hash of the signature (FNV-1a)
+ */
+std::string TimeSeriesCache::getCacheFilename() const
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t ii=0; ii<signature.size(); ii++) {
+		hash ^= static_cast<unsigned char>(signature[ii]);
+		hash *= 1099511628211ULL;
+	}
+
+	std::ostringstream os;
+	os << cache_dir << "/.meteoio_series_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+	return os.str();
+}
+
+void TimeSeriesCache::getInputStamps(std::map<std::string, file_stamp>& stamps) const
+{
+	stamps.clear();
+	const long long now = static_cast<long long>( time(nullptr) );
+	for (size_t ii=0; ii<input_paths.size(); ii++) {
+		const std::list<std::string> dirlist( FileUtils::readDirectory(input_paths[ii], "", true) );
+		for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
+			const std::string filename( input_paths[ii] + "/" + *it );
+			struct stat buffer;
+			if (stat(filename.c_str(), &buffer)!=0) continue; //the file is gone in the meantime
+			const long long mtime = static_cast<long long>(buffer.st_mtime);
+			//a file modified within the current second could still change with the same mtime, so it should not be trusted
+			stamps[filename] = file_stamp(static_cast<long long>(buffer.st_size), (mtime < now-1)? mtime : -1);
+		}
+	}
+}
+
+/**
+ * @brief Compare the input files with the ones that were used to build the cache
+ * @details The input is considered as having been extended when no file disappeared and all the files that changed
+ * have grown. Files rewritten with the same size are considered as changed.
+ */
+TimeSeriesCache::input_state TimeSeriesCache::compareStamps(const std::map<std::string, file_stamp>& previous, const std::map<std::string, file_stamp>& current)
+{
+	bool unchanged = (previous.size()==current.size());
+	for (std::map<std::string, file_stamp>::const_iterator it = previous.begin(); it != previous.end(); ++it) {
+		const std::map<std::string, file_stamp>::const_iterator now( current.find(it->first) );
+		if (now==current.end()) return CHANGED;
+		if (now->second.size==it->second.size && now->second.mtime==it->second.mtime) continue;
+		if (now->second.size<=it->second.size) return CHANGED;
+		unchanged = false;
+	}
+	return (unchanged)? UNCHANGED : EXTENDED;
+}
+
+/**
+ * @brief Look for the filtered data covering a given period
+ * @param[in] date_start start of the requested period
+ * @param[in] date_end end of the requested period
+ * @param[in] time_after how far in the future the filters look, so the data that has to be filtered again when the input has been extended
+ * @param[out] vecMeteo cached data (when the lookup is not a MISS)
+ * @param[out] cache_start start of the cached period
+ * @param[out] cache_end end of the cached period
+ * @param[out] tail_start for a TAIL, the cached data is only valid before this date
+ * @return lookup status
+ */
+TimeSeriesCache::lookup_status TimeSeriesCache::lookup(const Date& date_start, const Date& date_end, const Duration& time_after,
+                                       std::vector< METEO_SET >& vecMeteo, Date& cache_start, Date& cache_end, Date& tail_start)
+{
+	vecMeteo.clear();
+	getInputStamps(current_stamps);
+
+	std::map<std::string, file_stamp> cached_stamps;
+	if (!readCache(cached_stamps, cache_start, cache_end, vecMeteo) || cache_start>date_start) {
+		vecMeteo.clear();
+		nr_misses++;
+		return MISS;
+	}
+
+	const input_state state = compareStamps(cached_stamps, current_stamps);
+	if (state==CHANGED) {
+		vecMeteo.clear();
+		nr_misses++;
+		return MISS;
+	}
+	if (state==UNCHANGED && date_end<=cache_end) {
+		nr_hits++;
+		return HIT;
+	}
+
+	//the data after the last cached data point of any station (minus the filters' window) must be computed again
+	tail_start.setUndef(true);
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (vecMeteo[ii].empty()) continue;
+		const Date last( vecMeteo[ii].back().date - time_after );
+		if (tail_start.isUndef() || last<tail_start) tail_start = last;
+	}
+	if (tail_start.isUndef() || tail_start<=date_start) {
+		vecMeteo.clear();
+		nr_misses++;
+		return MISS;
+	}
+
+	nr_tails++;
+	return TAIL;
+}
+
+/**
+ * @brief Write the filtered data into the cache, together with the state of the input files as seen by the last lookup.
+ * The file is first written under a temporary name and then renamed, so an interrupted run never leaves a truncated file behind.
+ * @param[in] date_start start of the period covered by the data
+ * @param[in] date_end end of the period covered by the data
+ * @param[in] vecMeteo filtered data
+ */
+void TimeSeriesCache::store(const Date& date_start, const Date& date_end, const std::vector< METEO_SET >& vecMeteo)
+{
+	if (!enabled()) return;
+	if (current_stamps.empty()) getInputStamps(current_stamps);
+
+	const std::string filename( getCacheFilename() );
+	const std::string tmp_filename( filename + ".tmp" );
+	try {
+		{
+			std::ofstream fout(tmp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (fout.fail()) throw AccessException(tmp_filename, AT);
+
+			writeString(fout, cache_magic);
+			writeString(fout, signature);
+			writeValue(fout, static_cast<unsigned long long>(current_stamps.size()));
+			for (std::map<std::string, file_stamp>::const_iterator it = current_stamps.begin(); it != current_stamps.end(); ++it) {
+				writeString(fout, it->first);
+				writeValue(fout, it->second.size);
+				writeValue(fout, it->second.mtime);
+			}
+			writeDate(fout, date_start);
+			writeDate(fout, date_end);
+			writeValue(fout, static_cast<unsigned long long>(vecMeteo.size()));
+			for (size_t ii=0; ii<vecMeteo.size(); ii++) writeStation(fout, vecMeteo[ii]);
+			if (fout.fail()) throw AccessException("Could not write "+tmp_filename, AT);
+		}
+		if (std::rename(tmp_filename.c_str(), filename.c_str())!=0)
+			throw AccessException("Could not rename "+tmp_filename+" to "+filename, AT);
+	} catch (const std::exception& e) { //the cache is only an optimization, we can go on without it
+		std::remove(tmp_filename.c_str());
+		std::cerr << "[W] Could not write the meteo data cache: " << e.what() << "\n";
+	}
+}
+
+/**
+ * @brief Read the cache file
+ * @return false if there is no valid cache file for the current signature
+ */
+bool TimeSeriesCache::readCache(std::map<std::string, file_stamp>& stamps, Date& cache_start, Date& cache_end, std::vector< METEO_SET >& vecMeteo) const
+{
+	std::ifstream fin(getCacheFilename().c_str(), std::ios::in | std::ios::binary);
+	if (fin.fail()) return false;
+
+	std::string magic, file_signature;
+	if (!readString(fin, magic) || magic!=cache_magic) return false;
+	if (!readString(fin, file_signature) || file_signature!=signature) return false; //hash collision
+
+	unsigned long long nr_files = 0;
+	if (!readValue(fin, nr_files)) return false;
+	for (unsigned long long ii=0; ii<nr_files; ii++) {
+		std::string name;
+		file_stamp stamp;
+		if (!readString(fin, name) || !readValue(fin, stamp.size) || !readValue(fin, stamp.mtime)) return false;
+		stamps[name] = stamp;
+	}
+	if (!readDate(fin, cache_start) || !readDate(fin, cache_end)) return false;
+
+	unsigned long long nr_stations = 0;
+	if (!readValue(fin, nr_stations)) return false;
+	vecMeteo.resize(static_cast<size_t>(nr_stations));
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (!readStation(fin, vecMeteo[ii])) return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Write the time series of one station
+ * @details When all the data points share the same metadata and parameters (this is the usual case), these are only
+ * written once and each data point then only contains its date, its values and their flags. Otherwise, each data point
+ * is written in full.
+ */
+void TimeSeriesCache::writeStation(std::ostream& os, const METEO_SET& vecStation)
+{
+	writeValue(os, static_cast<unsigned long long>(vecStation.size()));
+	if (vecStation.empty()) return;
+
+	const MeteoData& ref = vecStation.front();
+	const size_t nrParams = ref.getNrOfParameters();
+	bool compact = true;
+	for (size_t jj=1; jj<vecStation.size() && compact; jj++) {
+		const MeteoData& md = vecStation[jj];
+		if (md.getNrOfParameters()!=nrParams || !(md.meta==ref.meta)) compact = false;
+		for (size_t pp=MeteoData::nrOfParameters; pp<nrParams && compact; pp++)
+			if (md.getNameForParameter(pp)!=ref.getNameForParameter(pp)) compact = false;
+	}
+
+	writeValue(os, static_cast<unsigned char>(compact? 1 : 0));
+	if (compact) {
+		os << ref.meta;
+		writeValue(os, static_cast<unsigned long long>(nrParams));
+		for (size_t pp=MeteoData::nrOfParameters; pp<nrParams; pp++) writeString(os, ref.getNameForParameter(pp));
+	}
+
+	std::vector<double> values( nrParams );
+	std::vector<unsigned char> flags( nrParams );
+	for (size_t jj=0; jj<vecStation.size(); jj++) {
+		const MeteoData& md = vecStation[jj];
+		if (compact) {
+			writeDate(os, md.date);
+			writeValue(os, static_cast<unsigned char>(md.isResampled()? 1 : 0));
+		} else {
+			os << md;
+		}
+		const size_t nr = md.getNrOfParameters();
+		values.resize( nr );
+		flags.resize( nr );
+		for (size_t pp=0; pp<nr; pp++) {
+			values[pp] = md(pp);
+			flags[pp] = getFlags(md, pp);
+		}
+		if (compact) os.write(reinterpret_cast<const char*>(&values[0]), static_cast<std::streamsize>(nr*sizeof(values[0])));
+		if (nr>0) os.write(reinterpret_cast<const char*>(&flags[0]), static_cast<std::streamsize>(nr*sizeof(flags[0])));
+	}
+}
+
+bool TimeSeriesCache::readStation(std::istream& is, METEO_SET& vecStation)
+{
+	unsigned long long nr_points = 0;
+	if (!readValue(is, nr_points)) return false;
+	vecStation.clear();
+	if (nr_points==0) return true;
+
+	unsigned char compact = 0;
+	if (!readValue(is, compact)) return false;
+	MeteoData ref;
+	size_t nrParams = 0;
+	if (compact) {
+		unsigned long long nr = 0;
+		is >> ref.meta;
+		if (!readValue(is, nr) || nr<MeteoData::nrOfParameters || nr>(1ULL<<16)) return false;
+		nrParams = static_cast<size_t>(nr);
+		for (size_t pp=MeteoData::nrOfParameters; pp<nrParams; pp++) {
+			std::string name;
+			if (!readString(is, name)) return false;
+			ref.addParameter( name );
+		}
+	}
+
+	vecStation.reserve( static_cast<size_t>(nr_points) );
+	std::vector<double> values( nrParams );
+	std::vector<unsigned char> flags( nrParams );
+	for (unsigned long long jj=0; jj<nr_points; jj++) {
+		MeteoData md( ref );
+		if (compact) {
+			unsigned char resampled = 0;
+			if (!readDate(is, md.date) || !readValue(is, resampled)) return false;
+			md.setResampled( resampled!=0 );
+			is.read(reinterpret_cast<char*>(&values[0]), static_cast<std::streamsize>(nrParams*sizeof(values[0])));
+			for (size_t pp=0; pp<nrParams; pp++) md(pp) = values[pp];
+		} else { //the flags are not part of the serialization, so rebuild the object to get them allocated
+			MeteoData tmp;
+			is >> tmp;
+			if (is.fail()) return false;
+			md = MeteoData(tmp.date, tmp.meta);
+			md.setResampled( tmp.isResampled() );
+			for (size_t pp=MeteoData::nrOfParameters; pp<tmp.getNrOfParameters(); pp++) md.addParameter( tmp.getNameForParameter(pp) );
+			for (size_t pp=0; pp<tmp.getNrOfParameters(); pp++) md(pp) = tmp(pp);
+		}
+		const size_t nr = md.getNrOfParameters();
+		flags.resize( nr );
+		if (nr>0) is.read(reinterpret_cast<char*>(&flags[0]), static_cast<std::streamsize>(nr*sizeof(flags[0])));
+		if (is.fail()) return false;
+		for (size_t pp=0; pp<nr; pp++) setFlags(md, pp, flags[pp]);
+		vecStation.push_back( md );
+	}
+	return true;
+}
+
+const std::string TimeSeriesCache::toString() const
+{
+	std::ostringstream os;
+	os << "<TimeSeriesCache>\n";
+	if (enabled())
+		os << "\t" << getCacheFilename() << ": " << nr_hits << " hits, " << nr_tails << " extended, " << nr_misses << " misses\n";
+	else
+		os << "\tdisabled\n";
+	os << "</TimeSeriesCache>\n";
+	return os.str();
+}
+
+} //namespace
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TIMESERIESCACHE_H
+#define TIMESERIESCACHE_H
+
+#include <meteoio/dataClasses/MeteoData.h>
+#include <meteoio/Config.h>
+#include <meteoio/IOUtils.h>
+
+#include <string>
+#include <map>
+#include <vector>
+#include <iostream>
+
+namespace mio {
+
+/**
+ * @class TimeSeriesCache
+ * @brief Persistent on-disk cache of the filtered meteorological time series
+ * @details When the key METEO_CACHE in the [General] section points to an existing directory, the TimeSeriesManager
+ * keeps the filtered time series of all stations (ie. after reading, data editing and filtering) in a binary file
+ * in this directory. The following runs then read this file instead of reading and filtering the raw data again.
+ * Resampling and data generators are still applied on the fly, since they only work on the requested time steps.
+ *
+ * The cache file name is built from a hash of the MeteoIO version, of the TimeSeriesManager rank and mode and of
+ * the [Input], [InputEditing], [Filters] and [Interpolations1D] sections, so changing any of these creates a new
+ * cache file. The file also records the path, size and modification time of all the files found in METEOPATH:
+ *     - if none of them has changed and the cached period covers the requested period, the cached data is used as is;
+ *     - if some files only grew (or new files appeared), the input is considered as having been extended: only the
+ *       tail of the time series, from the last cached data point minus the filters' window, is read and filtered
+ *       again and then appended to the cached data;
+ *     - otherwise (or if the requested period starts before the cached period), the cache is rebuilt.
+ *
+ * The input files are therefore expected to only grow by appending data at their end. The cache is disabled when
+ * there is no METEOPATH key in [Input] (for example with the database plugins), since there would be no way of
+ * knowing when the data has changed. Please also note that the data points at the beginning of the requested
+ * period might have been filtered with the data available before it (when it was part of a previous request),
+ * while a run without cache would not see this data.
+ * @code
+ * [General]
+ * METEO_CACHE = ./cache
+ * @endcode
+ *
+ * @ingroup data_str
+ */
+class TimeSeriesCache {
+	public:
+		///result of a cache lookup
+		enum lookup_status {
+			MISS, ///< nothing usable in the cache
+			HIT, ///< the cache covers the requested period
+			TAIL ///< the cache is valid until a given date, the data after it must be computed again
+		};
+
+		TimeSeriesCache(const Config& cfg, const char& rank, const IOUtils::OperationMode& mode);
+
+		bool enabled() const {return !cache_dir.empty();}
+
+		lookup_status lookup(const Date& date_start, const Date& date_end, const Duration& time_after,
+		                     std::vector< METEO_SET >& vecMeteo, Date& cache_start, Date& cache_end, Date& tail_start);
+		void store(const Date& date_start, const Date& date_end, const std::vector< METEO_SET >& vecMeteo);
+
+		const std::string toString() const;
+
+	private:
+		struct file_stamp {
+			file_stamp() : size(-1), mtime(-1) {}
+			file_stamp(const long long& i_size, const long long& i_mtime) : size(i_size), mtime(i_mtime) {}
+			long long size, mtime;
+		};
+		typedef enum INPUT_STATE { UNCHANGED, EXTENDED, CHANGED } input_state;
+
+		std::string buildSignature(const Config& cfg, const char& rank, const IOUtils::OperationMode& mode) const;
+		std::string getCacheFilename() const;
+		void getInputStamps(std::map<std::string, file_stamp>& stamps) const;
+		static input_state compareStamps(const std::map<std::string, file_stamp>& previous, const std::map<std::string, file_stamp>& current);
+		bool readCache(std::map<std::string, file_stamp>& stamps, Date& cache_start, Date& cache_end, std::vector< METEO_SET >& vecMeteo) const;
+
+		static void writeStation(std::ostream& os, const METEO_SET& vecStation);
+		static bool readStation(std::istream& is, METEO_SET& vecStation);
+
+		std::vector<std::string> input_paths; ///< the directories containing the raw input files
+		std::map<std::string, file_stamp> current_stamps; ///< input files, as seen by the last lookup
+		std::string cache_dir, signature;
+		size_t nr_hits, nr_tails, nr_misses;
+};
+
+} //end namespace
+#endif
@@ -18,6 +18,7 @@
 */
 
 #include <meteoio/TimeSeriesManager.h>
+#include <meteoio/Tracing.h>
 
 #include <algorithm>
 
@@ -30,15 +31,25 @@ bool TimeSeriesManager::compare(std::pair<Date, METEO_SET> p1, std::pair<Date, M
 }
 
 TimeSeriesManager::TimeSeriesManager(IOHandler& in_iohandler, const Config& in_cfg, const char& rank, const IOUtils::OperationMode &mode) : cfg(in_cfg), iohandler(in_iohandler),
-                                            meteoprocessor(in_cfg, rank, mode), dataGenerator(in_cfg),
+                                            meteoprocessor(in_cfg, rank, mode), dataGenerator(in_cfg), series_cache(in_cfg, rank, mode),
                                             proc_properties(), point_cache(), raw_buffer(), filtered_cache(),
                                             raw_requested_start(), raw_requested_end(), chunk_size(), buff_before(),
-                                            processing_level(IOUtils::raw | IOUtils::filtered | IOUtils::resampled | IOUtils::generated)
+                                            processing_level(IOUtils::raw | IOUtils::filtered | IOUtils::resampled | IOUtils::generated),
+                                            buffers_mutex(), generators_mutex()
 {
 	meteoprocessor.getWindowSize(proc_properties);
 	setDfltBufferProperties();
 }
 
+TimeSeriesManager::TimeSeriesManager(const TimeSeriesManager& source)
+                  : cfg(source.cfg), iohandler(source.iohandler),
+                    meteoprocessor(source.meteoprocessor), dataGenerator(source.dataGenerator), series_cache(source.series_cache),
+                    proc_properties(source.proc_properties), point_cache(source.point_cache), raw_buffer(source.raw_buffer), filtered_cache(source.filtered_cache),
+                    raw_requested_start(source.raw_requested_start), raw_requested_end(source.raw_requested_end), chunk_size(source.chunk_size), buff_before(source.buff_before),
+                    processing_level(source.processing_level),
+                    buffers_mutex(), generators_mutex()
+{}
+
 void TimeSeriesManager::setDfltBufferProperties()
 {
 	double chunk_size_days = 370.; //default chunk size value
@@ -74,6 +85,7 @@ void TimeSeriesManager::setDfltBufferProperties()
 
 void TimeSeriesManager::setBufferProperties(const double& i_chunk_size, const double& i_buff_before)
 {
+	const ExclusiveLock lock( buffers_mutex );
 	if (i_buff_before!=IOUtils::nodata) {
 		const Duration app_buff_before(i_buff_before, 0);
 		if (app_buff_before>buff_before) buff_before = app_buff_before;
@@ -89,12 +101,14 @@ void TimeSeriesManager::setBufferProperties(const double& i_chunk_size, const do
 
 void TimeSeriesManager::setRawBufferProperties(const Date& raw_buffer_start, const Date& raw_buffer_end)
 {
+	const ExclusiveLock lock( buffers_mutex );
 	if (!raw_buffer_start.isUndef()) raw_requested_start = raw_buffer_start;
 	if (!raw_buffer_end.isUndef()) raw_requested_end = raw_buffer_end;
 }
 
 void TimeSeriesManager::getBufferProperties(Duration &o_buffer_size, Duration &o_buff_before) const
 {
+	const SharedLock lock( buffers_mutex );
 	o_buffer_size = chunk_size+proc_properties.time_before+proc_properties.time_after;
 	o_buff_before = buff_before+proc_properties.time_before;
 }
@@ -104,11 +118,13 @@ void TimeSeriesManager::setProcessingLevel(const unsigned int& i_level)
 	if (i_level >= IOUtils::num_of_levels)
 		throw InvalidArgumentException("The processing level is invalid", AT);
 
+	const ExclusiveLock lock( buffers_mutex );
 	processing_level = i_level;
 }
 
 double TimeSeriesManager::getAvgSamplingRate() const
 {
+	const SharedLock lock( buffers_mutex );
 	const double raw_rate = raw_buffer.getAvgSamplingRate();
 	if (raw_rate!=IOUtils::nodata)
 		return raw_rate;
@@ -118,6 +134,7 @@ double TimeSeriesManager::getAvgSamplingRate() const
 
 Date TimeSeriesManager::getBufferStart(const cache_types& cache) const
 {
+	const SharedLock lock( buffers_mutex );
 	switch(cache) {
 		case RAW: 
 			return raw_buffer.getBufferStart();
@@ -130,6 +147,7 @@ Date TimeSeriesManager::getBufferStart(const cache_types& cache) const
 
 Date TimeSeriesManager::getBufferEnd(const cache_types& cache) const 
 {
+	const SharedLock lock( buffers_mutex );
 	switch(cache) {
 		case RAW: 
 			return raw_buffer.getBufferEnd();
@@ -142,6 +160,7 @@ Date TimeSeriesManager::getBufferEnd(const cache_types& cache) const
 
 Date TimeSeriesManager::getDataStart(const cache_types& cache) const
 {
+	const SharedLock lock( buffers_mutex );
 	switch(cache) {
 		case RAW: 
 			return raw_buffer.getDataStart();
@@ -158,6 +177,7 @@ Date TimeSeriesManager::getDataStart(const cache_types& cache) const
 
 Date TimeSeriesManager::getDataEnd(const cache_types& cache) const 
 {
+	const SharedLock lock( buffers_mutex );
 	switch(cache) {
 		case RAW: 
 			return raw_buffer.getDataEnd();
@@ -181,6 +201,7 @@ void TimeSeriesManager::push_meteo_data(const IOUtils::ProcessingLevel& level, c
 		throw InvalidArgumentException(ss, AT);
 	}
 
+	const ExclusiveLock lock( buffers_mutex );
 	if (level == IOUtils::filtered) {
 		filtered_cache.push(date_start, date_end, vecMeteo);
 	} else if (level == IOUtils::raw) {
@@ -202,6 +223,7 @@ void TimeSeriesManager::push_meteo_data(const IOUtils::ProcessingLevel& level, c
 		throw InvalidArgumentException(ss, AT);
 	}
 
+	const ExclusiveLock lock( buffers_mutex );
 	if (level == IOUtils::filtered) {
 		filtered_cache.push(date_start, date_end, vecMeteo);
 	} else if (level == IOUtils::raw) {
@@ -227,28 +249,37 @@ size_t TimeSeriesManager::getStationData(const Date& date, STATIONS_SET& vecStat
 size_t TimeSeriesManager::getMeteoData(const Date& dateStart, const Date& dateEnd, std::vector< METEO_SET >& vecVecMeteo)
 {
 	vecVecMeteo.clear();
-	if (processing_level == IOUtils::raw) {
+	unsigned int level;
+	bool success = false;
+	{ //most requests are served by the filtered cache, concurrently with the other readers
+		const SharedLock lock( buffers_mutex );
+		level = processing_level;
+		if (level != IOUtils::raw) success = filtered_cache.get(dateStart, dateEnd, vecVecMeteo);
+	}
+
+	if (level == IOUtils::raw) {
 		iohandler.readMeteoData(dateStart, dateEnd, vecVecMeteo);
 	} else {
-		const bool success = filtered_cache.get(dateStart, dateEnd, vecVecMeteo);
-
 		if (!success) {
-			std::vector< std::vector<MeteoData> > tmp_meteo;
-			const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > dateStart) || (raw_buffer.getBufferEnd() < dateEnd);
-			if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) fillRawBuffer(dateStart, dateEnd);
-			raw_buffer.get(dateStart, dateEnd, tmp_meteo);
-
-			//now it needs to be secured that the data is actually filtered, if configured
-			if ((IOUtils::filtered & processing_level) == IOUtils::filtered) {
-				fill_filtered_cache();
-				filtered_cache.get(dateStart, dateEnd, vecVecMeteo);
-			} else {
-				vecVecMeteo = tmp_meteo;
+			const ExclusiveLock lock( buffers_mutex );
+			if (!filtered_cache.get(dateStart, dateEnd, vecVecMeteo)) { //another thread might have filled the cache in the mean time
+				const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > dateStart) || (raw_buffer.getBufferEnd() < dateEnd);
+
+				//now it needs to be secured that the data is actually filtered, if configured
+				if ((IOUtils::filtered & processing_level) == IOUtils::filtered) {
+					refill_filtered_cache(dateStart, dateEnd, rebuffer_raw);
+					filtered_cache.get(dateStart, dateEnd, vecVecMeteo);
+				} else {
+					if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) fillRawBuffer(dateStart, dateEnd);
+					raw_buffer.get(dateStart, dateEnd, vecVecMeteo);
+				}
 			}
 		}
 
-		if ((IOUtils::generated & processing_level) == IOUtils::generated)
+		if ((IOUtils::generated & level) == IOUtils::generated) {
+			const std::lock_guard<std::mutex> lock( generators_mutex );
 			dataGenerator.fillMissing(vecVecMeteo);
+		}
 	}
 
 	return vecVecMeteo.size(); //equivalent with the number of stations that have data
@@ -258,9 +289,22 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 {
 	vecMeteo.clear();
 
+	unsigned int level;
+	{ //points that have already been computed are served concurrently with the other readers
+		const SharedLock lock( buffers_mutex );
+		level = processing_level;
+		if (level != IOUtils::raw) {
+			const map<Date, vector<MeteoData> >::const_iterator it = point_cache.find(i_date);
+			if (it != point_cache.end()) {
+				vecMeteo = it->second;
+				return vecMeteo.size();
+			}
+		}
+	}
+
 	//1. Check whether user wants raw data or processed data
 	//The first case: we are looking at raw data directly, only unresampled values are considered, exact date match
-	if (processing_level == IOUtils::raw) {
+	if (level == IOUtils::raw) {
 		std::vector< std::vector<MeteoData> > vec_cache;
 		static const Duration eps(1./(24.*3600.), 0.);
 		iohandler.readMeteoData(i_date-eps, i_date+eps, vec_cache);
@@ -272,7 +316,8 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 		return vecMeteo.size();
 	}
 
-	//2.  Check which data point is available, buffered locally
+	//2.  Check which data point is available, buffered locally (another thread might have computed it in the mean time)
+	const ExclusiveLock lock( buffers_mutex );
 	const map<Date, vector<MeteoData> >::const_iterator it = point_cache.find(i_date);
 	if (it != point_cache.end()) {
 		vecMeteo = it->second;
@@ -297,10 +342,7 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 				meteoprocessor.resetResampling();
 				
 			const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > buffer_start) || (raw_buffer.getBufferEnd() < buffer_end);
-			if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) {
-				fillRawBuffer(buffer_start, buffer_end);
-			}
-			fill_filtered_cache();
+			refill_filtered_cache(buffer_start, buffer_end, rebuffer_raw);
 		}
 		data = &filtered_cache.getBuffer();
 	} else { //data to be resampled should be IOUtils::raw
@@ -324,10 +366,12 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 		}
 	}
 
-	if ((IOUtils::generated & processing_level) == IOUtils::generated)
+	if ((IOUtils::generated & processing_level) == IOUtils::generated) {
+		const std::lock_guard<std::mutex> generators_lock( generators_mutex );
 		dataGenerator.fillMissing(vecMeteo);
+	}
 
-	add_to_points_cache(i_date, vecMeteo); //Store result in the local cache
+	insert_in_points_cache(i_date, vecMeteo); //Store result in the local cache
 
 	return vecMeteo.size();
 }
@@ -358,7 +402,81 @@ void TimeSeriesManager::fill_filtered_cache()
 	}
 }
 
+/**
+ * @brief Bring the filtered data cache up to date for a given period
+ * @details When the raw data has to be read again, the persistent series cache is first considered (if enabled). Otherwise,
+ * the raw data is read and filtered, the results then being written to the persistent series cache.
+ * @param[in] date_start start of the period that must be available
+ * @param[in] date_end end of the period that must be available
+ * @param[in] rebuffer_raw should the raw data be read again?
+ */
+void TimeSeriesManager::refill_filtered_cache(const Date& date_start, const Date& date_end, const bool& rebuffer_raw)
+{
+	const bool read_raw = rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw;
+	if (read_raw && series_cache.enabled() && fill_from_series_cache(date_start, date_end)) return;
+
+	if (read_raw) fillRawBuffer(date_start, date_end);
+	fill_filtered_cache();
+	if (read_raw && series_cache.enabled())
+		series_cache.store(filtered_cache.getBufferStart(), filtered_cache.getBufferEnd(), filtered_cache.getBuffer());
+}
+
+/**
+ * @brief Fill the filtered data cache from the persistent series cache
+ * @details If the input data has been extended since the series cache has been written, only the tail of the data is
+ * read and filtered again (with enough data before it for the filters' windows) and then appended to the cached data.
+ * @param[in] date_start start of the period that must be available
+ * @param[in] date_end end of the period that must be available
+ * @return false if the series cache could not be used
+ */
+bool TimeSeriesManager::fill_from_series_cache(const Date& date_start, const Date& date_end)
+{
+	MIO_TRACE_ZONE("MeteoIO", "seriesCache");
+	Date window_start, window_end;
+	getRawBufferWindow(date_start, date_end, window_start, window_end);
+
+	std::vector< METEO_SET > vecCached;
+	Date cache_start, cache_end, tail_start;
+	const TimeSeriesCache::lookup_status status = series_cache.lookup(window_start, window_end, proc_properties.time_after, vecCached, cache_start, cache_end, tail_start);
+	if (status==TimeSeriesCache::MISS) return false;
+
+	if (status==TimeSeriesCache::TAIL) {
+		std::vector< METEO_SET > vecRaw, vecTail;
+		iohandler.readMeteoData(tail_start-proc_properties.time_before, window_end, vecRaw);
+		if (vecRaw.size()!=vecCached.size()) return false; //the stations have changed
+		meteoprocessor.process(vecRaw, vecTail);
+
+		for (size_t ii=0; ii<vecCached.size(); ii++) { //splice the tail into the cached data, dropping what is before the window
+			METEO_SET& station = vecCached[ii];
+			if (!station.empty() && !vecTail[ii].empty() && station.front().meta.getHash()!=vecTail[ii].front().meta.getHash()) return false;
+
+			const METEO_SET::iterator first( std::lower_bound(station.begin(), station.end(), MeteoData(window_start)) );
+			const METEO_SET::iterator last( std::lower_bound(station.begin(), station.end(), MeteoData(tail_start)) );
+			METEO_SET spliced(first, last);
+			const METEO_SET::iterator tail( std::lower_bound(vecTail[ii].begin(), vecTail[ii].end(), MeteoData(tail_start)) );
+			spliced.insert(spliced.end(), tail, vecTail[ii].end());
+			station.swap( spliced );
+		}
+		cache_start = window_start;
+		cache_end = window_end;
+		series_cache.store(cache_start, cache_end, vecCached);
+	}
+
+	raw_buffer.clear(); //as in fill_filtered_cache(), the raw data is not kept
+	filtered_cache.clear();
+	std::swap(vecCached, filtered_cache.getBuffer());
+	filtered_cache.setBufferStart( cache_start );
+	filtered_cache.setBufferEnd( cache_end );
+	return true;
+}
+
 void TimeSeriesManager::add_to_points_cache(const Date& i_date, const METEO_SET& vecMeteo)
+{
+	const ExclusiveLock lock( buffers_mutex );
+	insert_in_points_cache(i_date, vecMeteo);
+}
+
+void TimeSeriesManager::insert_in_points_cache(const Date& i_date, const METEO_SET& vecMeteo)
 {
 	//Check cache size, delete oldest elements if necessary
 	if (point_cache.size() > 2000) {
@@ -370,6 +488,7 @@ void TimeSeriesManager::add_to_points_cache(const Date& i_date, const METEO_SET&
 
 void TimeSeriesManager::clear_cache(const cache_types& cache)
 {
+	const ExclusiveLock lock( buffers_mutex );
 	switch(cache) {
 		case RAW: 
 			raw_buffer.clear(); 
@@ -390,11 +509,21 @@ void TimeSeriesManager::clear_cache(const cache_types& cache)
 	}
 }
 
+/**
+ * @brief Compute the period that is read into the raw buffer in order to cover a given period
+ */
+void TimeSeriesManager::getRawBufferWindow(const Date& date_start, const Date& date_end, Date& window_start, Date& window_end) const
+{
+	window_start = date_start-buff_before; //taking centering into account
+	window_end = max(date_start + chunk_size, date_end);
+}
+
 void TimeSeriesManager::fillRawBuffer(const Date& date_start, const Date& date_end)
 {
+	MIO_TRACE_ZONE("MeteoIO", "readMeteoData");
 	//computing the start and end date of the raw data request
-	const Date new_start( date_start-buff_before ); //taking centering into account
-	const Date new_end( max(date_start + chunk_size, date_end) );
+	Date new_start, new_end;
+	getRawBufferWindow(date_start, date_end, new_start, new_end);
 	
 	raw_buffer.clear(); //HACK until we have a proper ring buffer to avoid eating up all memory...
 
@@ -429,6 +558,7 @@ void TimeSeriesManager::fillRawBuffer(const Date& date_start, const Date& date_e
 }
 
 const std::string TimeSeriesManager::toString() const {
+	const SharedLock lock( buffers_mutex );
 	ostringstream os;
 	os << "<TimeSeriesManager>\n";
 	os << "Config& cfg = " << hex << &cfg << dec << "\n";
@@ -436,6 +566,7 @@ const std::string TimeSeriesManager::toString() const {
 	os << meteoprocessor.toString();
 	os << "Processing level = " << processing_level << "\n";
 	os << dataGenerator.toString();
+	os << series_cache.toString();
 
 	os << "RawBuffer:\n" << raw_buffer.toString();
 	os << "Filteredcache:\n" << filtered_cache.toString();
@@ -21,13 +21,23 @@
 
 #include <meteoio/DataGenerator.h>
 #include <meteoio/MeteoProcessor.h>
+#include <meteoio/TimeSeriesCache.h>
 #include <meteoio/dataClasses/MeteoData.h>
 #include <meteoio/dataClasses/Buffer.h>
 #include <meteoio/IOHandler.h>
 #include <meteoio/Config.h>
+#include <meteoio/SharedMutex.h>
+
+#include <mutex>
 
 namespace mio {
 
+/**
+ * @class TimeSeriesManager
+ * @brief Buffered access to the meteorological time series
+ * @details The buffers are protected by a readers / writer lock, so requests that can be served from the buffers run
+ * concurrently while filling the buffers is done by one thread at a time (see @ref concurrency).
+ */
 class TimeSeriesManager {
 	public:
 		enum cache_types {
@@ -50,6 +60,13 @@ class TimeSeriesManager {
 		 */
 		TimeSeriesManager(IOHandler& in_iohandler, const Config& in_cfg, const char& rank=1, const IOUtils::OperationMode &mode=IOUtils::STD);
 
+		/**
+		 * @brief Copy constructor
+		 * @details The copy gets its own locks, the source must not be used by other threads while it is being copied.
+		 * @param[in] source TimeSeriesManager to copy
+		 */
+		TimeSeriesManager(const TimeSeriesManager& source);
+
 		size_t getStationData(const Date& date, STATIONS_SET& vecStation);
 
 		/**
@@ -224,12 +241,17 @@ class TimeSeriesManager {
 		static bool compare(std::pair<Date, METEO_SET> p1, std::pair<Date, METEO_SET> p2);
 		void setDfltBufferProperties();
 		void fill_filtered_cache();
+		void refill_filtered_cache(const Date& date_start, const Date& date_end, const bool& rebuffer_raw);
+		bool fill_from_series_cache(const Date& date_start, const Date& date_end);
+		void getRawBufferWindow(const Date& date_start, const Date& date_end, Date& window_start, Date& window_end) const;
 		void fillRawBuffer(const Date& date_start, const Date& date_end);
+		void insert_in_points_cache(const Date& i_date, const METEO_SET& vecMeteo);
 
 		const Config& cfg;
 		IOHandler& iohandler;
 		MeteoProcessor meteoprocessor;
 		DataGenerator dataGenerator;
+		TimeSeriesCache series_cache; ///< persistent cache of the filtered data (when enabled)
 
 		ProcessingProperties proc_properties; ///< buffer constraints in order to be able to compute the requested values
 		std::map<Date, METEO_SET > point_cache;  ///< stores already resampled data points
@@ -240,6 +262,9 @@ class TimeSeriesManager {
 		Duration chunk_size; ///< How much data to read at once
 		Duration buff_before; ///< How much data to read before the requested date in buffer
 		unsigned int processing_level;
+
+		mutable SharedMutex buffers_mutex; ///< protects all the buffers and the buffering properties
+		std::mutex generators_mutex; ///< the data generators keep some state, so they are called by one thread at a time
 };
 } //end namespace
 #endif
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/Tracing.h>
+#include <meteoio/IOExceptions.h>
+#include <meteoio/FileUtils.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace mio {
+
+namespace {
+struct ZoneEvent {
+	const char* module;
+	const char* name;
+	double t_start, t_end;
+};
+
+struct ZoneStats {
+	ZoneStats() : count(0), total(0.), max(0.) {}
+	size_t count;
+	double total, max;
+};
+
+//all the zones recorded by one thread. The zones are identified by the addresses of their literals
+struct ThreadBuffer {
+	ThreadBuffer(const size_t& i_tid) : events(), stats(), tid(i_tid) {}
+	std::vector<ZoneEvent> events;
+	std::map< std::pair<const char*, const char*>, ZoneStats > stats;
+	const size_t tid;
+};
+
+std::mutex registry_mutex;
+std::vector< std::shared_ptr<ThreadBuffer> > registry; //buffers are kept after their thread has exited
+std::atomic<bool> tracing_enabled( true );
+std::atomic<size_t> process_id( 0 );
+std::atomic<size_t> max_thread_events( 1000000 );
+const std::chrono::steady_clock::time_point epoch( std::chrono::steady_clock::now() );
+
+ThreadBuffer& getThreadBuffer()
+{
+	static thread_local ThreadBuffer* buffer = nullptr;
+	if (buffer==nullptr) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		registry.push_back( std::make_shared<ThreadBuffer>(registry.size()) );
+		buffer = registry.back().get();
+	}
+	return *buffer;
+}
+
+//escape the few characters that are not allowed in a JSON string
+std::string jsonEscape(const std::string& str)
+{
+	std::string out;
+	out.reserve( str.size() );
+	for (size_t ii=0; ii<str.size(); ii++) {
+		const char c = str[ii];
+		if (c=='"' || c=='\\') out.push_back('\\');
+		if (static_cast<unsigned char>(c)<0x20) continue;
+		out.push_back( c );
+	}
+	return out;
+}
+}
+
+/**
+* @brief Enable or disable recording at runtime (default: enabled).
+* This has no effect on zones that have been compiled out.
+* @param enable true to record the zones
+*/
+void Tracer::setEnabled(const bool& enable)
+{
+	tracing_enabled = enable;
+}
+
+bool Tracer::isEnabled()
+{
+	return tracing_enabled;
+}
+
+/**
+* @brief Set the id of the current process (for example, its MPI rank) so traces of several processes can be merged.
+* @param id process id
+*/
+void Tracer::setProcessID(const size_t& id)
+{
+	process_id = id;
+}
+
+/**
+* @brief Set the maximum number of timeline events that each thread keeps (default: 1000000).
+* Beyond this limit, the zones are still accounted for in the summary but are not exported to the trace anymore.
+* @param max_events maximum number of events per thread
+*/
+void Tracer::setMaxEvents(const size_t& max_events)
+{
+	max_thread_events = max_events;
+}
+
+/**
+* @brief Time since the process started, in seconds
+* @return time in seconds
+*/
+double Tracer::now()
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now() - epoch ).count();
+}
+
+/**
+* @brief Record a zone for the calling thread
+* @param module module the zone belongs to (must be a string literal)
+* @param name name of the zone (must be a string literal)
+* @param t_start start time, as returned by now()
+* @param t_end end time, as returned by now()
+*/
+void Tracer::record(const char* module, const char* name, const double& t_start, const double& t_end)
+{
+	ThreadBuffer& buffer = getThreadBuffer();
+	ZoneStats& stats = buffer.stats[ std::make_pair(module, name) ];
+	const double duration = t_end - t_start;
+	stats.count++;
+	stats.total += duration;
+	if (duration>stats.max) stats.max = duration;
+
+	if (buffer.events.size() < max_thread_events) {
+		const ZoneEvent event = {module, name, t_start, t_end};
+		buffer.events.push_back( event );
+	}
+}
+
+/**
+* @brief Write all the recorded events as a Chrome trace (JSON "Trace Event Format")
+* @details The process id is written as "pid" and the internal thread index as "tid". The times are in microseconds since
+* the process started.
+* @param filename file to write
+*/
+void Tracer::writeChromeTrace(const std::string& filename)
+{
+	if (!FileUtils::validFileAndPath(filename)) throw InvalidNameException(filename, AT);
+	std::ofstream fout(filename.c_str(), std::ios::out);
+	if (fout.fail()) throw AccessException(filename, AT);
+
+	const size_t pid = process_id;
+	fout << std::fixed << std::setprecision(3);
+	fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	for (size_t ii=0; ii<registry.size(); ii++) {
+		const std::vector<ZoneEvent>& events = registry[ii]->events;
+		for (size_t jj=0; jj<events.size(); jj++) {
+			if (!first) fout << ",\n";
+			first = false;
+			fout << "{\"name\":\"" << jsonEscape(events[jj].name) << "\",\"cat\":\"" << jsonEscape(events[jj].module) << "\",\"ph\":\"X\",";
+			fout << "\"ts\":" << events[jj].t_start*1e6 << ",\"dur\":" << (events[jj].t_end-events[jj].t_start)*1e6 << ",";
+			fout << "\"pid\":" << pid << ",\"tid\":" << registry[ii]->tid << "}";
+		}
+	}
+	fout << "\n]}\n";
+	fout.close();
+}
+
+/**
+* @brief Summary table of the time spent in each zone, for all threads of the current process
+* @details The zones are sorted by module and by decreasing total time. Since zones can be nested, the time of a
+* zone includes the time of the zones it contains.
+* @return multi-line table
+*/
+std::string Tracer::getSummary()
+{
+	//merge the threads. Identical literals might have different addresses in different compilation units, so merge by content
+	std::map< std::pair<std::string, std::string>, ZoneStats > all_stats;
+	std::map< std::pair<std::string, std::string>, size_t > nr_threads;
+	{
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		for (size_t ii=0; ii<registry.size(); ii++) {
+			std::map< std::pair<const char*, const char*>, ZoneStats >::const_iterator it;
+			for (it=registry[ii]->stats.begin(); it!=registry[ii]->stats.end(); ++it) {
+				const std::pair<std::string, std::string> key(it->first.first, it->first.second);
+				ZoneStats& stats = all_stats[ key ];
+				stats.count += it->second.count;
+				stats.total += it->second.total;
+				if (it->second.max>stats.max) stats.max = it->second.max;
+				nr_threads[ key ]++;
+			}
+		}
+	}
+
+	std::vector< std::pair<std::pair<std::string, std::string>, ZoneStats> > sorted(all_stats.begin(), all_stats.end());
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::pair<std::string, std::string>, ZoneStats>& a, const std::pair<std::pair<std::string, std::string>, ZoneStats>& b) {
+		if (a.first.first!=b.first.first) return a.first.first < b.first.first;
+		return a.second.total > b.second.total;
+	});
+
+	std::ostringstream os;
+	os << "[i] Timing summary for process " << process_id << "\n";
+	os << std::left << std::setw(20) << "module" << std::setw(32) << "zone" << std::right;
+	os << std::setw(10) << "calls" << std::setw(9) << "threads" << std::setw(14) << "total [s]" << std::setw(14) << "mean [ms]" << std::setw(14) << "max [ms]" << "\n";
+	os << std::fixed;
+	for (size_t ii=0; ii<sorted.size(); ii++) {
+		const ZoneStats& stats = sorted[ii].second;
+		os << std::left << std::setw(20) << sorted[ii].first.first << std::setw(32) << sorted[ii].first.second << std::right;
+		os << std::setw(10) << stats.count << std::setw(9) << nr_threads[ sorted[ii].first ];
+		os << std::setw(14) << std::setprecision(3) << stats.total;
+		os << std::setw(14) << std::setprecision(3) << stats.total / static_cast<double>(stats.count) * 1e3;
+		os << std::setw(14) << std::setprecision(3) << stats.max * 1e3 << "\n";
+	}
+	return os.str();
+}
+
+/**
+* @brief Forget all the recorded zones
+*/
+void Tracer::clear()
+{
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	for (size_t ii=0; ii<registry.size(); ii++) {
+		registry[ii]->events.clear();
+		registry[ii]->stats.clear();
+	}
+}
+
+} //end namespace mio
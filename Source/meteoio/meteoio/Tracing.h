@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <string>
+
+namespace mio {
+
+/**
+ * @page tracing Tracing
+ * MeteoIO provides a low overhead instrumentation facility that records how much time is spent in the main code sections ("zones"), per module,
+ * per thread and per process. It is used by MeteoIO itself as well as by Snowpack and Alpine3D for their hot paths (data reading, filtering,
+ * resampling, spatial interpolations, radiation, snowpack sub-models, snow drift, MPI exchanges, etc).
+ *
+ * The instrumentation is compiled out unless the code has been compiled with <i>MIO_TRACING</i> defined (this is done by setting the
+ * TRACING cmake option to ON, for each of the projects that should be instrumented). When it is compiled in, zones are declared
+ * with the MIO_TRACE_ZONE(module, name) macro: the zone covers the code from the macro until the end of the enclosing scope. Both the module
+ * and the zone name must be string literals.
+ * @code
+ * void MyClass::compute()
+ * {
+ * 	MIO_TRACE_ZONE("MyModule", "compute");
+ * 	//... code to time
+ * }
+ * @endcode
+ *
+ * Once the run is over, the records can be exported either as a summary table (total time, number of calls, etc per zone) or as a
+ * <a href="https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU">Chrome trace</a> JSON file that
+ * can be opened in chrome://tracing or <a href="https://ui.perfetto.dev">Perfetto</a>. In a parallel run, each process should set
+ * its process id (see Tracer::setProcessID()) and write its own trace file, the files can then be merged by concatenating their
+ * "traceEvents" arrays.
+ */
+
+/**
+ * @class Tracer
+ * @brief Process wide recorder for the timing zones.
+ * @details The zones are recorded in per-thread buffers, so recording does not require any locking.
+ * Each thread keeps at most a given number of timeline events (see setMaxEvents()), beyond this limit only the
+ * statistics used by the summary table are updated so the memory usage remains bounded for long runs.
+ * The export methods should be called when no other thread is recording anymore.
+ */
+class Tracer {
+	public:
+		static void setEnabled(const bool& enable);
+		static bool isEnabled();
+		static void setProcessID(const size_t& id);
+		static void setMaxEvents(const size_t& max_events);
+
+		static void record(const char* module, const char* name, const double& t_start, const double& t_end);
+		static double now();
+
+		static void writeChromeTrace(const std::string& filename);
+		static std::string getSummary();
+		static void clear();
+};
+
+/**
+ * @class TraceZone
+ * @brief Record the time spent between its construction and its destruction as a zone.
+ * @details This should not be used directly but through the MIO_TRACE_ZONE macro, so it can be compiled out.
+ */
+class TraceZone {
+	public:
+		TraceZone(const char* i_module, const char* i_name) : module(i_module), name(i_name), t_start(Tracer::isEnabled()? Tracer::now() : -1.) {}
+		~TraceZone() { if (t_start>=0.) Tracer::record(module, name, t_start, Tracer::now()); }
+
+	private:
+		TraceZone(const TraceZone&);
+		TraceZone& operator=(const TraceZone&);
+
+		const char* module;
+		const char* name;
+		const double t_start;
+};
+
+} //end namespace mio
+
+#define MIO_TRACE_CONCAT_(a, b) a##b
+#define MIO_TRACE_CONCAT(a, b) MIO_TRACE_CONCAT_(a, b)
+#ifdef MIO_TRACING
+	#define MIO_TRACE_ZONE(module, name) const mio::TraceZone MIO_TRACE_CONCAT(mio_trace_zone_, __LINE__)(module, name)
+#else
+	#define MIO_TRACE_ZONE(module, name) ((void)0)
+#endif
+
+#endif
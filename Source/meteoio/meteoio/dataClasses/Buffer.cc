@@ -320,14 +320,34 @@ const std::string MeteoBuffer::toString() const
 /********************************************************************************************/
 
 GridBuffer::GridBuffer(const size_t& in_max_grids) 
-           : mapBufferedGrids(), mapBufferedDEMs(), mapBufferedInfos(), IndexBufferedGrids(), IndexBufferedDEMs(), max_grids(in_max_grids) 
+           : mapBufferedGrids(), mapCompactGrids(), mapBufferedDEMs(), mapBufferedInfos(), IndexBufferedGrids(), IndexBufferedDEMs(), max_grids(in_max_grids), compact(false)
 {}
 
+/**
+ * @brief Store the 2D grids as float32 with a validity bitmask (see CompactGrid2D) instead of doubles.
+ * @details The grids are converted back to Grid2DObject when they are retrieved, so this is transparent for the caller
+ * except for the reduced precision. Changing the storage clears the buffer.
+ * @param i_compact true to use the compact storage
+ */
+void GridBuffer::setCompact(const bool& i_compact)
+{
+	if (i_compact==compact) return;
+	clear();
+	compact = i_compact;
+}
+
 
 bool GridBuffer::get(Grid2DObject& grid, const std::string& grid_hash) const
 {
 	if (IndexBufferedGrids.empty()) return false;
 
+	if (compact) {
+		const std::map<std::string, CompactGrid2D>::const_iterator it = mapCompactGrids.find( grid_hash );
+		if (it == mapCompactGrids.end()) return false;
+		(*it).second.get( grid );
+		return true;
+	}
+
 	const std::map<std::string, Grid2DObject>::const_iterator it = mapBufferedGrids.find( grid_hash );
 	if (it != mapBufferedGrids.end()) { //already in map
 		grid = (*it).second;
@@ -362,6 +382,7 @@ bool GridBuffer::get(Grid2DObject& grid, const MeteoGrids::Parameters& parameter
 bool GridBuffer::has(const std::string& grid_hash) const
 {
 	if (IndexBufferedGrids.empty()) return false;
+	if (compact) return (mapCompactGrids.find( grid_hash ) != mapCompactGrids.end());
 	const std::map<std::string, Grid2DObject>::const_iterator it = mapBufferedGrids.find( grid_hash );
 	return (it != mapBufferedGrids.end());
 }
@@ -424,13 +445,15 @@ void GridBuffer::push(const Grid2DObject& grid, const std::string& grid_hash, co
 
 	if (IndexBufferedGrids.size() >= max_grids) { //we need to remove the oldest grid
 		const std::string tmp_hash( IndexBufferedGrids.front() );
-		mapBufferedGrids.erase( mapBufferedGrids.find( tmp_hash ) );
+		if (compact) mapCompactGrids.erase( tmp_hash );
+		else mapBufferedGrids.erase( mapBufferedGrids.find( tmp_hash ) );
 		mapBufferedInfos.erase( mapBufferedInfos.find( tmp_hash ) );
 		//swap followed by pop_back is faster than erase()
 		swap( IndexBufferedGrids.front(), IndexBufferedGrids.back() );
 		IndexBufferedGrids.pop_back();
 	}
-	mapBufferedGrids[ grid_hash ] = grid;
+	if (compact) mapCompactGrids[ grid_hash ].set( grid );
+	else mapBufferedGrids[ grid_hash ] = grid;
 	mapBufferedInfos[ grid_hash ] = grid_info;
 	IndexBufferedGrids.push_back( grid_hash );
 }
@@ -450,18 +473,43 @@ void GridBuffer::push(const Grid2DObject& grid, const MeteoGrids::Parameters& pa
 	push(grid, grid_hash, "");
 }
 
+/**
+ * @brief Buffer a grid and set it to the values that the buffer returns for it
+ * @details With the compact storage, the buffered copy has a reduced precision. The grid is then read back from the buffer,
+ * so the caller gets the same values when the grid has just been computed as when it is later found in the buffer.
+ * @param grid grid to buffer, replaced by its buffered copy
+ * @param grid_hash key of the grid in the buffer
+ * @param grid_info information string associated with the grid
+ */
+void GridBuffer::pushAndGet(Grid2DObject& grid, const std::string& grid_hash, const std::string& grid_info)
+{
+	push(grid, grid_hash, grid_info);
+	if (compact) get(grid, grid_hash);
+}
+
+void GridBuffer::pushAndGet(Grid2DObject& grid, const MeteoGrids::Parameters& parameter, const Date& date)
+{
+	push(grid, parameter, date);
+	if (compact) get(grid, parameter, date);
+}
+
 const std::string GridBuffer::toString() const
 {
 	ostringstream os;
 	os << "<GridBuffer>\n";
 	os << "Max buffered grids = " << max_grids << "\n";
+	if (compact) os << "Compact storage (float32 and validity mask)\n";
 
 	//cache content
-	os << "Cached grids: " << mapBufferedGrids.size() << "\n";
+	os << "Cached grids: " << mapBufferedGrids.size() + mapCompactGrids.size() << "\n";
 	std::map<std::string, Grid2DObject>::const_iterator it_grid;
 	for (it_grid=mapBufferedGrids.begin(); it_grid != mapBufferedGrids.end(); ++it_grid){
 		os << setw(10) << "Grid " << it_grid->first << "\n";
 	}
+	std::map<std::string, CompactGrid2D>::const_iterator it_compact;
+	for (it_compact=mapCompactGrids.begin(); it_compact != mapCompactGrids.end(); ++it_compact){
+		os << setw(10) << "Grid " << it_compact->first << "\n";
+	}
 	
 	//dem buffer
 	os << "Cached dems: " << mapBufferedDEMs.size() << "\n";
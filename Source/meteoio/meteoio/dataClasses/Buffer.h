@@ -20,6 +20,7 @@
 #define BUFFER_H
 
 #include <meteoio/dataClasses/Grid2DObject.h>
+#include <meteoio/dataClasses/CompactGrid2D.h>
 #include <meteoio/dataClasses/DEMObject.h>
 #include <meteoio/dataClasses/Date.h>
 #include <meteoio/dataClasses/MeteoData.h>
@@ -147,7 +148,9 @@ class MeteoBuffer {
  * @class GridBuffer
  * @brief A class to buffer gridded data.
  * This class buffers Grid2D objects. It implements a proper ring buffer, thus removing old buffered grids
- * when necessary.
+ * when necessary. The 2D grids can optionally be stored as CompactGrid2D (float32 values and a validity bitmask, see
+ * setCompact()) in order to halve the memory that the buffer requires, at the cost of a reduced precision. The grids
+ * that are buffered with pushAndGet() are then also rounded for the caller, so they do not depend on buffer hits.
  *
  * @ingroup data_str
  * @author Mathias Bavay
@@ -159,10 +162,12 @@ class GridBuffer {
 		GridBuffer(const size_t& in_max_grids);
 
 		bool empty() const {return IndexBufferedGrids.empty();}
-		void clear() {mapBufferedGrids.clear(); mapBufferedInfos.clear(); IndexBufferedGrids.clear();}
+		void clear() {mapBufferedGrids.clear(); mapCompactGrids.clear(); mapBufferedInfos.clear(); IndexBufferedGrids.clear();}
 		size_t size() const {return IndexBufferedGrids.size();}
 
 		void setMaxGrids(const size_t& in_max_grids) {max_grids=in_max_grids;}
+		void setCompact(const bool& i_compact);
+		bool isCompact() const {return compact;}
 
 		bool get(DEMObject& grid, const std::string& grid_hash) const;
 		bool get(Grid2DObject& grid, const std::string& grid_hash) const;
@@ -176,15 +181,19 @@ class GridBuffer {
 		void push(const Grid2DObject& grid, const std::string& grid_hash);
 		void push(const Grid2DObject& grid, const std::string& grid_hash, const std::string& grid_info);
 		void push(const Grid2DObject& grid, const MeteoGrids::Parameters& parameter, const Date& date);
+		void pushAndGet(Grid2DObject& grid, const std::string& grid_hash, const std::string& grid_info="");
+		void pushAndGet(Grid2DObject& grid, const MeteoGrids::Parameters& parameter, const Date& date);
 
 		const std::string toString() const;
 	private:
 		std::map<std::string, Grid2DObject> mapBufferedGrids;  ///< Buffer interpolated grids
+		std::map<std::string, CompactGrid2D> mapCompactGrids;  ///< Buffer interpolated grids, when using the compact storage
 		std::map<std::string, DEMObject> mapBufferedDEMs;  ///< Buffer interpolated grids
 		std::map<std::string, std::string> mapBufferedInfos; ///< Buffer interpolations info messages
 		std::vector<std::string> IndexBufferedGrids; // this is required in order to know which grid is the oldest one
 		std::vector<std::string> IndexBufferedDEMs; // this is required in order to know which grid is the oldest one
 		size_t max_grids; ///< How many grids to buffer (grids, dem, landuse and assimilation grids together)
+		bool compact; ///< store the 2D grids as CompactGrid2D?
 };
 
 }
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2024 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/dataClasses/CompactGrid2D.h>
+#include <meteoio/IOExceptions.h>
+#include <meteoio/IOUtils.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace mio {
+
+CompactGrid2D::CompactGrid2D()
+              : llcorner(), cellsize(0.), values(), mask(), nx(0), ny(0), ur_lat(IOUtils::nodata), ur_lon(IOUtils::nodata), isLatLon(false) {}
+
+CompactGrid2D::CompactGrid2D(const Grid2DObject& grid)
+              : llcorner(), cellsize(0.), values(), mask(), nx(0), ny(0), ur_lat(IOUtils::nodata), ur_lon(IOUtils::nodata), isLatLon(false)
+{
+	set(grid);
+}
+
+/**
+* @brief Create an empty grid (all cells invalid)
+* @param ncols number of colums
+* @param nrows number of rows
+* @param i_cellsize cell size
+* @param i_llcorner lower left corner point
+*/
+CompactGrid2D::CompactGrid2D(const size_t& ncols, const size_t& nrows, const double& i_cellsize, const Coords& i_llcorner)
+              : llcorner(i_llcorner), cellsize(i_cellsize), values(ncols*nrows, 0.f), mask((ncols*nrows+7)/8, 0), nx(ncols), ny(nrows),
+                ur_lat(IOUtils::nodata), ur_lon(IOUtils::nodata), isLatLon(false) {}
+
+/**
+* @brief Store a grid, its nodata cells being marked as invalid
+* @param grid grid to store
+*/
+void CompactGrid2D::set(const Grid2DObject& grid)
+{
+	llcorner = grid.llcorner;
+	cellsize = grid.cellsize;
+	ur_lat = grid.ur_lat;
+	ur_lon = grid.ur_lon;
+	isLatLon = grid.isLatLon;
+	grid.grid2D.size(nx, ny);
+
+	const size_t count = nx*ny;
+	values.assign(count, 0.f);
+	mask.assign((count+7)/8, 0);
+	for (size_t ii=0; ii<count; ii++) {
+		const double val = grid.grid2D(ii);
+		if (val==IOUtils::nodata) continue;
+		values[ii] = static_cast<float>( val );
+		mask[ii >> 3] |= static_cast<unsigned char>(1 << (ii & 7));
+	}
+}
+
+/**
+* @brief Convert back to a Grid2DObject, the invalid cells being set to IOUtils::nodata
+* @param grid grid to fill
+*/
+void CompactGrid2D::get(Grid2DObject& grid) const
+{
+	grid.set(nx, ny, cellsize, llcorner);
+	grid.ur_lat = ur_lat;
+	grid.ur_lon = ur_lon;
+	grid.isLatLon = isLatLon;
+
+	const size_t count = nx*ny;
+	for (size_t ii=0; ii<count; ii++) {
+		grid.grid2D(ii) = (isValid(ii))? static_cast<double>( values[ii] ) : IOUtils::nodata;
+	}
+}
+
+Grid2DObject CompactGrid2D::toGrid2D() const
+{
+	Grid2DObject grid;
+	get(grid);
+	return grid;
+}
+
+void CompactGrid2D::clear()
+{
+	values.clear();
+	mask.clear();
+	nx = ny = 0;
+}
+
+size_t CompactGrid2D::getCount() const
+{
+	size_t count = 0;
+	for (size_t ii=0; ii<mask.size(); ii++) {
+		unsigned char bits = mask[ii];
+		for (; bits; count++) bits &= static_cast<unsigned char>(bits - 1); //clear the lowest set bit
+	}
+	return count;
+}
+
+double CompactGrid2D::operator()(const size_t& ii) const
+{
+	return (isValid(ii))? static_cast<double>( values[ii] ) : IOUtils::nodata;
+}
+
+/**
+* @brief Set the value of a cell. Setting IOUtils::nodata marks the cell as invalid.
+* @param ii cell index
+* @param value new value
+*/
+void CompactGrid2D::setValue(const size_t& ii, const double& value)
+{
+	if (value==IOUtils::nodata) {
+		mask[ii >> 3] &= static_cast<unsigned char>( ~(1 << (ii & 7)) );
+		values[ii] = 0.f;
+	} else {
+		mask[ii >> 3] |= static_cast<unsigned char>(1 << (ii & 7));
+		values[ii] = static_cast<float>( value );
+	}
+}
+
+double CompactGrid2D::getMin() const
+{
+	float min = std::numeric_limits<float>::max();
+	bool found = false;
+	const size_t count = nx*ny;
+	for (size_t ii=0; ii<count; ii++) {
+		if (isValid(ii) && values[ii]<min) {
+			min = values[ii];
+			found = true;
+		}
+	}
+	return (found)? static_cast<double>( min ) : IOUtils::nodata;
+}
+
+double CompactGrid2D::getMax() const
+{
+	float max = -std::numeric_limits<float>::max();
+	bool found = false;
+	const size_t count = nx*ny;
+	for (size_t ii=0; ii<count; ii++) {
+		if (isValid(ii) && values[ii]>max) {
+			max = values[ii];
+			found = true;
+		}
+	}
+	return (found)? static_cast<double>( max ) : IOUtils::nodata;
+}
+
+double CompactGrid2D::getMean() const
+{
+	double sum = 0.; //accumulate in double precision
+	size_t nr_valid = 0;
+	const size_t count = nx*ny;
+	for (size_t ii=0; ii<count; ii++) {
+		if (!isValid(ii)) continue;
+		sum += static_cast<double>( values[ii] );
+		nr_valid++;
+	}
+	return (nr_valid>0)? sum/static_cast<double>(nr_valid) : IOUtils::nodata;
+}
+
+/**
+* @brief check if the current grid has the same geolocalization attributes as another one, with the same
+* logic as Grid2DObject::isSameGeolocalization()
+* @param target grid to compare to
+* @return true if same geolocalization
+*/
+bool CompactGrid2D::isSameGeolocalization(const CompactGrid2D& target) const
+{
+	static const double eps = 1.e-4;
+	return nx==target.nx && ny==target.ny && llcorner==target.llcorner &&
+	       (cellsize==target.cellsize || (fabs(ur_lat-target.ur_lat) < eps && fabs(ur_lon-target.ur_lon) < eps));
+}
+
+bool CompactGrid2D::isSameGeolocalization(const Grid2DObject& target) const
+{
+	static const double eps = 1.e-4;
+	return nx==target.getNx() && ny==target.getNy() && llcorner==target.llcorner &&
+	       (cellsize==target.cellsize || (fabs(ur_lat-target.ur_lat) < eps && fabs(ur_lon-target.ur_lon) < eps));
+}
+
+void CompactGrid2D::checkGeolocalization(const CompactGrid2D& rhs) const
+{
+	if (!isSameGeolocalization(rhs))
+		throw InvalidArgumentException("[E] grids must have the same geolocalization in order to do arithmetic operations!", AT);
+}
+
+//the invalid cells remain invalid and, for operations between two grids, a cell is valid only if it is valid in both
+CompactGrid2D& CompactGrid2D::operator+=(const double& rhs)
+{
+	const float val = static_cast<float>( rhs );
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] += val;
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator+=(const CompactGrid2D& rhs)
+{
+	checkGeolocalization(rhs);
+	for (size_t ii=0; ii<mask.size(); ii++) mask[ii] &= rhs.mask[ii];
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] += rhs.values[ii];
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator-=(const double& rhs)
+{
+	const float val = static_cast<float>( rhs );
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] -= val;
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator-=(const CompactGrid2D& rhs)
+{
+	checkGeolocalization(rhs);
+	for (size_t ii=0; ii<mask.size(); ii++) mask[ii] &= rhs.mask[ii];
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] -= rhs.values[ii];
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator*=(const double& rhs)
+{
+	const float val = static_cast<float>( rhs );
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] *= val;
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator*=(const CompactGrid2D& rhs)
+{
+	checkGeolocalization(rhs);
+	for (size_t ii=0; ii<mask.size(); ii++) mask[ii] &= rhs.mask[ii];
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] *= rhs.values[ii];
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator/=(const double& rhs)
+{
+	const float val = static_cast<float>( rhs );
+	for (size_t ii=0; ii<values.size(); ii++) values[ii] /= val;
+	return *this;
+}
+
+CompactGrid2D& CompactGrid2D::operator/=(const CompactGrid2D& rhs)
+{
+	checkGeolocalization(rhs);
+	for (size_t ii=0; ii<mask.size(); ii++) mask[ii] &= rhs.mask[ii];
+	for (size_t ii=0; ii<values.size(); ii++) {
+		if (isValid(ii)) values[ii] /= rhs.values[ii]; //the invalid cells might contain 0
+	}
+	return *this;
+}
+
+const std::string CompactGrid2D::toString() const
+{
+	std::ostringstream os;
+	os << "<CompactGrid2D>\n";
+	os << llcorner.toString();
+	os << nx << " x " << ny << " @ " << cellsize << "m\n";
+	os << getCount() << " valid cells, " << getMemorySize() << " bytes\n";
+	os << "</CompactGrid2D>\n";
+	return os.str();
+}
+
+} //namespace
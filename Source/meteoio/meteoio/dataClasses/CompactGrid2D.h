@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2024 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef COMPACTGRID2D_H
+#define COMPACTGRID2D_H
+
+#include <meteoio/dataClasses/Grid2DObject.h>
+
+#include <string>
+#include <vector>
+
+namespace mio {
+
+/**
+ * @class CompactGrid2D
+ * @brief A reduced precision storage for 2D grids: the values are kept as float32 and the nodata cells are marked in
+ * a separate validity bitmask instead of relying on the IOUtils::nodata sentinel.
+ * @details This halves the memory footprint of a grid (plus one bit per cell) and lets the statistics and
+ * arithmetic operators work on the mask without comparing each value to nodata. It is meant for the grids that are
+ * kept around (buffers of forcing grids, interpolated grids, accumulators) and is converted back to a Grid2DObject
+ * (the "double view") when the full API is required:
+ * @code
+ * CompactGrid2D compact( grid ); //from a Grid2DObject
+ * compact *= 2.;
+ * const double mean = compact.getMean();
+ * Grid2DObject result;
+ * compact.get( result ); //back to doubles, invalid cells are set to IOUtils::nodata
+ * @endcode
+ * Please note that the values are rounded to float32 (about 7 significant digits) when stored.
+ *
+ * @ingroup data_str
+ */
+class CompactGrid2D {
+	public:
+		CompactGrid2D();
+		CompactGrid2D(const Grid2DObject& grid);
+		CompactGrid2D(const size_t& ncols, const size_t& nrows, const double& i_cellsize, const Coords& i_llcorner);
+
+		void set(const Grid2DObject& grid);
+		void get(Grid2DObject& grid) const;
+		Grid2DObject toGrid2D() const;
+
+		size_t getNx() const {return nx;}
+		size_t getNy() const {return ny;}
+		size_t size() const {return nx*ny;}
+		bool empty() const {return (nx==0 || ny==0);}
+		void clear();
+
+		/**
+		* @brief Number of valid (ie not nodata) cells
+		*/
+		size_t getCount() const;
+
+		/**
+		* @brief Memory used by the values and the mask, in bytes
+		*/
+		size_t getMemorySize() const {return values.capacity()*sizeof(float) + mask.capacity()*sizeof(unsigned char);}
+
+		bool isValid(const size_t& ii) const {return (mask[ii >> 3] & (1 << (ii & 7))) != 0;}
+		bool isValid(const size_t& ix, const size_t& iy) const {return isValid(ix + iy*nx);}
+
+		double operator()(const size_t& ii) const;
+		double operator()(const size_t& ix, const size_t& iy) const {return operator()(ix + iy*nx);}
+		void setValue(const size_t& ii, const double& value);
+		void setValue(const size_t& ix, const size_t& iy, const double& value) {setValue(ix + iy*nx, value);}
+
+		double getMin() const;
+		double getMax() const;
+		double getMean() const;
+
+		bool isSameGeolocalization(const CompactGrid2D& target) const;
+		bool isSameGeolocalization(const Grid2DObject& target) const;
+
+		CompactGrid2D& operator+=(const double& rhs);
+		CompactGrid2D& operator+=(const CompactGrid2D& rhs);
+		CompactGrid2D& operator-=(const double& rhs);
+		CompactGrid2D& operator-=(const CompactGrid2D& rhs);
+		CompactGrid2D& operator*=(const double& rhs);
+		CompactGrid2D& operator*=(const CompactGrid2D& rhs);
+		CompactGrid2D& operator/=(const double& rhs);
+		CompactGrid2D& operator/=(const CompactGrid2D& rhs);
+
+		const std::string toString() const;
+
+		Coords llcorner; ///<lower left corner of the grid
+		double cellsize; ///<dimension in meters of a cell (considered to be square)
+
+	private:
+		void checkGeolocalization(const CompactGrid2D& rhs) const;
+
+		std::vector<float> values; ///< the values, only meaningful where the mask is set
+		std::vector<unsigned char> mask; ///< one bit per cell, set for valid cells
+		size_t nx, ny;
+		double ur_lat, ur_lon; ///< upper right corner, as in Grid2DObject
+		bool isLatLon;
+};
+
+} //end namespace
+
+#endif
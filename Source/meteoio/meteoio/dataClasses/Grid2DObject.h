@@ -29,6 +29,8 @@ namespace mio {
 
 class IOInterface;
 class GridsManager;
+class GridRemapper;
+class CompactGrid2D;
 
 /**
  * @class Grid2DObject
@@ -42,6 +44,8 @@ class GridsManager;
 class Grid2DObject {
 	friend class IOInterface;
 	friend class GridsManager;
+	friend class GridRemapper;
+	friend class CompactGrid2D;
 	
 	public:
 		///structure to contain the grid coordinates of a point in a 2D grid
@@ -36,6 +36,8 @@ FilterMaths::FilterMaths(const std::vector< std::pair<std::string, std::string>
 
 /**
  * @brief The filtering routine as called by the processing toolchain.
+ * @details All expressions are compiled once and then evaluated over the whole time series at once
+ * (see ColumnExpression), the conditions are evaluated the same way before the formulas.
  * @param[in] param Parameter index the filter is asked to run on by the user.
  * @param[in] ivec Meteo data to filter.
  * @param[out] ovec Filtered meteo data. Cf. main documentation.
@@ -44,139 +46,129 @@ void FilterMaths::process(const unsigned int& param, const std::vector<MeteoData
     std::vector<MeteoData>& ovec)
 {
 	ovec = ivec;
+	const size_t nr_data = ivec.size();
 
-	//We init all of this not in the constructor but here to have more control over the memory management.
-	te_variable *te_vars = new te_variable[substitutions.size()]; //substitutions are built in constructor
-	initExpressionVars(te_vars); //build te_variables from substitution vectors
-	te_expr *expr_formula = compileExpression(formula, te_vars, substitutions.size()); //main formula
-	te_expr *expr_formula_else = nullptr; //only compile if available
-	if (!formula_else.empty()) {
-		try {
-			expr_formula_else = compileExpression(formula_else, te_vars, substitutions.size());
-		} catch (...) { //roll back main formula on error
-			te_free(expr_formula);
-			delete[] te_vars;
-			throw;
-		}
-	}
+	//all expressions share the same variables, in the order of the substitutions map (built in constructor)
+	std::vector<std::string> variables;
+	for (std::map<std::string, double>::const_iterator it_sub = substitutions.begin(); it_sub != substitutions.end(); ++it_sub)
+		variables.push_back(it_sub->first);
 
-	//logic_equations is input directly from the ini file. The following is storage for the same pairs of expressions in compiled
-	//form, where the index matches the one from logic_equations:
-	std::map< size_t, std::pair<te_expr*, te_expr*> > compiled_expressions;
+	ColumnExpression expr_formula, expr_formula_else;
+	compileExpression(formula, variables, expr_formula); //main formula
+	if (!formula_else.empty()) //only compile if available
+		compileExpression(formula_else, variables, expr_formula_else);
 
-	std::map<size_t, logic_eq>::iterator it;
-	for (it = logic_equations.begin(); it != logic_equations.end(); ++it) {
-		if (it->second.op.substr(0, 3) != "STR") { //nothing to compile for string evaluations
-			bool arrived_at_second(false);
-			try {
-				compiled_expressions[it->first].first = compileExpression(it->second.expression, te_vars, substitutions.size());
-				arrived_at_second = true; //flag to check which compilation failed
-				compiled_expressions[it->first].second = compileExpression(it->second.compare, te_vars, substitutions.size());
-			} catch (...) { //unroll all previous expression compilations
-				if (arrived_at_second)
-					te_free(compiled_expressions[it->first].first); //.compare has an error -> clean .expression
-				for (; it-- != logic_equations.begin(); ) {
-					te_free(compiled_expressions[it->first].first);
-					te_free(compiled_expressions[it->first].second);
-				}
-				te_free(expr_formula);
-				if (!formula_else.empty())
-					te_free(expr_formula_else);
-				delete[] te_vars;
-				throw;
-			} //end try
-		} //endif STR
+	//logic_equations is input directly from the ini file. The following is storage for the same pairs of expressions in compiled
+	//form, in the same order as logic_equations:
+	std::vector< std::pair<ColumnExpression, ColumnExpression> > compiled_expressions( logic_equations.size() );
+	std::vector<bool> is_string_eq( logic_equations.size() );
+	std::map<size_t, logic_eq>::const_iterator it;
+	size_t eq_idx = 0;
+	for (it = logic_equations.begin(); it != logic_equations.end(); ++it, ++eq_idx) {
+		is_string_eq[eq_idx] = (it->second.op.compare(0, 3, "STR") == 0);
+		if (is_string_eq[eq_idx]) continue; //nothing to compile for string evaluations
+		compileExpression(it->second.expression, variables, compiled_expressions[eq_idx].first);
+		compileExpression(it->second.compare, variables, compiled_expressions[eq_idx].second);
+	}
+	if (nr_data == 0) return;
+
+	//fill the substitutions for all the records at once, but only for the variables that are used somewhere
+	std::vector< std::vector<double> > columns( variables.size() );
+	for (size_t vv = 0; vv < variables.size(); ++vv) {
+		bool used = expr_formula.usesVariable(vv) || (expr_formula_else.isCompiled() && expr_formula_else.usesVariable(vv));
+		for (size_t ee = 0; ee < compiled_expressions.size(); ++ee) {
+			if (is_string_eq[ee]) continue;
+			used = used || compiled_expressions[ee].first.usesVariable(vv) || compiled_expressions[ee].second.usesVariable(vv);
+		}
+		if (used) doSubstitutions(ivec, variables[vv], columns[vv]);
 	}
 
-	for (size_t ii = 0; ii < ivec.size(); ++ii) {
-		if (skip_nodata && ivec[ii](param) == IOUtils::nodata)
-			continue; //not even a comparison to nodata is evaluated with this key
+	std::vector<char> active(nr_data, 1); //records that are processed
+	if (skip_nodata) { //not even a comparison to nodata is evaluated with this key
+		for (size_t ii = 0; ii < nr_data; ++ii)
+			active[ii] = (ivec[ii](param) != IOUtils::nodata);
+	}
 
-		doSubstitutions(ivec, ii); //do all substitutions
-		bool current_logic; //iterative result of AND resp. OR operations
-		if (logic_equations.empty())
-			current_logic = true; //no conditions --> always evaluate to true
-		else
-			current_logic = (connective == "OR"? false : true); //default: AND
-
-		for (it = logic_equations.begin(); it != logic_equations.end(); ++it) {
-			bool cond;
-			if (it->second.op.substr(0, 3) != "STR") { //arithmetic evaluation
-				double res_ex, res_cond;
-				res_ex = te_eval(compiled_expressions[it->first].first); //condition expression
-				res_cond = te_eval(compiled_expressions[it->first].second); //comparison expression
-				cond = assertCondition(res_ex, res_cond, it->second.op); //evaluate the complete condition
-			} else { //string evaluation
+	std::vector<char> current_logic(nr_data, 1); //iterative result of AND resp. OR operations
+	if (!logic_equations.empty() && connective == "OR")
+		current_logic.assign(nr_data, 0); //no conditions --> always evaluate to true, default: AND
+
+	std::vector<char> cond(nr_data, 0);
+	std::vector<double> res_ex(nr_data), res_cond(nr_data);
+	for (it = logic_equations.begin(), eq_idx = 0; it != logic_equations.end(); ++it, ++eq_idx) {
+		if (!is_string_eq[eq_idx]) { //arithmetic evaluation
+			bindSubstitutions(columns, compiled_expressions[eq_idx].first);
+			bindSubstitutions(columns, compiled_expressions[eq_idx].second);
+			compiled_expressions[eq_idx].first.evaluate(nr_data, &res_ex[0], &active[0]); //condition expression
+			compiled_expressions[eq_idx].second.evaluate(nr_data, &res_cond[0], &active[0]); //comparison expression
+			assertCondition(res_ex, res_cond, it->second.op, cond); //evaluate the complete condition
+		} else { //string evaluation
+			for (size_t ii = 0; ii < nr_data; ++ii) {
+				if (!active[ii]) continue;
 				const std::string tmp_exp( doStringSubstitutions(it->second.expression, ivec[ii]) );
-				cond = assertStringCondition(tmp_exp, it->second.compare, it->second.op);
+				cond[ii] = assertStringCondition(tmp_exp, it->second.compare, it->second.op);
 			}
-
-			if (connective == "OR")
-				current_logic = current_logic || cond;
-			else
-				current_logic = current_logic && cond;
 		}
 
-		double result;
-		if (current_logic) { //conditions evaluated to true together
-			result = te_eval(expr_formula);
-		} else { //conditions evaluated to false together
-			if (!formula_else.empty())
-				result = te_eval(expr_formula_else);
-			else
-				result = ivec[ii](param); //default: unchanged
+		if (connective == "OR") {
+			for (size_t ii = 0; ii < nr_data; ++ii) current_logic[ii] = current_logic[ii] || cond[ii];
+		} else {
+			for (size_t ii = 0; ii < nr_data; ++ii) current_logic[ii] = current_logic[ii] && cond[ii];
 		}
+	}
+
+	std::vector<double> results(nr_data);
+	std::vector<char> mask_then(nr_data), mask_else(nr_data);
+	for (size_t ii = 0; ii < nr_data; ++ii) {
+		results[ii] = ivec[ii](param); //default: unchanged
+		mask_then[ii] = active[ii] && current_logic[ii]; //conditions evaluated to true together
+		mask_else[ii] = active[ii] && !current_logic[ii]; //conditions evaluated to false together
+	}
+	bindSubstitutions(columns, expr_formula);
+	expr_formula.evaluate(nr_data, &results[0], &mask_then[0]);
+	if (expr_formula_else.isCompiled()) {
+		bindSubstitutions(columns, expr_formula_else);
+		expr_formula_else.evaluate(nr_data, &results[0], &mask_else[0]);
+	}
 
+	for (size_t ii = 0; ii < nr_data; ++ii) {
+		if (!active[ii]) continue;
+		const double result = results[ii];
 		if (assign_param.empty()) { //output to same parameter as the filter runs on
 			ovec[ii](param) = isNan(result)? IOUtils::nodata : result;
 		} else { //output to a different parameter
 			ovec[ii].addParameter(assign_param); //NOTE: will not be respected by filters running afterwards
 			ovec[ii](assign_param) = isNan(result)? IOUtils::nodata : result; //--> must be last filter!
 		}
-
 	} //endfor ii
-
-	std::map< size_t, std::pair<te_expr*, te_expr*> >::iterator it_expr; //cleanup
-	for (it_expr = compiled_expressions.begin(); it_expr != compiled_expressions.end(); ++it_expr) {
-		te_free(it_expr->second.first);
-		te_free(it_expr->second.second);
-	}
-	te_free(expr_formula);
-	if (!formula_else.empty())
-		te_free(expr_formula_else);
-	delete[] te_vars;
 }
 
 /**
- * @brief Test two values with a comparison operator.
- * @param[in] condition_value 1st part of condition: the value to compare against.
- * @param[in] condition_compare 2nd part of condition: the value to compare.
+ * @brief Test two series of values with a comparison operator.
+ * @param[in] condition_value 1st part of condition: the values to compare against.
+ * @param[in] condition_compare 2nd part of condition: the values to compare.
  * @param[in] condition_operator 3rd part of condition: the comparison operator.
- * @return if (condition_value condition_operator conditon_compare) then true.
+ * @param[out] cond for each index, true if (condition_value condition_operator conditon_compare).
  */
-bool FilterMaths::assertCondition(const double& condition_value, const double& condition_compare,
-        const std::string& condition_operator) const
+void FilterMaths::assertCondition(const std::vector<double>& condition_value, const std::vector<double>& condition_compare,
+        const std::string& condition_operator, std::vector<char>& cond) const
 {
+	const size_t nr_data = condition_value.size();
 	if (condition_operator == "LT") {
-		if (condition_value < condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] < condition_compare[ii]);
 	} else if (condition_operator == "LE") {
-		if (condition_value <= condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] <= condition_compare[ii]);
 	} else if (condition_operator == "GT") {
-		if (condition_value > condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] > condition_compare[ii]);
 	} else if (condition_operator == "GE") {
-		if (condition_value >= condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] >= condition_compare[ii]);
 	} else if (condition_operator == "EQ") {
-		if (condition_value == condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] == condition_compare[ii]);
 	} else if (condition_operator == "NE") {
-		if (condition_value != condition_compare)
-			return true;
+		for (size_t ii = 0; ii < nr_data; ++ii) cond[ii] = (condition_value[ii] != condition_compare[ii]);
+	} else {
+		cond.assign(nr_data, 0);
 	}
-	return false;
 }
 
 /**
@@ -283,37 +275,74 @@ void FilterMaths::buildSubstitutions()
 }
 
 /**
- * @brief Perform substitutions for all keys in the global map that do not have constant values.
+ * @brief Fill the values of a substitution for all records.
+ * @details Constant substitutions (and unknown names) are left empty, their value is taken from the global map.
+ * @param[in] ivec Meteo data.
+ * @param[in] name Name of the substitution, as found in the global map.
+ * @param[out] column Value of the substitution for each record.
  */
-void FilterMaths::doSubstitutions(const std::vector<MeteoData>& ivec, const size_t& idx)
+void FilterMaths::doSubstitutions(const std::vector<MeteoData>& ivec, const std::string& name, std::vector<double>& column) const
 {
+	const size_t nr_data = ivec.size();
+	column.resize(nr_data);
 	int year, month, day, hour, minute;
-	ivec[idx].date.getDate(year, month, day, hour, minute);
-	substitutions["year"] = (double)year;
-	substitutions["month"] = (double)month;
-	substitutions["day"] = (double)day;
-	substitutions["hour"] = (double)hour;
-	substitutions["minute"] = (double)minute;
-	substitutions["julian"] = ivec[idx].date.getJulian();
-	substitutions["altitude"] = ivec[idx].meta.getAltitude();
-	substitutions["azimuth"] = ivec[idx].meta.getAzimuth();
-	substitutions["slope"] = ivec[idx].meta.getSlopeAngle();
-	substitutions["latitude"] = ivec[idx].meta.getPosition().getLat();
-	substitutions["longitude"] = ivec[idx].meta.getPosition().getLon();
-	substitutions["easting"] = ivec[idx].meta.getPosition().getEasting();
-	substitutions["northing"] = ivec[idx].meta.getPosition().getNorthing();
-	//TODO: max, min?
 
-	std::map<std::string, double>::iterator it_sub;
-	for (it_sub = substitutions.begin(); it_sub != substitutions.end(); ++it_sub) {
-		if (it_sub->first.substr(0, 5) == "meteo") {
-			const size_t param_idx = ivec[idx].getParameterIndex( IOUtils::strToUpper(it_sub->first.substr(5)) );
+	if (name.compare(0, 5, "meteo") == 0) {
+		const std::string param_name( IOUtils::strToUpper(name.substr(5)) );
+		const size_t static_idx = MeteoData::getStaticParameterIndex(param_name); //standard parameters have the same index for all records
+		for (size_t ii = 0; ii < nr_data; ++ii) {
+			const size_t param_idx = (static_idx != IOUtils::npos)? static_idx : ivec[ii].getParameterIndex(param_name);
 			if (param_idx == IOUtils::npos) //parameter unavailable, nodata instead of error
-				it_sub->second = IOUtils::nodata;
+				column[ii] = IOUtils::nodata;
 			else
-				it_sub->second = ivec[idx](param_idx); //place values in tinyexpr memory location
-		} //endif "meteo"
-	} //endfor it_sub
+				column[ii] = ivec[ii](param_idx);
+		}
+	} else if (name == "year" || name == "month" || name == "day" || name == "hour" || name == "minute") {
+		int *field = &minute;
+		if (name == "year") field = &year;
+		else if (name == "month") field = &month;
+		else if (name == "day") field = &day;
+		else if (name == "hour") field = &hour;
+		for (size_t ii = 0; ii < nr_data; ++ii) {
+			ivec[ii].date.getDate(year, month, day, hour, minute);
+			column[ii] = (double)*field;
+		}
+	} else if (name == "julian") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].date.getJulian();
+	} else if (name == "altitude") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getAltitude();
+	} else if (name == "azimuth") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getAzimuth();
+	} else if (name == "slope") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getSlopeAngle();
+	} else if (name == "latitude") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getPosition().getLat();
+	} else if (name == "longitude") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getPosition().getLon();
+	} else if (name == "easting") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getPosition().getEasting();
+	} else if (name == "northing") {
+		for (size_t ii = 0; ii < nr_data; ++ii) column[ii] = ivec[ii].meta.getPosition().getNorthing();
+	} else { //constant parameters
+		column.clear();
+	}
+	//TODO: max, min?
+}
+
+/**
+ * @brief Bind the substitutions to the variables of an expression.
+ * @param[in] columns Values of the substitutions for all records (empty for constants), in the order of the global map.
+ * @param[in,out] expr Expression compiled with the substitutions as variables.
+ */
+void FilterMaths::bindSubstitutions(const std::vector< std::vector<double> >& columns, ColumnExpression& expr) const
+{
+	size_t vv = 0;
+	for (std::map<std::string, double>::const_iterator it_sub = substitutions.begin(); it_sub != substitutions.end(); ++it_sub, ++vv) {
+		if (!columns[vv].empty())
+			expr.bindColumn(vv, &columns[vv][0]);
+		else
+			expr.bindValue(vv, it_sub->second);
+	}
 }
 
 /**
@@ -331,40 +360,18 @@ std::string FilterMaths::doStringSubstitutions(const std::string& line_in, const
 }
 
 /**
- * @brief Helper function to call tinyexpr compilation and throw an error if this fails.
+ * @brief Helper function to compile an expression and throw an error if this fails.
  * @param[in] expression The arithmetic equation to compile.
- * @param[in] te_vars Substitutions carried out in the model expression (variables).
- * @param[in] sz Number of substitutions.
- * @return The compiled tinyexpr expression ready to evaluate the function.
+ * @param[in] variables Substitutions carried out in the model expression (variables).
+ * @param[out] expr The compiled expression ready to evaluate the function.
  */
-te_expr* FilterMaths::compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const
+void FilterMaths::compileExpression(const std::string& expression, const std::vector<std::string>& variables, ColumnExpression& expr) const
 { //ready the lazy expressions (with syntax check)
 	const std::string where("Filters::" + block_name);
 	int te_err;
-	te_expr *expr = te_compile(expression.c_str(), te_vars, (int)sz, &te_err);
-	if (!expr)
+	if (!expr.compile(expression, variables, te_err))
 		throw InvalidFormatException("Arithmetic expression \"" + expression +
 		        "\" could not be evaluated for " + where + "; parse error at " + IOUtils::toString(te_err), AT);
-	return expr;
-}
-
-/**
- * @brief Helper function to put substitutions in tinyexpr's format.
- * @details This will iterate through the global substitutions map and put the substitutions in tinyexpr's format.
- * @param[out] vars Tinyexpr formatted substitutions.
- */
-void FilterMaths::initExpressionVars(te_variable* vars)
-{ //build a substitutions expression for tinyexpr
-
-	std::map<std::string, double>::iterator it;
-	size_t cc = 0;
-	for (it = substitutions.begin(); it != substitutions.end(); ++it) {
-		vars[cc].name = it->first.c_str();
-		vars[cc].address = &it->second;
-		vars[cc].type = 0;
-		vars[cc].context = nullptr;
-		cc++;
-	}
 }
 
 /**
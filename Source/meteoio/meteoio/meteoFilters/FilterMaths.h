@@ -22,7 +22,7 @@
 
 #include <meteoio/meteoFilters/ProcessingBlock.h>
 
-#include <meteoio/thirdParty/tinyexpr.h>
+#include <meteoio/meteoStats/libexpression.h>
 #include <map>
 
 namespace mio {
@@ -222,15 +222,15 @@ class FilterMaths : public ProcessingBlock {
 		    std::vector<MeteoData>& ovec);
 
 	private:
-		bool assertCondition(const double& condition_value, const double& condition_compare,
-		        const std::string& condition_operator) const;
+		void assertCondition(const std::vector<double>& condition_value, const std::vector<double>& condition_compare,
+		        const std::string& condition_operator, std::vector<char>& cond) const;
 		bool assertStringCondition(const std::string& line1, const std::string& line2, const std::string& op);
 		std::map<std::string, double> parseBracketExpression(std::string& line);
 		void buildSubstitutions();
-		void doSubstitutions(const std::vector<MeteoData>& ivec, const size_t& idx);
+		void doSubstitutions(const std::vector<MeteoData>& ivec, const std::string& name, std::vector<double>& column) const;
+		void bindSubstitutions(const std::vector< std::vector<double> >& columns, ColumnExpression& expr) const;
 		std::string doStringSubstitutions(const std::string& line_in, const MeteoData& ielem) const;
-		te_expr* compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const;
-		void initExpressionVars(te_variable* vars);
+		void compileExpression(const std::string& expression, const std::vector<std::string>& variables, ColumnExpression& expr) const;
 		void parse_args(const std::vector< std::pair<std::string, std::string> >& vecArgs);
 		bool isNan(const double& xx) const;
 		void checkOperator(const std::string& op);
@@ -242,7 +242,7 @@ class FilterMaths : public ProcessingBlock {
 			logic_eq() : expression(""), op(""), compare("") {}
 		};
 		std::map<size_t, logic_eq> logic_equations; //collection of conditions the user supplies
-		std::map<std::string, double> substitutions; //fixed memory for substitutions
+		std::map<std::string, double> substitutions; //all substitutions, with the values of the constant ones
 
 		std::string formula; //calculation expression
 		std::string formula_else; //expression to use when evaluating to false
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/meteoStats/GridRemapper.h>
+#include <meteoio/IOExceptions.h>
+#include <meteoio/IOUtils.h>
+#include <meteoio/Tracing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace mio {
+
+const char GridRemapper::magic[8] = {'M', 'I', 'O', 'R', 'E', 'M', 'A', 'P'};
+
+/**
+* @brief Constructor
+* @param i_method remapping method
+* @param i_cache_dir existing directory where to write/read the remapping operators (default: empty, so they are only kept in memory)
+*/
+GridRemapper::GridRemapper(const RemapMethod& i_method, const std::string& i_cache_dir)
+             : operators(), cache_dir(i_cache_dir), method(i_method), nr_built(0) {}
+
+GridRemapper::RemapMethod GridRemapper::getMethod(const std::string& method_name)
+{
+	const std::string name( IOUtils::strToUpper(method_name) );
+	if (name=="NEAREST") return NEAREST;
+	if (name=="BILINEAR") return BILINEAR;
+	if (name=="CONSERVATIVE") return CONSERVATIVE;
+
+	throw InvalidArgumentException("Unknown grid remapping method '"+method_name+"'", AT);
+}
+
+std::string GridRemapper::getMethodName(const RemapMethod& i_method)
+{
+	if (i_method==NEAREST) return "NEAREST";
+	if (i_method==BILINEAR) return "BILINEAR";
+	return "CONSERVATIVE";
+}
+
+/**
+* @brief Remap a grid onto the geolocalization of another grid
+* @param[in] source grid to remap
+* @param[in] target grid providing the geolocalization (for example, the DEM). Its data is not used.
+* @param[out] result remapped grid, with the same geolocalization as target
+*/
+void GridRemapper::remap(const Grid2DObject& source, const Grid2DObject& target, Grid2DObject& result)
+{
+	MIO_TRACE_ZONE("MeteoIO", "GridRemapper::remap");
+	if (source.empty())
+		throw NoDataException("Can not remap an empty grid", AT);
+	if (target.empty())
+		throw InvalidArgumentException("Can not remap a grid onto an empty target grid", AT);
+
+	const RemapOperator& op = getOperator(source, target);
+	result.set(target, IOUtils::nodata);
+	apply(op, source, result);
+}
+
+////////////////////////////////////////////////////////////
+//// End of public methods
+
+const GridRemapper::RemapOperator& GridRemapper::getOperator(const Grid2DObject& source, const Grid2DObject& target)
+{
+	const std::string key( getGeometryKey(source, target) );
+	const std::map<std::string, RemapOperator>::const_iterator it( operators.find(key) );
+	if (it!=operators.end()) return it->second;
+
+	RemapOperator& op = operators[key];
+	if (!cache_dir.empty() && readCache(key, op)) return op;
+
+	buildOperator(source, target, op);
+	nr_built++;
+	if (!cache_dir.empty()) {
+		try {
+			writeCache(key, op);
+		} catch (const std::exception& e) { //the cache is only an optimization, we can go on without it
+			std::cerr << "[W] Could not write the grid remapping operator to '" << cache_dir << "': " << e.what() << "\n";
+		}
+	}
+	return op;
+}
+
+/**
+* @brief Compute the (fractional) indices in the source grid of a point given by its (fractional) indices in the target grid
+*/
+void GridRemapper::getSourceIndices(const Grid2DObject& source, const Grid2DObject& target, const double& ii, const double& jj, double& fx, double& fy)
+{
+	const bool target_latlon = (target.isLatLon && target.ur_lat!=IOUtils::nodata && target.ur_lon!=IOUtils::nodata);
+	const bool source_latlon = (source.isLatLon && source.ur_lat!=IOUtils::nodata && source.ur_lon!=IOUtils::nodata);
+
+	if (!target_latlon && !source_latlon && target.llcorner.isSameProj(source.llcorner)) { //simple arithmetics
+		const double easting = target.llcorner.getEasting() + ii*target.cellsize;
+		const double northing = target.llcorner.getNorthing() + jj*target.cellsize;
+		fx = (easting - source.llcorner.getEasting()) / source.cellsize;
+		fy = (northing - source.llcorner.getNorthing()) / source.cellsize;
+		return;
+	}
+
+	//otherwise, we go through lat/lon
+	Coords point( target.llcorner );
+	if (target_latlon) {
+		const double lat = target.llcorner.getLat() + jj*(target.ur_lat - target.llcorner.getLat()) / static_cast<double>(std::max(target.getNy(), (size_t)2)-1);
+		const double lon = target.llcorner.getLon() + ii*(target.ur_lon - target.llcorner.getLon()) / static_cast<double>(std::max(target.getNx(), (size_t)2)-1);
+		point.setLatLon(lat, lon, IOUtils::nodata);
+	} else {
+		point.setXY(target.llcorner.getEasting() + ii*target.cellsize, target.llcorner.getNorthing() + jj*target.cellsize, IOUtils::nodata);
+	}
+
+	if (source_latlon) {
+		fx = (point.getLon() - source.llcorner.getLon()) / (source.ur_lon - source.llcorner.getLon()) * static_cast<double>(std::max(source.getNx(), (size_t)2)-1);
+		fy = (point.getLat() - source.llcorner.getLat()) / (source.ur_lat - source.llcorner.getLat()) * static_cast<double>(std::max(source.getNy(), (size_t)2)-1);
+	} else {
+		point.copyProj(source.llcorner); //getting the east/north coordinates in the source grid's projection
+		fx = (point.getEasting() - source.llcorner.getEasting()) / source.cellsize;
+		fy = (point.getNorthing() - source.llcorner.getNorthing()) / source.cellsize;
+	}
+}
+
+/**
+* @brief Compute the remapping operator
+* @details In the source grid, cell (k,l) is centered on the indices (k,l) and extends by half a cell on each side.
+*/
+void GridRemapper::buildOperator(const Grid2DObject& source, const Grid2DObject& target, RemapOperator& op) const
+{
+	MIO_TRACE_ZONE("MeteoIO", "GridRemapper::buildOperator");
+	const size_t src_nx = source.getNx(), src_ny = source.getNy();
+	const size_t nx = target.getNx(), ny = target.getNy();
+	const double x_max = static_cast<double>(src_nx) - 0.5, y_max = static_cast<double>(src_ny) - 0.5;
+
+	//position of the target cells' centers (and corners for the conservative method) in the source grid
+	std::vector<double> fx(nx*ny), fy(nx*ny);
+	for (size_t jj=0; jj<ny; jj++) {
+		for (size_t ii=0; ii<nx; ii++)
+			getSourceIndices(source, target, static_cast<double>(ii), static_cast<double>(jj), fx[ii+jj*nx], fy[ii+jj*nx]);
+	}
+	std::vector<double> cx, cy;
+	if (method==CONSERVATIVE) {
+		cx.resize((nx+1)*(ny+1));
+		cy.resize((nx+1)*(ny+1));
+		for (size_t jj=0; jj<=ny; jj++) {
+			for (size_t ii=0; ii<=nx; ii++)
+				getSourceIndices(source, target, static_cast<double>(ii)-0.5, static_cast<double>(jj)-0.5, cx[ii+jj*(nx+1)], cy[ii+jj*(nx+1)]);
+		}
+	}
+
+	op.src_count = src_nx*src_ny;
+	op.row_ptr.assign(1, 0);
+	op.cols.clear();
+	op.weights.clear();
+	op.row_ptr.reserve(nx*ny+1);
+
+	for (size_t jj=0; jj<ny; jj++) {
+		for (size_t ii=0; ii<nx; ii++) {
+			const double x = fx[ii+jj*nx], y = fy[ii+jj*nx];
+			const bool inside = (x>=-0.5 && x<=x_max && y>=-0.5 && y<=y_max);
+
+			if (method==NEAREST) {
+				if (inside) {
+					const size_t k = std::min(static_cast<size_t>(std::max(floor(x+0.5), 0.)), src_nx-1);
+					const size_t l = std::min(static_cast<size_t>(std::max(floor(y+0.5), 0.)), src_ny-1);
+					op.cols.push_back( k + l*src_nx );
+					op.weights.push_back( 1. );
+				}
+			} else if (method==BILINEAR) {
+				if (inside) {
+					const double xc = std::min(std::max(x, 0.), static_cast<double>(src_nx-1));
+					const double yc = std::min(std::max(y, 0.), static_cast<double>(src_ny-1));
+					const size_t k0 = (src_nx>1)? std::min(static_cast<size_t>(xc), src_nx-2) : 0;
+					const size_t l0 = (src_ny>1)? std::min(static_cast<size_t>(yc), src_ny-2) : 0;
+					const size_t k1 = std::min(k0+1, src_nx-1), l1 = std::min(l0+1, src_ny-1);
+					const double tx = xc - static_cast<double>(k0), ty = yc - static_cast<double>(l0);
+					const size_t idx[4] = {k0+l0*src_nx, k1+l0*src_nx, k0+l1*src_nx, k1+l1*src_nx};
+					const double w[4] = {(1.-tx)*(1.-ty), tx*(1.-ty), (1.-tx)*ty, tx*ty};
+					for (size_t nn=0; nn<4; nn++) {
+						if (w[nn]<=0.) continue;
+						op.cols.push_back( idx[nn] );
+						op.weights.push_back( w[nn] );
+					}
+				}
+			} else { //CONSERVATIVE
+				const size_t c00 = ii+jj*(nx+1), c10 = c00+1, c01 = c00+nx+1, c11 = c01+1;
+				const double xmin = std::max(std::min(std::min(cx[c00], cx[c10]), std::min(cx[c01], cx[c11])), -0.5);
+				const double xmax = std::min(std::max(std::max(cx[c00], cx[c10]), std::max(cx[c01], cx[c11])), x_max);
+				const double ymin = std::max(std::min(std::min(cy[c00], cy[c10]), std::min(cy[c01], cy[c11])), -0.5);
+				const double ymax = std::min(std::max(std::max(cy[c00], cy[c10]), std::max(cy[c01], cy[c11])), y_max);
+				if (xmax>xmin && ymax>ymin) {
+					const size_t k0 = static_cast<size_t>(floor(xmin+0.5)), k1 = std::min(static_cast<size_t>(floor(xmax+0.5)), src_nx-1);
+					const size_t l0 = static_cast<size_t>(floor(ymin+0.5)), l1 = std::min(static_cast<size_t>(floor(ymax+0.5)), src_ny-1);
+					for (size_t l=l0; l<=l1; l++) {
+						const double oy = std::min(ymax, static_cast<double>(l)+0.5) - std::max(ymin, static_cast<double>(l)-0.5);
+						if (oy<=0.) continue;
+						for (size_t k=k0; k<=k1; k++) {
+							const double ox = std::min(xmax, static_cast<double>(k)+0.5) - std::max(xmin, static_cast<double>(k)-0.5);
+							if (ox<=0.) continue;
+							op.cols.push_back( k + l*src_nx );
+							op.weights.push_back( ox*oy );
+						}
+					}
+				}
+			}
+
+			op.row_ptr.push_back( op.cols.size() );
+		}
+	}
+}
+
+/**
+* @brief Apply a remapping operator, as a sparse matrix - vector product
+*/
+void GridRemapper::apply(const RemapOperator& op, const Grid2DObject& source, Grid2DObject& result)
+{
+	const size_t nr_rows = op.row_ptr.size() - 1;
+	if (source.getNx()*source.getNy()!=op.src_count || result.getNx()*result.getNy()!=nr_rows) //getCount() would skip the nodata cells
+		throw InvalidArgumentException("The grid remapping operator does not match the grids' dimensions", AT);
+
+	#pragma omp parallel for schedule(static)
+	for (size_t row=0; row<nr_rows; row++) {
+		double sum = 0., sum_weights = 0.;
+		for (size_t nn=op.row_ptr[row]; nn<op.row_ptr[row+1]; nn++) {
+			const double value = source.grid2D( op.cols[nn] );
+			if (value==IOUtils::nodata) continue;
+			sum += op.weights[nn] * value;
+			sum_weights += op.weights[nn];
+		}
+		result.grid2D(row) = (sum_weights>0.)? sum / sum_weights : IOUtils::nodata;
+	}
+}
+
+std::string GridRemapper::getGeometry(const Grid2DObject& grid)
+{
+	std::string proj_type, proj_args;
+	grid.llcorner.getProj(proj_type, proj_args);
+
+	std::ostringstream os;
+	os << std::setprecision(12);
+	os << grid.getNx() << "x" << grid.getNy() << " cellsize=" << grid.cellsize;
+	os << " proj=" << proj_type << " " << proj_args;
+	os << " ll=" << grid.llcorner.getEasting() << "," << grid.llcorner.getNorthing() << " (" << grid.llcorner.getLat() << "," << grid.llcorner.getLon() << ")";
+	if (grid.isLatLon) os << " ur=(" << grid.ur_lat << "," << grid.ur_lon << ")";
+	return os.str();
+}
+
+std::string GridRemapper::getGeometryKey(const Grid2DObject& source, const Grid2DObject& target) const
+{
+	return getMethodName(method) + " from " + getGeometry(source) + " to " + getGeometry(target);
+}
+
+/**
+* @brief Build the name of the cache file from a hash of the geometry key (FNV-1a)
+*/
+std::string GridRemapper::getCacheFilename(const std::string& key) const
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t ii=0; ii<key.size(); ii++) {
+		hash ^= static_cast<unsigned char>(key[ii]);
+		hash *= 1099511628211ULL;
+	}
+
+	std::ostringstream os;
+	os << cache_dir << "/remap_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+	return os.str();
+}
+
+/**
+* @brief Read a remapping operator from the cache directory
+* @return false if there is no valid cache file for this pair of geometries
+*/
+bool GridRemapper::readCache(const std::string& key, RemapOperator& op) const
+{
+	std::ifstream fin(getCacheFilename(key).c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	char file_magic[8];
+	unsigned long long key_len = 0;
+	fin.read(file_magic, sizeof(file_magic));
+	fin.read(reinterpret_cast<char*>(&key_len), sizeof(key_len));
+	if (fin.fail() || memcmp(file_magic, magic, sizeof(magic))!=0 || key_len!=key.size()) return false;
+
+	std::string file_key(key.size(), ' ');
+	if (!key.empty()) fin.read(&file_key[0], static_cast<std::streamsize>(key.size()));
+	if (fin.fail() || file_key!=key) return false; //hash collision or different geometry
+
+	unsigned long long header[3]; //src_count, nr_rows, nr_entries
+	fin.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (fin.fail()) return false;
+
+	std::vector<unsigned long long> row_ptr(header[1]+1), cols(header[2]);
+	std::vector<double> weights(header[2]);
+	fin.read(reinterpret_cast<char*>(&row_ptr[0]), static_cast<std::streamsize>(row_ptr.size()*sizeof(unsigned long long)));
+	if (header[2]>0) {
+		fin.read(reinterpret_cast<char*>(&cols[0]), static_cast<std::streamsize>(cols.size()*sizeof(unsigned long long)));
+		fin.read(reinterpret_cast<char*>(&weights[0]), static_cast<std::streamsize>(weights.size()*sizeof(double)));
+	}
+	if (fin.fail() || row_ptr.back()!=header[2]) return false;
+
+	op.src_count = static_cast<size_t>(header[0]);
+	op.row_ptr.assign(row_ptr.begin(), row_ptr.end());
+	op.cols.assign(cols.begin(), cols.end());
+	op.weights.swap(weights);
+	return true;
+}
+
+/**
+* @brief Write a remapping operator into the cache directory. The file is first written under a temporary name and
+* then renamed, so an interrupted run never leaves a truncated file behind.
+*/
+void GridRemapper::writeCache(const std::string& key, const RemapOperator& op) const
+{
+	const std::string filename( getCacheFilename(key) );
+	const std::string tmp_filename( filename + ".tmp" );
+	{
+		std::ofstream fout(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+		if (fout.fail()) throw AccessException(tmp_filename, AT);
+
+		const unsigned long long key_len = key.size();
+		const unsigned long long header[3] = {op.src_count, op.row_ptr.size()-1, op.cols.size()};
+		const std::vector<unsigned long long> row_ptr(op.row_ptr.begin(), op.row_ptr.end()), cols(op.cols.begin(), op.cols.end());
+
+		fout.write(magic, sizeof(magic));
+		fout.write(reinterpret_cast<const char*>(&key_len), sizeof(key_len));
+		fout.write(key.c_str(), static_cast<std::streamsize>(key.size()));
+		fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+		fout.write(reinterpret_cast<const char*>(&row_ptr[0]), static_cast<std::streamsize>(row_ptr.size()*sizeof(unsigned long long)));
+		if (!cols.empty()) {
+			fout.write(reinterpret_cast<const char*>(&cols[0]), static_cast<std::streamsize>(cols.size()*sizeof(unsigned long long)));
+			fout.write(reinterpret_cast<const char*>(&op.weights[0]), static_cast<std::streamsize>(op.weights.size()*sizeof(double)));
+		}
+		if (fout.fail()) throw AccessException("Could not write "+tmp_filename, AT);
+	}
+	if (std::rename(tmp_filename.c_str(), filename.c_str())!=0)
+		throw AccessException("Could not rename "+tmp_filename+" to "+filename, AT);
+}
+
+} //namespace
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2020 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef GRIDREMAPPER_H
+#define GRIDREMAPPER_H
+
+#include <meteoio/dataClasses/Grid2DObject.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mio {
+
+/**
+ * @class GridRemapper
+ * @brief Remap grids from one geolocalization (for example lat/lon NWP output, or another projection) onto a target grid (usually the DEM).
+ * @details For each pair of source grid geometry and target grid geometry, the remapping is described by a sparse operator
+ * (each target cell being a weighted sum of source cells) that is built only once and then applied to every grid with
+ * the same geometry, whatever the parameter or the timestep. The operators are kept in memory and, if a cache directory has been
+ * provided, also written there so the following runs do not have to compute them again (the file contains a description of both
+ * geometries that is checked when reading it back).
+ *
+ * The following remapping methods are available:
+ *     - NEAREST: each target cell gets the value of the closest source cell;
+ *     - BILINEAR: bilinear interpolation between the four source cells surrounding the target cell (default);
+ *     - CONSERVATIVE: area weighted average of the source cells that overlap the target cell (the footprint of the target cell
+ *       in the source grid is approximated by the bounding box of its corners). This preserves the spatial means and should be
+ *       preferred for precipitation or when the target cells are larger than the source cells.
+ *
+ * The source cells containing nodata are skipped and the weights of the other cells renormalized, so a target cell only becomes
+ * nodata when all of its contributing source cells are nodata (or when it lies outside of the source grid).
+ *
+ * @ingroup stats
+ */
+class GridRemapper {
+	public:
+		typedef enum REMAP_METHOD {
+			NEAREST, ///< nearest source cell
+			BILINEAR, ///< bilinear interpolation
+			CONSERVATIVE ///< area weighted average
+		} RemapMethod;
+
+		GridRemapper(const RemapMethod& i_method=BILINEAR, const std::string& i_cache_dir="");
+
+		static RemapMethod getMethod(const std::string& method_name);
+		static std::string getMethodName(const RemapMethod& method);
+
+		void remap(const Grid2DObject& source, const Grid2DObject& target, Grid2DObject& result);
+
+		RemapMethod getMethod() const {return method;}
+		size_t getNrBuilt() const {return nr_built;} ///< number of operators that had to be computed (ie not found in memory or on disk)
+		void clear() {operators.clear();}
+
+	private:
+		///sparse remapping operator in compressed row format: one row per target cell
+		typedef struct REMAP_OPERATOR {
+			REMAP_OPERATOR() : row_ptr(), cols(), weights(), src_count(0) {}
+			std::vector<size_t> row_ptr;
+			std::vector<size_t> cols;
+			std::vector<double> weights;
+			size_t src_count;
+		} RemapOperator;
+
+		const RemapOperator& getOperator(const Grid2DObject& source, const Grid2DObject& target);
+		void buildOperator(const Grid2DObject& source, const Grid2DObject& target, RemapOperator& op) const;
+		static void getSourceIndices(const Grid2DObject& source, const Grid2DObject& target, const double& ii, const double& jj, double& fx, double& fy);
+		static void apply(const RemapOperator& op, const Grid2DObject& source, Grid2DObject& result);
+
+		std::string getGeometryKey(const Grid2DObject& source, const Grid2DObject& target) const;
+		static std::string getGeometry(const Grid2DObject& grid);
+		std::string getCacheFilename(const std::string& key) const;
+		bool readCache(const std::string& key, RemapOperator& op) const;
+		void writeCache(const std::string& key, const RemapOperator& op) const;
+
+		static const char magic[8];
+
+		std::map<std::string, RemapOperator> operators; ///< operators already built, by geometry key
+		std::string cache_dir;
+		RemapMethod method;
+		size_t nr_built;
+};
+
+} //end namespace
+
+#endif
@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/meteoStats/libexpression.h>
+#include <meteoio/thirdParty/tinyexpr.h>
+#include <meteoio/IOUtils.h>
+#include <meteoio/IOExceptions.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mio {
+
+//the node types of tinyexpr that we need to recognize (the arity is in the lower bits)
+static const int te_type_mask = 0x1F;
+static const int te_arity_mask = 0x07;
+
+typedef double (*te_fun0)();
+typedef double (*te_fun1)(double);
+typedef double (*te_fun2)(double, double);
+typedef double (*te_fun3)(double, double, double);
+typedef double (*te_fun4)(double, double, double, double);
+typedef double (*te_fun5)(double, double, double, double, double);
+typedef double (*te_fun6)(double, double, double, double, double, double);
+typedef double (*te_fun7)(double, double, double, double, double, double, double);
+
+const size_t ColumnExpression::block_size; //std::min() takes it by reference, so it needs a definition
+
+ColumnExpression::ColumnExpression() : program(), columns(), values(), max_depth(0) {}
+
+bool ColumnExpression::compile(const std::string& expression, const std::vector<std::string>& variables, int& error)
+{
+	program.clear();
+	max_depth = 0;
+	columns.assign(variables.size(), nullptr);
+	values.assign(variables.size(), IOUtils::nodata);
+
+	//tinyexpr binds each variable to an address: we give it the addresses of a dummy array so we can
+	//find back the index of each variable in the syntax tree
+	const std::vector<double> slots(variables.size(), 0.);
+	std::vector<te_variable> te_vars(variables.size());
+	for (size_t ii=0; ii<variables.size(); ii++) {
+		te_vars[ii].name = variables[ii].c_str();
+		te_vars[ii].address = &slots[ii];
+		te_vars[ii].type = TE_VARIABLE;
+		te_vars[ii].context = nullptr;
+	}
+
+	te_expr *expr = te_compile(expression.c_str(), te_vars.empty()? nullptr : &te_vars[0], static_cast<int>(te_vars.size()), &error);
+	if (!expr) return false;
+
+	const bool success = translate(expr, slots, 0);
+	te_free(expr);
+	if (!success) {
+		program.clear();
+		error = 1; //the expression contains constructs that we can not translate
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Append the instructions for a node of tinyexpr's syntax tree (and all its children) to the program.
+ * @param[in] node tinyexpr node
+ * @param[in] slots the addresses that have been bound to the variables
+ * @param[in] depth depth of the stack before the node is evaluated
+ * @return false if the node could not be translated
+ */
+bool ColumnExpression::translate(const void* node, const std::vector<double>& slots, size_t depth)
+{
+	const te_expr *nn = static_cast<const te_expr*>(node);
+	if (te_is_constant(nn)) {
+		Instruction instr(PUSH_CONST);
+		instr.value = nn->value;
+		program.push_back(instr);
+		max_depth = std::max(max_depth, depth+1);
+		return true;
+	}
+
+	const int type = nn->type & te_type_mask;
+	if (type == TE_VARIABLE) {
+		if (slots.empty() || nn->bound < &slots.front() || nn->bound > &slots.back()) return false;
+		Instruction instr(PUSH_VAR);
+		instr.idx = static_cast<size_t>(nn->bound - &slots.front());
+		program.push_back(instr);
+		max_depth = std::max(max_depth, depth+1);
+		return true;
+	}
+
+	if (type < TE_FUNCTION0 || type > TE_FUNCTION7) return false; //closures are not supported
+	const size_t arity = static_cast<size_t>(type & te_arity_mask);
+	for (size_t ii=0; ii<arity; ii++) { //the arguments are pushed from left to right
+		if (!translate(nn->parameters[ii], slots, depth+ii)) return false;
+	}
+
+	const char op = te_operator(nn->function);
+	Instruction instr(CALL_N);
+	if (arity==2 && op=='+') instr.op = ADD;
+	else if (arity==2 && op=='-') instr.op = SUB;
+	else if (arity==2 && op=='*') instr.op = MUL;
+	else if (arity==2 && op=='/') instr.op = DIV;
+	else if (arity==2 && op=='^') instr.op = POW;
+	else if (arity==2 && op=='%') instr.op = MOD;
+	else if (arity==2 && op==',') instr.op = COMMA;
+	else if (arity==1 && op=='n') instr.op = NEG;
+	else {
+		if (arity==0) instr.op = CALL0;
+		else if (arity==1) instr.op = CALL1;
+		else if (arity==2) instr.op = CALL2;
+		instr.idx = arity;
+		instr.function = nn->function;
+	}
+	program.push_back(instr);
+	max_depth = std::max(max_depth, depth+1);
+	return true;
+}
+
+bool ColumnExpression::usesVariable(const size_t& idx) const
+{
+	for (size_t ii=0; ii<program.size(); ii++) {
+		if (program[ii].op==PUSH_VAR && program[ii].idx==idx) return true;
+	}
+	return false;
+}
+
+void ColumnExpression::bindColumn(const size_t& idx, const double* data)
+{
+	if (idx >= columns.size())
+		throw IndexOutOfBoundsException("Variable index "+IOUtils::toString(idx)+" does not exist in the expression", AT);
+	columns[idx] = data;
+}
+
+void ColumnExpression::bindValue(const size_t& idx, const double& value)
+{
+	if (idx >= columns.size())
+		throw IndexOutOfBoundsException("Variable index "+IOUtils::toString(idx)+" does not exist in the expression", AT);
+	columns[idx] = nullptr;
+	values[idx] = value;
+}
+
+void ColumnExpression::evaluate(const size_t& nr_values, double* results, const char* mask) const
+{
+	if (program.empty())
+		throw InvalidArgumentException("The expression must be compiled before being evaluated", AT);
+
+	std::vector<double> stack(max_depth * block_size);
+	for (size_t offset=0; offset<nr_values; offset+=block_size) {
+		const size_t nn = std::min(block_size, nr_values-offset);
+		if (mask) { //skip the blocks that are fully masked out
+			bool active = false;
+			for (size_t kk=0; kk<nn; kk++) {
+				if (mask[offset+kk]) {
+					active = true;
+					break;
+				}
+			}
+			if (!active) continue;
+		}
+
+		run(offset, nn, &stack[0]);
+
+		if (mask) {
+			for (size_t kk=0; kk<nn; kk++)
+				if (mask[offset+kk]) results[offset+kk] = stack[kk];
+		} else {
+			for (size_t kk=0; kk<nn; kk++) results[offset+kk] = stack[kk];
+		}
+	}
+}
+
+/**
+ * @brief Run the program over one block of values
+ * @param[in] offset index of the first value of the block in the bound columns
+ * @param[in] nn number of values in the block
+ * @param[in] stack storage for max_depth*block_size values, the result is left in the first block_size values
+ */
+void ColumnExpression::run(const size_t& offset, const size_t& nn, double* stack) const
+{
+	size_t sp = 0; //number of blocks currently on the stack
+	for (size_t ii=0; ii<program.size(); ii++) {
+		const Instruction& instr = program[ii];
+		double* top = stack + sp*block_size; //next free block
+		double* a = (sp>=2)? top - 2*block_size : nullptr; //first argument of binary operators
+		double* b = (sp>=1)? top - block_size : nullptr; //second argument of binary operators, argument of unary operators
+
+		switch (instr.op) {
+			case PUSH_CONST:
+				for (size_t kk=0; kk<nn; kk++) top[kk] = instr.value;
+				sp++;
+				break;
+			case PUSH_VAR: {
+				const double* col = columns[instr.idx];
+				if (col) {
+					col += offset;
+					for (size_t kk=0; kk<nn; kk++) top[kk] = col[kk];
+				} else {
+					const double value = values[instr.idx];
+					for (size_t kk=0; kk<nn; kk++) top[kk] = value;
+				}
+				sp++;
+				break;
+			}
+			case ADD:
+				for (size_t kk=0; kk<nn; kk++) a[kk] += b[kk];
+				sp--;
+				break;
+			case SUB:
+				for (size_t kk=0; kk<nn; kk++) a[kk] -= b[kk];
+				sp--;
+				break;
+			case MUL:
+				for (size_t kk=0; kk<nn; kk++) a[kk] *= b[kk];
+				sp--;
+				break;
+			case DIV:
+				for (size_t kk=0; kk<nn; kk++) a[kk] /= b[kk];
+				sp--;
+				break;
+			case POW:
+				for (size_t kk=0; kk<nn; kk++) a[kk] = std::pow(a[kk], b[kk]);
+				sp--;
+				break;
+			case MOD:
+				for (size_t kk=0; kk<nn; kk++) a[kk] = std::fmod(a[kk], b[kk]);
+				sp--;
+				break;
+			case COMMA:
+				for (size_t kk=0; kk<nn; kk++) a[kk] = b[kk];
+				sp--;
+				break;
+			case NEG:
+				for (size_t kk=0; kk<nn; kk++) b[kk] = -b[kk];
+				break;
+			case CALL0: {
+				const double value = reinterpret_cast<te_fun0>(instr.function)();
+				for (size_t kk=0; kk<nn; kk++) top[kk] = value;
+				sp++;
+				break;
+			}
+			case CALL1: {
+				const te_fun1 fun = reinterpret_cast<te_fun1>(instr.function);
+				for (size_t kk=0; kk<nn; kk++) b[kk] = fun(b[kk]);
+				break;
+			}
+			case CALL2: {
+				const te_fun2 fun = reinterpret_cast<te_fun2>(instr.function);
+				for (size_t kk=0; kk<nn; kk++) a[kk] = fun(a[kk], b[kk]);
+				sp--;
+				break;
+			}
+			case CALL_N: { //functions with 3 to 7 arguments, none of them are built-in but we support them for completeness
+				const size_t arity = instr.idx;
+				double* args = top - arity*block_size;
+				for (size_t kk=0; kk<nn; kk++) {
+					const double* x = args + kk;
+					double res;
+					switch (arity) {
+						case 3: res = reinterpret_cast<te_fun3>(instr.function)(x[0], x[block_size], x[2*block_size]); break;
+						case 4: res = reinterpret_cast<te_fun4>(instr.function)(x[0], x[block_size], x[2*block_size], x[3*block_size]); break;
+						case 5: res = reinterpret_cast<te_fun5>(instr.function)(x[0], x[block_size], x[2*block_size], x[3*block_size], x[4*block_size]); break;
+						case 6: res = reinterpret_cast<te_fun6>(instr.function)(x[0], x[block_size], x[2*block_size], x[3*block_size], x[4*block_size], x[5*block_size]); break;
+						default: res = reinterpret_cast<te_fun7>(instr.function)(x[0], x[block_size], x[2*block_size], x[3*block_size], x[4*block_size], x[5*block_size], x[6*block_size]); break;
+					}
+					args[kk] = res;
+				}
+				sp -= arity-1;
+				break;
+			}
+		}
+	}
+}
+
+} //namespace
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef LIBEXPRESSION_H
+#define LIBEXPRESSION_H
+
+#include <vector>
+#include <string>
+
+namespace mio {
+
+/**
+ * @class ColumnExpression
+ * @brief Evaluate an arithmetic expression over whole arrays of values.
+ * @details The expression is parsed by tinyexpr (so the syntax, the functions and the constants are exactly the
+ * ones documented in FilterMaths) and its syntax tree is then flattened into a list of instructions for a small
+ * stack machine. Each instruction is applied to a block of values at once, so the arithmetic operators run as plain
+ * loops over contiguous memory (that the compiler can vectorize) instead of walking the syntax tree for each value.
+ *
+ * The variables of the expression are given by name when compiling it and are then bound either to an array of
+ * values (for example a meteorological parameter for all the timesteps or a row of a grid) or to a single value
+ * that is the same for all the evaluations. Unbound variables are evaluated as IOUtils::nodata.
+ * @code
+ * std::vector<std::string> vars;
+ * vars.push_back("ta"); vars.push_back("offset");
+ * ColumnExpression expr;
+ * int err;
+ * if (!expr.compile("ta * 5/9 + offset", vars, err)) throw InvalidFormatException("Parse error at "+IOUtils::toString(err), AT);
+ * expr.bindColumn(0, &ta[0]);
+ * expr.bindValue(1, 273.15);
+ * expr.evaluate(ta.size(), &results[0]);
+ * @endcode
+ *
+ * @ingroup stats
+ * @date   2026-10-18
+ */
+class ColumnExpression {
+	public:
+		ColumnExpression();
+
+		/**
+		 * @brief Compile an expression
+		 * @param[in] expression arithmetic expression (tinyexpr syntax)
+		 * @param[in] variables names of the variables that can be used in the expression
+		 * @param[out] error position of the parse error (0 if there was no error)
+		 * @return true if the compilation succeeded
+		 */
+		bool compile(const std::string& expression, const std::vector<std::string>& variables, int& error);
+		bool isCompiled() const {return !program.empty();}
+		bool usesVariable(const size_t& idx) const;
+
+		/**
+		 * @brief Bind a variable to an array of values. The array must contain at least as many values as the number
+		 * of evaluations and must remain valid until the evaluation.
+		 * @param[in] idx index of the variable (in the vector given to compile())
+		 * @param[in] data pointer to the first value
+		 */
+		void bindColumn(const size_t& idx, const double* data);
+
+		/**
+		 * @brief Bind a variable to a value that is the same for all evaluations
+		 * @param[in] idx index of the variable (in the vector given to compile())
+		 * @param[in] value value of the variable
+		 */
+		void bindValue(const size_t& idx, const double& value);
+
+		/**
+		 * @brief Evaluate the expression for nr_values sets of values
+		 * @param[in] nr_values number of evaluations
+		 * @param[out] results array that receives the results (it may be one of the bound columns)
+		 * @param[in] mask if not NULL, only the values where mask is not zero are evaluated, the other results are left untouched
+		 */
+		void evaluate(const size_t& nr_values, double* results, const char* mask=nullptr) const;
+
+		static const size_t block_size = 64; ///< number of values processed at once by each instruction
+
+	private:
+		typedef enum OPCODE {
+			PUSH_CONST, PUSH_VAR,
+			ADD, SUB, MUL, DIV, POW, MOD, COMMA, NEG,
+			CALL0, CALL1, CALL2, CALL_N
+		} OpCode;
+
+		typedef struct INSTRUCTION {
+			INSTRUCTION(const OpCode& i_op) : op(i_op), idx(0), value(0.), function(nullptr) {}
+			OpCode op;
+			size_t idx; ///< variable index for PUSH_VAR, arity for CALL_N
+			double value; ///< value for PUSH_CONST
+			const void *function; ///< function to call for CALLx
+		} Instruction;
+
+		bool translate(const void* node, const std::vector<double>& slots, size_t depth);
+		void run(const size_t& offset, const size_t& nn, double* stack) const;
+
+		std::vector<Instruction> program;
+		std::vector<const double*> columns;
+		std::vector<double> values;
+		size_t max_depth;
+};
+
+} //end namespace
+
+#endif
@@ -271,6 +271,27 @@ void SphericVario::setDefaultGuess() {
 	Lambda.push_back( *max_element(X.begin(), X.end()) );
 }
 
+bool SphericVario::gradient(const double& x, std::vector<double>& grad) const {
+	if (x==0) {
+		grad[0] = grad[1] = grad[2] = 0.;
+		return true;
+	}
+	const double cs = Lambda.at(1);
+	const double as = Lambda.at(2);
+
+	const double abs_x = fabs(x);
+	grad[0] = 1.;
+	if (abs_x<=as) {
+		const double val = abs_x/as;
+		grad[1] = 1.5*val - 0.5*Optim::pow3(val);
+		grad[2] = -1.5 * cs * val * (1. - val*val) / as;
+	} else {
+		grad[1] = 1.;
+		grad[2] = 0.;
+	}
+	return true;
+}
+
 double LinVario::f(const double& x) const {
 	if (x==0) {
 		return 0;
@@ -294,6 +315,12 @@ void LinVario::setDefaultGuess() {
 	Lambda.push_back( slope );
 }
 
+bool LinVario::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = (x==0)? 0. : 1.;
+	grad[1] = abs(x);
+	return true;
+}
+
 double ExpVario::f(const double& x) const {
 	if (x==0) {
 		return 0;
@@ -318,6 +345,20 @@ void ExpVario::setDefaultGuess() {
 	Lambda.push_back( 1. );
 }
 
+bool ExpVario::gradient(const double& x, std::vector<double>& grad) const {
+	if (x==0) {
+		grad[0] = grad[1] = grad[2] = 0.;
+		return true;
+	}
+	const double ce = Lambda.at(1);
+	const double ae = Lambda.at(2);
+	const double decay = exp(-abs(x)/ae);
+	grad[0] = 1.;
+	grad[1] = 1. - decay;
+	grad[2] = -ce * decay * abs(x) / (ae*ae);
+	return true;
+}
+
 double RatQuadVario::f(const double& x) const {
 	if (x==0) {
 		return 0;
@@ -342,6 +383,21 @@ void RatQuadVario::setDefaultGuess() {
 	Lambda.push_back( 1. );
 }
 
+bool RatQuadVario::gradient(const double& x, std::vector<double>& grad) const {
+	if (x==0) {
+		grad[0] = grad[1] = grad[2] = 0.;
+		return true;
+	}
+	const double cr = Lambda.at(1);
+	const double ar = Lambda.at(2);
+	const double x2 = x*x;
+	const double denom = 1. + x2/ar;
+	grad[0] = 1.;
+	grad[1] = x2 / denom;
+	grad[2] = cr * x2*x2 / Optim::pow2(denom*ar);
+	return true;
+}
+
 double LinearLS::f(const double& x) const {
 	const double y = Lambda.at(0)*x + Lambda.at(1); //Lambda is a vector
 	return y;
@@ -359,6 +415,12 @@ void LinearLS::setDefaultGuess() {
 	Lambda.push_back( Y[xzero_idx] );
 }
 
+bool LinearLS::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = x;
+	grad[1] = 1.;
+	return true;
+}
+
 double Quadratic::f(const double& x) const {
 	const double y = Lambda.at(0)*x*x + Lambda.at(1)*x + Lambda.at(2); //Lambda is a vector
 	return y;
@@ -381,6 +443,13 @@ void Quadratic::setDefaultGuess() {
 		Lambda.push_back( *( std::max_element( Y.begin(), Y.end() ) ) );
 }
 
+bool Quadratic::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = x*x;
+	grad[1] = x;
+	grad[2] = 1.;
+	return true;
+}
+
 
 /**
 * @brief Add one data point to the model
@@ -57,6 +57,8 @@ class SphericVario : public FitLeastSquare {
 		SphericVario() : FitLeastSquare("SphericVario", 3, 4) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
 class LinVario : public FitLeastSquare {
@@ -64,6 +66,8 @@ class LinVario : public FitLeastSquare {
 		LinVario() : FitLeastSquare("LinVario", 2, 3) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
 class ExpVario : public FitLeastSquare {
@@ -71,6 +75,8 @@ class ExpVario : public FitLeastSquare {
 		ExpVario() : FitLeastSquare("ExpVario", 3, 4) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
 class RatQuadVario : public FitLeastSquare {
@@ -78,6 +84,8 @@ class RatQuadVario : public FitLeastSquare {
 		RatQuadVario() : FitLeastSquare("RatQuadVario", 3, 4) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
 class LinearLS : public FitLeastSquare {
@@ -85,6 +93,8 @@ class LinearLS : public FitLeastSquare {
 		LinearLS() : FitLeastSquare("LinearLS", 2, 3) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
 class Quadratic : public FitLeastSquare {
@@ -92,6 +102,8 @@ class Quadratic : public FitLeastSquare {
 		Quadratic() : FitLeastSquare("Quadratic", 3, 4) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
 };
 
   /**
@@ -146,45 +146,47 @@ bool FitLeastSquare::computeFit()
 {
 	double max_delta;
 	initLambda();
-	Matrix dLambda; //parameters variations
-	initDLambda(dLambda);
 
-	Matrix A(nPts, nParam);
-	Matrix dBeta(nPts, (size_t)1);
+	//the normal equations are accumulated point by point, so the Jacobian never has to be stored
+	std::vector<double> AtA(nParam*nParam), Atb(nParam), dLambda(nParam), grad(nParam);
+	double R2 = 0.;
 
 	unsigned int iter = 0;
 	do {
 		iter++;
-		//set dBeta matrix
-		for (size_t m=1; m<=nPts; m++) {
-			dBeta(m,1) = Y[m-1] - f(X[m-1]); //X and Y are vectors
-		}
+		std::fill(AtA.begin(), AtA.end(), 0.);
+		std::fill(Atb.begin(), Atb.end(), 0.);
+		R2 = 0.;
+
+		for (size_t m=0; m<nPts; m++) {
+			const double dBeta = Y[m] - f(X[m]);
+			R2 += dBeta*dBeta;
+
+			if (!gradient(X[m], grad)) { //no analytic derivatives for this model
+				for (size_t n=0; n<nParam; n++) grad[n] = DDer(X[m], n+1);
+			}
 
-		//set A matrix
-		for (size_t m=1; m<=nPts; m++) {
-			for (size_t n=1; n<=nParam; n++) {
-				const double value = DDer( X[m-1], n ); //X is a vector
-				A(m,n) = value;
+			for (size_t ii=0; ii<nParam; ii++) {
+				Atb[ii] += grad[ii] * dBeta;
+				for (size_t jj=0; jj<=ii; jj++) AtA[ii*nParam+jj] += grad[ii] * grad[jj];
 			}
 		}
+		for (size_t ii=0; ii<nParam; ii++) { //AtA is symmetric
+			for (size_t jj=ii+1; jj<nParam; jj++) AtA[ii*nParam+jj] = AtA[jj*nParam+ii];
+		}
 
 		//calculate parameters deltas
-		const Matrix a( A.getT() * A );
-		const Matrix b( A.getT() * dBeta );
-		if (!Matrix::solve(a, b, dLambda)) return false;
+		if (!solveNormalEquations(AtA, Atb, dLambda)) return false;
 
 		//apply the deltas to the parameters, record maximum delta
 		max_delta = 0.;
-		for (size_t n=1; n<=nParam; n++) {
-			Lambda[n-1] += dLambda(n,1); //Lambda is a vector
-			if ( fabs(dLambda(n,1))>max_delta ) max_delta=fabs(dLambda(n,1));
+		for (size_t n=0; n<nParam; n++) {
+			Lambda[n] += dLambda[n];
+			if ( fabs(dLambda[n])>max_delta ) max_delta=fabs(dLambda[n]);
 		}
 
 	} while (max_delta>eps_conv && iter<max_iter);
 
-	//compute R2
-	const double R2 = Matrix::dot(dBeta, dBeta);
-
 	//building infoString
 	ostringstream ss;
 	ss << "Computed regression with " << regname << " model ";
@@ -201,23 +203,49 @@ bool FitLeastSquare::computeFit()
 	}
 }
 
-void FitLeastSquare::initLambda()
+/**
+* @brief Solve the (small) system of normal equations A*x=b by Gaussian elimination with partial pivoting
+* @param A nParam x nParam matrix, stored by rows (it is modified)
+* @param b right hand side (it is modified)
+* @param x solution
+* @return false if the system is singular
+*/
+bool FitLeastSquare::solveNormalEquations(std::vector<double>& A, std::vector<double>& b, std::vector<double>& x) const
 {
-	if (Lambda.empty()) //else, setGuess has been called
-		Lambda.resize(nParam, lambda_init);
-}
+	static const double epsilon = 1e-9; //same as Matrix::solve
+	const size_t n = nParam;
 
-void FitLeastSquare::initDLambda(Matrix& dLambda) const
-{
-	dLambda.resize(nParam,1);
-	for (size_t m=1; m<=nParam; m++) {
-		const double var = Lambda[m-1]; //Lambda is a vector
-		if (var==0) {
-			dLambda(m,1) = delta_init_abs * 0.5;
-		} else {
-			dLambda(m,1) = delta_init_rel * var * 0.5;
+	for (size_t kk=0; kk<n; kk++) {
+		size_t pivot = kk;
+		for (size_t ii=kk+1; ii<n; ii++) {
+			if (fabs(A[ii*n+kk])>fabs(A[pivot*n+kk])) pivot = ii;
+		}
+		if (fabs(A[pivot*n+kk])<=epsilon) return false;
+		if (pivot!=kk) {
+			for (size_t jj=kk; jj<n; jj++) std::swap(A[kk*n+jj], A[pivot*n+jj]);
+			std::swap(b[kk], b[pivot]);
+		}
+
+		for (size_t ii=kk+1; ii<n; ii++) {
+			const double factor = A[ii*n+kk] / A[kk*n+kk];
+			if (factor==0.) continue;
+			for (size_t jj=kk+1; jj<n; jj++) A[ii*n+jj] -= factor * A[kk*n+jj];
+			b[ii] -= factor * b[kk];
 		}
 	}
+
+	for (size_t ii=n; ii-- > 0; ) {
+		double sum = b[ii];
+		for (size_t jj=ii+1; jj<n; jj++) sum -= A[ii*n+jj] * x[jj];
+		x[ii] = sum / A[ii*n+ii];
+	}
+	return true;
+}
+
+void FitLeastSquare::initLambda()
+{
+	if (Lambda.empty()) //else, setGuess has been called
+		Lambda.resize(nParam, lambda_init);
 }
 
 double FitLeastSquare::getDelta(const double& var) const
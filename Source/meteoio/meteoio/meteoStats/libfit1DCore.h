@@ -66,6 +66,12 @@ class FitModel {
  * @brief A class to perform non-linear least square fitting.
  * It works on a time serie and uses matrix arithmetic to perform an arbitrary fit
  * (see http://mathworld.wolfram.com/NonlinearLeastSquaresFitting.html).
+ * The models can provide the analytic derivatives of f() with respect to their parameters by overriding gradient(),
+ * otherwise they are computed by finite differences. The normal equations are directly accumulated and solved
+ * by Gaussian elimination, so fitting a few parameters does not allocate any matrix.
+ *
+ * In order to warm start a fit (for example from the parameters that have been found at the previous time step),
+ * call setGuess() after setData() and before fit().
  *
  * @ingroup stats
  * @author Mathias Bavay
@@ -80,10 +86,17 @@ class FitLeastSquare : public FitModel {
 
 	protected:
 		virtual void setDefaultGuess(); //set defaults guess values. Called by setData
+		/**
+		* @brief Partial derivatives of f(x) with respect to each parameter
+		* @param x abscissa
+		* @param grad partial derivatives (already sized to the number of parameters)
+		* @return false if the model does not provide analytic derivatives
+		*/
+		virtual bool gradient(const double& /*x*/, std::vector<double>& /*grad*/) const {return false;}
 
 	private:
 		void initLambda();
-		void initDLambda(Matrix& dLambda) const;
+		bool solveNormalEquations(std::vector<double>& A, std::vector<double>& b, std::vector<double>& x) const;
 		double getDelta(const double& var) const;
 		double DDer(const double& x, const size_t& index);
 		bool computeFit();
@@ -795,6 +795,89 @@ void Interpol1D::LinRegressionFixedRate(const std::vector<double>& X, const std:
 	}
 }
 
+namespace {
+/**
+* @brief Sufficient statistics of a linear regression (centered sums), so points can be removed in O(1)
+* The means and co-moments are updated with Welford's method, so removing a point does not require another
+* pass over the data. Only the points where both X and Y are valid contribute to the sums.
+*/
+class RegressionSums {
+	public:
+		RegressionSums(const std::vector<double>& X, const std::vector<double>& Y)
+		               : count(0), x_avg(0.), y_avg(0.), sx(0.), sy(0.), sxy(0.), syy_raw(0.)
+		{
+			for (size_t ii=0; ii<X.size(); ii++) {
+				if (X[ii]==IOUtils::nodata || Y[ii]==IOUtils::nodata) continue;
+				count++;
+				const double dx = X[ii] - x_avg;
+				const double dy = Y[ii] - y_avg;
+				x_avg += dx / (double)count;
+				y_avg += dy / (double)count;
+				sx += dx * (X[ii] - x_avg);
+				sy += dy * (Y[ii] - y_avg);
+				sxy += dx * (Y[ii] - y_avg);
+				syy_raw += Y[ii]*Y[ii];
+			}
+		}
+
+		void remove(const double& x, const double& y)
+		{
+			if (count<=1) {
+				count = 0;
+				x_avg = y_avg = sx = sy = sxy = syy_raw = 0.;
+				return;
+			}
+			count--;
+			const double dx = x - x_avg;
+			const double dy = y - y_avg;
+			x_avg -= dx / (double)count;
+			y_avg -= dy / (double)count;
+			sx -= dx * (x - x_avg);
+			sy -= dy * (y - y_avg);
+			sxy -= dx * (y - y_avg);
+			syy_raw -= y*y;
+		}
+
+		/**
+		* @brief Same regression as Interpol1D::LinRegression but computed from the sums
+		*/
+		void regression(double& a, double& b, double& r, std::string& mesg, const bool& fixed_rate) const
+		{
+			if (fixed_rate) {
+				if (count==0)
+					throw NoDataException("Trying to calculate linear regression with no valid data points", AT);
+				b = y_avg - a*x_avg;
+				const double SSR = std::max(0., sy - 2.*a*sxy + a*a*sx); //Sum of Squared Residuals
+				if (syy_raw>0.) {
+					r = 1. - SSR/syy_raw;
+				} else {
+					r = 1.;
+					mesg = "[W] Computing fixed lapse rate linear regression on data all at Y=0\n";
+				}
+				return;
+			}
+
+			if (count<2)
+				throw NoDataException("Trying to calculate linear regression with too few valid data points", AT);
+			static const double epsilon = 1e-6;
+			if (sx <= fabs(x_avg)*epsilon) {
+				a = 0.;
+				b = y_avg;
+				r = 1.;
+				mesg = "[W] Computing linear regression on data at identical X\n";
+				return;
+			}
+			a = sxy / sx;
+			b = y_avg - a*x_avg;
+			r = (sy<=0.)? 1. : fabs( sxy / sqrt(sx*sy) );
+		}
+
+	private:
+		size_t count;
+		double x_avg, y_avg, sx, sy, sxy, syy_raw;
+};
+}
+
 /**
 * @brief Computes the linear regression coefficients fitting the points given as X and Y in two vectors
 * the linear regression has the form Y = aX + b with a regression coefficient r. If the regression coefficient is not good enough, tries to remove bad points (up to 15% of the initial data set can be removed, keeping at least 4 points)
@@ -815,39 +898,61 @@ void Interpol1D::NoisyLinRegression(const std::vector<double>& in_X, const std::
 	const size_t min_dataset = (size_t)Optim::floor( 0.75*(double)nb_pts );
 	const size_t min_pts = (min_dataset>4)? min_dataset : 4;
 
-	std::ostringstream ss;
-
 	LinRegression(in_X, in_Y, A, B, R, mesg, fixed_rate);
-	if (R>=r_thres) return;
-	ss << mesg;
+	if (R>=r_thres || nb_pts<=min_pts) {
+		if (R<r_thres) mesg += poorRegressionMesg(R);
+		return;
+	}
 
-	std::vector<double> X(in_X), Y(in_Y);
+	//the points are then removed one by one while the regression is updated from its sufficient statistics
+	const double a_fixed = A;
+	RegressionSums sums(in_X, in_Y);
+	std::vector<bool> removed(nb_pts, false);
 	size_t nb_valid_pts = nb_pts;
+	std::string warnings( mesg );
 
 	while (R<r_thres && nb_valid_pts>min_pts) {
 		//we try to remove the one point in the data set that is the worst
 		size_t index_bad=0;
 		double max_dist = -1.;
 		for (size_t ii=0; ii<nb_pts; ii++) {
-			if (Y[ii]==IOUtils::nodata) continue;
-			const double dist = pt_line_distance(X[ii], Y[ii], A, B);
+			if (removed[ii] || in_Y[ii]==IOUtils::nodata) continue;
+			const double dist = pt_line_distance(in_X[ii], in_Y[ii], A, B);
 			if (dist>max_dist) {
 				max_dist = dist;
 				index_bad = ii;
 			}
 		}
 		//the worst point has been found, we remove it
-		Y[index_bad] = IOUtils::nodata;
+		removed[index_bad] = true;
 		nb_valid_pts--;
-		LinRegression(X, Y, A, B, R, mesg, fixed_rate);
-		ss << mesg;
+		if (in_X[index_bad]!=IOUtils::nodata) sums.remove(in_X[index_bad], in_Y[index_bad]);
+		if (fixed_rate) A = a_fixed;
+		mesg.clear();
+		sums.regression(A, B, R, mesg, fixed_rate);
+		if (!mesg.empty() && warnings.find(mesg)==std::string::npos) warnings += mesg;
 	}
 
-	//check if r is reasonable
-	if (R<r_thres) {
-		ss << "\n[W] Poor regression coefficient: " << std::setprecision(2) << R << "\n";
+	//the final coefficients are computed again from the kept points, so they do not carry the round-off of the updates
+	std::vector<double> Y(in_Y);
+	for (size_t ii=0; ii<nb_pts; ii++) {
+		if (removed[ii]) Y[ii] = IOUtils::nodata;
 	}
-	mesg = ss.str();
+	if (fixed_rate) A = a_fixed;
+	mesg.clear();
+	LinRegression(in_X, Y, A, B, R, mesg, fixed_rate);
+	if (!mesg.empty() && warnings.find(mesg)==std::string::npos) warnings += mesg;
+
+	//check if r is reasonable
+	if (R<r_thres) warnings += poorRegressionMesg(R);
+	mesg = warnings;
+}
+
+std::string Interpol1D::poorRegressionMesg(const double& R)
+{
+	std::ostringstream ss;
+	ss << "\n[W] Poor regression coefficient: " << std::setprecision(2) << R << "\n";
+	return ss.str();
 }
 
 /**
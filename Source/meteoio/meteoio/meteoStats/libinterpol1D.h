@@ -66,6 +66,7 @@ class Interpol1D {
 	private:
 		static double getMedianCore(std::vector<double> vecData);
 		static bool ptOK(const double& x, const double& y);
+		static std::string poorRegressionMesg(const double& R);
 		static void LinRegressionFixedRate(const std::vector<double>& X, const std::vector<double>& Y, double& a, double& b, double& r, std::string& mesg);
 		static bool pair_comparator(const std::pair<double, double>& l, const std::pair<double, double>& r);
 		static double pt_line_distance(const double& x, const double& y, const double& a, const double& b);
@@ -57,6 +57,8 @@ namespace mio {
  * - GRID2DPATH: meteo grids directory where to read/write the grids; [Input] and [Output] sections
  * - GRID2DEXT: grid file extension, or <i>none</i> for no file extension (default: .asc)
  * - A3D_VIEW: use Alpine3D's grid viewer naming scheme (default=false)? [Input] and [Output] sections.
+ * - GRID2D_CATALOG: existing directory where to keep the catalogue of the grids available in GRID2DPATH between runs, so
+ * large archives do not have to be scanned again at each start (optional, see FileUtils::GridsCatalog); [Input] section.
  * - DEMFILE: for reading the data as a DEMObject
  * - LANDUSE: for interpreting the data as landuse codes
  * - DAPATH: path+prefix of file containing data assimilation grids (named with ISO 8601 basic date and .sca extension,
@@ -73,11 +75,79 @@ namespace mio {
  * @endcode
  */
 
+namespace {
+	///get the date and parameter of the grids from their file names
+	class ArcFilesParser : public FileUtils::GridsCatalog::FileParser {
+		public:
+			ArcFilesParser(const double& i_TZ, const std::string& i_ext, const bool& i_a3d_view)
+			              : TZ(i_TZ), ext(i_ext), a3d_view(i_a3d_view) {}
+
+			void parse(const std::string& /*path*/, const std::string& filename, std::vector<FileUtils::GridsCatalog::catalog_entry>& entries) const
+			{
+				Date date;
+				size_t param = IOUtils::npos;
+				if (a3d_view) {
+					static const char NUM[] = "0123456789";
+					static const size_t date_str_len = 12; //fix format for this plugin
+
+					const std::string::size_type pos = filename.find_first_not_of(NUM);
+					if (pos==std::string::npos || pos!=date_str_len) return; //for ARC, we skip the seconds -> date is 12 chars
+					if (filename.length() < (date_str_len+1)) return; //we must have either '.' after the date
+					if (filename[date_str_len]!='.') return;
+					if (!IOUtils::convertString(date, filename.substr(0, date_str_len), TZ)) return;
+
+					const std::string file_ext( IOUtils::strToUpper(FileUtils::getExtension( filename )) );
+					if (file_ext=="SDP")
+						param = MeteoGrids::HS;
+					else if (file_ext=="SWR")
+						param = MeteoGrids::ISWR;
+					else if (file_ext=="LWR")
+						param = MeteoGrids::ILWR;
+					else if (file_ext=="ASC")
+						param = MeteoGrids::DEM;
+					else
+						param = MeteoGrids::getParameterIndex( file_ext );
+				} else {
+					static const char DATE_CHAR[] = "0123456789-+T:.";
+					static const size_t max_date_str_len = 19+6; //worst case scenario, with 6 chars for the timezone
+					if ("."+FileUtils::getExtension( filename ) != ext) return;
+
+					const std::string::size_type pos = filename.find_first_not_of(DATE_CHAR);
+					if (pos==std::string::npos || pos>max_date_str_len) return;
+
+					std::string date_str(  filename.substr(0, pos) );
+					std::replace( date_str.begin(), date_str.end(), '.', ':');
+					if (!IOUtils::convertString(date, date_str, TZ)) return;
+
+					const std::string::size_type pos_underscore = filename.find('_');
+					const std::string::size_type pos_dot = filename.find_last_of('.');
+					if (pos_underscore==std::string::npos || pos_dot==std::string::npos) return;
+					param = MeteoGrids::getParameterIndex( filename.substr(pos_underscore+1, (pos_dot - pos_underscore - 1)) );
+				}
+
+				if (param==IOUtils::npos) return;
+				entries.push_back( FileUtils::GridsCatalog::catalog_entry(date, param, filename) );
+			}
+
+			std::string getSignature() const
+			{
+				std::ostringstream os;
+				os << "ARC TZ=" << TZ << " ext=" << ext << " a3d_view=" << a3d_view;
+				return os.str();
+			}
+
+		private:
+			const double TZ;
+			const std::string ext;
+			const bool a3d_view;
+	};
+}
+
 ARCIO::ARCIO(const std::string& configfile)
        : cfg(configfile),
          coordin(), coordinparam(), coordout(), coordoutparam(),
          grid2dpath_in(), grid2dpath_out(), grid2d_ext_in(".asc"), grid2d_ext_out(".asc"),
-         a3d_view_in(false), a3d_view_out(false)
+         grids_catalog(), a3d_view_in(false), a3d_view_out(false)
 {
 	IOUtils::getProjectionParameters(cfg, coordin, coordinparam, coordout, coordoutparam);
 	cfg.getValue("A3D_VIEW", "Input", a3d_view_in, IOUtils::nothrow);
@@ -89,7 +159,7 @@ ARCIO::ARCIO(const Config& cfgreader)
        : cfg(cfgreader),
          coordin(), coordinparam(), coordout(), coordoutparam(),
          grid2dpath_in(), grid2dpath_out(), grid2d_ext_in(".asc"), grid2d_ext_out(".asc"),
-         a3d_view_in(false), a3d_view_out(false)
+         grids_catalog(), a3d_view_in(false), a3d_view_out(false)
 {
 	IOUtils::getProjectionParameters(cfg, coordin, coordinparam, coordout, coordoutparam);
 	cfg.getValue("A3D_VIEW", "Input", a3d_view_in, IOUtils::nothrow);
@@ -112,6 +182,12 @@ void ARCIO::getGridPaths()
 	if (grid2d_ext_in=="none") grid2d_ext_in.clear();
 	cfg.getValue("GRID2DEXT", "Output", grid2d_ext_out, IOUtils::nothrow);
 	if (grid2d_ext_out=="none") grid2d_ext_out.clear();
+
+	if (!grid2dpath_in.empty()) {
+		std::string catalog_dir;
+		cfg.getValue("GRID2D_CATALOG", "Input", catalog_dir, IOUtils::nothrow);
+		grids_catalog = FileUtils::GridsCatalog(grid2dpath_in, "", catalog_dir);
+	}
 }
 
 void ARCIO::read2DGrid_internal(Grid2DObject& grid_out, const std::string& full_name)
@@ -210,66 +286,8 @@ bool ARCIO::list2DGrids(const Date& start, const Date& end, std::map<Date, std::
 {
 	results.clear();
 	const double TZ = cfg.get("TIME_ZONE", "Input");
-	std::list<std::string> dirlist( FileUtils::readDirectory(grid2dpath_in) ); //read everything. Toggle it to recursive if this changes in the plugin!
-	dirlist.sort();
-
-	if (a3d_view_in) {
-		static const char NUM[] = "0123456789";
-		static const size_t date_str_len = 12; //fix format for this plugin
-
-		for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
-			const std::string::size_type pos = it->find_first_not_of(NUM);
-			if (pos==std::string::npos || pos!=date_str_len) continue; //for ARC, we skip the seconds -> date is 12 chars
-			if (it->length() < (date_str_len+1)) continue; //we must have either '.' after the date
-			if ((*it)[date_str_len]!='.') continue;
-
-			Date date;
-			if (!IOUtils::convertString(date, it->substr(0, date_str_len), TZ)) continue;
-			if (date<start) continue;
-			if (date>end) return true;
-
-			const std::string ext( IOUtils::strToUpper(FileUtils::getExtension( *it )) );
-			size_t param;
-			if (ext=="SDP")
-				param = MeteoGrids::HS;
-			else if (ext=="SWR")
-				param = MeteoGrids::ISWR;
-			else if (ext=="LWR")
-				param = MeteoGrids::ILWR;
-			else if (ext=="ASC")
-				param = MeteoGrids::DEM;
-			else
-				param = MeteoGrids::getParameterIndex( ext );
-			if (param==IOUtils::npos) continue;
-			results[date].insert( param );
-		}
-	} else {
-		static const char DATE_CHAR[] = "0123456789-+T:.";
-		static const size_t max_date_str_len = 19+6; //worst case scenario, with 6 chars for the timezone
-		for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
-			const std::string ext( "."+FileUtils::getExtension( *it ) );
-			if (ext!=grid2d_ext_in) continue;
-
-			const std::string::size_type pos = it->find_first_not_of(DATE_CHAR);
-			if (pos==std::string::npos || pos>max_date_str_len) continue;
-
-			std::string date_str(  it->substr(0, pos) );
-			std::replace( date_str.begin(), date_str.end(), '.', ':');
-			Date date;
-			if (!IOUtils::convertString(date, date_str, TZ)) continue;
-			if (date<start) continue;
-			if (date>end) return true;
-
-			const std::string::size_type pos_underscore = it->find('_');
-			const std::string::size_type pos_dot = it->find_last_of('.');
-			if (pos==std::string::npos || pos_dot==std::string::npos) continue;
-			const std::string param_str( it->substr(pos_underscore+1, (pos_dot - pos_underscore - 1)) );
-			const size_t param = MeteoGrids::getParameterIndex( param_str );
-			if (param==IOUtils::npos) continue;
-			results[date].insert( param );
-		}
-	}
-
+	grids_catalog.update( ArcFilesParser(TZ, grid2d_ext_in, a3d_view_in) );
+	grids_catalog.getGrids(start, end, results);
 	return true;
 }
 
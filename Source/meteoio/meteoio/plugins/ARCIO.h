@@ -20,6 +20,7 @@
 #define ARCIO_H
 
 #include <meteoio/IOInterface.h>
+#include <meteoio/FileUtils.h>
 
 #include <string>
 
@@ -63,6 +64,7 @@ class ARCIO : public IOInterface {
 		std::string grid2dpath_in, grid2dpath_out;
 		std::string grid2d_ext_in, grid2d_ext_out; //file extension
 
+		FileUtils::GridsCatalog grids_catalog; ///< grids available in grid2dpath_in
 		bool a3d_view_in, a3d_view_out; ///< make filename compatible with the Alpine3D's viewer?
 };
 
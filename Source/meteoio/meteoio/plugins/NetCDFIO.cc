@@ -90,6 +90,8 @@ namespace mio {
  *     - DEMVAR: The variable name of the DEM within the DEMFILE; [Input] section
  *     - GRID2DPATH: if this directory contains files, they will be used for reading the input from; [Input] and [Output] section
  *     - GRID2DFILE: force reading the data from a single file within GRID2DPATH or specify the output file name; [Input] and [Output] section
+ *     - GRID2D_CATALOG: existing directory where to keep the catalogue of the grids available in GRID2DPATH between runs, so the
+ *       files do not have to be opened again at each start (optional, see FileUtils::GridsCatalog); [Input] section
  * - Time series handling:
  *     - STATION#: if provided, only the given station IDs will be kept in the input data (this is specially useful when reading a file containing multiple stations); [Input]
  *     - METEOPATH: meteo files directory where to read the meteofiles from; [Input] section. Two modes are available when reading input files:
@@ -113,7 +115,8 @@ namespace mio {
  * @note The timezone is assumed to be GMT. When reading a NetCDF file, the stationID and stationName are supposed to be provided by either
  * global attributes or through a variable. If nothing is provided, the filename (stripped of its extension) is used.
  * @note When providing multiple grid files in one directory, in case of overlapping files (because each file can provide multiple timestamps),
- * the file containing the newest data has priority. This is convenient when using forecast data to automatically use the most short-term forecast.
+ * the file coming last in alphabetical order has priority. When the file names start with their run date, this is the newest data, which is
+ * convenient when using forecast data to automatically use the most short-term forecast.
  * @note When using the CROCUS schema, please note that the humidity should be provided as specific humidity, so please use a data
  * creator if don't already have a QI parameter (see HumidityGenerator). Crocus also requires split precipitation, this can be generated 
  * by the PrecSplitting creator (make sure to use parameters names from MeteoGrids::Parameters).
@@ -285,22 +288,56 @@ namespace mio {
  * @endcode
  */
 
-//helper function to sort the cache of grid files
-inline bool sort_cache_grids(const std::pair<std::pair<Date,Date>,ncFiles> &left, const std::pair<std::pair<Date,Date>,ncFiles> &right) {
-	if (left.first.first < right.first.first) return true;
-	if (left.first.first > right.first.first) return false;
-	return left.first.second < right.first.second; //date_start equallity case
+namespace {
+	///get the timestamps and parameters of the grids contained in the NetCDF files (only the files having a time dimension are considered)
+	class NcFilesParser : public FileUtils::GridsCatalog::FileParser {
+		public:
+			NcFilesParser(const Config& i_cfg, const std::string& i_schema, const bool& i_debug)
+			             : cfg(i_cfg), schema(i_schema), debug(i_debug) {}
+
+			void parse(const std::string& path, const std::string& filename, std::vector<FileUtils::GridsCatalog::catalog_entry>& entries) const
+			{
+				const ncFiles file(path + "/" + filename, ncFiles::READ, cfg, schema, debug);
+				if (!file.hasDimension(ncpp::TIME)) return;
+
+				//we consider that the exact same parameters are available at all time steps in the file
+				const std::set<size_t> params_set( file.getParams() );
+				const std::vector<Date> ts( file.getTimestamps() );
+				for (size_t ii=0; ii<ts.size(); ii++) {
+					for (std::set<size_t>::const_iterator it = params_set.begin(); it != params_set.end(); ++it)
+						entries.push_back( FileUtils::GridsCatalog::catalog_entry(ts[ii], *it, filename, ii) );
+				}
+			}
+
+			std::string getSignature() const
+			{
+				//the schema and the user provided variables and dimensions mappings decide which parameters are found
+				std::ostringstream os;
+				os << "NETCDF schema=" << schema;
+				const char* remaps[2] = {"NETCDF_VAR::", "NETCDF_DIM::"};
+				for (size_t ii=0; ii<2; ii++) {
+					const std::vector<std::string> keys( cfg.getKeys(remaps[ii], "Input") );
+					for (size_t jj=0; jj<keys.size(); jj++) os << " " << keys[jj] << "=" << cfg.get(keys[jj], "Input", "");
+				}
+				return os.str();
+			}
+
+		private:
+			const Config& cfg;
+			const std::string schema;
+			const bool debug;
+	};
 }
 
 NetCDFIO::NetCDFIO(const std::string& configfile)
-         : cfg(configfile), cache_grid_files(), cache_grids_out(), cache_inmeteo_files(), in_stations(), available_params(), in_schema("CF-1.6"), out_schema("CF-1.6"), in_grid2d_path(), in_nc_ext(".nc"), out_grid2d_path(), grid2d_out_file(),
+         : cfg(configfile), grids_catalog(), cache_grid_files(), cache_grids_out(), cache_inmeteo_files(), in_stations(), available_params(), in_schema("CF-1.6"), out_schema("CF-1.6"), in_grid2d_path(), grid2d_in_file(), in_nc_ext(".nc"), out_grid2d_path(), grid2d_out_file(),
          out_meteo_path(), out_meteo_file(), debug(false), out_single_file(false), split_by_year(false), split_by_var(false)
 {
 	parseInputOutputSection();
 }
 
 NetCDFIO::NetCDFIO(const Config& cfgreader)
-         : cfg(cfgreader), cache_grid_files(), cache_grids_out(), cache_inmeteo_files(), in_stations(), available_params(), in_schema("CF-1.6"), out_schema("CF-1.6"), in_grid2d_path(), in_nc_ext(".nc"), out_grid2d_path(), grid2d_out_file(),
+         : cfg(cfgreader), grids_catalog(), cache_grid_files(), cache_grids_out(), cache_inmeteo_files(), in_stations(), available_params(), in_schema("CF-1.6"), out_schema("CF-1.6"), in_grid2d_path(), grid2d_in_file(), in_nc_ext(".nc"), out_grid2d_path(), grid2d_out_file(),
          out_meteo_path(), out_meteo_file(), debug(false), out_single_file(false), split_by_year(false), split_by_var(false)
 {
 	parseInputOutputSection();
@@ -313,14 +350,16 @@ void NetCDFIO::parseInputOutputSection()
 		cfg.getValue("NC_DEBUG", "INPUT", debug, IOUtils::nothrow);
 		cfg.getValue("NETCDF_SCHEMA", "Input", in_schema, IOUtils::nothrow); IOUtils::toUpper(in_schema);
 
-		const std::string grid2d_in_file = cfg.get("GRID2DFILE", "Input", "");
+		cfg.getValue("GRID2DFILE", "Input", grid2d_in_file, IOUtils::nothrow);
 		if (!grid2d_in_file.empty()) {
 			if (!FileUtils::fileExists(grid2d_in_file)) throw AccessException(grid2d_in_file, AT); //prevent invalid filenames
-			ncFiles file(grid2d_in_file, ncFiles::READ, cfg, in_schema, debug);
-			cache_grid_files.push_back( make_pair(file.getDateRange(), file) );
+			cache_grid_files.insert( make_pair(grid2d_in_file, ncFiles(grid2d_in_file, ncFiles::READ, cfg, in_schema, debug)) );
 		} else {
 			cfg.getValue("GRID2DPATH", "Input", in_grid2d_path);
 			cfg.getValue("NC_EXT", "INPUT", in_nc_ext, IOUtils::nothrow);
+			std::string catalog_dir;
+			cfg.getValue("GRID2D_CATALOG", "Input", catalog_dir, IOUtils::nothrow);
+			grids_catalog = FileUtils::GridsCatalog(in_grid2d_path, in_nc_ext, catalog_dir);
 		}
 	}
 
@@ -381,47 +420,55 @@ void NetCDFIO::parseInputOutputSection()
 	}
 }
 
-void NetCDFIO::scanPath(const std::string& in_path, const std::string& nc_ext, std::vector< std::pair<std::pair<Date,Date>, ncFiles> > &nc_files)
+void NetCDFIO::updateGridsCatalog()
 {
-	nc_files.clear();
-	std::list<std::string> dirlist( FileUtils::readDirectory(in_path, nc_ext) );
-	if (dirlist.empty()) return; //nothing to do if the directory is empty, we will transparently swap to using GRID2DFILE
-	dirlist.sort();
+	const size_t nr_parsed = grids_catalog.getNrParsed();
+	grids_catalog.update( NcFilesParser(cfg, in_schema, debug) );
+	if (grids_catalog.getNrParsed()!=nr_parsed) cache_grid_files.clear(); //some files have changed, they must be opened again
+}
 
-	//Check date range in every filename and cache it
-	std::list<std::string>::const_iterator it = dirlist.begin();
-	while ((it != dirlist.end())) {
-		const std::string filename( in_path + "/" + *it );
-		if (!FileUtils::fileExists(filename)) throw AccessException(filename, AT); //prevent invalid filenames
-		ncFiles file(filename, ncFiles::READ, cfg, in_schema, debug);
-		if (file.hasDimension(ncpp::TIME))
-			nc_files.push_back( make_pair(file.getDateRange(), file) );
-		++it;
+/**
+* @brief Get the file providing a given grid
+* @param parameter grid parameter
+* @param date grid timestamp
+* @return the opened file, either GRID2DFILE or the last file of GRID2DPATH (in alphabetical order) providing this grid
+*/
+ncFiles& NetCDFIO::getGridFile(const MeteoGrids::Parameters& parameter, const Date& date)
+{
+	std::string filename( grid2d_in_file );
+	if (filename.empty()) {
+		updateGridsCatalog();
+		std::vector<FileUtils::GridsCatalog::catalog_entry> grids;
+		grids_catalog.getEntries(date, date, grids);
+		for (size_t ii=0; ii<grids.size(); ii++) { //for a given date, the grids are sorted by file name
+			if (grids[ii].param==static_cast<size_t>(parameter)) filename = in_grid2d_path + "/" + grids[ii].file;
+		}
+		if (filename.empty())
+			throw InvalidArgumentException("No Gridded data found for "+MeteoGrids::getParameterName( parameter )+" at "+date.toString(Date::ISO)+" in '"+in_grid2d_path+"'", AT);
 	}
-	std::sort(nc_files.begin(), nc_files.end(), &sort_cache_grids);
+
+	std::map<std::string, ncFiles>::iterator it( cache_grid_files.find(filename) );
+	if (it==cache_grid_files.end())
+		it = cache_grid_files.insert( make_pair(filename, ncFiles(filename, ncFiles::READ, cfg, in_schema, debug)) ).first;
+	return it->second;
 }
 
 bool NetCDFIO::list2DGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> >& list)
 {
-	if (cache_grid_files.empty()) scanPath(in_grid2d_path, in_nc_ext, cache_grid_files);
-	if (cache_grid_files.empty()) return true; //there are no grids to read
+	if (grid2d_in_file.empty()) {
+		updateGridsCatalog();
+		grids_catalog.getGrids(start, end, list);
+		return true;
+	}
 
 	//TODO handle the case of file_start & file_end are undef() (example: DEM)
-	for (size_t ii=0; ii<cache_grid_files.size(); ii++) {
-		const Date file_start( cache_grid_files[ii].first.first );
-		const Date file_end( cache_grid_files[ii].first.second );
-
-		if (file_start > end) return true; //no more files to process (since the files are sorted in cache_grid_files)
-		if (file_end < start) continue;
-
-		//we consider that the exact same parameters are available at all time steps in the current file
-		const std::set<size_t> params_set( cache_grid_files[ii].second.getParams() );
-		const std::vector<Date> ts( cache_grid_files[ii].second.getTimestamps() );
-		for (size_t jj=0; jj<ts.size(); jj++) {
-			if (ts[jj]>end) break; //no more timestamps in the right range
-			if (ts[jj]<start) continue;
-			list[ ts[jj] ].insert( params_set.begin(), params_set.end() );
-		}
+	const ncFiles& file = cache_grid_files.find(grid2d_in_file)->second;
+	const std::set<size_t> params_set( file.getParams() );
+	const std::vector<Date> ts( file.getTimestamps() );
+	for (size_t jj=0; jj<ts.size(); jj++) {
+		if (ts[jj]>end) break; //no more timestamps in the right range
+		if (ts[jj]<start) continue;
+		list[ ts[jj] ].insert( params_set.begin(), params_set.end() );
 	}
 
 	return true;
@@ -445,66 +492,12 @@ void NetCDFIO::read2DGrid(Grid2DObject& grid_out, const std::string& arguments)
 
 void NetCDFIO::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	if (cache_grid_files.empty()) scanPath(in_grid2d_path, in_nc_ext, cache_grid_files);
-
-	if (!cache_grid_files.empty()) {
-		for (size_t ii=0; ii<cache_grid_files.size(); ii++) {
-			// Get available time period for file
-			const Date file_start( cache_grid_files[ii].first.first );
-			const Date file_end( cache_grid_files[ii].first.second );
-			// Get available params for file
-			const std::set<size_t> params_set( cache_grid_files[ii].second.getParams() );
-
-			// Check for time period
-			if (file_start > date) continue;
-			if (file_end < date) continue;
-
-			// Check for param
-			if (params_set.find(parameter) == params_set.end()) continue;
-
-			grid_out = cache_grid_files[ii].second.read2DGrid(parameter, date);
-			return;
-		}
-		//the date/param was not found
-		throw InvalidArgumentException("No Gridded data found for "+MeteoGrids::getParameterName( parameter )+" at "+date.toString(Date::ISO)+" in '"+in_grid2d_path+"'", AT);
-	} else {
-		const std::string filename = cfg.get("GRID2DFILE", "Input");
-		if (!FileUtils::fileExists(filename)) throw NotFoundException(filename, AT); //prevent invalid filenames
-		ncFiles file(filename, ncFiles::READ, cfg, in_schema, debug);
-		grid_out = file.read2DGrid(parameter, date);
-	}
+	grid_out = getGridFile(parameter, date).read2DGrid(parameter, date);
 }
 
 void NetCDFIO::readPointsIn2DGrid(std::vector<double>& data, const MeteoGrids::Parameters& parameter, const Date& date, const std::vector< std::pair<size_t, size_t> >& Pts)
 {
-	if (cache_grid_files.empty()) scanPath(in_grid2d_path, in_nc_ext, cache_grid_files);
-
-	if (!cache_grid_files.empty()) {
-		for (size_t ii=0; ii<cache_grid_files.size(); ii++) {
-			// Get available time period for file
-			const Date file_start( cache_grid_files[ii].first.first );
-			const Date file_end( cache_grid_files[ii].first.second );
-			// Get available params for file
-			const std::set<size_t> params_set( cache_grid_files[ii].second.getParams() );
-
-			// Check for time period
-			if (file_start > date) continue;
-			if (file_end < date) continue;
-
-			// Check for param
-			if (params_set.find(parameter) == params_set.end()) continue;
-
-			data = cache_grid_files[ii].second.readPointsIn2DGrid(parameter, date, Pts);
-			return;
-		}
-		//the date/param was not found
-		throw InvalidArgumentException("No Gridded data found for "+MeteoGrids::getParameterName( parameter )+" at "+date.toString(Date::ISO)+" in '"+in_grid2d_path+"'", AT);
-	} else {
-		const std::string filename = cfg.get("GRID2DFILE", "Input");
-		if (!FileUtils::fileExists(filename)) throw NotFoundException(filename, AT); //prevent invalid filenames
-		ncFiles file(filename, ncFiles::READ, cfg, in_schema, debug);
-		data = file.readPointsIn2DGrid(parameter, date, Pts);
-	}
+	data = getGridFile(parameter, date).readPointsIn2DGrid(parameter, date, Pts);
 }
 
 void NetCDFIO::readDEM(DEMObject& dem_out)
@@ -20,6 +20,7 @@
 #define NetCDFIO_H
 
 #include <meteoio/IOInterface.h>
+#include <meteoio/FileUtils.h>
 #include <meteoio/plugins/libncpp.h>
 
 #include <string>
@@ -134,16 +135,18 @@ class NetCDFIO : public IOInterface {
 
 	private:
 		void parseInputOutputSection();
-		void scanPath(const std::string& in_path, const std::string& nc_ext, std::vector< std::pair<std::pair<Date,Date>, ncFiles> > &nc_files);
+		void updateGridsCatalog();
+		ncFiles& getGridFile(const MeteoGrids::Parameters& parameter, const Date& date);
 		void cleanMeteoCache(std::vector< std::pair<std::pair<Date,Date>, ncFiles> > &meteo_files);
 
 		const Config cfg;
-		std::vector< std::pair<std::pair<Date,Date>, ncFiles> > cache_grid_files; //cache of grid files in GRID2DPATH
+		FileUtils::GridsCatalog grids_catalog; ///< grids available in GRID2DPATH
+		std::map<std::string, ncFiles> cache_grid_files; //cache of the input grid files already opened
 		std::map<std::string, ncFiles> cache_grids_out; //cache of output GRID2D files
 		std::vector< ncFiles > cache_inmeteo_files; //cache of meteo files in input METEOPATH
 		std::set<std::string> in_stations; ///< only the stations IDs listed here will be returned by a call to readMeteoData/readStationData
 		std::vector<MeteoGrids::Parameters> available_params;
-		std::string in_schema, out_schema, in_grid2d_path, in_nc_ext, out_grid2d_path, grid2d_out_file;
+		std::string in_schema, out_schema, in_grid2d_path, grid2d_in_file, in_nc_ext, out_grid2d_path, grid2d_out_file;
 		std::string out_meteo_path, out_meteo_file;
 		bool debug, out_single_file;
 		bool split_by_year, split_by_var;
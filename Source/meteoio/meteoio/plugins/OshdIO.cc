@@ -23,6 +23,7 @@
 
 #include <matio.h>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 
@@ -100,6 +101,8 @@ namespace mio {
  * - DEMFILE: for reading the data as a DEMObject
  * - GRID2DPATH: meteo grids directory where to read/write the grids; [Input] and [Output] sections
  * - GRIDPATH_RECURSIVE: if set to true, grids will be searched recursively in GRID2DPATH (default: false)
+ * - GRID2D_CATALOG: existing directory where to keep the catalogue of the grids available in GRID2DPATH between runs
+ * (optional, see FileUtils::GridsCatalog); [Input] section
  * - OSHD_DEBUG: write out extra information to better show what is in the files
  *
  * @section oshd_example Example use
@@ -115,19 +118,74 @@ namespace mio {
  *
  */
 
+namespace {
+	//split a file name written as {param}_{timestep}_XXX_{runtime}{ext} into its timestep, run time and suffix (everything after the parameter)
+	bool parseOshdFilename(const std::string& filename, const std::string& ext, std::string& date_str, std::string& run_date, std::string& suffix)
+	{
+		const std::string::size_type rundate_end = filename.rfind('.');
+		if (rundate_end==string::npos) return false;
+		if (filename.substr(rundate_end)!=ext) return false;
+		const std::string::size_type pos_param = filename.find('_');
+		if (pos_param==string::npos) return false;
+		const std::string::size_type date_start = filename.find_first_of("0123456789");
+		if (date_start==string::npos) return false;
+		const std::string::size_type date_end = filename.find('_', date_start);
+		if (date_end==string::npos) return false;
+		const std::string::size_type rundate_start = filename.rfind('_');
+		if (rundate_start==string::npos) return false;
+
+		date_str = filename.substr(date_start, date_end-date_start);
+		run_date = filename.substr(rundate_start+1, rundate_end-rundate_start-1);
+		suffix = filename.substr(pos_param);
+		return true;
+	}
+
+	///get the timesteps of the grids from the "prec" file names, all the other parameters being expected at the same timesteps
+	class OshdFilesParser : public FileUtils::GridsCatalog::FileParser {
+		public:
+			OshdFilesParser(const std::map< MeteoGrids::Parameters, std::string >& i_grids_map, const std::string& i_ext, const double& i_TZ)
+			               : grids_map(i_grids_map), ext(i_ext), TZ(i_TZ) {}
+
+			void parse(const std::string& /*path*/, const std::string& filename, std::vector<FileUtils::GridsCatalog::catalog_entry>& entries) const
+			{
+				std::string date_str, run_date, suffix;
+				if (!parseOshdFilename(FileUtils::getFilename(filename), ext, date_str, run_date, suffix)) return;
+				Date date;
+				if (!IOUtils::convertString(date, date_str, TZ)) return;
+
+				std::map< MeteoGrids::Parameters, std::string >::const_iterator it;
+				for (it=grids_map.begin(); it!=grids_map.end(); ++it)
+					entries.push_back( FileUtils::GridsCatalog::catalog_entry(date, it->first, filename) );
+			}
+
+			std::string getSignature() const
+			{
+				std::ostringstream os;
+				os << "OSHD TZ=" << TZ << " ext=" << ext;
+				for (std::map< MeteoGrids::Parameters, std::string >::const_iterator it=grids_map.begin(); it!=grids_map.end(); ++it) os << " " << it->first;
+				return os.str();
+			}
+
+		private:
+			const std::map< MeteoGrids::Parameters, std::string >& grids_map;
+			const std::string ext;
+			const double TZ;
+	};
+}
+
 const char* OshdIO::meteo_ext = ".mat";
 const double OshdIO::in_dflt_TZ = 0.; //COSMO data is always GMT
 std::vector< std::pair<MeteoData::Parameters, std::string> > OshdIO::params_map;
 std::map< MeteoGrids::Parameters, std::string > OshdIO::grids_map;
 const bool OshdIO::__init = OshdIO::initStaticData();
 
-OshdIO::OshdIO(const std::string& configfile) : cfg(configfile), cache_meteo_files(), cache_grid_files(), vecMeta(), vecIDs(), vecIdx(),
+OshdIO::OshdIO(const std::string& configfile) : cfg(configfile), cache_meteo_files(), grids_catalog(), vecMeta(), vecIDs(), vecIdx(),
                coordin(), coordinparam(), grid2dpath_in(), in_meteopath(), in_metafile(), nrMetadata(0), debug(false)
 {
 	parseInputOutputSection();
 }
 
-OshdIO::OshdIO(const Config& cfgreader) : cfg(cfgreader), cache_meteo_files(), cache_grid_files(), vecMeta(), vecIDs(), vecIdx(),
+OshdIO::OshdIO(const Config& cfgreader) : cfg(cfgreader), cache_meteo_files(), grids_catalog(), vecMeta(), vecIDs(), vecIdx(),
                coordin(), coordinparam(), grid2dpath_in(), in_meteopath(), in_metafile(), nrMetadata(0), debug(false)
 {
 	parseInputOutputSection();
@@ -161,10 +219,12 @@ void OshdIO::parseInputOutputSection()
 		grid2dpath_in.clear();
 		cfg.getValue("GRID2DPATH", "Input", grid2dpath_in);
 		const bool is_recursive = cfg.get("GRIDPATH_RECURSIVE", "Input", false);
-		cache_grid_files = scanMeteoPath(grid2dpath_in, is_recursive);
+		std::string catalog_dir;
+		cfg.getValue("GRID2D_CATALOG", "Input", catalog_dir, IOUtils::nothrow);
+		grids_catalog = FileUtils::GridsCatalog(grid2dpath_in, "prec", catalog_dir, is_recursive); //we consider that if we have found one parameter, the others are also there
 		if (debug) {
-			std::cout << "Grid files cache content:\n";
-			for(size_t ii=0; ii<cache_grid_files.size(); ii++) std::cout << cache_grid_files[ii].toString() << "\n";
+			grids_catalog.update( OshdFilesParser(grids_map, meteo_ext, in_dflt_TZ) );
+			std::cout << "Grid files cache content:\n" << grids_catalog.toString();
 		}
 	}
 }
@@ -203,24 +263,10 @@ std::vector< struct OshdIO::file_index > OshdIO::scanMeteoPath(const std::string
 	std::map<std::string, size_t> mapIdx; //make sure each timestamp only appears once, ie remove duplicates
 	for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
 		const std::string file_and_path( *it );
-		const std::string filename( FileUtils::getFilename(file_and_path) );
 
 		//we need to split the file name into its components: parameter, date, run_date
-		const std::string::size_type rundate_end = filename.rfind('.');
-		if (rundate_end==string::npos) continue;
-		const std::string ext( filename.substr(rundate_end) );
-		if (ext!=meteo_ext) continue;
-		const std::string::size_type pos_param = filename.find('_');
-		if (pos_param==string::npos) continue;
-		const std::string::size_type date_start = filename.find_first_of("0123456789");
-		if (date_start==string::npos) continue;
-		const std::string::size_type date_end = filename.find('_', date_start);
-		if (date_end==string::npos) continue;
-		const std::string::size_type rundate_start = filename.rfind('_');
-		if (rundate_start==string::npos) continue;
-
-		const std::string date_str( filename.substr(date_start, date_end-date_start) );
-		const std::string run_date( filename.substr(rundate_start+1, rundate_end-rundate_start-1) );
+		std::string date_str, run_date, file_suffix;
+		if (!parseOshdFilename(FileUtils::getFilename(file_and_path), meteo_ext, date_str, run_date, file_suffix)) continue;
 
 		//do we already have an entry for this date?
 		size_t idx = IOUtils::npos;
@@ -234,7 +280,7 @@ std::vector< struct OshdIO::file_index > OshdIO::scanMeteoPath(const std::string
 		const std::string path( FileUtils::getPath(file_and_path) );
 		Date date;
 		IOUtils::convertString(date, date_str, in_dflt_TZ);
-		const file_index elem(date, path, filename.substr(pos_param), run_date);
+		const file_index elem(date, path, file_suffix, run_date);
 		if (idx==IOUtils::npos) {
 			data_files.push_back( elem );
 			mapIdx[ date_str ] = data_files.size()-1;
@@ -251,19 +297,8 @@ std::vector< struct OshdIO::file_index > OshdIO::scanMeteoPath(const std::string
 bool OshdIO::list2DGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> >& results)
 {
 	results.clear();
-	
-	for (size_t ii=0; ii<cache_grid_files.size(); ii++) {
-		const Date date( cache_grid_files[ii].date );
-		if (date<start) continue;
-		if (date>end) break;
-		
-		//we consider that all parameters are present at all timesteps
-		std::map< MeteoGrids::Parameters, std::string >::const_iterator it;
-		for (it=grids_map.begin(); it!=grids_map.end(); ++it) {
-			results[date].insert( it->first );
-		}
-	}
-	
+	grids_catalog.update( OshdFilesParser(grids_map, meteo_ext, in_dflt_TZ) );
+	grids_catalog.getGrids(start, end, results);
 	return true;
 }
 
@@ -556,13 +591,25 @@ void OshdIO::read2DGrid(Grid2DObject& grid_out, const std::string& filename)
 
 void OshdIO::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	const size_t file_idx = getFileIdx( cache_grid_files, date );
-	Date grid_date( cache_grid_files[file_idx].date );
-	if (grid_date!=date) return; //the requested date is NOT in the available files
+	grids_catalog.update( OshdFilesParser(grids_map, meteo_ext, in_dflt_TZ) );
+	std::vector<FileUtils::GridsCatalog::catalog_entry> grids;
+	grids_catalog.getEntries(date, date, grids);
+
+	//when multiple runs provide this timestep, keep the most recent one
+	std::string prec_file, run_date, file_suffix;
+	for (size_t ii=0; ii<grids.size(); ii++) {
+		std::string date_str, file_run_date, suffix;
+		if (!parseOshdFilename(FileUtils::getFilename(grids[ii].file), meteo_ext, date_str, file_run_date, suffix)) continue;
+		if (prec_file.empty() || file_run_date>run_date) {
+			prec_file = grids[ii].file;
+			run_date = file_run_date;
+			file_suffix = suffix;
+		}
+	}
+	if (prec_file.empty()) return; //the requested date is NOT in the available files
 
 	//build the proper file name
-	const std::string file_suffix( cache_grid_files[ file_idx ].file_suffix );
-	const std::string path( grid2dpath_in + "/" + cache_grid_files[ file_idx ].path );
+	const std::string path( grid2dpath_in + "/" + FileUtils::getPath(prec_file) );
 
 	if (grids_map.find(parameter)!=grids_map.end()) {
 		const std::string filename( path + "/" + grids_map[parameter] +file_suffix );
@@ -20,6 +20,7 @@
 #define OSHDIO_H
 
 #include <meteoio/IOInterface.h>
+#include <meteoio/FileUtils.h>
 
 #include <string>
 
@@ -81,7 +82,7 @@ class OshdIO : public IOInterface {
 		
 		const Config cfg;
 		std::vector< struct file_index > cache_meteo_files; //cache of meteo files in METEOPATH
-		std::vector< struct file_index > cache_grid_files; //cache of meteo files in METEOPATH
+		FileUtils::GridsCatalog grids_catalog; ///< grids available in GRID2DPATH
 		std::vector<StationData> vecMeta;
 		std::vector<std::string> vecIDs; ///< IDs of the stations that have to be read
 		std::vector<size_t> vecIdx; ///< index of each ID that should be read within the 'acro', 'names' and 'data' vectors
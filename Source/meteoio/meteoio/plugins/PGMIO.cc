@@ -46,6 +46,8 @@ namespace mio {
  * - COORDSYS: coordinate system (see Coords); [Input] and [Output] section
  * - COORDPARAM: extra coordinates parameters (see Coords); [Input] and [Output] section
  * - GRID2DPATH: meteo grids directory where to read/write the grids; [Input] and [Output] sections
+ * - GRID2D_CATALOG: existing directory where to keep the catalogue of the grids available in GRID2DPATH between runs
+ * (optional, see FileUtils::GridsCatalog); [Input] section
  * - PGM_XCOORD: lower left x coordinate; [Input] section
  * - PGM_YCOORD: lower left y coordinate; [Input] section
  * - PGM_CELLSIZE: cellsize in meters; [Input] section
@@ -65,12 +67,47 @@ namespace mio {
  * @endcode
  */
 
+namespace {
+	///get the date and parameter of the grids from their file names, as written by PGMIO::write2DGrid()
+	class PgmFilesParser : public FileUtils::GridsCatalog::FileParser {
+		public:
+			PgmFilesParser(const double& i_TZ) : TZ(i_TZ) {}
+
+			void parse(const std::string& /*path*/, const std::string& filename, std::vector<FileUtils::GridsCatalog::catalog_entry>& entries) const
+			{
+				if (FileUtils::getExtension( filename )!="pgm") return;
+				const std::string name( FileUtils::removeExtension( filename ) );
+				const std::string::size_type pos = name.find_last_of('_');
+				if (pos==std::string::npos) return;
+
+				std::string date_str( name.substr(0, pos) );
+				std::replace( date_str.begin(), date_str.end(), '.', ':');
+				Date date;
+				if (!IOUtils::convertString(date, date_str, TZ)) return;
+
+				const size_t param = MeteoGrids::getParameterIndex( name.substr(pos+1) );
+				if (param==IOUtils::npos) return;
+				entries.push_back( FileUtils::GridsCatalog::catalog_entry(date, param, filename) );
+			}
+
+			std::string getSignature() const
+			{
+				std::ostringstream os;
+				os << "PGM TZ=" << TZ;
+				return os.str();
+			}
+
+		private:
+			const double TZ;
+	};
+}
+
 const double PGMIO::plugin_nodata = 0.; //plugin specific nodata value. It can also be read by the plugin (depending on what is appropriate)
 
 PGMIO::PGMIO(const std::string& configfile)
        : cfg(configfile),
          coordin(), coordinparam(), coordout(), coordoutparam(),
-         grid2dpath_in(), grid2dpath_out()
+         grid2dpath_in(), grid2dpath_out(), grids_catalog()
 {
 	IOUtils::getProjectionParameters(cfg, coordin, coordinparam, coordout, coordoutparam);
 	getGridPaths();
@@ -79,7 +116,7 @@ PGMIO::PGMIO(const std::string& configfile)
 PGMIO::PGMIO(const Config& cfgreader)
        : cfg(cfgreader),
          coordin(), coordinparam(), coordout(), coordoutparam(),
-         grid2dpath_in(), grid2dpath_out()
+         grid2dpath_in(), grid2dpath_out(), grids_catalog()
 {
 	IOUtils::getProjectionParameters(cfg, coordin, coordinparam, coordout, coordoutparam);
 	getGridPaths();
@@ -93,6 +130,12 @@ void PGMIO::getGridPaths()
 	const std::string grid_out = IOUtils::strToUpper( cfg.get("GRID2D", "Output", "") );
 	if (grid_out == "PGM") //keep it synchronized with IOHandler.cc for plugin mapping!!
 		cfg.getValue("GRID2DPATH", "Output", grid2dpath_out);
+
+	if (!grid2dpath_in.empty()) {
+		std::string catalog_dir;
+		cfg.getValue("GRID2D_CATALOG", "Input", catalog_dir, IOUtils::nothrow);
+		grids_catalog = FileUtils::GridsCatalog(grid2dpath_in, ".pgm", catalog_dir);
+	}
 }
 
 size_t PGMIO::getNextHeader(std::vector<std::string>& vecString, const std::string& filename, std::ifstream& fin) 
@@ -251,28 +294,8 @@ void PGMIO::read2DGrid(Grid2DObject& grid_out, const std::string& filename) {
 bool PGMIO::list2DGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> > &results)
 {
 	results.clear();
-	std::list<std::string> dirlist( FileUtils::readDirectory(grid2dpath_in) ); //read everything. Toggle it to recursive if this changes in the plugin!
-	dirlist.sort();
-	
-	for (std::list<std::string>::const_iterator it = dirlist.begin(); it != dirlist.end(); ++it) {
-		const std::string ext( FileUtils::getExtension( *it ) );
-		if (ext!=".pgm") continue;
-		const std::string filename( FileUtils::removeExtension( FileUtils::getFilename(*it) ) );
-		const std::string::size_type pos = filename.find_last_of('_');
-		if (pos==std::string::npos) continue;
-		const std::string date_str( filename.substr(0, pos) );
-		
-		Date date;
-		if (!IOUtils::convertString(date, date_str, start.getTimeZone())) continue;
-		if (date<start) continue;
-		if (date>end) return true;
-		
-		const std::string param_str( filename.substr(pos) );
-		const size_t param = MeteoGrids::getParameterIndex( param_str );
-		if (param==IOUtils::npos) continue;
-		results[date].insert( param );
-	}
-	
+	grids_catalog.update( PgmFilesParser(start.getTimeZone()) );
+	grids_catalog.getGrids(start, end, results);
 	return true;
 }
 
@@ -20,6 +20,7 @@
 #define PGMIO_H
 
 #include <meteoio/IOInterface.h>
+#include <meteoio/FileUtils.h>
 
 #include <string>
 #include <sstream>
@@ -60,6 +61,7 @@ class PGMIO : public IOInterface {
 		static const double plugin_nodata; //plugin specific nodata value, e.g. -999
 		std::string coordin, coordinparam, coordout, coordoutparam; //projection parameters
 		std::string grid2dpath_in, grid2dpath_out;
+		FileUtils::GridsCatalog grids_catalog; ///< grids available in grid2dpath_in
 };
 
 } //namespace
@@ -24,7 +24,7 @@
 namespace mio {
 
 OrdinaryKrigingAlgorithm::OrdinaryKrigingAlgorithm(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm)
-                                            : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), variogram(), vario_types()
+                                            : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), variogram(), vario_types(), vario_params()
 {
 	bool has_linvario = false;
 	for (size_t ii=0; ii<vecArgs.size(); ii++) {
@@ -182,11 +182,24 @@ bool OrdinaryKrigingAlgorithm::computeVariogram(const bool& /*detrend_data*/)
 
 	size_t vario_index=0;
 	do {
-		const bool status = variogram.setModel(vario_types[vario_index], distData, variData);
+		const std::string& vario_type( vario_types[vario_index] );
+		bool status = false;
+
+		//warm start from the parameters found for the previous grid, that are usually close to the new ones
+		const std::map< std::string, std::vector<double> >::const_iterator it( vario_params.find(vario_type) );
+		if (it!=vario_params.end() && distData.size()>=it->second.size()) {
+			variogram.setModel(vario_type, distData, variData, false);
+			variogram.setGuess(it->second);
+			status = variogram.fit();
+		}
+		if (!status) status = variogram.setModel(vario_type, distData, variData); //cold start
+
 		if (status) {
-			info << " - " << vario_types[vario_index];
+			vario_params[vario_type] = variogram.getParams();
+			info << " - " << vario_type;
 			return true;
 		}
+		vario_params.erase(vario_type);
 
 		vario_index++;
 	} while (vario_index<vario_types.size());
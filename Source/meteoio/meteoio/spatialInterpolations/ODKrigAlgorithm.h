@@ -22,6 +22,8 @@
 #include <meteoio/spatialInterpolations/InterpolationAlgorithms.h>
 #include <meteoio/meteoStats/libinterpol1D.h>
 
+#include <map>
+
 namespace mio {
 
 /**
@@ -38,7 +40,9 @@ namespace mio {
  * (thus reflecting the time-correlation between stations) has not brought any significant improvements, so it is currently
  * not used (although implemented).
  *
- * Please note that the variogram and krigging coefficients are re-computed fresh for each new grid (or time step).
+ * Please note that the variogram and krigging coefficients are re-computed for each new grid (or time step). The fit of
+ * each variogram model starts from the parameters found for the previous grid (if any), so it usually converges within
+ * a few iterations; if this fails, the fit is done again from the default guess.
  * The available variogram models are found in Fit1D::regression and given as optional VARIO argument
  * (by default, LINVARIO is used). Several models can be given, the first that can fit the data will be used
  * for the current timestep:
@@ -59,6 +63,7 @@ class OrdinaryKrigingAlgorithm : public InterpolationAlgorithm {
 		bool computeVariogram(const bool& detrend_data=false);
 		Fit1D variogram;
 		std::vector<std::string> vario_types;
+		std::map< std::string, std::vector<double> > vario_params; ///< last successful parameters of each variogram model, for warm starts
 };
 
 } //end namespace mio
@@ -175,37 +175,33 @@ void SnowlineAlgorithm::assimilateBands(const double& snowline, const DEMObject&
 
 void SnowlineAlgorithm::assimilateFormula(const double& snowline, const DEMObject& dem, Grid2DObject& grid)
 { //set to result of formula evaluated at grid points
-	std::vector< std::pair<std::string, double> > substitutions; //fixed memory for tinyexpr
-
 	static const size_t nr_sub = 3;
 	static const std::string sub[nr_sub] = {"snowline", "altitude", "param"};
-	for (size_t ii = 0; ii < nr_sub; ++ii) {
-		std::pair<std::string, double> item(sub[ii], IOUtils::nodata);
-		substitutions.push_back(item);
-	}
-	substitutions[0].second = snowline; //this is the same for all points
-
-	te_variable *te_vars = new te_variable[substitutions.size()];
-	initExpressionVars(substitutions, te_vars); //build te_variables from substitution vector
-	te_expr *expr_formula = compileExpression(formula_, te_vars, nr_sub);
-
-	for (size_t ii = 0; ii < grid.getNx(); ++ii) {
-		for (size_t jj = 0; jj < grid.getNy(); ++jj) {
-			if (dem(ii, jj) == IOUtils::nodata)
-				continue;
-			if (dem(ii, jj) < snowline) {
+	const std::vector<std::string> variables(sub, sub + nr_sub);
+
+	ColumnExpression expr_formula;
+	compileExpression(formula_, variables, expr_formula);
+	expr_formula.bindValue(0, snowline); //this is the same for all points
+
+	//the formula is evaluated on whole rows of the grid at once
+	const size_t nx = grid.getNx();
+	if (nx == 0) return;
+	std::vector<double> altitude(nx);
+	std::vector<char> mask(nx);
+	expr_formula.bindColumn(1, &altitude[0]); //point-dependent substitutions
+
+	for (size_t jj = 0; jj < grid.getNy(); ++jj) {
+		for (size_t ii = 0; ii < nx; ++ii) {
+			altitude[ii] = dem(ii, jj);
+			mask[ii] = (altitude[ii] != IOUtils::nodata && altitude[ii] >= snowline);
+			if (altitude[ii] != IOUtils::nodata && altitude[ii] < snowline)
 				grid(ii, jj) = cutoff_val_;
-				continue;
-			}
-
-			substitutions[1].second = dem(ii, jj); //point-dependent substitutions
-			substitutions[2].second = grid(ii, jj);
-			grid(ii, jj) = te_eval(expr_formula);
 		}
-	}
 
-	te_free(expr_formula);
-	delete[] te_vars;
+		double *row = &grid.grid2D(0, jj);
+		expr_formula.bindColumn(2, row);
+		expr_formula.evaluate(nx, row, &mask[0]);
+	}
 }
 
 Grid2DObject SnowlineAlgorithm::mergeSlopes(const DEMObject& dem, const std::vector<Grid2DObject>& azi_grids)
@@ -248,27 +244,12 @@ Grid2DObject SnowlineAlgorithm::mergeSlopes(const DEMObject& dem, const std::vec
 	return outgrid;
 }
 
-void SnowlineAlgorithm::initExpressionVars(const std::vector< std::pair<std::string, double> >& substitutions, te_variable* vars) const
-{ //build a substitutions expression for tinyexpr
-	size_t cc = 0;
-	for (std::vector< std::pair<std::string, double> >::const_iterator it = substitutions.begin();
-	    it != substitutions.end(); ++it) {
-		vars[cc].name = it->first.c_str();
-		vars[cc].address = &it->second;
-		vars[cc].type = 0;
-		vars[cc].context = nullptr;
-		cc++;
-	}
-}
-
-te_expr* SnowlineAlgorithm::compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const
+void SnowlineAlgorithm::compileExpression(const std::string& expression, const std::vector<std::string>& variables, ColumnExpression& expr) const
 { //ready the lazy expressions (with syntax check)
 	int te_err;
-	te_expr *expr = te_compile(expression.c_str(), te_vars, static_cast<int>(sz), &te_err);
-	if (!expr)
+	if (!expr.compile(expression, variables, te_err))
 		throw InvalidFormatException("Arithmetic expression \"" + expression +
 		        "\" could not be evaluated for " + where_ + "; parse error at " + IOUtils::toString(te_err), AT);
-	return expr;
 }
 
 /**
@@ -659,3 +659,21 @@ static void pn (const te_expr *n, int depth) {
 void te_print(const te_expr *n) {
     pn(n, 0);
 }
+
+
+/* MeteoIO addition (altered source): inspection of compiled expressions */
+int te_is_constant(const te_expr *n) {
+    return (n && TYPE_MASK(n->type) == TE_CONSTANT);
+}
+
+char te_operator(const void *function) {
+    if (function == (const void*)add) return '+';
+    if (function == (const void*)sub) return '-';
+    if (function == (const void*)mul) return '*';
+    if (function == (const void*)divide) return '/';
+    if (function == (const void*)pow) return '^';
+    if (function == (const void*)fmod) return '%';
+    if (function == (const void*)comma) return ',';
+    if (function == (const void*)negate) return 'n';
+    return 0;
+}
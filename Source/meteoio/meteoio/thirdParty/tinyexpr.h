@@ -79,6 +79,14 @@ void te_print(const te_expr *n);
 /* This is safe to call on NULL pointers. */
 void te_free(te_expr *n);
 
+/* MeteoIO addition (altered source): inspection of compiled expressions, */
+/* so they can be translated for evaluation over whole arrays. */
+/* Returns 1 if the node is a constant (its value is then in n->value). */
+int te_is_constant(const te_expr *n);
+/* Returns the symbol of the built-in operator implemented by function ('+', '-', '*', '/', '^', '%', ',', */
+/* or 'n' for the negation), or 0 if function is not one of the built-in operators. */
+char te_operator(const void *function);
+
 
 #ifdef __cplusplus
 }
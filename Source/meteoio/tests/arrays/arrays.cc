@@ -205,6 +205,70 @@ bool matrix(const size_t& n) {
 	return status;
 }
 
+bool compactGrid2d(const unsigned int& n) {
+	cout << "Testing CompactGrid2D\n";
+	bool status = true;
+	srand((unsigned)time(0));
+	const double range = 10.;
+	Coords llcorner("CH1903","");
+	llcorner.setXY(785425. , 191124., 1400.);
+
+	Grid2DObject grid1(n, n, 100, llcorner);
+	for(unsigned int jj=0; jj<grid1.getNy(); jj++) {
+		for(unsigned int ii=0; ii<grid1.getNx(); ii++) {
+			grid1.grid2D(ii,jj) = 1. + (double)rand()/(double)RAND_MAX*range;
+		}
+	}
+	grid1.grid2D(0,0) = IOUtils::nodata;
+
+	CompactGrid2D compact1(grid1);
+	if(compact1.getCount()!=grid1.grid2D.getCount() || compact1.isValid(0,0)) {
+		cout << "\terror: the validity mask does not match the nodata cells!\n";
+		status=false;
+	}
+	if(!IOUtils::checkEpsilonEquality(compact1.getMean(), grid1.grid2D.getMean(), 1e-5)) {
+		cout << "\terror: statistics on the compact grid fail!\n";
+		status=false;
+	}
+
+	CompactGrid2D compact2(compact1);
+	compact2 -= 8.;
+	compact2 /= 2.;
+	compact2 += 4.;
+	compact2 *= 2.;
+	Grid2DObject grid2;
+	compact2.get(grid2);
+	if(!grid2.isSameGeolocalization(grid1) || grid2.grid2D(0,0)!=IOUtils::nodata || !grid2.grid2D.checkEpsilonEquality(grid1.grid2D, 1e-5)) {
+		cout << "\terror: basic operations with constants fail!\n";
+		status=false;
+	}
+
+	compact2 /= compact1;
+	if(!IOUtils::checkEpsilonEquality(compact2.getMean(), 1., 1e-5)) {
+		cout << "\terror: grids division fails!\n";
+		status=false;
+	}
+	compact2.setValue(1, 0, IOUtils::nodata);
+	compact2 *= compact1;
+	if(compact2.getCount()!=compact1.getCount()-1) {
+		cout << "\terror: the validity masks are not combined!\n";
+		status=false;
+	}
+
+	//a grid buffered in compact form must have the same values whether it has just been pushed or is read from the buffer
+	GridBuffer buffer(5);
+	buffer.setCompact(true);
+	Grid2DObject pushed(grid1), buffered;
+	pushed.grid2D(1,1) = 1./3.;
+	buffer.pushAndGet(pushed, MeteoGrids::TA, Date(2020, 1, 1, 0, 0, 1.));
+	if(!buffer.get(buffered, MeteoGrids::TA, Date(2020, 1, 1, 0, 0, 1.)) || !(pushed.grid2D==buffered.grid2D) || pushed.grid2D(1,1)!=buffered.grid2D(1,1)
+	    || pushed.grid2D(1,1)!=static_cast<double>(1.f/3.f)) {
+		cout << "\terror: the pushed grid is different from the buffered one!\n";
+		status=false;
+	}
+
+	return status;
+}
 
 int main() {
 	const unsigned int n=50;
@@ -212,7 +276,8 @@ int main() {
 	const bool grid1d_status = array1d(n);
 	const bool grid2d_status = grid2d(n);
 	const bool grid3d_status = grid3d(n);
+	const bool compact_status = compactGrid2d(n);
 	const bool matrix_status = matrix(n);
-	if(grid1d_status!=true || grid2d_status!=true || grid3d_status!=true || matrix_status!=true) throw IOException("Grid/Matrix error", AT);
+	if(grid1d_status!=true || grid2d_status!=true || grid3d_status!=true || compact_status!=true || matrix_status!=true) throw IOException("Grid/Matrix error", AT);
 	return 0;
 }
@@ -0,0 +1,558 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sys/stat.h>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+/*
+ * Performance benchmarks for MeteoIO.
+ * All inputs are synthetic and generated (with a fixed seed) in a work directory that is removed at exit, so the results only
+ * depend on the code and on the machine. Each benchmark is run several times and the best time is kept, it is then reported together with
+ * its throughput (number of items processed per second).
+ *
+ * Usage: benchmarks [--size=tiny|small|medium|large] [--repeat=n] [--only=pattern] [--save=file] [--baseline=file] [--tolerance=0.2]
+ *   --size       size of the synthetic inputs (default: small)
+ *   --repeat     number of runs for each benchmark (default: 3)
+ *   --only       only run the benchmarks whose name contains the given pattern
+ *   --save       write the throughputs to the given file, so it can be used later as a baseline
+ *   --baseline   compare the throughputs with the given baseline and return an error if some benchmarks are slower
+ *                than (1-tolerance) times their baseline
+ *   --tolerance  relative tolerance for the comparison with the baseline (default: 0.2)
+ */
+
+struct BenchSize {
+	const char* name;
+	size_t dem_nx, dem_ny; //dimensions of the DEM
+	size_t nr_stations; //number of stations of the network
+	size_t nr_days; //length of the hourly time series
+	size_t csv_records; //number of lines of the CSV file
+};
+
+static const BenchSize bench_sizes[] = {
+	{"tiny", 40, 30, 4, 5, 2000},
+	{"small", 200, 150, 20, 60, 100000},
+	{"medium", 500, 400, 60, 365, 1000000},
+	{"large", 1000, 800, 200, 730, 4000000}
+};
+
+static const double cellsize = 100.;
+static const double TZ = 1.;
+static const std::string work_dir( "meteoio_benchmarks_work" ); //all the generated files go there
+
+//the work directory is created empty and removed with all its content when going out of scope
+class WorkDirectory {
+	public:
+		WorkDirectory() { clean(); mkdir(work_dir.c_str(), 0755); }
+		~WorkDirectory() { clean(); }
+	private:
+		static void clean() {
+			if (!FileUtils::directoryExists(work_dir)) return;
+			const std::list<std::string> files( FileUtils::readDirectory(work_dir) );
+			for (std::list<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) std::remove( (work_dir+"/"+*it).c_str() );
+			std::remove( work_dir.c_str() );
+		}
+};
+
+//a small deterministic pseudo random number generator, so the inputs are the same on all platforms
+class Lcg {
+	public:
+		Lcg(const unsigned int& seed) : state(seed) {}
+		double operator()() { state = state*1664525u + 1013904223u; return static_cast<double>(state) / 4294967296.; } //in [0,1[
+	private:
+		unsigned int state;
+};
+
+struct BenchResult {
+	BenchResult(const std::string& i_name, const std::string& i_unit, const double& i_items, const double& i_seconds)
+	            : name(i_name), unit(i_unit), items(i_items), seconds(i_seconds) {}
+	double throughput() const {return (seconds>0.)? items/seconds : 0.;}
+
+	std::string name, unit;
+	double items, seconds;
+};
+
+class Benchmarks {
+	public:
+		Benchmarks(const size_t& i_repeat, const std::string& i_only) : results(), only(i_only), repeat(i_repeat) {}
+
+		/**
+		 * @brief Run one benchmark
+		 * @param name benchmark name
+		 * @param unit unit of the items that are processed
+		 * @param items number of items processed by one run
+		 * @param func the benchmark itself. It must start/stop the timer around the part to measure, so it can do some setup.
+		 */
+		void run(const std::string& name, const std::string& unit, const double& items, const std::function<void(Timer&)>& func)
+		{
+			if (!only.empty() && name.find(only)==std::string::npos) return;
+
+			double best = -1.;
+			try {
+				for (size_t ii=0; ii<repeat; ii++) {
+					Timer timer;
+					func(timer);
+					timer.stop();
+					if (best<0. || timer.getElapsed()<best) best = timer.getElapsed();
+				}
+			} catch (const std::exception& e) {
+				//only keep the last line of the message, without the backtrace nor the colors
+				std::string msg( e.what() );
+				msg.erase(msg.find_last_not_of(" \n") + 1);
+				msg.erase(0, msg.find_last_of('\n') + 1);
+				for (size_t pos=msg.find('\033'); pos!=std::string::npos; pos=msg.find('\033'))
+					msg.erase(pos, msg.find('m', pos) - pos + 1);
+				std::cout << std::left << std::setw(36) << name << " skipped: " << msg << "\n";
+				return;
+			}
+
+			results.push_back( BenchResult(name, unit, items, best) );
+			const BenchResult& res = results.back();
+			std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(4) << std::setw(12) << res.seconds << " s";
+			std::cout << std::scientific << std::setprecision(3) << std::setw(14) << res.throughput() << " " << unit << "/s\n";
+			std::cout.unsetf(std::ios::floatfield);
+		}
+
+		void save(const std::string& filename) const
+		{
+			std::ofstream fout(filename.c_str());
+			if (fout.fail()) throw AccessException(filename, AT);
+			fout << "#benchmark throughput unit\n";
+			for (size_t ii=0; ii<results.size(); ii++)
+				fout << results[ii].name << " " << std::setprecision(10) << results[ii].throughput() << " " << results[ii].unit << "/s\n";
+		}
+
+		//return the number of benchmarks that are slower than their baseline
+		size_t compare(const std::string& filename, const double& tolerance) const
+		{
+			std::ifstream fin(filename.c_str());
+			if (fin.fail()) throw AccessException(filename, AT);
+			std::map<std::string, double> baseline;
+			std::string line;
+			while (std::getline(fin, line)) {
+				if (line.empty() || line[0]=='#') continue;
+				std::istringstream iss(line);
+				std::string name;
+				double throughput;
+				if (iss >> name >> throughput) baseline[name] = throughput;
+			}
+
+			size_t nr_slower = 0;
+			std::cout << "\nComparison with " << filename << " (tolerance: " << tolerance*100. << "%)\n";
+			for (size_t ii=0; ii<results.size(); ii++) {
+				const std::map<std::string, double>::const_iterator it( baseline.find(results[ii].name) );
+				if (it==baseline.end() || it->second<=0.) continue;
+				const double ratio = results[ii].throughput() / it->second;
+				const bool slower = (ratio < 1.-tolerance);
+				if (slower) nr_slower++;
+				std::cout << std::left << std::setw(36) << results[ii].name << std::right << std::fixed << std::setprecision(2);
+				std::cout << std::setw(8) << ratio << "x" << (slower? "   <-- slower" : "") << "\n";
+			}
+			return nr_slower;
+		}
+
+	private:
+		std::vector<BenchResult> results;
+		const std::string only;
+		const size_t repeat;
+};
+
+////////////////////////////////// synthetic inputs
+DEMObject makeDEM(const BenchSize& sz)
+{
+	Coords llcorner("CH1903", "");
+	llcorner.setXY(700000., 150000., IOUtils::nodata);
+	Array2D<double> altitude(sz.dem_nx, sz.dem_ny);
+	for (size_t jj=0; jj<sz.dem_ny; jj++) {
+		for (size_t ii=0; ii<sz.dem_nx; ii++) {
+			const double x = static_cast<double>(ii) / static_cast<double>(sz.dem_nx);
+			const double y = static_cast<double>(jj) / static_cast<double>(sz.dem_ny);
+			altitude(ii,jj) = 1500. + 800.*sin(6.*x)*cos(5.*y) + 300.*x*y;
+		}
+	}
+	return DEMObject(cellsize, llcorner, altitude);
+}
+
+std::vector<StationData> makeStations(const DEMObject& dem, const size_t& nr_stations)
+{
+	Lcg rng(42);
+	std::vector<StationData> vecStations;
+	for (size_t st=0; st<nr_stations; st++) {
+		const size_t ii = static_cast<size_t>( rng() * static_cast<double>(dem.getNx()-1) );
+		const size_t jj = static_cast<size_t>( rng() * static_cast<double>(dem.getNy()-1) );
+		Coords position( dem.llcorner );
+		position.setXY(dem.llcorner.getEasting() + static_cast<double>(ii)*dem.cellsize, dem.llcorner.getNorthing() + static_cast<double>(jj)*dem.cellsize, dem.grid2D(ii,jj));
+		std::ostringstream id;
+		id << "BENCH" << std::setfill('0') << std::setw(4) << st;
+		vecStations.push_back( StationData(position, id.str(), id.str()) );
+	}
+	return vecStations;
+}
+
+//hourly time series with daily and seasonal cycles, noise and a few spikes (so the filters have something to do)
+std::vector< std::vector<MeteoData> > makeTimeSeries(const std::vector<StationData>& vecStations, const Date& start, const size_t& nr_days)
+{
+	static const double two_pi = 2.*Cst::PI;
+	const size_t nr_steps = nr_days * 24;
+	Lcg rng(1234);
+	std::vector< std::vector<MeteoData> > vecvecMeteo( vecStations.size() );
+	for (size_t st=0; st<vecStations.size(); st++) {
+		const double altitude = vecStations[st].position.getAltitude();
+		double hs = 0.5;
+		vecvecMeteo[st].reserve( nr_steps );
+		for (size_t kk=0; kk<nr_steps; kk++) {
+			const double day = static_cast<double>(kk) / 24.;
+			const double daily = sin( two_pi*(day - 0.3) );
+			const double seasonal = -cos( two_pi*day/365. );
+			MeteoData md(start + day, vecStations[st]);
+			double ta = 273.15 + 2. - 0.0065*(altitude-1500.) + 6.*daily + 10.*seasonal + 3.*(rng()-0.5);
+			if (kk%997==0) ta += 40.; //spike
+			const double psum = (rng()<0.1)? 3.*rng() : 0.;
+			hs = std::max(0., hs + ((ta<273.15)? psum*0.01 : -0.002));
+			md(MeteoData::TA) = ta;
+			md(MeteoData::RH) = 0.7 - 0.2*daily + 0.2*(rng()-0.5);
+			md(MeteoData::VW) = 4. + 3.*rng();
+			md(MeteoData::DW) = 360.*rng();
+			md(MeteoData::ISWR) = std::max(0., 900.*daily);
+			md(MeteoData::RSWR) = std::max(0., 500.*daily);
+			md(MeteoData::ILWR) = 250. + 40.*rng();
+			md(MeteoData::PSUM) = psum;
+			md(MeteoData::HS) = hs;
+			md(MeteoData::TSG) = 273.15 + 0.5*rng();
+			vecvecMeteo[st].push_back( md );
+		}
+	}
+	return vecvecMeteo;
+}
+
+void writeCSV(const std::string& filename, const Date& start, const size_t& nr_records)
+{
+	std::ofstream fout(filename.c_str());
+	if (fout.fail()) throw AccessException(filename, AT);
+	Lcg rng(99);
+	fout << "TIMESTAMP,TA,RH,VW,ISWR,PSUM\n";
+	fout << std::fixed << std::setprecision(3);
+	for (size_t kk=0; kk<nr_records; kk++) {
+		const Date date( start + static_cast<double>(kk)/144. ); //10 minutes time step
+		fout << date.toString(Date::ISO) << "," << 270.+10.*rng() << "," << 0.5+0.5*rng() << "," << 10.*rng() << "," << 800.*rng() << "," << 2.*rng() << "\n";
+	}
+}
+
+//configuration for writing the benchmarks' data
+Config makeOutputConfig()
+{
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("COORDSYS", "Output", "CH1903");
+	cfg.addKey("TIME_ZONE", "Output", "1");
+	cfg.addKey("METEO", "Output", "SMET");
+	cfg.addKey("METEOPATH", "Output", work_dir);
+	cfg.addKey("GRID2D", "Output", "ARC");
+	cfg.addKey("GRID2DPATH", "Output", work_dir);
+	return cfg;
+}
+
+//configuration for reading the stations' data (the SMET files must already exist)
+Config makeInputConfig(const std::vector<StationData>& vecStations)
+{
+	Config cfg( makeOutputConfig() );
+	cfg.addKey("METEO", "Input", "SMET");
+	cfg.addKey("METEOPATH", "Input", work_dir);
+	for (size_t st=0; st<vecStations.size(); st++) {
+		std::ostringstream key;
+		key << "STATION" << st+1;
+		cfg.addKey(key.str(), "Input", vecStations[st].stationID+".smet");
+	}
+	cfg.addKey("GRID2D", "Input", "ARC");
+	cfg.addKey("GRID2DPATH", "Input", work_dir);
+	return cfg;
+}
+
+////////////////////////////////// benchmarks
+void benchReadWrite(Benchmarks& bench, const Config& out_cfg, const Config& in_cfg, const std::vector< std::vector<MeteoData> >& vecvecMeteo, const Date& start, const BenchSize& sz)
+{
+	const double nr_values = static_cast<double>(vecvecMeteo.size() * vecvecMeteo.front().size() * 10);
+	const Date end( vecvecMeteo.front().back().date );
+
+	bench.run("smet_write", "values", nr_values, [&](Timer& timer) {
+		IOManager io(out_cfg);
+		timer.start();
+		io.writeMeteoData(vecvecMeteo);
+	});
+
+	bench.run("smet_read", "values", nr_values, [&](Timer& timer) {
+		IOManager io(in_cfg);
+		std::vector< std::vector<MeteoData> > vecvecRead;
+		timer.start();
+		io.getMeteoData(start, end, vecvecRead);
+		timer.stop();
+		if (vecvecRead.size()!=vecvecMeteo.size() || vecvecRead.front().size()!=vecvecMeteo.front().size())
+			throw IOException("The SMET files could not be read back", AT);
+	});
+
+	writeCSV(work_dir+"/bench_station.csv", start, sz.csv_records);
+	Config csv_cfg;
+	csv_cfg.addKey("COORDSYS", "Input", "CH1903");
+	csv_cfg.addKey("TIME_ZONE", "Input", "1");
+	csv_cfg.addKey("METEO", "Input", "CSV");
+	csv_cfg.addKey("METEOPATH", "Input", work_dir);
+	csv_cfg.addKey("STATION1", "Input", "bench_station.csv");
+	csv_cfg.addKey("POSITION1", "Input", "xy (700000, 150000, 1500)");
+	csv_cfg.addKey("CSV1_ID", "Input", "CSVBENCH");
+	csv_cfg.addKey("CSV_NR_HEADERS", "Input", "1");
+	csv_cfg.addKey("CSV_COLUMNS_HEADERS", "Input", "1");
+	const Date csv_end( start + static_cast<double>(sz.csv_records-1)/144. );
+	bench.run("csv_read", "values", static_cast<double>(sz.csv_records*5), [&](Timer& timer) {
+		IOManager io(csv_cfg);
+		std::vector< std::vector<MeteoData> > vecvecRead;
+		timer.start();
+		io.getMeteoData(start, csv_end, vecvecRead);
+		timer.stop();
+		if (vecvecRead.size()!=1 || vecvecRead.front().size()!=sz.csv_records)
+			throw IOException("The CSV file could not be read back", AT);
+	});
+}
+
+void benchFilters(Benchmarks& bench, const std::vector< std::vector<MeteoData> >& vecvecMeteo)
+{
+	Config cfg;
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("TA::filter1", "Filters", "min_max");
+	cfg.addKey("TA::arg1::min", "Filters", "230");
+	cfg.addKey("TA::arg1::max", "Filters", "320");
+	cfg.addKey("TA::filter2", "Filters", "rate");
+	cfg.addKey("TA::arg2::max", "Filters", "0.01");
+	cfg.addKey("TA::filter3", "Filters", "mad");
+	cfg.addKey("TA::arg3::soft", "Filters", "true");
+	cfg.addKey("TA::arg3::centering", "Filters", "center");
+	cfg.addKey("TA::arg3::min_pts", "Filters", "10");
+	cfg.addKey("TA::arg3::min_span", "Filters", "21600");
+	cfg.addKey("TA::filter4", "Filters", "wma_smoothing");
+	cfg.addKey("TA::arg4::centering", "Filters", "right");
+	cfg.addKey("TA::arg4::min_pts", "Filters", "3");
+	cfg.addKey("TA::arg4::min_span", "Filters", "3600");
+
+	const double nr_values = static_cast<double>(vecvecMeteo.size() * vecvecMeteo.front().size());
+	bench.run("filters_TA_chain", "values", nr_values, [&](Timer& timer) {
+		ProcessingStack stack(cfg, "TA");
+		std::vector< std::vector<MeteoData> > vecvecFiltered;
+		timer.start();
+		stack.process(vecvecMeteo, vecvecFiltered);
+	});
+
+	cfg.addKey("RH::filter1", "Filters", "min_max");
+	cfg.addKey("RH::arg1::min", "Filters", "0.01");
+	cfg.addKey("RH::arg1::max", "Filters", "1.2");
+	cfg.addKey("RH::filter2", "Filters", "min_max");
+	cfg.addKey("RH::arg2::soft", "Filters", "true");
+	cfg.addKey("RH::arg2::min", "Filters", "0.05");
+	cfg.addKey("RH::arg2::max", "Filters", "1.0");
+	bench.run("filters_RH_min_max", "values", nr_values, [&](Timer& timer) {
+		ProcessingStack stack(cfg, "RH");
+		std::vector< std::vector<MeteoData> > vecvecFiltered;
+		timer.start();
+		stack.process(vecvecMeteo, vecvecFiltered);
+	});
+
+	cfg.addKey("TSS::filter1", "Filters", "maths");
+	cfg.addKey("TSS::arg1::formula", "Filters", "meteo(TA) - 2 - 3 * (1 - meteo(RH)) + 0.001 * (altitude - 1500)");
+	cfg.addKey("TSS::arg1::formula_else", "Filters", "meteo(TA) + 0.5");
+	cfg.addKey("TSS::arg1::expression1", "Filters", "meteo(RH)");
+	cfg.addKey("TSS::arg1::operator1", "Filters", "LT");
+	cfg.addKey("TSS::arg1::compare1", "Filters", "0.9");
+	cfg.addKey("TSS::arg1::expression2", "Filters", "hour");
+	cfg.addKey("TSS::arg1::operator2", "Filters", "GE");
+	cfg.addKey("TSS::arg1::compare2", "Filters", "6");
+	bench.run("filters_TSS_maths", "values", nr_values, [&](Timer& timer) {
+		ProcessingStack stack(cfg, "TSS");
+		std::vector< std::vector<MeteoData> > vecvecFiltered;
+		timer.start();
+		stack.process(vecvecMeteo, vecvecFiltered);
+	});
+}
+
+void benchResampling(Benchmarks& bench, const std::vector< std::vector<MeteoData> >& vecvecMeteo)
+{
+	Config cfg;
+	cfg.addKey("WINDOW_SIZE", "Interpolations1D", "86400");
+	cfg.addKey("TA::resample", "Interpolations1D", "linear");
+	cfg.addKey("RH::resample", "Interpolations1D", "linear");
+	cfg.addKey("HS::resample", "Interpolations1D", "linear");
+	cfg.addKey("VW::resample", "Interpolations1D", "nearest");
+	cfg.addKey("PSUM::resample", "Interpolations1D", "accumulate");
+	cfg.addKey("PSUM::accumulate::period", "Interpolations1D", "3600");
+
+	const size_t nr_steps = vecvecMeteo.front().size() - 1;
+	const double nr_records = static_cast<double>(vecvecMeteo.size() * nr_steps);
+	bench.run("resampling_1D", "records", nr_records, [&](Timer& timer) {
+		Meteo1DInterpolator interpolator(cfg);
+		timer.start();
+		for (size_t st=0; st<vecvecMeteo.size(); st++) {
+			const std::vector<MeteoData>& vecM( vecvecMeteo[st] );
+			const std::string hash( vecM.front().meta.getHash() );
+			for (size_t kk=0; kk<nr_steps; kk++) {
+				MeteoData md( vecM[kk] );
+				md.setDate( vecM[kk].date + 0.5/24. ); //in between two measurements
+				interpolator.resampleData(md.date, hash, vecM, md);
+			}
+		}
+	});
+}
+
+void benchSpatialInterpolations(Benchmarks& bench, const Config& in_cfg, const DEMObject& dem, const Date& start)
+{
+	//parameter, algorithm and its arguments
+	static const char* algorithms[][3] = {
+		{"TA", "NEAREST", ""},
+		{"TA", "AVG", ""},
+		{"TA", "AVG_LAPSE", ""},
+		{"TA", "IDW", ""},
+		{"TA", "IDW_LAPSE", ""},
+		{"TA", "LIDW_LAPSE", "NEIGHBORS=4"},
+		{"TA", "ODKRIG", ""},
+		{"TA", "ODKRIG_LAPSE", ""},
+		{"RH", "LISTON_RH", ""},
+		{"VW", "LISTON_WIND", ""},
+		{"ISWR", "SWRAD", ""},
+		{"PSUM", "PSUM_SNOW", "BASE=IDW_LAPSE"}
+	};
+	static const size_t nr_dates = 3;
+	const double nr_cells = static_cast<double>(dem.getNx() * dem.getNy() * nr_dates);
+
+	for (size_t ii=0; ii<sizeof(algorithms)/sizeof(algorithms[0]); ii++) {
+		const std::string param( algorithms[ii][0] ), algo( algorithms[ii][1] ), args( algorithms[ii][2] );
+		Config cfg( in_cfg );
+		cfg.addKey("TA::algorithms", "Interpolations2D", "IDW_LAPSE"); //some algorithms rely on the TA grid, it is then part of the measured time
+		cfg.addKey(param+"::algorithms", "Interpolations2D", algo);
+		if (!args.empty()) {
+			const size_t pos = args.find('=');
+			cfg.addKey(param+"::"+algo+"::"+args.substr(0, pos), "Interpolations2D", args.substr(pos+1));
+		}
+		const MeteoData::Parameters meteoparam = static_cast<MeteoData::Parameters>( MeteoData::getStaticParameterIndex(param) );
+
+		bench.run("interpol2D_"+param+"_"+algo, "cells", nr_cells, [&](Timer& timer) {
+			IOManager io(cfg);
+			std::vector<MeteoData> vecMeteo;
+			io.getMeteoData(start+2., vecMeteo); //fill the buffers so only the interpolations are measured
+			Grid2DObject grid;
+			std::string info;
+			timer.start();
+			for (size_t dd=0; dd<nr_dates; dd++) //one new date each time so the grids buffer does not help
+				io.getMeteoData(start+2.+static_cast<double>(dd)/24., dem, meteoparam, grid, info);
+		});
+	}
+}
+
+void benchGrids(Benchmarks& bench, const Config& out_cfg, const DEMObject& dem)
+{
+	static const size_t nr_ops = 10;
+	const double nr_cells = static_cast<double>(dem.getNx() * dem.getNy());
+	bench.run("grid_arithmetic", "cells", nr_cells*nr_ops, [&](Timer& timer) {
+		Grid2DObject grid_a(dem, 1.), grid_b(dem, 2.);
+		timer.start();
+		for (size_t ii=0; ii<nr_ops; ii++) {
+			grid_a.grid2D += grid_b.grid2D;
+			grid_a.grid2D *= 0.5;
+			grid_b.grid2D += grid_a.grid2D.getMean();
+		}
+	});
+
+	bench.run("grid_slopes", "cells", nr_cells, [&](Timer& timer) {
+		DEMObject tmp_dem( dem, false );
+		timer.start();
+		tmp_dem.update();
+	});
+
+	bench.run("grid_write_ARC", "cells", nr_cells, [&](Timer& timer) {
+		IOManager io(out_cfg);
+		timer.start();
+		io.write2DGrid(dem, "bench_dem");
+	});
+
+	Config cfg( out_cfg );
+	cfg.addKey("DEM", "Input", "ARC");
+	cfg.addKey("DEMFILE", "Input", work_dir+"/bench_dem.asc");
+	bench.run("grid_read_ARC", "cells", nr_cells, [&](Timer& timer) {
+		IOManager io(cfg);
+		DEMObject read_dem;
+		read_dem.setUpdatePpt(DEMObject::NO_UPDATE);
+		timer.start();
+		io.readDEM(read_dem);
+	});
+
+	Config png_cfg( out_cfg );
+	png_cfg.addKey("GRID2D", "Output", "PNG");
+	bench.run("grid_write_PNG", "cells", nr_cells, [&](Timer& timer) {
+		IOManager io(png_cfg);
+		timer.start();
+		io.write2DGrid(dem, "bench_dem");
+	});
+}
+
+int main(int argc, char** argv) {
+	std::string size_name("small"), only, save_file, baseline_file;
+	size_t repeat = 3;
+	double tolerance = 0.2;
+	for (int ii=1; ii<argc; ii++) {
+		const std::string arg( argv[ii] );
+		const size_t pos = arg.find('=');
+		const std::string key( arg.substr(0, pos) ), value( (pos!=std::string::npos)? arg.substr(pos+1) : "" );
+		if (key=="--size") size_name = value;
+		else if (key=="--repeat") IOUtils::convertString(repeat, value);
+		else if (key=="--only") only = value;
+		else if (key=="--save") save_file = value;
+		else if (key=="--baseline") baseline_file = value;
+		else if (key=="--tolerance") IOUtils::convertString(tolerance, value);
+		else {
+			std::cerr << "Usage: " << argv[0] << " [--size=tiny|small|medium|large] [--repeat=n] [--only=pattern] [--save=file] [--baseline=file] [--tolerance=0.2]\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	const BenchSize* sz = NULL;
+	for (size_t ii=0; ii<sizeof(bench_sizes)/sizeof(bench_sizes[0]); ii++)
+		if (size_name==bench_sizes[ii].name) sz = &bench_sizes[ii];
+	if (sz==NULL) throw InvalidArgumentException("Unknown benchmark size '"+size_name+"'", AT);
+	if (repeat==0) repeat = 1;
+
+	const WorkDirectory work_directory; //removed at exit, even if a benchmark fails
+	try {
+		std::cout << "Generating '" << sz->name << "' inputs: DEM " << sz->dem_nx << "x" << sz->dem_ny << ", " << sz->nr_stations << " stations, ";
+		std::cout << sz->nr_days << " days of hourly data, " << sz->csv_records << " CSV records\n\n";
+		const Date start(2020, 1, 1, 0, 0, TZ);
+		const DEMObject dem( makeDEM(*sz) );
+		const std::vector<StationData> vecStations( makeStations(dem, sz->nr_stations) );
+		const std::vector< std::vector<MeteoData> > vecvecMeteo( makeTimeSeries(vecStations, start, sz->nr_days) );
+		const Config out_cfg( makeOutputConfig() );
+		{ //the inputs for the benchmarks that read data
+			IOManager io(out_cfg);
+			io.writeMeteoData(vecvecMeteo);
+			io.write2DGrid(dem, "bench_dem");
+		}
+		const Config in_cfg( makeInputConfig(vecStations) );
+
+		Benchmarks bench(repeat, only);
+		benchReadWrite(bench, out_cfg, in_cfg, vecvecMeteo, start, *sz);
+		benchFilters(bench, vecvecMeteo);
+		benchResampling(bench, vecvecMeteo);
+		benchSpatialInterpolations(bench, in_cfg, dem, start);
+		benchGrids(bench, out_cfg, dem);
+
+		if (!save_file.empty()) bench.save(save_file);
+		if (!baseline_file.empty() && bench.compare(baseline_file, tolerance)>0) return EXIT_FAILURE;
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
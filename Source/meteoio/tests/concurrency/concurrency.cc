@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <meteoio/MeteoIO.h>
+
+using namespace mio; //The MeteoIO namespace is called mio
+using namespace std;
+
+//Several threads share one IOManager and compare what they get with a sequential run.
+//The buffers are primed with the first date, so they don't depend on the order of the requests.
+const size_t nr_threads = 8;
+const Date start_date(2008, 12, 5, 0, 0, 1.);
+const size_t nr_dates = 200; //every 6 hours
+const MeteoData::Parameters interpol_params[] = {MeteoData::TA, MeteoData::RH, MeteoData::TSS};
+const size_t nr_interpol_params = sizeof(interpol_params) / sizeof(interpol_params[0]);
+
+atomic<size_t> nr_errors( 0 );
+
+Date getDate(const size_t& idx)
+{
+	return start_date + static_cast<double>(idx) * 0.25;
+}
+
+void error(const std::string& msg)
+{
+	static std::mutex cerr_mutex;
+	const std::lock_guard<std::mutex> lock(cerr_mutex);
+	cerr << msg << endl;
+	nr_errors++;
+}
+
+bool sameMeteo(const METEO_SET& vec1, const METEO_SET& vec2)
+{
+	if (vec1.size()!=vec2.size()) return false;
+	for (size_t ii=0; ii<vec1.size(); ii++)
+		if (vec1[ii]!=vec2[ii]) return false;
+	return true;
+}
+
+bool sameSeries(const std::vector<METEO_SET>& vec1, const std::vector<METEO_SET>& vec2)
+{
+	if (vec1.size()!=vec2.size()) return false;
+	for (size_t ii=0; ii<vec1.size(); ii++)
+		if (!sameMeteo(vec1[ii], vec2[ii])) return false;
+	return true;
+}
+
+struct Reference {
+	Reference() : points(nr_dates), series(), grids(nr_dates), dem() {}
+	std::vector<METEO_SET> points; ///< the stations at each date
+	std::vector< std::vector<METEO_SET> > series; ///< the time series over each 10 days period
+	std::vector< std::vector<Grid2DObject> > grids; ///< the interpolated grids
+	DEMObject dem;
+};
+
+std::string getGridName(const size_t& thread_id)
+{
+	return "concurrency_" + IOUtils::toString(thread_id); //the ARC plugin adds the extension when writing
+}
+
+void worker(IOManager& io, const Reference& ref, const size_t& thread_id)
+{
+	try {
+		//each thread walks through the dates in a different order
+		for (size_t kk=0; kk<nr_dates; kk++) {
+			const size_t idx = (kk*7 + thread_id*(nr_dates/nr_threads)) % nr_dates;
+			const Date date( getDate(idx) );
+
+			METEO_SET vecMeteo;
+			io.getMeteoData(date, vecMeteo);
+			if (!sameMeteo(vecMeteo, ref.points[idx])) error("Thread " + IOUtils::toString(thread_id) + ": wrong stations data on " + date.toString(Date::ISO));
+
+			if (kk%20==0) {
+				const size_t period = idx / 40;
+				std::vector<METEO_SET> vecSeries;
+				io.getMeteoData(getDate(period*40), getDate(period*40+39), vecSeries);
+				if (!sameSeries(vecSeries, ref.series[period])) error("Thread " + IOUtils::toString(thread_id) + ": wrong time series from " + getDate(period*40).toString(Date::ISO));
+			}
+
+			if (kk%25==thread_id%25) { //spatial interpolations, writing the result and reading it back
+				DEMObject dem;
+				io.readDEM(dem);
+				if (!(dem.grid2D==ref.dem.grid2D)) error("Thread " + IOUtils::toString(thread_id) + ": wrong DEM");
+
+				const size_t ii = kk % nr_interpol_params;
+				Grid2DObject grid;
+				std::string info;
+				io.getMeteoData(date, dem, interpol_params[ii], grid, info);
+				if (!grid.grid2D.checkEpsilonEquality(ref.grids[idx][ii].grid2D, 1e-9))
+					error("Thread " + IOUtils::toString(thread_id) + ": wrong " + MeteoData::getParameterName(interpol_params[ii]) + " grid on " + date.toString(Date::ISO));
+
+				io.write2DGrid(grid, getGridName(thread_id));
+				Grid2DObject grid_back;
+				io.read2DGrid(grid_back, getGridName(thread_id)+".asc");
+				//the grids buffer might return the previous grid of this thread, so only check the geolocalization
+				if (!grid_back.isSameGeolocalization(ref.dem)) error("Thread " + IOUtils::toString(thread_id) + ": wrong grid read back");
+			}
+		}
+	} catch (const std::exception& e) {
+		error("Thread " + IOUtils::toString(thread_id) + ": " + e.what());
+	}
+}
+
+//only the number of stations is checked here: the buffers are cleared while the other threads are reading
+void rebufferWorker(IOManager& io, const Reference& ref, const size_t& thread_id)
+{
+	try {
+		for (size_t kk=0; kk<nr_dates; kk+=5) {
+			const size_t idx = (kk*13 + thread_id*17) % nr_dates;
+			if (thread_id==0 && kk%20==0) io.clear_cache();
+
+			METEO_SET vecMeteo;
+			io.getMeteoData(getDate(idx), vecMeteo);
+			if (vecMeteo.size()!=ref.points[idx].size()) error("Rebuffering thread " + IOUtils::toString(thread_id) + ": got " + IOUtils::toString(vecMeteo.size()) + " stations");
+		}
+	} catch (const std::exception& e) {
+		error("Rebuffering thread " + IOUtils::toString(thread_id) + ": " + e.what());
+	}
+}
+
+int main() {
+	Config cfg("io.ini");
+
+	//sequential reference
+	Reference ref;
+	{
+		IOManager io(cfg);
+		io.readDEM(ref.dem);
+		for (size_t idx=0; idx<nr_dates; idx++) {
+			io.getMeteoData(getDate(idx), ref.points[idx]);
+			ref.grids[idx].resize(nr_interpol_params);
+			for (size_t ii=0; ii<nr_interpol_params; ii++) {
+				std::string info;
+				io.getMeteoData(getDate(idx), ref.dem, interpol_params[ii], ref.grids[idx][ii], info);
+			}
+		}
+		for (size_t period=0; period<nr_dates/40; period++) {
+			std::vector<METEO_SET> vecSeries;
+			io.getMeteoData(getDate(period*40), getDate(period*40+39), vecSeries);
+			ref.series.push_back( vecSeries );
+		}
+	}
+
+	//concurrent accesses
+	IOManager io(cfg);
+	METEO_SET vecMeteo;
+	io.getMeteoData(start_date, vecMeteo);
+	std::vector<std::thread> threads;
+	for (size_t tt=0; tt<nr_threads; tt++)
+		threads.push_back( std::thread(worker, std::ref(io), std::cref(ref), tt) );
+	for (size_t tt=0; tt<nr_threads; tt++) threads[tt].join();
+	for (size_t tt=0; tt<nr_threads; tt++) std::remove( (getGridName(tt)+".asc").c_str() );
+
+	threads.clear();
+	for (size_t tt=0; tt<nr_threads; tt++)
+		threads.push_back( std::thread(rebufferWorker, std::ref(io), std::cref(ref), tt) );
+	for (size_t tt=0; tt<nr_threads; tt++) threads[tt].join();
+
+	if (nr_errors>0) {
+		cerr << nr_errors << " error(s) in the concurrent accesses\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
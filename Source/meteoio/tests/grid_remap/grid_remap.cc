@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <sys/stat.h>
+#include <meteoio/MeteoIO.h>
+
+using namespace mio; //The MeteoIO namespace is called mio
+using namespace std;
+
+//Remap analytic fields with the three GridRemapper methods and check the results against the analytic values.
+//All the grids are in the same projection, the source grid has 100m cells and its cell (0,0) is centered on llcorner.
+const std::string cache_dir( "grid_remap_cache" );
+const double ref_x = 600000., ref_y = 150000.;
+const size_t src_nx = 42, src_ny = 30;
+const double src_cellsize = 100.;
+const double epsilon = 1e-9;
+
+size_t nr_errors = 0;
+
+void error(const std::string& msg)
+{
+	cerr << msg << endl;
+	nr_errors++;
+}
+
+double linearField(const double& x, const double& y)
+{
+	return 12. + 0.004*(x-ref_x) - 0.0025*(y-ref_y);
+}
+
+double smoothField(const double& x, const double& y)
+{
+	return 5. + sin((x-ref_x)/700.) * cos((y-ref_y)/500.);
+}
+
+Grid2DObject getGrid(const size_t& nx, const size_t& ny, const double& cellsize, const double& x_offset, const double& y_offset)
+{
+	Coords llcorner("CH1903", "");
+	llcorner.setXY(ref_x+x_offset, ref_y+y_offset, IOUtils::nodata);
+	return Grid2DObject(nx, ny, cellsize, llcorner, 0.);
+}
+
+//fill a grid with a function evaluated at its cells' centers
+void fillGrid(Grid2DObject& grid, double (*func)(const double&, const double&))
+{
+	for (size_t jj=0; jj<grid.getNy(); jj++) {
+		for (size_t ii=0; ii<grid.getNx(); ii++) {
+			const double x = grid.llcorner.getEasting() + static_cast<double>(ii)*grid.cellsize;
+			const double y = grid.llcorner.getNorthing() + static_cast<double>(jj)*grid.cellsize;
+			grid.grid2D(ii, jj) = func(x, y);
+		}
+	}
+}
+
+//position of a target cell's center in the source grid's indices
+void getSourcePosition(const Grid2DObject& target, const size_t& ii, const size_t& jj, double& fx, double& fy)
+{
+	fx = (target.llcorner.getEasting() - ref_x + static_cast<double>(ii)*target.cellsize) / src_cellsize;
+	fy = (target.llcorner.getNorthing() - ref_y + static_cast<double>(jj)*target.cellsize) / src_cellsize;
+}
+
+void checkNearest(const Grid2DObject& source, const Grid2DObject& target)
+{
+	GridRemapper remapper(GridRemapper::NEAREST);
+	Grid2DObject result;
+	remapper.remap(source, target, result);
+	for (size_t jj=0; jj<target.getNy(); jj++) {
+		for (size_t ii=0; ii<target.getNx(); ii++) {
+			double fx, fy;
+			getSourcePosition(target, ii, jj, fx, fy);
+			const size_t kk = static_cast<size_t>(floor(fx+0.5)), ll = static_cast<size_t>(floor(fy+0.5));
+			if (result.grid2D(ii, jj)!=source.grid2D(kk, ll)) {
+				error("NEAREST: wrong value at (" + IOUtils::toString(ii) + "," + IOUtils::toString(jj) + ")");
+				return;
+			}
+		}
+	}
+}
+
+//a linear field is reproduced exactly by the bilinear interpolation, between the centers of the source cells
+void checkBilinear(const Grid2DObject& source, const Grid2DObject& target)
+{
+	GridRemapper remapper(GridRemapper::BILINEAR);
+	Grid2DObject result;
+	remapper.remap(source, target, result);
+	for (size_t jj=0; jj<target.getNy(); jj++) {
+		for (size_t ii=0; ii<target.getNx(); ii++) {
+			double fx, fy;
+			getSourcePosition(target, ii, jj, fx, fy);
+			if (fx>static_cast<double>(src_nx-1) || fy>static_cast<double>(src_ny-1)) continue;
+			const double x = target.llcorner.getEasting() + static_cast<double>(ii)*target.cellsize;
+			const double y = target.llcorner.getNorthing() + static_cast<double>(jj)*target.cellsize;
+			if (fabs(result.grid2D(ii, jj) - linearField(x, y)) > epsilon) {
+				error("BILINEAR: wrong value at (" + IOUtils::toString(ii) + "," + IOUtils::toString(jj) + ")");
+				return;
+			}
+		}
+	}
+}
+
+//the target cells cover exactly 3x3 source cells: the average of a linear field is its value at the center of the
+//target cell and the total mass of any field is preserved
+void checkConservative(const Grid2DObject& target)
+{
+	Grid2DObject source( getGrid(src_nx, src_ny, src_cellsize, 0., 0.) );
+	GridRemapper remapper(GridRemapper::CONSERVATIVE);
+	Grid2DObject result;
+
+	fillGrid(source, linearField);
+	remapper.remap(source, target, result);
+	Grid2DObject expected( target );
+	fillGrid(expected, linearField);
+	if (!result.grid2D.checkEpsilonEquality(expected.grid2D, epsilon)) error("CONSERVATIVE: wrong values for a linear field");
+
+	fillGrid(source, smoothField);
+	remapper.remap(source, target, result);
+	double src_mass = 0., mass = 0.;
+	for (size_t nn=0; nn<source.size(); nn++) src_mass += source.grid2D(nn) * src_cellsize*src_cellsize;
+	for (size_t nn=0; nn<result.size(); nn++) mass += result.grid2D(nn) * target.cellsize*target.cellsize;
+	if (fabs(mass - src_mass) > 1e-12*src_mass) error("CONSERVATIVE: the mass is not preserved (" + IOUtils::toString(mass) + " vs " + IOUtils::toString(src_mass) + ")");
+	if (remapper.getNrBuilt()!=1) error("CONSERVATIVE: the operator should be reused for all the grids of the same geometry");
+}
+
+//a constant field with holes: the weights of the valid cells are renormalized, so the field remains constant and
+//a target cell is only nodata when all of its source cells are nodata
+void checkNodata(const Grid2DObject& fine_target, const Grid2DObject& coarse_target)
+{
+	Grid2DObject source( getGrid(src_nx, src_ny, src_cellsize, 0., 0.), 7. );
+	source.grid2D(10, 10) = IOUtils::nodata;
+	for (size_t ll=20; ll<=21; ll++)
+		for (size_t kk=20; kk<=21; kk++) source.grid2D(kk, ll) = IOUtils::nodata;
+
+	const GridRemapper::RemapMethod methods[] = {GridRemapper::NEAREST, GridRemapper::BILINEAR, GridRemapper::CONSERVATIVE};
+	for (size_t mm=0; mm<sizeof(methods)/sizeof(methods[0]); mm++) {
+		const std::string name( GridRemapper::getMethodName(methods[mm]) );
+		const Grid2DObject& target = (methods[mm]==GridRemapper::CONSERVATIVE)? coarse_target : fine_target;
+		GridRemapper remapper(methods[mm]);
+		Grid2DObject result;
+		remapper.remap(source, target, result);
+
+		size_t nr_nodata = 0;
+		for (size_t jj=0; jj<target.getNy(); jj++) {
+			for (size_t ii=0; ii<target.getNx(); ii++) {
+				const double value = result.grid2D(ii, jj);
+				double fx, fy;
+				getSourcePosition(target, ii, jj, fx, fy);
+				const bool in_hole = (methods[mm]==GridRemapper::NEAREST)? (fx>=19.5 && fx<21.5 && fy>=19.5 && fy<21.5) : (fx>=20. && fx<=21. && fy>=20. && fy<=21.);
+				if (methods[mm]!=GridRemapper::CONSERVATIVE && in_hole) {
+					if (value!=IOUtils::nodata) error(name + ": expected nodata at (" + IOUtils::toString(ii) + "," + IOUtils::toString(jj) + ")");
+					nr_nodata++;
+				} else if (value==IOUtils::nodata && methods[mm]==GridRemapper::NEAREST && floor(fx+0.5)==10. && floor(fy+0.5)==10.) {
+					nr_nodata++;
+				} else if (fabs(value - 7.) > epsilon) {
+					error(name + ": wrong value " + IOUtils::toString(value) + " at (" + IOUtils::toString(ii) + "," + IOUtils::toString(jj) + ")");
+					return;
+				}
+			}
+		}
+		if (methods[mm]!=GridRemapper::CONSERVATIVE && nr_nodata==0) error(name + ": the nodata cells have not been checked");
+	}
+}
+
+//an operator written to the cache and read back by another GridRemapper must give exactly the same results
+void checkCache(const Grid2DObject& fine_target, const Grid2DObject& coarse_target)
+{
+	Grid2DObject smooth( getGrid(src_nx, src_ny, src_cellsize, 0., 0.) ), holes( smooth );
+	fillGrid(smooth, smoothField);
+	fillGrid(holes, linearField);
+	for (size_t nn=0; nn<holes.size(); nn+=7) holes.grid2D(nn) = IOUtils::nodata;
+
+	const GridRemapper::RemapMethod methods[] = {GridRemapper::NEAREST, GridRemapper::BILINEAR, GridRemapper::CONSERVATIVE};
+	for (size_t mm=0; mm<sizeof(methods)/sizeof(methods[0]); mm++) {
+		const std::string name( GridRemapper::getMethodName(methods[mm]) );
+		const Grid2DObject& target = (methods[mm]==GridRemapper::CONSERVATIVE)? coarse_target : fine_target;
+
+		GridRemapper writer(methods[mm], cache_dir), reader(methods[mm], cache_dir);
+		Grid2DObject result1, result2, holes1, holes2;
+		writer.remap(smooth, target, result1);
+		writer.remap(holes, target, holes1);
+		reader.remap(smooth, target, result2);
+		reader.remap(holes, target, holes2);
+
+		if (writer.getNrBuilt()!=1) error(name + ": the operator should have been built once");
+		if (reader.getNrBuilt()!=0) error(name + ": the operator should have been read from the cache");
+		if (!(result1.grid2D==result2.grid2D) || !(holes1.grid2D==holes2.grid2D)) error(name + ": the cached operator gives different results");
+	}
+}
+
+int main() {
+	mkdir(cache_dir.c_str(), 0755);
+	const std::list<std::string> old_cache( FileUtils::readDirectory(cache_dir) );
+	for (std::list<std::string>::const_iterator it = old_cache.begin(); it != old_cache.end(); ++it) std::remove( (cache_dir+"/"+*it).c_str() );
+
+	//25m cells, slightly shifted so no target cell center lies half way between source cells
+	const Grid2DObject fine_target( getGrid(150, 110, 25., 10., 10.) );
+	//300m cells, each covering exactly 3x3 source cells
+	const Grid2DObject coarse_target( getGrid(src_nx/3, src_ny/3, 3.*src_cellsize, src_cellsize, src_cellsize) );
+
+	Grid2DObject source( getGrid(src_nx, src_ny, src_cellsize, 0., 0.) );
+	fillGrid(source, linearField);
+	checkNearest(source, fine_target);
+	checkBilinear(source, fine_target);
+	checkConservative(coarse_target);
+	checkNodata(fine_target, coarse_target);
+	checkCache(fine_target, coarse_target);
+
+	if (nr_errors>0) {
+		cerr << nr_errors << " error(s) in the grid remapping\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
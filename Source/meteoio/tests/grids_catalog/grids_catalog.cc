@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <meteoio/MeteoIO.h>
+
+using namespace mio; //The MeteoIO namespace is called mio
+using namespace std;
+
+//The grids found through a FileUtils::GridsCatalog must match the content of the archive: when the catalogue is built,
+//when it is updated without changes (nothing is parsed again), when it is read back from its index by another instance,
+//when a file has been replaced (only this stale entry is parsed again), when the parsing options change and in recursive mode.
+const std::string work_dir( "grids_catalog_work" );
+const std::string archive_dir( work_dir + "/archive" );
+const std::string index_dir( work_dir + "/index" );
+const double TZ = 1.;
+
+size_t nr_errors = 0;
+
+void error(const std::string& msg)
+{
+	cerr << msg << endl;
+	nr_errors++;
+}
+
+//the archive files are lists of "{ISO date} {MeteoGrids parameter}", one grid per line
+class TestFilesParser : public FileUtils::GridsCatalog::FileParser {
+	public:
+		TestFilesParser(const std::string& i_signature="TEST") : signature(i_signature) {}
+
+		void parse(const std::string& path, const std::string& filename, std::vector<FileUtils::GridsCatalog::catalog_entry>& entries) const
+		{
+			std::ifstream fin( (path + "/" + filename).c_str() );
+			std::string date_str, param_str;
+			size_t offset = 0;
+			while (fin >> date_str >> param_str) {
+				Date date;
+				if (!IOUtils::convertString(date, date_str, TZ)) continue;
+				entries.push_back( FileUtils::GridsCatalog::catalog_entry(date, MeteoGrids::getParameterIndex(param_str), filename, offset++) );
+			}
+		}
+
+		std::string getSignature() const {return signature;}
+
+	private:
+		const std::string signature;
+};
+
+void writeFile(const std::string& filename, const std::string& content)
+{
+	std::ofstream fout(filename.c_str(), ios::out | ios::trunc);
+	fout << content;
+}
+
+//the catalogue does not trust the directories modified within the current second, so make sure the archive is old enough
+void waitForArchive()
+{
+	std::this_thread::sleep_for( std::chrono::milliseconds(2100) );
+}
+
+//remove a directory with all its content, including the hidden index files
+void removeDirectory(const std::string& path)
+{
+	DIR *dp = opendir(path.c_str());
+	if (dp==nullptr) return;
+	struct dirent *dirp;
+	while ((dirp = readdir(dp)) != nullptr) {
+		const std::string filename( dirp->d_name );
+		if (filename=="." || filename=="..") continue;
+		const std::string full_path( path + "/" + filename );
+		if (FileUtils::directoryExists(full_path)) removeDirectory(full_path);
+		else std::remove( full_path.c_str() );
+	}
+	closedir(dp);
+	std::remove( path.c_str() );
+}
+
+//print the grids found within a time range as "{date} {param},{param};" so they can be compared with the expected ones
+std::string listGrids(const FileUtils::GridsCatalog& catalog, const Date& start, const Date& end)
+{
+	std::map<Date, std::set<size_t> > grids;
+	catalog.getGrids(start, end, grids);
+	std::ostringstream os;
+	for (std::map<Date, std::set<size_t> >::const_iterator it = grids.begin(); it != grids.end(); ++it) {
+		os << it->first.toString(Date::ISO);
+		for (std::set<size_t>::const_iterator param = it->second.begin(); param != it->second.end(); ++param)
+			os << ((param==it->second.begin())? " " : ",") << MeteoGrids::getParameterName(*param);
+		os << ";";
+	}
+	return os.str();
+}
+
+void checkGrids(const std::string& step, const FileUtils::GridsCatalog& catalog, const Date& start, const Date& end, const std::string& expected)
+{
+	const std::string grids( listGrids(catalog, start, end) );
+	if (grids!=expected) error(step + ": expected '" + expected + "' and got '" + grids + "'");
+}
+
+void checkParsed(const std::string& step, const FileUtils::GridsCatalog& catalog, const size_t& expected)
+{
+	if (catalog.getNrParsed()!=expected) {
+		std::ostringstream os;
+		os << step << ": expected " << expected << " file(s) parsed so far and got " << catalog.getNrParsed();
+		error(os.str());
+	}
+}
+
+int main() {
+	removeDirectory(work_dir);
+	mkdir(work_dir.c_str(), 0755);
+	mkdir(archive_dir.c_str(), 0755);
+	mkdir(index_dir.c_str(), 0755);
+
+	const Date day1(2020, 1, 1, 0, 0, TZ), day2(2020, 1, 2, 0, 0, TZ), day3(2020, 1, 3, 0, 0, TZ), day4(2020, 1, 4, 0, 0, TZ);
+	writeFile(archive_dir+"/a.txt", "2020-01-01T00:00 TA\n2020-01-01T00:00 RH\n2020-01-02T00:00 TA\n");
+	writeFile(archive_dir+"/b.txt", "2020-01-03T00:00 TA\n");
+	writeFile(archive_dir+"/ignored.dat", "2020-01-01T00:00 VW\n"); //not matching the pattern
+	waitForArchive();
+
+	//building the catalogue, then the date ranges are given by a binary search in the catalogue
+	FileUtils::GridsCatalog catalog(archive_dir, ".txt", index_dir);
+	catalog.update( TestFilesParser() );
+	checkParsed("Building the catalogue", catalog, 2);
+	checkGrids("Whole archive", catalog, day1, day4, "2020-01-01T00:00:00 TA,RH;2020-01-02T00:00:00 TA;2020-01-03T00:00:00 TA;");
+	checkGrids("First two days", catalog, day1, day2, "2020-01-01T00:00:00 TA,RH;2020-01-02T00:00:00 TA;");
+	checkGrids("Single date", catalog, day3, day3, "2020-01-03T00:00:00 TA;");
+	checkGrids("Between the grids", catalog, day1+0.5, day2-0.1, "");
+	checkGrids("After the archive", catalog, day4, day4+10., "");
+
+	std::vector<FileUtils::GridsCatalog::catalog_entry> entries;
+	catalog.getEntries(day2, day3, entries);
+	if (entries.size()!=2 || entries[0].file!="a.txt" || entries[0].offset!=2 || entries[1].file!="b.txt" || entries[1].offset!=0)
+		error("The entries of the second and third days do not point to the right files and offsets");
+
+	//cache hit: nothing has changed, so nothing is parsed again
+	catalog.update( TestFilesParser() );
+	checkParsed("Updating an unchanged archive", catalog, 2);
+
+	//another instance finds everything in the index
+	FileUtils::GridsCatalog indexed(archive_dir, ".txt", index_dir);
+	indexed.update( TestFilesParser() );
+	checkParsed("Reading the index", indexed, 0);
+	checkGrids("Reading the index", indexed, day1, day4, listGrids(catalog, day1, day4));
+
+	//stale entry: b.txt is replaced by a file of the same size, so only this file is parsed again
+	writeFile(archive_dir+"/b.tmp", "2020-01-04T00:00 TA\n");
+	std::rename( (archive_dir+"/b.tmp").c_str(), (archive_dir+"/b.txt").c_str() );
+	waitForArchive();
+	indexed.update( TestFilesParser() );
+	checkParsed("Replaced file", indexed, 1);
+	checkGrids("Replaced file", indexed, day1, day4, "2020-01-01T00:00:00 TA,RH;2020-01-02T00:00:00 TA;2020-01-04T00:00:00 TA;");
+
+	//removed file
+	std::remove( (archive_dir+"/a.txt").c_str() );
+	waitForArchive();
+	indexed.update( TestFilesParser() );
+	checkParsed("Removed file", indexed, 1);
+	checkGrids("Removed file", indexed, day1, day4, "2020-01-04T00:00:00 TA;");
+
+	//the index has been updated along the way, so a new instance does not need to parse anything either
+	FileUtils::GridsCatalog reindexed(archive_dir, ".txt", index_dir);
+	reindexed.update( TestFilesParser() );
+	checkParsed("Reading the updated index", reindexed, 0);
+	checkGrids("Reading the updated index", reindexed, day1, day4, "2020-01-04T00:00:00 TA;");
+
+	//other parsing options: the index can not be used
+	FileUtils::GridsCatalog other(archive_dir, ".txt", index_dir);
+	other.update( TestFilesParser("OTHER") );
+	checkParsed("Other parser signature", other, 1);
+
+	//recursive archive: a file replaced in a sub-directory does not change the archive's modification time but is still found
+	const std::string sub_dir( archive_dir + "/sub" );
+	mkdir(sub_dir.c_str(), 0755);
+	writeFile(sub_dir+"/c.txt", "2020-01-02T00:00 VW\n");
+	waitForArchive();
+	FileUtils::GridsCatalog recursive(archive_dir, ".txt", "", true);
+	recursive.update( TestFilesParser() );
+	checkParsed("Recursive archive", recursive, 2);
+	checkGrids("Recursive archive", recursive, day1, day4, "2020-01-02T00:00:00 VW;2020-01-04T00:00:00 TA;");
+	recursive.getEntries(day2, day2, entries);
+	if (entries.size()!=1 || entries[0].file!="sub/c.txt") error("The files of the sub-directories must be given relative to the archive");
+
+	writeFile(sub_dir+"/c.tmp", "2020-01-03T00:00 VW\n");
+	std::rename( (sub_dir+"/c.tmp").c_str(), (sub_dir+"/c.txt").c_str() );
+	waitForArchive();
+	recursive.update( TestFilesParser() );
+	checkParsed("Replaced file in a sub-directory", recursive, 3);
+	checkGrids("Replaced file in a sub-directory", recursive, day1, day4, "2020-01-03T00:00:00 VW;2020-01-04T00:00:00 TA;");
+
+	removeDirectory(work_dir);
+	if (nr_errors>0) {
+		cerr << nr_errors << " error(s) with the grids catalogue\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+#include <meteoio/MeteoIO.h>
+
+using namespace mio; //The MeteoIO namespace is called mio
+using namespace std;
+
+//The filtered time series read through the persistent cache (METEO_CACHE) must be the same as without cache:
+//when the cache is built, when it is read back, when the input has been extended (only the tail is computed again)
+//and when the input has been rewritten with the same size (the cache must then be rebuilt).
+const std::string input_dir( "series_cache_input" );
+const std::string cache_dir( "series_cache_cache" );
+const std::string input_file( input_dir + "/CACHE1.smet" );
+const Date start_date(2020, 1, 1, 0, 0, 1.);
+const size_t nr_days = 10, nr_days_ext = 15;
+
+size_t nr_errors = 0;
+
+void error(const std::string& msg)
+{
+	cerr << msg << endl;
+	nr_errors++;
+}
+
+//hourly data, with a few out of range TA values for the filters. The values are written with a fixed width,
+//so writing another version of the data (shift) gives a file of the same size
+void writeInput(const size_t& days, const double& shift)
+{
+	ofstream fout(input_file.c_str(), ios::out | ios::trunc);
+	fout << "SMET 1.1 ASCII\n[HEADER]\nstation_id = CACHE1\nstation_name = series_cache\n";
+	fout << "latitude = 46.8\nlongitude = 9.81\naltitude = 1560\nnodata = -999\ntz = 1\n";
+	fout << "fields = timestamp TA RH VW\n[DATA]\n";
+	for (size_t hh=0; hh<days*24; hh++) {
+		const double t = static_cast<double>(hh);
+		const double ta = (hh%37==5)? 350. : 265. + shift + 5.*sin(2.*Cst::PI*t/24.);
+		const double rh = 0.7 + 0.2*sin(2.*Cst::PI*t/31.);
+		const double vw = 5. + 4.*sin(2.*Cst::PI*t/17.) + ((hh%11==0)? 3. : 0.);
+		char line[128];
+		snprintf(line, sizeof(line), "%s %7.3f %5.3f %6.3f\n", (start_date+t/24.).toString(Date::ISO).c_str(), ta, rh, vw);
+		fout << line;
+	}
+}
+
+long long getFileSize(const std::string& filename)
+{
+	struct stat buffer;
+	if (stat(filename.c_str(), &buffer)!=0) return -1;
+	return static_cast<long long>(buffer.st_size);
+}
+
+//the cache does not trust the files modified within the current second, so make sure the inputs are old enough
+void waitForInputs()
+{
+	std::this_thread::sleep_for( std::chrono::milliseconds(2100) );
+}
+
+Config getConfig(const bool& with_cache)
+{
+	Config cfg;
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("METEO", "Input", "SMET");
+	cfg.addKey("METEOPATH", "Input", input_dir);
+	cfg.addKey("STATION1", "Input", "CACHE1");
+	if (with_cache) cfg.addKey("METEO_CACHE", "General", cache_dir);
+
+	cfg.addKey("TA::filter1", "Filters", "min_max");
+	cfg.addKey("TA::arg1::min", "Filters", "240");
+	cfg.addKey("TA::arg1::max", "Filters", "320");
+	//a windowed filter, so the data around the splice point depends on its neighbours
+	cfg.addKey("VW::filter1", "Filters", "AGGREGATE");
+	cfg.addKey("VW::arg1::type", "Filters", "mean");
+	cfg.addKey("VW::arg1::soft", "Filters", "true");
+	cfg.addKey("VW::arg1::centering", "Filters", "center");
+	cfg.addKey("VW::arg1::min_pts", "Filters", "3");
+	cfg.addKey("VW::arg1::min_span", "Filters", "21600");
+	return cfg;
+}
+
+//read the whole time series and return the cache statistics line
+std::string readSeries(const bool& with_cache, const size_t& days, std::vector<METEO_SET>& vecMeteo)
+{
+	IOManager io( getConfig(with_cache) );
+	io.getMeteoData(start_date, start_date+static_cast<double>(days)-1./24., vecMeteo);
+	const std::string stats( io.toString() );
+	const size_t pos = stats.find(".bin: ");
+	if (pos==std::string::npos) return "";
+	return stats.substr(pos+6, stats.find('\n', pos)-pos-6);
+}
+
+void check(const std::string& step, const std::vector<METEO_SET>& ref, const std::vector<METEO_SET>& vecMeteo, const std::string& stats, const std::string& expected_stats)
+{
+	if (ref.size()!=1 || ref[0].empty()) {
+		error(step + ": no reference data");
+		return;
+	}
+	if (vecMeteo.size()!=ref.size() || vecMeteo[0].size()!=ref[0].size()) {
+		error(step + ": wrong number of data points");
+		return;
+	}
+	for (size_t jj=0; jj<ref[0].size(); jj++) {
+		if (vecMeteo[0][jj]!=ref[0][jj]) {
+			error(step + ": wrong data on " + ref[0][jj].date.toString(Date::ISO));
+			break;
+		}
+	}
+	if (stats!=expected_stats) error(step + ": expected '" + expected_stats + "' and got '" + stats + "'");
+}
+
+int main() {
+	mkdir(input_dir.c_str(), 0755);
+	mkdir(cache_dir.c_str(), 0755);
+	std::remove(input_file.c_str());
+	const std::list<std::string> old_cache( FileUtils::readDirectory(cache_dir) );
+	for (std::list<std::string>::const_iterator it = old_cache.begin(); it != old_cache.end(); ++it) std::remove( (cache_dir+"/"+*it).c_str() );
+
+	writeInput(nr_days, 0.);
+	waitForInputs();
+
+	std::vector<METEO_SET> ref, vecMeteo;
+	readSeries(false, nr_days, ref);
+	check("Building the cache", ref, vecMeteo, readSeries(true, nr_days, vecMeteo), "0 hits, 0 extended, 1 misses");
+	check("Reading the cache", ref, vecMeteo, readSeries(true, nr_days, vecMeteo), "1 hits, 0 extended, 0 misses");
+
+	//data appended to the input: the cached data is reused and only the tail is computed again
+	writeInput(nr_days_ext, 0.);
+	waitForInputs();
+	readSeries(false, nr_days_ext, ref);
+	check("Extending the cache", ref, vecMeteo, readSeries(true, nr_days_ext, vecMeteo), "0 hits, 1 extended, 0 misses");
+	check("Reading the extended cache", ref, vecMeteo, readSeries(true, nr_days_ext, vecMeteo), "1 hits, 0 extended, 0 misses");
+
+	//the input rewritten with other values but the same size: the cache must be rebuilt
+	const long long size = getFileSize(input_file);
+	writeInput(nr_days_ext, 1.);
+	if (getFileSize(input_file)!=size) error("The rewritten input does not have the same size");
+	waitForInputs();
+	const std::vector<METEO_SET> previous( ref );
+	readSeries(false, nr_days_ext, ref);
+	if (!ref.empty() && !previous.empty() && ref[0].size()==previous[0].size() && !ref[0].empty() && ref[0][1]==previous[0][1])
+		error("The rewritten input should give other values");
+	check("Rewritten input", ref, vecMeteo, readSeries(true, nr_days_ext, vecMeteo), "0 hits, 0 extended, 1 misses");
+
+	if (nr_errors>0) {
+		cerr << nr_errors << " error(s) with the meteo data cache\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
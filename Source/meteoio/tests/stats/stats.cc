@@ -3,6 +3,7 @@
 #include <time.h>
 #include <algorithm>
 #include <meteoio/MeteoIO.h>
+#include <meteoio/thirdParty/tinyexpr.h>
 
 using namespace std;
 using namespace mio;
@@ -318,6 +319,26 @@ bool check_regressions(const vector<double>& x, const vector<double>& y) {
 		}
 	}
 
+	//fit the parameters back from the data, then again starting from the fitted parameters
+	for (size_t pass=0; pass<2; pass++) {
+		if (pass==0) {
+			fit.setModel(Fit1D::SPHERICVARIO, X, Y);
+		} else {
+			const std::vector<double> guess( fit.getParams() );
+			fit.setModel(Fit1D::SPHERICVARIO, X, Y, false);
+			fit.setGuess(guess);
+			fit.fit();
+		}
+		coeff = fit.getParams();
+		for (size_t ii=0; ii<lambda.size(); ii++) {
+			if (!IOUtils::checkEpsilonEquality(coeff[ii], lambda[ii], 1e-4*lambda[ii])) {
+				std::cout << "Wrong result when fitting SphericVario (pass " << pass << "): expected " << lambda[ii];
+				std::cout << " received " << setprecision(12) << coeff[ii] << " instead\n";
+				status = false;
+			}
+		}
+	}
+
 	if (status)
 		std::cout << "Regressions: success\n";
 	else
@@ -325,6 +346,66 @@ bool check_regressions(const vector<double>& x, const vector<double>& y) {
 	return status;
 }
 
+bool check_expressions(const vector<double>& x, const vector<double>& y) {
+	static const size_t nr_exprs = 5;
+	static const std::string exprs[nr_exprs] = {"x * 5/9 - 2^3", "-x + y % 7", "sqrt(abs(x)) + atan2(y, x) * pi", "(x, y) / 2 + e", "pow(x/100, 2) + ncr(6, 2) - floor(y/10)"};
+	vector<string> variables;
+	variables.push_back("x");
+	variables.push_back("y");
+
+	//the mask skips the 4th value, its result must stay untouched
+	const size_t N = x.size() * 11; //so the evaluation runs over several blocks
+	vector<double> X(N), Y(N);
+	vector<char> mask(N, 1);
+	for (size_t ii=0; ii<N; ++ii) {
+		X[ii] = x[ii % x.size()] + static_cast<double>(ii);
+		Y[ii] = y[ii % y.size()];
+	}
+	mask[3] = 0;
+
+	bool status = true;
+	for (size_t ee=0; ee<nr_exprs; ++ee) {
+		double te_x, te_y;
+		te_variable te_vars[] = {{"x", &te_x, TE_VARIABLE, nullptr}, {"y", &te_y, TE_VARIABLE, nullptr}};
+		int err;
+		te_expr *te_ref = te_compile(exprs[ee].c_str(), te_vars, 2, &err);
+
+		ColumnExpression expr;
+		if (!te_ref || !expr.compile(exprs[ee], variables, err)) {
+			std::cout << "Expression \"" << exprs[ee] << "\" could not be compiled\n";
+			te_free(te_ref);
+			status = false;
+			continue;
+		}
+		expr.bindColumn(0, &X[0]);
+		expr.bindColumn(1, &Y[0]);
+		vector<double> results(N, -1.);
+		expr.evaluate(N, &results[0], &mask[0]);
+
+		for (size_t ii=0; ii<N; ++ii) {
+			te_x = X[ii];
+			te_y = Y[ii];
+			const double expected = (mask[ii])? te_eval(te_ref) : -1.;
+			if (results[ii] != expected && !(results[ii]!=results[ii] && expected!=expected)) {
+				std::cout << "Expression \"" << exprs[ee] << "\" for x=" << X[ii] << ", y=" << Y[ii] << ": got " << results[ii] << " instead of " << expected << "\n";
+				status = false;
+				break;
+			}
+		}
+		te_free(te_ref);
+	}
+
+	ColumnExpression expr; //syntax errors must be reported
+	int err;
+	if (expr.compile("x * (y + ", variables, err) || err==0) status = false;
+
+	if (status)
+		std::cout << "Expressions: success\n";
+	else
+		std::cout << "Expressions: failed\n";
+	return status;
+}
+
 int main() {
 	vector<double> x,y;
 	//cr_rand_vectors(x, y);
@@ -337,8 +418,9 @@ int main() {
 	const bool der_status = check_derivative(x,y);
 	const bool quantiles_status = check_quantiles(x);
 	const bool regressions_status = check_regressions(x, y);
+	const bool expressions_status = check_expressions(x, y);
 
-	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status)
+	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status || !expressions_status)
 		throw IOException("Statistical functions error!", AT);
 
 
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/Source/snowpack/bin/profconvert"
+  "/root/repo/Source/snowpack/bin/profconvert.pdb"
+  "CMakeFiles/profconvert.dir/ProfConvert.cc.o"
+  "CMakeFiles/profconvert.dir/ProfConvert.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/profconvert.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
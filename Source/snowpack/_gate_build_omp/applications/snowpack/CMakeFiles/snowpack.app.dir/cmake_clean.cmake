@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/Source/snowpack/bin/snowpack"
+  "/root/repo/Source/snowpack/bin/snowpack.pdb"
+  "CMakeFiles/snowpack.app.dir/Main.cc.o"
+  "CMakeFiles/snowpack.app.dir/Main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/snowpack.app.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
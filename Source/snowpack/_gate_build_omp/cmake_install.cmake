@@ -0,0 +1,109 @@
+# Install script for directory: /root/repo/Source/snowpack
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/snowpack" TYPE FILE FILES
+    "/root/repo/Source/snowpack/snowpack/Constants.h"
+    "/root/repo/Source/snowpack/snowpack/DataClasses.h"
+    "/root/repo/Source/snowpack/snowpack/Hazard.h"
+    "/root/repo/Source/snowpack/snowpack/Laws_sn.h"
+    "/root/repo/Source/snowpack/snowpack/MainPage.h"
+    "/root/repo/Source/snowpack/snowpack/Meteo.h"
+    "/root/repo/Source/snowpack/snowpack/Saltation.h"
+    "/root/repo/Source/snowpack/snowpack/SnowDrift.h"
+    "/root/repo/Source/snowpack/snowpack/SnowpackConfig.h"
+    "/root/repo/Source/snowpack/snowpack/Stability.h"
+    "/root/repo/Source/snowpack/snowpack/StabilityAlgorithms.h"
+    "/root/repo/Source/snowpack/snowpack/TechnicalSnow.h"
+    "/root/repo/Source/snowpack/snowpack/Utils.h"
+    "/root/repo/Source/snowpack/snowpack/libsnowpack.h"
+    "/root/repo/Source/snowpack/snowpack/vanGenuchten.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/snowpack/plugins" TYPE FILE FILES
+    "/root/repo/Source/snowpack/snowpack/plugins/AsciiIO.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/CaaMLIO.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/ImisDBIO.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/ProfileStore.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/SmetIO.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/SnowpackIO.h"
+    "/root/repo/Source/snowpack/snowpack/plugins/SnowpackIOInterface.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "headers" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/snowpack/snowpackCore" TYPE FILE FILES
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/Aggregate.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/Canopy.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/Metamorphism.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/PhaseChange.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/ReSolver1d.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/SalinityTransport.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/SeaIce.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/Snowpack.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/Solver.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/VapourTransport.h"
+    "/root/repo/Source/snowpack/snowpack/snowpackCore/WaterTransport.h"
+    )
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/Source/snowpack/_gate_build_omp/snowpack/cmake_install.cmake")
+  include("/root/repo/Source/snowpack/_gate_build_omp/applications/snowpack/cmake_install.cmake")
+
+endif()
+
+if(CMAKE_INSTALL_COMPONENT)
+  set(CMAKE_INSTALL_MANIFEST "install_manifest_${CMAKE_INSTALL_COMPONENT}.txt")
+else()
+  set(CMAKE_INSTALL_MANIFEST "install_manifest.txt")
+endif()
+
+string(REPLACE ";" "\n" CMAKE_INSTALL_MANIFEST_CONTENT
+       "${CMAKE_INSTALL_MANIFEST_FILES}")
+file(WRITE "/root/repo/Source/snowpack/_gate_build_omp/${CMAKE_INSTALL_MANIFEST}"
+     "${CMAKE_INSTALL_MANIFEST_CONTENT}")
@@ -0,0 +1,52 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Source/snowpack/snowpack/DataClasses.cc" "snowpack/CMakeFiles/snowpack.dir/DataClasses.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/DataClasses.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Hazard.cc" "snowpack/CMakeFiles/snowpack.dir/Hazard.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Hazard.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Laws_sn.cc" "snowpack/CMakeFiles/snowpack.dir/Laws_sn.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Laws_sn.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Meteo.cc" "snowpack/CMakeFiles/snowpack.dir/Meteo.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Meteo.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Saltation.cc" "snowpack/CMakeFiles/snowpack.dir/Saltation.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Saltation.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/SnowDrift.cc" "snowpack/CMakeFiles/snowpack.dir/SnowDrift.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/SnowDrift.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/SnowpackConfig.cc" "snowpack/CMakeFiles/snowpack.dir/SnowpackConfig.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/SnowpackConfig.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Stability.cc" "snowpack/CMakeFiles/snowpack.dir/Stability.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Stability.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/StabilityAlgorithms.cc" "snowpack/CMakeFiles/snowpack.dir/StabilityAlgorithms.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/StabilityAlgorithms.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/TechnicalSnow.cc" "snowpack/CMakeFiles/snowpack.dir/TechnicalSnow.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/TechnicalSnow.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/Utils.cc" "snowpack/CMakeFiles/snowpack.dir/Utils.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/Utils.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/plugins/AsciiIO.cc" "snowpack/CMakeFiles/snowpack.dir/plugins/AsciiIO.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/plugins/AsciiIO.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/plugins/ProfileStore.cc" "snowpack/CMakeFiles/snowpack.dir/plugins/ProfileStore.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/plugins/ProfileStore.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/plugins/SmetIO.cc" "snowpack/CMakeFiles/snowpack.dir/plugins/SmetIO.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/plugins/SmetIO.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/plugins/SnowpackIO.cc" "snowpack/CMakeFiles/snowpack.dir/plugins/SnowpackIO.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/plugins/SnowpackIO.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/Aggregate.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Aggregate.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Aggregate.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/Canopy.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Canopy.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Canopy.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/Metamorphism.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Metamorphism.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Metamorphism.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/PhaseChange.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/PhaseChange.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/PhaseChange.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/ReSolver1d.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/ReSolver1d.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/ReSolver1d.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/SalinityTransport.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/SalinityTransport.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/SalinityTransport.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/SeaIce.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/SeaIce.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/SeaIce.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/Snowpack.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Snowpack.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Snowpack.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/Solver.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Solver.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/Solver.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/VapourTransport.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/VapourTransport.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/VapourTransport.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/snowpackCore/WaterTransport.cc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/WaterTransport.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/snowpackCore/WaterTransport.cc.o.d"
+  "/root/repo/Source/snowpack/snowpack/vanGenuchten.cc" "snowpack/CMakeFiles/snowpack.dir/vanGenuchten.cc.o" "gcc" "snowpack/CMakeFiles/snowpack.dir/vanGenuchten.cc.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/Source/snowpack/lib/libsnowpack.so" "/root/repo/Source/snowpack/lib/libsnowpack.so.3.6.0"
+  "/root/repo/Source/snowpack/lib/libsnowpack.so.3" "/root/repo/Source/snowpack/lib/libsnowpack.so.3.6.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
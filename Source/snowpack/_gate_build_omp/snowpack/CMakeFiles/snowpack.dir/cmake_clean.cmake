@@ -0,0 +1,65 @@
+file(REMOVE_RECURSE
+  "/root/repo/Source/snowpack/lib/libsnowpack.pdb"
+  "/root/repo/Source/snowpack/lib/libsnowpack.so"
+  "/root/repo/Source/snowpack/lib/libsnowpack.so.3"
+  "/root/repo/Source/snowpack/lib/libsnowpack.so.3.6.0"
+  "CMakeFiles/snowpack.dir/DataClasses.cc.o"
+  "CMakeFiles/snowpack.dir/DataClasses.cc.o.d"
+  "CMakeFiles/snowpack.dir/Hazard.cc.o"
+  "CMakeFiles/snowpack.dir/Hazard.cc.o.d"
+  "CMakeFiles/snowpack.dir/Laws_sn.cc.o"
+  "CMakeFiles/snowpack.dir/Laws_sn.cc.o.d"
+  "CMakeFiles/snowpack.dir/Meteo.cc.o"
+  "CMakeFiles/snowpack.dir/Meteo.cc.o.d"
+  "CMakeFiles/snowpack.dir/Saltation.cc.o"
+  "CMakeFiles/snowpack.dir/Saltation.cc.o.d"
+  "CMakeFiles/snowpack.dir/SnowDrift.cc.o"
+  "CMakeFiles/snowpack.dir/SnowDrift.cc.o.d"
+  "CMakeFiles/snowpack.dir/SnowpackConfig.cc.o"
+  "CMakeFiles/snowpack.dir/SnowpackConfig.cc.o.d"
+  "CMakeFiles/snowpack.dir/Stability.cc.o"
+  "CMakeFiles/snowpack.dir/Stability.cc.o.d"
+  "CMakeFiles/snowpack.dir/StabilityAlgorithms.cc.o"
+  "CMakeFiles/snowpack.dir/StabilityAlgorithms.cc.o.d"
+  "CMakeFiles/snowpack.dir/TechnicalSnow.cc.o"
+  "CMakeFiles/snowpack.dir/TechnicalSnow.cc.o.d"
+  "CMakeFiles/snowpack.dir/Utils.cc.o"
+  "CMakeFiles/snowpack.dir/Utils.cc.o.d"
+  "CMakeFiles/snowpack.dir/plugins/AsciiIO.cc.o"
+  "CMakeFiles/snowpack.dir/plugins/AsciiIO.cc.o.d"
+  "CMakeFiles/snowpack.dir/plugins/ProfileStore.cc.o"
+  "CMakeFiles/snowpack.dir/plugins/ProfileStore.cc.o.d"
+  "CMakeFiles/snowpack.dir/plugins/SmetIO.cc.o"
+  "CMakeFiles/snowpack.dir/plugins/SmetIO.cc.o.d"
+  "CMakeFiles/snowpack.dir/plugins/SnowpackIO.cc.o"
+  "CMakeFiles/snowpack.dir/plugins/SnowpackIO.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/Aggregate.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/Aggregate.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/Canopy.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/Canopy.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/Metamorphism.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/Metamorphism.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/PhaseChange.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/PhaseChange.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/ReSolver1d.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/ReSolver1d.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/SalinityTransport.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/SalinityTransport.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/SeaIce.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/SeaIce.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/Snowpack.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/Snowpack.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/Solver.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/Solver.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/VapourTransport.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/VapourTransport.cc.o.d"
+  "CMakeFiles/snowpack.dir/snowpackCore/WaterTransport.cc.o"
+  "CMakeFiles/snowpack.dir/snowpackCore/WaterTransport.cc.o.d"
+  "CMakeFiles/snowpack.dir/vanGenuchten.cc.o"
+  "CMakeFiles/snowpack.dir/vanGenuchten.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/snowpack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <iomanip>
 #include <ctime>
 
 #ifdef _MSC_VER
@@ -653,6 +654,151 @@ inline void dataForCurrentTimeStep(CurrentMeteo& Mdata, SurfaceFluxes& surfFluxe
 	}
 }
 
+/**
+ * @brief Can the virtual slopes be computed independently of each other?
+ * @details Once the main station has been computed, the virtual slopes only depend on it, except the lee slope that gets
+ * the snow eroded on the windward slope when SNOW_REDISTRIBUTION is set. But some settings carry state from one slope
+ * to the next one within a time step (cumulated surface fluxes, canopy), in which case the slopes are computed one after
+ * the other as before so the results remain the same.
+ * @param cfg configuration
+ * @param slope slopes configuration
+ * @return true if the virtual slopes can be computed concurrently
+ */
+inline bool independentSlopes(const SnowpackConfig& cfg, const Slope& slope)
+{
+	if (slope.nSlopes < 2) return false;
+	const bool avgsum_time_series = cfg.get("AVGSUM_TIME_SERIES", "Output");
+	const bool cumsum_mass = cfg.get("CUMSUM_MASS", "Output");
+	const bool useCanopyModel = cfg.get("CANOPY", "Snowpack");
+	return (!avgsum_time_series && !cumsum_mass && !useCanopyModel);
+}
+
+/**
+ * @brief Initialize the variant dependent static data of SnLaws before several threads use it
+ * @details These parameters are static and shared by all the stations, slopes and ensemble members. They are otherwise
+ * initialized lazily (on the first settling or new snow density computation), so this must be done before entering a
+ * parallel region, otherwise several threads could write them at once.
+ * @param cfg configuration
+ */
+inline void initSnLawsStaticData(const SnowpackConfig& cfg)
+{
+	const std::string variant = cfg.get("VARIANT", "SnowpackAdvanced");
+	if (variant != SnLaws::current_variant)
+		SnLaws::setStaticData(variant, cfg.get("WATERTRANSPORTMODEL_SNOW", "SnowpackAdvanced"));
+}
+
+/**
+ * @brief State of a virtual slope at the end of its computation for the current time step, kept until its outputs are written
+ */
+struct SlopeStep {
+	SlopeStep(const Slope& i_slope, const CurrentMeteo& i_Mdata, const SurfaceFluxes& i_surfFluxes, const BoundCond& i_Bdata, const double& i_precip)
+	          : slope(i_slope), Mdata(i_Mdata), surfFluxes(i_surfFluxes), sn_Bdata(i_Bdata),
+	            precip(i_precip), tot_mass_in(0.), erosion_mass(0.) {}
+
+	Slope slope;              ///< slope status for this slope (as set by Slope::setSlope())
+	CurrentMeteo Mdata;
+	SurfaceFluxes surfFluxes;
+	BoundCond sn_Bdata;
+	double precip;            ///< cumulated precipitation, as left by this slope
+	double tot_mass_in;       ///< initial mass for the mass balance check
+	double erosion_mass;      ///< eroded mass at the end of the computation (before the lee slope takes it over)
+};
+
+/**
+ * @brief Compute one virtual slope for the current time step, the main station having already been computed
+ * @details This performs the same steps as the sequential loop in real_main() up to the collection of the surface fluxes,
+ * but on the slope's own copy of the forcing, fluxes and boundary conditions so several slopes can run at the same time.
+ */
+inline void computeSlope(SlopeStep& step, const unsigned int& slope_sequence, const mio::MeteoData& md, vector<SnowStation>& vecXdata,
+                         const SnowpackConfig& cfg, SunObject& sun, const double& lw_in, const double& hs_a3hl6,
+                         const double& wind_scaling_factor, const std::string& variant,
+                         const bool& grooming, const bool& classify_profile, const mio::Date& current_date)
+{
+	SnowpackConfig tmpcfg(cfg);
+	bool iswr_is_net = false;
+	copyMeteoData(md, step.Mdata, step.slope.prevailing_wind_dir, wind_scaling_factor, iswr_is_net);
+	step.Mdata.copySnowTemperatures(md, slope_sequence);
+	step.Mdata.copySolutes(md, SnowStation::number_of_solutes);
+	dataForCurrentTimeStep(step.Mdata, step.surfFluxes, vecXdata, step.slope, tmpcfg,
+	                       sun, step.precip, lw_in, hs_a3hl6,
+	                       step.tot_mass_in, variant, iswr_is_net);
+
+	Snowpack snowpack(tmpcfg);
+	Stability stability(tmpcfg, classify_profile);
+	SnowStation& Xdata = vecXdata[step.slope.sector];
+	snowpack.runSnowpackModel(step.Mdata, Xdata, step.precip, step.sn_Bdata, step.surfFluxes);
+	if (grooming)
+		snowpack.snowPreparation(current_date, Xdata);
+	stability.checkStability(step.Mdata, Xdata);
+	step.surfFluxes.collectSurfaceFluxes(step.sn_Bdata, Xdata, step.Mdata);
+	step.erosion_mass = Xdata.ErosionMass;
+}
+
+/**
+ * @brief Compute all the virtual slopes of the current time step, concurrently when compiled with OpenMP
+ * @details The slopes are grouped into chains that must be computed in order: when SNOW_REDISTRIBUTION is set, the lee slope
+ * follows the windward slope whose eroded snow it receives, all the other slopes being independent. The chains are then
+ * distributed among the threads. The outputs are not written here, the caller writes them in the usual slope sequence.
+ * @param slope slopes status after the main station has been computed (it is left on the last slope of the sequence)
+ * @param Mdata forcing of the main station, used as starting point for each slope
+ * @param surfFluxes surface fluxes after the main station has been written out
+ * @param sn_Bdata boundary conditions of the main station
+ * @param precip cumulated precipitation, updated as if the slopes had been computed one after the other
+ * @param steps one SlopeStep per virtual slope, in sequence order (ie. steps[0] is the slope_sequence 1)
+ */
+inline void computeVirtualSlopes(Slope& slope, const CurrentMeteo& Mdata, const SurfaceFluxes& surfFluxes, const BoundCond& sn_Bdata, double& precip,
+                                 const mio::MeteoData& md, vector<SnowStation>& vecXdata,
+                                 const SnowpackConfig& cfg, SunObject& sun, const double& lw_in, const double& hs_a3hl6,
+                                 const double& wind_scaling_factor, const std::string& variant,
+                                 const bool& grooming, const bool& classify_profile, const mio::Date& current_date, vector<SlopeStep>& steps)
+{
+	//the slopes status only depends on the sequence, not on the computations
+	steps.clear();
+	steps.reserve(slope.nSlopes-1);
+	double wind_dir = Mdata.dw_drift; //only used for the main station
+	for (unsigned int slope_sequence=1; slope_sequence<slope.nSlopes; slope_sequence++) {
+		slope.setSlope(slope_sequence, vecXdata, wind_dir);
+		steps.push_back( SlopeStep(slope, Mdata, surfFluxes, sn_Bdata, precip) );
+	}
+
+	vector< vector<size_t> > chains;
+	size_t lee_chain = IOUtils::npos;
+	for (size_t ii=0; ii<steps.size(); ii++) {
+		const unsigned int sector = steps[ii].slope.sector;
+		if (slope.snow_redistribution && sector == slope.lee && lee_chain != IOUtils::npos) {
+			chains[lee_chain].push_back( ii );
+			continue;
+		}
+		chains.push_back( vector<size_t>(1, ii) );
+		if (slope.snow_redistribution && sector == slope.luv) lee_chain = chains.size() - 1;
+	}
+
+	initSnLawsStaticData(cfg); //the main station might not have needed it yet (for example without any snow)
+	size_t errCount = 0;
+	#pragma omp parallel for schedule(dynamic, 1) reduction(+: errCount)
+	for (size_t cc=0; cc<chains.size(); cc++) {
+		// process exceptions in a way that is compatible with openmp
+		try {
+			for (size_t jj=0; jj<chains[cc].size(); jj++) {
+				const size_t ii = chains[cc][jj];
+				computeSlope(steps[ii], static_cast<unsigned int>(ii+1), md, vecXdata, cfg, sun, lw_in, hs_a3hl6,
+				             wind_scaling_factor, variant, grooming, classify_profile, current_date);
+			}
+		} catch(const std::exception& e) {
+			++errCount;
+			cout << e.what() << std::endl;
+		}
+	}
+	if (errCount > 0)
+		throw mio::IOException("Computation of the virtual slopes failed", AT);
+
+	//each slope either keeps the cumulated precipitation or resets it, so the last change in the sequence wins
+	const double precip_main = precip;
+	for (size_t ii=0; ii<steps.size(); ii++) {
+		if (steps[ii].precip != precip_main) precip = steps[ii].precip;
+	}
+}
+
 /**
  * @brief determine which outputs need to be done for the current time step
  * @param mn_ctrl timestep control structure
@@ -942,52 +1088,251 @@ inline void printStartInfo(const SnowpackConfig& cfg, const std::string& name)
 	}
 }
 
-// SNOWPACK MAIN **************************************************************
-inline void real_main (int argc, char *argv[])
+/**
+ * @class Perturbation
+ * @brief Perturbations applied to the forcing of one ensemble member
+ * @details For each parameter listed in the [Ensemble] section, each member draws one perturbation from the configured
+ * distribution. It is then applied on the forcing of this member for the whole simulation period, either added (ADD) or
+ * multiplied (MULT). The perturbed values are kept physically possible (non-negative, RH at most 1, DW within [0, 360[).
+ * The shared forcing is never modified, each member perturbs its own copy of the current time step.
+ */
+class Perturbation {
+	public:
+		Perturbation() : params(), values(), multiplicative() {}
+		Perturbation(const mio::Config& cfg, const unsigned int& member);
+
+		void apply(mio::MeteoData& md) const;
+		bool empty() const {return params.empty();}
+
+	private:
+		std::vector<std::string> params;
+		std::vector<double> values;
+		std::vector<bool> multiplicative;
+};
+
+/**
+ * @brief Draw the perturbations of one member
+ * @param cfg configuration containing the [Ensemble] section
+ * @param member member index (when CONTROL_MEMBER is set, member 0 is not perturbed)
+ */
+Perturbation::Perturbation(const mio::Config& cfg, const unsigned int& member)
+             : params(), values(), multiplicative()
 {
-	setbuf(stdout, NULL); //always flush stdout
-	setbuf(stderr, NULL); //always flush stderr
-#ifdef DEBUG_ARITHM
-	feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW ); //for halting the process at arithmetic exceptions, see also ReSolver1d
-#endif
-	//parse the command line arguments
-	std::string begin_date_str, end_date_str;
-	parseCmdLine(argc, argv, begin_date_str, end_date_str);
+	const bool control_member = cfg.get("CONTROL_MEMBER", "Ensemble", true);
+	if (control_member && member==0) return;
+
+	uint64_t seed = 0;
+	const bool fixed_seed = cfg.keyExists("SEED", "Ensemble");
+	if (fixed_seed) cfg.getValue("SEED", "Ensemble", seed);
+
+	const std::vector<std::string> keys( cfg.getKeys("::PERTURB", "Ensemble", true) );
+	for (size_t ii=0; ii<keys.size(); ii++) {
+		const std::string param( keys[ii].substr(0, keys[ii].find("::")) );
+		const std::string type( IOUtils::strToUpper( cfg.get(param+"::PERTURB", "Ensemble") ) );
+		if (type!="ADD" && type!="MULT")
+			throw mio::InvalidArgumentException("Perturbation '"+type+"' not supported for "+param+", please use either ADD or MULT", AT);
+		const mio::RandomNumberGenerator::RNG_DISTR distribution = mio::RandomNumberGenerator::strToRngdistr( cfg.get(param+"::DISTRIBUTION", "Ensemble", "GAUSS") );
+		std::vector<double> distr_params;
+		cfg.getValue(param+"::PARAMETERS", "Ensemble", distr_params, IOUtils::nothrow);
+
+		//with a fixed seed, each member and parameter gets its own reproducible sequence
+		mio::RandomNumberGenerator RNG(mio::RandomNumberGenerator::RNG_XOR, distribution,
+		                               (distribution==mio::RandomNumberGenerator::RNG_UNIFORM)? std::vector<double>() : distr_params);
+		if (fixed_seed) {
+			const uint64_t state = seed ^ ((static_cast<uint64_t>(member)+1) * 0x9E3779B97F4A7C15ULL) ^ ((static_cast<uint64_t>(ii)+1) << 32);
+			const uint64_t seed_init[4] = {state, state ^ 4101842887655102017ULL, 4101842887655102017ULL ^ (state << 1), 1};
+			RNG.setState( std::vector<uint64_t>(seed_init, seed_init+4) );
+			for (size_t jj=0; jj<16; jj++) RNG.int64(); //let the states mix
+		}
+		double value = RNG.doub();
+		if (distribution==mio::RandomNumberGenerator::RNG_UNIFORM && distr_params.size()==2) //uniform within [min, max]
+			value = distr_params[0] + (distr_params[1]-distr_params[0]) * value;
 
-	const bool prn_check = false;
-	mio::Timer meteoRead_timer;
-	mio::Timer run_timer;
-	run_timer.start();
-	time_t nowSRT = time(NULL);
-	MainControl mn_ctrl; //Time step control parameters
+		params.push_back( param );
+		values.push_back( value );
+		multiplicative.push_back( type=="MULT" );
+	}
+}
 
-	SnowpackConfig cfg(cfgfile);
-	addSpecialKeys(cfg);
+void Perturbation::apply(mio::MeteoData& md) const
+{
+	for (size_t ii=0; ii<params.size(); ii++) {
+		if (!md.param_exists(params[ii])) continue;
+		double& value = md(params[ii]);
+		if (value==IOUtils::nodata) continue;
+
+		value = (multiplicative[ii])? value*values[ii] : value+values[ii];
+		if (params[ii]=="DW") {
+			value = fmod(value, 360.);
+			if (value<0.) value += 360.;
+		} else {
+			if (value<0.) value = 0.;
+			if (params[ii]=="RH" && value>1.) value = 1.;
+		}
+	}
+}
 
-	const double i_time_zone = cfg.get("TIME_ZONE", "Input"); //get user provided input time_zone
-	if (!begin_date_str.empty()) {
-		mio::IOUtils::convertString(dateBegin, begin_date_str, i_time_zone);
+/**
+ * @brief Forcing of one station for the whole simulation period, as prepared by MeteoIO
+ * @details In ensemble mode, the forcing is read, filtered and resampled only once and then replayed from memory for
+ * all the members.
+ */
+struct ForcingReplay {
+	ForcingReplay() : start(), dt(0.), meteo(), hs_a3hl6(), sampling_rate(IOUtils::nodata) {}
+
+	mio::Date start;                   ///< date of the first calculation step
+	double dt;                         ///< calculation step length (days)
+	std::vector<mio::MeteoData> meteo; ///< forcing of each calculation step
+	std::vector<double> hs_a3hl6;      ///< snow height average over the 3 hours before each calculation step
+	double sampling_rate;              ///< average sampling rate of the raw data, as reported by MeteoIO
+};
+
+/**
+ * @class ForcingSource
+ * @brief Provides the forcing of one station to the time integration loop, either directly from MeteoIO or
+ * from a ForcingReplay (with the perturbations of an ensemble member)
+ */
+class ForcingSource {
+	public:
+		ForcingSource(mio::IOManager& i_io, const size_t& i_stn)
+		             : io(&i_io), replay(NULL), perturbation(), stn_idx(i_stn) {}
+		ForcingSource(const ForcingReplay& i_replay, const Perturbation& i_perturbation)
+		             : io(NULL), replay(&i_replay), perturbation(i_perturbation), stn_idx(0) {}
+
+		void getMeteoData(const mio::Date& date, mio::MeteoData& md);
+		double getHS_last3hours(const mio::Date& date);
+		double getAvgSamplingRate() const {return (replay!=NULL)? replay->sampling_rate : io->getAvgSamplingRate();}
+
+	private:
+		size_t getReplayIndex(const mio::Date& date) const;
+
+		mio::IOManager* io;
+		const ForcingReplay* replay;
+		Perturbation perturbation;
+		size_t stn_idx;
+};
+
+size_t ForcingSource::getReplayIndex(const mio::Date& date) const
+{
+	const double offset = (date.getJulian() - replay->start.getJulian()) / replay->dt;
+	if (offset < -0.5 || offset > static_cast<double>(replay->meteo.size()) - 0.5)
+		throw mio::IndexOutOfBoundsException("No forcing available in memory for "+date.toString(mio::Date::ISO), AT);
+	return static_cast<size_t>( floor(offset + 0.5) );
+}
+
+void ForcingSource::getMeteoData(const mio::Date& date, mio::MeteoData& md)
+{
+	if (replay!=NULL) {
+		md = replay->meteo[ getReplayIndex(date) ];
+		perturbation.apply(md);
+		return;
 	}
-	if (end_date_str == "NOW") { //interpret user provided end date
-		dateEnd.setFromSys();
-		dateEnd.setTimeZone(i_time_zone);
-		dateEnd.rnd(1800, mio::Date::DOWN);
-	} else {
-		mio::IOUtils::convertString(dateEnd, end_date_str, i_time_zone);
+
+	std::vector<mio::MeteoData> vecMeteo;
+	io->getMeteoData(date, vecMeteo);
+	md = vecMeteo[stn_idx];
+}
+
+double ForcingSource::getHS_last3hours(const mio::Date& date)
+{
+	if (replay!=NULL) return replay->hs_a3hl6[ getReplayIndex(date) ];
+	return ::getHS_last3hours(*io, date);
+}
+
+/**
+ * @brief Read the forcing of one station once for all the calculation steps of the simulation
+ * @param io IOManager to read the data from
+ * @param i_stn station index
+ * @param current_date date preceding the first calculation step
+ * @param calculation_step_length calculation step length (min)
+ * @param replay forcing for all the calculation steps
+ */
+inline void readForcingReplay(mio::IOManager& io, const size_t& i_stn, mio::Date current_date, const double& calculation_step_length, ForcingReplay& replay)
+{
+	replay.dt = calculation_step_length/1440;
+	replay.start = current_date + replay.dt;
+	replay.meteo.clear();
+	replay.hs_a3hl6.clear();
+
+	std::vector<mio::MeteoData> vecMeteo;
+	do { //same steps as in the time integration loop
+		current_date += replay.dt;
+		io.getMeteoData(current_date, vecMeteo);
+		if (replay.sampling_rate==IOUtils::nodata) replay.sampling_rate = io.getAvgSamplingRate();
+		replay.meteo.push_back( vecMeteo[i_stn] );
+		replay.hs_a3hl6.push_back( getHS_last3hours(io, current_date) );
+	} while ((dateEnd.getJulian() - current_date.getJulian()) > calculation_step_length/(2.*1440));
+}
+
+/**
+ * @brief Initial state of a station, as read from its sno file(s)
+ * @details In ensemble mode, this is read once and copied for each member.
+ */
+struct StationInit {
+	StationInit(const SnowpackConfig& cfg);
+
+	Slope slope;
+	ZwischenData sn_Zdata;                 ///< "Memory"-data, required for every operational station
+	vector<SN_SNOWSOIL_DATA> vecSSdata;
+	vector<SnowStation> vecXdata;
+	CurrentMeteo Mdata;                    ///< meteo data object to hold interpolated current time steps
+	double wind_scaling_factor;            ///< Used to scale wind for blowing and drifting snowpack (from statistical analysis)
+	double time_count_deltaHS;             ///< Control of time window: used for adapting diverging snow depth in operational mode
+	mio::Date current_date;
+};
+
+StationInit::StationInit(const SnowpackConfig& cfg)
+            : slope(cfg), sn_Zdata(), vecSSdata(slope.nSlopes, SN_SNOWSOIL_DATA(/*number_of_solutes*/)), vecXdata(), Mdata(cfg),
+              wind_scaling_factor(cfg.get("WIND_SCALING_FACTOR", "SnowpackAdvanced")), time_count_deltaHS(0.), current_date(dateBegin)
+{
+	const std::string variant = cfg.get("VARIANT", "SnowpackAdvanced");
+	const bool useSoilLayers = cfg.get("SNP_SOIL", "Snowpack");
+	const bool useCanopyModel = cfg.get("CANOPY", "Snowpack");
+	for (size_t ii=0; ii<slope.nSlopes; ii++) { //fill vecXdata with *different* SnowStation objects
+		vecXdata.push_back( SnowStation(useCanopyModel, useSoilLayers, false /*Is A3d?*/, (variant=="SEAICE") ) );
+		if (vecXdata.back().Seaice != NULL) vecXdata[ii].Seaice->ConfigSeaIce(cfg);
 	}
+}
+
+/**
+ * @brief Name of the experiment of an ensemble member, so each member writes its own output files
+ * @param experiment name of the experiment
+ * @param member member index
+ * @return experiment name for this member
+ */
+inline std::string getMemberExperiment(const std::string& experiment, const unsigned int& member)
+{
+	std::ostringstream ss;
+	ss << experiment << "_m" << std::setfill('0') << std::setw(3) << member;
+	return ss.str();
+}
+
+/**
+ * @brief Run the simulation of one station from its initial state until dateEnd
+ * @details The forcing is either read from MeteoIO for each time step or replayed from memory (ensemble mode).
+ * In ensemble mode, several stations are computed at the same time, each with its own state, configuration
+ * and outputs.
+ * @param stn initial state of the station, it is then updated by the simulation
+ * @param cfg configuration of this simulation
+ * @param snowpackio outputs of this simulation
+ * @param forcing where to get the forcing from
+ * @param i_stn station index
+ * @param meteoRead_timer timer measuring the time spent getting the forcing
+ * @param write_outputs if false, nothing is written out (this is used for the spin-up cycles)
+ */
+inline void runStation(StationInit& stn, SnowpackConfig& cfg, SnowpackIO& snowpackio, ForcingSource& forcing,
+                       const size_t& i_stn, mio::Timer& meteoRead_timer, const bool& write_outputs=true)
+{
+	const bool prn_check = false;
+	MainControl mn_ctrl; //Time step control parameters
 
 	const std::string variant = cfg.get("VARIANT", "SnowpackAdvanced");
 	const std::string experiment = cfg.get("EXPERIMENT", "Output");
 	const std::string outpath = cfg.get("METEOPATH", "Output");
-	const bool useSoilLayers = cfg.get("SNP_SOIL", "Snowpack");
 	const bool useCanopyModel = cfg.get("CANOPY", "Snowpack");
 	const double calculation_step_length = cfg.get("CALCULATION_STEP_LENGTH", "Snowpack");
 	const double sn_dt = M_TO_S(calculation_step_length); //Calculation time step in seconds
 
-	int nSolutes = Constants::iundefined;
-	cfg.getValue("NUMBER_OF_SOLUTES", "Input", nSolutes, mio::IOUtils::nothrow);
-	if (nSolutes > 0) SnowStation::number_of_solutes = static_cast<short unsigned int>(nSolutes);
-
 	//Interval between profile backups (*.sno\<JulianDate\>) (d)
 	double backup_days_between = 400.;
 	cfg.getValue("SNOW_DAYS_BETWEEN", "Output", backup_days_between, mio::IOUtils::nothrow);
@@ -1014,153 +1359,115 @@ inline void real_main (int argc, char *argv[])
 	const bool advective_heat = cfg.get("ADVECTIVE_HEAT", "SnowpackAdvanced");
 	const bool soil_flux = cfg.get("SOIL_FLUX", "Snowpack");
 
-	//If the user provides the stationIDs - operational use case
-	if (!vecStationIDs.empty()) { //operational use case: stationIDs provided on the command line
-		for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
-			stringstream ss;
-			ss << "STATION" << i_stn+1;
-			cfg.addKey(ss.str(), "Input", vecStationIDs[i_stn]);
-		}
-	}
-
-	SnowpackIO snowpackio(cfg);
-	mio::IOManager io(cfg);
-	io.setMinBufferRequirements(IOUtils::nodata, 1.1); //we require the buffer to contain at least 1.1 day before the current point
-
-	if (vecStationIDs.empty()) { //research use case: stationIDs provided by the available input files
-		vector<StationData> accessible_stations;
-		io.getStationData(dateEnd, accessible_stations); //we are retrieving meta information from MeteoIO
-		for (size_t ii=0; ii<accessible_stations.size(); ii++) {
-			vecStationIDs.push_back( accessible_stations[ii].getStationID() ); //HACK: accessible_stations should be directly used
+	Slope& slope = stn.slope;
+	ZwischenData& sn_Zdata = stn.sn_Zdata;
+	vector<SN_SNOWSOIL_DATA>& vecSSdata = stn.vecSSdata;
+	vector<SnowStation>& vecXdata = stn.vecXdata;
+	CurrentMeteo& Mdata = stn.Mdata;
+	double& wind_scaling_factor = stn.wind_scaling_factor;
+	double& time_count_deltaHS = stn.time_count_deltaHS;
+	mio::Date& current_date = stn.current_date;
+
+	Cumsum cumsum(slope.nSlopes);
+	double lw_in = Constants::undefined;    // Storage for LWin from flat field energy balance
+	// To collect surface exchange data for output
+	SurfaceFluxes surfFluxes/*(number_of_solutes)*/;
+	// Boundary condition (fluxes)
+	BoundCond sn_Bdata;
+	const bool independent_slopes = independentSlopes(cfg, slope);
+
+	memset(&mn_ctrl, 0, sizeof(MainControl));
+	if (mode == "RESEARCH") {
+		mn_ctrl.resFirstDump = true; //HACK to dump the initial state in research mode
+		if (write_outputs) {
+			deleteOldOutputFiles(outpath, experiment, vecStationIDs[i_stn], slope.nSlopes, snowpackio.getExtensions());
+			cfg.write(outpath + "/" + vecStationIDs[i_stn] + "_" + experiment + ".ini"); //output config
 		}
+	} else {
+		const std::string db_name = cfg.get("DBNAME", "Output", "");
+		if (db_name == "sdbo" || db_name == "sdbt")
+			mn_ctrl.sdbDump = true;
 	}
 
-	//now, let's start!
-	printStartInfo(cfg, string(argv[0]));
-
-	// START LOOP OVER ALL STATIONS
-	bool write_forcing = cfg.get("WRITE_PROCESSED_METEO", "Output"); //it will be set to false once it has been done
-	for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
-		cout << endl;
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Run on meteo station %s", vecStationIDs[i_stn].c_str());
-		run_timer.reset();
-		meteoRead_timer.reset();
-
-		Slope slope(cfg);
-		Cumsum cumsum(slope.nSlopes);
-
-		double lw_in = Constants::undefined;    // Storage for LWin from flat field energy balance
-
-		// Used to scale wind for blowing and drifting snowpack (from statistical analysis)
-		double wind_scaling_factor = cfg.get("WIND_SCALING_FACTOR", "SnowpackAdvanced");
-
-		// Control of time window: used for adapting diverging snow depth in operational mode
-		double time_count_deltaHS = 0.;
-
-		// Snowpack data (input/output)
-		ZwischenData sn_Zdata;   // "Memory"-data, required for every operational station
-		vector<SN_SNOWSOIL_DATA> vecSSdata(slope.nSlopes, SN_SNOWSOIL_DATA(/*number_of_solutes*/));
-		vector<SnowStation> vecXdata;
-		for (size_t ii=0; ii<slope.nSlopes; ii++) { //fill vecXdata with *different* SnowStation objects
-			vecXdata.push_back( SnowStation(useCanopyModel, useSoilLayers, false /*Is A3d?*/, (variant=="SEAICE") ) );
-			if (vecXdata.back().Seaice != NULL) vecXdata[ii].Seaice->ConfigSeaIce(cfg);
-		}
-
-		// Create meteo data object to hold interpolated current time steps
-		CurrentMeteo Mdata(cfg);
-		// To collect surface exchange data for output
-		SurfaceFluxes surfFluxes/*(number_of_solutes)*/;
-		// Boundary condition (fluxes)
-		BoundCond sn_Bdata;
-
-		mio::Date current_date( dateBegin );
+	SunObject sun(vecSSdata[slope.mainStation].meta.position.getLat(), vecSSdata[slope.mainStation].meta.position.getLon(), vecSSdata[slope.mainStation].meta.position.getAltitude());
+	sun.setElevationThresh(0.6);
+	vector<ProcessDat> qr_Hdata;     //Hazard data for t=0...tn
+	vector<ProcessInd> qr_Hdata_ind; //Hazard data Index for t=0...tn
+	const double duration = (dateEnd.getJulian() - current_date.getJulian() + 0.5/24)*24*3600; //HACK: why is it computed this way?
+	Hazard hazard(cfg, duration);
+	hazard.initializeHazard(sn_Zdata.drift24, vecXdata.at(0).meta.getSlopeAngle(), qr_Hdata, qr_Hdata_ind);
+
+	prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Start simulation for %s on %s",
+		vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO_TZ).c_str());
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "End date specified by user: %s",
+	        dateEnd.toString(mio::Date::ISO_TZ).c_str());
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Integration step length: %f min",
+	        calculation_step_length);
+
+	bool computed_one_timestep = false;
+	double meteo_step_length = -1.;
+	const bool enforce_snow_height = cfg.get("ENFORCE_MEASURED_SNOW_HEIGHTS", "Snowpack");
+
+	// START TIME INTEGRATION LOOP
+	do {
+		current_date += calculation_step_length/1440;
+		mn_ctrl.nStep++;
+		mn_ctrl.nAvg++;
+
+		// Get meteo data
+		mio::MeteoData md;
 		meteoRead_timer.start();
-		if (mode == "OPERATIONAL")
-			cfg.addKey("PERP_TO_SLOPE", "SnowpackAdvanced", "false");
-		const bool read_slope_status = readSlopeMeta(io, snowpackio, cfg, i_stn, slope, current_date, vecSSdata, vecXdata, sn_Zdata, Mdata, wind_scaling_factor, time_count_deltaHS);
-		meteoRead_timer.stop();
-		if (!read_slope_status) continue; //something went wrong, move to the next station
-
-		memset(&mn_ctrl, 0, sizeof(MainControl));
-		if (mode == "RESEARCH") {
-			mn_ctrl.resFirstDump = true; //HACK to dump the initial state in research mode
-			deleteOldOutputFiles(outpath, experiment, vecStationIDs[i_stn], slope.nSlopes, snowpackio.getExtensions());
-			cfg.write(outpath + "/" + vecStationIDs[i_stn] + "_" + experiment + ".ini"); //output config
-			if (!restart) current_date -= calculation_step_length/(24.*60.);
-		} else {
-			const std::string db_name = cfg.get("DBNAME", "Output", "");
-			if (db_name == "sdbo" || db_name == "sdbt")
-				mn_ctrl.sdbDump = true;
+		forcing.getMeteoData(current_date, md);
+		if(meteo_step_length<0.) {
+			std::stringstream ss2;
+			meteo_step_length = forcing.getAvgSamplingRate();
+			ss2 << "" << meteo_step_length;
+			cfg.addKey("METEO_STEP_LENGTH", "Snowpack", ss2.str());
 		}
-
-		SunObject sun(vecSSdata[slope.mainStation].meta.position.getLat(), vecSSdata[slope.mainStation].meta.position.getLon(), vecSSdata[slope.mainStation].meta.position.getAltitude());
-		sun.setElevationThresh(0.6);
-		vector<ProcessDat> qr_Hdata;     //Hazard data for t=0...tn
-		vector<ProcessInd> qr_Hdata_ind; //Hazard data Index for t=0...tn
-		const double duration = (dateEnd.getJulian() - current_date.getJulian() + 0.5/24)*24*3600; //HACK: why is it computed this way?
-		Hazard hazard(cfg, duration);
-		hazard.initializeHazard(sn_Zdata.drift24, vecXdata.at(0).meta.getSlopeAngle(), qr_Hdata, qr_Hdata_ind);
-
-		prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Start simulation for %s on %s",
-			vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO_TZ).c_str());
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "End date specified by user: %s",
-		        dateEnd.toString(mio::Date::ISO_TZ).c_str());
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Integration step length: %f min",
-		        calculation_step_length);
-
-		bool computed_one_timestep = false;
-		double meteo_step_length = -1.;
-		const bool enforce_snow_height = cfg.get("ENFORCE_MEASURED_SNOW_HEIGHTS", "Snowpack");
-
-		//from current_date to dateEnd, if necessary write out meteo forcing
-		if (write_forcing==true) {
-			writeForcing(current_date, dateEnd, calculation_step_length/1440, io);
-			write_forcing = false; //no need to call it again for the other stations
+		meteoRead_timer.stop();
+		editMeteoData(md, variant, thresh_rain);
+		if (!validMeteoData(md, vecStationIDs[i_stn], variant, enforce_snow_height, advective_heat, soil_flux, slope.nSlopes)) {
+			prn_msg(__FILE__, __LINE__, "msg-", current_date, "No valid data for station %s on [%s]",
+			        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+			current_date -= calculation_step_length/1440;
+			break;
 		}
 
-		// START TIME INTEGRATION LOOP
-		do {
-			current_date += calculation_step_length/1440;
-			mn_ctrl.nStep++;
-			mn_ctrl.nAvg++;
-
-			// Get meteo data
-			vector<mio::MeteoData> vecMyMeteo;
-			meteoRead_timer.start();
-			io.getMeteoData(current_date, vecMyMeteo);
-			if(meteo_step_length<0.) {
-				std::stringstream ss2;
-				meteo_step_length = io.getAvgSamplingRate();
-				ss2 << "" << meteo_step_length;
-				cfg.addKey("METEO_STEP_LENGTH", "Snowpack", ss2.str());
-			}
-			meteoRead_timer.stop();
-			editMeteoData(vecMyMeteo[i_stn], variant, thresh_rain);
-			if (!validMeteoData(vecMyMeteo[i_stn], vecStationIDs[i_stn], variant, enforce_snow_height, advective_heat, soil_flux, slope.nSlopes)) {
-				prn_msg(__FILE__, __LINE__, "msg-", current_date, "No valid data for station %s on [%s]",
-				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
-				current_date -= calculation_step_length/1440;
-				break;
-			}
-
-			//determine which outputs will have to be done
-			getOutputControl(mn_ctrl, current_date, vecSSdata[slope.mainStation].profileDate, calculation_step_length,
-			                 tsstart, tsdaysbetween, profstart, profdaysbetween,
-			                 first_backup, backup_days_between);
-			//Radiation data
-			sun.setDate(current_date.getJulian(), current_date.getTimeZone());
-			const double hs_a3hl6 = getHS_last3hours(io, current_date);
-
-			// START LOOP OVER ASPECTS
-			for (unsigned int slope_sequence=0; slope_sequence<slope.nSlopes; slope_sequence++) {
-				double tot_mass_in = 0.; // To check mass balance over one CALCULATION_STEP_LENGTH if MASS_BALANCE is set
+		//determine which outputs will have to be done
+		getOutputControl(mn_ctrl, current_date, vecSSdata[slope.mainStation].profileDate, calculation_step_length,
+		                 tsstart, tsdaysbetween, profstart, profdaysbetween,
+		                 first_backup, backup_days_between);
+		//Radiation data
+		sun.setDate(current_date.getJulian(), current_date.getTimeZone());
+		const double hs_a3hl6 = forcing.getHS_last3hours(current_date);
+
+		// START LOOP OVER ASPECTS
+		// independent virtual slopes are all computed once the main station is done, their outputs are then written in sequence
+		const bool technical_snow = (md.param_exists("PSUM_TECH") && md("PSUM_TECH") > 0.); //it uses the cumulated precipitation left by the previous slope
+		const bool schedule_slopes = independent_slopes && !technical_snow;
+		vector<SlopeStep> slope_steps;
+		for (unsigned int slope_sequence=0; slope_sequence<slope.nSlopes; slope_sequence++) {
+			double tot_mass_in = 0.; // To check mass balance over one CALCULATION_STEP_LENGTH if MASS_BALANCE is set
+			if (schedule_slopes && slope_sequence > 0) {
+				if (slope_steps.empty()) {
+					computeVirtualSlopes(slope, Mdata, surfFluxes, sn_Bdata, cumsum.precip, md, vecXdata, cfg, sun,
+					                     lw_in, hs_a3hl6, wind_scaling_factor, variant, grooming, classify_profile, current_date, slope_steps);
+				}
+				SlopeStep& step = slope_steps[slope_sequence-1];
+				slope = step.slope;
+				std::swap(Mdata, step.Mdata);
+				std::swap(surfFluxes, step.surfFluxes);
+				std::swap(sn_Bdata, step.sn_Bdata);
+				tot_mass_in = step.tot_mass_in;
+				vecXdata[slope.sector].ErosionMass = step.erosion_mass; //the lee slope might already have taken it over
+			} else {
 				SnowpackConfig tmpcfg(cfg);
 
 				//fill Snowpack internal structure with forcing data
 				bool iswr_is_net = false;
-				copyMeteoData(vecMyMeteo[i_stn], Mdata, slope.prevailing_wind_dir, wind_scaling_factor, iswr_is_net);
-				Mdata.copySnowTemperatures(vecMyMeteo[i_stn], slope_sequence);
-				Mdata.copySolutes(vecMyMeteo[i_stn], SnowStation::number_of_solutes);
+				copyMeteoData(md, Mdata, slope.prevailing_wind_dir, wind_scaling_factor, iswr_is_net);
+				Mdata.copySnowTemperatures(md, slope_sequence);
+				Mdata.copySolutes(md, SnowStation::number_of_solutes);
 				slope.setSlope(slope_sequence, vecXdata, Mdata.dw_drift);
 				dataForCurrentTimeStep(Mdata, surfFluxes, vecXdata, slope, tmpcfg,
                                        sun, cumsum.precip, lw_in, hs_a3hl6,
@@ -1185,270 +1492,479 @@ inline void real_main (int argc, char *argv[])
 					snowpack.snowPreparation(current_date, vecXdata[slope.sector] );
 
 				stability.checkStability(Mdata, vecXdata[slope.sector]);
-
-				/***** OUTPUT SECTION *****/
 				surfFluxes.collectSurfaceFluxes(sn_Bdata, vecXdata[slope.sector], Mdata);
-				if (slope.sector == slope.mainStation) { // main station only (usually flat field)
-					// Calculate consistent lw_in for virtual slopes
-					if ( vecXdata[slope.mainStation].getNumberOfElements() > 0 ) {
-						double k_eff, gradT;
-						k_eff =
-						    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].k[TEMPERATURE];
-						gradT =
-						    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].gradT;
-						lw_in = k_eff*gradT + sn_Bdata.lw_out - sn_Bdata.qs - sn_Bdata.ql - sn_Bdata.qr;
+			}
+
+			/***** OUTPUT SECTION *****/
+			if (slope.sector == slope.mainStation) { // main station only (usually flat field)
+				// Calculate consistent lw_in for virtual slopes
+				if ( vecXdata[slope.mainStation].getNumberOfElements() > 0 ) {
+					double k_eff, gradT;
+					k_eff =
+					    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].k[TEMPERATURE];
+					gradT =
+					    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].gradT;
+					lw_in = k_eff*gradT + sn_Bdata.lw_out - sn_Bdata.qs - sn_Bdata.ql - sn_Bdata.qr;
+				} else {
+					lw_in = Constants::undefined;
+				}
+				// Deal with new snow densities
+				if (vecXdata[slope.mainStation].hn > 0.) {
+					surfFluxes.cRho_hn = vecXdata[slope.mainStation].rho_hn;
+					surfFluxes.mRho_hn = Mdata.rho_hn;
+				}
+				if (slope.snow_erosion != "NONE") {
+					// Update drifting snow index (VI24),
+					//   from erosion at the main station only if no virtual slopes are available
+					if (slope.mainStationDriftIndex)
+						cumulate(cumsum.drift, surfFluxes.drift);
+					// Update erosion mass from main station
+					// NOTE cumsum.erosion[] will be positive in case of real erosion at any time during the output time step
+					if (vecXdata[slope.mainStation].ErosionMass > Constants::eps) {
+						// Real erosion
+						if (cumsum.erosion[slope.mainStation] > Constants::eps) {
+							cumsum.erosion[slope.mainStation] += vecXdata[slope.mainStation].ErosionMass;
+							cumsum.erosion_length[slope.mainStation] += vecXdata[slope.mainStation].ErosionLength;
+						} else {
+							cumsum.erosion[slope.mainStation] = vecXdata[slope.mainStation].ErosionMass;
+							cumsum.erosion_length[slope.mainStation] = vecXdata[slope.mainStation].ErosionLength;
+						}
 					} else {
-						lw_in = Constants::undefined;
+						// Potential erosion at main station only
+						if (cumsum.erosion[slope.mainStation] < -Constants::eps)
+							cumsum.erosion[slope.mainStation] -= surfFluxes.mass[SurfaceFluxes::MS_WIND];
+						else if (!(cumsum.erosion[slope.mainStation] > Constants::eps))
+							cumsum.erosion[slope.mainStation] = -surfFluxes.mass[SurfaceFluxes::MS_WIND];
 					}
-					// Deal with new snow densities
-					if (vecXdata[slope.mainStation].hn > 0.) {
-						surfFluxes.cRho_hn = vecXdata[slope.mainStation].rho_hn;
-						surfFluxes.mRho_hn = Mdata.rho_hn;
+					cumsum.redeposition[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit * vecXdata[slope.mainStation].rho_hn_redeposit;
+					cumsum.redeposition_length[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit;
+				}
+				const size_t i_hz = mn_ctrl.HzStep;
+				if (mode == "OPERATIONAL") {
+					if (!cumsum_mass) { // Cumulate flat field runoff in operational mode
+						qr_Hdata.at(i_hz).runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
+						cumsum.runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
 					}
-					if (slope.snow_erosion != "NONE") {
-						// Update drifting snow index (VI24),
-						//   from erosion at the main station only if no virtual slopes are available
-						if (slope.mainStationDriftIndex)
-							cumulate(cumsum.drift, surfFluxes.drift);
-						// Update erosion mass from main station
-						// NOTE cumsum.erosion[] will be positive in case of real erosion at any time during the output time step
-						if (vecXdata[slope.mainStation].ErosionMass > Constants::eps) {
-							// Real erosion
-							if (cumsum.erosion[slope.mainStation] > Constants::eps) {
-								cumsum.erosion[slope.mainStation] += vecXdata[slope.mainStation].ErosionMass;
-								cumsum.erosion_length[slope.mainStation] += vecXdata[slope.mainStation].ErosionLength;
-							} else {
-								cumsum.erosion[slope.mainStation] = vecXdata[slope.mainStation].ErosionMass;
-								cumsum.erosion_length[slope.mainStation] = vecXdata[slope.mainStation].ErosionLength;
-							}
+					/*
+					 * Snow depth and mass corrections (deflate-inflate):
+					 *   Monitor snow depth discrepancy assumed to be due to ...
+					 *   ... wrong settling, which in turn is assumed to be due to a wrong estimation ...
+					 *   of fresh snow mass because Michi spent many painful days calibrating the settling ...
+					 *   and therefore it can't be wrong, dixunt Michi and Charles.
+					 */
+					const double cH = vecXdata[slope.mainStation].cH - vecXdata[slope.mainStation].Ground;
+					const double mH = vecXdata[slope.mainStation].mH - vecXdata[slope.mainStation].Ground;
+					// Look for missed erosion or not strong enough settling ...
+					// ... and nastily deep "dips" caused by buggy data ...
+					if (time_count_deltaHS > -Constants::eps2) {
+						if ((mH + 0.01) < cH) {
+							time_count_deltaHS += S_TO_D(sn_dt);
 						} else {
-							// Potential erosion at main station only
-							if (cumsum.erosion[slope.mainStation] < -Constants::eps)
-								cumsum.erosion[slope.mainStation] -= surfFluxes.mass[SurfaceFluxes::MS_WIND];
-							else if (!(cumsum.erosion[slope.mainStation] > Constants::eps))
-								cumsum.erosion[slope.mainStation] = -surfFluxes.mass[SurfaceFluxes::MS_WIND];
-						}
-						cumsum.redeposition[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit * vecXdata[slope.mainStation].rho_hn_redeposit;
-						cumsum.redeposition_length[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit;
-					}
-					const size_t i_hz = mn_ctrl.HzStep;
-					if (mode == "OPERATIONAL") {
-						if (!cumsum_mass) { // Cumulate flat field runoff in operational mode
-							qr_Hdata.at(i_hz).runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
-							cumsum.runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
-						}
-						/*
-						 * Snow depth and mass corrections (deflate-inflate):
-						 *   Monitor snow depth discrepancy assumed to be due to ...
-						 *   ... wrong settling, which in turn is assumed to be due to a wrong estimation ...
-						 *   of fresh snow mass because Michi spent many painful days calibrating the settling ...
-						 *   and therefore it can't be wrong, dixunt Michi and Charles.
-						 */
-						const double cH = vecXdata[slope.mainStation].cH - vecXdata[slope.mainStation].Ground;
-						const double mH = vecXdata[slope.mainStation].mH - vecXdata[slope.mainStation].Ground;
-						// Look for missed erosion or not strong enough settling ...
-						// ... and nastily deep "dips" caused by buggy data ...
-						if (time_count_deltaHS > -Constants::eps2) {
-							if ((mH + 0.01) < cH) {
-								time_count_deltaHS += S_TO_D(sn_dt);
-							} else {
-								time_count_deltaHS = 0.;
-							}
-						}
-						// ... or too strong settling
-						if (time_count_deltaHS < Constants::eps2) {
-							if ((mH - 0.01) > cH) {
-								time_count_deltaHS -= S_TO_D(sn_dt);
-							} else {
-								time_count_deltaHS = 0.;
-							}
-						}
-						// If the error persisted for at least one day => apply correction
-						if (enforce_snow_height && (fabs(time_count_deltaHS) > (1. - 0.05 * M_TO_D(calculation_step_length)))) {
-							deflateInflate(Mdata, vecXdata[slope.mainStation],
-							               qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr);
-							if (prn_check) {
-								prn_msg(__FILE__, __LINE__, "msg+", Mdata.date,
-								        "InflDefl (i_hz=%u): dhs=%f, dmass=%f, counter=%f",
-								        i_hz, qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr,
-								        time_count_deltaHS);
-							}
 							time_count_deltaHS = 0.;
 						}
 					}
-					if (mn_ctrl.HzDump) { // Save hazard data ...
-						qr_Hdata.at(i_hz).stat_abbrev = vecStationIDs[i_stn];
-						if (mode == "OPERATIONAL") {
-							qr_Hdata.at(i_hz).loc_for_snow = (unsigned char)vecStationIDs[i_stn][vecStationIDs[i_stn].length()-1];
-							//TODO: WHAT SHOULD WE SET HERE? wstat_abk (not existing yet in DB) and wstao_nr, of course;-)
-							qr_Hdata_ind.at(i_hz).loc_for_wind = -1;
+					// ... or too strong settling
+					if (time_count_deltaHS < Constants::eps2) {
+						if ((mH - 0.01) > cH) {
+							time_count_deltaHS -= S_TO_D(sn_dt);
 						} else {
-							qr_Hdata.at(i_hz).loc_for_snow = 2;
-							qr_Hdata.at(i_hz).loc_for_wind = 1;
-						}
-						hazard.getHazardDataMainStation(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
-						                                sn_Zdata, cumsum.drift, slope.mainStationDriftIndex,
-						                                vecXdata[slope.mainStation], Mdata, surfFluxes);
-						if (slope.nSlopes==1) { //only one slope, so set lwi_N and lwi_S to the same value
-							const double lwi = vecXdata[slope.mainStation].getLiquidWaterIndex();
-							if ((lwi < -Constants::eps) || (lwi >= 10.))
-								qr_Hdata_ind.at(i_hz).lwi_N = qr_Hdata_ind.at(i_hz).lwi_S = false;
-							qr_Hdata.at(i_hz).lwi_N = lwi;
-							qr_Hdata.at(i_hz).lwi_S = lwi;
+							time_count_deltaHS = 0.;
 						}
-						mn_ctrl.HzStep++;
-						if (slope.mainStationDriftIndex)
-							cumsum.drift = 0.;
-						surfFluxes.hoar = 0.;
 					}
-					// New snow water equivalent (kg m-2), rain was dealt with in Watertransport.cc
-					surfFluxes.mass[SurfaceFluxes::MS_HNW] += vecXdata[slope.mainStation].hn
-					                                              * vecXdata[slope.mainStation].rho_hn;
-					if (!avgsum_time_series) { // Sum up precipitations
-						cumsum.rain += surfFluxes.mass[SurfaceFluxes::MS_RAIN];
-						cumsum.snow += surfFluxes.mass[SurfaceFluxes::MS_HNW];
+					// If the error persisted for at least one day => apply correction
+					if (enforce_snow_height && (fabs(time_count_deltaHS) > (1. - 0.05 * M_TO_D(calculation_step_length)))) {
+						deflateInflate(Mdata, vecXdata[slope.mainStation],
+						               qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr);
+						if (prn_check) {
+							prn_msg(__FILE__, __LINE__, "msg+", Mdata.date,
+							        "InflDefl (i_hz=%u): dhs=%f, dmass=%f, counter=%f",
+							        i_hz, qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr,
+							        time_count_deltaHS);
+						}
+						time_count_deltaHS = 0.;
 					}
-				} else {
-					const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep-1 : 0;
-					if (slope.luvDriftIndex) {
-						// Update drifting snow index (VI24),
-						// considering only snow eroded from the windward slope
-						cumulate(cumsum.drift, surfFluxes.drift);
+				}
+				if (mn_ctrl.HzDump) { // Save hazard data ...
+					qr_Hdata.at(i_hz).stat_abbrev = vecStationIDs[i_stn];
+					if (mode == "OPERATIONAL") {
+						qr_Hdata.at(i_hz).loc_for_snow = (unsigned char)vecStationIDs[i_stn][vecStationIDs[i_stn].length()-1];
+						//TODO: WHAT SHOULD WE SET HERE? wstat_abk (not existing yet in DB) and wstao_nr, of course;-)
+						qr_Hdata_ind.at(i_hz).loc_for_wind = -1;
+					} else {
+						qr_Hdata.at(i_hz).loc_for_snow = 2;
+						qr_Hdata.at(i_hz).loc_for_wind = 1;
 					}
-					if (mn_ctrl.HzDump) {
-						// NOTE qr_Hdata was first saved at the end of the mainStation simulation, at which time the drift index could not be dumped!
-						hazard.getHazardDataSlope(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
-						                          sn_Zdata.drift24, cumsum.drift, vecXdata[slope.sector],
-						                          slope.luvDriftIndex, slope.north, slope.south);
-						if(slope.luvDriftIndex) cumsum.drift = 0.;
+					hazard.getHazardDataMainStation(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
+					                                sn_Zdata, cumsum.drift, slope.mainStationDriftIndex,
+					                                vecXdata[slope.mainStation], Mdata, surfFluxes);
+					if (slope.nSlopes==1) { //only one slope, so set lwi_N and lwi_S to the same value
+						const double lwi = vecXdata[slope.mainStation].getLiquidWaterIndex();
+						if ((lwi < -Constants::eps) || (lwi >= 10.))
+							qr_Hdata_ind.at(i_hz).lwi_N = qr_Hdata_ind.at(i_hz).lwi_S = false;
+						qr_Hdata.at(i_hz).lwi_N = lwi;
+						qr_Hdata.at(i_hz).lwi_S = lwi;
 					}
-
-					// Update erosion mass from windward virtual slope
-					cumsum.erosion[slope.sector] += vecXdata[slope.sector].ErosionMass;
-					cumsum.erosion_length[slope.sector] += vecXdata[slope.sector].ErosionLength;
+					mn_ctrl.HzStep++;
+					if (slope.mainStationDriftIndex)
+						cumsum.drift = 0.;
+					surfFluxes.hoar = 0.;
+				}
+				// New snow water equivalent (kg m-2), rain was dealt with in Watertransport.cc
+				surfFluxes.mass[SurfaceFluxes::MS_HNW] += vecXdata[slope.mainStation].hn
+				                                              * vecXdata[slope.mainStation].rho_hn;
+				if (!avgsum_time_series) { // Sum up precipitations
+					cumsum.rain += surfFluxes.mass[SurfaceFluxes::MS_RAIN];
+					cumsum.snow += surfFluxes.mass[SurfaceFluxes::MS_HNW];
+				}
+			} else {
+				const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep-1 : 0;
+				if (slope.luvDriftIndex) {
+					// Update drifting snow index (VI24),
+					// considering only snow eroded from the windward slope
+					cumulate(cumsum.drift, surfFluxes.drift);
+				}
+				if (mn_ctrl.HzDump) {
+					// NOTE qr_Hdata was first saved at the end of the mainStation simulation, at which time the drift index could not be dumped!
+					hazard.getHazardDataSlope(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
+					                          sn_Zdata.drift24, cumsum.drift, vecXdata[slope.sector],
+					                          slope.luvDriftIndex, slope.north, slope.south);
+					if(slope.luvDriftIndex) cumsum.drift = 0.;
 				}
 
-				// TIME SERIES (*.met)
-				if (tswrite && mn_ctrl.TsDump) {
-					// Average fluxes
-					if (avgsum_time_series) {
-						averageFluxTimeSeries(mn_ctrl.nAvg, useCanopyModel, surfFluxes, vecXdata[slope.sector]);
-					} else {
-						surfFluxes.mass[SurfaceFluxes::MS_RAIN] = cumsum.rain;
-						surfFluxes.mass[SurfaceFluxes::MS_HNW] = cumsum.snow;
-						// Add eroded snow from luv to precipitations on lee slope
-						if (slope.sector == slope.lee && cumsum.erosion[slope.luv] > Constants::eps)
-							surfFluxes.mass[SurfaceFluxes::MS_HNW] += cumsum.erosion[slope.luv] / vecXdata[slope.luv].cos_sl;
-					}
+				// Update erosion mass from windward virtual slope
+				cumsum.erosion[slope.sector] += vecXdata[slope.sector].ErosionMass;
+				cumsum.erosion_length[slope.sector] += vecXdata[slope.sector].ErosionLength;
+			}
 
-					if (precip_rates) { // Precip rates in kg m-2 h-1
-						surfFluxes.mass[SurfaceFluxes::MS_RAIN] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-						surfFluxes.mass[SurfaceFluxes::MS_HNW] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-						if ((mode == "OPERATIONAL") && (!cumsum_mass)) {
-							surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] = cumsum.runoff;
-							surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-							cumsum.runoff = 0.;
-						}
+			// TIME SERIES (*.met)
+			if (tswrite && mn_ctrl.TsDump) {
+				// Average fluxes
+				if (avgsum_time_series) {
+					averageFluxTimeSeries(mn_ctrl.nAvg, useCanopyModel, surfFluxes, vecXdata[slope.sector]);
+				} else {
+					surfFluxes.mass[SurfaceFluxes::MS_RAIN] = cumsum.rain;
+					surfFluxes.mass[SurfaceFluxes::MS_HNW] = cumsum.snow;
+					// Add eroded snow from luv to precipitations on lee slope
+					if (slope.sector == slope.lee && cumsum.erosion[slope.luv] > Constants::eps)
+						surfFluxes.mass[SurfaceFluxes::MS_HNW] += cumsum.erosion[slope.luv] / vecXdata[slope.luv].cos_sl;
+				}
+
+				if (precip_rates) { // Precip rates in kg m-2 h-1
+					surfFluxes.mass[SurfaceFluxes::MS_RAIN] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+					surfFluxes.mass[SurfaceFluxes::MS_HNW] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+					if ((mode == "OPERATIONAL") && (!cumsum_mass)) {
+						surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] = cumsum.runoff;
+						surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+						cumsum.runoff = 0.;
 					}
+				}
 
-					// Erosion mass rate in kg m-2 h-1
-					surfFluxes.mass[SurfaceFluxes::MS_WIND] = cumsum.erosion[slope.sector];
-					surfFluxes.mass[SurfaceFluxes::MS_WIND] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+				// Erosion mass rate in kg m-2 h-1
+				surfFluxes.mass[SurfaceFluxes::MS_WIND] = cumsum.erosion[slope.sector];
+				surfFluxes.mass[SurfaceFluxes::MS_WIND] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
 
-					// REDEPOSIT mode variables:
-					if (cumsum.erosion_length[slope.sector] != 0. && cumsum.redeposition_length[slope.sector] != 0.) {
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = cumsum.redeposition[slope.sector]/cumsum.redeposition_length[slope.sector] + cumsum.erosion[slope.sector]/cumsum.erosion_length[slope.sector];
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = cumsum.redeposition_length[slope.sector] + cumsum.erosion_length[slope.sector];
-					} else {
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = IOUtils::nodata;
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = IOUtils::nodata;
-					}
+				// REDEPOSIT mode variables:
+				if (cumsum.erosion_length[slope.sector] != 0. && cumsum.redeposition_length[slope.sector] != 0.) {
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = cumsum.redeposition[slope.sector]/cumsum.redeposition_length[slope.sector] + cumsum.erosion[slope.sector]/cumsum.erosion_length[slope.sector];
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = cumsum.redeposition_length[slope.sector] + cumsum.erosion_length[slope.sector];
+				} else {
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = IOUtils::nodata;
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = IOUtils::nodata;
+				}
 
-					// Dump
-					const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep - 1 : 0;
-					size_t i_hz0 = (mn_ctrl.HzStep > 1) ? mn_ctrl.HzStep - 2 : 0;
-					if (slope.mainStationDriftIndex)
-						i_hz0 = i_hz;
-					const double wind_trans24 = (slope.sector == slope.mainStation) ? qr_Hdata.at(i_hz0).wind_trans24 : qr_Hdata.at(i_hz).wind_trans24;
+				// Dump
+				const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep - 1 : 0;
+				size_t i_hz0 = (mn_ctrl.HzStep > 1) ? mn_ctrl.HzStep - 2 : 0;
+				if (slope.mainStationDriftIndex)
+					i_hz0 = i_hz;
+				const double wind_trans24 = (slope.sector == slope.mainStation) ? qr_Hdata.at(i_hz0).wind_trans24 : qr_Hdata.at(i_hz).wind_trans24;
+				if (write_outputs)
 					snowpackio.writeTimeSeries(vecXdata[slope.sector], surfFluxes, Mdata,
 					                           qr_Hdata.at(i_hz), wind_trans24);
 
-					if (avgsum_time_series) {
-						surfFluxes.reset(cumsum_mass);
-						if (useCanopyModel) vecXdata[slope.sector].Cdata.reset(cumsum_mass);
-					}
-					surfFluxes.cRho_hn = Constants::undefined;
-					surfFluxes.mRho_hn = Constants::undefined;
-					// reset cumulative variables
-					if (slope_sequence == slope.nSlopes-1) {
-						cumsum.erosion.assign(cumsum.erosion.size(), 0.);
-						cumsum.erosion_length.assign(cumsum.erosion_length.size(), 0.);
-						cumsum.redeposition.assign(cumsum.redeposition.size(), 0.);
-						cumsum.redeposition_length.assign(cumsum.redeposition_length.size(), 0.);
-						cumsum.rain = cumsum.snow = 0.;
-						mn_ctrl.nAvg = 0;
-					}
+				if (avgsum_time_series) {
+					surfFluxes.reset(cumsum_mass);
+					if (useCanopyModel) vecXdata[slope.sector].Cdata.reset(cumsum_mass);
 				}
-
-				// SNOW PROFILES ...
-				// ... for visualization (*.pro), etc. (*.prf)
-				if (profwrite && mn_ctrl.PrDump)
-					snowpackio.writeProfile(current_date, vecXdata[slope.sector]);
-
-				// ... backup Xdata (*.sno<JulianDate>)
-				if (mn_ctrl.XdataDump) {
-					std::stringstream ss;
-					ss << "" << vecStationIDs[i_stn];
-					if (slope.sector != slope.mainStation) ss << "" << slope.sector;
-					snowpackio.writeSnowCover(current_date, vecXdata[slope.sector], sn_Zdata, (label_snow)?(2):(1));
-					prn_msg(__FILE__, __LINE__, "msg", current_date,
-					        "Backup Xdata dumped for station %s [%.2f days, step %d]", ss.str().c_str(),
-					        (current_date.getJulian()
-					            - (vecSSdata[slope.mainStation].profileDate.getJulian() + 0.5/24)),
-					        mn_ctrl.nStep);
+				surfFluxes.cRho_hn = Constants::undefined;
+				surfFluxes.mRho_hn = Constants::undefined;
+				// reset cumulative variables
+				if (slope_sequence == slope.nSlopes-1) {
+					cumsum.erosion.assign(cumsum.erosion.size(), 0.);
+					cumsum.erosion_length.assign(cumsum.erosion_length.size(), 0.);
+					cumsum.redeposition.assign(cumsum.redeposition.size(), 0.);
+					cumsum.redeposition_length.assign(cumsum.redeposition_length.size(), 0.);
+					cumsum.rain = cumsum.snow = 0.;
+					mn_ctrl.nAvg = 0;
 				}
+			}
 
-				// check mass balance if AVGSUM_TIME_SERIES is not set (screen output only)
-				if (!avgsum_time_series) {
-					const bool mass_balance = cfg.get("MASS_BALANCE", "SnowpackAdvanced");
-					if (mass_balance) {
-						if (massBalanceCheck(vecXdata[slope.sector], surfFluxes, tot_mass_in) == false)
-							prn_msg(__FILE__, __LINE__, "msg+", current_date, "Mass error at end of time step!");
-					}
-				}
-			} //end loop on slopes
-			computed_one_timestep = true;
-		} while ((dateEnd.getJulian() - current_date.getJulian()) > calculation_step_length/(2.*1440));
-		//end loop on timesteps
-
-		// If the simulation run for at least one time step,
-		//   dump the PROFILEs (Xdata) for every station referred to as sector where sector 0 corresponds to the main station
-		if (computed_one_timestep && snow_write) {
-			for (size_t sector=slope.mainStation; sector<slope.nSlopes; sector++) {
-				if ((mode == "OPERATIONAL") && (sector == slope.mainStation)) {
-					// Operational mode ONLY: dump snow depth discrepancy time counter
-					vecXdata[slope.mainStation].TimeCountDeltaHS = time_count_deltaHS;
-				}
-				snowpackio.writeSnowCover(current_date, vecXdata[sector], sn_Zdata);
-				if (sector == slope.mainStation) {
-					prn_msg(__FILE__, __LINE__, "msg", mio::Date(),
-					        "Writing data to sno file(s) for %s (station %s) on %s",
-					        vecSSdata[slope.mainStation].meta.getStationName().c_str(),
-					        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+			// SNOW PROFILES ...
+			// ... for visualization (*.pro), etc. (*.prf)
+			if (write_outputs && profwrite && mn_ctrl.PrDump)
+				snowpackio.writeProfile(current_date, vecXdata[slope.sector]);
+
+			// ... backup Xdata (*.sno<JulianDate>)
+			if (write_outputs && mn_ctrl.XdataDump) {
+				std::stringstream ss;
+				ss << "" << vecStationIDs[i_stn];
+				if (slope.sector != slope.mainStation) ss << "" << slope.sector;
+				snowpackio.writeSnowCover(current_date, vecXdata[slope.sector], sn_Zdata, (label_snow)?(2):(1));
+				prn_msg(__FILE__, __LINE__, "msg", current_date,
+				        "Backup Xdata dumped for station %s [%.2f days, step %d]", ss.str().c_str(),
+				        (current_date.getJulian()
+				            - (vecSSdata[slope.mainStation].profileDate.getJulian() + 0.5/24)),
+				        mn_ctrl.nStep);
+			}
+
+			// check mass balance if AVGSUM_TIME_SERIES is not set (screen output only)
+			if (!avgsum_time_series) {
+				const bool mass_balance = cfg.get("MASS_BALANCE", "SnowpackAdvanced");
+				if (mass_balance) {
+					if (massBalanceCheck(vecXdata[slope.sector], surfFluxes, tot_mass_in) == false)
+						prn_msg(__FILE__, __LINE__, "msg+", current_date, "Mass error at end of time step!");
 				}
 			}
-			// Dump time series to snowpack.ams_pmod@SDBx (hazard data)
-			if (mn_ctrl.sdbDump) {
-				mio::Timer sdbDump_timer;
-				sdbDump_timer.reset();
-				sdbDump_timer.start();
-				if (snowpackio.writeHazardData(vecStationIDs[i_stn], qr_Hdata, qr_Hdata_ind, mn_ctrl.HzStep)) {
-					sdbDump_timer.stop();
-					prn_msg(__FILE__, __LINE__, "msg-", mio::Date(),
-					        "Finished writing Hdata to SDB for station %s on %s (%lf s)",
-					        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str(), sdbDump_timer.getElapsed());
+			if (schedule_slopes && slope.snow_redistribution && slope_sequence > 0 && slope.sector == slope.luv)
+				vecXdata[slope.luv].ErosionMass = 0.; //as done by the lee slope in the sequential case
+		} //end loop on slopes
+		computed_one_timestep = true;
+	} while ((dateEnd.getJulian() - current_date.getJulian()) > calculation_step_length/(2.*1440));
+	//end loop on timesteps
+
+	// If the simulation run for at least one time step,
+	//   dump the PROFILEs (Xdata) for every station referred to as sector where sector 0 corresponds to the main station
+	if (write_outputs && computed_one_timestep && snow_write) {
+		for (size_t sector=slope.mainStation; sector<slope.nSlopes; sector++) {
+			if ((mode == "OPERATIONAL") && (sector == slope.mainStation)) {
+				// Operational mode ONLY: dump snow depth discrepancy time counter
+				vecXdata[slope.mainStation].TimeCountDeltaHS = time_count_deltaHS;
+			}
+			snowpackio.writeSnowCover(current_date, vecXdata[sector], sn_Zdata);
+			if (sector == slope.mainStation) {
+				prn_msg(__FILE__, __LINE__, "msg", mio::Date(),
+				        "Writing data to sno file(s) for %s (station %s) on %s",
+				        vecSSdata[slope.mainStation].meta.getStationName().c_str(),
+				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+			}
+		}
+		// Dump time series to snowpack.ams_pmod@SDBx (hazard data)
+		if (mn_ctrl.sdbDump) {
+			mio::Timer sdbDump_timer;
+			sdbDump_timer.reset();
+			sdbDump_timer.start();
+			if (snowpackio.writeHazardData(vecStationIDs[i_stn], qr_Hdata, qr_Hdata_ind, mn_ctrl.HzStep)) {
+				sdbDump_timer.stop();
+				prn_msg(__FILE__, __LINE__, "msg-", mio::Date(),
+				        "Finished writing Hdata to SDB for station %s on %s (%lf s)",
+				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str(), sdbDump_timer.getElapsed());
+			}
+		}
+	}
+}
+
+/**
+ * @brief Temperatures of the soil nodes of a station (empty if there are no soil layers)
+ */
+inline std::vector<double> getSoilTemperatures(const SnowStation& Xdata)
+{
+	std::vector<double> temperatures;
+	if (Xdata.SoilNode == 0) return temperatures;
+	for (size_t n=0; n<=Xdata.SoilNode; n++) temperatures.push_back( Xdata.Ndata[n].T );
+	return temperatures;
+}
+
+/**
+ * @brief Spin-up the initial state of a station by cycling over its forcing kept in memory
+ * @details The station is computed over the whole simulation period without writing any output, then the simulation
+ * restarts at the beginning of the period with the state reached at the end of the previous cycle (the deposition
+ * dates of the layers being shifted back by the length of the period). This stops after max_cycles cycles or as soon
+ * as the soil temperatures changed by less than threshold between two cycles.
+ * @param stn initial state of the station, replaced by the spun-up state
+ * @param cfg configuration
+ * @param snowpackio outputs (nothing is written during the spin-up)
+ * @param replay forcing of the station over the simulation period
+ * @param i_stn station index
+ * @param max_cycles maximum number of cycles
+ * @param threshold maximum change of the soil temperatures between two cycles to consider that the equilibrium is reached (K),
+ * 0 to always compute all the cycles
+ */
+inline void spinUp(StationInit& stn, const SnowpackConfig& cfg, SnowpackIO& snowpackio, const ForcingReplay& replay, const size_t& i_stn,
+                   const unsigned int& max_cycles, const double& threshold)
+{
+	const mio::Date start_date( stn.current_date );
+	std::vector<double> prev_temperatures( getSoilTemperatures(stn.vecXdata[stn.slope.mainStation]) );
+
+	for (unsigned int cycle=1; cycle<=max_cycles; cycle++) {
+		SnowpackConfig cycle_cfg(cfg);
+		ForcingSource forcing(replay, Perturbation());
+		mio::Timer cycle_timer;
+		runStation(stn, cycle_cfg, snowpackio, forcing, i_stn, cycle_timer, false);
+
+		//hand the state over to the next cycle
+		const double period = stn.current_date.getJulian() - start_date.getJulian();
+		for (size_t sector=0; sector<stn.vecXdata.size(); sector++) {
+			SnowStation& Xdata = stn.vecXdata[sector];
+			for (size_t e=0; e<Xdata.Edata.size(); e++) Xdata.Edata[e].depositionDate -= period;
+		}
+		stn.current_date = start_date;
+
+		const std::vector<double> temperatures( getSoilTemperatures(stn.vecXdata[stn.slope.mainStation]) );
+		if (temperatures.empty() || temperatures.size() != prev_temperatures.size()) {
+			prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Spin-up cycle %u of %u done for station %s",
+			        cycle, max_cycles, vecStationIDs[i_stn].c_str());
+		} else {
+			double max_change = 0.;
+			for (size_t n=0; n<temperatures.size(); n++)
+				max_change = std::max(max_change, fabs(temperatures[n] - prev_temperatures[n]));
+			prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Spin-up cycle %u of %u done for station %s, soil temperatures changed by up to %.4f K",
+			        cycle, max_cycles, vecStationIDs[i_stn].c_str(), max_change);
+			if (threshold > 0. && max_change < threshold) {
+				prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Equilibrium reached for station %s", vecStationIDs[i_stn].c_str());
+				break;
+			}
+		}
+		prev_temperatures = temperatures;
+	}
+}
+
+// SNOWPACK MAIN **************************************************************
+inline void real_main (int argc, char *argv[])
+{
+	setbuf(stdout, NULL); //always flush stdout
+	setbuf(stderr, NULL); //always flush stderr
+#ifdef DEBUG_ARITHM
+	feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW ); //for halting the process at arithmetic exceptions, see also ReSolver1d
+#endif
+	//parse the command line arguments
+	std::string begin_date_str, end_date_str;
+	parseCmdLine(argc, argv, begin_date_str, end_date_str);
+
+	mio::Timer meteoRead_timer;
+	mio::Timer run_timer;
+	run_timer.start();
+	time_t nowSRT = time(NULL);
+
+	SnowpackConfig cfg(cfgfile);
+	addSpecialKeys(cfg);
+
+	const double i_time_zone = cfg.get("TIME_ZONE", "Input"); //get user provided input time_zone
+	if (!begin_date_str.empty()) {
+		mio::IOUtils::convertString(dateBegin, begin_date_str, i_time_zone);
+	}
+	if (end_date_str == "NOW") { //interpret user provided end date
+		dateEnd.setFromSys();
+		dateEnd.setTimeZone(i_time_zone);
+		dateEnd.rnd(1800, mio::Date::DOWN);
+	} else {
+		mio::IOUtils::convertString(dateEnd, end_date_str, i_time_zone);
+	}
+
+	const std::string experiment = cfg.get("EXPERIMENT", "Output");
+	const std::string outpath = cfg.get("METEOPATH", "Output");
+	const double calculation_step_length = cfg.get("CALCULATION_STEP_LENGTH", "Snowpack");
+
+	int nSolutes = Constants::iundefined;
+	cfg.getValue("NUMBER_OF_SOLUTES", "Input", nSolutes, mio::IOUtils::nothrow);
+	if (nSolutes > 0) SnowStation::number_of_solutes = static_cast<short unsigned int>(nSolutes);
+
+	unsigned int nMembers = 0; //when set, this runs as many ensemble members for each station
+	cfg.getValue("NUMBER_OF_MEMBERS", "Ensemble", nMembers, mio::IOUtils::nothrow);
+	if (nMembers > 0 && mode == "OPERATIONAL")
+		throw mio::InvalidArgumentException("The ensemble mode is only available in research mode", AT);
+
+	unsigned int spinup_cycles = 0; //when set, the initial state is spun-up over the simulation period
+	double spinup_threshold = 0.;
+	cfg.getValue("CYCLES", "SpinUp", spinup_cycles, mio::IOUtils::nothrow);
+	cfg.getValue("TEMPERATURE_THRESHOLD", "SpinUp", spinup_threshold, mio::IOUtils::nothrow);
+	if (spinup_cycles > 0 && mode == "OPERATIONAL")
+		throw mio::InvalidArgumentException("The spin-up is only available in research mode", AT);
+
+	//If the user provides the stationIDs - operational use case
+	if (!vecStationIDs.empty()) { //operational use case: stationIDs provided on the command line
+		for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
+			stringstream ss;
+			ss << "STATION" << i_stn+1;
+			cfg.addKey(ss.str(), "Input", vecStationIDs[i_stn]);
+		}
+	}
+
+	SnowpackIO snowpackio(cfg);
+	mio::IOManager io(cfg);
+	io.setMinBufferRequirements(IOUtils::nodata, 1.1); //we require the buffer to contain at least 1.1 day before the current point
+
+	if (vecStationIDs.empty()) { //research use case: stationIDs provided by the available input files
+		vector<StationData> accessible_stations;
+		io.getStationData(dateEnd, accessible_stations); //we are retrieving meta information from MeteoIO
+		for (size_t ii=0; ii<accessible_stations.size(); ii++) {
+			vecStationIDs.push_back( accessible_stations[ii].getStationID() ); //HACK: accessible_stations should be directly used
+		}
+	}
+
+	//now, let's start!
+	printStartInfo(cfg, string(argv[0]));
+
+	// START LOOP OVER ALL STATIONS
+	bool write_forcing = cfg.get("WRITE_PROCESSED_METEO", "Output"); //it will be set to false once it has been done
+	for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
+		cout << endl;
+		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Run on meteo station %s", vecStationIDs[i_stn].c_str());
+		run_timer.reset();
+		meteoRead_timer.reset();
+
+		StationInit stn(cfg);
+		meteoRead_timer.start();
+		if (mode == "OPERATIONAL")
+			cfg.addKey("PERP_TO_SLOPE", "SnowpackAdvanced", "false");
+		const bool read_slope_status = readSlopeMeta(io, snowpackio, cfg, i_stn, stn.slope, stn.current_date, stn.vecSSdata, stn.vecXdata, stn.sn_Zdata, stn.Mdata, stn.wind_scaling_factor, stn.time_count_deltaHS);
+		meteoRead_timer.stop();
+		if (!read_slope_status) continue; //something went wrong, move to the next station
+		if (mode == "RESEARCH" && !restart) stn.current_date -= calculation_step_length/(24.*60.);
+
+		//from current_date to dateEnd, if necessary write out meteo forcing
+		if (write_forcing==true) {
+			writeForcing(stn.current_date, dateEnd, calculation_step_length/1440, io);
+			write_forcing = false; //no need to call it again for the other stations
+		}
+
+		//the forcing is prepared once, then replayed from memory for the spin-up cycles and the members
+		ForcingReplay replay;
+		if (nMembers > 0 || spinup_cycles > 0) {
+			meteoRead_timer.start();
+			readForcingReplay(io, i_stn, stn.current_date, calculation_step_length, replay);
+			meteoRead_timer.stop();
+			if (spinup_cycles > 0)
+				spinUp(stn, cfg, snowpackio, replay, i_stn, spinup_cycles, spinup_threshold);
+		}
+
+		if (nMembers == 0 && spinup_cycles == 0) {
+			ForcingSource forcing(io, i_stn);
+			runStation(stn, cfg, snowpackio, forcing, i_stn, meteoRead_timer);
+		} else if (nMembers == 0) {
+			ForcingSource forcing(replay, Perturbation());
+			runStation(stn, cfg, snowpackio, forcing, i_stn, meteoRead_timer);
+		} else {
+			initSnLawsStaticData(cfg); //shared by all the members
+
+			size_t errCount = 0;
+			#pragma omp parallel for schedule(dynamic, 1) reduction(+: errCount)
+			for (unsigned int member=0; member<nMembers; member++) {
+				// process exceptions in a way that is compatible with openmp
+				try {
+					SnowpackConfig member_cfg(cfg);
+					member_cfg.addKey("EXPERIMENT", "Output", getMemberExperiment(experiment, member));
+					SnowpackIO member_io(member_cfg);
+					StationInit member_stn(stn);
+					ForcingSource forcing(replay, Perturbation(member_cfg, member));
+					mio::Timer member_timer;
+					runStation(member_stn, member_cfg, member_io, forcing, i_stn, member_timer);
+				} catch(const std::exception& e) {
+					++errCount;
+					cout << e.what() << std::endl;
 				}
 			}
+			if (errCount > 0)
+				throw mio::IOException("Computation of the ensemble members failed for station "+vecStationIDs[i_stn], AT);
 		}
 		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Total time to read meteo data : %lf s",
 		        meteoRead_timer.getElapsed());
@@ -1456,6 +1972,10 @@ inline void real_main (int argc, char *argv[])
 		        vecStationIDs[i_stn].c_str(), run_timer.getElapsed());
 	}
 
+#ifdef MIO_TRACING
+	mio::Tracer::writeChromeTrace(outpath + "/trace_" + experiment + ".json");
+	cout << "\n" << mio::Tracer::getSummary();
+#endif
 	time_t nowEND=time(NULL);
 	cout << endl;
 	cout << "[i] []                 STARTED  running SLF " << mode << " Snowpack Model on " << ctime(&nowSRT);
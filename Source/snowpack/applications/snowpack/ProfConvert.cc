@@ -0,0 +1,74 @@
+/*
+ *  SNOWPACK stand-alone
+ *
+ *  Copyright WSL Institute for Snow and Avalanche Research SLF, DAVOS, SWITZERLAND
+*/
+/*  This file is part of Snowpack.
+    Snowpack is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Snowpack is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Snowpack.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <snowpack/libsnowpack.h>
+#include <meteoio/MeteoIO.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace mio;
+
+//Convert profiles time series between the PRO format and the binary PROB format.
+//The direction of the conversion is given by the extension of the input file.
+static void usage(const std::string& programname)
+{
+	cout << "Usage: " << programname << " [-z time_zone] <input file> <output file>\n";
+	cout << "\tConvert a .pro profiles time series into a .prob binary profiles time series, or the other way around\n";
+	cout << "\t-z time_zone: time zone of the dates in the .pro file (default: 0)\n";
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<std::string> files;
+	double time_zone = 0.;
+	for (int ii=1; ii<argc; ii++) {
+		const std::string arg( argv[ii] );
+		if (arg == "-z" && ii+1 < argc) {
+			IOUtils::convertString(time_zone, argv[++ii]);
+		} else if (arg == "-h" || arg == "--help") {
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		} else {
+			files.push_back(arg);
+		}
+	}
+	if (files.size() != 2) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	try {
+		const std::string ext( FileUtils::getExtension(files[0]) );
+		if (ext == "prob") {
+			ProfileStore::toPro(files[0], files[1]);
+		} else if (ext == "pro") {
+			ProfileStore::fromPro(files[0], files[1], time_zone);
+		} else {
+			cerr << "[E] The input file must either be a .pro or a .prob file\n";
+			return EXIT_FAILURE;
+		}
+	} catch (const std::exception& e) {
+		cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
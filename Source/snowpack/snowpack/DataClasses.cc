@@ -27,7 +27,6 @@
 #include <snowpack/Utils.h>
 #include <snowpack/snowpackCore/Canopy.h>
 #include <snowpack/snowpackCore/Metamorphism.h>
-#include <snowpack/snowpackCore/Solver.h>
 #include <snowpack/Laws_sn.h>
 #include <snowpack/snowpackCore/Aggregate.h>
 
@@ -1903,7 +1902,7 @@ SnowStation::SnowStation(const bool i_useCanopyModel, const bool i_useSoilLayers
 	hn_redeposit(0.), rho_hn_redeposit(0.), ErosionLevel(0), ErosionMass(0.), ErosionLength(0.),
 	S_class1(0), S_class2(0), S_d(0.), z_S_d(0.), S_n(0.), z_S_n(0.),
 	S_s(0.), z_S_s(0.), S_4(0.), z_S_4(0.), S_5(0.), z_S_5(0.),
-	Ndata(), Edata(), Kt(NULL), ColdContent(0.), ColdContentSoil(0.), dIntEnergy(0.), dIntEnergySoil(0.), meltFreezeEnergy(0.), meltFreezeEnergySoil(0.), meltMassTot(0.), refreezeMassTot(0.),
+	Ndata(), Edata(), ColdContent(0.), ColdContentSoil(0.), dIntEnergy(0.), dIntEnergySoil(0.), meltFreezeEnergy(0.), meltFreezeEnergySoil(0.), meltMassTot(0.), refreezeMassTot(0.),
 	ReSolver_dt(-1), windward(false),
 	WindScalingFactor(1.), TimeCountDeltaHS(0.),
 	nNodes(0), nElems(0), maxElementID(0), useCanopyModel(i_useCanopyModel), useSoilLayers(i_useSoilLayers), isAlpine3D(i_isAlpine3D)
@@ -1921,7 +1920,7 @@ SnowStation::SnowStation(const SnowStation& c) :
 	hn_redeposit(c.hn_redeposit), rho_hn_redeposit(c.rho_hn_redeposit), ErosionLevel(c.ErosionLevel), ErosionMass(c.ErosionMass), ErosionLength(c.ErosionLength),
 	S_class1(c.S_class1), S_class2(c.S_class2), S_d(c.S_d), z_S_d(c.z_S_d), S_n(c.S_n), z_S_n(c.z_S_n),
 	S_s(c.S_s), z_S_s(c.z_S_s), S_4(c.S_4), z_S_4(c.z_S_4), S_5(c.S_5), z_S_5(c.z_S_5),
-	Ndata(c.Ndata), Edata(c.Edata), Kt(NULL), ColdContent(c.ColdContent), ColdContentSoil(c.ColdContentSoil), dIntEnergy(c.dIntEnergy), dIntEnergySoil(c.dIntEnergySoil), meltFreezeEnergy(c.meltFreezeEnergy), meltFreezeEnergySoil(c.meltFreezeEnergySoil), meltMassTot(c.meltMassTot), refreezeMassTot(c.refreezeMassTot),
+	Ndata(c.Ndata), Edata(c.Edata), ColdContent(c.ColdContent), ColdContentSoil(c.ColdContentSoil), dIntEnergy(c.dIntEnergy), dIntEnergySoil(c.dIntEnergySoil), meltFreezeEnergy(c.meltFreezeEnergy), meltFreezeEnergySoil(c.meltFreezeEnergySoil), meltMassTot(c.meltMassTot), refreezeMassTot(c.refreezeMassTot),
 	ReSolver_dt(-1), windward(c.windward),
 	WindScalingFactor(c.WindScalingFactor), TimeCountDeltaHS(c.TimeCountDeltaHS),
 	nNodes(c.nNodes), nElems(c.nElems), maxElementID(c.maxElementID), useCanopyModel(c.useCanopyModel), useSoilLayers(c.useSoilLayers), isAlpine3D(c.isAlpine3D) {
@@ -1979,7 +1978,6 @@ SnowStation& SnowStation::operator=(const SnowStation& source) {
 		z_S_5 = source.z_S_5;
 		Ndata = source.Ndata;
 		Edata = source.Edata;
-		Kt = NULL;
 		ColdContent = source.ColdContent;
 		ColdContentSoil = source.ColdContentSoil;
 		dIntEnergy = source.dIntEnergy;
@@ -2004,18 +2002,6 @@ SnowStation& SnowStation::operator=(const SnowStation& source) {
 
 SnowStation::~SnowStation()
 {
-	SD_MATRIX_DATA* pMat = (SD_MATRIX_DATA*) Kt;
-
-	if (pMat != NULL) {
-		if ( pMat->State == ConMatrix ){
-			ReleaseConMatrix(&pMat->Mat.Con);
-		} else if ( pMat->State == BlockMatrix  ){
-			ReleaseBlockMatrix(&pMat->Mat.Block);
-		}
-		free(pMat);
-		pMat = NULL;
-	}
-
 	if (Seaice != NULL) {
 		delete Seaice;
 		Seaice = NULL;
@@ -2905,7 +2891,6 @@ std::ostream& operator<<(std::ostream& os, const SnowStation& data)
 	os.write(reinterpret_cast<const char*>(&s_Edata), sizeof(size_t));
 	for (size_t ii=0; ii<s_Edata; ii++) os << data.Edata[ii];
 
-	// void *Kt
 	os.write(reinterpret_cast<const char*>(&data.ColdContent), sizeof(data.ColdContent));
 	os.write(reinterpret_cast<const char*>(&data.ColdContentSoil), sizeof(data.ColdContentSoil));
 	os.write(reinterpret_cast<const char*>(&data.dIntEnergy), sizeof(data.dIntEnergy));
@@ -2942,8 +2927,6 @@ std::ostream& operator<<(std::ostream& os, const SnowStation& data)
 
 std::istream& operator>>(std::istream& is, SnowStation& data)
 {
-	// HACK: nothing is done for the void* Kt
-
 	is >> data.meta;
 	is.read(reinterpret_cast<char*>(&data.cos_sl), sizeof(data.cos_sl));
 	is.read(reinterpret_cast<char*>(&data.sector), sizeof(data.sector));
@@ -2993,8 +2976,6 @@ std::istream& operator>>(std::istream& is, SnowStation& data)
 	data.Edata.resize( s_Edata, ElementData(ElementData::noID) );
 	for (size_t ii=0; ii<s_Edata; ii++) is >> data.Edata[ii];
 
-	data.Kt = NULL;
-
 	is.read(reinterpret_cast<char*>(&data.ColdContent), sizeof(data.ColdContent));
 	is.read(reinterpret_cast<char*>(&data.ColdContentSoil), sizeof(data.ColdContentSoil));
 	is.read(reinterpret_cast<char*>(&data.dIntEnergy), sizeof(data.dIntEnergy));
@@ -3057,10 +3038,6 @@ const std::string SnowStation::toString() const
 	os << "Stability:\tS_d(" << z_S_d << ")=" << S_d << " S_n(" << z_S_n << ")=" << S_n << " S_s(" << z_S_s << ")=" << S_s;
 	os << " S_1=" << S_class1 << " S_2=" << S_class2 << " S_4(" << z_S_4 << ")=" << S_4 << " S_5(" << z_S_5 << ")=" << S_5 << "\n";
 
-	if(Kt==NULL)
-		os << "Kt= NULL\n";
-	else
-		os << "Kt= " << hex << Kt << dec << "\n";
 	/*for (unsigned int ii=1; ii<Ndata.size(); ii++) {
 		os << Ndata[ii].toString();
 	}
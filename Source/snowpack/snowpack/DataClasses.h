@@ -671,7 +671,6 @@ class SnowStation {
 		double z_S_5;               ///< Depth of stab_index5
 		std::vector<NodeData> Ndata;    ///< pointer to nodal data array (e.g. T, z, u, etc..)
 		std::vector<ElementData> Edata; ///< pointer to element data array (e.g. Te, L, Rho, etc..)
-		void *Kt;                   ///< Pointer to pseudo-conductivity and stiffnes matrix
 		double ColdContent;         ///< Cold content of snowpack (J m-2)
 		double ColdContentSoil;     ///< Cold content of soil (J m-2)
 		double dIntEnergy;          ///< Internal energy change of snowpack (J m-2)
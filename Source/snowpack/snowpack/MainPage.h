@@ -466,6 +466,49 @@
  * The %Snowpack_advanced section contains settings that previously required to edit the source code and recompile the model. Since these settings
  * deeply transform the operation of the model, please <b>refrain from using them</b> if you are not absolutely sure of what you are doing.
  *
+ * @section ensemble_cfg Ensemble simulations
+ * In research mode, the stand-alone application can run several members of an ensemble for each station within the same process: the
+ * forcing is read, filtered and resampled only once and the initial snow cover is read only once, each member then running on its
+ * own perturbed copy of the forcing. The members are computed concurrently when %Snowpack has been compiled with OpenMP support and each
+ * member writes its own output files, its experiment name being suffixed by the member number (for example <i>"WFJ2_res_m003.met"</i>).
+ * Please note that the static data of the %Snowpack library (such as the variant dependent parameters of the snow laws) is shared by
+ * all the members: it is initialized before starting the members, which must therefore all use the same VARIANT.
+ * The following keys are read in the [Ensemble] section:
+ *     - NUMBER_OF_MEMBERS: how many members to run for each station (default: 0, no ensemble);
+ *     - CONTROL_MEMBER: if set to true, the first member runs on the unperturbed forcing (default: true);
+ *     - SEED: seed for the random numbers, so the perturbations can be reproduced (default: seeded from the hardware);
+ *     - {param}::PERTURB: either ADD or MULT, the perturbation being added or multiplied to the forcing parameter {param};
+ *     - {param}::DISTRIBUTION: the distribution the perturbations are drawn from, as supported by MeteoIO's RandomNumberGenerator (default: GAUSS);
+ *     - {param}::PARAMETERS: the parameters of this distribution (for UNIFORM, the minimum and maximum values).
+ *
+ * Each member draws one perturbation per parameter that is then applied over the whole simulation period:
+ * @code
+ * [Ensemble]
+ * NUMBER_OF_MEMBERS = 20
+ * SEED = 42
+ * TA::PERTURB = ADD
+ * TA::PARAMETERS = 0 1 ;mean sigma
+ * PSUM::PERTURB = MULT
+ * PSUM::DISTRIBUTION = UNIFORM
+ * PSUM::PARAMETERS = 0.7 1.3
+ * @endcode
+ *
+ * @section spinup_cfg Spin-up
+ * In research mode, the initial state (mostly the soil temperatures) can be spun-up by repeatedly computing the simulation period without
+ * writing any output, each cycle restarting from the state reached at the end of the previous one. The forcing is read, filtered and
+ * resampled only once and then replayed from memory for all the cycles, the production run starting from the spun-up state. The following
+ * keys are read in the [SpinUp] section:
+ *     - CYCLES: maximum number of spin-up cycles (default: 0, no spin-up);
+ *     - TEMPERATURE_THRESHOLD: stop the spin-up as soon as the soil temperatures change by less than this threshold (in K) between two
+ *       cycles (default: 0, always compute all the cycles).
+ *
+ * When combined with the ensemble mode, all the members start from the same spun-up state.
+ * @code
+ * [SpinUp]
+ * CYCLES = 10
+ * TEMPERATURE_THRESHOLD = 0.01
+ * @endcode
+ *
  */
 
 /**
@@ -542,7 +585,6 @@
  * Energy: ColdContent=0 dIntEnergy=0 SubSurfaceMelt=x SubSurfaceFrze=x
  * Snowdrift:      windward=0 ErosionLevel=0 ErosionMass=0
  * Stability:      S_d(0)=0 S_n(0)=0 S_s(0)=0 S_1=0 S_2=0 S_4(0)=0 S_5(0)=0
- * Kt= 0
  * </SnowStation>
  * @endcode
  *
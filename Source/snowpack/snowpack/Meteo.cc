@@ -396,6 +396,7 @@ bool Meteo::compHSrate(CurrentMeteo& Mdata, const SnowStation& Xdata, const doub
 void Meteo::compMeteo(CurrentMeteo &Mdata, SnowStation &Xdata, const bool runCanopyModel,
                      const bool adjust_height_of_wind_value)
 {
+	MIO_TRACE_ZONE("Snowpack", "compMeteo");
 	// adjust_height_of_wind_value should be passed externally in order to allow to change it for each
 	// pixel in Alpine3D
 	bool canopy_status = true;
@@ -23,7 +23,9 @@
 #include <snowpack/Saltation.h>
 #include <snowpack/Constants.h>
 #include <snowpack/Utils.h>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 
 using namespace mio;
 using namespace std;
@@ -59,18 +61,229 @@ const double Saltation::salt_height = 0.07;
  * const double Saltation::z0 = 0.01; //Wind Field Z0 - includes larger surface features
  */
 
+/**
+ * @class SaltationTable
+ * @brief Table of precomputed values of Judith Doorschot's saltation model, shared by all Saltation objects.
+ * The table covers the surface shear stress (logarithmic axis), the threshold shear stress, the slope angle and the grain
+ * size (linear axes). Each node is computed with the exact model the first time it is needed, so only the part of the
+ * parameter space that a simulation actually visits is ever computed. Several threads can query the table at the
+ * same time: a node is only written once, under a lock, and the nodes are always computed the same way so the
+ * results do not depend on which thread computed them.
+ *
+ * The model is not smooth (it switches between weak and strong saltation regimes), so the interpolation error is
+ * checked for each cell of the table when it is first used: the interpolated values at the center of the cell are compared
+ * with the exact model and if they deviate by more than max_rel_error (relative to the exact values or to min_flux / min_cs,
+ * whichever is larger), the cell is flagged and the exact model is used for all the points that fall in it.
+ */
+class SaltationTable {
+	public:
+		SaltationTable();
+
+		bool interpolate(const double& tauS, const double& tau_th, const double& slope_angle, const double& dg,
+		                 double& massflux, double& c_salt);
+
+		static const double max_rel_error; ///< maximum relative deviation from the exact model at the center of the cells
+		static const double min_flux, min_cs; ///< below these values, max_rel_error applies to these values instead
+
+	private:
+		typedef struct TABLE_AXIS {
+			double min, step; ///< first node and distance between nodes (in log space for logarithmic axes)
+			size_t n; ///< number of nodes
+			bool logarithmic;
+		} TableAxis;
+
+		typedef enum CELL_STATE {
+			CELL_UNKNOWN, ///< the cell has not been checked yet
+			CELL_INTERPOLATED, ///< the interpolation is accurate enough in this cell
+			CELL_EXACT ///< the interpolation is not accurate enough in this cell, the exact model must be used
+		} CellState;
+
+		static bool getPosition(const TableAxis& axis, const double& value, size_t& idx, double& weight);
+		static double getAxisValue(const TableAxis& axis, const double& pos);
+		void getNode(const size_t& ii, const size_t& jj, const size_t& kk, const size_t& ll, double& massflux, double& c_salt);
+		void interpolateCell(const size_t idx[], const double weight[], double& massflux, double& c_salt);
+		bool checkCell(const size_t idx[]);
+
+		static const size_t nr_axis = 4;
+		static const TableAxis axis[nr_axis]; //tauS, tau_th, slope_angle, dg
+
+		std::vector<double> node_flux, node_cs;
+		std::unique_ptr< std::atomic<bool>[] > node_ready;
+		std::unique_ptr< std::atomic<int>[] > cell_state;
+		std::mutex node_mutex;
+};
+
+//the surface shear stress covers 0.01 to 2 Pa with 25 nodes
+const SaltationTable::TableAxis SaltationTable::axis[SaltationTable::nr_axis] = {
+	{log(0.01), log(200.)/24., 25, true}, // tauS (Pa)
+	{0.02, 0.04, 13, false}, // tau_th (Pa), up to 0.5 Pa
+	{-60., 10., 13, false}, // slope_angle (deg), from -60 to 60 deg (negative for downwind slopes)
+	{0.0001, 0.0001, 10, false} // dg (m), up to 1 mm
+};
+
+const double SaltationTable::max_rel_error = 0.05;
+const double SaltationTable::min_flux = 1e-4; //kg m-1 s-1
+const double SaltationTable::min_cs = 1e-4; //kg m-3
+
+SaltationTable::SaltationTable()
+               : node_flux(), node_cs(), node_ready(), cell_state(), node_mutex()
+{
+	size_t nr_nodes = 1, nr_cells = 1;
+	for (size_t ii=0; ii<nr_axis; ii++) {
+		nr_nodes *= axis[ii].n;
+		nr_cells *= axis[ii].n - 1;
+	}
+	node_flux.resize(nr_nodes, 0.);
+	node_cs.resize(nr_nodes, 0.);
+	node_ready.reset( new std::atomic<bool>[nr_nodes] );
+	for (size_t ii=0; ii<nr_nodes; ii++) node_ready[ii].store(false);
+	cell_state.reset( new std::atomic<int>[nr_cells] );
+	for (size_t ii=0; ii<nr_cells; ii++) cell_state[ii].store(CELL_UNKNOWN);
+}
+
+/**
+ * @brief Get the lower node and the interpolation weight of the upper node along an axis
+ * @return false if the value is outside of the axis
+ */
+bool SaltationTable::getPosition(const TableAxis& ax, const double& value, size_t& idx, double& weight)
+{
+	if (ax.logarithmic && value <= 0.) return false;
+	const double pos = ((ax.logarithmic? log(value) : value) - ax.min) / ax.step;
+	if (!(pos >= 0.) || pos > static_cast<double>(ax.n - 1)) return false; //this also rejects NaN
+	idx = std::min(static_cast<size_t>(pos), ax.n - 2);
+	weight = pos - static_cast<double>(idx);
+	return true;
+}
+
+/**
+ * @brief Get the physical value at a (possibly fractional) position along an axis
+ */
+double SaltationTable::getAxisValue(const TableAxis& ax, const double& pos)
+{
+	const double value = ax.min + pos * ax.step;
+	return (ax.logarithmic)? exp(value) : value;
+}
+
+void SaltationTable::getNode(const size_t& ii, const size_t& jj, const size_t& kk, const size_t& ll, double& massflux, double& c_salt)
+{
+	const size_t index = ((ii * axis[1].n + jj) * axis[2].n + kk) * axis[3].n + ll;
+	if (!node_ready[index].load(std::memory_order_acquire)) {
+		double flux, cs;
+		Saltation::compDoorschot(getAxisValue(axis[0], static_cast<double>(ii)), getAxisValue(axis[1], static_cast<double>(jj)),
+		                         getAxisValue(axis[2], static_cast<double>(kk)), getAxisValue(axis[3], static_cast<double>(ll)), flux, cs);
+
+		std::lock_guard<std::mutex> lock(node_mutex);
+		if (!node_ready[index].load(std::memory_order_relaxed)) { //another thread might have been faster
+			node_flux[index] = flux;
+			node_cs[index] = cs;
+			node_ready[index].store(true, std::memory_order_release);
+		}
+	}
+	massflux = node_flux[index];
+	c_salt = node_cs[index];
+}
+
+/**
+ * @brief Multilinear interpolation within a cell of the table
+ * @param[in] idx lower node of the cell along each axis
+ * @param[in] weight interpolation weight of the upper node along each axis
+ * @param[out] massflux interpolated mass flux
+ * @param[out] c_salt interpolated saltation concentration
+ */
+void SaltationTable::interpolateCell(const size_t idx[], const double weight[], double& massflux, double& c_salt)
+{
+	massflux = 0.;
+	c_salt = 0.;
+	for (unsigned int corner=0; corner<(1u << nr_axis); corner++) { //loop over the 16 corners of the hypercube
+		double w = 1.;
+		size_t node[nr_axis];
+		for (size_t ii=0; ii<nr_axis; ii++) {
+			const bool upper = ((corner >> ii) & 1u) != 0;
+			node[ii] = idx[ii] + (upper? 1 : 0);
+			w *= (upper)? weight[ii] : 1. - weight[ii];
+		}
+		if (w == 0.) continue; //do not compute nodes that would not contribute
+		double flux, cs;
+		getNode(node[0], node[1], node[2], node[3], flux, cs);
+		massflux += w * flux;
+		c_salt += w * cs;
+	}
+}
+
+/**
+ * @brief Check (once) if the interpolation is accurate enough within a cell of the table
+ * @param[in] idx lower node of the cell along each axis
+ * @return true if the cell can be interpolated, false if the exact model must be used
+ */
+bool SaltationTable::checkCell(const size_t idx[])
+{
+	const size_t index = ((idx[0] * (axis[1].n-1) + idx[1]) * (axis[2].n-1) + idx[2]) * (axis[3].n-1) + idx[3];
+	const int state = cell_state[index].load(std::memory_order_acquire);
+	if (state != CELL_UNKNOWN) return (state == CELL_INTERPOLATED);
+
+	//compare with the exact model at the center of the cell, where the interpolation error is usually the largest
+	const double center[nr_axis] = {.5, .5, .5, .5};
+	double flux, cs;
+	interpolateCell(idx, center, flux, cs);
+	double flux_exact, cs_exact;
+	Saltation::compDoorschot(getAxisValue(axis[0], static_cast<double>(idx[0])+.5), getAxisValue(axis[1], static_cast<double>(idx[1])+.5),
+	                         getAxisValue(axis[2], static_cast<double>(idx[2])+.5), getAxisValue(axis[3], static_cast<double>(idx[3])+.5), flux_exact, cs_exact);
+	const bool accurate = (fabs(flux - flux_exact) <= max_rel_error * std::max(fabs(flux_exact), min_flux))
+	                      && (fabs(cs - cs_exact) <= max_rel_error * std::max(fabs(cs_exact), min_cs));
+
+	//the check is deterministic, so it does not matter if several threads do it at the same time
+	cell_state[index].store((accurate)? CELL_INTERPOLATED : CELL_EXACT, std::memory_order_release);
+	return accurate;
+}
+
+/**
+ * @brief Multilinear interpolation of the mass flux and saltation concentration
+ * @return false if the point is outside of the table or in a cell where the interpolation is not accurate enough
+ */
+bool SaltationTable::interpolate(const double& tauS, const double& tau_th, const double& slope_angle, const double& dg,
+                                 double& massflux, double& c_salt)
+{
+	const double values[nr_axis] = {tauS, tau_th, slope_angle, dg};
+	size_t idx[nr_axis];
+	double weight[nr_axis];
+	for (size_t ii=0; ii<nr_axis; ii++) {
+		if (!getPosition(axis[ii], values[ii], idx[ii], weight[ii])) return false;
+	}
+	if (!checkCell(idx)) return false;
+
+	interpolateCell(idx, weight, massflux, c_salt);
+	return true;
+}
+
 /************************************************************
  * non-static section                                       *
  ************************************************************/
 
-static std::string get_model(const SnowpackConfig& cfg) 
+static Saltation::SALTATION_MODEL get_model(const SnowpackConfig& cfg)
 {
 	std::string model;
 	cfg.getValue("SALTATION_MODEL", "SnowpackAdvanced", model);
-	return model;
+	if (model == "SORENSEN") return Saltation::SORENSEN;
+	if (model == "DOORSCHOT") return Saltation::DOORSCHOT;
+	if (model == "DOORSCHOT_TABLE") return Saltation::DOORSCHOT_TABLE;
+
+	prn_msg(__FILE__, __LINE__, "err", Date(), "Saltation model %s not implemented yet!", model.c_str());
+	throw IOException("The required saltation model is not implemented yet!", AT);
+}
+
+//the table does not depend on the configuration, so a single table is shared by the whole process. This is important
+//since Snowpack creates a new Saltation object at each time step for each pixel.
+static std::shared_ptr<SaltationTable> get_table()
+{
+	static const std::shared_ptr<SaltationTable> table( std::make_shared<SaltationTable>() );
+	return table;
 }
 
-Saltation::Saltation(const SnowpackConfig& cfg) : saltation_model( get_model(cfg) ) {}
+Saltation::Saltation(const SnowpackConfig& cfg)
+          : saltation_model( get_model(cfg) ), table()
+{
+	if (saltation_model == DOORSCHOT_TABLE) table = get_table();
+}
 
 /**
  * @brief Returns the wind profile
@@ -383,6 +596,81 @@ int Saltation::sa_TestSaltation(const double& z0, const double& tauS, const doub
 
 }
 
+/**
+ * @brief Computes the saltation flux with Judith Doorschot's model
+ * @param i_tauS surface shear stress (Pa)
+ * @param tau_th threshold shear stress (Pa)
+ * @param slope_angle (deg)
+ * @param dg grain size (m)
+ * @param massflux saltation mass flux
+ * @param c_salt saltation concentration
+ */
+void Saltation::compDoorschot(const double& i_tauS, const double& tau_th, const double& slope_angle, const double& dg,
+                              double& massflux, double& c_salt)
+{
+	int    k = 5;
+	// Initialize Shear Stress Distribution
+	const double taumean = i_tauS;
+	const double taumax = 15.* i_tauS;
+	const double taustep = (taumax - tau_th) / k;
+	const double Cp = 1. / taumean;
+	double tauA_middle=0.;
+	double flux_mean = 0., cs_mean = 0.;
+
+	for (int j = 0; j < k; j++) {
+		const double tau_j = tau_th + ((double)(j) + 0.5) * taustep;
+		const double tauS = tau_j;
+
+		if(tauS > tau_th) {
+			double ubar = 0., z_lower = 0.;
+			double flux, cs; // What we finally want
+			// First test for large rebound thresholds
+			if (sa_TestSaltation(Saltation::z0_salt, tauS, tauS, slope_angle, dg, tau_th, z_lower, ubar) == Saltation::weak) {
+				sa_AeroEntrain(Saltation::z0_salt, tauS, slope_angle, dg, tau_th, flux, z_lower, ubar, cs);
+			} else {
+				// Use an iterative method to determine the rebound threshold at the ground
+				const double eps = 1e-5;
+				double tauA_right = tauS, tauA_left = 0.;
+				do {
+					tauA_middle = .5 * (tauA_left + tauA_right);
+					if (sa_TestSaltation(Saltation::z0_salt, tauS, tauA_middle, slope_angle,
+								      dg, tau_th, z_lower, ubar) == Saltation::strong) {
+						tauA_right = tauA_middle;
+					} else {
+						tauA_left = tauA_middle;
+					}
+				} while (tauA_right - tauA_left > eps);
+				const double tau_r = tauA_middle;
+
+				/*
+				* Distinguish the different possibilities after Judith and compute
+				* the flux; Start with computation of tau_e: The surface shear stress
+				* for the hypothetical case of aerodynamic entrainment only given a
+				* certain overall shear stress, tauS
+				*/
+				const double tau_e = sa_AeroEntrain(Saltation::z0_salt, tauS, slope_angle, dg, tau_th, flux, z_lower, ubar, cs);
+				if (tau_e < tau_th) {
+					const double tauA = tau_r;
+					flux = sa_MassFlux(Saltation::z0_salt, tauS, tauA, slope_angle, dg, tau_th, z_lower, ubar, cs);
+				} else if (tau_e < tau_r) {
+					//const double tauA = tau_e;
+				} else {
+					const double tauA = tau_r; // Flux computation is wrong, must be redone
+					flux = sa_MassFlux(Saltation::z0_salt, tauS, tauA, slope_angle, dg, tau_th, z_lower, ubar, cs);
+				}
+			} // else large rebound threshold
+			const double Ptau_j = exp(-Cp * (tau_j - 0.5 * taustep)) - exp(-Cp * (tau_j+ 0.5 * taustep));
+			cs_mean += cs * Ptau_j;
+			flux_mean += flux * Ptau_j;
+		} // if there is s.th. to do
+
+	} // for all shear stress classes
+
+	// Fill return Values
+	massflux = flux_mean;
+	c_salt = cs_mean;
+}
+
 /**
  * @brief Computes the saltation flux
  * @note  Sorensen's model is computationally more efficient than Judith Doorschot's
@@ -397,87 +685,28 @@ int Saltation::sa_TestSaltation(const double& z0, const double& tauS, const doub
 bool Saltation::compSaltation(const double& i_tauS, const double& tau_th, const double& slope_angle, const double& dg,
                                   double& massflux, double& c_salt) const
 {
-	if (saltation_model == "SORENSEN") { // Default model
-		// Sorensen
-		const double tauS = i_tauS;
-		const double ustar = sqrt(tauS / Constants::density_air);
-		const double ustar_thresh = sqrt(tau_th / Constants::density_air);
-		if (ustar > ustar_thresh) {
-			massflux = 0.0014 * Constants::density_air * ustar * (ustar - ustar_thresh) * (ustar + 7.6*ustar_thresh + 205.);
-			c_salt = massflux / ustar*0.001; // Arbitrary Scaling to match Doorschot concentration
-		} else {
-			massflux = 0.;
-			c_salt = 0.;
+	switch (saltation_model) {
+		case SORENSEN: { // Default model
+			const double tauS = i_tauS;
+			const double ustar = sqrt(tauS / Constants::density_air);
+			const double ustar_thresh = sqrt(tau_th / Constants::density_air);
+			if (ustar > ustar_thresh) {
+				massflux = 0.0014 * Constants::density_air * ustar * (ustar - ustar_thresh) * (ustar + 7.6*ustar_thresh + 205.);
+				c_salt = massflux / ustar*0.001; // Arbitrary Scaling to match Doorschot concentration
+			} else {
+				massflux = 0.;
+				c_salt = 0.;
+			}
+			break;
 		}
-	}
-	else if (saltation_model == "DOORSCHOT") { // Judith Doorschot's model
-		int    k = 5;
-		// Initialize Shear Stress Distribution
-		const double taumean = i_tauS;
-		const double taumax = 15.* i_tauS;
-		const double taustep = (taumax - tau_th) / k;
-		const double Cp = 1. / taumean;
-		double tauA_middle=0.;
-		double flux_mean = 0., cs_mean = 0.;
-
-		for (int j = 0; j < k; j++) {
-			const double tau_j = tau_th + ((double)(j) + 0.5) * taustep;
-			const double tauS = tau_j;
-
-			if(tauS > tau_th) {
-				double ubar = 0., z_lower = 0.;
-				double flux, cs; // What we finally want
-				// First test for large rebound thresholds
-				if (sa_TestSaltation(Saltation::z0_salt, tauS, tauS, slope_angle, dg, tau_th, z_lower, ubar) == Saltation::weak) {
-					sa_AeroEntrain(Saltation::z0_salt, tauS, slope_angle, dg, tau_th, flux, z_lower, ubar, cs);
-				} else {
-					// Use an iterative method to determine the rebound threshold at the ground
-					const double eps = 1e-5;
-					double tauA_right = tauS, tauA_left = 0.;
-					do {
-						tauA_middle = .5 * (tauA_left + tauA_right);
-						if (sa_TestSaltation(Saltation::z0_salt, tauS, tauA_middle, slope_angle,
-									      dg, tau_th, z_lower, ubar) == Saltation::strong) {
-							tauA_right = tauA_middle;
-						} else {
-							tauA_left = tauA_middle;
-						}
-					} while (tauA_right - tauA_left > eps);
-					const double tau_r = tauA_middle;
-
-					/*
-					* Distinguish the different possibilities after Judith and compute
-					* the flux; Start with computation of tau_e: The surface shear stress
-					* for the hypothetical case of aerodynamic entrainment only given a
-					* certain overall shear stress, tauS
-					*/
-					const double tau_e = sa_AeroEntrain(Saltation::z0_salt, tauS, slope_angle, dg, tau_th, flux, z_lower, ubar, cs);
-					if (tau_e < tau_th) {
-						const double tauA = tau_r;
-						flux = sa_MassFlux(Saltation::z0_salt, tauS, tauA, slope_angle, dg, tau_th, z_lower, ubar, cs);
-					} else if (tau_e < tau_r) {
-						//const double tauA = tau_e;
-					} else {
-						const double tauA = tau_r; // Flux computation is wrong, must be redone
-						flux = sa_MassFlux(Saltation::z0_salt, tauS, tauA, slope_angle, dg, tau_th, z_lower, ubar, cs);
-					}
-				} // else large rebound threshold
-				const double Ptau_j = exp(-Cp * (tau_j - 0.5 * taustep)) - exp(-Cp * (tau_j+ 0.5 * taustep));
-				cs_mean += cs * Ptau_j;
-				flux_mean += flux * Ptau_j;
-			} // if there is s.th. to do
-
-		} // for all shear stress classes
-
-		// Fill return Values
-		massflux = flux_mean;
-		c_salt = cs_mean;
-	}
-	else {
-		prn_msg(__FILE__, __LINE__, "err", Date(), "Saltation model %s not implemented yet!", saltation_model.c_str());
-		throw IOException("The required saltation model is not implemented yet!", AT);
+		case DOORSCHOT_TABLE: // Judith Doorschot's model, tabulated
+			if (table->interpolate(i_tauS, tau_th, slope_angle, dg, massflux, c_salt)) break;
+			compDoorschot(i_tauS, tau_th, slope_angle, dg, massflux, c_salt); //outside of the table or not accurate enough
+			break;
+		case DOORSCHOT: // Judith Doorschot's model
+			compDoorschot(i_tauS, tau_th, slope_angle, dg, massflux, c_salt);
+			break;
 	}
 
 	return true;
 }
-
@@ -22,11 +22,24 @@
 
 #include <meteoio/MeteoIO.h>
 #include <string.h>
+#include <memory>
 
 #include <snowpack/SnowpackConfig.h>
 
+class SaltationTable;
+
 /**
  * @brief This module contains the saltation model of Judith.
+ * The model is chosen with the SALTATION_MODEL key in the [SnowpackAdvanced] section:
+ * 	- SORENSEN: Sorensen's empirical mass flux (default);
+ * 	- DOORSCHOT: Judith Doorschot's physically based model, that computes the particles' trajectories for
+ * several shear stress classes. It is much more expensive than SORENSEN;
+ * 	- DOORSCHOT_TABLE: the same model, but interpolated (multilinear) within a table of precomputed values over
+ * the surface shear stress, threshold shear stress, slope angle and grain size. The nodes of the table are computed
+ * on demand the first time they are needed and are then shared by all the Saltation objects of the process (so all
+ * the pixels of a simulation benefit from them). Outside of the table's range, the exact model is used. The model switches
+ * between saltation regimes, so the interpolation is checked against the exact model at the center of each cell of the
+ * table when the cell is first used; if it deviates by more than 5%, the exact model is used within this cell.
  * @ingroup postprocessing
  */
 class Saltation {
@@ -36,9 +49,18 @@ class Saltation {
 		bool compSaltation(const double& tauS, const double& tau_th, const double& slope_angle, const double& dg,
 		                   double& massflux, double& c_salt) const;
 
+		static void compDoorschot(const double& tauS, const double& tau_th, const double& slope_angle, const double& dg,
+		                          double& massflux, double& c_salt);
+
 		static const double karman;
 		static const double z0_salt;
 
+		typedef enum {
+			SORENSEN, ///< Sorensen's empirical mass flux
+			DOORSCHOT, ///< Judith Doorschot's model
+			DOORSCHOT_TABLE ///< Judith Doorschot's model, interpolated in a table of precomputed values
+		} SALTATION_MODEL;
+
 	private:
 		static double sa_vw(const double& z, const double& tauA, const double& tauS, const double& z0,
                      const double& u_start, const double& slope_angle);
@@ -58,7 +80,8 @@ class Saltation {
 		static int sa_TestSaltation(const double& z0, const double& tauS, const double& tauA, const double& slope_angle,
 		                     const double& dg, const double& tau_th, double& z_max, double& ubar);
 
-		const std::string saltation_model;
+		SALTATION_MODEL saltation_model;
+		std::shared_ptr<SaltationTable> table; ///< only set for DOORSCHOT_TABLE, shared by the whole process
 		static const double hs_frac, elas, angle_ej, ratio_ve_ustar, salt_height;
 		static const int strong, weak;
 };
@@ -203,6 +203,7 @@ double SnowDrift::compMassFlux(const std::vector<ElementData>& EMS, const double
 */
 void SnowDrift::compSnowDrift(const CurrentMeteo& Mdata, SnowStation& Xdata, SurfaceFluxes& Sdata, double& forced_massErode) const
 {
+	MIO_TRACE_ZONE("Snowpack", "compSnowDrift");
 	size_t nE = Xdata.getNumberOfElements();
 	vector<NodeData>& NDS = Xdata.Ndata;
 	vector<ElementData>& EMS = Xdata.Edata;
@@ -69,7 +69,7 @@ bool Stability::initStaticData()
  ************************************************************/
 
 Stability::Stability(const SnowpackConfig& cfg, const bool& i_classify_profile)
-           : strength_model(), hardness_parameterization(), hoar_density_buried(IOUtils::nodata), plastic(false),
+           : strength_model(), hardness_parameterization(), hand_hardness(NULL), shear_strength(NULL), hoar_density_buried(IOUtils::nodata), plastic(false),
              classify_profile(i_classify_profile), multi_layer_sk38(false), RTA_ssi(false)
 {
 	cfg.getValue("STRENGTH_MODEL", "SnowpackAdvanced", strength_model);
@@ -79,9 +79,11 @@ Stability::Stability(const SnowpackConfig& cfg, const bool& i_classify_profile)
 
 	const map<string, StabMemFn>::const_iterator it1 = mapHandHardness.find(hardness_parameterization);
 	if (it1 == mapHandHardness.end()) throw InvalidArgumentException("Unknown hardness parameterization: "+hardness_parameterization, AT);
+	hand_hardness = it1->second;
 
 	const map<string, StabFnShearStrength>::const_iterator it2 = mapShearStrength.find(strength_model);
 	if (it2 == mapShearStrength.end()) throw InvalidArgumentException("Unknown strength model: "+strength_model, AT);
+	shear_strength = it2->second;
 
 	cfg.getValue("PLASTIC", "SnowpackAdvanced", plastic); //To build a sandwich with a non-snow layer (plastic or wood chips) on top;
 
@@ -149,6 +151,7 @@ double Stability::initStructuralStabilityIndex(const ElementData& Edata_lower, c
  */
 void Stability::checkStability(const CurrentMeteo& Mdata, SnowStation& Xdata)
 {
+	MIO_TRACE_ZONE("Snowpack", "checkStability");
 	const double cos_sl = Xdata.cos_sl; // Cosine of slope angle
 	// Dereference the element pointer containing micro-structure data
 	const size_t nN = Xdata.getNumberOfNodes();
@@ -169,7 +172,7 @@ void Stability::checkStability(const CurrentMeteo& Mdata, SnowStation& Xdata)
 	std::vector<unsigned short> n_lemon(nN, 0.);
 	size_t e = nE;
 	while (e-- > Xdata.SoilNode) {
-		EMS[e].hard = (mapHandHardness[hardness_parameterization])(EMS[e], hoar_density_buried);
+		EMS[e].hard = hand_hardness(EMS[e], hoar_density_buried);
 		EMS[e].S_dr = StabilityAlgorithms::setDeformationRateIndex(EMS[e]);
 		StabilityData  STpar(Stability::psi_ref);
 
@@ -181,8 +184,7 @@ void Stability::checkStability(const CurrentMeteo& Mdata, SnowStation& Xdata)
 		STpar.strength_upper = strength_upper; //reset to previous value
 		StabilityAlgorithms::compReducedStresses(EMS[e].C, cos_sl, STpar);
 
-		if ( !(mapShearStrength[strength_model])(Xdata.cH, cos_sl, Mdata.date,
-		                                                               EMS[e], NDS[e+1], STpar)) {
+		if ( !shear_strength(Xdata.cH, cos_sl, Mdata.date, EMS[e], NDS[e+1], STpar)) {
 			prn_msg(__FILE__, __LINE__, "msg-", Date(), "Node %03d of %03d", e+1, nN);
 		}
 		strength_upper = STpar.strength_upper; //store previous value
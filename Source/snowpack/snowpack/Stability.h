@@ -70,6 +70,8 @@ class Stability {
 		static std::map<std::string, StabFnShearStrength> mapShearStrength;
 
 		std::string strength_model, hardness_parameterization;
+		StabMemFn hand_hardness; ///< resolved from hardness_parameterization
+		StabFnShearStrength shear_strength; ///< resolved from strength_model
 		double hoar_density_buried;
 		bool plastic;
 		bool classify_profile, multi_layer_sk38, RTA_ssi;
@@ -42,6 +42,7 @@
 #include <snowpack/plugins/SnowpackIOInterface.h>
 #include <snowpack/plugins/AsciiIO.h> //for direct calls to AsciiIO
 #include <snowpack/plugins/SmetIO.h> //for direct calls to SmetIO
+#include <snowpack/plugins/ProfileStore.h> //for reading and converting binary profiles
 
 #include <snowpack/snowpackCore/Aggregate.h>
 #include <snowpack/snowpackCore/Canopy.h>
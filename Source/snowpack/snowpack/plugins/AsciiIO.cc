@@ -896,22 +896,95 @@ void AsciiIO::writeProfile(const mio::Date& i_date, const SnowStation& Xdata)
 			writeProfilePro(i_date, Xdata, aggregate_prf);
 		} else if (vecProfileFmt[ii] == "PRF") {
 			writeProfilePrf(i_date, Xdata, aggregate_prf);
+		} else if (vecProfileFmt[ii] == "PROB") {
+			writeProfileProb(i_date, Xdata);
 		} else if (vecProfileFmt[ii] == "IMIS") {
 			;
 		} else {
-			throw InvalidArgumentException("Key PROF_FORMAT in section [Output] takes only PRO, PRF or IMIS formats", AT);
+			throw InvalidArgumentException("Key PROF_FORMAT in section [Output] takes only PRO, PRF, PROB or IMIS formats", AT);
 		}
 	}
 }
 
+/**
+ * @brief Start a new column of a profile record, with the sea ice offset if necessary
+ */
+static std::vector<double>& addProfileColumn(ProfileStore::ProfileRecord& record, const unsigned int& code, const size_t& Noffset)
+{
+	record.columns.push_back( ProfileStore::ProfileColumn(code) );
+	if (Noffset == 1) record.columns.back().values.push_back(mio::IOUtils::nodata);
+	return record.columns.back().values;
+}
+
+/**
+ * @brief Is this profile code only defined for the snow elements?
+ * @details When there is no snow, such codes only contain one zero.
+ */
+static bool isSnowOnlyCode(const unsigned int& code)
+{
+	return ((code >= 508 && code <= 512) || code == 522 || code == 523 || (code >= 531 && code <= 541) || code >= 600);
+}
+
+/**
+ * @brief Write one column of a profile record in the PRO format
+ * @details The number of decimals depends on the code while the nodata values (such as the sea ice offset) are always
+ * written with two decimals, so the PRO files remain the same as when each code was formatted on its own.
+ * @param column profile column, as computed by AsciiIO::getProfileColumns()
+ * @param no_snow is there no snow on the ground?
+ * @param fout output stream
+ */
+static void writeProColumn(const ProfileStore::ProfileColumn& column, const bool& no_snow, std::ostream& fout)
+{
+	const unsigned int code = column.code;
+	const std::vector<double>& values = column.values;
+	fout << "\n" << std::setfill('0') << std::setw(4) << code << std::setfill(' ');
+	if (no_snow && isSnowOnlyCode(code)) {
+		fout << ",1,0";
+		return;
+	}
+	fout << "," << values.size();
+
+	if (code == 513) { //grain types, the last value being the surface hoar marker
+		for (size_t kk = 0; kk+1 < values.size(); kk++)
+			fout << "," << std::setfill('0') << std::setw(3) << static_cast<int>(values[kk]) << std::setfill(' ');
+		fout << "," << static_cast<int>(values.back());
+		return;
+	}
+	if (code == 514) { //surface hoar at the surface
+		if (values[0] == IOUtils::nodata) fout << ",-999,-999.0,-999.0";
+		else fout << ",660," << std::fixed << std::setprecision(1) << values[1] << "," << std::setprecision(0) << values[2];
+		return;
+	}
+	if (code == 530) { //profile type and stability class, then position and value of the minimum stability indices
+		fout << "," << static_cast<int>(values[0]) << "," << static_cast<int>(values[1]);
+		for (size_t kk = 2; kk < values.size(); kk++)
+			fout << "," << std::fixed << std::setprecision((kk%2 == 0)? 1 : 2) << values[kk];
+		return;
+	}
+
+	const bool scientific = (code == 517 || code == 518 || code == 520 || code == 521);
+	int precision = 2;
+	if (code == 504 || code == 515 || code == 516 || code == 519) precision = 0;
+	else if (code == 502 || code == 506 || code == 510 || code == 522 || code == 523 || code == 534 || code == 605) precision = 1;
+	else if (code == 507 || code == 524 || code == 525) precision = 3;
+
+	for (size_t kk = 0; kk < values.size(); kk++) {
+		if (values[kk] == IOUtils::nodata)
+			fout << "," << std::fixed << std::setprecision(2) << values[kk];
+		else if ((code == 602 || code == 603) && kk+1 == values.size()) //no difference for the top element
+			fout << ",0.";
+		else if (scientific)
+			fout << "," << std::scientific << std::setprecision(3) << values[kk];
+		else
+			fout << "," << std::fixed << std::setprecision(precision) << values[kk];
+	}
+}
+
 void AsciiIO::writeProfilePro(const mio::Date& i_date, const SnowStation& Xdata, const bool& /*aggregate*/)
 {
 //TODO: optimize this method. For high-res outputs, we spend more than 50% of the time in this method...
 	const string filename( getFilenamePrefix(Xdata.meta.getStationID(), outpath) + ".pro" );
-	const size_t nN = Xdata.getNumberOfNodes();
-	const size_t nE = nN-1;
-	const vector<ElementData>& EMS = Xdata.Edata;
-	const vector<NodeData>& NDS = Xdata.Ndata;
+	const size_t nE = Xdata.getNumberOfElements();
 
 	//Check whether file exists, if so check whether data can be appended
 	//or file needs to be deleted
@@ -934,11 +1007,44 @@ void AsciiIO::writeProfilePro(const mio::Date& i_date, const SnowStation& Xdata,
 	}
 
 	fout << "\n0500," << i_date.toString(Date::DIN);
-	const double cos_sl = Xdata.cos_sl;
+	if (nE==0) {
+		fout << "\n0501,1,0";
+		fout.close();
+		return;
+	}
+
+	ProfileStore::ProfileRecord record;
+	getProfileColumns(i_date, Xdata, record);
 	const bool no_snow = (nE == Xdata.SoilNode);
+	for (size_t ii=0; ii<record.columns.size(); ii++)
+		writeProColumn(record.columns[ii], no_snow, fout);
+
+	if (variant == "CALIBRATION")
+		writeProfileProAddCalibration(Xdata, fout);
+	else if (out_load)
+		writeProfileProAddDefault(Xdata, fout);
+
+	fout.close();
+}
 
+/**
+ * @brief Compute the profile codes written in the PRO (see writeProfilePro()) and PROB (see writeProfileProb()) files
+ * @details This computes all codes from 0501 to 0541 as well as the 0600-profile specials of the default variant, in the
+ * order they are written. The solute concentrations (OUT_LOAD) and the calibration specials are only written in the PRO files.
+ * @param i_date the current date
+ * @param Xdata
+ * @param record profile record to fill
+ */
+void AsciiIO::getProfileColumns(const mio::Date& i_date, const SnowStation& Xdata, ProfileStore::ProfileRecord& record) const
+{
+	const size_t nN = Xdata.getNumberOfNodes();
+	const size_t nE = nN-1;
+	const vector<ElementData>& EMS = Xdata.Edata;
+	const vector<NodeData>& NDS = Xdata.Ndata;
+	const double cos_sl = Xdata.cos_sl;
+	const bool no_snow = (nE == Xdata.SoilNode);
 	// Are we using sea ice variant? Check if the object is defined via the pointer:
-	const bool SeaIce = (Xdata.Seaice==NULL)?(false):(true);
+	const bool SeaIce = (Xdata.Seaice!=NULL);
 	// Offset profile [m]:
 	const double offset = (SeaIce)?(4.):(0.);
 	// Check reference level: either a marked reference level, or, if non existent, the sea level (if sea ice module is used), otherwise 0:
@@ -946,268 +1052,203 @@ void AsciiIO::writeProfilePro(const mio::Date& i_date, const SnowStation& Xdata,
 	// Number of fill elements for offset (only 0 or 1 is supported now):
 	const size_t Noffset = (SeaIce)?(1):(0);
 
-	//  501: height [> 0: top, < 0: bottom of elem.] (cm)
-	const size_t nz = (useSoilLayers)? nN : nE;
-	if(nE==0) {
-		fout << "\n0501,1,0";
-		fout.close();
+	record.date = i_date;
+	record.columns.clear();
+	if (nE == 0) {
+		addProfileColumn(record, 501, 0).push_back(0.);
 		return;
-	} else {
-		fout << "\n0501," << nz + Noffset;
 	}
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << M_TO_CM(offset - ReferenceLevel/cos_sl);
+
+	//  501: height [> 0: top, < 0: bottom of elem.] (cm)
+	const size_t nz = (useSoilLayers)? nN : nE;
+	std::vector<double>& z = addProfileColumn(record, 501, 0);
+	if (Noffset == 1) z.push_back( M_TO_CM(offset - ReferenceLevel/cos_sl) );
 	for (size_t n = nN-nz; n < nN; n++) {
-		if (SeaIce) {
-			//Correct for sea level:
-			fout << "," << std::fixed << std::setprecision(2) << M_TO_CM((NDS[n].z+NDS[n].u - NDS[Xdata.SoilNode].z - ReferenceLevel)/cos_sl + offset);
-		} else {
-			fout << "," << std::fixed << std::setprecision(2) << M_TO_CM((NDS[n].z+NDS[n].u - NDS[Xdata.SoilNode].z)/cos_sl);
-		}
+		if (SeaIce) //Correct for sea level:
+			z.push_back( M_TO_CM((NDS[n].z+NDS[n].u - NDS[Xdata.SoilNode].z - ReferenceLevel)/cos_sl + offset) );
+		else
+			z.push_back( M_TO_CM((NDS[n].z+NDS[n].u - NDS[Xdata.SoilNode].z)/cos_sl) );
 	}
+
 	// 0502: element density (kg m-3)
-	fout << "\n0502," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(1) << EMS[e].Rho;
+	std::vector<double>* col = &addProfileColumn(record, 502, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(EMS[e].Rho);
 	// 0503: element temperature (degC)
-	fout << "\n0503," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(2) << IOUtils::K_TO_C(EMS[e].Te);
+	col = &addProfileColumn(record, 503, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(IOUtils::K_TO_C(EMS[e].Te));
 	// 0504: element ID
-	fout << "\n0504," << nE;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(0) << EMS[e].ID;
+	col = &addProfileColumn(record, 504, 0);
+	for (size_t e = 0; e < nE; e++) col->push_back(static_cast<double>(EMS[e].ID));
 	// 0505: element age
-	fout << "\n0505," << nE;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(2) << i_date.getJulian() - EMS[e].depositionDate.getJulian();
+	col = &addProfileColumn(record, 505, 0);
+	for (size_t e = 0; e < nE; e++) col->push_back(i_date.getJulian() - EMS[e].depositionDate.getJulian());
 	// 0506: liquid water content by volume (%)
-	fout << "\n0506," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(1) << 100.*EMS[e].theta[WATER];
+	col = &addProfileColumn(record, 506, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta[WATER]);
 	// 0507: liquid preferential flow water content by volume (%)
-	if(enable_pref_flow) {
-		fout << "\n0507," << nE + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = 0; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(3) << 100.*EMS[e].theta[WATER_PREF];
-	}
-	// 0508: snow dendricity (1)
-	if (no_snow) {
-		fout << "\n0508,1,0";
-	} else {
-		fout << "\n0508," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].dd;
-	}
-	// 0509: snow sphericity (1)
-	if (no_snow) {
-		fout << "\n0509,1,0";
-	} else {
-		fout << "\n0509," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].sp;
-	}
-	// 0510: snow coordination number (1)
-	if (no_snow) {
-		fout << "\n0510,1,0";
-	} else {
-		fout << "\n0510," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(1) << EMS[e].N3;
+	if (enable_pref_flow) {
+		col = &addProfileColumn(record, 507, Noffset);
+		for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta[WATER_PREF]);
 	}
-	// 0511: snow bond size (mm)
-	if (no_snow) {
-		fout << "\n0511,1,0";
-	} else {
-		fout << "\n0511," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << 2.*EMS[e].rb;
-	}
-	// 0512: snow grain size (mm)
-	if (no_snow) {
-		fout << "\n0512,1,0";
-	} else {
-		fout << "\n0512," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << 2.*EMS[e].rg;
-	}
-	// 0513: snow grain type (Swiss code F1F2F3), dumps either 1,0 or 1,660 if no snow on the ground!
-	fout << "\n0513," << nE+1-Xdata.SoilNode + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setfill ('0') << std::setw (3) << 0;
-	for (size_t e = Xdata.SoilNode; e < nE; e++)
-		fout << "," << std::fixed << std::setfill ('0') << std::setw (3) << EMS[e].type;
-	// surface hoar at surface? (depending on boundary conditions)
-	if (M_TO_MM(NDS[nN-1].hoar/hoar_density_surf) > hoar_min_size_surf) {
-		fout << ",660";
-		// 0514: grain type, grain size (mm), and density (kg m-3) of SH at surface
-		fout << "\n0514,3";
-		fout << ",660," << std::fixed << std::setprecision(1) << M_TO_MM(NDS[nN-1].hoar/hoar_density_surf);
-		fout << "," << std::fixed << std::setprecision(0) << hoar_density_surf;
-	} else {
-		fout << ",0";
-		fout << "\n0514,3,-999,-999.0,-999.0";
+
+	// 0508 to 0512: snow dendricity (1), sphericity (1), coordination number (1), bond size (mm) and grain size (mm)
+	const unsigned int snow_codes[] = {508, 509, 510, 511, 512};
+	for (size_t ii = 0; ii < sizeof(snow_codes)/sizeof(snow_codes[0]); ii++) {
+		col = &addProfileColumn(record, snow_codes[ii], (no_snow)? 0 : Noffset);
+		if (no_snow) {
+			col->push_back(0.);
+			continue;
+		}
+		for (size_t e = Xdata.SoilNode; e < nE; e++) {
+			if (snow_codes[ii] == 508) col->push_back(EMS[e].dd);
+			else if (snow_codes[ii] == 509) col->push_back(EMS[e].sp);
+			else if (snow_codes[ii] == 510) col->push_back(EMS[e].N3);
+			else if (snow_codes[ii] == 511) col->push_back(2.*EMS[e].rb);
+			else col->push_back(2.*EMS[e].rg);
+		}
 	}
+
+	// 0513: snow grain type (Swiss code F1F2F3), the last value being either 0 or 660 (surface hoar at the surface)
+	col = &addProfileColumn(record, 513, 0);
+	if (Noffset == 1) col->push_back(0.);
+	for (size_t e = Xdata.SoilNode; e < nE; e++) col->push_back(static_cast<double>(EMS[e].type));
+	const bool surface_hoar = (M_TO_MM(NDS[nN-1].hoar/hoar_density_surf) > hoar_min_size_surf); //depending on boundary conditions
+	col->push_back( (surface_hoar)? 660. : 0. );
+	// 0514: grain type, grain size (mm), and density (kg m-3) of SH at surface
+	col = &addProfileColumn(record, 514, 0);
+	col->push_back( (surface_hoar)? 660. : IOUtils::nodata );
+	col->push_back( (surface_hoar)? M_TO_MM(NDS[nN-1].hoar/hoar_density_surf) : IOUtils::nodata );
+	col->push_back( (surface_hoar)? hoar_density_surf : IOUtils::nodata );
+
 	// 0515: ice volume fraction (%)
-	fout << "\n0515," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(0) << 100.*EMS[e].theta[ICE];
+	col = &addProfileColumn(record, 515, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta[ICE]);
 	// 0516: air volume fraction (%)
-	fout << "\n0516," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(0) << 100.*EMS[e].theta[AIR];
+	col = &addProfileColumn(record, 516, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta[AIR]);
 	// 0517: stress (kPa)
-	fout << "\n0517," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::scientific << std::setprecision(3) << 1.e-3*EMS[e].C;
+	col = &addProfileColumn(record, 517, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(1.e-3*EMS[e].C);
 	// 0518: viscosity (GPa s)
-	fout << "\n0518," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::scientific << std::setprecision(3) << 1.e-9*EMS[e].k[SETTLEMENT];
+	col = &addProfileColumn(record, 518, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(1.e-9*EMS[e].k[SETTLEMENT]);
 	// 0519: soil volume fraction (%)
-	fout << "\n0519," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::fixed << std::setprecision(0) <<100.*EMS[e].theta[SOIL];
+	col = &addProfileColumn(record, 519, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta[SOIL]);
 	// 0520: temperature gradient (K m-1)
-	fout << "\n0520," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::scientific << std::setprecision(3) << EMS[e].gradT;
+	col = &addProfileColumn(record, 520, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(EMS[e].gradT);
 	// 0521: thermal conductivity (W K-1 m-1)
-	fout << "\n0521," << nE + Noffset;
-	if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-	for (size_t e = 0; e < nE; e++)
-		fout << "," << std::scientific << std::setprecision(3) << EMS[e].k[TEMPERATURE];
+	col = &addProfileColumn(record, 521, Noffset);
+	for (size_t e = 0; e < nE; e++) col->push_back(EMS[e].k[TEMPERATURE]);
 	// 0522: snow absorbed shortwave radiation (W m-2)
-	if (no_snow) {
-		fout << "\n0522,1,0";
-	} else {
-		fout << "\n0522," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(1) << EMS[e].sw_abs;
-	}
+	col = &addProfileColumn(record, 522, (no_snow)? 0 : Noffset);
+	if (no_snow) col->push_back(0.);
+	else for (size_t e = Xdata.SoilNode; e < nE; e++) col->push_back(EMS[e].sw_abs);
 	// 0523: snow viscous deformation rate (1.e-6 s-1)
-	if (no_snow) {
-		fout << "\n0523,1,0";
-	} else {
-		fout << "\n0523," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(1) << 1.e6*EMS[e].Eps_vDot;
-	}
-	// 0524: ice reservoir content by volume (%)
-	if(enable_ice_reservoir) {
-		fout << "\n0524," << nE + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = 0; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(3) << 100.*EMS[e].theta_i_reservoir;
-	}
-	// 0525: cumulated ice reservoir content by volume (%)
-	if(enable_ice_reservoir) {
-		fout << "\n0525," << nE + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = 0; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(3) << 100.*EMS[e].theta_i_reservoir_cumul;
+	col = &addProfileColumn(record, 523, (no_snow)? 0 : Noffset);
+	if (no_snow) col->push_back(0.);
+	else for (size_t e = Xdata.SoilNode; e < nE; e++) col->push_back(1.e6*EMS[e].Eps_vDot);
+	// 0524 and 0525: ice reservoir content and cumulated ice reservoir content by volume (%)
+	if (enable_ice_reservoir) {
+		col = &addProfileColumn(record, 524, Noffset);
+		for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta_i_reservoir);
+		col = &addProfileColumn(record, 525, Noffset);
+		for (size_t e = 0; e < nE; e++) col->push_back(100.*EMS[e].theta_i_reservoir_cumul);
 	}
+
 	// 0530: position (cm) and minimum stability indices
-	fout << "\n0530,8";
-	fout << "," << std::fixed << +Xdata.S_class1 << "," << +Xdata.S_class2; //force printing type char as numerica value
-	fout << "," <<  std::setprecision(1) << M_TO_CM(Xdata.z_S_d/cos_sl) << "," << std::setprecision(2) << Xdata.S_d;
-	fout << "," << std::fixed << std::setprecision(1) << M_TO_CM(Xdata.z_S_n/cos_sl) << "," << std::setprecision(2) <<  Xdata.S_n;
-	fout << "," << std::setprecision(1) << M_TO_CM(Xdata.z_S_s/cos_sl) << "," << std::fixed << std::setprecision(2) << Xdata.S_s;
-	// 0531: deformation rate stability index Sdef
-	if (no_snow) {
-		fout << "\n0531,1,0";
-	} else {
-		fout << "\n0531," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].S_dr;
-	}
-	// 0532: natural stability index Sn38
-	if (no_snow) {
-		fout << "\n0532,1,0";
-	} else {
-		fout << "\n0532," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode;  e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << NDS[e+1].S_n;
-	}
-	// 0533: stability index Sk38
-	if (no_snow) {
-		fout << "\n0533,1,0";
-	} else {
-		fout << "\n0533," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << NDS[e+1].S_s;
-	}
-	// 0534: hand hardness ...
-	if (no_snow) {
-		fout << "\n0534,1,0";
-	} else {
-		fout << "\n0534," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		if (r_in_n) { // ... either converted to newtons according to the ICSSG 2009
-			for (size_t e = Xdata.SoilNode; e < nE; e++)
-				fout << "," << std::fixed << std::setprecision(1) << -1.*(19.3*pow(EMS[e].hard, 2.4));
-		} else { // ... or in index steps (1)
-			for (size_t e = Xdata.SoilNode; e < nE; e++)
-				fout << "," << std::fixed << std::setprecision(1) << -EMS[e].hard;
+	col = &addProfileColumn(record, 530, 0);
+	col->push_back(static_cast<double>(Xdata.S_class1));
+	col->push_back(static_cast<double>(Xdata.S_class2));
+	col->push_back(M_TO_CM(Xdata.z_S_d/cos_sl));
+	col->push_back(Xdata.S_d);
+	col->push_back(M_TO_CM(Xdata.z_S_n/cos_sl));
+	col->push_back(Xdata.S_n);
+	col->push_back(M_TO_CM(Xdata.z_S_s/cos_sl));
+	col->push_back(Xdata.S_s);
+
+	// 0531 to 0534: stability indices Sdef, Sn38, Sk38 and hand hardness, either converted to newtons according to the
+	// ICSSG 2009 or in index steps (1), 0540 and 0541: bulk and brine salinity (g/kg), 0535: optical equivalent grain size (mm)
+	const unsigned int stab_codes[] = {531, 532, 533, 534, 540, 541, 535};
+	for (size_t ii = 0; ii < sizeof(stab_codes)/sizeof(stab_codes[0]); ii++) {
+		if ((stab_codes[ii] == 540 || stab_codes[ii] == 541) && !SeaIce) continue;
+		col = &addProfileColumn(record, stab_codes[ii], (no_snow)? 0 : Noffset);
+		if (no_snow) {
+			col->push_back(0.);
+			continue;
+		}
+		for (size_t e = Xdata.SoilNode; e < nE; e++) {
+			if (stab_codes[ii] == 531) col->push_back(EMS[e].S_dr);
+			else if (stab_codes[ii] == 532) col->push_back(NDS[e+1].S_n);
+			else if (stab_codes[ii] == 533) col->push_back(NDS[e+1].S_s);
+			else if (stab_codes[ii] == 534) col->push_back( (r_in_n)? -1.*(19.3*pow(EMS[e].hard, 2.4)) : -EMS[e].hard );
+			else if (stab_codes[ii] == 540) col->push_back(EMS[e].salinity);
+			else if (stab_codes[ii] == 541) col->push_back( (EMS[e].theta[WATER] == 0.) ? (mio::IOUtils::nodata) : (EMS[e].salinity / EMS[e].theta[WATER]) );
+			else col->push_back(EMS[e].ogs);
 		}
 	}
-	if (Xdata.Seaice!=NULL) {
-		// 0540: bulk salinity (g/kg)
+
+	// 0600-profile specials: snow shear strength (kPa), grain size difference (mm), hardness difference (1),
+	// structural stability index SSI, inverse texture index ITI (Mg m-4), critical cut length (m) and for the NIED
+	// metamorphism, the dry snow metamorphism factor, Sigdsm and S_dsm
+	if (variant == "CALIBRATION" || out_load) return;
+	const bool nied = (metamorphism_model == "NIED");
+	const unsigned int special_codes[] = {601, 602, 603, 604, 605, 606, 621, 622, 623};
+	for (size_t ii = 0; ii < sizeof(special_codes)/sizeof(special_codes[0]); ii++) {
+		if (special_codes[ii] > 620 && !nied) continue;
+		col = &addProfileColumn(record, special_codes[ii], 0);
 		if (no_snow) {
-			fout << "\n0540,1,0";
-		} else {
-			fout << "\n0540," << nE-Xdata.SoilNode + Noffset;
-			if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-			for (size_t e = Xdata.SoilNode; e < nE; e++)
-				fout << "," << std::fixed << std::setprecision(2) << EMS[e].salinity;
+			col->push_back(0.);
+			continue;
 		}
-		// 0541: bulk salinity (g/kg)
-		if (no_snow) {
-			fout << "\n0541,1,0";
-		} else {
-			fout << "\n0541," << nE-Xdata.SoilNode + Noffset;
-			if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-			for (size_t e = Xdata.SoilNode; e < nE; e++)
-				fout << "," << std::fixed << std::setprecision(2) << ((EMS[e].theta[WATER] == 0.) ? (mio::IOUtils::nodata) : (EMS[e].salinity / EMS[e].theta[WATER]));
+		for (size_t e = Xdata.SoilNode; e < nE; e++) {
+			switch (special_codes[ii]) {
+				case 601: col->push_back(EMS[e].s_strength); break;
+				case 602: col->push_back( (e+1 < nE)? 2.*fabs(EMS[e].rg - EMS[e+1].rg) : 0. ); break;
+				case 603: col->push_back( (e+1 < nE)? fabs(EMS[e].hard - EMS[e+1].hard) : 0. ); break;
+				case 604: col->push_back(NDS[e+1].ssi); break;
+				case 605: col->push_back( (EMS[e].dd < 0.005)? -1.*EMS[e].Rho/(2.*MM_TO_M(EMS[e].rg)) : 0. ); break;
+				case 606: col->push_back(EMS[e].crit_cut_length); break;
+				case 621: col->push_back(EMS[e].dsm); break;
+				case 622: col->push_back(NDS[e+1].Sigdsm); break;
+				default: col->push_back(NDS[e+1].S_dsm); break;
+			}
 		}
 	}
-	// 0535: optical equivalent grain size OGS (mm)
-	if (no_snow) {
-		fout << "\n0535,1,0";
-	} else {
-		fout << "\n0535," << nE-Xdata.SoilNode + Noffset;
-		if (Noffset == 1) fout << "," << std::fixed << std::setprecision(2) << mio::IOUtils::nodata;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].ogs;
+}
+
+/**
+ * @brief Write the Snow Profile Results in the binary profiles format (*.prob), see \ref prob_format
+ * @details The same codes and units as in writeProfilePro() are written (see getProfileColumns()), but without any text formatting.
+ * @param i_date the current date
+ * @param Xdata
+ */
+void AsciiIO::writeProfileProb(const mio::Date& i_date, const SnowStation& Xdata)
+{
+	const string filename( getFilenamePrefix(Xdata.meta.getStationID(), outpath) + ".prob" );
+	ProfileStore store(filename);
+
+	//on the first call, either append to the existing file or create a new one (same logic as for the PRO files)
+	if (setAppendableFiles.find(filename) == setAppendableFiles.end()) {
+		if (!store.exists() || !store.truncate(i_date)) {
+			std::ostringstream header;
+			writeProHeader(Xdata, header);
+			string header_str( header.str() );
+			header_str.erase(header_str.size() - string("[DATA]").size()); //the [DATA] marker is not part of the header
+			store.create(header_str);
+		}
+		setAppendableFiles.insert(filename);
 	}
-	if (variant == "CALIBRATION")
-		writeProfileProAddCalibration(Xdata, fout);
-	else
-		writeProfileProAddDefault(Xdata, fout);
 
-	fout.close();
+	ProfileStore::ProfileRecord record;
+	getProfileColumns(i_date, Xdata, record);
+	store.append(record);
 }
 
 /**
- * @brief Default: dump special profiles to *.pro output file
+ * @brief Default: dump the solute concentrations (OUT_LOAD) to *.pro output file, the 0600-profile specials being
+ * computed by getProfileColumns()
  * @author Charles Fierz
  * @version 10.04
  * @param Xdata
@@ -1217,78 +1258,15 @@ void AsciiIO::writeProfileProAddDefault(const SnowStation& Xdata, std::ofstream
 {
 	const size_t nE = Xdata.getNumberOfElements();
 	const vector<ElementData>& EMS = Xdata.Edata;
-	const vector<NodeData>& NDS = Xdata.Ndata;
 
-	if (out_load) {
-		// 06nn: e.g. solute concentration
-		for (size_t jj = 2; jj < N_COMPONENTS-1; jj++) {
-			for (size_t ii = 0; ii < Xdata.number_of_solutes; ii++) {
-				fout << "\n06" << std::fixed << std::setfill('0') << std::setw(2) << 10*jj + ii << "," << nE-Xdata.SoilNode;
-				for (size_t e = Xdata.SoilNode; e < nE; e++) {
-					fout << "," << std::fixed << std::setprecision(1) << EMS[e].conc(ii,jj);
-				}
-			}
-		}
-	} else if (nE > Xdata.SoilNode) { // snow on the ground
-		// 0600-profile specials
-		// 0601: snow shear strength (kPa)
-		fout << "\n0601," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].s_strength;
-		// 0602: grain size difference (mm)
-		fout << "\n0602," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE-1; e++)
-			fout << "," << std::fixed << std::setprecision(2) << 2.*fabs(EMS[e].rg - EMS[e+1].rg);
-		fout << ",0.";
-		// 0603: hardness difference (1)
-		fout << "\n0603," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE-1; e++)
-			fout << "," << std::fixed << std::setprecision(2) << fabs(EMS[e].hard - EMS[e+1].hard);
-		fout << ",0.";
-		// 0604: structural stability index SSI
-		fout << "\n0604," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE; e++)
-			fout << "," << std::fixed << std::setprecision(2) << NDS[e+1].ssi;
-		// 0605: inverse texture index ITI (Mg m-4)
-		fout << "\n0605," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE; e++) {
-			if (EMS[e].dd < 0.005)
-				fout << "," << std::fixed << std::setprecision(1) << -1.*EMS[e].Rho/(2.*MM_TO_M(EMS[e].rg));
-			else
-				fout << "," << std::fixed << std::setprecision(1) << 0.;
-		}
-		// 0606: critical cut length (m)
-		fout << "\n0606," << nE-Xdata.SoilNode;
-		for (size_t e = Xdata.SoilNode; e < nE; e++) {
-			fout << "," << std::fixed << std::setprecision(2) << EMS[e].crit_cut_length;
-		}
-		if (metamorphism_model == "NIED") {
-			// 0621: Dry snow metamorphism factor
-			fout << "\n0621," << nE-Xdata.SoilNode;
-			for (size_t e = Xdata.SoilNode; e < nE; e++) {
-				fout << "," << std::fixed << std::setprecision(2) << EMS[e].dsm;
-			}
-			// 0622: Sigdsm
-			fout << "\n0622," << nE-Xdata.SoilNode;
-			for (size_t e = Xdata.SoilNode; e < nE; e++) {
-				fout << "," << std::fixed << std::setprecision(2) << NDS[e+1].Sigdsm;
-			}
-			// 0623: S_dsm
-			fout << "\n0623," << nE-Xdata.SoilNode;
+	// 06nn: e.g. solute concentration
+	for (size_t jj = 2; jj < N_COMPONENTS-1; jj++) {
+		for (size_t ii = 0; ii < Xdata.number_of_solutes; ii++) {
+			fout << "\n06" << std::fixed << std::setfill('0') << std::setw(2) << 10*jj + ii << "," << nE-Xdata.SoilNode;
 			for (size_t e = Xdata.SoilNode; e < nE; e++) {
-				fout << "," << std::fixed << std::setprecision(2) << NDS[e+1].S_dsm;
+				fout << "," << std::fixed << std::setprecision(1) << EMS[e].conc(ii,jj);
 			}
 		}
-	} else {
-		for (size_t jj = 1; jj < 7; jj++) {
-			fout << "\n060" << jj << ",1,0";
-		}
-		if (metamorphism_model == "NIED") {
-			for (size_t jj = 1; jj < 4; jj++) {
-			      fout << "\n062" << jj << ",1,0";
-			}
-		}
-
 	}
 }
 
@@ -2391,7 +2369,7 @@ void AsciiIO::writeMETHeader(const SnowStation& Xdata, std::ofstream &fout) cons
 	fout << "\n\n[DATA]";
 }
 
-void AsciiIO::writeProHeader(const SnowStation& Xdata, std::ofstream &fout) const
+void AsciiIO::writeProHeader(const SnowStation& Xdata, std::ostream &fout) const
 {
 	const string stationname = Xdata.meta.getStationName();
 	fout << "[STATION_PARAMETERS]";
@@ -23,6 +23,7 @@
 
 #include <meteoio/MeteoIO.h>
 #include <snowpack/plugins/SnowpackIOInterface.h>
+#include <snowpack/plugins/ProfileStore.h>
 
 class AsciiIO : public SnowpackIOInterface {
 
@@ -61,15 +62,17 @@ class AsciiIO : public SnowpackIOInterface {
 		std::string getFilenamePrefix(const std::string& fnam, const std::string& path, const bool addexp=true) const;
 
 		void writeMETHeader(const SnowStation& Xdata, std::ofstream &fout) const;
-		void writeProHeader(const SnowStation& Xdata, std::ofstream &fout) const;
+		void writeProHeader(const SnowStation& Xdata, std::ostream &fout) const;
 		void writePrfHeader(const SnowStation& Xdata, std::ofstream &fout) const;
 		bool checkHeader(const SnowStation& Xdata, const std::string& filename, const std::string& ext, const std::string& signature) const;
 
+		void getProfileColumns(const mio::Date& date, const SnowStation& Xdata, ProfileStore::ProfileRecord& record) const;
 		void writeProfilePro(const mio::Date& date, const SnowStation& Xdata, const bool& aggregate);
 		void writeProfileProAddDefault(const SnowStation& Xdata, std::ofstream &fout);
 		void writeProfileProAddCalibration(const SnowStation& Xdata, std::ofstream &fout);
 
 		void writeProfilePrf(const mio::Date& date, const SnowStation& Xdata, const bool& aggregate);
+		void writeProfileProb(const mio::Date& date, const SnowStation& Xdata);
 
 		size_t writeTemperatures(std::ofstream &fout, const double& z_vert, const double& T,
 		                         const size_t& ii, const SnowStation& Xdata);
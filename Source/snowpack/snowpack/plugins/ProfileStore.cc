@@ -0,0 +1,534 @@
+/*
+ *  SNOWPACK stand-alone
+ *
+ *  Copyright WSL Institute for Snow and Avalanche Research SLF, DAVOS, SWITZERLAND
+*/
+/*  This file is part of Snowpack.
+    Snowpack is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Snowpack is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Snowpack.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <snowpack/plugins/ProfileStore.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace mio;
+
+const char ProfileStore::magic[8] = {'S', 'N', 'P', 'R', 'O', 'B', '0', '1'};
+const char ProfileStore::index_magic[8] = {'S', 'N', 'P', 'R', 'I', 'D', 'X', '1'};
+
+static const size_t record_header_size = sizeof(unsigned long long) + 2*sizeof(double) + sizeof(unsigned int); //size, julian, timezone, number of columns
+static const size_t column_info_size = 2*sizeof(unsigned int) + sizeof(unsigned long long); //code, count, offset
+static const double date_epsilon = 1.e-5; //dates closer than this (in days) are considered equal
+
+static bool compareIndex(const std::pair<double, unsigned long long>& a, const std::pair<double, unsigned long long>& b)
+{
+	return a.first < b.first;
+}
+
+template <class T> static void pushBytes(std::vector<char>& buffer, const T& value)
+{
+	const char *bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes+sizeof(T));
+}
+
+const ProfileStore::ProfileColumn* ProfileStore::PROFILE_RECORD::getColumn(const unsigned int& code) const
+{
+	for (size_t ii=0; ii<columns.size(); ii++) {
+		if (columns[ii].code == code) return &columns[ii];
+	}
+	return NULL;
+}
+
+ProfileStore::ProfileStore(const std::string& i_filename)
+             : index(), filename(i_filename), index_filename(i_filename+".idx"), data_start(0), index_read(false)
+{}
+
+/**
+ * @brief Does the file exist?
+ */
+bool ProfileStore::exists() const
+{
+	return FileUtils::fileExists(filename);
+}
+
+/**
+ * @brief Create a new file (any existing file is overwritten)
+ * @param header header of the profiles time series, in the PRO format (ie. up to the [DATA] line)
+ */
+void ProfileStore::create(const std::string& header)
+{
+	std::ofstream fout(filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (fout.fail()) throw AccessException(filename, AT);
+	const unsigned long long header_size = static_cast<unsigned long long>( header.size() );
+	fout.write(magic, sizeof(magic));
+	fout.write(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+	fout.write(header.c_str(), static_cast<std::streamsize>(header.size()));
+	if (fout.fail()) throw AccessException("Could not write "+filename, AT);
+	fout.close();
+
+	std::ofstream fidx(index_filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (fidx.fail()) throw AccessException(index_filename, AT);
+	fidx.write(index_magic, sizeof(index_magic));
+
+	index.clear();
+	data_start = sizeof(magic) + sizeof(header_size) + header_size;
+	index_read = true;
+}
+
+/**
+ * @brief Append a profile at the end of the file
+ * @param record profile to append (its date should be after the dates already in the file)
+ */
+void ProfileStore::append(const ProfileRecord& record)
+{
+	//build the whole record in memory, so it is written in one go
+	std::vector<char> buffer;
+	const size_t ncols = record.columns.size();
+	unsigned long long values_offset = record_header_size + ncols*column_info_size;
+	size_t nvalues = 0;
+	for (size_t ii=0; ii<ncols; ii++) nvalues += record.columns[ii].values.size();
+	const unsigned long long record_size = values_offset + nvalues*sizeof(float);
+	buffer.reserve( static_cast<size_t>(record_size) );
+
+	pushBytes(buffer, record_size);
+	pushBytes(buffer, record.date.getJulian(true));
+	pushBytes(buffer, record.date.getTimeZone());
+	pushBytes(buffer, static_cast<unsigned int>(ncols));
+	for (size_t ii=0; ii<ncols; ii++) {
+		pushBytes(buffer, record.columns[ii].code);
+		pushBytes(buffer, static_cast<unsigned int>(record.columns[ii].values.size()));
+		pushBytes(buffer, values_offset);
+		values_offset += record.columns[ii].values.size()*sizeof(float);
+	}
+	for (size_t ii=0; ii<ncols; ii++) {
+		const std::vector<double>& values = record.columns[ii].values;
+		for (size_t jj=0; jj<values.size(); jj++) pushBytes(buffer, static_cast<float>(values[jj]));
+	}
+
+	std::fstream fout(filename.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+	if (fout.fail()) throw AccessException(filename, AT);
+	fout.seekp(0, std::ios::end);
+	const unsigned long long offset = static_cast<unsigned long long>( fout.tellp() );
+	fout.write(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+	if (fout.fail()) throw AccessException("Could not write "+filename, AT);
+	fout.close();
+
+	std::ofstream fidx(index_filename.c_str(), std::ios::binary | std::ios::app);
+	if (!fidx.fail()) { //the index is only an optimization, it will be rebuilt if necessary
+		const double julian = record.date.getJulian(true);
+		fidx.write(reinterpret_cast<const char*>(&julian), sizeof(julian));
+		fidx.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+	}
+
+	if (index_read) {
+		const std::pair<double, unsigned long long> entry( record.date.getJulian(true), offset );
+		if (index.empty() || index.back().first <= entry.first) index.push_back(entry);
+		else index_read = false; //out of order, it will be sorted when reading it again
+	}
+}
+
+/**
+ * @brief Remove all the profiles at or after a given date, in order to restart a simulation from this date.
+ * This mirrors what is done for the PRO files: if there are no profiles left, the file should be recreated.
+ * @param date date of the first profile to remove
+ * @return true if some profiles are left in the file (so new profiles can be appended), false if the file should be recreated
+ */
+bool ProfileStore::truncate(const mio::Date& date)
+{
+	try {
+		readIndex();
+	} catch (const mio::IOException&) {
+		return false; //not a valid file, it has to be recreated
+	}
+
+	const double julian = date.getJulian(true) - date_epsilon;
+	size_t first_removed = 0;
+	while (first_removed < index.size() && index[first_removed].first < julian) first_removed++;
+	if (first_removed == 0) return false;
+	if (first_removed == index.size()) return true;
+
+	//copy the profiles to keep into a temporary file
+	const unsigned long long end_offset = index[first_removed].second;
+	const std::string tmp_filename( filename + ".tmp" );
+	{
+		std::ifstream fin;
+		openData(fin);
+		std::ofstream fout(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+		if (fout.fail()) throw AccessException(tmp_filename, AT);
+		std::vector<char> buffer(1024*1024);
+		unsigned long long remaining = end_offset;
+		while (remaining > 0) {
+			const size_t chunk = static_cast<size_t>( std::min(remaining, static_cast<unsigned long long>(buffer.size())) );
+			fin.read(&buffer[0], static_cast<std::streamsize>(chunk));
+			fout.write(&buffer[0], static_cast<std::streamsize>(chunk));
+			if (fin.fail() || fout.fail()) throw AccessException("Could not truncate "+filename, AT);
+			remaining -= chunk;
+		}
+	}
+	if (std::remove(filename.c_str()) != 0 || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+		throw AccessException("Could not replace "+filename+" by "+tmp_filename, AT);
+
+	index.resize(first_removed);
+	std::ofstream fidx(index_filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (fidx.fail()) throw AccessException(index_filename, AT);
+	fidx.write(index_magic, sizeof(index_magic));
+	for (size_t ii=0; ii<index.size(); ii++) {
+		fidx.write(reinterpret_cast<const char*>(&index[ii].first), sizeof(index[ii].first));
+		fidx.write(reinterpret_cast<const char*>(&index[ii].second), sizeof(index[ii].second));
+	}
+	return true;
+}
+
+/**
+ * @brief Open the data file and check its signature
+ */
+void ProfileStore::openData(std::ifstream& fin) const
+{
+	fin.open(filename.c_str(), std::ios::binary);
+	if (fin.fail()) throw AccessException(filename, AT);
+	char file_magic[8];
+	fin.read(file_magic, sizeof(file_magic));
+	if (fin.fail() || memcmp(file_magic, magic, sizeof(magic)) != 0)
+		throw InvalidFormatException("'"+filename+"' is not a binary profiles file", AT);
+	fin.seekg(0);
+}
+
+/**
+ * @brief Read the index file, and complete it by going through the profiles that it does not list (if any)
+ */
+void ProfileStore::readIndex()
+{
+	if (index_read) return;
+
+	std::ifstream fin;
+	openData(fin);
+	unsigned long long header_size;
+	fin.seekg(sizeof(magic));
+	fin.read(reinterpret_cast<char*>(&header_size), sizeof(header_size));
+	if (fin.fail()) throw InvalidFormatException("Could not read the header of "+filename, AT);
+	data_start = sizeof(magic) + sizeof(header_size) + header_size;
+	fin.seekg(0, std::ios::end);
+	const unsigned long long file_size = static_cast<unsigned long long>( fin.tellg() );
+
+	std::vector< std::pair<double, unsigned long long> > entries;
+	std::ifstream fidx(index_filename.c_str(), std::ios::binary);
+	char file_magic[8];
+	if (!fidx.fail() && fidx.read(file_magic, sizeof(file_magic)) && memcmp(file_magic, index_magic, sizeof(index_magic)) == 0) {
+		double julian;
+		unsigned long long offset;
+		while (fidx.read(reinterpret_cast<char*>(&julian), sizeof(julian)) && fidx.read(reinterpret_cast<char*>(&offset), sizeof(offset))) {
+			if (offset < data_start || offset >= file_size) break; //the index does not match the data file anymore
+			entries.push_back( std::make_pair(julian, offset) );
+		}
+	}
+
+	//go through the profiles that are not in the index, if any
+	unsigned long long offset = data_start;
+	if (!entries.empty()) {
+		unsigned long long record_size;
+		fin.seekg( static_cast<std::streamoff>(entries.back().second) );
+		fin.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+		if (fin.fail()) throw InvalidFormatException("Invalid profile record in "+filename, AT);
+		offset = entries.back().second + record_size;
+	}
+	while (offset + record_header_size <= file_size) {
+		unsigned long long record_size;
+		double julian;
+		fin.seekg( static_cast<std::streamoff>(offset) );
+		fin.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+		fin.read(reinterpret_cast<char*>(&julian), sizeof(julian));
+		if (fin.fail() || record_size < record_header_size || offset + record_size > file_size) break; //truncated record
+		entries.push_back( std::make_pair(julian, offset) );
+		offset += record_size;
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), compareIndex);
+	index.swap(entries);
+	index_read = true;
+}
+
+/**
+ * @brief Read the date and the table of columns of a profile record
+ * @return false if the record could not be read
+ */
+bool ProfileStore::readRecordInfo(std::ifstream& fin, const unsigned long long& offset, mio::Date& date, std::vector<ColumnInfo>& info) const
+{
+	unsigned long long record_size;
+	double julian, time_zone;
+	unsigned int ncols;
+	fin.seekg( static_cast<std::streamoff>(offset) );
+	fin.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+	fin.read(reinterpret_cast<char*>(&julian), sizeof(julian));
+	fin.read(reinterpret_cast<char*>(&time_zone), sizeof(time_zone));
+	fin.read(reinterpret_cast<char*>(&ncols), sizeof(ncols));
+	if (fin.fail()) return false;
+	date.setDate(julian, 0.);
+	date.setTimeZone(time_zone);
+
+	std::vector<char> buffer(ncols*column_info_size);
+	if (ncols > 0) fin.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+	if (fin.fail()) return false;
+	info.resize(ncols);
+	for (size_t ii=0; ii<ncols; ii++) {
+		const char *ptr = &buffer[ii*column_info_size];
+		memcpy(&info[ii].code, ptr, sizeof(unsigned int));
+		memcpy(&info[ii].count, ptr+sizeof(unsigned int), sizeof(unsigned int));
+		memcpy(&info[ii].offset, ptr+2*sizeof(unsigned int), sizeof(unsigned long long));
+		info[ii].offset += offset; //from now on, this is an absolute position in the file
+		if (info[ii].offset + info[ii].count*sizeof(float) > offset + record_size) return false;
+	}
+	return true;
+}
+
+void ProfileStore::readColumn(std::ifstream& fin, const ColumnInfo& info, std::vector<double>& values)
+{
+	std::vector<float> buffer(info.count);
+	fin.seekg( static_cast<std::streamoff>(info.offset) );
+	if (info.count > 0) fin.read(reinterpret_cast<char*>(&buffer[0]), static_cast<std::streamsize>(info.count*sizeof(float)));
+	if (fin.fail()) throw InvalidFormatException("Could not read a profile column", AT);
+	values.assign(buffer.begin(), buffer.end());
+}
+
+/**
+ * @brief Get the header of the profiles time series, in the PRO format (ie. up to the [DATA] line)
+ */
+std::string ProfileStore::getHeader()
+{
+	std::ifstream fin;
+	openData(fin);
+	unsigned long long header_size;
+	fin.seekg(sizeof(magic));
+	fin.read(reinterpret_cast<char*>(&header_size), sizeof(header_size));
+	if (fin.fail()) throw InvalidFormatException("Could not read the header of "+filename, AT);
+	std::string header( static_cast<size_t>(header_size), '\0' );
+	if (header_size > 0) fin.read(&header[0], static_cast<std::streamsize>(header_size));
+	if (fin.fail()) throw InvalidFormatException("Could not read the header of "+filename, AT);
+	return header;
+}
+
+/**
+ * @brief Get the dates of all the profiles contained in the file
+ */
+std::vector<mio::Date> ProfileStore::getDates()
+{
+	readIndex();
+	std::vector<mio::Date> dates;
+	dates.reserve(index.size());
+	std::ifstream fin;
+	openData(fin);
+	std::vector<ColumnInfo> info;
+	for (size_t ii=0; ii<index.size(); ii++) {
+		mio::Date date;
+		if (!readRecordInfo(fin, index[ii].second, date, info))
+			throw InvalidFormatException("Invalid profile record in "+filename, AT);
+		dates.push_back(date);
+	}
+	return dates;
+}
+
+/**
+ * @brief Read the profile at a given date
+ * @param date date of the profile
+ * @param record all the codes of the profile
+ * @return false if there is no profile at this date
+ */
+bool ProfileStore::readProfile(const mio::Date& date, ProfileRecord& record)
+{
+	readIndex();
+	const double julian = date.getJulian(true);
+	const std::vector< std::pair<double, unsigned long long> >::const_iterator it = std::lower_bound(index.begin(), index.end(), std::make_pair(julian-date_epsilon, 0ULL), compareIndex);
+	if (it == index.end() || it->first > julian+date_epsilon) return false;
+
+	std::ifstream fin;
+	openData(fin);
+	std::vector<ColumnInfo> info;
+	if (!readRecordInfo(fin, it->second, record.date, info))
+		throw InvalidFormatException("Invalid profile record in "+filename, AT);
+	record.columns.resize(info.size());
+	for (size_t ii=0; ii<info.size(); ii++) {
+		record.columns[ii].code = info[ii].code;
+		readColumn(fin, info[ii], record.columns[ii].values);
+	}
+	return true;
+}
+
+/**
+ * @brief Only keep the layers whose top height lies within [z_min, z_max]
+ * @details The values of a code are assumed to match the topmost heights of the code 0501 (this is the case for all the per layer codes).
+ */
+std::vector<double> ProfileStore::selectLayers(const std::vector<double>& values, const std::vector<double>& z,
+                                               const double& z_min, const double& z_max, std::vector<double>& layer_z)
+{
+	layer_z.clear();
+	if (values.size() > z.size()) { //this is not a per layer code, the heights can not be used
+		if (z_min != IOUtils::nodata || z_max != IOUtils::nodata) return std::vector<double>();
+		return values;
+	}
+
+	std::vector<double> selected;
+	const size_t z_start = z.size() - values.size();
+	for (size_t ii=0; ii<values.size(); ii++) {
+		const double height = z[z_start + ii];
+		if (z_min != IOUtils::nodata && height < z_min) continue;
+		if (z_max != IOUtils::nodata && height > z_max) continue;
+		selected.push_back(values[ii]);
+		layer_z.push_back(height);
+	}
+	return selected;
+}
+
+/**
+ * @brief Read the time series of one profile code.
+ * Only the requested code and the heights (code 0501) are read from each profile.
+ * @param code profile code to read (for example, 502 for the densities)
+ * @param start_date start of the period to read
+ * @param end_date end of the period to read
+ * @param z_min only keep the layers whose top is higher than this (in cm, as for the code 0501), IOUtils::nodata to keep all layers
+ * @param z_max only keep the layers whose top is lower than this (in cm, as for the code 0501), IOUtils::nodata to keep all layers
+ * @param dates dates of the profiles that contain this code
+ * @param heights for each date, the top height of each returned layer (in cm)
+ * @param values for each date, the values of the returned layers
+ */
+void ProfileStore::readVariable(const unsigned int& code, const mio::Date& start_date, const mio::Date& end_date,
+                                const double& z_min, const double& z_max, std::vector<mio::Date>& dates,
+                                std::vector< std::vector<double> >& heights, std::vector< std::vector<double> >& values)
+{
+	readIndex();
+	dates.clear();
+	heights.clear();
+	values.clear();
+
+	const double start_julian = start_date.getJulian(true) - date_epsilon;
+	const double end_julian = end_date.getJulian(true) + date_epsilon;
+	std::ifstream fin;
+	openData(fin);
+	std::vector<ColumnInfo> info;
+	std::vector<double> z, column, layer_z;
+	for (size_t ii=0; ii<index.size(); ii++) {
+		if (index[ii].first < start_julian) continue;
+		if (index[ii].first > end_julian) break;
+
+		mio::Date date;
+		if (!readRecordInfo(fin, index[ii].second, date, info))
+			throw InvalidFormatException("Invalid profile record in "+filename, AT);
+		const ColumnInfo *z_info = NULL, *col_info = NULL;
+		for (size_t jj=0; jj<info.size(); jj++) {
+			if (info[jj].code == 501) z_info = &info[jj];
+			if (info[jj].code == code) col_info = &info[jj];
+		}
+		if (col_info == NULL) continue;
+
+		if (z_info != NULL) readColumn(fin, *z_info, z);
+		else z.clear();
+		readColumn(fin, *col_info, column);
+
+		dates.push_back(date);
+		values.push_back( selectLayers(column, z, z_min, z_max, layer_z) );
+		heights.push_back(layer_z);
+	}
+}
+
+/**
+ * @brief Convert a PRO file into a binary profiles file
+ * @param pro_filename PRO file to read
+ * @param prob_filename binary profiles file to create (the file is overwritten if it exists)
+ * @param time_zone time zone of the dates in the PRO file
+ */
+void ProfileStore::fromPro(const std::string& pro_filename, const std::string& prob_filename, const double& time_zone)
+{
+	std::ifstream fin(pro_filename.c_str());
+	if (fin.fail()) throw AccessException(pro_filename, AT);
+	const char eoln = FileUtils::getEoln(fin);
+
+	std::string line, header;
+	bool data_started = false;
+	while (!data_started && getline(fin, line, eoln)) {
+		std::string trimmed( line );
+		IOUtils::trim(trimmed);
+		if (trimmed == "[DATA]") data_started = true;
+		else header += line + "\n";
+	}
+	if (!data_started) throw InvalidFormatException("No [DATA] section found in "+pro_filename, AT);
+
+	ProfileStore store(prob_filename);
+	store.create(header);
+
+	ProfileRecord record;
+	bool has_record = false;
+	std::vector<std::string> vecTmp;
+	while (getline(fin, line, eoln)) {
+		if (IOUtils::readLineToVec(line, vecTmp, ',') < 2) continue;
+		unsigned int code;
+		if (!IOUtils::convertString(code, vecTmp[0])) throw InvalidFormatException("Invalid code '"+vecTmp[0]+"' in "+pro_filename, AT);
+
+		if (code == 500) {
+			if (has_record) store.append(record);
+			if (vecTmp[1].length() < 16) throw InvalidFormatException("Invalid date '"+vecTmp[1]+"' in "+pro_filename, AT);
+			const std::string tmpdate = vecTmp[1].substr(6,4) + "-" + vecTmp[1].substr(3,2) + "-" + vecTmp[1].substr(0,2)
+			                 + "T" + vecTmp[1].substr(11,5);
+			IOUtils::convertString(record.date, tmpdate, time_zone);
+			record.columns.clear();
+			has_record = true;
+		} else if (has_record) {
+			ProfileColumn column(code);
+			column.values.resize(vecTmp.size()-2);
+			for (size_t ii=2; ii<vecTmp.size(); ii++) {
+				if (!IOUtils::convertString(column.values[ii-2], vecTmp[ii]))
+					throw InvalidFormatException("Invalid value '"+vecTmp[ii]+"' in "+pro_filename, AT);
+			}
+			record.columns.push_back(column);
+		}
+	}
+	if (has_record) store.append(record);
+}
+
+/**
+ * @brief Convert a binary profiles file into a PRO file
+ * @details The values are written with up to 6 significant digits, so the resulting file is equivalent to the PRO file
+ * written by %Snowpack but not necessarily identical.
+ * @param prob_filename binary profiles file to read
+ * @param pro_filename PRO file to create (the file is overwritten if it exists)
+ */
+void ProfileStore::toPro(const std::string& prob_filename, const std::string& pro_filename)
+{
+	ProfileStore store(prob_filename);
+	store.readIndex();
+
+	std::ofstream fout(pro_filename.c_str());
+	if (fout.fail()) throw AccessException(pro_filename, AT);
+	fout << std::setprecision(7); //enough for the float32 values without printing their rounding noise
+	fout << store.getHeader() << "[DATA]";
+
+	std::ifstream fin;
+	store.openData(fin);
+	std::vector<ColumnInfo> info;
+	std::vector<double> values;
+	for (size_t ii=0; ii<store.index.size(); ii++) {
+		mio::Date date;
+		if (!store.readRecordInfo(fin, store.index[ii].second, date, info))
+			throw InvalidFormatException("Invalid profile record in "+prob_filename, AT);
+		fout << "\n0500," << date.toString(Date::DIN);
+		for (size_t jj=0; jj<info.size(); jj++) {
+			readColumn(fin, info[jj], values);
+			fout << "\n" << std::setfill('0') << std::setw(4) << info[jj].code << std::setfill(' ') << "," << values.size();
+			for (size_t kk=0; kk<values.size(); kk++) fout << "," << values[kk];
+		}
+	}
+	if (fout.fail()) throw AccessException("Could not write "+pro_filename, AT);
+}
@@ -0,0 +1,116 @@
+/*
+ *  SNOWPACK stand-alone
+ *
+ *  Copyright WSL Institute for Snow and Avalanche Research SLF, DAVOS, SWITZERLAND
+*/
+/*  This file is part of Snowpack.
+    Snowpack is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Snowpack is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Snowpack.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILESTORE_H
+#define PROFILESTORE_H
+
+#include <meteoio/MeteoIO.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @page prob_format PROB binary profiles time series
+ * @section prob_structure General structure
+ * This is a binary version of the \ref pro_format "PRO" format: it contains the same header and the same profile codes, but each
+ * profile is written as a binary record where each code is stored as a contiguous column of values. An index file (with the same name
+ * and an additional <i>".idx"</i> extension) gives the date and the position of each profile, so a profile can be read at a given date
+ * or a variable can be extracted over a time period without having to go through the whole file. The index is only an optimization:
+ * if it is missing or incomplete, it is rebuilt in memory by hopping from record to record.
+ *
+ * The binary file is made of:
+ * - an 8 bytes signature ("SNPROB01") followed by the size of the header and the header itself, exactly as it is written in the PRO
+ *   format (ie. up to the <i>[DATA]</i> line);
+ * - for each profile, the size of the record, the date (as GMT julian date and time zone), the number of codes and for each code,
+ *   its number, its number of values and its offset within the record, followed by all the values as 32 bits floating point numbers.
+ *
+ * The values are stored in the units of the PRO format. All integers and floating point numbers are written in the native byte order
+ * of the machine.
+ *
+ * The ProfileStore class can be used to read such files, either a full profile at a given date or the time series of one
+ * variable (within a given range of heights), as well as to convert them from and to the PRO format.
+ *
+ * @section prob_keywords Keywords
+ * This plugin is enabled by adding PROB to the PROF_FORMAT key in the [Output] section. It uses the same keywords as the
+ * \ref pro_format "PRO" format, but the calibration (VARIANT = CALIBRATION) and the solute (OUT_LOAD) profiles are not written.
+ */
+
+/**
+ * @class ProfileStore
+ * @brief Reading and writing of binary profiles time series (see \ref prob_format)
+ */
+class ProfileStore {
+	public:
+		///all the values of one profile code
+		typedef struct PROFILE_COLUMN {
+			PROFILE_COLUMN() : code(0), values() {}
+			PROFILE_COLUMN(const unsigned int& i_code) : code(i_code), values() {}
+			unsigned int code;
+			std::vector<double> values;
+		} ProfileColumn;
+
+		///one profile, made of all its codes
+		typedef struct PROFILE_RECORD {
+			PROFILE_RECORD() : date(), columns() {}
+			const ProfileColumn* getColumn(const unsigned int& code) const;
+			mio::Date date;
+			std::vector<ProfileColumn> columns;
+		} ProfileRecord;
+
+		ProfileStore(const std::string& i_filename);
+
+		bool exists() const;
+		void create(const std::string& header);
+		void append(const ProfileRecord& record);
+		bool truncate(const mio::Date& date);
+
+		std::string getHeader();
+		std::vector<mio::Date> getDates();
+		bool readProfile(const mio::Date& date, ProfileRecord& record);
+		void readVariable(const unsigned int& code, const mio::Date& start_date, const mio::Date& end_date,
+		                  const double& z_min, const double& z_max, std::vector<mio::Date>& dates,
+		                  std::vector< std::vector<double> >& heights, std::vector< std::vector<double> >& values);
+
+		static void fromPro(const std::string& pro_filename, const std::string& prob_filename, const double& time_zone);
+		static void toPro(const std::string& prob_filename, const std::string& pro_filename);
+
+	private:
+		typedef struct COLUMN_INFO {
+			unsigned int code, count;
+			unsigned long long offset;
+		} ColumnInfo;
+
+		void readIndex();
+		void openData(std::ifstream& fin) const;
+		bool readRecordInfo(std::ifstream& fin, const unsigned long long& offset, mio::Date& date, std::vector<ColumnInfo>& info) const;
+		static void readColumn(std::ifstream& fin, const ColumnInfo& info, std::vector<double>& values);
+		static std::vector<double> selectLayers(const std::vector<double>& values, const std::vector<double>& z,
+		                                        const double& z_min, const double& z_max, std::vector<double>& layer_z);
+
+		static const char magic[8], index_magic[8];
+
+		std::vector< std::pair<double, unsigned long long> > index; ///< GMT julian date and position of each profile, sorted by date
+		std::string filename, index_filename;
+		unsigned long long data_start; ///< position of the first profile
+		bool index_read;
+};
+
+#endif
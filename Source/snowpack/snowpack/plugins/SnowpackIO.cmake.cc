@@ -88,8 +88,8 @@ SnowpackIO::SnowpackIO(const SnowpackConfig& cfg):
 	}
 
 	const std::vector<string> vecProfileFmt = cfg.get("PROF_FORMAT", "Output");
-	if (vecProfileFmt.size() > 3) {
-		throw InvalidArgumentException("The key PROF_FORMAT in [Output] can take three values at most", AT);
+	if (vecProfileFmt.size() > 4) {
+		throw InvalidArgumentException("The key PROF_FORMAT in [Output] can take four values at most", AT);
 	} else {
 		for (size_t ii=0; ii<vecProfileFmt.size(); ii++) {
 			if (vecProfileFmt[ii] == "PRO") {
@@ -100,10 +100,13 @@ SnowpackIO::SnowpackIO(const SnowpackConfig& cfg):
 				output_prf_as_ascii  = true;
 				vecExtension.push_back("prf");	//Time series of full modeled snow-profile data in tabular form
 				vecExtension.push_back("aprf");	//Time series of aggregated modeled snow-profile data in tabular form
+			} else if (vecProfileFmt[ii] == "PROB") {
+				output_prf_as_ascii  = true;
+				vecExtension.push_back("prob");	//Time series of full modeled snow-profile data in binary form
 			} else if (vecProfileFmt[ii] == "IMIS") {
 				output_prf_as_imis  = true;
 			} else {
-				throw InvalidArgumentException("The key PROF_FORMAT in [Output] takes only PRO, PRF or IMIS as value", AT);
+				throw InvalidArgumentException("The key PROF_FORMAT in [Output] takes only PRO, PRF, PROB or IMIS as value", AT);
 			}
 		}
 	}
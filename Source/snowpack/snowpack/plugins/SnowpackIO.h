@@ -84,6 +84,7 @@
  * <tr><th>Key</th><th>Description</th><th>Extra requirements</th></tr>
  * <tr><td>\subpage pro_format "PRO"</td><td>legacy %Snowpack profile time series for visualization with <A HREF="snopviz.org">SnopViz</A> and sngui</td><td></td></tr>
  * <tr><td>\subpage prf_format "PRF"</td><td>tabular profile time series</td><td></td></tr>
+ * <tr><td>\subpage prob_format "PROB"</td><td>binary version of the PRO profile time series, indexed for fast extraction</td><td></td></tr>
  * <tr><td>\subpage profile_imis "IMIS"</td><td>write profile time series to the IMIS database</td><td><A HREF="http://docs.oracle.com/cd/B12037_01/appdev.101/b10778/introduction.htm">Oracle's OCCI library</A></td></tr>
  * </table></center>
  * 
@@ -1574,6 +1574,7 @@ void Canopy::CanopyRadiationOutput(SnowStation& Xdata, const CurrentMeteo& Mdata
  */
 bool Canopy::runCanopyModel(CurrentMeteo &Mdata, SnowStation &Xdata, const double& roughness_length, const double& height_of_wind_val, const bool& adjust_VW_height)
 {
+	MIO_TRACE_ZONE("Snowpack", "runCanopyModel");
 	Twolayercanopy = Twolayercanopy_user; //so we can temporarily overwrite the user's choice if needed
 	const double hs = Xdata.cH - Xdata.Ground;
 	const size_t nE = Xdata.getNumberOfElements();
@@ -447,6 +447,7 @@ void PhaseChange::finalize(const SurfaceFluxes& Sdata, SnowStation& Xdata, const
  */
 double PhaseChange::compPhaseChange(SnowStation& Xdata, const mio::Date& date_in, const bool& verbose, const double& surf_melt)
 {
+	MIO_TRACE_ZONE("Snowpack", "compPhaseChange");
 	size_t e, nE;
 	double ql_Rest;
 	ElementData* EMS;
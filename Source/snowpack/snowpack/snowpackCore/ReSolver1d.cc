@@ -1092,6 +1092,8 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 	}
 
 	SalinityTransport Salinity(nE);
+	std::vector<double> DeltaSal(nE, 0.);		//Salinity changes
+	std::vector<double> DeltaSal2(nE, 0.);		//Salinity changes
 
 	//Note: there are 2 iterations. First, the iteration starts to match the Richards solver time step to the SNOWPACK time step. Simple example: assume SNOWPACK time step is 15 minutes and
 	//Richards solver time step is 1 minute, there should be 15 iterations to match the solution to the SNOWPACK time step.
@@ -1558,17 +1560,7 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 
 			r_mpfd = AssembleRHS(lowernode, uppernode, h_np1_m, theta_n, theta_np1_m, theta_i_n, theta_i_np1_m, s, dt, rho, k_np1_m_im12, k_np1_m_ip12, aTopBC, TopFluxRate, aBottomBC, BottomFluxRate, Xdata, Salinity, SALINITY_MIXING);
 			r_mpfd2 = r_mpfd;			// We make a copy for use with DGTSV and TDMA solvers.
-
-			// Check stability criterion for salinity transport for sea ice simulations
-			if(variant=="SEAICE") {
-				if(SalinityTransportSolver==SalinityTransport::EXPLICIT && Salinity.VerifyCFL(dt)==false) {
-					printf("CFL failed for dt=%.10f --> reducing time step\n", dt);
-					solver_result=-1;
-				} else if((SalinityTransportSolver==SalinityTransport::IMPLICIT || SalinityTransportSolver==SalinityTransport::IMPLICIT2) && Salinity.VerifyImplicitDt(dt)==false) {
-					printf("ImplicitLimit failed for dt=%.10f --> reducing time step\n", dt);
-					solver_result=-1;
-				}
-			}
+			// Note: the salinity transport does not constrain the time step here, it is sub-cycled after the step has been accepted.
 
 
 			//Before solving the system of equations, reset convergence tracking variables:
@@ -1663,19 +1655,6 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 			}
 
 
-			if (Xdata.Seaice != NULL && solver_result != -1) {
-				AssembleRHS(lowernode, uppernode, h_np1_m, theta_n, theta_np1_m, theta_i_n, theta_i_np1_m, s, dt, rho, k_np1_m_im12, k_np1_m_ip12, aTopBC, TopFluxRate, aBottomBC, BottomFluxRate, Xdata, Salinity, SALINITY_MIXING);
-				if(SalinityTransportSolver==SalinityTransport::EXPLICIT && Salinity.VerifyCFL(dt)==false) {
-					printf("CFL failed for dt=%.10f @ second time\n", dt);
-					solver_result=-1;
-				}
-				if((SalinityTransportSolver==SalinityTransport::IMPLICIT || SalinityTransportSolver==SalinityTransport::IMPLICIT2) && Salinity.VerifyImplicitDt(dt)==false) {
-					printf("ImplicitLimit failed for dt=%.10f @ second time\n", dt);
-					solver_result=-1;
-				}
-			}
-
-
 			i = uppernode + 1;
 			while (i-- > lowernode) {
 				//Keep track of the maximum delta h, to detect possible model blow-ups.
@@ -2152,8 +2131,6 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 				//
 
 				// Set the SalinityTransport vector with the solution after liquid water flow
-				std::vector<double> DeltaSal(nE, 0.);							//Salinity changes
-				std::vector<double> DeltaSal2(nE, 0.);							//Salinity changes
 				for (i = lowernode; i <= uppernode; i++) {						//We loop over all Richards solver domain layers
 					Salinity.BrineSal[i] = EMS[i].salinity / theta_n[i];				//Calculate brine salinity
 					Salinity.theta1[i] = theta_n[i];
@@ -2162,12 +2139,8 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 				Salinity.BottomSalinity = (Xdata.Seaice->OceanSalinity);
 				Salinity.TopSalinity = (0.);
 
-				// Solve the transport equation
-				if(SalinityTransportSolver==SalinityTransport::EXPLICIT) {
-					Salinity.SolveSalinityTransportEquationExplicit(dt, DeltaSal);
-				} else {
-					Salinity.SolveSalinityTransportEquationImplicit(dt, DeltaSal, 0.5, (SalinityTransportSolver==SalinityTransport::IMPLICIT2));
-				}
+				// Solve the transport equation, sub-cycling it within the accepted time step if required
+				Salinity.SolveSalinityTransportEquation(dt, DeltaSal, SalinityTransportSolver);
 
 				// Apply and verify solution
 				const double tol = 0.;
@@ -2193,11 +2166,7 @@ void ReSolver1d::SolveRichardsEquation(SnowStation& Xdata, SurfaceFluxes& Sdata,
 						//Salinity.D[i] = 0.;
 					}
 					// Solve the transport equation
-					if(SalinityTransportSolver==SalinityTransport::EXPLICIT) {
-						Salinity.SolveSalinityTransportEquationExplicit(dt, DeltaSal2);
-					} else {
-						Salinity.SolveSalinityTransportEquationImplicit(dt, DeltaSal2, 0.5, SalinityTransportSolver==SalinityTransport::IMPLICIT2);
-					}
+					Salinity.SolveSalinityTransportEquation(dt, DeltaSal2, SalinityTransportSolver);
 				}
 
 				// Apply and verify solution
@@ -22,6 +22,7 @@
 #include <snowpack/snowpackCore/ReSolver1d.h>
 #include <snowpack/Utils.h>
 #include <stdio.h>
+#include <algorithm>
 
 static const bool ZeroFluxLowerBoundary_diffusion = false;
 static const bool ZeroFluxUpperBoundary_diffusion = true;
@@ -67,7 +68,7 @@ static const bool ZeroFluxUpperBoundary_advection_out = true;	// For outgoing fl
  */
 SalinityTransport::SalinityTransport(const size_t nE)
            : flux_up(), flux_down(), flux_up_2(), flux_down_2(),dz_(), dz_up(), dz_down(), theta1(), theta2(), BrineSal(), D(), sb(), BottomSalinity(0.), TopSalinity(0.),
-	     BottomSalFlux(0.), TopSalFlux(0.), NumberOfElements(0)
+	     BottomSalFlux(0.), TopSalFlux(0.), NumberOfElements(0), ad(), adu(), adl(), b(), b_(), theta_start(), theta_end(), sb_total(), DeltaSal_step()
 {
 	SetDomainSize(nE);
 }
@@ -93,6 +94,16 @@ void SalinityTransport::SetDomainSize(size_t nE) {
 	BrineSal.resize(nE, 0.);
 	D.resize(nE, 0.);
 	sb.resize(nE, 0.);
+
+	ad.resize(nE, 0.);
+	adu.resize((nE>0)?(nE-1):(0), 0.);
+	adl.resize((nE>0)?(nE-1):(0), 0.);
+	b.resize(nE, 0.);
+	b_.resize(nE, 0.);
+	theta_start.resize(nE, 0.);
+	theta_end.resize(nE, 0.);
+	sb_total.resize(nE, 0.);
+	DeltaSal_step.resize(nE, 0.);
 	return;
 }
 
@@ -120,11 +131,11 @@ bool SalinityTransport::SolveSalinityTransportEquationImplicit(const double dt,
 	const bool UpstreamBoundaries = true;
 	if(WriteDebugOutput) setvbuf(stdout, NULL, _IONBF, 0);
 
-	// Declare and initialize l.h.s. matrix and r.h.s. vector
-	std::vector<double> ad(NumberOfElements, 0.);		// Matrix diagonal
-	std::vector<double> adu(NumberOfElements-1, 0.);	// Matrix upper diagonal
-	std::vector<double> adl(NumberOfElements-1, 0.);	// Matrix lower diagonal
-	std::vector<double> b(NumberOfElements, 0.);		// Vector
+	// Initialize l.h.s. matrix and r.h.s. vector
+	std::fill(ad.begin(), ad.end(), 0.);			// Matrix diagonal
+	std::fill(adu.begin(), adu.end(), 0.);			// Matrix upper diagonal
+	std::fill(adl.begin(), adl.end(), 0.);			// Matrix lower diagonal
+	std::fill(b.begin(), b.end(), 0.);			// Vector
 
 	if((ZeroFluxUpperBoundary_advection_in && flux_up[NumberOfElements-1] > 0.)
 		|| (ZeroFluxUpperBoundary_advection_out && flux_up[NumberOfElements-1] < 0.)) flux_up[NumberOfElements-1] = 0.;
@@ -324,9 +335,9 @@ bool SalinityTransport::SolveSalinityTransportEquationImplicit(const double dt,
 	}
 #else
 	// Call TDMASolver: Thomas algorithm for tidiagonal matrices. Not the recommended choice, but useful when LAPACK is not available.
-	std::vector<double> b_ = b;
+	b_ = b;
 	const int ret = ReSolver1d::TDMASolver(matrixdimensions, &adl[0], &ad[0], &adu[0], &b[0], &b_[0]);
-	b=b_;
+	b.swap(b_);
 	if (ret != 0) {
 		std::cout << "[E] Error in SalinityTransport.cc: TDMA failed.\n";
 		std::cout << "    Using LAPACK (see compile options) may increase numerical stability in SalinityTransport.\n";
@@ -368,8 +379,8 @@ bool SalinityTransport::SolveSalinityTransportEquationExplicit(const double dt,
 	const bool WriteDebugOutput = false;
 	if(WriteDebugOutput) setvbuf(stdout, NULL, _IONBF, 0);
 
-	// Declare vectors
-	std::vector<double> b(NumberOfElements, 0.);		// Solution vector
+	// Initialize solution vector
+	std::fill(b.begin(), b.end(), 0.);
 
 	if((ZeroFluxUpperBoundary_advection_in && flux_up[NumberOfElements-1] > 0.)
 		|| (ZeroFluxUpperBoundary_advection_out && flux_up[NumberOfElements-1] < 0.)) flux_up[NumberOfElements-1] = 0.;
@@ -422,7 +433,7 @@ bool SalinityTransport::SolveSalinityTransportEquationExplicit(const double dt,
 		}
 		if(i==NumberOfElements-1) {
 			// Upper boundary advection
-			TopSalFlux    =  BrineSal[i] * flux_up[i] * dt - BrineSal[i] * flux_up_2[i] * dt +
+			TopSalFlux    += BrineSal[i] * flux_up[i] * dt - BrineSal[i] * flux_up_2[i] * dt +
 				tmp_flux   * dt * (  (tmp_flux   > 0.)   ?  ((TopSalinity - BrineSal[i]) / dz_down[i])  :  (0.)  ) +
 				tmp_flux_2 * dt * (  (tmp_flux_2 > 0.)   ?  ((TopSalinity - BrineSal[i]) / dz_down[i])  :  (0.)  );
 			// Upper boundary diffusion
@@ -483,3 +494,111 @@ bool SalinityTransport::VerifyImplicitDt(const double dt)
 	}
 	return true;
 }
+
+
+/**
+ * @brief Largest time step that satisfies the stability criterion of the given solver\n
+ * @details This is the same criterion as in SalinityTransport::VerifyCFL (explicit solver) or SalinityTransport::VerifyImplicitDt
+ * (implicit solvers), solved for the time step. For the diffusion part, the largest of theta1 and theta2 is used, so the criterion
+ * holds for all the sub-steps of a sub-cycled time step.
+ * @param solver Solver that will be used for the transport equation
+ * @return Maximum time step (s), or -1 if there is no limitation
+ */
+double SalinityTransport::GetMaxTimeStep(const SalinityTransportSolvers& solver) const
+{
+	const double limit = (solver==EXPLICIT) ? (0.499) : (0.999);
+	double max_rate = 0.;		// The criteria are of the form max_rate * dt <= limit
+	for(size_t i = 0; i < NumberOfElements; i++) {
+		const double min_dz = std::min(dz_up[i], dz_down[i]);
+		const double theta = std::max(theta1[i], theta2[i]);
+		if (solver==EXPLICIT) {
+			// Advection
+			max_rate = std::max(max_rate, std::max( fabs(flux_up[i]) , fabs(flux_down[i]) ) / min_dz);
+			max_rate = std::max(max_rate, std::max( fabs(flux_up_2[i]) , fabs(flux_down_2[i]) ) / min_dz);
+			// Diffusion
+			max_rate = std::max(max_rate, D[i] * theta / (min_dz * min_dz));
+		} else {
+			// Advection
+			max_rate = std::max(max_rate, std::max( fabs(flux_up[i])/dz_up[i] , fabs(flux_down[i]/dz_down[i]) ));
+			max_rate = std::max(max_rate, std::max( fabs(flux_up_2[i])/dz_up[i] , fabs(flux_down_2[i]/dz_down[i]) ));
+			// Diffusion
+			max_rate = std::max(max_rate, ((i==0) ? (D[i]) : (D[i] * theta)) / (min_dz * min_dz));
+		}
+	}
+	return (max_rate > 0.) ? (limit / max_rate) : (-1.);
+}
+
+
+/**
+ * @brief Number of sub-steps required to solve the transport equation over a time step while satisfying the stability criterion\n
+ * @param dt Time step (s)
+ * @param solver Solver that will be used for the transport equation
+ * @return Number of sub-steps (at least 1)
+ */
+size_t SalinityTransport::GetNumberOfSubSteps(const double dt, const SalinityTransportSolvers& solver) const
+{
+	static const size_t max_substeps = 10000;
+	const double max_dt = GetMaxTimeStep(solver);
+	if (max_dt < 0. || dt <= max_dt) return 1;
+
+	const double nr_substeps = ceil(dt / max_dt);
+	if (!(nr_substeps <= static_cast<double>(max_substeps))) {
+		std::cout << "[W] SalinityTransport.cc: " << nr_substeps << " sub-steps would be required for dt=" << dt << ", limiting to " << max_substeps << ".\n";
+		return max_substeps;
+	}
+	return static_cast<size_t>(nr_substeps);
+}
+
+
+/**
+ * @brief Solve the diffusion-advection equation for salinity over a time step of the liquid water flow\n
+ * @details The salinity transport is an operator-split stage of the water transport: the fluxes computed for the accepted Richards
+ * equation step are kept constant, while the liquid water content varies linearly from theta1 to theta2. The time step is split into as many
+ * sub-steps as required by the stability criterion of the chosen solver (see SalinityTransport::GetMaxTimeStep), so that the
+ * salinity transport does not constrain the time step of the Richards equation. The boundary fluxes are accumulated over all the sub-steps.
+ * @param dt Time step (s)
+ * @param DeltaSal Result vector (change in salinity over the whole time step)
+ * @param solver Solver for the transport equation
+ * @return false on error, true otherwise
+ */
+bool SalinityTransport::SolveSalinityTransportEquation(const double dt, std::vector <double>& DeltaSal, const SalinityTransportSolvers& solver)
+{
+	const size_t nr_substeps = GetNumberOfSubSteps(dt, solver);
+	if (nr_substeps == 1) {
+		if (solver==EXPLICIT) return SolveSalinityTransportEquationExplicit(dt, DeltaSal);
+		return SolveSalinityTransportEquationImplicit(dt, DeltaSal, 0.5, (solver==IMPLICIT2));
+	}
+
+	const double sub_dt = dt / static_cast<double>(nr_substeps);
+	for(size_t i = 0; i < NumberOfElements; i++) {
+		theta_start[i] = theta1[i];
+		theta_end[i] = theta2[i];
+		sb_total[i] = sb[i];
+		sb[i] /= static_cast<double>(nr_substeps);
+		DeltaSal[i] = 0.;
+	}
+
+	bool status = true;
+	for(size_t step = 0; step < nr_substeps && status; step++) {
+		const double f1 = static_cast<double>(step) / static_cast<double>(nr_substeps);
+		const double f2 = static_cast<double>(step + 1) / static_cast<double>(nr_substeps);
+		for(size_t i = 0; i < NumberOfElements; i++) {
+			theta1[i] = theta_start[i] + f1 * (theta_end[i] - theta_start[i]);
+			theta2[i] = (step + 1 == nr_substeps) ? (theta_end[i]) : (theta_start[i] + f2 * (theta_end[i] - theta_start[i]));
+		}
+
+		if (solver==EXPLICIT) {
+			status = SolveSalinityTransportEquationExplicit(sub_dt, DeltaSal_step);
+		} else {
+			status = SolveSalinityTransportEquationImplicit(sub_dt, DeltaSal_step, 0.5, (solver==IMPLICIT2));
+		}
+		for(size_t i = 0; i < NumberOfElements; i++) DeltaSal[i] += DeltaSal_step[i];
+	}
+
+	for(size_t i = 0; i < NumberOfElements; i++) {
+		theta1[i] = theta_start[i];
+		theta2[i] = theta_end[i];
+		sb[i] = sb_total[i];
+	}
+	return status;
+}
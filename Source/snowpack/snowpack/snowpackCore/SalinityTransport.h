@@ -34,13 +34,17 @@
 class SalinityTransport {
 
 	public:
+		enum SalinityTransportSolvers{EXPLICIT, IMPLICIT, IMPLICIT2};
+
 		SalinityTransport(size_t nE);		// Class constructor
 
 		bool VerifyCFL(const double dt);
 		bool VerifyImplicitDt(const double dt);
+		double GetMaxTimeStep(const SalinityTransportSolvers& solver) const;
+		size_t GetNumberOfSubSteps(const double dt, const SalinityTransportSolvers& solver) const;
+		bool SolveSalinityTransportEquation(const double dt, std::vector <double>& DeltaSal, const SalinityTransportSolvers& solver);
 		bool SolveSalinityTransportEquationImplicit(const double dt, std::vector <double>& DeltaSal, const double f, const bool DonorCell = true);	// Donor cell or central differences?
 		bool SolveSalinityTransportEquationExplicit(const double dt, std::vector <double>& DeltaSal);
-		enum SalinityTransportSolvers{EXPLICIT, IMPLICIT, IMPLICIT2};
 
 		std::vector<double> flux_up;		//Flux with element above (negative=upward, positive=downward)
 		std::vector<double> flux_down;		//Flux with element below (negative=upward, positive=downward)
@@ -62,5 +66,11 @@ class SalinityTransport {
 	private:
 		void SetDomainSize(size_t nE);
 		size_t NumberOfElements;
+
+		// Work arrays, kept between calls to avoid reallocating them at every time step
+		std::vector<double> ad, adu, adl, b, b_;	// Tridiagonal matrix and r.h.s. vector
+		std::vector<double> theta_start, theta_end;	// Vol. liquid water content at the start and end of a sub-cycled step
+		std::vector<double> sb_total;			// Source/sink term of a sub-cycled step
+		std::vector<double> DeltaSal_step;		// Salinity changes of a sub-step
 };
 #endif //End of SalinityTransport.h
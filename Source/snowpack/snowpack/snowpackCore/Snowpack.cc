@@ -25,7 +25,6 @@
  */
 
 #include <snowpack/snowpackCore/Snowpack.h>
-#include <snowpack/snowpackCore/Solver.h>
 #include <snowpack/Meteo.h>
 #include <snowpack/Constants.h>
 #include <snowpack/Utils.h>
@@ -339,6 +338,7 @@ void Snowpack::setUseSoilLayers(const bool& value) { //NOTE is this really neede
  */
 void Snowpack::compSnowCreep(const CurrentMeteo& Mdata, SnowStation& Xdata, SurfaceFluxes& Sdata)
 {
+	MIO_TRACE_ZONE("Snowpack", "compSnowCreep");
 	const bool prn_WRN = false;
 	const size_t nN = Xdata.getNumberOfNodes();
 	if (nN == (Xdata.SoilNode + 1))
@@ -844,6 +844,39 @@ double Snowpack::getModelAlbedo(const SnowStation& Xdata, CurrentMeteo& Mdata) c
 	return pAlbedo; //we do not have a measured albedo -> use parametrized
 }
 
+/**
+ * @brief Assemble an element matrix into the symmetric tridiagonal global matrix
+ * @details As for a symmetric matrix, only the upper coefficient of the element matrix is used for the off-diagonal term.
+ * @param Ie element incidences (two consecutive nodes)
+ * @param Se element matrix
+ * @param Kdiag main diagonal of the global matrix
+ * @param Koff off-diagonal of the global matrix (Koff[n] couples nodes n and n+1)
+ */
+inline void assembleTridiagonal(const int Ie[ N_OF_INCIDENCES ], const double Se[ N_OF_INCIDENCES ][ N_OF_INCIDENCES ],
+                                std::vector<double>& Kdiag, std::vector<double>& Koff)
+{
+	Kdiag[ Ie[0] ] += Se[0][0];
+	Kdiag[ Ie[1] ] += Se[1][1];
+	Koff[ Ie[0] ] += Se[0][1];
+}
+
+/**
+ * @brief Solve the symmetric tridiagonal system of equations with the Thomas algorithm
+ * @param Kdiag main diagonal of the matrix (overwritten)
+ * @param Koff off-diagonal of the matrix
+ * @param X right hand side vector, overwritten by the solution vector
+ * @return false if the solver failed or produced NaNs in the solution vector
+ */
+inline bool solveTridiagonal(std::vector<double>& Kdiag, std::vector<double>& Koff, double *X)
+{
+	const size_t nN = Kdiag.size();
+	if (ReSolver1d::TDMASolver(nN, &Koff[0], &Kdiag[0], &Koff[0], X, X) != 0) return false;
+	for (size_t n = 0; n < nN; n++) {
+		if (std::isnan(X[n])) return false;
+	}
+	return true;
+}
+
 /**
  * @brief Computes the snow temperatures which are given by the following formula: \n
  * @par
@@ -857,7 +890,7 @@ double Snowpack::getModelAlbedo(const SnowStation& Xdata, CurrentMeteo& Mdata) c
  * rho = snow density (kg m-3); c = specific heat capacity (J K-1 kg-1); k = heat conductivity (W K-1 m-1); t = time (s);
  * \n
  * Note:  The equations are solved with a fully implicit time-integration scheme and the
- * system of finite element matrices are solved using a sparse matrix solver.
+ * tridiagonal system of finite element matrices is solved with the Thomas algorithm.
  * @param Xdata Snow profile data
  * @param[in] Mdata Meteorological forcing
  * @param Bdata Boundary conditions
@@ -866,6 +899,7 @@ double Snowpack::getModelAlbedo(const SnowStation& Xdata, CurrentMeteo& Mdata) c
  */
 bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xdata, BoundCond& Bdata, const bool& ThrowAtNoConvergence)
 {
+	MIO_TRACE_ZONE("Snowpack", "compTemperatureProfile");
 	int Ie[N_OF_INCIDENCES];                     // Element incidences
 	double T0[N_OF_INCIDENCES];                  // Element nodal temperatures at t0
 	double TN[N_OF_INCIDENCES];                  // Iterated element nodal temperatures
@@ -875,7 +909,6 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 	double *U=NULL, *dU=NULL, *ddU=NULL;         // Solution vectors
 
 	// Dereference the pointers
-	void *Kt = Xdata.Kt;
 	vector<NodeData>& NDS = Xdata.Ndata;
 	vector<ElementData>& EMS = Xdata.Edata;
 
@@ -927,32 +960,14 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		return true;
 	}
 
-	if (Kt != NULL)
-		ds_Solve(ReleaseMatrixData, (SD_MATRIX_DATA*)Kt, 0);
-	ds_Initialize(static_cast<int>(nN), (SD_MATRIX_DATA**)&Kt);
 	/*
-	 * Define the structure of the matrix, i.e. its connectivity. For each element
-	 * we compute the element incidences and pass the incidences to the solver.
-	 * The solver assumes that the element incidences build a crique, i.e. the
-	 * equations specified by the incidence set are all connected to each other.
-	 * Initialize element data.
+	 * With linear elements, each node is only connected to its two neighbours, so the global
+	 * matrix is tridiagonal. It is also symmetric, since only the upper coefficient of the element
+	 * matrices is used for the off-diagonal terms. It is therefore stored as its main diagonal Kdiag
+	 * and its off-diagonal Koff (Koff[n] couples nodes n and n+1) and solved directly with the
+	 * Thomas algorithm, without any symbolic factorization or fill-in.
 	*/
-	for (int e = 0; e < static_cast<int>(nE); e++) {
-		int Nodes[2] = {e, e+1};
-		ds_DefineConnectivity( (SD_MATRIX_DATA*)Kt, 2, Nodes , 1, 0 );
-	}
-
-	/*
-	 * Perform the symbolic factorization. By specifying the element incidences, we
-	 * have simply declared which coefficients of the global matrix are not zero.
-	 * However, when we factorize the matrix in a LU form there is some fill-in.
-	 * Coefficients that were zero prior to start the factorization process will
-	 * have a value different from zero thereafter. At this step the solver compute
-	 * exactly how many memory is required to solve the problem and allocate this
-	 * memory in order to store the numerical matrix. Then reallocate all the
-	 * solution vectors.
-	*/
-	ds_Solve(SymbolicFactorize, (SD_MATRIX_DATA*)Kt, 0);
+	std::vector<double> Kdiag(nN, 0.), Koff(nN-1, 0.);
 
 	// Make sure that these vectors are always available for use ....
 	errno=0;
@@ -975,9 +990,6 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		throw IOException("Runtime error in compTemperatureProfile", AT);
 	}
 
-	// Make sure that the global data structures know where the pointers are for the next integration step after the reallocation ....
-	Xdata.Kt = Kt;
-
 	// Set the temperature at the snowpack base to the prescribed value.
 	// This only in case the soil_flux is not used.
 	if (!(soil_flux)) {
@@ -1064,7 +1076,8 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 	do {
 		iteration++;
 		// Reset the matrix data and zero out all the increment vectors
-		ds_Solve(ResetMatrixData, (SD_MATRIX_DATA*)Kt, 0);
+		std::fill(Kdiag.begin(), Kdiag.end(), 0.);
+		std::fill(Koff.begin(), Koff.end(), 0.);
 		for (size_t n = 0; n < nN; n++) {
 			ddU[n] = dU[n];
 			dU[n] = 0.0;
@@ -1159,13 +1172,13 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 				free(U); free(dU); free(ddU);
 				throw IOException("Runtime error in compTemperatureProfile", AT);
 			}
-			ds_AssembleMatrix( (SD_MATRIX_DATA*)Kt, 2, Ie, 2,  (double*) Se );
+			assembleTridiagonal(Ie, Se, Kdiag, Koff);
 			EL_RGT_ASSEM( dU, Ie, Fe );
 		}
 
 		/*
 		 * The top element is special in that it handles the entire meteo conditions
-		 * Several terms must be added to the global stiffness matrix Kt and flux
+		 * Several terms must be added to the tridiagonal system and flux
 		 * right-hand side vector dU. Note:  Shortwave radiation --- since it is a body
 		 * or volumetric force --- is computed in sn_ElementKtMatrix().
 		 */
@@ -1174,7 +1187,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			EL_INCID(static_cast<int>(nE-1), Ie);
 			EL_TEMP(Ie, T0, TN, NDS, U);
 			neumannBoundaryConditions(Mdata, Bdata, Xdata, T0[1], TN[1], Se, Fe);
-			ds_AssembleMatrix( (SD_MATRIX_DATA*)Kt, 2, Ie, 2,  (double*) Se );
+			assembleTridiagonal(Ie, Se, Kdiag, Koff);
 			EL_RGT_ASSEM( dU, Ie, Fe );
 		}
 
@@ -1182,8 +1195,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		if (surfaceCode == DIRICHLET_BC) {
 			// Dirichlet BC at surface: prescribed temperature value
 			// NOTE Insert Big at this location to hold the temperature constant at the prescribed value.
-			Ie[0] = static_cast<int>(nE);
-			ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 1, Ie, 1, &Big);
+			Kdiag[nE] += Big;
 		}
 		// Bottom node
 		if (soil_flux && variant != "SEAICE") {
@@ -1191,15 +1203,14 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			EL_INCID(0, Ie);
 			EL_TEMP(Ie, T0, TN, NDS, U);
 			neumannBoundaryConditionsSoil(Bdata.qg, T0[1], Se, Fe);
-			ds_AssembleMatrix((SD_MATRIX_DATA*)Kt, 2, Ie, 2, (double*) Se);
+			assembleTridiagonal(Ie, Se, Kdiag, Koff);
 			EL_RGT_ASSEM(dU, Ie, Fe);
 		} else if ((Xdata.getNumberOfElements() < 3) && (Xdata.Edata[0].theta[WATER] >= 0.9 * Xdata.Edata[0].res_wat_cont)) {
 			dU[0] = 0.;
 		} else {
 			// Dirichlet BC at bottom: prescribed temperature value
 			// NOTE Insert Big at this location to hold the temperature constant at the prescribed value.
-			Ie[0] = 0;
-			ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 1, Ie, 1, &Big);
+			Kdiag[0] += Big;
 		}
 
 		/*
@@ -1208,7 +1219,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		 * the solution of the system of equations, the new temperature.
 		 * It will throw an exception whenever the linear solver failed
 		 */
-		if (!ds_Solve(ComputeSolution, (SD_MATRIX_DATA*) Kt, dU)) {
+		if (!solveTridiagonal(Kdiag, Koff, dU)) {
 			  prn_msg(__FILE__, __LINE__, "err", Mdata.date,
 			  "Linear solver failed to solve for dU on the %d-th iteration.",
 			  iteration);
@@ -1627,6 +1638,7 @@ void Snowpack::compTechnicalSnow(const CurrentMeteo& Mdata, SnowStation& Xdata,
 void Snowpack::compSnowFall(const CurrentMeteo& Mdata, SnowStation& Xdata, double& cumu_precip,
                             SurfaceFluxes& Sdata)
 {
+	MIO_TRACE_ZONE("Snowpack", "compSnowFall");
 	if (Mdata.psum_tech!=Constants::undefined && Mdata.psum_tech > 0.) {
 		compTechnicalSnow(Mdata, Xdata, cumu_precip);
 		return;
@@ -2032,6 +2044,7 @@ void Snowpack::RedepositSnow(CurrentMeteo Mdata, SnowStation& Xdata, SurfaceFlux
 void Snowpack::runSnowpackModel(CurrentMeteo Mdata, SnowStation& Xdata, double& cumu_precip,
                                 BoundCond& Bdata, SurfaceFluxes& Sdata)
 {
+	MIO_TRACE_ZONE("Snowpack", "runSnowpackModel");
 	// HACK -> couldn't the following objects be created once in init ?? (with only a reset method ??)
 	WaterTransport watertransport(cfg);
 	VapourTransport vapourtransport(cfg);
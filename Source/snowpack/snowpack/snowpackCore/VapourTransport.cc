@@ -482,6 +482,7 @@ void VapourTransport::LayerToLayer(SnowStation& Xdata, SurfaceFluxes& Sdata, dou
 void VapourTransport::compTransportMass(const CurrentMeteo& Mdata, double& ql,
                                        SnowStation& Xdata, SurfaceFluxes& Sdata)
 {
+	MIO_TRACE_ZONE("Snowpack", "VapourTransport");
 	// First, consider no soil with no snow on the ground
 	if (!useSoilLayers && Xdata.getNumberOfNodes() == Xdata.SoilNode+1) {
 		return;
@@ -1165,6 +1165,7 @@ void WaterTransport::transportWater(const CurrentMeteo& Mdata, SnowStation& Xdat
 void WaterTransport::compTransportMass(const CurrentMeteo& Mdata,
                                        SnowStation& Xdata, SurfaceFluxes& Sdata, double& ql)
 {
+	MIO_TRACE_ZONE("Snowpack", "WaterTransport");
 	RichardsEquationSolver1d_matrix.surfacefluxrate=0.;		//These are for the interface of snowpack with the richards solver. Initialize it to 0.
 	RichardsEquationSolver1d_matrix.soilsurfacesourceflux=0.;
 